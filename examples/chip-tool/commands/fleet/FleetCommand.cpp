@@ -0,0 +1,716 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "FleetCommand.h"
+
+#include <app/InteractionModelEngine.h>
+#include <lib/support/jsontlv/TlvJson.h>
+#include <system/SystemClock.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+using namespace ::chip;
+using namespace ::chip::app;
+
+namespace {
+
+// The path keys match the ones used by RemoteDataModelLogger.
+constexpr char kNodeIdKey[]        = "nodeId";
+constexpr char kEndpointIdKey[]    = "endpointId";
+constexpr char kClusterIdKey[]     = "clusterId";
+constexpr char kAttributeIdKey[]   = "attributeId";
+constexpr char kCommandIdKey[]     = "commandId";
+constexpr char kStatusKey[]        = "status";
+constexpr char kClusterStatusKey[] = "clusterStatus";
+constexpr char kErrorKey[]         = "error";
+
+constexpr uint16_t kDefaultMaxParallel = 16;
+
+// Upper bound on the number of node ids a single node list can expand to, so that
+// a typo in a range does not try to allocate billions of entries.
+constexpr size_t kMaxNodeListSize = 65536;
+
+uint64_t NowMicros()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+Json::Value MicrosToMillis(uint64_t micros)
+{
+    return Json::Value(static_cast<double>(micros) / 1000.0);
+}
+
+void AddStatus(Json::Value & entry, const StatusIB & status)
+{
+    entry[kStatusKey] = to_underlying(status.mStatus);
+    if (status.mClusterStatus.HasValue())
+    {
+        entry[kClusterStatusKey] = status.mClusterStatus.Value();
+    }
+}
+
+bool ParseNodeId(const std::string & token, NodeId & nodeId)
+{
+    VerifyOrReturnValue(!token.empty() && token[0] != '-' && token[0] != '+', false);
+
+    char * end = nullptr;
+    errno      = 0;
+    nodeId     = strtoull(token.c_str(), &end, 0);
+    return errno == 0 && end != token.c_str() && *end == '\0' && IsOperationalNodeId(nodeId);
+}
+
+CHIP_ERROR ParseNodeToken(const std::string & token, std::vector<NodeId> & nodeIds)
+{
+    // The first character is skipped when looking for the range separator so
+    // that a leading sign is reported as an invalid node id rather than as a range.
+    size_t separator = token.find('-', 1);
+
+    NodeId first;
+    NodeId last;
+    if (separator == std::string::npos)
+    {
+        VerifyOrReturnError(ParseNodeId(token, first), CHIP_ERROR_INVALID_ARGUMENT,
+                            ChipLogError(chipTool, "Invalid node id: %s", token.c_str()));
+        last = first;
+    }
+    else
+    {
+        VerifyOrReturnError(ParseNodeId(token.substr(0, separator), first) && ParseNodeId(token.substr(separator + 1), last) &&
+                                first <= last,
+                            CHIP_ERROR_INVALID_ARGUMENT, ChipLogError(chipTool, "Invalid node id range: %s", token.c_str()));
+    }
+
+    VerifyOrReturnError(last - first < kMaxNodeListSize - nodeIds.size(), CHIP_ERROR_INVALID_ARGUMENT,
+                        ChipLogError(chipTool, "Node list is larger than %u nodes", static_cast<unsigned>(kMaxNodeListSize)));
+    for (NodeId nodeId = first;; nodeId++)
+    {
+        nodeIds.push_back(nodeId);
+        VerifyOrReturnError(nodeId != last, CHIP_NO_ERROR);
+    }
+}
+
+class ReadOperation : public FleetOperation, public ReadClient::Callback
+{
+public:
+    ReadOperation(FleetCommand & command, NodeId nodeId, ReadClient::InteractionType interactionType,
+                  const AttributePathParams & path) :
+        FleetOperation(command, nodeId),
+        mInteractionType(interactionType), mPath(path), mBufferedReadCallback(*this)
+    {}
+
+    bool IsActive() const override { return mReadClient != nullptr; }
+
+    CHIP_ERROR Start(Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle) override
+    {
+        ReadPrepareParams params(sessionHandle);
+        params.mpAttributePathParamsList    = &mPath;
+        params.mAttributePathParamsListSize = 1;
+        params.mIsFabricFiltered            = mFabricFiltered;
+        if (mInteractionType == ReadClient::InteractionType::Subscribe)
+        {
+            params.mMinIntervalFloorSeconds   = mMinIntervalFloorSeconds;
+            params.mMaxIntervalCeilingSeconds = mMaxIntervalCeilingSeconds;
+            params.mKeepSubscriptions         = mKeepSubscriptions;
+        }
+
+        mReadClient = std::make_unique<ReadClient>(InteractionModelEngine::GetInstance(), &exchangeMgr, mBufferedReadCallback,
+                                                   mInteractionType);
+        CHIP_ERROR err = mReadClient->SendRequest(params);
+        if (err != CHIP_NO_ERROR)
+        {
+            mReadClient.reset();
+        }
+        return err;
+    }
+
+    void SetFabricFiltered(bool fabricFiltered) { mFabricFiltered = fabricFiltered; }
+    void SetSubscriptionParams(uint16_t minInterval, uint16_t maxInterval, bool keepSubscriptions)
+    {
+        mMinIntervalFloorSeconds   = minInterval;
+        mMaxIntervalCeilingSeconds = maxInterval;
+        mKeepSubscriptions         = keepSubscriptions;
+    }
+
+    /////////// ReadClient Callback Interface /////////
+    void OnAttributeData(const ConcreteDataAttributePath & path, TLV::TLVReader * data, const StatusIB & status) override
+    {
+        Json::Value entry;
+        entry[kEndpointIdKey]  = path.mEndpointId;
+        entry[kClusterIdKey]   = path.mClusterId;
+        entry[kAttributeIdKey] = path.mAttributeId;
+
+        AddStatus(entry, status);
+        if (status.IsSuccess() && data != nullptr)
+        {
+            TLV::TLVReader reader;
+            reader.Init(*data);
+            CHIP_ERROR err = TlvToJson(reader, entry);
+            if (err != CHIP_NO_ERROR)
+            {
+                entry[kErrorKey] = ErrorStr(err);
+            }
+        }
+
+        if (!IsFinished())
+        {
+            AddEntry(std::move(entry));
+            return;
+        }
+
+        // Reports received once the subscription is established are written
+        // as they arrive instead of being accumulated.
+        Json::Value record;
+        record[kNodeIdKey] = Json::Value(static_cast<Json::UInt64>(GetNodeId()));
+        record["report"]   = std::move(entry);
+        mCommand.EmitRecord(record);
+    }
+
+    void OnError(CHIP_ERROR error) override
+    {
+        ChipLogError(chipTool, "Node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT, ChipLogValueX64(GetNodeId()), error.Format());
+        mError = error;
+    }
+
+    void OnSubscriptionEstablished(SubscriptionId subscriptionId) override { Finish(CHIP_NO_ERROR); }
+
+    void OnDone(ReadClient * client) override
+    {
+        if (!IsFinished())
+        {
+            Finish(mError);
+        }
+        else if (mInteractionType == ReadClient::InteractionType::Subscribe)
+        {
+            Json::Value record;
+            record[kNodeIdKey] = Json::Value(static_cast<Json::UInt64>(GetNodeId()));
+            record[kErrorKey]  = ErrorStr(mError);
+            mCommand.EmitRecord(record);
+        }
+
+        mReadClient.reset();
+    }
+
+private:
+    ReadClient::InteractionType mInteractionType;
+    AttributePathParams mPath;
+    bool mFabricFiltered                = true;
+    uint16_t mMinIntervalFloorSeconds   = 0;
+    uint16_t mMaxIntervalCeilingSeconds = 0;
+    bool mKeepSubscriptions             = false;
+    CHIP_ERROR mError                   = CHIP_NO_ERROR;
+
+    // Reassembles lists that the node sends across several chunks.
+    BufferedReadCallback mBufferedReadCallback;
+    std::unique_ptr<ReadClient> mReadClient;
+};
+
+class WriteOperation : public FleetOperation, public WriteClient::Callback
+{
+public:
+    WriteOperation(FleetCommand & command, NodeId nodeId, const AttributePathParams & path, const CustomArgument & value,
+                   const Optional<uint16_t> & timedInteractionTimeoutMs) :
+        FleetOperation(command, nodeId),
+        mPath(path), mValue(value), mTimedInteractionTimeoutMs(timedInteractionTimeoutMs)
+    {}
+
+    CHIP_ERROR Start(Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle) override
+    {
+        mWriteClient = std::make_unique<WriteClient>(&exchangeMgr, this, mTimedInteractionTimeoutMs, false,
+                                                     sessionHandle->AllowsLargePayload());
+
+        CHIP_ERROR err = mWriteClient->EncodeAttribute(mPath, mValue);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = mWriteClient->SendWriteRequest(sessionHandle);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            mWriteClient.reset();
+        }
+        return err;
+    }
+
+    /////////// WriteClient Callback Interface /////////
+    void OnResponse(const WriteClient * client, const ConcreteDataAttributePath & path, StatusIB status) override
+    {
+        Json::Value entry;
+        entry[kEndpointIdKey]  = path.mEndpointId;
+        entry[kClusterIdKey]   = path.mClusterId;
+        entry[kAttributeIdKey] = path.mAttributeId;
+        AddStatus(entry, status);
+        AddEntry(std::move(entry));
+
+        if (!status.IsSuccess() && mError == CHIP_NO_ERROR)
+        {
+            mError = status.ToChipError();
+        }
+    }
+
+    void OnError(const WriteClient * client, CHIP_ERROR error) override
+    {
+        ChipLogError(chipTool, "Node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT, ChipLogValueX64(GetNodeId()), error.Format());
+        mError = error;
+    }
+
+    void OnDone(WriteClient * client) override
+    {
+        Finish(mError);
+        mWriteClient.reset();
+    }
+
+private:
+    AttributePathParams mPath;
+    const CustomArgument & mValue;
+    Optional<uint16_t> mTimedInteractionTimeoutMs;
+    CHIP_ERROR mError = CHIP_NO_ERROR;
+
+    std::unique_ptr<WriteClient> mWriteClient;
+};
+
+class InvokeOperation : public FleetOperation, public CommandSender::Callback
+{
+public:
+    InvokeOperation(FleetCommand & command, NodeId nodeId, const CommandPathParams & path, const CustomArgument & payload,
+                    const Optional<uint16_t> & timedInteractionTimeoutMs) :
+        FleetOperation(command, nodeId),
+        mPath(path), mPayload(payload), mTimedInteractionTimeoutMs(timedInteractionTimeoutMs)
+    {}
+
+    CHIP_ERROR Start(Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle) override
+    {
+        mCommandSender = std::make_unique<CommandSender>(this, &exchangeMgr, mTimedInteractionTimeoutMs.HasValue(), false,
+                                                         sessionHandle->AllowsLargePayload());
+
+        CommandSender::AddRequestDataParameters params(mTimedInteractionTimeoutMs);
+        DataModel::EncodableType<CustomArgument> encodable(mPayload);
+
+        CHIP_ERROR err = mCommandSender->AddRequestData(mPath, encodable, params);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = mCommandSender->SendCommandRequest(sessionHandle);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            mCommandSender.reset();
+        }
+        return err;
+    }
+
+    /////////// CommandSender Callback Interface /////////
+    void OnResponse(CommandSender * client, const ConcreteCommandPath & path, const StatusIB & status,
+                    TLV::TLVReader * data) override
+    {
+        Json::Value entry;
+        entry[kEndpointIdKey] = path.mEndpointId;
+        entry[kClusterIdKey]  = path.mClusterId;
+        entry[kCommandIdKey]  = path.mCommandId;
+        AddStatus(entry, status);
+
+        if (data != nullptr)
+        {
+            TLV::TLVReader reader;
+            reader.Init(*data);
+            CHIP_ERROR err = TlvToJson(reader, entry);
+            if (err != CHIP_NO_ERROR)
+            {
+                entry[kErrorKey] = ErrorStr(err);
+            }
+        }
+        AddEntry(std::move(entry));
+
+        if (!status.IsSuccess() && mError == CHIP_NO_ERROR)
+        {
+            mError = status.ToChipError();
+        }
+    }
+
+    void OnError(const CommandSender * client, CHIP_ERROR error) override
+    {
+        ChipLogError(chipTool, "Node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT, ChipLogValueX64(GetNodeId()), error.Format());
+        mError = error;
+    }
+
+    void OnDone(CommandSender * client) override
+    {
+        Finish(mError);
+        mCommandSender.reset();
+    }
+
+private:
+    CommandPathParams mPath;
+    const CustomArgument & mPayload;
+    Optional<uint16_t> mTimedInteractionTimeoutMs;
+    CHIP_ERROR mError = CHIP_NO_ERROR;
+
+    std::unique_ptr<CommandSender> mCommandSender;
+};
+
+} // namespace
+
+FleetOperation::FleetOperation(FleetCommand & command, NodeId nodeId) :
+    mCommand(command), mNodeId(nodeId), mOnDeviceConnectedCallback(OnDeviceConnectedFn, this),
+    mOnDeviceConnectionFailureCallback(OnDeviceConnectionFailureFn, this)
+{}
+
+FleetOperation::~FleetOperation()
+{
+    mOnDeviceConnectedCallback.Cancel();
+    mOnDeviceConnectionFailureCallback.Cancel();
+}
+
+void FleetOperation::Finish(CHIP_ERROR error)
+{
+    VerifyOrReturn(!mFinished);
+    mFinished = true;
+    mCommand.OnFinished(*this, error);
+}
+
+void FleetOperation::OnDeviceConnectedFn(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                         const SessionHandle & sessionHandle)
+{
+    auto * operation = reinterpret_cast<FleetOperation *>(context);
+    VerifyOrReturn(operation != nullptr, ChipLogError(chipTool, "OnDeviceConnectedFn: context is null"));
+    operation->mCommand.OnConnected(*operation, exchangeMgr, sessionHandle);
+}
+
+void FleetOperation::OnDeviceConnectionFailureFn(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    auto * operation = reinterpret_cast<FleetOperation *>(context);
+    VerifyOrReturn(operation != nullptr, ChipLogError(chipTool, "OnDeviceConnectionFailureFn: context is null"));
+    operation->mCommand.OnConnectionFailure(*operation, error);
+}
+
+void FleetCommand::AddFleetArguments()
+{
+    AddArgument("node-ids", &mNodeList,
+                "Comma-separated list of node ids and inclusive ranges (e.g. 1,2,0x10-0x1F), or @path to read the node ids "
+                "from a file.");
+    AddArgument("endpoint-id", 0, UINT16_MAX, &mEndpointId);
+    AddArgument("max-parallel", 1, UINT16_MAX, &mMaxParallel,
+                "Maximum number of nodes processed at the same time. Defaults to 16.");
+    AddArgument("output", &mOutputPath, "File to write the results to, one JSON object per line. Defaults to stdout.");
+    AddArgument("timeout", 0, UINT16_MAX, &mTimeout,
+                "Time, in seconds, before the whole command is aborted. Defaults to 300 seconds.");
+}
+
+CHIP_ERROR FleetCommand::ParseNodeList(const char * nodeList, std::vector<NodeId> & nodeIds)
+{
+    VerifyOrReturnError(nodeList != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::string contents;
+    if (nodeList[0] == '@')
+    {
+        std::ifstream file(nodeList + 1);
+        VerifyOrReturnError(file.is_open(), CHIP_ERROR_OPEN_FAILED, ChipLogError(chipTool, "Can not open %s", nodeList + 1));
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            contents.append(line, 0, line.find('#'));
+            contents.push_back(',');
+        }
+    }
+    else
+    {
+        contents = nodeList;
+    }
+    std::replace_if(
+        contents.begin(), contents.end(), [](char c) { return isspace(static_cast<unsigned char>(c)); }, ',');
+
+    std::istringstream stream(contents);
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+        if (!token.empty())
+        {
+            ReturnErrorOnFailure(ParseNodeToken(token, nodeIds));
+        }
+    }
+
+    // Operating on a node twice would also count it twice in the results: only keep the first occurrence of each node.
+    std::unordered_set<NodeId> seen;
+    nodeIds.erase(std::remove_if(nodeIds.begin(), nodeIds.end(), [&seen](NodeId nodeId) { return !seen.insert(nodeId).second; }),
+                  nodeIds.end());
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FleetCommand::RunCommand()
+{
+    mNodeIds.clear();
+    ReturnErrorOnFailure(ParseNodeList(mNodeList, mNodeIds));
+    VerifyOrReturnError(!mNodeIds.empty(), CHIP_ERROR_INVALID_ARGUMENT, ChipLogError(chipTool, "The node list is empty"));
+
+    // Operations from a previous run in interactive mode are only kept while
+    // they still do work, i.e. subscriptions that are still alive.
+    mOperations.erase(std::remove_if(mOperations.begin(), mOperations.end(),
+                                     [](const std::unique_ptr<FleetOperation> & operation) { return !operation->IsActive(); }),
+                      mOperations.end());
+
+    CloseOutput();
+    if (mOutputPath.HasValue())
+    {
+        mOutput = fopen(mOutputPath.Value(), "w");
+        VerifyOrReturnError(mOutput != nullptr, CHIP_ERROR_OPEN_FAILED,
+                            ChipLogError(chipTool, "Can not open %s", mOutputPath.Value()));
+    }
+
+    mNodeCount    = mNodeIds.size();
+    mNextNode     = 0;
+    mInFlight     = 0;
+    mSucceeded    = 0;
+    mFailed       = 0;
+    mConnecting   = 0;
+    mConnectLimit = SIZE_MAX;
+    mFirstError   = CHIP_NO_ERROR;
+    mLatencies.clear();
+    mLatencies.reserve(mNodeCount);
+
+    ChipLogProgress(chipTool, "Running %s on %u nodes", GetName(), static_cast<unsigned>(mNodeCount));
+    mStartMicros = NowMicros();
+    Dispatch();
+    return CHIP_NO_ERROR;
+}
+
+void FleetCommand::Dispatch()
+{
+    // Sessions that are already established are reported synchronously from
+    // GetConnectedDevice, so an operation can complete, and try to dispatch the
+    // next node, before the loop below gets to the next iteration.  Record the
+    // request and let the outer loop handle it instead of recursing.
+    if (mDispatching)
+    {
+        mDispatchPending = true;
+        return;
+    }
+
+    mDispatching = true;
+    do
+    {
+        mDispatchPending = false;
+        while (mNextNode < mNodeIds.size() && mInFlight < mMaxParallel.ValueOr(kDefaultMaxParallel) &&
+               mConnecting < mConnectLimit)
+        {
+            NodeId nodeId = mNodeIds[mNextNode++];
+            mOperations.push_back(NewOperation(nodeId));
+            FleetOperation & operation = *mOperations.back();
+
+            mInFlight++;
+            mConnecting++;
+            operation.mStartMicros = NowMicros();
+
+            CHIP_ERROR err = CurrentCommissioner().GetConnectedDevice(nodeId, &operation.mOnDeviceConnectedCallback,
+                                                                      &operation.mOnDeviceConnectionFailureCallback);
+            if (err != CHIP_NO_ERROR)
+            {
+                OnConnectionFailure(operation, err);
+            }
+        }
+    } while (mDispatchPending);
+    mDispatching = false;
+}
+
+void FleetCommand::OnConnected(FleetOperation & operation, Messaging::ExchangeManager & exchangeMgr,
+                               const SessionHandle & sessionHandle)
+{
+    mConnecting--;
+    operation.mConnectedMicros = NowMicros();
+
+    CHIP_ERROR err = operation.Start(exchangeMgr, sessionHandle);
+    if (err != CHIP_NO_ERROR)
+    {
+        operation.Finish(err);
+    }
+}
+
+void FleetCommand::OnConnectionFailure(FleetOperation & operation, CHIP_ERROR error)
+{
+    mConnecting--;
+
+    // The controller can only set up a limited number of sessions at once.  If
+    // other nodes are still connecting, wait for them before trying this node
+    // again, and do not start more connections than that from now on.
+    if (error == CHIP_ERROR_NO_MEMORY && mConnecting > 0)
+    {
+        ChipLogProgress(chipTool, "Out of session setups, limiting to %u concurrent connections",
+                        static_cast<unsigned>(mConnecting));
+        mConnectLimit = mConnecting;
+        mInFlight--;
+        operation.mFinished = true;
+        mNodeIds.push_back(operation.GetNodeId());
+        return;
+    }
+
+    ChipLogError(chipTool, "Failed to connect to node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                 ChipLogValueX64(operation.GetNodeId()), error.Format());
+    operation.Finish(error);
+}
+
+void FleetCommand::OnFinished(FleetOperation & operation, CHIP_ERROR error)
+{
+    uint64_t now     = NowMicros();
+    uint64_t latency = now - operation.mStartMicros;
+
+    Json::Value record;
+    record[kNodeIdKey] = Json::Value(static_cast<Json::UInt64>(operation.GetNodeId()));
+    record["success"]  = (error == CHIP_NO_ERROR);
+    if (error != CHIP_NO_ERROR)
+    {
+        record[kErrorKey] = ErrorStr(error);
+    }
+    if (operation.mConnectedMicros != 0)
+    {
+        record["connectMs"] = MicrosToMillis(operation.mConnectedMicros - operation.mStartMicros);
+    }
+    record["latencyMs"] = MicrosToMillis(latency);
+    record["results"]   = std::move(operation.mEntries);
+    EmitRecord(record);
+
+    mInFlight--;
+    mLatencies.push_back(latency);
+    if (error == CHIP_NO_ERROR)
+    {
+        mSucceeded++;
+    }
+    else
+    {
+        mFailed++;
+        if (mFirstError == CHIP_NO_ERROR)
+        {
+            mFirstError = error;
+        }
+    }
+
+    if (mSucceeded + mFailed == mNodeCount)
+    {
+        EmitSummary();
+        SetCommandExitStatus(mFirstError);
+        return;
+    }
+
+    Dispatch();
+}
+
+void FleetCommand::EmitRecord(const Json::Value & record)
+{
+    Json::FastWriter writer;
+    writer.omitEndingLineFeed();
+    std::string line = writer.write(record);
+
+    FILE * output = (mOutput != nullptr) ? mOutput : stdout;
+    fprintf(output, "%s\n", line.c_str());
+    fflush(output);
+}
+
+void FleetCommand::EmitSummary()
+{
+    uint64_t elapsed = NowMicros() - mStartMicros;
+
+    Json::Value summary;
+    summary["command"]   = GetName();
+    summary["nodes"]     = static_cast<Json::UInt64>(mNodeCount);
+    summary["succeeded"] = static_cast<Json::UInt64>(mSucceeded);
+    summary["failed"]    = static_cast<Json::UInt64>(mFailed);
+    summary["elapsedMs"] = MicrosToMillis(elapsed);
+    if (elapsed != 0)
+    {
+        summary["nodesPerSecond"] = static_cast<double>(mNodeCount) * 1e6 / static_cast<double>(elapsed);
+    }
+
+    if (!mLatencies.empty())
+    {
+        std::sort(mLatencies.begin(), mLatencies.end());
+        auto percentile = [this](size_t p) { return MicrosToMillis(mLatencies[(mLatencies.size() - 1) * p / 100]); };
+
+        Json::Value latency;
+        latency["min"]       = MicrosToMillis(mLatencies.front());
+        latency["p50"]       = percentile(50);
+        latency["p90"]       = percentile(90);
+        latency["p99"]       = percentile(99);
+        latency["max"]       = MicrosToMillis(mLatencies.back());
+        summary["latencyMs"] = std::move(latency);
+    }
+
+    Json::Value record;
+    record["summary"] = std::move(summary);
+    EmitRecord(record);
+}
+
+void FleetCommand::CloseOutput()
+{
+    if (mOutput != nullptr)
+    {
+        fclose(mOutput);
+        mOutput = nullptr;
+    }
+}
+
+void FleetCommand::Shutdown()
+{
+    // Nodes that have not completed by now (the command timed out) are
+    // abandoned.  Finished subscriptions keep running until Cleanup().
+    mOperations.erase(std::remove_if(mOperations.begin(), mOperations.end(),
+                                     [](const std::unique_ptr<FleetOperation> & operation) { return !operation->IsFinished(); }),
+                      mOperations.end());
+    mInFlight   = 0;
+    mConnecting = 0;
+
+    CHIPCommand::Shutdown();
+}
+
+void FleetCommand::Cleanup()
+{
+    mOperations.clear();
+    CloseOutput();
+}
+
+std::unique_ptr<FleetOperation> FleetReadCommand::NewOperation(NodeId nodeId)
+{
+    auto operation = std::make_unique<ReadOperation>(*this, nodeId, ReadClient::InteractionType::Read,
+                                                     AttributePathParams(mEndpointId, mClusterId, mAttributeId));
+    operation->SetFabricFiltered(mFabricFiltered.ValueOr(true));
+    return operation;
+}
+
+std::unique_ptr<FleetOperation> FleetSubscribeCommand::NewOperation(NodeId nodeId)
+{
+    auto operation = std::make_unique<ReadOperation>(*this, nodeId, ReadClient::InteractionType::Subscribe,
+                                                     AttributePathParams(mEndpointId, mClusterId, mAttributeId));
+    operation->SetFabricFiltered(mFabricFiltered.ValueOr(true));
+    operation->SetSubscriptionParams(mMinInterval, mMaxInterval, mKeepSubscriptions.ValueOr(false));
+    return operation;
+}
+
+std::unique_ptr<FleetOperation> FleetWriteCommand::NewOperation(NodeId nodeId)
+{
+    return std::make_unique<WriteOperation>(*this, nodeId, AttributePathParams(mEndpointId, mClusterId, mAttributeId),
+                                            mAttributeValue, mTimedInteractionTimeoutMs);
+}
+
+std::unique_ptr<FleetOperation> FleetInvokeCommand::NewOperation(NodeId nodeId)
+{
+    CommandPathParams path(mEndpointId, /* group id */ 0, mClusterId, mCommandId, CommandPathFlags::kEndpointIdValid);
+    return std::make_unique<InvokeOperation>(*this, nodeId, path, mPayload, mTimedInteractionTimeoutMs);
+}
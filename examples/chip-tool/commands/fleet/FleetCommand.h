@@ -0,0 +1,293 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "../clusters/CustomArgument.h"
+#include "../common/CHIPCommand.h"
+
+#include <app/BufferedReadCallback.h>
+#include <app/CommandSender.h>
+#include <app/ReadClient.h>
+#include <app/WriteClient.h>
+#include <json/json.h>
+
+#include <memory>
+#include <vector>
+
+class FleetCommand;
+
+/**
+ * The interaction a fleet command runs against a single node.
+ *
+ * FleetCommand establishes (or reuses) the CASE session to the node and then
+ * calls Start().  The operation must eventually call Finish() exactly once,
+ * unless Start() returns an error.
+ */
+class FleetOperation
+{
+public:
+    FleetOperation(FleetCommand & command, chip::NodeId nodeId);
+    virtual ~FleetOperation();
+
+    chip::NodeId GetNodeId() const { return mNodeId; }
+    bool IsFinished() const { return mFinished; }
+
+    /**
+     * Returns true while the operation still does work after finishing, e.g. a
+     * subscription that keeps reporting.
+     */
+    virtual bool IsActive() const { return !mFinished; }
+
+    virtual CHIP_ERROR Start(chip::Messaging::ExchangeManager & exchangeMgr, const chip::SessionHandle & sessionHandle) = 0;
+
+protected:
+    /**
+     * Adds an entry (attribute value, command response, status...) to the
+     * record written for this node when it finishes.
+     */
+    void AddEntry(Json::Value && entry) { mEntries.append(std::move(entry)); }
+
+    void Finish(CHIP_ERROR error);
+
+    FleetCommand & mCommand;
+
+private:
+    friend class FleetCommand;
+
+    static void OnDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
+                                    const chip::SessionHandle & sessionHandle);
+    static void OnDeviceConnectionFailureFn(void * context, const chip::ScopedNodeId & peerId, CHIP_ERROR error);
+
+    chip::NodeId mNodeId;
+    bool mFinished = false;
+    Json::Value mEntries{ Json::arrayValue };
+
+    uint64_t mStartMicros     = 0;
+    uint64_t mConnectedMicros = 0;
+
+    chip::Callback::Callback<chip::OnDeviceConnected> mOnDeviceConnectedCallback;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> mOnDeviceConnectionFailureCallback;
+};
+
+/**
+ * Base class for the `fleet` commands, which run the same interaction against
+ * a list of nodes.
+ *
+ * Up to `max-parallel` nodes are processed at once; the next node is started
+ * as soon as one completes.  Sessions are obtained through
+ * DeviceController::GetConnectedDevice, so nodes that already have a CASE
+ * session (e.g. from an earlier command in interactive mode) do not go through
+ * a new handshake.  When the pool of pending session setups is exhausted, the
+ * node is put back in the queue instead of failing.
+ *
+ * One JSON object per node is written on its own line as soon as the node
+ * completes, followed by a summary line with the overall throughput and the
+ * distribution of per-node latencies.
+ */
+class FleetCommand : public CHIPCommand
+{
+public:
+    FleetCommand(const char * commandName, CredentialIssuerCommands * credsIssuerConfig, const char * helpText) :
+        CHIPCommand(commandName, credsIssuerConfig, helpText)
+    {}
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override
+    {
+        return chip::System::Clock::Seconds16(mTimeout.ValueOr(kDefaultTimeoutSeconds));
+    }
+    void Shutdown() override;
+    void Cleanup() override;
+
+    /**
+     * Parses a node list: comma-separated node ids and inclusive ranges (e.g.
+     * "1,2,0x10-0x1F"), or "@path" to read node ids from a file (separated by
+     * commas or whitespace, '#' starts a comment). A node listed several times
+     * is only kept where it first appears.
+     */
+    static CHIP_ERROR ParseNodeList(const char * nodeList, std::vector<chip::NodeId> & nodeIds);
+
+    /**
+     * Writes a single JSON line to the command output.
+     */
+    void EmitRecord(const Json::Value & record);
+
+protected:
+    static constexpr uint16_t kDefaultTimeoutSeconds = 300;
+
+    /**
+     * Adds the node-ids and endpoint-id arguments followed by the options shared
+     * by every fleet command.  Subclasses call this after adding the arguments
+     * that come before the node list.
+     */
+    void AddFleetArguments();
+
+    virtual std::unique_ptr<FleetOperation> NewOperation(chip::NodeId nodeId) = 0;
+
+    chip::EndpointId mEndpointId;
+
+private:
+    friend class FleetOperation;
+
+    void OnConnected(FleetOperation & operation, chip::Messaging::ExchangeManager & exchangeMgr,
+                     const chip::SessionHandle & sessionHandle);
+    void OnConnectionFailure(FleetOperation & operation, CHIP_ERROR error);
+    void OnFinished(FleetOperation & operation, CHIP_ERROR error);
+
+    /**
+     * Starts queued nodes until `max-parallel` operations are in flight.
+     */
+    void Dispatch();
+    void EmitSummary();
+    void CloseOutput();
+
+    char * mNodeList = nullptr;
+    chip::Optional<uint16_t> mMaxParallel;
+    chip::Optional<char *> mOutputPath;
+    chip::Optional<uint16_t> mTimeout;
+
+    std::vector<chip::NodeId> mNodeIds;
+    std::vector<std::unique_ptr<FleetOperation>> mOperations;
+    FILE * mOutput = nullptr;
+
+    size_t mNodeCount = 0;
+    size_t mNextNode  = 0;
+    size_t mInFlight  = 0;
+    size_t mSucceeded = 0;
+    size_t mFailed    = 0;
+
+    // Nodes waiting for a session, and how many of them the controller can set
+    // up at once (learned when GetConnectedDevice runs out of memory).
+    size_t mConnecting   = 0;
+    size_t mConnectLimit = SIZE_MAX;
+
+    std::vector<uint64_t> mLatencies;
+    uint64_t mStartMicros = 0;
+    CHIP_ERROR mFirstError = CHIP_NO_ERROR;
+
+    bool mDispatching     = false;
+    bool mDispatchPending = false;
+};
+
+class FleetReadCommand : public FleetCommand
+{
+public:
+    FleetReadCommand(CredentialIssuerCommands * credsIssuerConfig) :
+        FleetCommand("read-by-id", credsIssuerConfig, "Read an attribute from every node of a node list.")
+    {
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("attribute-id", 0, UINT32_MAX, &mAttributeId);
+        AddFleetArguments();
+        AddArgument("fabric-filtered", 0, 1, &mFabricFiltered,
+                    "Boolean indicating whether to do a fabric-filtered read. Defaults to true.");
+    }
+
+protected:
+    std::unique_ptr<FleetOperation> NewOperation(chip::NodeId nodeId) override;
+
+private:
+    chip::ClusterId mClusterId;
+    chip::AttributeId mAttributeId;
+    chip::Optional<bool> mFabricFiltered;
+};
+
+class FleetSubscribeCommand : public FleetCommand
+{
+public:
+    FleetSubscribeCommand(CredentialIssuerCommands * credsIssuerConfig) :
+        FleetCommand("subscribe-by-id", credsIssuerConfig,
+                     "Subscribe to an attribute on every node of a node list. Reports are written as they arrive.")
+    {
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("attribute-id", 0, UINT32_MAX, &mAttributeId);
+        AddArgument("min-interval", 0, UINT16_MAX, &mMinInterval,
+                    "The requested minimum interval between reports. Sets MinIntervalFloor in the Subscribe Request.");
+        AddArgument("max-interval", 0, UINT16_MAX, &mMaxInterval,
+                    "The requested maximum interval between reports. Sets MaxIntervalCeiling in the Subscribe Request.");
+        AddFleetArguments();
+        AddArgument("fabric-filtered", 0, 1, &mFabricFiltered,
+                    "Boolean indicating whether to do a fabric-filtered subscription. Defaults to true.");
+        AddArgument("keep-subscriptions", 0, 1, &mKeepSubscriptions,
+                    "Boolean indicating whether to keep existing subscriptions when creating the new ones. Defaults to false.");
+    }
+
+    // Subscriptions keep reporting after the command completes in interactive
+    // mode, until they are torn down when quitting.
+    bool DeferInteractiveCleanup() override { return true; }
+
+protected:
+    std::unique_ptr<FleetOperation> NewOperation(chip::NodeId nodeId) override;
+
+private:
+    chip::ClusterId mClusterId;
+    chip::AttributeId mAttributeId;
+    uint16_t mMinInterval;
+    uint16_t mMaxInterval;
+    chip::Optional<bool> mFabricFiltered;
+    chip::Optional<bool> mKeepSubscriptions;
+};
+
+class FleetWriteCommand : public FleetCommand
+{
+public:
+    FleetWriteCommand(CredentialIssuerCommands * credsIssuerConfig) :
+        FleetCommand("write-by-id", credsIssuerConfig, "Write an attribute on every node of a node list.")
+    {
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("attribute-id", 0, UINT32_MAX, &mAttributeId);
+        AddArgument("attribute-value", &mAttributeValue, "The value to write, in the same format as for 'any write-by-id'.");
+        AddFleetArguments();
+        AddArgument("timedInteractionTimeoutMs", 0, UINT16_MAX, &mTimedInteractionTimeoutMs,
+                    "If provided, do a timed write with the given timed interaction timeout.");
+    }
+
+protected:
+    std::unique_ptr<FleetOperation> NewOperation(chip::NodeId nodeId) override;
+
+private:
+    chip::ClusterId mClusterId;
+    chip::AttributeId mAttributeId;
+    CustomArgument mAttributeValue;
+    chip::Optional<uint16_t> mTimedInteractionTimeoutMs;
+};
+
+class FleetInvokeCommand : public FleetCommand
+{
+public:
+    FleetInvokeCommand(CredentialIssuerCommands * credsIssuerConfig) :
+        FleetCommand("command-by-id", credsIssuerConfig, "Invoke a command on every node of a node list.")
+    {
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("command-id", 0, UINT32_MAX, &mCommandId);
+        AddArgument("payload", &mPayload, "The command payload, in the same format as for 'any command-by-id'.");
+        AddFleetArguments();
+        AddArgument("timedInteractionTimeoutMs", 0, UINT16_MAX, &mTimedInteractionTimeoutMs,
+                    "If provided, do a timed invoke with the given timed interaction timeout.");
+    }
+
+protected:
+    std::unique_ptr<FleetOperation> NewOperation(chip::NodeId nodeId) override;
+
+private:
+    chip::ClusterId mClusterId;
+    chip::CommandId mCommandId;
+    CustomArgument mPayload;
+    chip::Optional<uint16_t> mTimedInteractionTimeoutMs;
+};
@@ -0,0 +1,36 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "commands/common/Commands.h"
+#include "commands/metrics/MetricsCommand.h"
+
+void registerCommandsMetrics(Commands & commands, CredentialIssuerCommands * credsIssuerConfig)
+{
+    const char * clusterName      = "Metrics";
+    commands_list clusterCommands = {
+        make_unique<MetricsDumpCommand>(),                         //
+        make_unique<MetricsResetCommand>(),                        //
+        make_unique<MetricsStartExportCommand>(credsIssuerConfig), //
+        make_unique<MetricsStopExportCommand>(credsIssuerConfig),  //
+    };
+
+    commands.RegisterCommandSet(clusterName, clusterCommands,
+                                "Commands for inspecting metrics aggregated with '--trace-to metrics'.");
+}
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "MetricsCommand.h"
+
+#include <platform/CHIPDeviceLayer.h>
+
+#include <cstdio>
+#include <cstring>
+
+using chip::Tracing::Metrics::MetricsRegistry;
+
+namespace {
+
+CHIP_ERROR ParseFormat(const chip::Optional<char *> & format, MetricsRegistry::ExportFormat & outFormat)
+{
+    outFormat = MetricsRegistry::ExportFormat::kText;
+    VerifyOrReturnError(format.HasValue(), CHIP_NO_ERROR);
+
+    if (strcmp(format.Value(), "text") == 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+    if (strcmp(format.Value(), "json") == 0)
+    {
+        outFormat = MetricsRegistry::ExportFormat::kJson;
+        return CHIP_NO_ERROR;
+    }
+
+    ChipLogError(chipTool, "Unknown metrics format '%s', expected 'text' or 'json'", format.Value());
+    return CHIP_ERROR_INVALID_ARGUMENT;
+}
+
+void PrintSnapshot(const std::string & snapshot, void * /* context */)
+{
+    fputs(snapshot.c_str(), stdout);
+    fflush(stdout);
+}
+
+} // namespace
+
+CHIP_ERROR MetricsDumpCommand::Run()
+{
+    MetricsRegistry::ExportFormat format;
+    ReturnErrorOnFailure(ParseFormat(mFormat, format));
+
+    PrintSnapshot(MetricsRegistry::Instance().Export(format), nullptr);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MetricsResetCommand::Run()
+{
+    MetricsRegistry::Instance().Reset();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MetricsStartExportCommand::RunCommand()
+{
+    MetricsRegistry::ExportFormat format;
+    ReturnErrorOnFailure(ParseFormat(mFormat, format));
+
+    CHIP_ERROR err = MetricsRegistry::Instance().StartPeriodicExport(
+        chip::DeviceLayer::SystemLayer(), chip::System::Clock::Seconds16(mIntervalInSeconds), format, PrintSnapshot, nullptr);
+    SetCommandExitStatus(err);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MetricsStopExportCommand::RunCommand()
+{
+    MetricsRegistry::Instance().StopPeriodicExport();
+    SetCommandExitStatus(CHIP_NO_ERROR);
+    return CHIP_NO_ERROR;
+}
@@ -0,0 +1,83 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "../common/CHIPCommand.h"
+#include "../common/Command.h"
+
+#include <tracing/metrics/metrics_registry.h>
+
+/**
+ * Commands to inspect the metrics aggregated by the `metrics` tracing target
+ * (`--trace-to metrics`). They are mostly useful from interactive mode, where
+ * the registry accumulates across the commands of a session.
+ */
+
+class MetricsDumpCommand : public Command
+{
+public:
+    MetricsDumpCommand() : Command("dump", "Print the aggregated metrics.")
+    {
+        AddArgument("format", &mFormat, "Output format: text (default) or json.");
+    }
+
+    CHIP_ERROR Run() override;
+
+private:
+    chip::Optional<char *> mFormat;
+};
+
+class MetricsResetCommand : public Command
+{
+public:
+    MetricsResetCommand() : Command("reset", "Discard the aggregated metrics.") {}
+
+    CHIP_ERROR Run() override;
+};
+
+class MetricsStartExportCommand : public CHIPCommand
+{
+public:
+    MetricsStartExportCommand(CredentialIssuerCommands * credIssuerCommands) :
+        CHIPCommand("start-export", credIssuerCommands, "Periodically print the aggregated metrics.")
+    {
+        AddArgument("interval-in-seconds", 1, UINT16_MAX, &mIntervalInSeconds, "Time between two snapshots.");
+        AddArgument("format", &mFormat, "Output format: text (default) or json.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Seconds16(1); }
+
+private:
+    uint16_t mIntervalInSeconds;
+    chip::Optional<char *> mFormat;
+};
+
+class MetricsStopExportCommand : public CHIPCommand
+{
+public:
+    MetricsStopExportCommand(CredentialIssuerCommands * credIssuerCommands) :
+        CHIPCommand("stop-export", credIssuerCommands, "Stop printing the aggregated metrics periodically.")
+    {}
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Seconds16(1); }
+};
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <commands/fleet/FleetCommand.h>
+#include <lib/core/StringBuilderAdapters.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+
+namespace {
+
+std::vector<NodeId> Parse(const char * nodeList, CHIP_ERROR expectedError = CHIP_NO_ERROR)
+{
+    std::vector<NodeId> nodeIds;
+    EXPECT_EQ(FleetCommand::ParseNodeList(nodeList, nodeIds), expectedError);
+    return nodeIds;
+}
+
+TEST(TestFleetCommand, TestIdsAndRanges)
+{
+    EXPECT_EQ(Parse("1"), (std::vector<NodeId>{ 1 }));
+    EXPECT_EQ(Parse("1,2,0x10-0x12"), (std::vector<NodeId>{ 1, 2, 0x10, 0x11, 0x12 }));
+    EXPECT_EQ(Parse("5-5"), (std::vector<NodeId>{ 5 }));
+    EXPECT_EQ(Parse("0xFFFFFFEFFFFFFFFE-0xFFFFFFEFFFFFFFFF"),
+              (std::vector<NodeId>{ kMaxOperationalNodeId - 1, kMaxOperationalNodeId }));
+    EXPECT_EQ(Parse("1-65536").size(), 65536u);
+
+    // Whitespace separates ids like commas, and empty entries are skipped.
+    EXPECT_EQ(Parse(" 3,\t1\n2 ,, "), (std::vector<NodeId>{ 3, 1, 2 }));
+    EXPECT_TRUE(Parse("").empty());
+    EXPECT_TRUE(Parse(" , ").empty());
+}
+
+TEST(TestFleetCommand, TestDuplicates)
+{
+    // The order in which nodes first appear is kept.
+    EXPECT_EQ(Parse("3,1,3"), (std::vector<NodeId>{ 3, 1 }));
+    EXPECT_EQ(Parse("4-6,1-5,0x5"), (std::vector<NodeId>{ 4, 5, 6, 1, 2, 3 }));
+}
+
+TEST(TestFleetCommand, TestMalformed)
+{
+    std::vector<NodeId> nodeIds;
+    EXPECT_EQ(FleetCommand::ParseNodeList(nullptr, nodeIds), CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (const char * nodeList : {
+             "abc", "1,x", "1.5", "12abc", "0x", "-1", "+1", "1-", "-", "1--2", "1-2-3", "3-1", "0x1G",
+             // Not operational node ids.
+             "0", "0xFFFFFFF000000000", "1-0xFFFFFFF000000000",
+             // Out of range of a node id.
+             "18446744073709551616",
+             // Too many nodes.
+             "1-65537", "1-40000,40001-80000",
+         })
+    {
+        Parse(nodeList, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+}
+
+TEST(TestFleetCommand, TestFile)
+{
+    char path[] = "/tmp/TestFleetCommand-XXXXXX";
+    int fd      = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    FILE * file = fopen(path, "w");
+    ASSERT_NE(file, nullptr);
+    fputs("# Kitchen\n1 2\n0x10-0x11 # Hallway, 2 nodes\n\n3,1\n", file);
+    fclose(file);
+
+    std::string nodeList = std::string("@") + path;
+    EXPECT_EQ(Parse(nodeList.c_str()), (std::vector<NodeId>{ 1, 2, 0x10, 0x11, 3 }));
+
+    file = fopen(path, "w");
+    ASSERT_NE(file, nullptr);
+    fputs("1\nnot-a-node\n", file);
+    fclose(file);
+    Parse(nodeList.c_str(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    unlink(path);
+    Parse(nodeList.c_str(), CHIP_ERROR_OPEN_FAILED);
+}
+
+} // namespace
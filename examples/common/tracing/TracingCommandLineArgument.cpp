@@ -20,8 +20,13 @@
 #include <lib/support/StringSplitter.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <tracing/json/json_tracing.h>
+#include <tracing/metrics/metrics_registry.h>
 #include <tracing/registry.h>
 
+#if ENABLE_BINARY_TRACING
+#include <tracing/binary/binary_tracing.h> // nogncheck
+#endif
+
 #if ENABLE_PERFETTO_TRACING
 #include <tracing/perfetto/event_storage.h>     // nogncheck
 #include <tracing/perfetto/simple_initialize.h> // nogncheck
@@ -74,6 +79,35 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             }
             chip::Tracing::Register(mJsonBackend);
         }
+        else if (value.data_equal(CharSpan::fromCharString("metrics")))
+        {
+            chip::Tracing::Register(chip::Tracing::Metrics::MetricsRegistry::Instance());
+        }
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+        else if (value.data_equal(CharSpan::fromCharString("event-loop")))
+        {
+            // Log callbacks that delay the event loop past the standalone ack timeout of MRP.
+            chip::System::EventLoopProfiler::Config config;
+            config.mStallThreshold = chip::System::Clock::Milliseconds32(200);
+            chip::System::EventLoopProfiler::Instance().Enable(config);
+            chip::Tracing::Register(mEventLoopLabels);
+            mEventLoopProfiling = true;
+        }
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+#if ENABLE_BINARY_TRACING
+        else if (StartsWith(value, "binary:"))
+        {
+            std::string fileName(value.data() + 7, value.size() - 7);
+
+            CHIP_ERROR err = mBinaryBackend.OpenFile(fileName.c_str());
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(AppServer, "Failed to open binary trace output: %" CHIP_ERROR_FORMAT, err.Format());
+                continue;
+            }
+            chip::Tracing::Register(mBinaryBackend);
+        }
+#endif // ENABLE_BINARY_TRACING
 #if ENABLE_PERFETTO_TRACING
         else if (value.data_equal(CharSpan::fromCharString("perfetto")))
         {
@@ -112,6 +146,24 @@ void TracingSetup::StopTracing()
 
 #endif
 
+#if ENABLE_BINARY_TRACING
+    chip::Tracing::Unregister(mBinaryBackend);
+#endif
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+    if (mEventLoopProfiling)
+    {
+        chip::System::EventLoopProfiler::Instance().Disable();
+        chip::System::EventLoopProfiler::Instance().LogStats();
+        chip::Tracing::Unregister(mEventLoopLabels);
+        mEventLoopProfiling = false;
+    }
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
+    // The periodic export may run without the registry being a tracing backend, so stop it explicitly while the
+    // system layer is still alive.
+    chip::Tracing::Metrics::MetricsRegistry::Instance().StopPeriodicExport();
+    chip::Tracing::Unregister(chip::Tracing::Metrics::MetricsRegistry::Instance());
     chip::Tracing::Unregister(mJsonBackend);
 }
 
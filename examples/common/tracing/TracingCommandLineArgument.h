@@ -19,21 +19,43 @@
 
 #include "tracing/enabled_features.h"
 
+#include <system/SystemConfig.h>
 #include <tracing/json/json_tracing.h>
+#include <tracing/metrics/event_loop_labels.h>
+
+#if ENABLE_BINARY_TRACING
+#include <tracing/binary/binary_tracing.h> // nogncheck
+#endif
 
 #if ENABLE_PERFETTO_TRACING
 #include <tracing/perfetto/file_output.h>      // nogncheck
 #include <tracing/perfetto/perfetto_tracing.h> // nogncheck
 #endif
 
-/// A string with supported command line tracing targets
-/// to be pretty-printed in help strings if needed
+#if ENABLE_BINARY_TRACING
+#define BINARY_COMMAND_LINE_TRACING_TARGETS ", binary:<path>"
+#else
+#define BINARY_COMMAND_LINE_TRACING_TARGETS ""
+#endif
+
 #if ENABLE_PERFETTO_TRACING
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>, perfetto, perfetto:<path>"
+#define PERFETTO_COMMAND_LINE_TRACING_TARGETS ", perfetto, perfetto:<path>"
 #else
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>"
+#define PERFETTO_COMMAND_LINE_TRACING_TARGETS ""
 #endif
 
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+#define EVENT_LOOP_COMMAND_LINE_TRACING_TARGETS ", event-loop"
+#else
+#define EVENT_LOOP_COMMAND_LINE_TRACING_TARGETS ""
+#endif
+
+/// A string with supported command line tracing targets
+/// to be pretty-printed in help strings if needed
+#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS                                                                                     \
+    "json:log, json:<path>, metrics" BINARY_COMMAND_LINE_TRACING_TARGETS PERFETTO_COMMAND_LINE_TRACING_TARGETS                     \
+        EVENT_LOOP_COMMAND_LINE_TRACING_TARGETS
+
 namespace chip {
 namespace CommandLineApp {
 
@@ -59,6 +81,15 @@ public:
 private:
     ::chip::Tracing::Json::JsonBackend mJsonBackend;
 
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+    ::chip::Tracing::Metrics::EventLoopLabels mEventLoopLabels;
+    bool mEventLoopProfiling = false;
+#endif
+
+#if ENABLE_BINARY_TRACING
+    ::chip::Tracing::Binary::BinaryBackend mBinaryBackend;
+#endif
+
 #if ENABLE_PERFETTO_TRACING
     chip::Tracing::Perfetto::FileTraceOutput mPerfettoFileOutput;
     chip::Tracing::Perfetto::PerfettoBackend mPerfettoBackend;
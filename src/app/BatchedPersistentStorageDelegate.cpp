@@ -0,0 +1,267 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/BatchedPersistentStorageDelegate.h>
+
+#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR BatchedPersistentStorageDelegate::Init(PersistentStorageDelegate * storage, System::Clock::Milliseconds32 flushInterval)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mStorage       = storage;
+    mFlushInterval = flushInterval;
+    return CHIP_NO_ERROR;
+}
+
+void BatchedPersistentStorageDelegate::Shutdown()
+{
+    VerifyOrReturn(mStorage != nullptr);
+
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to write %u pending values on shutdown: %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(GetPendingWriteCount()), err.Format());
+    }
+
+    DiscardPendingWrites();
+    mStorage = nullptr;
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::Flush()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CancelFlush();
+    VerifyOrReturnError(GetPendingWriteCount() > 0, CHIP_NO_ERROR);
+
+    CHIP_ERROR err = FlushInTransaction();
+    if (err == CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        err = FlushOneByOne();
+    }
+
+    mMetrics.mFlushes++;
+    if (err != CHIP_NO_ERROR)
+    {
+        // The values that could not be written are retried on the next flush.
+        mMetrics.mFailedFlushes++;
+        ScheduleFlush();
+    }
+    return err;
+}
+
+void BatchedPersistentStorageDelegate::DiscardPendingWrites()
+{
+    CancelFlush();
+    mPendingWrites.ReleaseAll();
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::SyncGetKeyValue(const char * key, void * buffer, uint16_t & size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    PendingWrite * pending = FindPendingWrite(key);
+    if (pending == nullptr)
+    {
+        return mStorage->SyncGetKeyValue(key, buffer, size);
+    }
+
+    // Same semantics as the decorated storage: the value is truncated to the size of the buffer.
+    uint16_t valueSize = static_cast<uint16_t>(pending->mValue.AllocatedSize());
+    ReturnErrorCodeIf(size == 0 && valueSize == 0, CHIP_NO_ERROR);
+    ReturnErrorCodeIf(buffer == nullptr, size == 0 ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint16_t copySize = std::min(size, valueSize);
+    memcpy(buffer, pending->mValue.Get(), copySize);
+    size = copySize;
+    return (copySize < valueSize) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::SyncSetKeyValue(const char * key, const void * value, uint16_t size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(value != nullptr || size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mMetrics.mWrites++;
+
+    // Keys that do not fit in a pending write, and all values when batching is disabled, are written through.
+    if (mFlushInterval == System::Clock::kZero || strlen(key) > kKeyLengthMax)
+    {
+        mMetrics.mStorageWrites++;
+        return mStorage->SyncSetKeyValue(key, value, size);
+    }
+
+    // The value is copied first, so that a failed allocation leaves the pending values as they are.
+    Platform::ScopedMemoryBufferWithSize<uint8_t> copy;
+    if (size > 0)
+    {
+        VerifyOrReturnError(copy.Alloc(size), CHIP_ERROR_NO_MEMORY);
+        memcpy(copy.Get(), value, size);
+    }
+
+    PendingWrite * pending = FindPendingWrite(key);
+    if (pending != nullptr)
+    {
+        mMetrics.mMergedWrites++;
+    }
+    else
+    {
+        if (GetPendingWriteCount() >= kMaxPendingWrites)
+        {
+            // Make room for the new key; values that could not be written stay pending.
+            LogErrorOnFailure(Flush());
+            VerifyOrReturnError(GetPendingWriteCount() < kMaxPendingWrites, CHIP_ERROR_NO_MEMORY);
+        }
+
+        pending = mPendingWrites.CreateObject();
+        VerifyOrReturnError(pending != nullptr, CHIP_ERROR_NO_MEMORY);
+        Platform::CopyString(pending->mKey, key);
+    }
+    pending->mValue = std::move(copy);
+
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::SyncDeleteKeyValue(const char * key)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    PendingWrite * pending = FindPendingWrite(key);
+    if (pending != nullptr)
+    {
+        mPendingWrites.ReleaseObject(pending);
+    }
+
+    // A key that was only pending did exist, even if the decorated storage does not have it yet.
+    CHIP_ERROR err = mStorage->SyncDeleteKeyValue(key);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND && pending != nullptr)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    return err;
+}
+
+bool BatchedPersistentStorageDelegate::SyncDoesKeyExist(const char * key)
+{
+    VerifyOrReturnValue(mStorage != nullptr, false);
+    return (FindPendingWrite(key) != nullptr) || mStorage->SyncDoesKeyExist(key);
+}
+
+BatchedPersistentStorageDelegate::PendingWrite * BatchedPersistentStorageDelegate::FindPendingWrite(const char * key)
+{
+    PendingWrite * found = nullptr;
+    mPendingWrites.ForEachActiveObject([&](PendingWrite * pending) {
+        if (strcmp(pending->mKey, key) == 0)
+        {
+            found = pending;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::FlushInTransaction()
+{
+    ReturnErrorOnFailure(mStorage->SyncBeginTransaction());
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    mPendingWrites.ForEachActiveObject([&](PendingWrite * pending) {
+        err =
+            mStorage->SyncSetKeyValue(pending->mKey, pending->mValue.Get(), static_cast<uint16_t>(pending->mValue.AllocatedSize()));
+        return (err == CHIP_NO_ERROR) ? Loop::Continue : Loop::Break;
+    });
+    if (err == CHIP_NO_ERROR)
+    {
+        err = mStorage->SyncCommitTransaction();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        // Nothing was written: all the values stay pending.
+        mStorage->SyncAbortTransaction();
+        return err;
+    }
+
+    mMetrics.mStorageWrites += static_cast<uint32_t>(GetPendingWriteCount());
+    mPendingWrites.ReleaseAll();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BatchedPersistentStorageDelegate::FlushOneByOne()
+{
+    CHIP_ERROR result = CHIP_NO_ERROR;
+    mPendingWrites.ForEachActiveObject([&](PendingWrite * pending) {
+        CHIP_ERROR err =
+            mStorage->SyncSetKeyValue(pending->mKey, pending->mValue.Get(), static_cast<uint16_t>(pending->mValue.AllocatedSize()));
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "Failed to write pending value of key %s: %" CHIP_ERROR_FORMAT, pending->mKey, err.Format());
+            result = err;
+            return Loop::Continue;
+        }
+
+        mMetrics.mStorageWrites++;
+        mPendingWrites.ReleaseObject(pending);
+        return Loop::Continue;
+    });
+    return result;
+}
+
+void BatchedPersistentStorageDelegate::ScheduleFlush()
+{
+    VerifyOrReturn(!mFlushScheduled);
+
+    CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(mFlushInterval, OnFlushTimerExpired, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        // The values stay pending until the next write, Flush() or Shutdown().
+        ChipLogError(AppServer, "Failed to schedule writing pending values: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mFlushScheduled = true;
+}
+
+void BatchedPersistentStorageDelegate::CancelFlush()
+{
+    VerifyOrReturn(mFlushScheduled);
+
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimerExpired, this);
+    mFlushScheduled = false;
+}
+
+void BatchedPersistentStorageDelegate::OnFlushTimerExpired(System::Layer * layer, void * context)
+{
+    auto * storage           = static_cast<BatchedPersistentStorageDelegate *>(context);
+    storage->mFlushScheduled = false;
+    LogErrorOnFailure(storage->Flush());
+}
+
+} // namespace app
+} // namespace chip
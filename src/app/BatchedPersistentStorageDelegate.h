@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Decorator for a PersistentStorageDelegate that keeps written values in
+ * memory and writes them to the decorated storage in batches.
+ *
+ * This reduces flash wear and the time spent in storage when the same keys are
+ * written in bursts, e.g. attribute values persisted by
+ * DefaultAttributePersistenceProvider during a scene recall, a level transition
+ * or bridge updates:
+ *
+ * - The value written last for a key replaces the one pending for it, so only
+ *   the last value of a burst is stored.
+ * - Pending values are written a flush interval after the first of them was
+ *   written, when the pending values fill up, on Flush() and on Shutdown().
+ * - When the decorated storage supports transactions, all pending values are
+ *   written in a single one.
+ *
+ * Reads return pending values.  Deletes are applied to the decorated storage
+ * right away.  Pending values are lost on power loss, so this is meant for
+ * values that can lag behind, such as attribute values, and not for security
+ * or commissioning state.
+ */
+class BatchedPersistentStorageDelegate : public PersistentStorageDelegate
+{
+public:
+    static constexpr System::Clock::Milliseconds32 kDefaultFlushInterval =
+        System::Clock::Milliseconds32(CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS);
+
+    struct Metrics
+    {
+        // Values written to this object.
+        uint32_t mWrites = 0;
+        // Values that replaced a pending value of the same key, i.e. storage writes saved.
+        uint32_t mMergedWrites = 0;
+        // Values written to the decorated storage.
+        uint32_t mStorageWrites = 0;
+        // Batches of pending values written to the decorated storage, and how many of them failed.
+        uint32_t mFlushes       = 0;
+        uint32_t mFailedFlushes = 0;
+    };
+
+    BatchedPersistentStorageDelegate() = default;
+    ~BatchedPersistentStorageDelegate() override { Shutdown(); }
+
+    BatchedPersistentStorageDelegate(const BatchedPersistentStorageDelegate &)             = delete;
+    BatchedPersistentStorageDelegate & operator=(const BatchedPersistentStorageDelegate &) = delete;
+
+    // Passed-in storage must outlive this object.
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Clock::Milliseconds32 flushInterval = kDefaultFlushInterval);
+
+    /**
+     * Writes the pending values, and stops batching.
+     */
+    void Shutdown();
+
+    /**
+     * Writes the pending values without waiting for the flush interval.
+     * Values that could not be written stay pending.
+     */
+    CHIP_ERROR Flush();
+
+    /**
+     * Drops the pending values, e.g. when the decorated storage is about to be
+     * erased by a factory reset.
+     */
+    void DiscardPendingWrites();
+
+    size_t GetPendingWriteCount() const { return mPendingWrites.Allocated(); }
+    const Metrics & GetMetrics() const { return mMetrics; }
+
+    // PersistentStorageDelegate implementation.
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override;
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override;
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override;
+    bool SyncDoesKeyExist(const char * key) override;
+
+private:
+    static constexpr size_t kMaxPendingWrites = CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_MAX_PENDING_WRITES;
+
+    struct PendingWrite
+    {
+        char mKey[kKeyLengthMax + 1];
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    };
+
+    PendingWrite * FindPendingWrite(const char * key);
+    CHIP_ERROR FlushInTransaction();
+    CHIP_ERROR FlushOneByOne();
+    void ScheduleFlush();
+    void CancelFlush();
+    static void OnFlushTimerExpired(System::Layer * layer, void * context);
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    System::Clock::Milliseconds32 mFlushInterval{ kDefaultFlushInterval };
+    ObjectPool<PendingWrite, kMaxPendingWrites> mPendingWrites;
+    Metrics mMetrics;
+    bool mFlushScheduled = false;
+};
+
+} // namespace app
+} // namespace chip
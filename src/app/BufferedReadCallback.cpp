@@ -24,7 +24,6 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
-#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace app {
@@ -46,89 +45,110 @@ void BufferedReadCallback::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
+namespace {
+
+//
+// Frame the buffered list items as an anonymous TLV array (the anonymous tag control bits are all zero).
+//
+const uint8_t kListStart[] = { static_cast<uint8_t>(TLV::TLVElementType::Array) };
+const uint8_t kListEnd[]   = { static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer) };
+
+//
+// Copy the list item the reader is positioned on into the free space at the end of the buffer. The reader passed
+// in is left untouched, so that the copy can be attempted again elsewhere if the item does not fit.
+//
+CHIP_ERROR AppendListItem(System::PacketBufferHandle & handle, const TLV::TLVReader & reader)
 {
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    TLV::TLVReader itemReader;
+    TLV::TLVWriter writer;
 
-    //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
-    //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
-    //
-    size_t totalBufSize = 0;
+    itemReader.Init(reader);
+    writer.Init(handle->Start() + handle->DataLength(), handle->AvailableDataLength());
+
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), itemReader));
+
+    handle->SetDataLength(handle->DataLength() + writer.GetLengthWritten());
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+uint32_t BufferedReadCallback::ListBackingStore::GetTotalLength() const
+{
+    size_t totalLength = sizeof(kListStart) + sizeof(kListEnd);
     for (const auto & packetBuffer : mBufferedList)
     {
-        totalBufSize += packetBuffer->TotalLength();
+        totalLength += packetBuffer->DataLength();
     }
 
-    //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
-    //
-    totalBufSize += 4;
-
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    return static_cast<uint32_t>(totalLength);
+}
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+CHIP_ERROR BufferedReadCallback::ListBackingStore::OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
+{
+    bufStart = kListStart;
+    bufLen   = sizeof(kListStart);
+    return CHIP_NO_ERROR;
+}
 
-    for (auto & bufHandle : mBufferedList)
+CHIP_ERROR BufferedReadCallback::ListBackingStore::GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart,
+                                                                 uint32_t & bufLen)
+{
+    //
+    // Find the buffer that ends where the reader stopped and hand out the one after it. Each buffered item is at
+    // most an MTU in size and items are packed together, so this list is short even for large lists.
+    //
+    auto next = mBufferedList.begin();
+    if (bufStart != kListStart + sizeof(kListStart))
     {
-        System::PacketBufferTLVReader reader;
+        while (next != mBufferedList.end() && bufStart != (*next)->Start() + (*next)->DataLength())
+        {
+            ++next;
+        }
 
-        reader.Init(std::move(bufHandle));
+        if (next == mBufferedList.end())
+        {
+            // Either past the end of the list, or a position we don't know about.
+            bufLen = 0;
+            return CHIP_NO_ERROR;
+        }
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+        ++next;
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
-
-    writer.Finalize(backingBuffer);
-
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+    if (next == mBufferedList.end())
+    {
+        bufStart = kListEnd;
+        bufLen   = sizeof(kListEnd);
+    }
+    else
+    {
+        bufStart = (*next)->Start();
+        bufLen   = static_cast<uint32_t>((*next)->DataLength());
+    }
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
-    System::PacketBufferTLVWriter writer;
-    System::PacketBufferHandle handle;
+    //
+    // Pack the item after the previously buffered ones if there is room left for it. Failing that (which includes
+    // not knowing the size of the item up front), move on to a fresh buffer. Items are never split across buffers.
+    //
+    if (!mBufferedList.empty() && AppendListItem(mBufferedList.back(), reader) == CHIP_NO_ERROR)
+    {
+        return CHIP_NO_ERROR;
+    }
 
     //
     // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
     // data received over the wire, which should always fit within that).
     //
-    // We could have snapshotted the reader at its current position, advanced it past the current element
-    // and computed the delta in its read point to figure out the size of the element before allocating
-    // our target buffer. However, the reader's current position is already set past the control octet
-    // and the tag. Consequently, the computed size is always going to omit the sizes of these two parts of the
-    // TLV element. Since the tag can vary in size, for now, let's just do the safe thing. In the future, if this is a problem,
-    // we can improve this.
-    //
-    handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    System::PacketBufferHandle handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
     VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
 
-    writer.Init(std::move(handle), false);
-
-    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    ReturnErrorOnFailure(writer.Finalize(&handle));
-
-    // Compact the buffer down to a more reasonably sized packet buffer
-    // if we can.
-    //
-    handle.RightSize();
+    ReturnErrorOnFailure(AppendListItem(handle, reader));
 
     mBufferedList.push_back(std::move(handle));
 
@@ -202,9 +222,10 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     }
 
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    ListBackingStore backingStore(mBufferedList);
+    TLV::TLVReader reader;
 
-    ReturnErrorOnFailure(GenerateListTLV(reader));
+    ReturnErrorOnFailure(reader.Init(backingStore, backingStore.GetTotalLength()));
 
     //
     // Update the list operation to now reflect the delivery of the entire list
@@ -32,10 +32,13 @@ namespace app {
 
 /*
  * This is an adapter that intercepts calls that deliver data from the ReadClient,
- * selectively buffers up list chunks in TLV and reconstitutes them into a singular, contiguous TLV array
+ * selectively buffers up list chunks in TLV and presents them as a singular TLV array
  * upon completion of delivery of all chunks. This is then delivered to a compliant ReadClient::Callback
  * without any awareness on their part that chunking happened.
  *
+ * The list items are read in place from the buffers they were stored in; they are not copied again
+ * into a contiguous buffer before delivery.
+ *
  */
 class BufferedReadCallback : public ReadClient::Callback
 {
@@ -44,9 +47,45 @@ public:
 
 private:
     /*
-     * Generates the reconsistuted TLV array from the stored individual list elements
+     * Backing store that presents the buffered list items as a single anonymous TLV array, by framing them
+     * with a start-of-array and an end-of-container element.
+     *
+     * No per-reader state is kept: the buffer that follows is looked up from the end of the one the reader
+     * just consumed. Readers backed by this store can therefore be copied freely (e.g. by a DecodableList),
+     * which is not possible with a TLVPacketBufferBackingStore over a chain of buffers.
+     *
+     * List items are never split across buffers, so string values within an item are always contiguous.
      */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
+    class ListBackingStore : public TLV::TLVBackingStore
+    {
+    public:
+        ListBackingStore(const std::vector<System::PacketBufferHandle> & bufferedList) : mBufferedList(bufferedList) {}
+
+        /*
+         * Total length of the TLV array, including its start and end elements.
+         */
+        uint32_t GetTotalLength() const;
+
+        CHIP_ERROR OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+
+        CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        bool GetNewBufferWillAlwaysFail() override { return true; }
+
+    private:
+        const std::vector<System::PacketBufferHandle> & mBufferedList;
+    };
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -121,8 +160,9 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, copy the list item where the reader is positioned
+     * into the last buffer of our buffered list if it fits there, or into a newly allocated packet buffer
+     * that is then added to our buffered list for tracking.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
@@ -0,0 +1,395 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEConnectionScheduler.h>
+
+#include <algorithm>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/metric_event.h>
+
+using chip::AddressResolve::NodeLookupRequest;
+using chip::AddressResolve::Resolver;
+using chip::AddressResolve::ResolveResult;
+
+namespace chip {
+
+CHIP_ERROR CASEConnectionScheduler::Init(const Params & params)
+{
+    VerifyOrReturnError(!mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(params.sessionManager != nullptr && params.fabricTable != nullptr && params.systemLayer != nullptr,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(params.maxConcurrentLookups > 0 && params.maxConcurrentHandshakes > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mParams      = params;
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+void CASEConnectionScheduler::Shutdown()
+{
+    VerifyOrReturn(mInitialized);
+
+    if (mFailureNotifyPending)
+    {
+        mParams.systemLayer->CancelTimer(HandleDeferredFailures, this);
+        mFailureNotifyPending = false;
+    }
+
+    if (mEntryCount > 0)
+    {
+        MATTER_LOG_METRIC_END(Tracing::kMetricCASEConnectionSchedulerDrain, CHIP_ERROR_CANCELLED);
+    }
+
+    mEntries.ForEachActiveObject([&](Entry * entry) {
+        Release(*entry);
+        return Loop::Continue;
+    });
+
+    mInitialized = false;
+}
+
+CHIP_ERROR CASEConnectionScheduler::RequestSession(const ScopedNodeId & peerId, Priority priority,
+                                                   Callback::Callback<OnDeviceConnected> * onConnection,
+                                                   Callback::Callback<OperationalSessionSetup::OnSetupFailure> * onFailure)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+
+    if (mEntryCount >= kQueueSize)
+    {
+        mStats.rejected++;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    Entry * entry = mEntries.CreateObject(*this, peerId, priority, mNextSequence++, onConnection, onFailure);
+    if (entry == nullptr)
+    {
+        mStats.rejected++;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    if (mEntryCount == 0)
+    {
+        mBatchStart = System::SystemClock().GetMonotonicTimestamp();
+        MATTER_LOG_METRIC_BEGIN(Tracing::kMetricCASEConnectionSchedulerDrain);
+    }
+
+    mEntryCount++;
+    mStats.requested++;
+    mStats.peakQueueDepth = std::max(mStats.peakQueueDepth, static_cast<uint16_t>(mEntryCount));
+
+    const bool wasInApiCall = mInApiCall;
+    mInApiCall              = true;
+    Dispatch();
+    mInApiCall = wasInApiCall;
+    return CHIP_NO_ERROR;
+}
+
+void CASEConnectionScheduler::CancelRequests(const ScopedNodeId & peerId)
+{
+    VerifyOrReturn(mEntryCount > 0);
+
+    mEntries.ForEachActiveObject([&](Entry * entry) {
+        if (entry->GetPeerId() == peerId)
+        {
+            Release(*entry);
+        }
+        return Loop::Continue;
+    });
+
+    if (mEntryCount == 0)
+    {
+        MATTER_LOG_METRIC_END(Tracing::kMetricCASEConnectionSchedulerDrain, CHIP_ERROR_CANCELLED);
+        return;
+    }
+
+    // Cancelling may have freed lookup or handshake slots.
+    const bool wasInApiCall = mInApiCall;
+    mInApiCall              = true;
+    Dispatch();
+    mInApiCall = wasInApiCall;
+}
+
+CHIP_ERROR CASEConnectionScheduler::StartLookup(Entry & entry)
+{
+    // A peer we already have a session with needs no lookup; the handshake
+    // stage will attach to the existing session.
+    Transport::PeerAddress address;
+    if (mParams.sessionManager->GetPeerAddress(entry.GetPeerId(), address) == CHIP_NO_ERROR)
+    {
+        OnLookupComplete(entry, CHIP_NO_ERROR);
+        return CHIP_NO_ERROR;
+    }
+
+    const FabricInfo * fabricInfo = mParams.fabricTable->FindFabricWithIndex(entry.GetPeerId().GetFabricIndex());
+    VerifyOrReturnError(fabricInfo != nullptr, CHIP_ERROR_INVALID_FABRIC_INDEX);
+
+    NodeLookupRequest request(PeerId(fabricInfo->GetCompressedFabricId(), entry.GetPeerId().GetNodeId()));
+    return Resolver::Instance().LookupNode(request, entry.mLookupHandle);
+}
+
+void CASEConnectionScheduler::CancelLookup(Entry & entry)
+{
+    if (entry.mLookupHandle.IsActive())
+    {
+        LogErrorOnFailure(Resolver::Instance().CancelLookup(entry.mLookupHandle, Resolver::FailureCallback::Skip));
+    }
+}
+
+void CASEConnectionScheduler::StartHandshake(Entry & entry)
+{
+    // May complete synchronously (e.g. for an existing session), in which case
+    // `entry` is released before this returns.
+    mParams.sessionManager->FindOrEstablishSession(entry.GetPeerId(), &entry.mConnectedCallback, &entry.mSetupFailureCallback);
+}
+
+void CASEConnectionScheduler::OnLookupComplete(Entry & entry, CHIP_ERROR error)
+{
+    VerifyOrDie(entry.mState == Entry::State::kResolving);
+    mActiveLookups--;
+    entry.mState = Entry::State::kResolved;
+
+    if (error != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Scheduled lookup for " ChipLogFormatScopedNodeId " failed: %" CHIP_ERROR_FORMAT,
+                     ChipLogValueScopedNodeId(entry.GetPeerId()), error.Format());
+        Retire(entry, error, SessionEstablishmentStage::kNotInKeyExchange);
+    }
+
+    Dispatch();
+}
+
+void CASEConnectionScheduler::OnHandshakeComplete(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage)
+{
+    VerifyOrDie(entry.mState == Entry::State::kConnecting);
+    Retire(entry, error, stage);
+    Dispatch();
+}
+
+CASEConnectionScheduler::Entry * CASEConnectionScheduler::FindEntry(const ScopedNodeId & peerId, Entry::State state)
+{
+    Entry * found = nullptr;
+    mEntries.ForEachActiveObject([&](Entry * entry) {
+        if (entry->GetPeerId() == peerId && entry->GetState() == state)
+        {
+            found = entry;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+void CASEConnectionScheduler::Retire(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage)
+{
+    if (error == CHIP_NO_ERROR)
+    {
+        mStats.connected++;
+    }
+    else
+    {
+        mStats.failed++;
+    }
+
+    // The caller of RequestSession or CancelRequests must not be re-entered
+    // through its own failure callback.
+    if (error != CHIP_NO_ERROR && entry.mOnFailure != nullptr && mInApiCall)
+    {
+        DeferFailure(entry, error, stage);
+        return;
+    }
+
+    Finish(entry, error, stage);
+}
+
+void CASEConnectionScheduler::Finish(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage)
+{
+    ScopedNodeId peerId = entry.GetPeerId();
+    auto * onFailure    = entry.mOnFailure;
+
+    Release(entry);
+
+    if (mEntryCount == 0)
+    {
+        mStats.lastDrainDuration =
+            std::chrono::duration_cast<System::Clock::Milliseconds32>(System::SystemClock().GetMonotonicTimestamp() - mBatchStart);
+        MATTER_LOG_METRIC_END(Tracing::kMetricCASEConnectionSchedulerDrain, CHIP_NO_ERROR);
+        ChipLogProgress(Discovery, "CASE connection scheduler drained in %" PRIu32 " ms", mStats.lastDrainDuration.count());
+    }
+
+    if (error != CHIP_NO_ERROR && onFailure != nullptr)
+    {
+        OperationalSessionSetup::ConnectionFailureInfo failureInfo(peerId, error, stage);
+        onFailure->mCall(onFailure->mContext, failureInfo);
+    }
+}
+
+void CASEConnectionScheduler::Release(Entry & entry)
+{
+    switch (entry.mState)
+    {
+    case Entry::State::kResolving:
+        CancelLookup(entry);
+        mActiveLookups--;
+        break;
+    case Entry::State::kConnecting:
+        mActiveHandshakes--;
+        break;
+    default:
+        break;
+    }
+
+    mEntryCount--;
+    // Destroying the entry cancels its CASESessionManager callbacks.
+    mEntries.ReleaseObject(&entry);
+}
+
+void CASEConnectionScheduler::DeferFailure(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage)
+{
+    // A failed lookup has already given its slot back.
+    if (entry.mState == Entry::State::kConnecting)
+    {
+        mActiveHandshakes--;
+    }
+
+    entry.mState = Entry::State::kFailed;
+    entry.mError = error;
+    entry.mStage = stage;
+
+    VerifyOrReturn(!mFailureNotifyPending);
+
+    CHIP_ERROR err = mParams.systemLayer->ScheduleWork(HandleDeferredFailures, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to defer CASE connection failure: %" CHIP_ERROR_FORMAT, err.Format());
+        Finish(entry, error, stage);
+        return;
+    }
+    mFailureNotifyPending = true;
+}
+
+void CASEConnectionScheduler::HandleDeferredFailures(System::Layer * systemLayer, void * context)
+{
+    auto * scheduler                 = static_cast<CASEConnectionScheduler *>(context);
+    scheduler->mFailureNotifyPending = false;
+
+    // Failure callbacks may queue or cancel requests, so look the next entry up
+    // again every time.
+    Entry * entry;
+    while ((entry = scheduler->NextInState(Entry::State::kFailed)) != nullptr)
+    {
+        scheduler->Finish(*entry, entry->mError, entry->mStage);
+    }
+}
+
+CASEConnectionScheduler::Entry * CASEConnectionScheduler::NextInState(Entry::State state)
+{
+    Entry * next = nullptr;
+    mEntries.ForEachActiveObject([&](Entry * entry) {
+        if (entry->GetState() == state && (next == nullptr || entry->IsBefore(*next)))
+        {
+            next = entry;
+        }
+        return Loop::Continue;
+    });
+    return next;
+}
+
+void CASEConnectionScheduler::Dispatch()
+{
+    // Stage hooks may complete synchronously and call back into Dispatch; let
+    // the outermost call pick up the work instead of recursing.
+    if (mDispatching)
+    {
+        mDispatchPending = true;
+        return;
+    }
+
+    mDispatching = true;
+    do
+    {
+        mDispatchPending = false;
+
+        while (mActiveHandshakes < mParams.maxConcurrentHandshakes)
+        {
+            Entry * entry = NextInState(Entry::State::kResolved);
+            if (entry == nullptr)
+            {
+                break;
+            }
+
+            entry->mState = Entry::State::kConnecting;
+            mActiveHandshakes++;
+            StartHandshake(*entry);
+        }
+
+        while (mActiveLookups < mParams.maxConcurrentLookups)
+        {
+            Entry * entry = NextInState(Entry::State::kQueued);
+            if (entry == nullptr)
+            {
+                break;
+            }
+
+            entry->mState = Entry::State::kResolving;
+            mActiveLookups++;
+            CHIP_ERROR err = StartLookup(*entry);
+            if (err != CHIP_NO_ERROR)
+            {
+                OnLookupComplete(*entry, err);
+            }
+        }
+    } while (mDispatchPending);
+    mDispatching = false;
+}
+
+void CASEConnectionScheduler::Entry::OnNodeAddressResolved(const PeerId & peerId, const ResolveResult & result)
+{
+    mScheduler.OnLookupComplete(*this, CHIP_NO_ERROR);
+}
+
+void CASEConnectionScheduler::Entry::OnNodeAddressResolutionFailed(const PeerId & peerId, CHIP_ERROR reason)
+{
+    mScheduler.OnLookupComplete(*this, reason);
+}
+
+void CASEConnectionScheduler::Entry::HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                                     const SessionHandle & sessionHandle)
+{
+    auto * entry                        = static_cast<Entry *>(context);
+    CASEConnectionScheduler & scheduler = entry->mScheduler;
+    auto * onConnection                 = entry->mOnConnection;
+
+    scheduler.OnHandshakeComplete(*entry, CHIP_NO_ERROR);
+    // `entry` is gone now.
+
+    if (onConnection != nullptr)
+    {
+        onConnection->mCall(onConnection->mContext, exchangeMgr, sessionHandle);
+    }
+}
+
+void CASEConnectionScheduler::Entry::HandleSetupFailure(void * context,
+                                                        const OperationalSessionSetup::ConnectionFailureInfo & failureInfo)
+{
+    auto * entry = static_cast<Entry *>(context);
+    entry->mScheduler.OnHandshakeComplete(*entry, failureInfo.error, failureInfo.sessionStage);
+}
+
+} // namespace chip
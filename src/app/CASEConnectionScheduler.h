@@ -0,0 +1,277 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetup.h>
+#include <credentials/FabricTable.h>
+#include <lib/address_resolve/AddressResolve.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/Pool.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+
+/**
+ * Schedules operational session establishment towards many peers at once.
+ *
+ * Establishing a session consists of an operational DNS-SD lookup followed by
+ * a CASE handshake.  Calling CASESessionManager::FindOrEstablishSession for a
+ * large set of peers at the same time exhausts the OperationalSessionSetup pool
+ * (CHIP_CONFIG_DEVICE_MAX_ACTIVE_DEVICES) and overflows the DNS-SD resolver's
+ * retry queue, so most of the requests either fail with CHIP_ERROR_NO_MEMORY or
+ * keep evicting each other's queries.
+ *
+ * The scheduler keeps a bounded queue of connection requests and moves them
+ * through two independently bounded stages:
+ *   - at most `maxConcurrentLookups` address lookups are in progress, and
+ *   - at most `maxConcurrentHandshakes` resolved peers are handed over to
+ *     CASESessionManager for the CASE handshake.
+ *
+ * Requests are served by priority, and in FIFO order within a priority level.
+ * When the queue is full, RequestSession returns CHIP_ERROR_NO_MEMORY and the
+ * caller is expected to retry once earlier requests have completed (see
+ * GetAvailableQueueSlots).
+ *
+ * The CASE stage performs its own lookup through AddressResolve.  That lookup
+ * is expected to be answered from the resolver cache populated by the first
+ * stage, so it does not generate additional DNS-SD traffic.
+ *
+ * The time between the scheduler leaving idle and draining its queue again is
+ * reported through the kMetricCASEConnectionSchedulerDrain metric and GetStats().
+ *
+ * The scheduler is opt-in: CASESessionManager and the controller do not route
+ * their own session requests through it.  Applications that (re)connect to
+ * many peers at once create one on top of their CASESessionManager and call
+ * RequestSession instead of FindOrEstablishSession.
+ */
+class CASEConnectionScheduler
+{
+public:
+    enum class Priority : uint8_t
+    {
+        kLow,
+        kNormal,
+        kHigh,
+    };
+
+    struct Params
+    {
+        CASESessionManager * sessionManager = nullptr;
+        const FabricTable * fabricTable     = nullptr;
+        System::Layer * systemLayer         = nullptr;
+
+        uint8_t maxConcurrentLookups    = CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_LOOKUPS;
+        uint8_t maxConcurrentHandshakes = CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_HANDSHAKES;
+    };
+
+    struct Stats
+    {
+        uint32_t requested      = 0; // Requests accepted into the queue
+        uint32_t rejected       = 0; // Requests refused because the queue was full
+        uint32_t connected      = 0; // Requests that completed with a session
+        uint32_t failed         = 0; // Requests that completed with an error
+        uint16_t peakQueueDepth = 0; // Largest number of requests pending at once
+
+        // Time from the first request of the last batch until every request of
+        // that batch completed.
+        System::Clock::Milliseconds32 lastDrainDuration = System::Clock::kZero;
+    };
+
+    static constexpr size_t kQueueSize = CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_QUEUE_SIZE;
+
+    CASEConnectionScheduler() = default;
+    virtual ~CASEConnectionScheduler() { Shutdown(); }
+
+    CASEConnectionScheduler(const CASEConnectionScheduler &)             = delete;
+    CASEConnectionScheduler & operator=(const CASEConnectionScheduler &) = delete;
+
+    CHIP_ERROR Init(const Params & params);
+
+    /**
+     * Drops every pending and in-progress request without notifying its
+     * callbacks.
+     */
+    void Shutdown();
+
+    /**
+     * Queue a session establishment request for `peerId`.
+     *
+     * `onConnection` and `onFailure` are optional and are called exactly once
+     * when the request completes, unless it is cancelled first.  The callback
+     * objects must outlive the request.  `onFailure` is never called from
+     * within RequestSession or CancelRequests: a request that fails while one
+     * of them runs is reported from a later iteration of the event loop.
+     *
+     * @retval CHIP_NO_ERROR          the request was queued.
+     * @retval CHIP_ERROR_NO_MEMORY   the queue is full (back-pressure).
+     * @retval CHIP_ERROR_INCORRECT_STATE the scheduler is not initialized.
+     */
+    CHIP_ERROR RequestSession(const ScopedNodeId & peerId, Priority priority, Callback::Callback<OnDeviceConnected> * onConnection,
+                              Callback::Callback<OperationalSessionSetup::OnSetupFailure> * onFailure);
+
+    /**
+     * Cancel every request for `peerId` without notifying their callbacks.
+     *
+     * A CASE handshake already handed over to CASESessionManager keeps running,
+     * but its result is no longer reported.
+     */
+    void CancelRequests(const ScopedNodeId & peerId);
+
+    size_t GetAvailableQueueSlots() const { return kQueueSize - mEntryCount; }
+    size_t GetPendingCount() const { return mEntryCount; }
+    uint8_t GetActiveLookupCount() const { return mActiveLookups; }
+    uint8_t GetActiveHandshakeCount() const { return mActiveHandshakes; }
+
+    const Stats & GetStats() const { return mStats; }
+    void ResetStats() { mStats = Stats(); }
+
+protected:
+    class Entry : public AddressResolve::NodeListener
+    {
+    public:
+        enum class State : uint8_t
+        {
+            kQueued,     // Waiting for a lookup slot
+            kResolving,  // Address lookup in progress
+            kResolved,   // Waiting for a handshake slot
+            kConnecting, // Handed over to CASESessionManager
+            kFailed,     // Completed with an error, failure callback not yet called
+        };
+
+        Entry(CASEConnectionScheduler & scheduler, const ScopedNodeId & peerId, Priority priority, uint32_t sequence,
+              Callback::Callback<OnDeviceConnected> * onConnection,
+              Callback::Callback<OperationalSessionSetup::OnSetupFailure> * onFailure) :
+            mScheduler(scheduler), mPeerId(peerId), mOnConnection(onConnection), mOnFailure(onFailure), mSequence(sequence),
+            mPriority(priority), mConnectedCallback(HandleConnected, this), mSetupFailureCallback(HandleSetupFailure, this)
+        {
+            mLookupHandle.SetListener(this);
+        }
+
+        const ScopedNodeId & GetPeerId() const { return mPeerId; }
+        State GetState() const { return mState; }
+
+        // AddressResolve::NodeListener
+        void OnNodeAddressResolved(const PeerId & peerId, const AddressResolve::ResolveResult & result) override;
+        void OnNodeAddressResolutionFailed(const PeerId & peerId, CHIP_ERROR reason) override;
+
+    private:
+        friend class CASEConnectionScheduler;
+
+        static void HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle);
+        static void HandleSetupFailure(void * context, const OperationalSessionSetup::ConnectionFailureInfo & failureInfo);
+
+        /// Returns true if this entry should be served before `other`.
+        bool IsBefore(const Entry & other) const
+        {
+            return (mPriority != other.mPriority) ? (mPriority > other.mPriority) : (mSequence < other.mSequence);
+        }
+
+        CASEConnectionScheduler & mScheduler;
+        ScopedNodeId mPeerId;
+        Callback::Callback<OnDeviceConnected> * mOnConnection;
+        Callback::Callback<OperationalSessionSetup::OnSetupFailure> * mOnFailure;
+        uint32_t mSequence;
+        Priority mPriority;
+        State mState = State::kQueued;
+
+        // Set when the entry is kFailed.
+        CHIP_ERROR mError                = CHIP_NO_ERROR;
+        SessionEstablishmentStage mStage = SessionEstablishmentStage::kNotInKeyExchange;
+
+        AddressResolve::NodeLookupHandle mLookupHandle;
+        Callback::Callback<OnDeviceConnected> mConnectedCallback;
+        Callback::Callback<OperationalSessionSetup::OnSetupFailure> mSetupFailureCallback;
+    };
+
+    /**
+     * Stage hooks.  The default implementations use AddressResolve and
+     * CASESessionManager; tests override them to simulate peers.
+     *
+     * StartLookup must eventually result in exactly one OnLookupComplete call
+     * when it returns CHIP_NO_ERROR.  StartHandshake must eventually result in
+     * exactly one OnHandshakeComplete call (the default implementation does so
+     * through the CASESessionManager callbacks, possibly synchronously).
+     */
+    virtual CHIP_ERROR StartLookup(Entry & entry);
+    virtual void CancelLookup(Entry & entry);
+    virtual void StartHandshake(Entry & entry);
+
+    void OnLookupComplete(Entry & entry, CHIP_ERROR error);
+    void OnHandshakeComplete(Entry & entry, CHIP_ERROR error,
+                             SessionEstablishmentStage stage = SessionEstablishmentStage::kNotInKeyExchange);
+
+    /**
+     * Returns the in-progress entry for `peerId` in state `state`, if any.
+     */
+    Entry * FindEntry(const ScopedNodeId & peerId, Entry::State state);
+
+private:
+    /**
+     * Completes `entry`: updates stats, then releases it and notifies the
+     * failure callback if `error` is not CHIP_NO_ERROR.  Inside RequestSession
+     * or CancelRequests, a failure with a callback is instead deferred (see
+     * DeferFailure).
+     */
+    void Retire(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage);
+
+    /**
+     * Releases `entry`, ends the drain metric if the queue is now empty and
+     * notifies the failure callback if `error` is not CHIP_NO_ERROR.
+     */
+    void Finish(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage);
+    void Release(Entry & entry);
+
+    /**
+     * Frees the lookup or handshake slot of `entry`, marks it kFailed and
+     * schedules HandleDeferredFailures to notify its failure callback.
+     */
+    void DeferFailure(Entry & entry, CHIP_ERROR error, SessionEstablishmentStage stage);
+    static void HandleDeferredFailures(System::Layer * systemLayer, void * context);
+
+    /**
+     * Moves queued entries into free lookup and handshake slots.
+     */
+    void Dispatch();
+    Entry * NextInState(Entry::State state);
+
+    Params mParams;
+    bool mInitialized = false;
+
+    ObjectPool<Entry, kQueueSize> mEntries;
+    size_t mEntryCount        = 0;
+    uint32_t mNextSequence    = 0;
+    uint8_t mActiveLookups    = 0;
+    uint8_t mActiveHandshakes = 0;
+
+    bool mDispatching     = false;
+    bool mDispatchPending = false;
+
+    // True while RequestSession or CancelRequests runs.
+    bool mInApiCall            = false;
+    bool mFailureNotifyPending = false;
+
+    System::Clock::Timestamp mBatchStart = System::Clock::kZero;
+    Stats mStats;
+};
+
+} // namespace chip
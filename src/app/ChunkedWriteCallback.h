@@ -30,6 +30,9 @@ namespace app {
  * - If any element in the list was not successfully written, callback->OnResponse will be called with the first error received.
  * - callback->OnResponse will always have NotList as mListOp since we have merged the chunked responses.
  * The merge logic assumes all list operations are part of list chunking.
+ *
+ * A list that fits in a single AttributeDataIB (which WriteClient attempts first when large payloads are allowed) gets a single
+ * status, and is reported as-is.
  */
 class ChunkedWriteCallback : public WriteClient::Callback
 {
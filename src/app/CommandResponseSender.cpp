@@ -19,6 +19,8 @@
 #include "InteractionModelEngine.h"
 #include "messaging/ExchangeContext.h"
 
+#include <tracing/metric_event.h>
+
 namespace chip {
 namespace app {
 using Status = Protocols::InteractionModel::Status;
@@ -115,6 +117,9 @@ void CommandResponseSender::StartSendingCommandResponses()
 
 void CommandResponseSender::OnDone(CommandHandlerImpl & apCommandObj)
 {
+    MATTER_LOG_METRIC(Tracing::kMetricIMCommandHandling,
+                      Tracing::LatencyMicroseconds(System::SystemClock().GetMonotonicMicroseconds64() - mRequestTimestamp));
+
     if (mState == State::ErrorSentDelayCloseUntilOnDone)
     {
         // We have already sent a message to the client indicating that we are not expecting
@@ -210,6 +215,7 @@ void CommandResponseSender::OnInvokeCommandRequest(Messaging::ExchangeContext *
     // Exchange Manager for unsolicited InvokeRequestMessages.
     mExchangeCtx.Grab(ec);
     mExchangeCtx->WillSendMessage();
+    mRequestTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
 
     // Grabbing Handle to prevent mCommandHandler from calling OnDone before OnInvokeCommandRequest returns.
     // This allows us to send a StatusResponse error instead of any potentially queued up InvokeResponseMessages.
@@ -255,6 +261,7 @@ void CommandResponseSender::TestOnlyInvokeCommandRequestWithFaultsInjected(Messa
 
     mExchangeCtx.Grab(ec);
     mExchangeCtx->WillSendMessage();
+    mRequestTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
 
     mCommandHandler.TestOnlyInvokeCommandRequestWithFaultsInjected(*this, std::move(payload), isTimedInvoke, faultType);
 }
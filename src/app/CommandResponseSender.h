@@ -189,6 +189,9 @@ private:
     Messaging::ExchangeHolder mExchangeCtx;
     State mState = State::ReadyForInvokeResponses;
 
+    // Invoke Request receive time, for the command handling metric.
+    System::Clock::Microseconds64 mRequestTimestamp = System::Clock::kZero;
+
     bool mReportResponseDropped = false;
 };
 
@@ -23,6 +23,7 @@
 #include <platform/LockTracker.h>
 #include <protocols/Protocols.h>
 #include <protocols/interaction_model/Constants.h>
+#include <tracing/metric_event.h>
 
 namespace chip {
 namespace app {
@@ -126,6 +127,7 @@ CHIP_ERROR CommandSender::SendCommandRequestInternal(const SessionHandle & sessi
     VerifyOrReturnError(!mExchangeCtx->IsGroupExchangeContext(), CHIP_ERROR_INVALID_MESSAGE_TYPE);
 
     mExchangeCtx->SetResponseTimeout(timeout.ValueOr(session->ComputeRoundTripTimeout(app::kExpectedIMProcessingTime)));
+    mSendTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
 
     if (mTimedInvokeTimeoutMs.HasValue())
     {
@@ -272,8 +274,14 @@ exit:
     {
         if (err == CHIP_NO_ERROR)
         {
+            MATTER_LOG_METRIC(Tracing::kMetricIMCommandRoundTrip,
+                              Tracing::LatencyMicroseconds(System::SystemClock().GetMonotonicMicroseconds64() - mSendTimestamp));
             FlushNoCommandResponse();
         }
+        else
+        {
+            MATTER_LOG_METRIC(Tracing::kMetricIMCommandRoundTrip, err);
+        }
         Close();
     }
     // Else we got a response to a Timed Request and just sent the invoke.
@@ -340,6 +348,7 @@ void CommandSender::OnResponseTimeout(Messaging::ExchangeContext * apExchangeCon
     ChipLogProgress(DataManagement, "Time out! failed to receive invoke command response from Exchange: " ChipLogFormatExchange,
                     ChipLogValueExchange(apExchangeContext));
 
+    MATTER_LOG_METRIC(Tracing::kMetricIMCommandRoundTrip, CHIP_ERROR_TIMEOUT);
     OnErrorCallback(CHIP_ERROR_TIMEOUT);
     Close();
 }
@@ -661,6 +661,9 @@ private:
 #endif // CHIP_CONFIG_COMMAND_SENDER_BUILTIN_SUPPORT_FOR_BATCHED_COMMANDS
     PendingResponseTracker * mpPendingResponseTracker = nullptr;
 
+    // Invoke Request send time, for the command round trip metric.
+    System::Clock::Microseconds64 mSendTimestamp = System::Clock::kZero;
+
     uint16_t mInvokeResponseMessageCount = 0;
     uint16_t mFinishedCommandCount       = 0;
     uint16_t mRemoteMaxPathsPerInvoke    = 1;
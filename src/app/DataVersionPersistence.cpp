@@ -0,0 +1,590 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/DataVersionPersistence.h>
+
+#include <app/AttributeEncodeState.h>
+#include <app/AttributeValueEncoder.h>
+#include <app/GlobalAttributes.h>
+#include <app/MessageDef/AttributeReportIB.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <app/MessageDef/ReportDataMessage.h>
+#include <app/MessageDef/StatusIB.h>
+#include <app/util/attribute-storage.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace chip {
+namespace app {
+namespace {
+
+DataVersionPersistence * gDataVersionPersistence = nullptr;
+
+// A record is an array with one structure per cluster of the endpoint.
+constexpr TLV::Tag kClusterIdTag   = TLV::ContextTag(1);
+constexpr TLV::Tag kDataVersionTag = TLV::ContextTag(2);
+constexpr TLV::Tag kSnapshotTag    = TLV::ContextTag(3);
+
+constexpr size_t RecordSize(size_t clusterCount)
+{
+    return TLV::EstimateStructOverhead(clusterCount *
+                                       TLV::EstimateStructOverhead(sizeof(ClusterId), sizeof(DataVersion), sizeof(uint64_t)));
+}
+
+// Extra room when reading a record, in case the endpoint had more clusters when it was written (e.g. before a firmware update).
+constexpr size_t kExtraStoredClusters = 4;
+
+// Attribute values are encoded in chunks of this size to compute a snapshot: lists that do not fit are split on item
+// boundaries, like in a chunked report.
+constexpr uint32_t kSnapshotChunkSize = 1024;
+
+// Room kept to close the containers around the attribute reports of a chunk.
+constexpr uint32_t kSnapshotChunkReservedSize = 2 * TLV::EstimateStructOverhead();
+
+/**
+ * TLV backing store hashing everything written to it, so that attribute values
+ * can be added to a snapshot without buffering them.
+ */
+class SnapshotHasher : private TLV::TLVBackingStore
+{
+public:
+    CHIP_ERROR Init()
+    {
+        ReturnErrorOnFailure(mHash.Begin());
+        mWriter.Init(*this);
+        return CHIP_NO_ERROR;
+    }
+
+    TLV::TLVWriter & GetWriter() { return mWriter; }
+
+    CHIP_ERROR Finish(uint64_t & snapshot)
+    {
+        ReturnErrorOnFailure(mWriter.Finalize());
+
+        uint8_t digest[Crypto::kSHA256_Hash_Length];
+        MutableByteSpan digestSpan(digest);
+        ReturnErrorOnFailure(mHash.Finish(digestSpan));
+        snapshot = Encoding::LittleEndian::Get64(digest);
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    CHIP_ERROR OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return GetNewBuffer(writer, bufStart, bufLen);
+    }
+    CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mBuffer;
+        bufLen   = sizeof(mBuffer);
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return mHash.AddData(ByteSpan(bufStart, bufLen));
+    }
+
+    Crypto::Hash_SHA256_stream mHash;
+    TLV::TLVWriter mWriter;
+    uint8_t mBuffer[64];
+};
+
+/**
+ * Adds the attribute reports encoded in a chunk to a snapshot: the list
+ * operation and data of each AttributeDataIB, and the status of each
+ * AttributeStatusIB.  Data versions are left out.
+ */
+CHIP_ERROR AddReportsToSnapshot(const uint8_t * chunk, size_t chunkLength, TLV::TLVWriter & snapshotWriter)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType reportDataType;
+    TLV::TLVType reportsType;
+    reader.Init(chunk, chunkLength);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(reportDataType));
+    ReturnErrorOnFailure(
+        reader.Next(TLV::kTLVType_Array, TLV::ContextTag(to_underlying(ReportDataMessage::Tag::kAttributeReportIBs))));
+    ReturnErrorOnFailure(reader.EnterContainer(reportsType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        AttributeReportIB::Parser report;
+        ReturnErrorOnFailure(report.Init(reader));
+
+        AttributeDataIB::Parser data;
+        err = report.GetAttributeData(&data);
+        if (err == CHIP_NO_ERROR)
+        {
+            AttributePathIB::Parser pathParser;
+            ConcreteDataAttributePath path;
+            TLV::TLVReader dataReader;
+            ReturnErrorOnFailure(data.GetPath(&pathParser));
+            ReturnErrorOnFailure(pathParser.GetConcreteAttributePath(path, AttributePathIB::ValidateIdRanges::kNo));
+            ReturnErrorOnFailure(data.GetData(&dataReader));
+            ReturnErrorOnFailure(snapshotWriter.Put(TLV::AnonymousTag(), to_underlying(path.mListOp)));
+            ReturnErrorOnFailure(snapshotWriter.CopyElement(TLV::AnonymousTag(), dataReader));
+            continue;
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+        AttributeStatusIB::Parser status;
+        StatusIB::Parser statusParser;
+        StatusIB statusIB;
+        ReturnErrorOnFailure(report.GetAttributeStatus(&status));
+        ReturnErrorOnFailure(status.GetErrorStatus(&statusParser));
+        ReturnErrorOnFailure(statusParser.DecodeStatusIB(statusIB));
+        ReturnErrorOnFailure(snapshotWriter.Put(TLV::AnonymousTag(), to_underlying(statusIB.mStatus)));
+        ReturnErrorOnFailure(snapshotWriter.Put(TLV::AnonymousTag(), statusIB.mClusterStatus.ValueOr(0)));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Reads an attribute through the provider, one chunk at a time, and adds its
+ * value to a snapshot.
+ *
+ * Fabric-sensitive fields of fabric-scoped values are not read, as there is no
+ * accessing fabric.
+ */
+CHIP_ERROR AddAttributeToSnapshot(DataModel::Provider & provider, const ConcreteAttributePath & path, uint8_t * chunk,
+                                  TLV::TLVWriter & snapshotWriter)
+{
+    DataModel::ReadAttributeRequest request;
+    AttributeEncodeState state;
+    request.path = path;
+    request.operationFlags.Set(DataModel::OperationFlags::kInternal);
+
+    ReturnErrorOnFailure(snapshotWriter.Put(TLV::AnonymousTag(), path.mAttributeId));
+
+    while (true)
+    {
+        TLV::TLVWriter writer;
+        TLV::TLVType reportDataType;
+        AttributeReportIBs::Builder reports;
+        writer.Init(chunk, kSnapshotChunkSize);
+        ReturnErrorOnFailure(writer.ReserveBuffer(kSnapshotChunkReservedSize));
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, reportDataType));
+        ReturnErrorOnFailure(reports.Init(&writer, to_underlying(ReportDataMessage::Tag::kAttributeReportIBs)));
+
+        AttributeValueEncoder encoder(reports, Access::SubjectDescriptor(), path, 0 /* dataVersion */,
+                                      false /* isFabricFiltered */, state);
+        DataModel::ActionReturnStatus status = provider.ReadAttribute(request, encoder);
+        bool hasMoreChunks                   = status.IsOutOfSpaceEncodingResponse() && encoder.GetState().AllowPartialData();
+
+        if (status.IsOutOfSpaceEncodingResponse() && !hasMoreChunks)
+        {
+            // A value that does not fit in a chunk cannot be part of the snapshot.
+            return CHIP_ERROR_BUFFER_TOO_SMALL;
+        }
+        if (status.IsError() && !hasMoreChunks)
+        {
+            // Reads that fail are reported as failed to clients too, so only the failure is part of the snapshot.
+            return snapshotWriter.Put(TLV::AnonymousTag(), status.GetUnderlyingError().AsInteger());
+        }
+
+        ReturnErrorOnFailure(writer.UnreserveBuffer(kSnapshotChunkReservedSize));
+        ReturnErrorOnFailure(reports.EndOfAttributeReportIBs());
+        ReturnErrorOnFailure(writer.EndContainer(reportDataType));
+        ReturnErrorOnFailure(AddReportsToSnapshot(chunk, writer.GetLengthWritten(), snapshotWriter));
+        VerifyOrReturnError(hasMoreChunks, CHIP_NO_ERROR);
+
+        // A list item that does not fit in a chunk on its own would never be read.
+        VerifyOrReturnError(encoder.GetState().CurrentEncodingListIndex() != state.CurrentEncodingListIndex(),
+                            CHIP_ERROR_BUFFER_TOO_SMALL);
+        state = encoder.GetState();
+    }
+}
+
+/**
+ * Finds the data version and snapshot of a cluster in a record.
+ */
+CHIP_ERROR FindStoredCluster(const ByteSpan & record, ClusterId clusterId, DataVersion & version, uint64_t & snapshot)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType arrayType;
+    reader.Init(record);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(arrayType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType structType;
+        ClusterId storedClusterId;
+        ReturnErrorOnFailure(reader.EnterContainer(structType));
+        ReturnErrorOnFailure(reader.Next(kClusterIdTag));
+        ReturnErrorOnFailure(reader.Get(storedClusterId));
+        ReturnErrorOnFailure(reader.Next(kDataVersionTag));
+        ReturnErrorOnFailure(reader.Get(version));
+        ReturnErrorOnFailure(reader.Next(kSnapshotTag));
+        ReturnErrorOnFailure(reader.Get(snapshot));
+        ReturnErrorOnFailure(reader.ExitContainer(structType));
+        VerifyOrReturnError(storedClusterId != clusterId, CHIP_NO_ERROR);
+    }
+    return (err == CHIP_END_OF_TLV) ? CHIP_ERROR_NOT_FOUND : err;
+}
+
+CHIP_ERROR WriteStoredCluster(TLV::TLVWriter & writer, ClusterId clusterId, DataVersion version, uint64_t snapshot)
+{
+    TLV::TLVType structType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, structType));
+    ReturnErrorOnFailure(writer.Put(kClusterIdTag, clusterId));
+    ReturnErrorOnFailure(writer.Put(kDataVersionTag, version));
+    ReturnErrorOnFailure(writer.Put(kSnapshotTag, snapshot));
+    return writer.EndContainer(structType);
+}
+
+} // namespace
+
+CHIP_ERROR DataVersionPersistence::Init(PersistentStorageDelegate * storage, System::Clock::Milliseconds32 writeDelay)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mStorage              = storage;
+    mWriteDelay           = writeDelay;
+    mRestoredClusterCount = 0;
+    return CHIP_NO_ERROR;
+}
+
+void DataVersionPersistence::Shutdown()
+{
+    VerifyOrReturn(mStorage != nullptr);
+
+    if (mWriteScheduled)
+    {
+        DeviceLayer::SystemLayer().CancelTimer(OnWriteTimerExpired, this);
+        mWriteScheduled = false;
+    }
+
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to store data versions on shutdown: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    mTrackedClusters.ReleaseAll();
+    mProvider = nullptr;
+    mStorage  = nullptr;
+}
+
+CHIP_ERROR DataVersionPersistence::RestoreDataVersions(DataModel::Provider & provider)
+{
+    for (EndpointId endpoint = provider.FirstEndpoint(); endpoint != kInvalidEndpointId; endpoint = provider.NextEndpoint(endpoint))
+    {
+        ReturnErrorOnFailure(RestoreDataVersions(provider, endpoint));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DataVersionPersistence::RestoreDataVersions(DataModel::Provider & provider, EndpointId endpoint)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mProvider == nullptr || mProvider == &provider, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mProvider = &provider;
+    ForgetEndpoint(endpoint);
+
+    size_t clusterCount = 0;
+    for (auto cluster = provider.FirstCluster(endpoint); cluster.IsValid(); cluster = provider.NextCluster(cluster.path))
+    {
+        clusterCount++;
+    }
+    VerifyOrReturnError(clusterCount > 0, CHIP_NO_ERROR);
+
+    Platform::ScopedMemoryBuffer<uint8_t> record;
+    uint16_t recordSize = static_cast<uint16_t>(std::min<size_t>(RecordSize(clusterCount + kExtraStoredClusters), UINT16_MAX));
+    VerifyOrReturnError(record.Alloc(recordSize), CHIP_ERROR_NO_MEMORY);
+
+    CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::ClusterDataVersions(endpoint).KeyName(), record.Get(),
+                                               recordSize);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        // Without a usable record, the clusters keep their current data versions, which get stored.
+        recordSize = 0;
+    }
+    else
+    {
+        ReturnErrorOnFailure(err);
+    }
+    ByteSpan storedRecord(record.Get(), recordSize);
+
+    bool needsWrite = false;
+    for (auto cluster = provider.FirstCluster(endpoint); cluster.IsValid(); cluster = provider.NextCluster(cluster.path))
+    {
+        DataVersion * version = emberAfDataVersionStorage(cluster.path);
+        if (version == nullptr)
+        {
+            continue;
+        }
+
+        TrackedCluster * tracked = mTrackedClusters.CreateObject(cluster.path);
+        if (tracked == nullptr)
+        {
+            ChipLogError(DataManagement, "Too many clusters to store data versions of, not tracking " ChipLogFormatMEI,
+                         ChipLogValueMEI(cluster.path.mClusterId));
+            break;
+        }
+
+        tracked->mStoredVersion = *version;
+        tracked->mHasSnapshot   = (ComputeSnapshot(provider, cluster.path, tracked->mSnapshot) == CHIP_NO_ERROR);
+
+        DataVersion storedVersion;
+        uint64_t storedSnapshot;
+        if (tracked->mHasSnapshot &&
+            FindStoredCluster(storedRecord, cluster.path.mClusterId, storedVersion, storedSnapshot) == CHIP_NO_ERROR &&
+            storedSnapshot == tracked->mSnapshot)
+        {
+            *version                       = storedVersion;
+            tracked->mStoredVersion        = storedVersion;
+            tracked->mSkipUnstoredVersions = true;
+            mRestoredClusterCount++;
+        }
+        else
+        {
+            tracked->mChanged = true;
+            needsWrite        = true;
+        }
+    }
+
+    if (needsWrite)
+    {
+        ScheduleWrite();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void DataVersionPersistence::ForgetEndpoint(EndpointId endpoint)
+{
+    mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+        if (tracked->mPath.mEndpointId == endpoint)
+        {
+            mTrackedClusters.ReleaseObject(tracked);
+        }
+        return Loop::Continue;
+    });
+}
+
+void DataVersionPersistence::OnDataVersionChanged(const ConcreteClusterPath & path, DataVersion & version)
+{
+    TrackedCluster * tracked = FindTrackedCluster(path);
+    VerifyOrReturn(tracked != nullptr);
+
+    if (tracked->mSkipUnstoredVersions)
+    {
+        // Versions up to mStoredVersion + kMaxUnstoredVersions - 1 may have been published before the reboot, with other values.
+        tracked->mSkipUnstoredVersions = false;
+        version                        = static_cast<DataVersion>(tracked->mStoredVersion + kMaxUnstoredVersions);
+    }
+    tracked->mChanged = true;
+
+    if (static_cast<DataVersion>(version - tracked->mStoredVersion) < kMaxUnstoredVersions)
+    {
+        ScheduleWrite();
+        return;
+    }
+
+    CHIP_ERROR err = WriteRecord(path.mEndpointId);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to store data versions of endpoint %u: %" CHIP_ERROR_FORMAT, path.mEndpointId,
+                     err.Format());
+        ScheduleWrite();
+    }
+}
+
+CHIP_ERROR DataVersionPersistence::Flush()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR result         = CHIP_NO_ERROR;
+    EndpointId failedEndpoint = kInvalidEndpointId;
+    mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+        if (tracked->mChanged && tracked->mPath.mEndpointId != failedEndpoint)
+        {
+            CHIP_ERROR err = WriteRecord(tracked->mPath.mEndpointId);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(DataManagement, "Failed to store data versions of endpoint %u: %" CHIP_ERROR_FORMAT,
+                             tracked->mPath.mEndpointId, err.Format());
+                failedEndpoint = tracked->mPath.mEndpointId;
+                result         = err;
+            }
+        }
+        return Loop::Continue;
+    });
+    return result;
+}
+
+CHIP_ERROR DataVersionPersistence::ComputeSnapshot(DataModel::Provider & provider, const ConcreteClusterPath & path,
+                                                   uint64_t & snapshot)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> chunk;
+    VerifyOrReturnError(chunk.Alloc(kSnapshotChunkSize), CHIP_ERROR_NO_MEMORY);
+
+    SnapshotHasher hasher;
+    ReturnErrorOnFailure(hasher.Init());
+
+    for (auto attribute = provider.FirstAttribute(path); attribute.IsValid(); attribute = provider.NextAttribute(attribute.path))
+    {
+        ReturnErrorOnFailure(AddAttributeToSnapshot(provider, attribute.path, chunk.Get(), hasher.GetWriter()));
+    }
+
+    // The attribute and command lists are not in the metadata, but they change along with it (e.g. after a firmware update).
+    for (AttributeId attributeId : GlobalAttributesNotInMetadata)
+    {
+        ReturnErrorOnFailure(AddAttributeToSnapshot(provider, ConcreteAttributePath(path.mEndpointId, path.mClusterId, attributeId),
+                                                    chunk.Get(), hasher.GetWriter()));
+    }
+
+    return hasher.Finish(snapshot);
+}
+
+DataVersionPersistence::TrackedCluster * DataVersionPersistence::FindTrackedCluster(const ConcreteClusterPath & path)
+{
+    TrackedCluster * found = nullptr;
+    mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+        if (tracked->mPath == path)
+        {
+            found = tracked;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+CHIP_ERROR DataVersionPersistence::WriteRecord(EndpointId endpoint)
+{
+    VerifyOrReturnError(mStorage != nullptr && mProvider != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Changed clusters get their current data version and snapshot; the others keep what is already stored.
+    size_t clusterCount = 0;
+    mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+        if (tracked->mPath.mEndpointId == endpoint)
+        {
+            if (tracked->mChanged)
+            {
+                tracked->mHasSnapshot = (emberAfDataVersionStorage(tracked->mPath) != nullptr) &&
+                    (ComputeSnapshot(*mProvider, tracked->mPath, tracked->mSnapshot) == CHIP_NO_ERROR);
+            }
+            clusterCount += tracked->mHasSnapshot ? 1 : 0;
+        }
+        return Loop::Continue;
+    });
+
+    StorageKeyName key = DefaultStorageKeyAllocator::ClusterDataVersions(endpoint);
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+    if (clusterCount == 0)
+    {
+        err = mStorage->SyncDeleteKeyValue(key.KeyName());
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            err = CHIP_NO_ERROR;
+        }
+    }
+    else
+    {
+        size_t recordSize = RecordSize(clusterCount);
+        VerifyOrReturnError(CanCastTo<uint16_t>(recordSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        Platform::ScopedMemoryBuffer<uint8_t> record;
+        VerifyOrReturnError(record.Alloc(recordSize), CHIP_ERROR_NO_MEMORY);
+
+        TLV::TLVWriter writer;
+        TLV::TLVType arrayType;
+        writer.Init(record.Get(), recordSize);
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, arrayType));
+        mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+            if (tracked->mPath.mEndpointId == endpoint && tracked->mHasSnapshot)
+            {
+                DataVersion version = tracked->mChanged ? *emberAfDataVersionStorage(tracked->mPath) : tracked->mStoredVersion;
+                err                 = WriteStoredCluster(writer, tracked->mPath.mClusterId, version, tracked->mSnapshot);
+            }
+            return (err == CHIP_NO_ERROR) ? Loop::Continue : Loop::Break;
+        });
+        ReturnErrorOnFailure(err);
+        ReturnErrorOnFailure(writer.EndContainer(arrayType));
+
+        err = mStorage->SyncSetKeyValue(key.KeyName(), record.Get(), static_cast<uint16_t>(writer.GetLengthWritten()));
+    }
+    ReturnErrorOnFailure(err);
+
+    // Only now that the record is stored can the stored data versions move forward.
+    mTrackedClusters.ForEachActiveObject([&](TrackedCluster * tracked) {
+        if (tracked->mPath.mEndpointId == endpoint && tracked->mChanged)
+        {
+            DataVersion * version   = emberAfDataVersionStorage(tracked->mPath);
+            tracked->mStoredVersion = (version != nullptr) ? *version : tracked->mStoredVersion;
+            tracked->mChanged       = false;
+        }
+        return Loop::Continue;
+    });
+    return CHIP_NO_ERROR;
+}
+
+void DataVersionPersistence::ScheduleWrite()
+{
+    VerifyOrReturn(!mWriteScheduled);
+
+    CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(mWriteDelay, OnWriteTimerExpired, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule storing data versions: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mWriteScheduled = true;
+}
+
+void DataVersionPersistence::OnWriteTimerExpired(System::Layer * layer, void * context)
+{
+    auto * persistence           = static_cast<DataVersionPersistence *>(context);
+    persistence->mWriteScheduled = false;
+
+    // Flush() logs the endpoints whose records could not be written; they are retried on the next change.
+    LogErrorOnFailure(persistence->Flush());
+}
+
+DataVersionPersistence * GetDataVersionPersistence()
+{
+    return gDataVersionPersistence;
+}
+
+void SetDataVersionPersistence(DataVersionPersistence * persistence)
+{
+    gDataVersionPersistence = persistence;
+}
+
+} // namespace app
+} // namespace chip
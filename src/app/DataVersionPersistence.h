@@ -0,0 +1,169 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/data-model-provider/Provider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Pool.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Keeps the data versions of the server clusters stored by ember (see
+ * emberAfDataVersionStorage) across reboots.
+ *
+ * Data versions start from random values after a reboot, so reads and
+ * subscriptions whose DataVersionFilters name the versions a client already
+ * has get the full contents of every cluster again.  With this class, a
+ * cluster gets back the data version it had before the reboot when none of its
+ * attribute values changed, so those filters keep matching.
+ *
+ * Along with the data version of each cluster, a snapshot is stored: a hash of
+ * the values of all the attributes of the cluster, read through the data model
+ * provider.  A data version is only restored when the snapshot of the current
+ * values matches the stored one; clusters whose values changed across the
+ * reboot (e.g. attributes that are not persisted, or a firmware update) keep
+ * their random data version.
+ *
+ * The data versions of an endpoint are written in a single record, a while
+ * after they changed, so that a burst of changes results in one storage write
+ * per endpoint.  Data versions that were published but not yet written when the
+ * device lost power must never be reused for other values: a record is written
+ * without waiting when a data version gets kMaxUnstoredVersions past its stored
+ * value, and the first change of a restored cluster skips those versions.
+ *
+ * While a DataVersionPersistence is set (see SetDataVersionPersistence),
+ * subscriptions persisted for resumption also keep the data versions of their
+ * clusters, so the priming report of a resumed subscription only carries the
+ * clusters that changed since the subscription was established.
+ */
+class DataVersionPersistence
+{
+public:
+    static constexpr System::Clock::Milliseconds32 kDefaultWriteDelay =
+        System::Clock::Milliseconds32(CHIP_CONFIG_DATA_VERSION_PERSISTENCE_WRITE_DELAY_MS);
+    static constexpr DataVersion kMaxUnstoredVersions = CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_UNSTORED_VERSIONS;
+
+    DataVersionPersistence() = default;
+    ~DataVersionPersistence() { Shutdown(); }
+
+    DataVersionPersistence(const DataVersionPersistence &)             = delete;
+    DataVersionPersistence & operator=(const DataVersionPersistence &) = delete;
+
+    // Passed-in storage must outlive this object.
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Clock::Milliseconds32 writeDelay = kDefaultWriteDelay);
+
+    /**
+     * Writes the pending records and stops tracking data versions.
+     */
+    void Shutdown();
+
+    /**
+     * Restores the data versions of all the clusters of all the endpoints of
+     * the provider, and starts tracking them.
+     *
+     * Must be called once the clusters are initialized and before any read or
+     * subscription is served.  The provider must outlive this object, or the
+     * next call to Shutdown().
+     */
+    CHIP_ERROR RestoreDataVersions(DataModel::Provider & provider);
+
+    /**
+     * Same as above for a single endpoint, e.g. a dynamic endpoint that was
+     * just added.  Replaces the tracked data versions of that endpoint, if any.
+     */
+    CHIP_ERROR RestoreDataVersions(DataModel::Provider & provider, EndpointId endpoint);
+
+    /**
+     * Stops tracking the clusters of an endpoint, e.g. a dynamic endpoint that
+     * was removed.  Its stored record is kept.
+     */
+    void ForgetEndpoint(EndpointId endpoint);
+
+    /**
+     * Must be called after the data version of a cluster was incremented (see
+     * emberAfAttributeChanged), before the new version is reported.  May move
+     * `version` further forward.
+     */
+    void OnDataVersionChanged(const ConcreteClusterPath & path, DataVersion & version);
+
+    /**
+     * Writes the records of the endpoints whose data versions changed, without
+     * waiting for the write delay.
+     */
+    CHIP_ERROR Flush();
+
+    /**
+     * Computes the snapshot of the attribute values of a cluster.
+     */
+    static CHIP_ERROR ComputeSnapshot(DataModel::Provider & provider, const ConcreteClusterPath & path, uint64_t & snapshot);
+
+    size_t GetRestoredClusterCount() const { return mRestoredClusterCount; }
+
+private:
+    struct TrackedCluster
+    {
+        explicit TrackedCluster(const ConcreteClusterPath & path) : mPath(path) {}
+
+        const ConcreteClusterPath mPath;
+        DataVersion mStoredVersion = 0;
+        uint64_t mSnapshot         = 0;
+        bool mHasSnapshot          = false;
+        // The data version changed since mStoredVersion was written.
+        bool mChanged = false;
+        // Restored from storage: the next change skips the versions that may have been published before the reboot.
+        bool mSkipUnstoredVersions = false;
+    };
+
+    static constexpr size_t kMaxTrackedClusters = CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_CLUSTERS;
+
+    TrackedCluster * FindTrackedCluster(const ConcreteClusterPath & path);
+    CHIP_ERROR WriteRecord(EndpointId endpoint);
+    void ScheduleWrite();
+    static void OnWriteTimerExpired(System::Layer * layer, void * context);
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    DataModel::Provider * mProvider      = nullptr;
+    System::Clock::Milliseconds32 mWriteDelay{ kDefaultWriteDelay };
+    ObjectPool<TrackedCluster, kMaxTrackedClusters> mTrackedClusters;
+    size_t mRestoredClusterCount = 0;
+    bool mWriteScheduled         = false;
+};
+
+/**
+ * Gets the DataVersionPersistence notified of data version changes, if any.
+ */
+DataVersionPersistence * GetDataVersionPersistence();
+
+/**
+ * Sets the DataVersionPersistence notified of data version changes, or none
+ * when passed nullptr.
+ */
+void SetDataVersionPersistence(DataVersionPersistence * persistence);
+
+} // namespace app
+} // namespace chip
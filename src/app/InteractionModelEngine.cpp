@@ -283,6 +283,40 @@ uint32_t InteractionModelEngine::GetNumActiveWriteHandlers() const
     return numActive;
 }
 
+InteractionModelEngine::MemoryStatistics InteractionModelEngine::GetMemoryStatistics()
+{
+    auto poolStatistics = [](const auto & pool) {
+        PoolStatistics statistics;
+        statistics.mAllocated     = pool.Allocated();
+        statistics.mHighWaterMark = pool.HighWaterMark();
+        return statistics;
+    };
+
+    MemoryStatistics statistics;
+    statistics.mReadHandlers       = poolStatistics(mReadHandlers);
+    statistics.mCommandResponders  = poolStatistics(mCommandResponderObjs);
+    statistics.mTimedHandlers      = poolStatistics(mTimedHandlers);
+    statistics.mAttributePaths     = poolStatistics(mAttributePathPool);
+    statistics.mEventPaths         = poolStatistics(mEventPathPool);
+    statistics.mDataVersionFilters = poolStatistics(mDataVersionFilterPool);
+
+    mReadHandlers.ForEachActiveObject([&statistics](ReadHandler * handler) {
+        const Arena * arena = handler->GetPathArena();
+        if (arena != nullptr)
+        {
+            const Arena::Statistics & arenaStatistics = arena->GetStatistics();
+            statistics.mPathArenas.mAllocations += arenaStatistics.mAllocations;
+            statistics.mPathArenas.mBytesUsed += arenaStatistics.mBytesUsed;
+            statistics.mPathArenas.mBytesReserved += arenaStatistics.mBytesReserved;
+            statistics.mPathArenas.mBlockCount += arenaStatistics.mBlockCount;
+            statistics.mPathArenas.mBlockAllocations += arenaStatistics.mBlockAllocations;
+        }
+        return Loop::Continue;
+    });
+
+    return statistics;
+}
+
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
 CHIP_ERROR InteractionModelEngine::ShutdownSubscription(const ScopedNodeId & aPeerNodeId, SubscriptionId aSubscriptionId)
 {
@@ -1478,15 +1512,16 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
     return false;
 }
 
-void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
+void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
+                                                      Arena * apArena)
 {
-    ReleasePool(aAttributePathList, mAttributePathPool);
+    ReleasePool(aAttributePathList, mAttributePathPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
-                                                              AttributePathParams & aAttributePath)
+                                                              AttributePathParams & aAttributePath, Arena * apArena)
 {
-    CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool);
+    CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "AttributePath pool full");
@@ -1518,7 +1553,8 @@ bool InteractionModelEngine::IsExistentAttributePath(const ConcreteAttributePath
 #endif
 }
 
-void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths)
+void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths,
+                                                                  Arena * apArena)
 {
     SingleLinkedListNode<AttributePathParams> * prev = nullptr;
     auto * path1                                     = aAttributePaths;
@@ -1560,30 +1596,34 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedLi
             continue;
         }
 
+        // Nodes allocated from an arena are only unlinked; the arena reclaims them when it is reset.
+        auto * removed = path1;
         if (path1 == aAttributePaths)
         {
             aAttributePaths = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
-            path1 = aAttributePaths;
+            path1           = aAttributePaths;
         }
         else
         {
             prev->mpNext = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
-            path1 = prev->mpNext;
+            path1        = prev->mpNext;
+        }
+        if (apArena == nullptr)
+        {
+            mAttributePathPool.ReleaseObject(removed);
         }
     }
 }
 
-void InteractionModelEngine::ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList)
+void InteractionModelEngine::ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList, Arena * apArena)
 {
-    ReleasePool(aEventPathList, mEventPathPool);
+    ReleasePool(aEventPathList, mEventPathPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList,
-                                                                EventPathParams & aEventPath)
+                                                                EventPathParams & aEventPath, Arena * apArena)
 {
-    CHIP_ERROR err = PushFront(aEventPathList, aEventPath, mEventPathPool);
+    CHIP_ERROR err = PushFront(aEventPathList, aEventPath, mEventPathPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "EventPath pool full");
@@ -1592,15 +1632,16 @@ CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(SingleLinkedList
     return err;
 }
 
-void InteractionModelEngine::ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList)
+void InteractionModelEngine::ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
+                                                          Arena * apArena)
 {
-    ReleasePool(aDataVersionFilterList, mDataVersionFilterPool);
+    ReleasePool(aDataVersionFilterList, mDataVersionFilterPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
-                                                                  DataVersionFilter & aDataVersionFilter)
+                                                                  DataVersionFilter & aDataVersionFilter, Arena * apArena)
 {
-    CHIP_ERROR err = PushFront(aDataVersionFilterList, aDataVersionFilter, mDataVersionFilterPool);
+    CHIP_ERROR err = PushFront(aDataVersionFilterList, aDataVersionFilter, mDataVersionFilterPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "DataVersionFilter pool full, ignore this filter");
@@ -1611,8 +1652,14 @@ CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(SingleLinkedLi
 
 template <typename T, size_t N>
 void InteractionModelEngine::ReleasePool(SingleLinkedListNode<T> *& aObjectList,
-                                         ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
+                                         ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool, Arena * apArena)
 {
+    if (apArena != nullptr)
+    {
+        aObjectList = nullptr;
+        return;
+    }
+
     SingleLinkedListNode<T> * current = aObjectList;
     while (current != nullptr)
     {
@@ -1626,9 +1673,10 @@ void InteractionModelEngine::ReleasePool(SingleLinkedListNode<T> *& aObjectList,
 
 template <typename T, size_t N>
 CHIP_ERROR InteractionModelEngine::PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData,
-                                             ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
+                                             ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool, Arena * apArena)
 {
-    SingleLinkedListNode<T> * object = aObjectPool.CreateObject();
+    SingleLinkedListNode<T> * object =
+        (apArena != nullptr) ? apArena->New<SingleLinkedListNode<T>>() : aObjectPool.CreateObject();
     if (object == nullptr)
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -56,6 +56,7 @@
 #include <app/util/attribute-metadata.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/support/Arena.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/LinkedList.h>
@@ -180,6 +181,30 @@ public:
 
     uint32_t GetNumActiveWriteHandlers() const;
 
+    struct PoolStatistics
+    {
+        size_t mAllocated     = 0;
+        size_t mHighWaterMark = 0;
+    };
+
+    struct MemoryStatistics
+    {
+        PoolStatistics mReadHandlers;
+        PoolStatistics mCommandResponders;
+        PoolStatistics mTimedHandlers;
+        PoolStatistics mAttributePaths;
+        PoolStatistics mEventPaths;
+        PoolStatistics mDataVersionFilters;
+        // Sum over the path arenas of the active read handlers (builds with heap-backed pools only).
+        Arena::Statistics mPathArenas;
+    };
+
+    /**
+     * Returns the usage of the object pools owned by the engine, and of the memory held by active read handlers
+     * for their path lists.
+     */
+    MemoryStatistics GetMemoryStatistics();
+
     /**
      * Returns the handler at a particular index within the active handler list.
      */
@@ -194,23 +219,31 @@ public:
 
     reporting::ReportScheduler * GetReportScheduler() { return mReportScheduler; }
 
-    void ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList);
+    /*
+     * The path and data version filter lists below are allocated from pools owned by the engine, unless an arena is
+     * provided: the nodes are then allocated from the arena, and releasing a list only forgets it. Its memory goes back
+     * when the arena is reset. A list must always be passed the same arena (or none).
+     */
+    void ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList, Arena * apArena = nullptr);
 
     CHIP_ERROR PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
-                                          AttributePathParams & aAttributePath);
+                                          AttributePathParams & aAttributePath, Arena * apArena = nullptr);
 
     // If a concrete path indicates an attribute that is also referenced by a wildcard path in the request,
     // the path SHALL be removed from the list.
-    void RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths);
+    void RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths,
+                                              Arena * apArena = nullptr);
 
-    void ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList);
+    void ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList, Arena * apArena = nullptr);
 
-    CHIP_ERROR PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
+    CHIP_ERROR PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList, EventPathParams & aEventPath,
+                                            Arena * apArena = nullptr);
 
-    void ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList);
+    void ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
+                                      Arena * apArena = nullptr);
 
     CHIP_ERROR PushFrontDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
-                                              DataVersionFilter & aDataVersionFilter);
+                                              DataVersionFilter & aDataVersionFilter, Arena * apArena = nullptr);
 
     /*
      * Register an application callback to be notified of notable events when handling reads/subscribes.
@@ -620,9 +653,11 @@ private:
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
     template <typename T, size_t N>
-    void ReleasePool(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
+    void ReleasePool(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool,
+                     Arena * apArena);
     template <typename T, size_t N>
-    CHIP_ERROR PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
+    CHIP_ERROR PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool,
+                         Arena * apArena);
 
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
 
@@ -168,9 +168,7 @@ CHIP_ERROR ReadClient::ScheduleResubscription(uint32_t aTimeTillNextResubscripti
         mReadPrepareParams.mSessionHolder->AsSecureSession()->MarkAsDefunct();
     }
 
-    ReturnErrorOnFailure(
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-            System::Clock::Milliseconds32(aTimeTillNextResubscriptionMs), OnResubscribeTimerCallback, this));
+    ReturnErrorOnFailure(StartTimer(System::Clock::Milliseconds32(aTimeTillNextResubscriptionMs), OnResubscribeTimerCallback));
     mIsResubscriptionScheduled = true;
 
     return CHIP_NO_ERROR;
@@ -180,6 +178,21 @@ void ReadClient::Close(CHIP_ERROR aError, bool allowResubscription)
 {
     if (IsReadType())
     {
+        // A read stays in AwaitingInitialReport until it completes.
+        if (IsAwaitingInitialReport())
+        {
+            if (aError == CHIP_NO_ERROR)
+            {
+                MATTER_LOG_METRIC(Tracing::kMetricIMReadRoundTrip,
+                                  Tracing::LatencyMicroseconds(System::SystemClock().GetMonotonicMicroseconds64() -
+                                                               mMetricTimestamp));
+            }
+            else
+            {
+                MATTER_LOG_METRIC(Tracing::kMetricIMReadRoundTrip, aError);
+            }
+        }
+
         if (aError != CHIP_NO_ERROR)
         {
             mpCallback.OnError(aError);
@@ -362,6 +375,7 @@ CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
         mExchange->SetResponseTimeout(aReadPrepareParams.mTimeout);
     }
 
+    mMetricTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
     ReturnErrorOnFailure(mExchange->SendMessage(Protocols::InteractionModel::MsgType::ReadRequest, std::move(msgBuf),
                                                 Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse)));
 
@@ -702,6 +716,18 @@ exit:
             //
             mpCallback.NotifySubscriptionStillActive(*this);
             err = RefreshLivenessCheckTimer();
+
+            if (!mPendingMoreChunks)
+            {
+                MATTER_LOG_METRIC(Tracing::kMetricIMSubscriptionReportInterval,
+                                  Tracing::LatencyMicroseconds(System::SystemClock().GetMonotonicMicroseconds64() -
+                                                               mMetricTimestamp));
+            }
+        }
+
+        if (!mPendingMoreChunks && err == CHIP_NO_ERROR)
+        {
+            mMetricTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
         }
     }
 
@@ -956,8 +982,7 @@ CHIP_ERROR ReadClient::RefreshLivenessCheckTimer()
         DataManagement,
         "Refresh LivenessCheckTime for %lu milliseconds with SubscriptionId = 0x%08" PRIx32 " Peer = %02x:" ChipLogFormatX64,
         static_cast<long unsigned>(timeout.count()), mSubscriptionId, GetFabricIndex(), ChipLogValueX64(GetPeerNodeId()));
-    err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-        timeout, OnLivenessTimeoutCallback, this);
+    err = StartTimer(timeout, OnLivenessTimeoutCallback);
 
     return err;
 }
@@ -997,16 +1022,34 @@ CHIP_ERROR ReadClient::ComputeLivenessCheckTimerTimeout(System::Clock::Timeout *
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ReadClient::StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aCallback)
+{
+    if (mpTimerScheduler != nullptr)
+    {
+        return mpTimerScheduler->StartTimer(aDelay, aCallback, this);
+    }
+    return InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
+        aDelay, aCallback, this);
+}
+
+void ReadClient::CancelTimer(System::TimerCompleteCallback aCallback)
+{
+    if (mpTimerScheduler != nullptr)
+    {
+        mpTimerScheduler->CancelTimer(aCallback, this);
+        return;
+    }
+    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(aCallback, this);
+}
+
 void ReadClient::CancelLivenessCheckTimer()
 {
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnLivenessTimeoutCallback, this);
+    CancelTimer(OnLivenessTimeoutCallback);
 }
 
 void ReadClient::CancelResubscribeTimer()
 {
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnResubscribeTimerCallback, this);
+    CancelTimer(OnResubscribeTimerCallback);
     mIsResubscriptionScheduled = false;
 }
 
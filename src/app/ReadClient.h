@@ -286,6 +286,26 @@ public:
         virtual void OnCASESessionEstablished(const SessionHandle & aSession, ReadPrepareParams & aSubscriptionParams) {}
     };
 
+    /**
+     * Runs the liveness and resubscription timers of a ReadClient.
+     *
+     * By default every ReadClient arms its own timers on the system layer.  A
+     * consumer driving a large number of subscriptions can instead install a
+     * scheduler that multiplexes them (see SharedTimerScheduler).  The
+     * semantics are those of System::Layer::StartTimer/CancelTimer: starting a
+     * timer with the same callback and state as a pending one replaces it.
+     */
+    class TimerScheduler
+    {
+    public:
+        virtual ~TimerScheduler() = default;
+
+        virtual CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aCallback,
+                                      void * apAppState) = 0;
+
+        virtual void CancelTimer(System::TimerCompleteCallback aCallback, void * apAppState) = 0;
+    };
+
     enum class InteractionType : uint8_t
     {
         Read,
@@ -483,6 +503,14 @@ public:
      */
     void OverrideLivenessTimeout(System::Clock::Timeout aLivenessTimeout);
 
+    /**
+     * Use the given scheduler, instead of the system layer, for the liveness
+     * and resubscription timers of this client.  Must be called while no timer
+     * is pending (e.g. before sending the subscribe request), and the scheduler
+     * must outlive this object.  Passing nullptr restores the default.
+     */
+    void SetTimerScheduler(TimerScheduler * apTimerScheduler) { mpTimerScheduler = apTimerScheduler; }
+
     /**
      * If the ReadClient currently has a resubscription attempt scheduled,
      * trigger that attempt right now.  This is generally useful when a consumer
@@ -566,6 +594,8 @@ private:
     CHIP_ERROR ProcessAttributeReportIBs(TLV::TLVReader & aAttributeDataIBsReader);
     CHIP_ERROR ProcessEventReportIBs(TLV::TLVReader & aEventReportIBsReader);
 
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aCallback);
+    void CancelTimer(System::TimerCompleteCallback aCallback);
     static void OnLivenessTimeoutCallback(System::Layer * apSystemLayer, void * apAppState);
     CHIP_ERROR ProcessSubscribeResponse(System::PacketBufferHandle && aPayload);
     CHIP_ERROR RefreshLivenessCheckTimer();
@@ -654,6 +684,7 @@ private:
 
     ReadClient * mpNext                 = nullptr;
     InteractionModelEngine * mpImEngine = nullptr;
+    TimerScheduler * mpTimerScheduler   = nullptr;
 
     //
     // This stores the params associated with the interaction in a specific set of cases:
@@ -667,6 +698,10 @@ private:
 
     bool mIsPeerLIT = false;
 
+    // Read Request send time for reads, time of the last complete report for
+    // subscriptions. Used for latency metrics.
+    System::Clock::Microseconds64 mMetricTimestamp = System::Clock::kZero;
+
     // End Of Container (0x18) uses one byte.
     static constexpr uint16_t kReservedSizeForEndOfContainer = 1;
     // Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
@@ -23,6 +23,7 @@
  */
 
 #include <app/AppConfig.h>
+#include <app/DataVersionPersistence.h>
 #include <app/InteractionModelEngine.h>
 #include <app/MessageDef/EventPathIB.h>
 #include <app/MessageDef/StatusResponseMessage.h>
@@ -99,21 +100,39 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
     SetStateFlag(ReadHandlerFlags::FabricFiltered, resumptionSessionEstablisher.mSubscriptionInfo.mFabricFiltered);
 
     // Move dynamically allocated attributes and events from the SubscriptionInfo struct into
-    // the object pool managed by the IM engine
+    // the path lists of this handler
     for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mAttributePaths.AllocatedSize(); i++)
     {
         AttributePathParams params = resumptionSessionEstablisher.mSubscriptionInfo.mAttributePaths[i].GetParams();
-        CHIP_ERROR err = mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(mpAttributePathList, params);
+        CHIP_ERROR err = mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(mpAttributePathList, params,
+                                                                                                     GetPathArena());
         if (err != CHIP_NO_ERROR)
         {
             Close();
             return;
         }
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddToInterestIndex(*this);
+
     for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths.AllocatedSize(); i++)
     {
         EventPathParams params = resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths[i].GetParams();
-        CHIP_ERROR err = mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, params);
+        CHIP_ERROR err =
+            mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, params, GetPathArena());
+        if (err != CHIP_NO_ERROR)
+        {
+            Close();
+            return;
+        }
+    }
+
+    // The priming report skips the clusters whose data versions did not change since the subscription was established, as
+    // the subscriber already has their contents.
+    for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mDataVersionFilters.AllocatedSize(); i++)
+    {
+        DataVersionFilter filter = resumptionSessionEstablisher.mSubscriptionInfo.mDataVersionFilters[i].GetParams();
+        CHIP_ERROR err           = mManagementCallback.GetInteractionModelEngine()->PushFrontDataVersionFilterList(
+            mpDataVersionFilterList, filter, GetPathArena());
         if (err != CHIP_NO_ERROR)
         {
             Close();
@@ -159,9 +178,10 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
-    mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
-    mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
-    mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RemoveFromInterestIndex(*this);
+    mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList, GetPathArena());
+    mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList, GetPathArena());
+    mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList, GetPathArena());
 }
 
 void ReadHandler::Close(CloseOptions options)
@@ -367,7 +387,7 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
     {
         mPreviousReportsBeginGeneration = mCurrentReportsBeginGeneration;
         ClearForceDirtyFlag();
-        mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+        mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList, GetPathArena());
     }
 
     return err;
@@ -503,14 +523,15 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
         AttributePathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
         ReturnErrorOnFailure(path.ParsePath(attribute));
-        ReturnErrorOnFailure(
-            mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(mpAttributePathList, attribute));
+        ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(
+            mpAttributePathList, attribute, GetPathArena()));
     }
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
     {
-        mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList, GetPathArena());
         mAttributePathExpandIterator.ResetTo(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddToInterestIndex(*this);
         err = CHIP_NO_ERROR;
     }
     return err;
@@ -537,7 +558,7 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
         ReturnErrorOnFailure(path.GetCluster(&(versionFilter.mClusterId)));
         VerifyOrReturnError(versionFilter.IsValidDataVersionFilter(), CHIP_ERROR_IM_MALFORMED_DATA_VERSION_FILTER_IB);
         ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->PushFrontDataVersionFilterList(
-            mpDataVersionFilterList, versionFilter));
+            mpDataVersionFilterList, versionFilter, GetPathArena()));
     }
 
     if (CHIP_END_OF_TLV == err)
@@ -559,7 +580,8 @@ CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsPars
         EventPathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
         ReturnErrorOnFailure(path.ParsePath(event));
-        ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, event));
+        ReturnErrorOnFailure(
+            mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, event, GetPathArena()));
     }
 
     // if we have exhausted this container
@@ -844,6 +866,12 @@ void ReadHandler::PersistSubscription()
     VerifyOrReturn(subscriptionInfo.SetAttributePaths(mpAttributePathList) == CHIP_NO_ERROR);
     VerifyOrReturn(subscriptionInfo.SetEventPaths(mpEventPathList) == CHIP_NO_ERROR);
 
+    // Data versions only match after a reboot when they are persisted across it.
+    if (GetDataVersionPersistence() != nullptr && CollectDataVersionFilters(subscriptionInfo) != CHIP_NO_ERROR)
+    {
+        subscriptionInfo.mDataVersionFilters.Free();
+    }
+
     CHIP_ERROR err = subscriptionResumptionStorage->Save(subscriptionInfo);
     if (err != CHIP_NO_ERROR)
     {
@@ -851,6 +879,62 @@ void ReadHandler::PersistSubscription()
     }
 }
 
+CHIP_ERROR ReadHandler::CollectDataVersionFilters(SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
+{
+    using DataVersionFilterValues = SubscriptionResumptionStorage::DataVersionFilterValues;
+
+    DataModel::Provider * provider = mManagementCallback.GetInteractionModelEngine()->GetDataModelProvider();
+    VerifyOrReturnError(provider != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    Platform::ScopedMemoryBuffer<DataVersionFilterValues> filters;
+    VerifyOrReturnError(filters.Calloc(SubscriptionResumptionStorage::kMaxDataVersionFilters), CHIP_ERROR_NO_MEMORY);
+    size_t filterCount = 0;
+
+    // Returns false once there is no room left for more clusters. The clusters left out are simply reported in full.
+    auto addFilter = [&](const ConcreteClusterPath & path, DataVersion dataVersion) {
+        for (size_t i = 0; i < filterCount; i++)
+        {
+            VerifyOrReturnValue(filters[i].mEndpointId != path.mEndpointId || filters[i].mClusterId != path.mClusterId, true);
+        }
+        VerifyOrReturnValue(filterCount < SubscriptionResumptionStorage::kMaxDataVersionFilters, false);
+        filters[filterCount++].SetValues(path, dataVersion);
+        return true;
+    };
+
+    bool full = false;
+    for (auto * node = mpAttributePathList; node != nullptr && !full; node = node->mpNext)
+    {
+        const AttributePathParams & path = node->mValue;
+        for (EndpointId endpoint = path.HasWildcardEndpointId() ? provider->FirstEndpoint() : path.mEndpointId;
+             endpoint != kInvalidEndpointId && !full;
+             endpoint = path.HasWildcardEndpointId() ? provider->NextEndpoint(endpoint) : kInvalidEndpointId)
+        {
+            if (path.HasWildcardClusterId())
+            {
+                for (DataModel::ClusterEntry cluster = provider->FirstCluster(endpoint); cluster.IsValid() && !full;
+                     cluster                         = provider->NextCluster(cluster.path))
+                {
+                    full = !addFilter(cluster.path, cluster.info.dataVersion);
+                }
+                continue;
+            }
+
+            const ConcreteClusterPath clusterPath(endpoint, path.mClusterId);
+            std::optional<DataModel::ClusterInfo> info = provider->GetClusterInfo(clusterPath);
+            if (info.has_value())
+            {
+                full = !addFilter(clusterPath, info->dataVersion);
+            }
+        }
+    }
+
+    subscriptionInfo.mDataVersionFilters.Free();
+    VerifyOrReturnError(filterCount > 0, CHIP_NO_ERROR);
+    VerifyOrReturnError(subscriptionInfo.mDataVersionFilters.Calloc(filterCount), CHIP_ERROR_NO_MEMORY);
+    memcpy(subscriptionInfo.mDataVersionFilters.Get(), filters.Get(), filterCount * sizeof(DataVersionFilterValues));
+    return CHIP_NO_ERROR;
+}
+
 void ReadHandler::ResetPathIterator()
 {
     mAttributePathExpandIterator.ResetTo(mpAttributePathList);
@@ -858,6 +942,14 @@ void ReadHandler::ResetPathIterator()
 }
 
 void ReadHandler::AttributePathIsDirty(const AttributePathParams & aAttributeChanged)
+{
+    MarkAttributePathDirty(aAttributeChanged);
+
+    // ReportScheduler will take care of verifying the reportability of the handler and schedule the run
+    NotifyBecameReportable();
+}
+
+void ReadHandler::MarkAttributePathDirty(const AttributePathParams & aAttributeChanged)
 {
     ConcreteAttributePath path;
 
@@ -885,9 +977,6 @@ void ReadHandler::AttributePathIsDirty(const AttributePathParams & aAttributeCha
         mAttributePathExpandIterator.ResetCurrentCluster();
         mAttributeEncoderState.Reset();
     }
-
-    // ReportScheduler will take care of verifying the reportability of the handler and schedule the run
-    mObserver->OnBecameReportable(this);
 }
 
 Transport::SecureSession * ReadHandler::GetSession() const
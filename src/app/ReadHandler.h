@@ -42,6 +42,7 @@
 #include <lib/core/CHIPCallback.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/support/Arena.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/LinkedList.h>
@@ -325,6 +326,9 @@ private:
 
         // Don't need the response for report data if true
         SuppressResponse = (1 << 5),
+
+        // The attribute paths could not be added to the interest index of the reporting engine.
+        NotInInterestIndex = (1 << 6),
     };
 
     /**
@@ -413,6 +417,10 @@ private:
     /// run if the change to the attribute path makes the ReadHandler reportable.
     /// @param aAttributeChanged Path to the attribute that was changed.
     void AttributePathIsDirty(const AttributePathParams & aAttributeChanged);
+    /// @brief Same as AttributePathIsDirty, but without notifying the report scheduler. Used by the reporting engine to mark
+    /// several paths dirty at once; it must then call NotifyBecameReportable().
+    void MarkAttributePathDirty(const AttributePathParams & aAttributeChanged);
+    void NotifyBecameReportable() { mObserver->OnBecameReportable(this); }
     bool IsDirty() const
     {
         return (mDirtyGeneration > mPreviousReportsBeginGeneration) || mFlags.Has(ReadHandlerFlags::ForceDirty);
@@ -449,6 +457,16 @@ private:
     size_t GetEventPathCount() const { return mpEventPathList == nullptr ? 0 : mpEventPathList->Count(); };
     size_t GetDataVersionFilterCount() const { return mpDataVersionFilterList == nullptr ? 0 : mpDataVersionFilterList->Count(); };
 
+    // Returns the arena the path lists are allocated from, or nullptr when they come from the engine pools.
+    Arena * GetPathArena()
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        return &mPathArena;
+#else
+        return nullptr;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
     CHIP_ERROR SendStatusReport(Protocols::InteractionModel::Status aStatus);
 
     friend class TestReadInteraction;
@@ -508,6 +526,12 @@ private:
 
     void PersistSubscription();
 
+    /**
+     * Records in subscriptionInfo the current data versions of the clusters the subscription covers, up to
+     * SubscriptionResumptionStorage::kMaxDataVersionFilters of them.
+     */
+    CHIP_ERROR CollectDataVersionFilters(SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
+
     /// @brief Modifies a state flag in the read handler. If the read handler went from a
     /// non-reportable state to a reportable state, schedules a reporting engine run.
     /// @param aFlag Flag to set
@@ -585,6 +609,13 @@ private:
     SingleLinkedListNode<EventPathParams> * mpEventPathList           = nullptr;
     SingleLinkedListNode<DataVersionFilter> * mpDataVersionFilterList = nullptr;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // With heap-backed pools, each path node would be its own heap allocation, and releasing it would need a lookup
+    // in the pool. The arena holds all of them in a block or two, freed in one go when the handler goes away.
+    // Static pools are kept on other builds: their capacity is what the per-fabric minimums are sized against.
+    Arena mPathArena;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
     ManagementCallback & mManagementCallback;
 
     uint32_t mLastWrittenEventsBytes = 0;
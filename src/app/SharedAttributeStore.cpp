@@ -0,0 +1,439 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SharedAttributeStore.h>
+
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+namespace {
+
+uint64_t HashEncoding(const ByteSpan & aEncoding)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint8_t byte : aEncoding)
+    {
+        hash ^= byte;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+template <typename Entry>
+bool PathLess(const Entry & aEntry, EndpointId aEndpointId, ClusterId aClusterId)
+{
+    if (aEntry.mEndpointId != aEndpointId)
+    {
+        return aEntry.mEndpointId < aEndpointId;
+    }
+    return aEntry.mClusterId < aClusterId;
+}
+
+template <typename Entry>
+bool PathLess(const Entry & aEntry, const ConcreteAttributePath & aPath)
+{
+    if (aEntry.mEndpointId != aPath.mEndpointId || aEntry.mClusterId != aPath.mClusterId)
+    {
+        return PathLess(aEntry, aPath.mEndpointId, aPath.mClusterId);
+    }
+    return aEntry.mAttributeId < aPath.mAttributeId;
+}
+
+template <typename Entry>
+bool IsInCluster(const Entry & aEntry, EndpointId aEndpointId, ClusterId aClusterId)
+{
+    return aEntry.mEndpointId == aEndpointId && aEntry.mClusterId == aClusterId;
+}
+
+template <typename Entry>
+bool IsAt(const Entry & aEntry, const ConcreteAttributePath & aPath)
+{
+    return IsInCluster(aEntry, aPath.mEndpointId, aPath.mClusterId) && aEntry.mAttributeId == aPath.mAttributeId;
+}
+
+// First entry of a sorted vector that is not before the given cluster.
+template <typename Vector>
+auto ClusterLowerBound(Vector & aEntries, const ConcreteClusterPath & aPath)
+{
+    return std::lower_bound(aEntries.begin(), aEntries.end(), aPath, [](const auto & entry, const ConcreteClusterPath & path) {
+        return PathLess(entry, path.mEndpointId, path.mClusterId);
+    });
+}
+
+// First entry of a sorted vector that is not before the given attribute.
+template <typename Vector>
+auto AttributeLowerBound(Vector & aEntries, const ConcreteAttributePath & aPath)
+{
+    return std::lower_bound(aEntries.begin(), aEntries.end(), aPath,
+                            [](const auto & entry, const ConcreteAttributePath & path) { return PathLess(entry, path); });
+}
+
+} // namespace
+
+CHIP_ERROR SharedAttributeStore::SetAttribute(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath,
+                                              const TLV::TLVReader & aData, bool & aChanged)
+{
+    aChanged = false;
+    VerifyOrReturnError(!mFailingAttributeForTesting.HasValue() || !(mFailingAttributeForTesting.Value() == aPath),
+                        CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVReader reader;
+    reader.Init(aData);
+
+    // Re-encode the element with an anonymous tag.  The total length of the reader is an upper bound on its size.
+    size_t bufferSize = reader.GetTotalLength();
+    if (mScratch.AllocatedSize() < bufferSize)
+    {
+        mScratch.Calloc(bufferSize);
+        VerifyOrReturnError(mScratch.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    TLV::TLVWriter writer;
+    writer.Init(mScratch.Get(), mScratch.AllocatedSize());
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    ReturnErrorOnFailure(writer.Finalize());
+    ByteSpan encoding(mScratch.Get(), writer.GetLengthWritten());
+
+    if (encoding.size() <= kMaxInlineValueLength)
+    {
+        AttributeEntry & entry = FindOrInsertEntry(aNode, aPath);
+        aChanged               = entry.mKind != EntryKind::kInline || !entry.GetData().data_equal(encoding);
+        if (aChanged)
+        {
+            Release(entry);
+            entry.mKind         = EntryKind::kInline;
+            entry.mInlineLength = static_cast<uint8_t>(encoding.size());
+            memcpy(entry.mInline, encoding.data(), encoding.size());
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    // Take the new reference before finding the entry, so that nothing is left half-updated if this fails.
+    SharedValue * value = Intern(encoding);
+    VerifyOrReturnError(value != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // Interning makes identical encodings the same object, so comparing pointers is enough to detect a change.
+    AttributeEntry & entry = FindOrInsertEntry(aNode, aPath);
+    aChanged               = entry.mKind != EntryKind::kShared || entry.mShared != value;
+    Release(entry);
+    entry.mKind   = EntryKind::kShared;
+    entry.mShared = value;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SharedAttributeStore::SetStatus(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath,
+                                           const StatusIB & aStatus, bool & aChanged)
+{
+    AttributeEntry & entry = FindOrInsertEntry(aNode, aPath);
+
+    aChanged = entry.mKind != EntryKind::kStatus || entry.mStatus.mStatus != aStatus.mStatus ||
+        entry.mStatus.mHasClusterStatus != aStatus.mClusterStatus.HasValue() ||
+        (aStatus.mClusterStatus.HasValue() && entry.mStatus.mClusterStatus != aStatus.mClusterStatus.Value());
+
+    Release(entry);
+    entry.mKind                     = EntryKind::kStatus;
+    entry.mStatus.mStatus           = aStatus.mStatus;
+    entry.mStatus.mHasClusterStatus = aStatus.mClusterStatus.HasValue();
+    entry.mStatus.mClusterStatus    = aStatus.mClusterStatus.ValueOr(0);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SharedAttributeStore::Get(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath,
+                                     TLV::TLVReader & aReader) const
+{
+    const AttributeEntry * entry = FindEntry(aNode, aPath);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    VerifyOrReturnError(entry->mKind != EntryKind::kStatus, CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+
+    aReader.Init(entry->GetData());
+    return aReader.Next();
+}
+
+CHIP_ERROR SharedAttributeStore::GetStatus(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath,
+                                           StatusIB & aStatus) const
+{
+    const AttributeEntry * entry = FindEntry(aNode, aPath);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    VerifyOrReturnError(entry->mKind == EntryKind::kStatus, CHIP_ERROR_INVALID_ARGUMENT);
+
+    aStatus.mStatus = entry->mStatus.mStatus;
+    aStatus.mClusterStatus =
+        entry->mStatus.mHasClusterStatus ? MakeOptional(entry->mStatus.mClusterStatus) : Optional<ClusterStatus>::Missing();
+    return CHIP_NO_ERROR;
+}
+
+void SharedAttributeStore::SetDataVersion(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath,
+                                          const Optional<DataVersion> & aVersion)
+{
+    auto node = mNodes.find(aNode);
+    if (node == mNodes.end())
+    {
+        if (!aVersion.HasValue())
+        {
+            return;
+        }
+        node = mNodes.emplace(aNode, NodeState()).first;
+    }
+
+    auto & versions = node->second.mVersions;
+    auto version    = ClusterLowerBound(versions, aPath);
+    bool found      = version != versions.end() && IsInCluster(*version, aPath.mEndpointId, aPath.mClusterId);
+
+    if (!aVersion.HasValue())
+    {
+        if (found)
+        {
+            versions.erase(version);
+        }
+        return;
+    }
+
+    if (found)
+    {
+        version->mDataVersion = aVersion.Value();
+        return;
+    }
+
+    versions.insert(version, ClusterVersion{ aPath.mEndpointId, aPath.mClusterId, aVersion.Value() });
+}
+
+CHIP_ERROR SharedAttributeStore::GetDataVersion(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath,
+                                                Optional<DataVersion> & aVersion) const
+{
+    auto node = mNodes.find(aNode);
+    VerifyOrReturnError(node != mNodes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    aVersion.ClearValue();
+    const auto & versions = node->second.mVersions;
+    auto version          = ClusterLowerBound(versions, aPath);
+    if (version != versions.end() && IsInCluster(*version, aPath.mEndpointId, aPath.mClusterId))
+    {
+        aVersion.SetValue(version->mDataVersion);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void SharedAttributeStore::GetDataVersionFilters(const ScopedNodeId & aNode,
+                                                 std::vector<std::pair<DataVersionFilter, size_t>> & aFilters) const
+{
+    aFilters.clear();
+
+    auto node = mNodes.find(aNode);
+    VerifyOrReturn(node != mNodes.end());
+
+    // Both vectors are sorted by path, so the attributes of each versioned cluster can be summed in a single pass.
+    const auto & attributes = node->second.mAttributes;
+    auto attribute          = attributes.begin();
+    for (const auto & version : node->second.mVersions)
+    {
+        while (attribute != attributes.end() && PathLess(*attribute, version.mEndpointId, version.mClusterId))
+        {
+            ++attribute;
+        }
+
+        size_t clusterSize = 0;
+        for (; attribute != attributes.end() && IsInCluster(*attribute, version.mEndpointId, version.mClusterId); ++attribute)
+        {
+            // Statuses are small; count them like an inline value.
+            clusterSize += attribute->mKind == EntryKind::kStatus ? kMaxInlineValueLength : attribute->GetData().size();
+        }
+
+        if (clusterSize == 0)
+        {
+            // No data in this cluster, so no point in sending a data version along at all.
+            continue;
+        }
+
+        aFilters.emplace_back(DataVersionFilter(version.mEndpointId, version.mClusterId, version.mDataVersion), clusterSize);
+    }
+
+    std::stable_sort(aFilters.begin(), aFilters.end(),
+                     [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
+                         return x.second > y.second;
+                     });
+}
+
+void SharedAttributeStore::ClearCluster(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath)
+{
+    auto node = mNodes.find(aNode);
+    VerifyOrReturn(node != mNodes.end());
+
+    auto & attributes = node->second.mAttributes;
+    auto first        = ClusterLowerBound(attributes, aPath);
+    auto last         = first;
+    while (last != attributes.end() && IsInCluster(*last, aPath.mEndpointId, aPath.mClusterId))
+    {
+        Release(*last);
+        ++last;
+    }
+    attributes.erase(first, last);
+
+    SetDataVersion(aNode, aPath, NullOptional);
+}
+
+void SharedAttributeStore::RemoveNode(const ScopedNodeId & aNode)
+{
+    auto node = mNodes.find(aNode);
+    VerifyOrReturn(node != mNodes.end());
+
+    for (auto & entry : node->second.mAttributes)
+    {
+        Release(entry);
+    }
+    mNodes.erase(node);
+}
+
+void SharedAttributeStore::Clear()
+{
+    for (auto & node : mNodes)
+    {
+        for (auto & entry : node.second.mAttributes)
+        {
+            Release(entry);
+        }
+    }
+    mNodes.clear();
+    VerifyOrDie(mSharedValues.empty());
+    mScratch.Free();
+}
+
+void SharedAttributeStore::GetStats(Stats & aStats) const
+{
+    aStats                   = Stats();
+    aStats.mNodeCount        = mNodes.size();
+    aStats.mSharedValueCount = mSharedValues.size();
+    aStats.mSharedValueBytes = mSharedValueBytes;
+
+    aStats.mMemoryUsage = mSharedValueBytes + mSharedValues.size() * (sizeof(SharedValue) + 4 * sizeof(void *));
+    for (const auto & node : mNodes)
+    {
+        aStats.mAttributeCount += node.second.mAttributes.size();
+        for (const auto & entry : node.second.mAttributes)
+        {
+            aStats.mInlineValueCount += (entry.mKind == EntryKind::kInline) ? 1 : 0;
+        }
+        aStats.mMemoryUsage += sizeof(node) + 4 * sizeof(void *) + node.second.mAttributes.capacity() * sizeof(AttributeEntry) +
+            node.second.mVersions.capacity() * sizeof(ClusterVersion);
+    }
+}
+
+SharedAttributeStore::AttributeEntry & SharedAttributeStore::FindOrInsertEntry(const ScopedNodeId & aNode,
+                                                                               const ConcreteAttributePath & aPath)
+{
+    auto & attributes = mNodes[aNode].mAttributes;
+
+    // Reports mostly arrive in path order, so check for an append before searching.
+    auto position = attributes.end();
+    if (!attributes.empty() && !PathLess(attributes.back(), aPath))
+    {
+        position = AttributeLowerBound(attributes, aPath);
+        if (IsAt(*position, aPath))
+        {
+            return *position;
+        }
+    }
+
+    AttributeEntry entry = {};
+    entry.mEndpointId    = aPath.mEndpointId;
+    entry.mClusterId     = aPath.mClusterId;
+    entry.mAttributeId   = aPath.mAttributeId;
+    entry.mKind          = EntryKind::kEmpty;
+    return *attributes.insert(position, entry);
+}
+
+const SharedAttributeStore::AttributeEntry * SharedAttributeStore::FindEntry(const ScopedNodeId & aNode,
+                                                                             const ConcreteAttributePath & aPath) const
+{
+    auto node = mNodes.find(aNode);
+    VerifyOrReturnValue(node != mNodes.end(), nullptr);
+
+    const auto & attributes = node->second.mAttributes;
+    auto position           = AttributeLowerBound(attributes, aPath);
+    if (position == attributes.end() || !IsAt(*position, aPath))
+    {
+        return nullptr;
+    }
+    return &*position;
+}
+
+SharedAttributeStore::SharedValue * SharedAttributeStore::Intern(const ByteSpan & aEncoding)
+{
+    const uint64_t hash = HashEncoding(aEncoding);
+
+    auto range = mSharedValues.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        SharedValue * value = it->second;
+        if (ByteSpan(value->Bytes(), value->mLength).data_equal(aEncoding))
+        {
+            value->mRefCount++;
+            return value;
+        }
+    }
+
+    void * memory = Platform::MemoryAlloc(sizeof(SharedValue) + aEncoding.size());
+    VerifyOrReturnValue(memory != nullptr, nullptr);
+
+    SharedValue * value = new (memory) SharedValue();
+    value->mHash        = hash;
+    value->mRefCount    = 1;
+    value->mLength      = static_cast<uint32_t>(aEncoding.size());
+    memcpy(value->Bytes(), aEncoding.data(), aEncoding.size());
+
+    mSharedValues.emplace(hash, value);
+    mSharedValueBytes += aEncoding.size();
+    return value;
+}
+
+void SharedAttributeStore::Release(AttributeEntry & aEntry)
+{
+    if (aEntry.mKind == EntryKind::kShared)
+    {
+        SharedValue * value = aEntry.mShared;
+        if (--value->mRefCount == 0)
+        {
+            auto range = mSharedValues.equal_range(value->mHash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == value)
+                {
+                    mSharedValues.erase(it);
+                    break;
+                }
+            }
+            mSharedValueBytes -= value->mLength;
+            value->~SharedValue();
+            Platform::MemoryFree(value);
+        }
+    }
+    aEntry.mKind = EntryKind::kEmpty;
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,262 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/DataVersionFilter.h>
+#include <app/MessageDef/StatusIB.h>
+#include <app/data-model/Decode.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/ScopedBuffer.h>
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * Compact store for the attribute values of many nodes.
+ *
+ * ClusterStateCache keeps, per node, nested maps down to a separately allocated TLV buffer for every attribute. That
+ * is convenient for a single device but costs several hundred bytes per attribute, which dominates the memory of a
+ * controller mirroring a large fleet.  This store instead keeps each node's attributes in one sorted vector of fixed
+ * 24-byte entries:
+ *
+ *  - values whose TLV encoding fits in 8 bytes (booleans, enums, most integers, null) are stored inline in the entry;
+ *  - larger values (strings, lists, structs) are interned: identical encodings are stored once and reference counted,
+ *    so the metadata lists (AttributeList, AcceptedCommandList, ServerList, ...) that a fleet of identical devices
+ *    reports are shared by all of them;
+ *  - status responses are stored inline as well.
+ *
+ * As with ClusterStateCache, values are stored as an anonymous TLV element and decoded on demand.  A reader returned by
+ * Get() points into the store and is only valid until the next modification of the same node.
+ *
+ * The store also keeps the committed data version of each cluster, for use in data version filters when resubscribing.
+ */
+class SharedAttributeStore
+{
+public:
+    static constexpr size_t kMaxInlineValueLength = 8;
+
+    struct Stats
+    {
+        size_t mNodeCount        = 0;
+        size_t mAttributeCount   = 0;
+        size_t mInlineValueCount = 0;
+        size_t mSharedValueCount = 0; // Distinct interned values, however many nodes reference them.
+        size_t mSharedValueBytes = 0;
+        size_t mMemoryUsage      = 0; // Approximation of the heap used by the store.
+    };
+
+    SharedAttributeStore() = default;
+    ~SharedAttributeStore() { Clear(); }
+
+    SharedAttributeStore(const SharedAttributeStore &)             = delete;
+    SharedAttributeStore & operator=(const SharedAttributeStore &) = delete;
+
+    /*
+     * Store the value of an attribute of the given node.  The reader must be positioned on the value element.
+     *
+     * aChanged is set to whether the stored value differs from what was stored for that path before.
+     */
+    CHIP_ERROR SetAttribute(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath, const TLV::TLVReader & aData,
+                            bool & aChanged);
+
+    /*
+     * Store an error status for an attribute of the given node, replacing any value.
+     */
+    CHIP_ERROR SetStatus(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath, const StatusIB & aStatus,
+                         bool & aChanged);
+
+    /*
+     * Get a reader positioned on the stored value of an attribute.
+     *
+     * Notable return values:
+     *      - CHIP_ERROR_KEY_NOT_FOUND if nothing is stored for the path.
+     *      - CHIP_ERROR_IM_STATUS_CODE_RECEIVED if a status is stored for the path instead of data; use GetStatus().
+     */
+    CHIP_ERROR Get(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath, TLV::TLVReader & aReader) const;
+
+    /*
+     * Decode the stored value of an attribute.  See Get() above and ClusterStateCache::Get() for the meaning of the
+     * template parameter.
+     */
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath,
+                   typename AttributeObjectTypeT::DecodableType & aValue) const
+    {
+        if (aPath.mClusterId != AttributeObjectTypeT::GetClusterId() ||
+            aPath.mAttributeId != AttributeObjectTypeT::GetAttributeId())
+        {
+            return CHIP_ERROR_SCHEMA_MISMATCH;
+        }
+
+        TLV::TLVReader reader;
+        ReturnErrorOnFailure(Get(aNode, aPath, reader));
+        return DataModel::Decode(reader, aValue);
+    }
+
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(const ScopedNodeId & aNode, EndpointId aEndpoint, typename AttributeObjectTypeT::DecodableType & aValue) const
+    {
+        ConcreteAttributePath path(aEndpoint, AttributeObjectTypeT::GetClusterId(), AttributeObjectTypeT::GetAttributeId());
+        return Get<AttributeObjectTypeT>(aNode, path, aValue);
+    }
+
+    /*
+     * Get the status stored for an attribute.  Returns CHIP_ERROR_KEY_NOT_FOUND if nothing is stored for the path and
+     * CHIP_ERROR_INVALID_ARGUMENT if data is stored instead of a status.
+     */
+    CHIP_ERROR GetStatus(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath, StatusIB & aStatus) const;
+
+    /*
+     * Set or clear the committed data version of a cluster.
+     */
+    void SetDataVersion(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath, const Optional<DataVersion> & aVersion);
+    CHIP_ERROR GetDataVersion(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath,
+                              Optional<DataVersion> & aVersion) const;
+
+    /*
+     * Get a data version filter for each cluster of the node that has a committed data version, with the amount of
+     * attribute data it stands for, largest first.  The first filters are the ones worth sending if they do not all fit
+     * in a request.
+     */
+    void GetDataVersionFilters(const ScopedNodeId & aNode, std::vector<std::pair<DataVersionFilter, size_t>> & aFilters) const;
+
+    /*
+     * Remove all the attributes of a cluster, along with its data version.
+     */
+    void ClearCluster(const ScopedNodeId & aNode, const ConcreteClusterPath & aPath);
+
+    void RemoveNode(const ScopedNodeId & aNode);
+    void Clear();
+
+    bool HasNode(const ScopedNodeId & aNode) const { return mNodes.find(aNode) != mNodes.end(); }
+    size_t GetNodeCount() const { return mNodes.size(); }
+
+    void GetStats(Stats & aStats) const;
+
+    /*
+     * Test-only: make SetAttribute() fail with CHIP_ERROR_NO_MEMORY for the given attribute, or for none if aPath is empty.
+     */
+    void SetFailingAttributeForTesting(const Optional<ConcreteAttributePath> & aPath) { mFailingAttributeForTesting = aPath; }
+
+private:
+    /*
+     * Interned TLV encoding, allocated together with its bytes.
+     */
+    struct SharedValue
+    {
+        uint64_t mHash;
+        uint32_t mRefCount;
+        uint32_t mLength;
+
+        uint8_t * Bytes() { return reinterpret_cast<uint8_t *>(this + 1); }
+        const uint8_t * Bytes() const { return reinterpret_cast<const uint8_t *>(this + 1); }
+    };
+
+    enum class EntryKind : uint8_t
+    {
+        kEmpty,
+        kInline,
+        kShared,
+        kStatus,
+    };
+
+    struct AttributeEntry
+    {
+        EndpointId mEndpointId;
+        EntryKind mKind;
+        uint8_t mInlineLength;
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        union
+        {
+            uint8_t mInline[kMaxInlineValueLength];
+            SharedValue * mShared;
+            struct
+            {
+                Protocols::InteractionModel::Status mStatus;
+                ClusterStatus mClusterStatus;
+                bool mHasClusterStatus;
+            } mStatus;
+        };
+
+        ByteSpan GetData() const
+        {
+            return mKind == EntryKind::kShared ? ByteSpan(mShared->Bytes(), mShared->mLength) : ByteSpan(mInline, mInlineLength);
+        }
+    };
+
+    static_assert(sizeof(AttributeEntry) <= 24, "Attribute entries are meant to stay compact");
+
+    struct ClusterVersion
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        DataVersion mDataVersion;
+    };
+
+    struct NodeState
+    {
+        // Both sorted by path.
+        std::vector<AttributeEntry> mAttributes;
+        std::vector<ClusterVersion> mVersions;
+    };
+
+    struct NodeIdLess
+    {
+        bool operator()(const ScopedNodeId & a, const ScopedNodeId & b) const
+        {
+            if (a.GetFabricIndex() != b.GetFabricIndex())
+            {
+                return a.GetFabricIndex() < b.GetFabricIndex();
+            }
+            return a.GetNodeId() < b.GetNodeId();
+        }
+    };
+
+    AttributeEntry & FindOrInsertEntry(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath);
+    const AttributeEntry * FindEntry(const ScopedNodeId & aNode, const ConcreteAttributePath & aPath) const;
+
+    SharedValue * Intern(const ByteSpan & aEncoding);
+    void Release(AttributeEntry & aEntry);
+
+    std::map<ScopedNodeId, NodeState, NodeIdLess> mNodes;
+    std::unordered_multimap<uint64_t, SharedValue *> mSharedValues;
+    size_t mSharedValueBytes = 0;
+
+    // Scratch space to re-encode incoming values with an anonymous tag before storing them.
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mScratch;
+
+    Optional<ConcreteAttributePath> mFailingAttributeForTesting;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
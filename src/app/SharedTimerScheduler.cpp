@@ -0,0 +1,169 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SharedTimerScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+CHIP_ERROR SharedTimerScheduler::Init(System::Layer * apSystemLayer, System::Clock::Milliseconds32 aGranularity)
+{
+    VerifyOrReturnError(apSystemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mpSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mpSystemLayer = apSystemLayer;
+    // A zero granularity would let a timer restarted with no delay from its own callback fire again in the same wake-up.
+    mGranularity = std::max(aGranularity, System::Clock::Milliseconds32(1));
+    return CHIP_NO_ERROR;
+}
+
+void SharedTimerScheduler::Shutdown()
+{
+    if (mpSystemLayer != nullptr)
+    {
+        mpSystemLayer->CancelTimer(HandleSystemTimer, this);
+    }
+    mTimers.clear();
+    mDeadlines.clear();
+    mSystemTimerArmed = false;
+    mpSystemLayer     = nullptr;
+}
+
+System::Clock::Timestamp SharedTimerScheduler::ComputeDeadline(System::Clock::Timeout aDelay) const
+{
+    // Round up to the slot after the one the deadline falls in, so that a deadline is always strictly in the future and
+    // timers expiring within the same slot share a wake-up.
+    const uint64_t granularity = mGranularity.count();
+    const uint64_t deadline    = (System::SystemClock().GetMonotonicTimestamp() + aDelay).count();
+    return System::Clock::Timestamp((deadline / granularity + 1) * granularity);
+}
+
+CHIP_ERROR SharedTimerScheduler::StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aCallback,
+                                            void * apAppState)
+{
+    VerifyOrReturnError(mpSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aCallback != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    TimerKey key(aCallback, apAppState);
+    Remove(key);
+
+    auto deadline = mDeadlines.emplace(ComputeDeadline(aDelay), key);
+    mTimers.emplace(key, deadline);
+
+    CHIP_ERROR err = ArmSystemTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        Remove(key);
+    }
+    return err;
+}
+
+void SharedTimerScheduler::CancelTimer(System::TimerCompleteCallback aCallback, void * apAppState)
+{
+    Remove(TimerKey(aCallback, apAppState));
+
+    // Leave the system timer armed if it is now early; it is cheaper to take a spurious wake-up than to re-arm on every
+    // cancellation, which happens for each report that refreshes a liveness timer.
+    if (mDeadlines.empty() && mSystemTimerArmed && !mFiring)
+    {
+        mpSystemLayer->CancelTimer(HandleSystemTimer, this);
+        mSystemTimerArmed = false;
+    }
+}
+
+bool SharedTimerScheduler::IsTimerActive(System::TimerCompleteCallback aCallback, void * apAppState) const
+{
+    return mTimers.find(TimerKey(aCallback, apAppState)) != mTimers.end();
+}
+
+void SharedTimerScheduler::Remove(const TimerKey & aKey)
+{
+    auto timer = mTimers.find(aKey);
+    if (timer != mTimers.end())
+    {
+        mDeadlines.erase(timer->second);
+        mTimers.erase(timer);
+    }
+}
+
+CHIP_ERROR SharedTimerScheduler::ArmSystemTimer()
+{
+    // FireExpiredTimers() re-arms once all expired timers have run.
+    VerifyOrReturnError(!mFiring, CHIP_NO_ERROR);
+    VerifyOrReturnError(!mDeadlines.empty(), CHIP_NO_ERROR);
+
+    const System::Clock::Timestamp earliest = mDeadlines.begin()->first;
+    if (mSystemTimerArmed && mArmedDeadline <= earliest)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timeout delay =
+        (earliest > now) ? std::chrono::duration_cast<System::Clock::Timeout>(earliest - now) : System::Clock::kZero;
+    ReturnErrorOnFailure(mpSystemLayer->StartTimer(delay, HandleSystemTimer, this));
+    mArmedDeadline    = earliest;
+    mSystemTimerArmed = true;
+    return CHIP_NO_ERROR;
+}
+
+void SharedTimerScheduler::FireExpiredTimers()
+{
+    mSystemTimerArmed = false;
+    mWakeupCount++;
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    // Timers are taken off one at a time: a callback may cancel or restart any other timer (e.g. by closing a
+    // ReadClient), and those changes must be seen before the next expired timer is looked up.
+    mFiring = true;
+    while (mpSystemLayer != nullptr && !mDeadlines.empty() && mDeadlines.begin()->first <= now)
+    {
+        TimerKey key = mDeadlines.begin()->second;
+        Remove(key);
+        key.first(mpSystemLayer, key.second);
+    }
+    mFiring = false;
+
+    if (mpSystemLayer == nullptr)
+    {
+        // Shut down from a callback.
+        return;
+    }
+
+    CHIP_ERROR err = ArmSystemTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to re-arm shared timer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void SharedTimerScheduler::HandleSystemTimer(System::Layer * apSystemLayer, void * apAppState)
+{
+    static_cast<SharedTimerScheduler *>(apAppState)->FireExpiredTimers();
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
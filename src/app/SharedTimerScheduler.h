@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/ReadClient.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <functional>
+#include <map>
+#include <utility>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * A ReadClient::TimerScheduler that runs any number of timers off a single system timer.
+ *
+ * Each ReadClient normally keeps its own liveness timer (and, while disconnected, a resubscription timer) armed on the
+ * system layer, so a controller mirroring a large fleet ends up with thousands of system timers, most of which are
+ * re-armed on every report. This scheduler keeps the deadlines in an ordered map instead and only touches the system
+ * timer when the earliest deadline changes.
+ *
+ * Deadlines are rounded up to the next multiple of a configurable granularity so that timers which expire close
+ * together are dispatched in a single wake-up.  A timer therefore fires up to one granularity late, which is
+ * negligible next to liveness timeouts (max interval plus a round-trip) and resubscription backoff.
+ *
+ * Like the system layer, starting a timer for a callback/state pair that already has one pending replaces it.
+ */
+class SharedTimerScheduler : public ReadClient::TimerScheduler
+{
+public:
+    static constexpr System::Clock::Milliseconds32 kDefaultGranularity = System::Clock::Milliseconds32(100);
+
+    SharedTimerScheduler() = default;
+    ~SharedTimerScheduler() override { Shutdown(); }
+
+    SharedTimerScheduler(const SharedTimerScheduler &)             = delete;
+    SharedTimerScheduler & operator=(const SharedTimerScheduler &) = delete;
+
+    CHIP_ERROR Init(System::Layer * apSystemLayer, System::Clock::Milliseconds32 aGranularity = kDefaultGranularity);
+
+    /*
+     * Drops all pending timers without firing them.
+     */
+    void Shutdown();
+
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aCallback, void * apAppState) override;
+    void CancelTimer(System::TimerCompleteCallback aCallback, void * apAppState) override;
+
+    bool IsTimerActive(System::TimerCompleteCallback aCallback, void * apAppState) const;
+
+    /*
+     * Number of timers currently pending.
+     */
+    size_t GetPendingTimerCount() const { return mTimers.size(); }
+
+    /*
+     * Number of times the underlying system timer has fired.
+     */
+    uint32_t GetWakeupCount() const { return mWakeupCount; }
+
+private:
+    using TimerKey = std::pair<System::TimerCompleteCallback, void *>;
+
+    struct TimerKeyLess
+    {
+        bool operator()(const TimerKey & a, const TimerKey & b) const
+        {
+            if (a.first != b.first)
+            {
+                return std::less<System::TimerCompleteCallback>()(a.first, b.first);
+            }
+            return std::less<void *>()(a.second, b.second);
+        }
+    };
+
+    using DeadlineMap = std::multimap<System::Clock::Timestamp, TimerKey>;
+
+    System::Clock::Timestamp ComputeDeadline(System::Clock::Timeout aDelay) const;
+    void Remove(const TimerKey & aKey);
+    CHIP_ERROR ArmSystemTimer();
+    void FireExpiredTimers();
+
+    static void HandleSystemTimer(System::Layer * apSystemLayer, void * apAppState);
+
+    System::Layer * mpSystemLayer = nullptr;
+    System::Clock::Milliseconds32 mGranularity{ kDefaultGranularity };
+
+    DeadlineMap mDeadlines;
+    std::map<TimerKey, DeadlineMap::iterator, TimerKeyLess> mTimers;
+
+    // Deadline the system timer is currently armed for, if any.
+    System::Clock::Timestamp mArmedDeadline = System::Clock::kZero;
+    bool mSystemTimerArmed                  = false;
+    bool mFiring                            = false;
+    uint32_t mWakeupCount                   = 0;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -47,6 +47,9 @@ constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kAttributeIdTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kEventIdTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kEventPathTypeTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kResumptionRetriesTag;
+constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kDataVersionFiltersListTag;
+constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kDataVersionFilterTag;
+constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kDataVersionTag;
 
 SimpleSubscriptionResumptionStorage::SimpleSubscriptionInfoIterator::SimpleSubscriptionInfoIterator(
     SimpleSubscriptionResumptionStorage & storage) :
@@ -253,23 +256,66 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Load(uint16_t subscriptionIndex,
     }
     ReturnErrorOnFailure(reader.ExitContainer(eventsListType));
 
+    // Optional fields, missing from subscriptions saved by earlier versions
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-    // If the reader cannot get resumption retries, set it to 0 for subscriptionInfo
-    if (reader.Next(kResumptionRetriesTag) == CHIP_NO_ERROR)
-    {
-        ReturnErrorOnFailure(reader.Get(subscriptionInfo.mResumptionRetries));
-    }
-    else
+    subscriptionInfo.mResumptionRetries = 0;
+#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+    subscriptionInfo.mDataVersionFilters.Free();
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
     {
-        subscriptionInfo.mResumptionRetries = 0;
-    }
+#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+        if (reader.GetTag() == kResumptionRetriesTag)
+        {
+            ReturnErrorOnFailure(reader.Get(subscriptionInfo.mResumptionRetries));
+        }
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+        if (reader.GetTag() == kDataVersionFiltersListTag)
+        {
+            ReturnErrorOnFailure(LoadDataVersionFilters(reader, subscriptionInfo));
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
 
     ReturnErrorOnFailure(reader.ExitContainer(subscriptionContainerType));
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR SimpleSubscriptionResumptionStorage::LoadDataVersionFilters(TLV::TLVReader & reader, SubscriptionInfo & subscriptionInfo)
+{
+    VerifyOrReturnError(reader.GetType() == TLV::kTLVType_List, CHIP_ERROR_WRONG_TLV_TYPE);
+    TLV::TLVType filtersListType;
+    ReturnErrorOnFailure(reader.EnterContainer(filtersListType));
+
+    size_t filterCount = 0;
+    ReturnErrorOnFailure(reader.CountRemainingInContainer(&filterCount));
+    if (filterCount)
+    {
+        subscriptionInfo.mDataVersionFilters.Calloc(filterCount);
+        ReturnErrorCodeIf(subscriptionInfo.mDataVersionFilters.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+        for (size_t filterIndex = 0; filterIndex < filterCount; filterIndex++)
+        {
+            ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, kDataVersionFilterTag));
+            TLV::TLVType filterContainerType;
+            ReturnErrorOnFailure(reader.EnterContainer(filterContainerType));
+
+            ReturnErrorOnFailure(reader.Next(kEndpointIdTag));
+            ReturnErrorOnFailure(reader.Get(subscriptionInfo.mDataVersionFilters[filterIndex].mEndpointId));
+
+            ReturnErrorOnFailure(reader.Next(kClusterIdTag));
+            ReturnErrorOnFailure(reader.Get(subscriptionInfo.mDataVersionFilters[filterIndex].mClusterId));
+
+            ReturnErrorOnFailure(reader.Next(kDataVersionTag));
+            ReturnErrorOnFailure(reader.Get(subscriptionInfo.mDataVersionFilters[filterIndex].mDataVersion));
+
+            ReturnErrorOnFailure(reader.ExitContainer(filterContainerType));
+        }
+    }
+    return reader.ExitContainer(filtersListType);
+}
+
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(TLV::TLVWriter & writer, SubscriptionInfo & subscriptionInfo)
 {
     TLV::TLVType subscriptionContainerType;
@@ -324,6 +370,25 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(TLV::TLVWriter & writer, Su
     ReturnErrorOnFailure(writer.Put(kResumptionRetriesTag, subscriptionInfo.mResumptionRetries));
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 
+    // Data version filters
+    if (subscriptionInfo.mDataVersionFilters.AllocatedSize() > 0)
+    {
+        TLV::TLVType filtersListType;
+        ReturnErrorOnFailure(writer.StartContainer(kDataVersionFiltersListTag, TLV::kTLVType_List, filtersListType));
+        for (size_t filterIndex = 0; filterIndex < subscriptionInfo.mDataVersionFilters.AllocatedSize(); filterIndex++)
+        {
+            TLV::TLVType filterContainerType = TLV::kTLVType_Structure;
+            ReturnErrorOnFailure(writer.StartContainer(kDataVersionFilterTag, TLV::kTLVType_Structure, filterContainerType));
+
+            ReturnErrorOnFailure(writer.Put(kEndpointIdTag, subscriptionInfo.mDataVersionFilters[filterIndex].mEndpointId));
+            ReturnErrorOnFailure(writer.Put(kClusterIdTag, subscriptionInfo.mDataVersionFilters[filterIndex].mClusterId));
+            ReturnErrorOnFailure(writer.Put(kDataVersionTag, subscriptionInfo.mDataVersionFilters[filterIndex].mDataVersion));
+
+            ReturnErrorOnFailure(writer.EndContainer(filterContainerType));
+        }
+        ReturnErrorOnFailure(writer.EndContainer(filtersListType));
+    }
+
     ReturnErrorOnFailure(writer.EndContainer(subscriptionContainerType));
 
     return CHIP_NO_ERROR;
@@ -53,6 +53,7 @@ public:
 protected:
     CHIP_ERROR Save(TLV::TLVWriter & writer, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Load(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo);
+    CHIP_ERROR LoadDataVersionFilters(TLV::TLVReader & reader, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Delete(uint16_t subscriptionIndex);
     uint16_t Count();
     CHIP_ERROR DeleteMaxCount();
@@ -82,11 +83,17 @@ protected:
                    CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS);
     }
 
+    static constexpr size_t MaxDataVersionFiltersSize()
+    {
+        return TLV::EstimateStructOverhead(TLV::EstimateStructOverhead(sizeof(EndpointId), sizeof(ClusterId), sizeof(DataVersion)) *
+                                           kMaxDataVersionFilters);
+    }
+
     static constexpr size_t MaxSubscriptionSize()
     {
         // All the fields added together
         return TLV::EstimateStructOverhead(MaxScopedNodeIdSize(), sizeof(SubscriptionId), sizeof(uint16_t), sizeof(uint16_t),
-                                           sizeof(bool), MaxSubscriptionPathsSize());
+                                           sizeof(bool), MaxSubscriptionPathsSize(), sizeof(uint32_t), MaxDataVersionFiltersSize());
     }
 
     enum class EventPathType : uint8_t
@@ -116,23 +123,32 @@ protected:
     //         Endpoint ID
     //         Cluster ID
     //         Event ID
-
-    static constexpr TLV::Tag kPeerNodeIdTag         = TLV::ContextTag(1);
-    static constexpr TLV::Tag kFabricIndexTag        = TLV::ContextTag(2);
-    static constexpr TLV::Tag kSubscriptionIdTag     = TLV::ContextTag(3);
-    static constexpr TLV::Tag kMinIntervalTag        = TLV::ContextTag(4);
-    static constexpr TLV::Tag kMaxIntervalTag        = TLV::ContextTag(5);
-    static constexpr TLV::Tag kFabricFilteredTag     = TLV::ContextTag(6);
-    static constexpr TLV::Tag kAttributePathsListTag = TLV::ContextTag(7);
-    static constexpr TLV::Tag kEventPathsListTag     = TLV::ContextTag(8);
-    static constexpr TLV::Tag kAttributePathTag      = TLV::ContextTag(9);
-    static constexpr TLV::Tag kEventPathTag          = TLV::ContextTag(10);
-    static constexpr TLV::Tag kEndpointIdTag         = TLV::ContextTag(11);
-    static constexpr TLV::Tag kClusterIdTag          = TLV::ContextTag(12);
-    static constexpr TLV::Tag kAttributeIdTag        = TLV::ContextTag(13);
-    static constexpr TLV::Tag kEventIdTag            = TLV::ContextTag(14);
-    static constexpr TLV::Tag kEventPathTypeTag      = TLV::ContextTag(16);
-    static constexpr TLV::Tag kResumptionRetriesTag  = TLV::ContextTag(17);
+    //     Resumption retries (optional)
+    //     List of: (optional)
+    //       Structure of: (Data version filter)
+    //         Endpoint ID
+    //         Cluster ID
+    //         Data version
+
+    static constexpr TLV::Tag kPeerNodeIdTag             = TLV::ContextTag(1);
+    static constexpr TLV::Tag kFabricIndexTag            = TLV::ContextTag(2);
+    static constexpr TLV::Tag kSubscriptionIdTag         = TLV::ContextTag(3);
+    static constexpr TLV::Tag kMinIntervalTag            = TLV::ContextTag(4);
+    static constexpr TLV::Tag kMaxIntervalTag            = TLV::ContextTag(5);
+    static constexpr TLV::Tag kFabricFilteredTag         = TLV::ContextTag(6);
+    static constexpr TLV::Tag kAttributePathsListTag     = TLV::ContextTag(7);
+    static constexpr TLV::Tag kEventPathsListTag         = TLV::ContextTag(8);
+    static constexpr TLV::Tag kAttributePathTag          = TLV::ContextTag(9);
+    static constexpr TLV::Tag kEventPathTag              = TLV::ContextTag(10);
+    static constexpr TLV::Tag kEndpointIdTag             = TLV::ContextTag(11);
+    static constexpr TLV::Tag kClusterIdTag              = TLV::ContextTag(12);
+    static constexpr TLV::Tag kAttributeIdTag            = TLV::ContextTag(13);
+    static constexpr TLV::Tag kEventIdTag                = TLV::ContextTag(14);
+    static constexpr TLV::Tag kEventPathTypeTag          = TLV::ContextTag(16);
+    static constexpr TLV::Tag kResumptionRetriesTag      = TLV::ContextTag(17);
+    static constexpr TLV::Tag kDataVersionFiltersListTag = TLV::ContextTag(18);
+    static constexpr TLV::Tag kDataVersionFilterTag      = TLV::ContextTag(19);
+    static constexpr TLV::Tag kDataVersionTag            = TLV::ContextTag(20);
 
     PersistentStorageDelegate * mStorage;
     ObjectPool<SimpleSubscriptionInfoIterator, kIteratorsMax> mSubscriptionInfoIterators;
@@ -0,0 +1,414 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionMultiplexer.h>
+
+#include <app/InteractionModelEngine.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+class SubscriptionMultiplexer::Node : public ReadClient::Callback
+{
+public:
+    Node(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aId, const SessionHandle * apSession) :
+        mMultiplexer(aMultiplexer), mId(aId), mUsesCase(apSession == nullptr), mBufferedReader(*this)
+    {
+        if (apSession != nullptr)
+        {
+            mSession.Grab(*apSession);
+        }
+    }
+
+    ~Node() override
+    {
+        mMultiplexer.mTimerScheduler.CancelTimer(HandleStartTimer, this);
+        // Destroying an active ReadClient does not call OnDone, so there is nothing to guard against here.
+        mReadClient.reset();
+    }
+
+    CHIP_ERROR Start(System::Clock::Milliseconds32 aDelay)
+    {
+        if (aDelay == System::Clock::kZero)
+        {
+            return Subscribe();
+        }
+        return mMultiplexer.mTimerScheduler.StartTimer(aDelay, HandleStartTimer, this);
+    }
+
+    bool IsSubscriptionActive() const { return mSubscriptionActive; }
+
+    // ReadClient::Callback
+    void OnReportBegin() override { mLastReportCluster = ConcreteClusterPath(); }
+
+    void OnReportEnd() override
+    {
+        CommitPendingDataVersion();
+        mMultiplexer.mCallback.OnReportEnd(mMultiplexer, mId);
+    }
+
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        // BufferedReadCallback hands over lists whole.
+        VerifyOrDie(!aPath.IsListItemOperation());
+
+        SharedAttributeStore & store = mMultiplexer.mStore;
+        bool changed                 = false;
+        CHIP_ERROR err;
+
+        if (apData != nullptr)
+        {
+            UpdateDataVersion(aPath, aPath.mDataVersion);
+            err = store.SetAttribute(mId, aPath, *apData, changed);
+        }
+        else
+        {
+            err = store.SetStatus(mId, aPath, aStatus, changed);
+        }
+
+        if (err != CHIP_NO_ERROR)
+        {
+            InvalidateDataVersion(aPath);
+            ChipLogError(DataManagement,
+                         "Failed to store attribute " ChipLogFormatScopedNodeId " %u/" ChipLogFormatMEI "/" ChipLogFormatMEI
+                         ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueScopedNodeId(mId), aPath.mEndpointId, ChipLogValueMEI(aPath.mClusterId),
+                         ChipLogValueMEI(aPath.mAttributeId), err.Format());
+            return;
+        }
+
+        if (changed)
+        {
+            mMultiplexer.mCallback.OnAttributeChanged(mMultiplexer, mId, aPath);
+        }
+    }
+
+    void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
+    {
+        mSubscriptionActive = true;
+        mMultiplexer.mCallback.OnSubscriptionEstablished(mMultiplexer, mId, aSubscriptionId);
+    }
+
+    CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override
+    {
+        mSubscriptionActive = false;
+        if (aTerminationCause == CHIP_ERROR_LIT_SUBSCRIBE_INACTIVE_TIMEOUT)
+        {
+            return aTerminationCause;
+        }
+
+        System::Clock::Milliseconds32 delay =
+            mMultiplexer.ReserveSubscribeSlot(System::Clock::Milliseconds32(apReadClient->ComputeTimeTillNextSubscription()));
+
+        // As in the default policy, a subscription that timed out most likely lost its session.
+        ReturnErrorOnFailure(apReadClient->ScheduleResubscription(delay.count(), NullOptional,
+                                                                  mUsesCase && aTerminationCause == CHIP_ERROR_TIMEOUT));
+        mMultiplexer.mCallback.OnResubscriptionScheduled(mMultiplexer, mId, aTerminationCause, delay);
+        return CHIP_NO_ERROR;
+    }
+
+    // The path list belongs to the multiplexer and is shared by all the nodes.
+    void OnDeallocatePaths(ReadPrepareParams && aReadPrepareParams) override {}
+
+    CHIP_ERROR OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
+                                             const Span<AttributePathParams> & aAttributePaths,
+                                             bool & aEncodedDataVersionList) override
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        TLV::TLVWriter backup;
+
+        // The versions of the invalid clusters were cleared, so this request has no filter for them and they are reported
+        // whole again.
+        mInvalidClusters.clear();
+
+        std::vector<std::pair<DataVersionFilter, size_t>> filters;
+        mMultiplexer.mStore.GetDataVersionFilters(mId, filters);
+
+        aEncodedDataVersionList = false;
+        for (auto & filter : filters)
+        {
+            aDataVersionFilterIBsBuilder.Checkpoint(backup);
+            err = aDataVersionFilterIBsBuilder.EncodeDataVersionFilterIB(filter.first);
+            if (err != CHIP_NO_ERROR)
+            {
+                break;
+            }
+            aEncodedDataVersionList = true;
+        }
+
+        if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        {
+            ChipLogProgress(DataManagement, "OnUpdateDataVersionFilterList out of space; rolling back");
+            aDataVersionFilterIBsBuilder.Rollback(backup);
+            err = CHIP_NO_ERROR;
+        }
+        return err;
+    }
+
+    void OnError(CHIP_ERROR aError) override { mLastError = aError; }
+
+    void OnDone(ReadClient * apReadClient) override
+    {
+        mReadClient.reset();
+        mSubscriptionActive = false;
+        CHIP_ERROR err      = (mLastError == CHIP_NO_ERROR) ? CHIP_ERROR_INCORRECT_STATE : mLastError;
+        mLastError     = CHIP_NO_ERROR;
+        mMultiplexer.mCallback.OnSubscriptionTerminated(mMultiplexer, mId, err);
+    }
+
+private:
+    static void HandleStartTimer(System::Layer * apSystemLayer, void * apAppState)
+    {
+        Node * node    = static_cast<Node *>(apAppState);
+        CHIP_ERROR err = node->Subscribe();
+        if (err != CHIP_NO_ERROR)
+        {
+            node->mMultiplexer.mCallback.OnSubscriptionTerminated(node->mMultiplexer, node->mId, err);
+        }
+    }
+
+    CHIP_ERROR Subscribe()
+    {
+        InteractionModelEngine * engine = mMultiplexer.mpImEngine;
+        const Params & params           = mMultiplexer.mParams;
+
+        mReadClient = Platform::MakeUnique<ReadClient>(engine, engine->GetExchangeManager(), mBufferedReader,
+                                                       ReadClient::InteractionType::Subscribe);
+        VerifyOrReturnError(mReadClient, CHIP_ERROR_NO_MEMORY);
+        mReadClient->SetTimerScheduler(&mMultiplexer.mTimerScheduler);
+
+        CHIP_ERROR err;
+        if (mUsesCase)
+        {
+            ReadPrepareParams readParams;
+            FillParams(readParams, params);
+            err = mReadClient->SendAutoResubscribeRequest(mId, std::move(readParams));
+        }
+        else
+        {
+            auto session = mSession.Get();
+            VerifyOrExit(session.HasValue(), err = CHIP_ERROR_NOT_CONNECTED);
+            {
+                ReadPrepareParams readParams(session.Value());
+                FillParams(readParams, params);
+                err = mReadClient->SendAutoResubscribeRequest(std::move(readParams));
+            }
+        }
+
+    exit:
+        if (err != CHIP_NO_ERROR)
+        {
+            mReadClient.reset();
+        }
+        return err;
+    }
+
+    static void FillParams(ReadPrepareParams & aReadParams, const Params & aParams)
+    {
+        aReadParams.mpAttributePathParamsList    = aParams.mAttributePaths.data();
+        aReadParams.mAttributePathParamsListSize = aParams.mAttributePaths.size();
+        aReadParams.mMinIntervalFloorSeconds     = aParams.mMinIntervalFloorSeconds;
+        aReadParams.mMaxIntervalCeilingSeconds   = aParams.mMaxIntervalCeilingSeconds;
+        aReadParams.mIsFabricFiltered            = aParams.mIsFabricFiltered;
+        aReadParams.mKeepSubscriptions           = aParams.mKeepSubscriptions;
+    }
+
+    /*
+     * Same bookkeeping as ClusterStateCache: the data version of a cluster is only committed once all its attributes in
+     * the report have been stored, and only for clusters the subscription covers entirely.
+     */
+    void UpdateDataVersion(const ConcreteClusterPath & aPath, const Optional<DataVersion> & aVersion)
+    {
+        // Any incoming data invalidates the version committed so far for the cluster.
+        mMultiplexer.mStore.SetDataVersion(mId, aPath, NullOptional);
+
+        if (mLastReportCluster != aPath)
+        {
+            CommitPendingDataVersion();
+            mLastReportCluster = aPath;
+        }
+
+        if (aVersion.HasValue() && mMultiplexer.CoversWholeCluster(aPath) &&
+            std::find(mInvalidClusters.begin(), mInvalidClusters.end(), aPath) == mInvalidClusters.end())
+        {
+            mPendingDataVersion = aVersion;
+        }
+    }
+
+    /*
+     * Called when an attribute of a cluster could not be stored.  The cluster is missing an attribute, so no version of it
+     * may be used as a filter until it has been reported whole again: not the pending one, nor the one of a later report
+     * that only carries other attributes of the cluster.
+     */
+    void InvalidateDataVersion(const ConcreteClusterPath & aPath)
+    {
+        if (mLastReportCluster == aPath)
+        {
+            mPendingDataVersion.ClearValue();
+        }
+        mMultiplexer.mStore.SetDataVersion(mId, aPath, NullOptional);
+        if (std::find(mInvalidClusters.begin(), mInvalidClusters.end(), aPath) == mInvalidClusters.end())
+        {
+            mInvalidClusters.push_back(aPath);
+        }
+    }
+
+    void CommitPendingDataVersion()
+    {
+        if (mLastReportCluster.IsValidConcreteClusterPath() && mPendingDataVersion.HasValue())
+        {
+            mMultiplexer.mStore.SetDataVersion(mId, mLastReportCluster, mPendingDataVersion);
+        }
+        mPendingDataVersion.ClearValue();
+    }
+
+    SubscriptionMultiplexer & mMultiplexer;
+    const ScopedNodeId mId;
+    SessionHolder mSession;
+    const bool mUsesCase;
+    BufferedReadCallback mBufferedReader;
+    Platform::UniquePtr<ReadClient> mReadClient;
+    ConcreteClusterPath mLastReportCluster;
+    Optional<DataVersion> mPendingDataVersion;
+    // Clusters with an attribute that could not be stored since the last subscription request.
+    std::vector<ConcreteClusterPath> mInvalidClusters;
+    CHIP_ERROR mLastError    = CHIP_NO_ERROR;
+    bool mSubscriptionActive = false;
+};
+
+SubscriptionMultiplexer::SubscriptionMultiplexer(InteractionModelEngine * apImEngine, Callback & aCallback) :
+    mpImEngine(apImEngine), mCallback(aCallback)
+{}
+
+SubscriptionMultiplexer::~SubscriptionMultiplexer()
+{
+    Shutdown();
+}
+
+CHIP_ERROR SubscriptionMultiplexer::Init(const Params & aParams)
+{
+    VerifyOrReturnError(!mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mpImEngine != nullptr && mpImEngine->GetExchangeManager() != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!aParams.mAttributePaths.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(
+        mTimerScheduler.Init(mpImEngine->GetExchangeManager()->GetSessionManager()->SystemLayer(), aParams.mTimerGranularity));
+
+    mParams = aParams;
+    mWholeClusterPaths.clear();
+    for (const auto & path : mParams.mAttributePaths)
+    {
+        if (!path.HasWildcardAttributeId())
+        {
+            continue;
+        }
+        bool intersected = false;
+        for (const auto & other : mParams.mAttributePaths)
+        {
+            if (!other.HasWildcardAttributeId() && path.Intersects(other))
+            {
+                intersected = true;
+                break;
+            }
+        }
+        if (!intersected)
+        {
+            mWholeClusterPaths.push_back(path);
+        }
+    }
+
+    mNextSubscribeSlot = System::Clock::kZero;
+    mInitialized       = true;
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionMultiplexer::Shutdown()
+{
+    VerifyOrReturn(mInitialized);
+    mNodes.clear();
+    mTimerScheduler.Shutdown();
+    mStore.Clear();
+    mWholeClusterPaths.clear();
+    mInitialized = false;
+}
+
+CHIP_ERROR SubscriptionMultiplexer::AddNode(const ScopedNodeId & aNode, const SessionHandle & aSession)
+{
+    return AddNode(aNode, &aSession);
+}
+
+CHIP_ERROR SubscriptionMultiplexer::AddNode(const ScopedNodeId & aNode)
+{
+    VerifyOrReturnError(mpImEngine->GetCASESessionManager() != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AddNode(aNode, nullptr);
+}
+
+CHIP_ERROR SubscriptionMultiplexer::AddNode(const ScopedNodeId & aNode, const SessionHandle * apSession)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!HasNode(aNode), CHIP_ERROR_INCORRECT_STATE);
+
+    auto node = Platform::MakeUnique<Node>(*this, aNode, apSession);
+    VerifyOrReturnError(node, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(node->Start(ReserveSubscribeSlot(System::Clock::kZero)));
+    mNodes.emplace(aNode, std::move(node));
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionMultiplexer::RemoveNode(const ScopedNodeId & aNode)
+{
+    mNodes.erase(aNode);
+    mStore.RemoveNode(aNode);
+}
+
+size_t SubscriptionMultiplexer::GetActiveSubscriptionCount() const
+{
+    return static_cast<size_t>(std::count_if(mNodes.begin(), mNodes.end(),
+                                             [](const auto & entry) { return entry.second->IsSubscriptionActive(); }));
+}
+
+System::Clock::Milliseconds32 SubscriptionMultiplexer::ReserveSubscribeSlot(System::Clock::Milliseconds32 aMinDelay)
+{
+    if (mParams.mMaxSubscribesPerSecond == 0)
+    {
+        return aMinDelay;
+    }
+
+    System::Clock::Microseconds64 now   = System::SystemClock().GetMonotonicMicroseconds64();
+    System::Clock::Microseconds64 start = std::max<System::Clock::Microseconds64>(now + aMinDelay, mNextSubscribeSlot);
+
+    mNextSubscribeSlot = start + System::Clock::Microseconds64(System::Clock::Seconds32(1)) / mParams.mMaxSubscribesPerSecond;
+    // Round up so that no attempt starts before its slot.
+    return std::chrono::ceil<System::Clock::Milliseconds32>(start - now);
+}
+
+bool SubscriptionMultiplexer::CoversWholeCluster(const ConcreteClusterPath & aPath) const
+{
+    return std::any_of(mWholeClusterPaths.begin(), mWholeClusterPaths.end(),
+                       [&aPath](const AttributePathParams & path) { return path.IncludesAllAttributesInCluster(aPath); });
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/AttributePathParams.h>
+#include <app/BufferedReadCallback.h>
+#include <app/ReadClient.h>
+#include <app/SharedAttributeStore.h>
+#include <app/SharedTimerScheduler.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <transport/SessionHolder.h>
+
+#include <map>
+#include <vector>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+class InteractionModelEngine;
+class SubscriptionMultiplexerTestAccess;
+
+/*
+ * Keeps the same set of attribute subscriptions alive on many nodes and mirrors their attributes.
+ *
+ * This is what a controller, bridge or hub managing a large fleet would otherwise build out of one ReadClient plus one
+ * ClusterStateCache per node.  Compared to that, the multiplexer:
+ *
+ *  - drives all the ReadClients' liveness and resubscription timers from a single system timer
+ *    (SharedTimerScheduler), instead of arming one or two system timers per node;
+ *
+ *  - paces subscription attempts across the fleet.  Every initial subscription and every resubscription takes the
+ *    next free slot of a global schedule limited to Params::mMaxSubscribesPerSecond, on top of the per-node
+ *    fibonacci backoff and jitter of ReadClient::ComputeTimeTillNextSubscription().  After a network outage, when
+ *    every subscription times out at about the same time and the first retry has no backoff, the fleet reconnects
+ *    at a bounded rate instead of all at once;
+ *
+ *  - stores the attribute values of all nodes in a SharedAttributeStore, and uses it to send data version filters
+ *    when resubscribing, as ClusterStateCache does.
+ *
+ * All subscriptions use the same attribute paths, given in Params.  Events are not supported.
+ *
+ * Nodes are either reached over a session provided by the caller, or through CASE set up by the CASESessionManager of
+ * the interaction model engine (in which case a subscription that times out also re-establishes CASE, as in
+ * ReadClient::DefaultResubscribePolicy).
+ *
+ * The multiplexer must not be modified (nodes added or removed, shut down) from within its Callback.
+ */
+class SubscriptionMultiplexer
+{
+public:
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        /*
+         * Called when the value (or status) of an attribute of a node is stored for the first time or changes.  Use
+         * GetStore() to read it.
+         */
+        virtual void OnAttributeChanged(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                                        const ConcreteAttributePath & aPath)
+        {}
+
+        /*
+         * Called when a report from a node has been fully processed.
+         */
+        virtual void OnReportEnd(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode) {}
+
+        virtual void OnSubscriptionEstablished(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                                               SubscriptionId aSubscriptionId)
+        {}
+
+        /*
+         * Called when the subscription to a node dropped and a new attempt has been scheduled aDelay from now.
+         */
+        virtual void OnResubscriptionScheduled(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                                               CHIP_ERROR aTerminationCause, System::Clock::Milliseconds32 aDelay)
+        {}
+
+        /*
+         * Called when the subscription to a node ended and will not be retried.  The node and its stored attributes
+         * remain until it is removed.
+         */
+        virtual void OnSubscriptionTerminated(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                                              CHIP_ERROR aError)
+        {}
+    };
+
+    struct Params
+    {
+        // The paths subscribed to on every node.  The list is not copied and must outlive the multiplexer.
+        Span<AttributePathParams> mAttributePaths;
+        uint16_t mMinIntervalFloorSeconds   = 0;
+        uint16_t mMaxIntervalCeilingSeconds = 60;
+        bool mIsFabricFiltered              = true;
+        bool mKeepSubscriptions             = false;
+        // Limit on subscription attempts, initial or not, started per second across all nodes.  0 means no limit.
+        uint16_t mMaxSubscribesPerSecond = 20;
+        // See SharedTimerScheduler.  Attempts scheduled within the same tick start together, so subscriptions are started
+        // in bursts of up to mMaxSubscribesPerSecond * mTimerGranularity: keep the granularity small enough for these
+        // bursts to be absorbed by the network and the nodes.
+        System::Clock::Milliseconds32 mTimerGranularity = SharedTimerScheduler::kDefaultGranularity;
+    };
+
+    SubscriptionMultiplexer(InteractionModelEngine * apImEngine, Callback & aCallback);
+    ~SubscriptionMultiplexer();
+
+    SubscriptionMultiplexer(const SubscriptionMultiplexer &)             = delete;
+    SubscriptionMultiplexer & operator=(const SubscriptionMultiplexer &) = delete;
+
+    CHIP_ERROR Init(const Params & aParams);
+
+    /*
+     * Tears down all the subscriptions and drops all the stored attributes.
+     */
+    void Shutdown();
+
+    /*
+     * Start subscribing to a node over the given session.
+     */
+    CHIP_ERROR AddNode(const ScopedNodeId & aNode, const SessionHandle & aSession);
+
+    /*
+     * Start subscribing to a node, setting up CASE to it first.
+     */
+    CHIP_ERROR AddNode(const ScopedNodeId & aNode);
+
+    /*
+     * Tear down the subscription to a node and drop its stored attributes.
+     */
+    void RemoveNode(const ScopedNodeId & aNode);
+
+    bool HasNode(const ScopedNodeId & aNode) const { return mNodes.find(aNode) != mNodes.end(); }
+    size_t GetNodeCount() const { return mNodes.size(); }
+    size_t GetActiveSubscriptionCount() const;
+
+    const SharedAttributeStore & GetStore() const { return mStore; }
+    const SharedTimerScheduler & GetTimerScheduler() const { return mTimerScheduler; }
+
+private:
+    friend class SubscriptionMultiplexerTestAccess;
+
+    class Node;
+
+    struct NodeIdLess
+    {
+        bool operator()(const ScopedNodeId & a, const ScopedNodeId & b) const
+        {
+            if (a.GetFabricIndex() != b.GetFabricIndex())
+            {
+                return a.GetFabricIndex() < b.GetFabricIndex();
+            }
+            return a.GetNodeId() < b.GetNodeId();
+        }
+    };
+
+    CHIP_ERROR AddNode(const ScopedNodeId & aNode, const SessionHandle * apSession);
+
+    /*
+     * Reserve the first subscription slot at least aMinDelay from now, and return how far from now it is.
+     */
+    System::Clock::Milliseconds32 ReserveSubscribeSlot(System::Clock::Milliseconds32 aMinDelay);
+
+    /*
+     * Whether the data version reported for a cluster can be used in a filter: only if the subscription covers the whole
+     * cluster, so that the reported attributes are all of the cluster's attributes.
+     */
+    bool CoversWholeCluster(const ConcreteClusterPath & aPath) const;
+
+    InteractionModelEngine * const mpImEngine;
+    Callback & mCallback;
+    Params mParams;
+    bool mInitialized = false;
+
+    // Paths of mParams that cover whole clusters and do not overlap a path to a specific attribute.
+    std::vector<AttributePathParams> mWholeClusterPaths;
+
+    SharedTimerScheduler mTimerScheduler;
+    SharedAttributeStore mStore;
+    // Kept in microseconds: above 1000 subscriptions per second, slots are less than a millisecond apart.
+    System::Clock::Microseconds64 mNextSubscribeSlot = System::Clock::kZero;
+
+    std::map<ScopedNodeId, Platform::UniquePtr<Node>, NodeIdLess> mNodes;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
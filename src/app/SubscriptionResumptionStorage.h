@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <app/ConcreteClusterPath.h>
+#include <app/DataVersionFilter.h>
 #include <app/ReadClient.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CommonIterator.h>
@@ -64,6 +66,22 @@ public:
         }
         EventPathParams GetParams() { return EventPathParams(mEndpointId, mClusterId, mEventId, mIsUrgentEvent); }
     };
+    struct DataVersionFilterValues
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        DataVersion mDataVersion;
+        void SetValues(const ConcreteClusterPath & path, DataVersion dataVersion)
+        {
+            mEndpointId  = path.mEndpointId;
+            mClusterId   = path.mClusterId;
+            mDataVersion = dataVersion;
+        }
+        DataVersionFilter GetParams() { return DataVersionFilter(mEndpointId, mClusterId, mDataVersion); }
+    };
+
+    // Maximum number of cluster data versions kept with a subscription.
+    static constexpr size_t kMaxDataVersionFilters = CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS;
 
     /**
      * Struct to hold information about subscriptions
@@ -81,6 +99,10 @@ public:
         bool mFabricFiltered;
         Platform::ScopedMemoryBufferWithSize<AttributePathParamsValues> mAttributePaths;
         Platform::ScopedMemoryBufferWithSize<EventPathParamsValues> mEventPaths;
+        // Data versions of the subscribed clusters when the subscription was established. The priming report of the resumed
+        // subscription skips the clusters that are still at these versions, as it would for DataVersionFilters sent by the
+        // subscriber.
+        Platform::ScopedMemoryBufferWithSize<DataVersionFilterValues> mDataVersionFilters;
         CHIP_ERROR SetAttributePaths(const SingleLinkedListNode<AttributePathParams> * pAttributePathList)
         {
             mAttributePaths.Free();
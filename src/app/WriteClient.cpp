@@ -174,13 +174,15 @@ CHIP_ERROR WriteClient::StartNewMessage()
     // Do not allow timed request with chunks.
     VerifyOrReturnError(!(mTimedWriteTimeoutMs.HasValue() && !mChunks.IsNull()), CHIP_ERROR_NO_MEMORY);
 
-    System::PacketBufferHandle packet = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+    const size_t maxSduLength = mAllowLargePayload ? kMaxLargeSecureSduLengthBytes : kMaxSecureSduLengthBytes;
+
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(maxSduLength);
     VerifyOrReturnError(!packet.IsNull(), CHIP_ERROR_NO_MEMORY);
 
-    // Always limit the size of the packet to fit within kMaxSecureSduLengthBytes regardless of the available buffer capacity.
-    if (packet->AvailableDataLength() > kMaxSecureSduLengthBytes)
+    // Always limit the size of the packet to fit within the maximum SDU length regardless of the available buffer capacity.
+    if (packet->AvailableDataLength() > maxSduLength)
     {
-        reservedSize = static_cast<uint16_t>(packet->AvailableDataLength() - kMaxSecureSduLengthBytes);
+        reservedSize = static_cast<uint16_t>(packet->AvailableDataLength() - maxSduLength);
     }
 
     // ... and we need to reserve some extra space for the MIC field.
@@ -324,6 +326,9 @@ CHIP_ERROR WriteClient::SendWriteRequest(const SessionHandle & session, System::
 
     VerifyOrExit(mState == State::AddAttribute, err = CHIP_ERROR_INCORRECT_STATE);
 
+    // If the chunks were sized for large payloads, ensure that the underlying session supports them.
+    VerifyOrExit(!mAllowLargePayload || session->AllowsLargePayload(), err = CHIP_ERROR_INCORRECT_STATE);
+
     err = FinalizeMessage(false /* hasMoreChunks */);
     SuccessOrExit(err);
 
@@ -122,12 +122,14 @@ public:
      *  @param[in]    apCallback       Callback set by application.
      *  @param[in]    aTimedWriteTimeoutMs If provided, do a timed write using this timeout.
      *  @param[in]    aSuppressResponse If provided, set SuppressResponse field to the provided value
+     *  @param[in]    aAllowLargePayload If true, chunks are sized for sessions that support large payloads (e.g. over TCP) and
+     *                                   SendWriteRequest will fail on sessions that do not.
      */
     WriteClient(Messaging::ExchangeManager * apExchangeMgr, Callback * apCallback, const Optional<uint16_t> & aTimedWriteTimeoutMs,
-                bool aSuppressResponse = false) :
+                bool aSuppressResponse = false, bool aAllowLargePayload = false) :
         mpExchangeMgr(apExchangeMgr),
         mExchangeCtx(*this), mpCallback(apCallback), mTimedWriteTimeoutMs(aTimedWriteTimeoutMs),
-        mSuppressResponse(aSuppressResponse)
+        mSuppressResponse(aSuppressResponse), mAllowLargePayload(aAllowLargePayload)
     {
         assertChipStackLockedByCurrentThread();
     }
@@ -174,6 +176,19 @@ public:
 
         ReturnErrorOnFailure(EnsureMessage());
 
+        if (mAllowLargePayload)
+        {
+            // Large chunks usually fit the whole list, which saves repeating the attribute path for every item.
+            TLV::TLVWriter backupWriter;
+            mWriteRequestBuilder.GetWriteRequests().Checkpoint(backupWriter);
+            CHIP_ERROR err = TryEncodeSingleAttributeDataIB(path, value);
+            if (err != CHIP_ERROR_NO_MEMORY && err != CHIP_ERROR_BUFFER_TOO_SMALL)
+            {
+                return err;
+            }
+            mWriteRequestBuilder.GetWriteRequests().Rollback(backupWriter);
+        }
+
         // Encode an empty list for the chunking protocol.
         ReturnErrorOnFailure(EncodeSingleAttributeDataIB(path, DataModel::List<uint8_t>()));
 
@@ -373,7 +388,8 @@ private:
     // If mTimedWriteTimeoutMs has a value, we are expected to do a timed
     // write.
     Optional<uint16_t> mTimedWriteTimeoutMs;
-    bool mSuppressResponse = false;
+    bool mSuppressResponse  = false;
+    bool mAllowLargePayload = false;
 
     // A list of buffers, one buffer for each chunk.
     System::PacketBufferHandle mChunks;
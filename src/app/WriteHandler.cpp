@@ -82,7 +82,14 @@ void WriteHandler::Close()
 Status WriteHandler::HandleWriteRequestMessage(Messaging::ExchangeContext * apExchangeContext,
                                                System::PacketBufferHandle && aPayload, bool aIsTimedWrite)
 {
-    System::PacketBufferHandle packet = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    // A large request carries more attribute data, and therefore more statuses, than fit in a regular response.
+    size_t maxSduLength = kMaxSecureSduLengthBytes;
+    if (apExchangeContext->HasSessionHandle() && apExchangeContext->GetSessionHandle()->AllowsLargePayload())
+    {
+        maxSduLength = kMaxLargeSecureSduLengthBytes;
+    }
+
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(maxSduLength);
     VerifyOrReturnError(!packet.IsNull(), Status::Failure);
 
     System::PacketBufferTLVWriter messageWriter;
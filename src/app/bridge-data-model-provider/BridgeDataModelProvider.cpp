@@ -0,0 +1,1278 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <app/bridge-data-model-provider/BridgeDataModelProvider.h>
+
+#include <access/AccessControl.h>
+#include <access/RequestPath.h>
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/GlobalAttributes.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace chip {
+namespace app {
+namespace {
+
+using Protocols::InteractionModel::Status;
+namespace Descriptor = Clusters::Descriptor;
+namespace Globals    = Clusters::Globals;
+
+// Descriptor revision served for bridged endpoints. Features (e.g. TagList) are not supported.
+constexpr uint16_t kDescriptorClusterRevision = 2;
+
+constexpr AttributeId kDescriptorAttributes[] = {
+    Descriptor::Attributes::DeviceTypeList::Id,
+    Descriptor::Attributes::ServerList::Id,
+    Descriptor::Attributes::ClientList::Id,
+    Descriptor::Attributes::PartsList::Id,
+};
+
+// Global attributes that are iterated over (i.e. not in GlobalAttributesNotInMetadata), after the cluster attributes.
+constexpr AttributeId kIteratedGlobalAttributes[] = {
+    Globals::Attributes::FeatureMap::Id,
+    Globals::Attributes::ClusterRevision::Id,
+};
+
+// Null flag followed by the largest value: a length-prefixed string.
+constexpr size_t kMaxValueSize = 2 + UINT8_MAX;
+
+size_t IntegerSize(BridgedAttributeType type)
+{
+    switch (type)
+    {
+    case BridgedAttributeType::kBoolean:
+    case BridgedAttributeType::kUnsigned8:
+    case BridgedAttributeType::kSigned8:
+        return 1;
+    case BridgedAttributeType::kUnsigned16:
+    case BridgedAttributeType::kSigned16:
+        return 2;
+    case BridgedAttributeType::kUnsigned32:
+    case BridgedAttributeType::kSigned32:
+        return 4;
+    case BridgedAttributeType::kUnsigned64:
+    case BridgedAttributeType::kSigned64:
+        return 8;
+    case BridgedAttributeType::kCharString:
+        break;
+    }
+    return 0;
+}
+
+bool IsUnsigned(BridgedAttributeType type)
+{
+    return (type >= BridgedAttributeType::kUnsigned8) && (type <= BridgedAttributeType::kUnsigned64);
+}
+
+bool IsSigned(BridgedAttributeType type)
+{
+    return (type >= BridgedAttributeType::kSigned8) && (type <= BridgedAttributeType::kSigned64);
+}
+
+size_t ValueSize(const BridgedAttributeTemplate & attribute)
+{
+    if (attribute.type == BridgedAttributeType::kCharString)
+    {
+        return 2 + attribute.maxLength;
+    }
+    return 1 + IntegerSize(attribute.type);
+}
+
+void PutInteger(uint8_t * out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t GetUnsigned(const uint8_t * in, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+int64_t GetSigned(const uint8_t * in, size_t size)
+{
+    uint64_t value = GetUnsigned(in, size);
+    if (size < sizeof(value))
+    {
+        // sign-extend
+        const uint64_t signBit = 1ull << (8 * size - 1);
+        value                  = (value ^ signBit) - signBit;
+    }
+    return static_cast<int64_t>(value);
+}
+
+bool FitsUnsigned(uint64_t value, size_t size)
+{
+    return (size >= sizeof(value)) || (value < (1ull << (8 * size)));
+}
+
+bool FitsSigned(int64_t value, size_t size)
+{
+    if (size >= sizeof(value))
+    {
+        return true;
+    }
+    const int64_t limit = static_cast<int64_t>(1ull << (8 * size - 1));
+    return (value >= -limit) && (value < limit);
+}
+
+template <typename T>
+std::optional<size_t> IndexOf(Span<const T> items, T item)
+{
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (items[i] == item)
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+/// Decodes a value, which may be null (std::nullopt) if `nullable`.
+template <typename T>
+CHIP_ERROR DecodeNullable(AttributeValueDecoder & decoder, bool nullable, std::optional<T> & value)
+{
+    if (nullable)
+    {
+        DataModel::Nullable<T> decoded;
+        ReturnErrorOnFailure(decoder.Decode(decoded));
+        value = decoded.IsNull() ? std::nullopt : std::make_optional(decoded.Value());
+        return CHIP_NO_ERROR;
+    }
+
+    T decoded;
+    ReturnErrorOnFailure(decoder.Decode(decoded));
+    value = decoded;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CheckAccess(const Access::SubjectDescriptor & subject, const ConcreteClusterPath & path, Access::RequestType type,
+                       std::optional<uint32_t> entityId, Access::Privilege privilege)
+{
+    Access::RequestPath requestPath{ .cluster = path.mClusterId, .endpoint = path.mEndpointId, .requestType = type };
+    if (entityId.has_value())
+    {
+        requestPath.entityId = *entityId;
+    }
+    return Access::GetAccessControl().Check(subject, requestPath, privilege);
+}
+
+} // namespace
+
+BridgeDataModelProvider::BridgeDataModelProvider(DataModel::Provider & fallback, EndpointId firstEndpoint, uint16_t maxEndpoints) :
+    mFallback(fallback), mFirstEndpoint(firstEndpoint),
+    mMaxEndpoints(static_cast<uint16_t>(std::min<size_t>(maxEndpoints, static_cast<size_t>(kInvalidEndpointId - firstEndpoint))))
+{
+    // Endpoint indexes must fit, with kNoIndex to spare, in EndpointState.
+    static_assert(sizeof(EndpointId) == sizeof(uint16_t));
+}
+
+CHIP_ERROR BridgeDataModelProvider::Startup(DataModel::InteractionModelContext context)
+{
+    ReturnErrorOnFailure(DataModel::Provider::Startup(context));
+    return mFallback.Startup(context);
+}
+
+CHIP_ERROR BridgeDataModelProvider::Shutdown()
+{
+    return mFallback.Shutdown();
+}
+
+CHIP_ERROR BridgeDataModelProvider::AddEndpoint(const BridgedEndpointTemplate & endpointTemplate, EndpointId parentEndpoint,
+                                                EndpointId & outEndpoint)
+{
+    uint16_t parentIndex = kNoIndex;
+    if (parentEndpoint != kInvalidEndpointId)
+    {
+        VerifyOrReturnError(FindEndpoint(parentEndpoint) != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        parentIndex = static_cast<uint16_t>(parentEndpoint - mFirstEndpoint);
+    }
+
+    // Endpoint ids are handed out round-robin so that a removed id is not immediately given to another device.
+    size_t index = mMaxEndpoints;
+    for (size_t n = 0; n < mMaxEndpoints; n++)
+    {
+        size_t candidate = (mNextEndpointIndex + n) % mMaxEndpoints;
+        if (candidate >= mEndpoints.size())
+        {
+            mEndpoints.resize(candidate + 1);
+        }
+        if (mEndpoints[candidate].templateIndex == kNoIndex)
+        {
+            index = candidate;
+            break;
+        }
+    }
+    VerifyOrReturnError(index < mMaxEndpoints, CHIP_ERROR_NO_MEMORY);
+
+    auto templateState = std::find_if(mTemplates.begin(), mTemplates.end(),
+                                      [&](const TemplateState & state) { return state.endpointTemplate == &endpointTemplate; });
+    if (templateState == mTemplates.end())
+    {
+        VerifyOrReturnError(mTemplates.size() < kNoIndex, CHIP_ERROR_NO_MEMORY);
+
+        TemplateState state;
+        state.endpointTemplate = &endpointTemplate;
+        for (const BridgedClusterTemplate & cluster : endpointTemplate.clusters)
+        {
+            state.clusterFirstValue.push_back(static_cast<uint16_t>(state.valueOffsets.size()));
+            for (const BridgedAttributeTemplate & attribute : cluster.attributes)
+            {
+                VerifyOrReturnError(state.rowSize + ValueSize(attribute) <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+                state.valueOffsets.push_back(static_cast<uint16_t>(state.rowSize));
+                state.rowSize += ValueSize(attribute);
+            }
+        }
+        state.clusterFirstValue.push_back(static_cast<uint16_t>(state.valueOffsets.size()));
+        templateState = mTemplates.insert(mTemplates.end(), std::move(state));
+    }
+
+    const size_t versionsPerRow = templateState->ClusterCount() + 1;
+    uint32_t row;
+    if (!templateState->freeRows.empty())
+    {
+        row = templateState->freeRows.back();
+        templateState->freeRows.pop_back();
+    }
+    else
+    {
+        VerifyOrReturnError(templateState->dataVersions.size() / versionsPerRow < UINT32_MAX, CHIP_ERROR_NO_MEMORY);
+        row = static_cast<uint32_t>(templateState->dataVersions.size() / versionsPerRow);
+        templateState->values.resize(templateState->values.size() + templateState->rowSize);
+        templateState->dataVersions.resize(templateState->dataVersions.size() + versionsPerRow);
+    }
+
+    // Initial values: all zeroes, except the null flag of nullable attributes.
+    uint8_t * values = templateState->values.data() + row * templateState->rowSize;
+    memset(values, 0, templateState->rowSize);
+    size_t valueIndex = 0;
+    for (const BridgedClusterTemplate & cluster : endpointTemplate.clusters)
+    {
+        for (const BridgedAttributeTemplate & attribute : cluster.attributes)
+        {
+            values[templateState->valueOffsets[valueIndex++]] = attribute.nullable ? 1 : 0;
+        }
+    }
+
+    // Like for ember endpoints, data versions start at random values.
+    DataVersion * versions = templateState->dataVersions.data() + row * versionsPerRow;
+    if (Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(versions), versionsPerRow * sizeof(DataVersion)) != CHIP_NO_ERROR)
+    {
+        memset(versions, 0, versionsPerRow * sizeof(DataVersion));
+    }
+
+    EndpointState & endpoint = mEndpoints[index];
+    endpoint.templateIndex   = static_cast<uint16_t>(templateState - mTemplates.begin());
+    endpoint.row             = row;
+    endpoint.parent          = parentIndex;
+    endpoint.firstChild      = kNoIndex;
+    endpoint.nextSibling     = kNoIndex;
+    if (parentIndex != kNoIndex)
+    {
+        endpoint.nextSibling                = mEndpoints[parentIndex].firstChild;
+        mEndpoints[parentIndex].firstChild = static_cast<uint16_t>(index);
+    }
+
+    mEndpointCount++;
+    mNextEndpointIndex = (index + 1) % mMaxEndpoints;
+    outEndpoint        = EndpointIdAt(index);
+
+    BeginUpdate();
+    OnPartsListChanged(index);
+    MarkDirty(AttributePathParams(outEndpoint));
+    EndUpdate();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BridgeDataModelProvider::RemoveEndpoint(EndpointId endpointId)
+{
+    VerifyOrReturnError(FindEndpoint(endpointId) != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    const size_t index       = static_cast<size_t>(endpointId - mFirstEndpoint);
+    EndpointState & endpoint = mEndpoints[index];
+    VerifyOrReturnError(endpoint.firstChild == kNoIndex, CHIP_ERROR_INCORRECT_STATE);
+
+    // Versions and dirty paths of the ancestors, while the endpoint is still linked to them.
+    OnPartsListChanged(index);
+
+    if (endpoint.parent != kNoIndex)
+    {
+        uint16_t * link = &mEndpoints[endpoint.parent].firstChild;
+        while (*link != index)
+        {
+            link = &mEndpoints[*link].nextSibling;
+        }
+        *link = endpoint.nextSibling;
+    }
+
+    mTemplates[endpoint.templateIndex].freeRows.push_back(endpoint.row);
+    endpoint = EndpointState();
+    mEndpointCount--;
+    return CHIP_NO_ERROR;
+}
+
+const BridgeDataModelProvider::EndpointState * BridgeDataModelProvider::FindEndpoint(EndpointId endpoint) const
+{
+    VerifyOrReturnValue(InBridgedRange(endpoint), nullptr);
+    const size_t index = static_cast<size_t>(endpoint - mFirstEndpoint);
+    VerifyOrReturnValue(index < mEndpoints.size() && mEndpoints[index].templateIndex != kNoIndex, nullptr);
+    return &mEndpoints[index];
+}
+
+std::optional<size_t> BridgeDataModelProvider::FindCluster(const EndpointState & endpoint, ClusterId cluster) const
+{
+    const TemplateState & state = TemplateOf(endpoint);
+    for (size_t i = 0; i < state.ClusterCount(); i++)
+    {
+        if (state.endpointTemplate->clusters[i].id == cluster)
+        {
+            return i;
+        }
+    }
+    if (cluster == Descriptor::Id)
+    {
+        return state.ClusterCount();
+    }
+    return std::nullopt;
+}
+
+ClusterId BridgeDataModelProvider::ClusterIdAt(const TemplateState & state, size_t clusterIndex) const
+{
+    return (clusterIndex < state.ClusterCount()) ? state.endpointTemplate->clusters[clusterIndex].id : Descriptor::Id;
+}
+
+DataVersion & BridgeDataModelProvider::DataVersionOf(const EndpointState & endpoint, size_t clusterIndex)
+{
+    TemplateState & state = mTemplates[endpoint.templateIndex];
+    return state.dataVersions[endpoint.row * (state.ClusterCount() + 1) + clusterIndex];
+}
+
+DataModel::ClusterEntry BridgeDataModelProvider::ClusterEntryAt(EndpointId endpointId, const EndpointState & endpoint,
+                                                                size_t clusterIndex)
+{
+    VerifyOrReturnValue(clusterIndex <= TemplateOf(endpoint).ClusterCount(), DataModel::ClusterEntry::kInvalid);
+    return DataModel::ClusterEntry{ .path = ConcreteClusterPath(endpointId, ClusterIdAt(TemplateOf(endpoint), clusterIndex)),
+                                    .info = DataModel::ClusterInfo(DataVersionOf(endpoint, clusterIndex)) };
+}
+
+size_t BridgeDataModelProvider::AttributeCount(const TemplateState & state, size_t clusterIndex) const
+{
+    const size_t count = (clusterIndex < state.ClusterCount()) ? state.endpointTemplate->clusters[clusterIndex].attributes.size()
+                                                               : ArraySize(kDescriptorAttributes);
+    return count + ArraySize(kIteratedGlobalAttributes);
+}
+
+AttributeId BridgeDataModelProvider::AttributeIdAt(const TemplateState & state, size_t clusterIndex, size_t attributeIndex) const
+{
+    Span<const BridgedAttributeTemplate> attributes;
+    if (clusterIndex < state.ClusterCount())
+    {
+        attributes = state.endpointTemplate->clusters[clusterIndex].attributes;
+    }
+    else if (attributeIndex < ArraySize(kDescriptorAttributes))
+    {
+        return kDescriptorAttributes[attributeIndex];
+    }
+    else
+    {
+        return kIteratedGlobalAttributes[attributeIndex - ArraySize(kDescriptorAttributes)];
+    }
+
+    if (attributeIndex < attributes.size())
+    {
+        return attributes[attributeIndex].id;
+    }
+    return kIteratedGlobalAttributes[attributeIndex - attributes.size()];
+}
+
+std::optional<size_t> BridgeDataModelProvider::FindAttribute(const TemplateState & state, size_t clusterIndex,
+                                                             AttributeId attribute) const
+{
+    const size_t count = AttributeCount(state, clusterIndex);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (AttributeIdAt(state, clusterIndex, i) == attribute)
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+DataModel::AttributeEntry BridgeDataModelProvider::AttributeEntryAt(const ConcreteClusterPath & path, const TemplateState & state,
+                                                                    size_t clusterIndex, size_t attributeIndex) const
+{
+    VerifyOrReturnValue(attributeIndex < AttributeCount(state, clusterIndex), DataModel::AttributeEntry::kInvalid);
+
+    DataModel::AttributeEntry entry;
+    entry.path = ConcreteAttributePath(path.mEndpointId, path.mClusterId, AttributeIdAt(state, clusterIndex, attributeIndex));
+    entry.info.readPrivilege = Access::Privilege::kView;
+
+    if (clusterIndex < state.ClusterCount())
+    {
+        Span<const BridgedAttributeTemplate> attributes = state.endpointTemplate->clusters[clusterIndex].attributes;
+        if (attributeIndex < attributes.size())
+        {
+            entry.info.writePrivilege = attributes[attributeIndex].writePrivilege;
+            entry.info.flags.Set(DataModel::AttributeQualityFlags::kTimed, attributes[attributeIndex].timedWrite);
+        }
+    }
+    else if (attributeIndex < ArraySize(kDescriptorAttributes))
+    {
+        // All the Descriptor attributes are lists.
+        entry.info.flags.Set(DataModel::AttributeQualityFlags::kListAttribute);
+    }
+    return entry;
+}
+
+std::optional<size_t> BridgeDataModelProvider::FindAcceptedCommand(const ConcreteCommandPath & path) const
+{
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, std::nullopt);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value() && *clusterIndex < TemplateOf(*endpoint).ClusterCount(), std::nullopt);
+    return IndexOf(TemplateOf(*endpoint).endpointTemplate->clusters[*clusterIndex].acceptedCommands, path.mCommandId);
+}
+
+std::optional<size_t> BridgeDataModelProvider::FindGeneratedCommand(const ConcreteCommandPath & path) const
+{
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, std::nullopt);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value() && *clusterIndex < TemplateOf(*endpoint).ClusterCount(), std::nullopt);
+    return IndexOf(TemplateOf(*endpoint).endpointTemplate->clusters[*clusterIndex].generatedCommands, path.mCommandId);
+}
+
+CHIP_ERROR BridgeDataModelProvider::LocateValue(const ConcreteAttributePath & path, ValueLocation & location)
+{
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnError(endpoint != nullptr, CHIP_IM_GLOBAL_STATUS(UnsupportedEndpoint));
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnError(clusterIndex.has_value(), CHIP_IM_GLOBAL_STATUS(UnsupportedCluster));
+
+    TemplateState & state = mTemplates[endpoint->templateIndex];
+    VerifyOrReturnError(*clusterIndex < state.ClusterCount(), CHIP_IM_GLOBAL_STATUS(UnsupportedAttribute));
+    Span<const BridgedAttributeTemplate> attributes = state.endpointTemplate->clusters[*clusterIndex].attributes;
+    for (size_t i = 0; i < attributes.size(); i++)
+    {
+        if (attributes[i].id == path.mAttributeId)
+        {
+            const size_t valueIndex = state.clusterFirstValue[*clusterIndex] + i;
+            location.attribute      = &attributes[i];
+            location.value          = state.values.data() + endpoint->row * state.rowSize + state.valueOffsets[valueIndex];
+            location.dataVersion    = &DataVersionOf(*endpoint, *clusterIndex);
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_IM_GLOBAL_STATUS(UnsupportedAttribute);
+}
+
+CHIP_ERROR BridgeDataModelProvider::StoreValue(const ConcreteAttributePath & path, const ValueLocation & location,
+                                               const uint8_t * value)
+{
+    const size_t size = ValueSize(*location.attribute);
+    VerifyOrReturnError(memcmp(location.value, value, size) != 0, CHIP_NO_ERROR);
+
+    memcpy(location.value, value, size);
+    (*location.dataVersion)++;
+    MarkDirty(AttributePathParams(path.mEndpointId, path.mClusterId, path.mAttributeId));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BridgeDataModelProvider::SetAttribute(const ConcreteAttributePath & path, bool value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(location.attribute->type == BridgedAttributeType::kBoolean, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t stored[] = { 0, static_cast<uint8_t>(value ? 1 : 0) };
+    return StoreValue(path, location, stored);
+}
+
+CHIP_ERROR BridgeDataModelProvider::SetAttribute(const ConcreteAttributePath & path, uint64_t value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(IsUnsigned(location.attribute->type), CHIP_ERROR_INVALID_ARGUMENT);
+    const size_t size = IntegerSize(location.attribute->type);
+    VerifyOrReturnError(FitsUnsigned(value, size), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t stored[1 + sizeof(value)] = { 0 };
+    PutInteger(stored + 1, value, size);
+    return StoreValue(path, location, stored);
+}
+
+CHIP_ERROR BridgeDataModelProvider::SetAttribute(const ConcreteAttributePath & path, int64_t value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(IsSigned(location.attribute->type), CHIP_ERROR_INVALID_ARGUMENT);
+    const size_t size = IntegerSize(location.attribute->type);
+    VerifyOrReturnError(FitsSigned(value, size), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t stored[1 + sizeof(value)] = { 0 };
+    PutInteger(stored + 1, static_cast<uint64_t>(value), size);
+    return StoreValue(path, location, stored);
+}
+
+CHIP_ERROR BridgeDataModelProvider::SetAttribute(const ConcreteAttributePath & path, CharSpan value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(location.attribute->type == BridgedAttributeType::kCharString, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value.size() <= location.attribute->maxLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Bytes past the string length stay zero, so that stored values can be compared as a whole.
+    uint8_t stored[kMaxValueSize] = { 0 };
+    stored[1]                     = static_cast<uint8_t>(value.size());
+    memcpy(stored + 2, value.data(), value.size());
+    return StoreValue(path, location, stored);
+}
+
+CHIP_ERROR BridgeDataModelProvider::SetAttributeNull(const ConcreteAttributePath & path)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(location.attribute->nullable, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t stored[kMaxValueSize] = { 1 };
+    return StoreValue(path, location, stored);
+}
+
+CHIP_ERROR BridgeDataModelProvider::GetAttribute(const ConcreteAttributePath & path, bool & value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(location.attribute->type == BridgedAttributeType::kBoolean, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(location.value[0] == 0, CHIP_ERROR_INCORRECT_STATE);
+    value = location.value[1] != 0;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BridgeDataModelProvider::GetAttribute(const ConcreteAttributePath & path, uint64_t & value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(IsUnsigned(location.attribute->type), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(location.value[0] == 0, CHIP_ERROR_INCORRECT_STATE);
+    value = GetUnsigned(location.value + 1, IntegerSize(location.attribute->type));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BridgeDataModelProvider::GetAttribute(const ConcreteAttributePath & path, int64_t & value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(IsSigned(location.attribute->type), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(location.value[0] == 0, CHIP_ERROR_INCORRECT_STATE);
+    value = GetSigned(location.value + 1, IntegerSize(location.attribute->type));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BridgeDataModelProvider::GetAttribute(const ConcreteAttributePath & path, CharSpan & value)
+{
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    VerifyOrReturnError(location.attribute->type == BridgedAttributeType::kCharString, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(location.value[0] == 0, CHIP_ERROR_INCORRECT_STATE);
+    value = CharSpan(reinterpret_cast<const char *>(location.value + 2), location.value[1]);
+    return CHIP_NO_ERROR;
+}
+
+void BridgeDataModelProvider::EndUpdate()
+{
+    VerifyOrReturn(mUpdateDepth > 0);
+    VerifyOrReturn(--mUpdateDepth == 0 && !mDeferredDirtyPaths.empty());
+
+    DataModel::ProviderChangeListener * listener = CurrentContext().dataModelChangeListener;
+    if (listener != nullptr)
+    {
+        listener->MarkDirtyPaths(Span<const AttributePathParams>(mDeferredDirtyPaths.data(), mDeferredDirtyPaths.size()));
+    }
+    mDeferredDirtyPaths.clear();
+}
+
+void BridgeDataModelProvider::OnPartsListChanged(size_t endpointIndex)
+{
+    BeginUpdate();
+
+    // The PartsList of the root endpoint lists every endpoint. Its Descriptor is otherwise owned by the fallback.
+    mRootDescriptorVersionOffset++;
+    MarkDirty(AttributePathParams(kRootEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id));
+
+    bool directParent = true;
+    for (uint16_t ancestor = mEndpoints[endpointIndex].parent; ancestor != kNoIndex; ancestor = mEndpoints[ancestor].parent)
+    {
+        const EndpointState & state = mEndpoints[ancestor];
+        if (directParent || TemplateOf(state).endpointTemplate->composition == BridgedComposition::kFullFamily)
+        {
+            DataVersionOf(state, TemplateOf(state).ClusterCount())++;
+            MarkDirty(AttributePathParams(EndpointIdAt(ancestor), Descriptor::Id, Descriptor::Attributes::PartsList::Id));
+        }
+        directParent = false;
+    }
+
+    EndUpdate();
+}
+
+void BridgeDataModelProvider::MarkDirty(const AttributePathParams & path)
+{
+    if (mUpdateDepth > 0)
+    {
+        mDeferredDirtyPaths.push_back(path);
+        return;
+    }
+
+    DataModel::ProviderChangeListener * listener = CurrentContext().dataModelChangeListener;
+    if (listener != nullptr)
+    {
+        listener->MarkDirty(path);
+    }
+}
+
+bool BridgeDataModelProvider::EventPathIncludesAccessibleConcretePath(const EventPathParams & path,
+                                                                      const Access::SubjectDescriptor & descriptor)
+{
+    auto canAccessCluster = [&](EndpointId endpointId, ClusterId clusterId) {
+        // Bridged clusters have no event metadata: assume that all their events require View.
+        std::optional<uint32_t> eventId;
+        if (!path.HasWildcardEventId())
+        {
+            eventId = path.mEventId;
+        }
+        return CheckAccess(descriptor, ConcreteClusterPath(endpointId, clusterId), Access::RequestType::kEventReadRequest, eventId,
+                           Access::Privilege::kView) == CHIP_NO_ERROR;
+    };
+    auto hasAccessiblePath = [&](size_t index) {
+        const EndpointState & endpoint = mEndpoints[index];
+        if (endpoint.templateIndex == kNoIndex)
+        {
+            return false;
+        }
+        if (!path.HasWildcardClusterId())
+        {
+            return FindCluster(endpoint, path.mClusterId).has_value() && canAccessCluster(EndpointIdAt(index), path.mClusterId);
+        }
+        const TemplateState & state = TemplateOf(endpoint);
+        for (size_t i = 0; i <= state.ClusterCount(); i++)
+        {
+            if (canAccessCluster(EndpointIdAt(index), ClusterIdAt(state, i)))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (!path.HasWildcardEndpointId())
+    {
+        if (!InBridgedRange(path.mEndpointId))
+        {
+            return mFallback.EventPathIncludesAccessibleConcretePath(path, descriptor);
+        }
+        const size_t index = static_cast<size_t>(path.mEndpointId - mFirstEndpoint);
+        return (index < mEndpoints.size()) && hasAccessiblePath(index);
+    }
+
+    if (mFallback.EventPathIncludesAccessibleConcretePath(path, descriptor))
+    {
+        return true;
+    }
+    for (size_t index = 0; index < mEndpoints.size(); index++)
+    {
+        if (hasAccessiblePath(index))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+DataModel::ActionReturnStatus BridgeDataModelProvider::ReadAttribute(const DataModel::ReadAttributeRequest & request,
+                                                                     AttributeValueEncoder & encoder)
+{
+    const ConcreteAttributePath & path = request.path;
+    const bool isRootPartsList         = (path.mEndpointId == kRootEndpointId) && (path.mClusterId == Descriptor::Id) &&
+        (path.mAttributeId == Descriptor::Attributes::PartsList::Id);
+    if (!InBridgedRange(path.mEndpointId) && !isRootPartsList)
+    {
+        return mFallback.ReadAttribute(request, encoder);
+    }
+
+    // ACL check for non-internal requests. All the attributes served here are readable with View.
+    if (!request.operationFlags.Has(DataModel::OperationFlags::kInternal))
+    {
+        VerifyOrReturnError(request.subjectDescriptor.has_value(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        CHIP_ERROR err = CheckAccess(*request.subjectDescriptor, path, Access::RequestType::kAttributeReadRequest,
+                                     path.mAttributeId, Access::Privilege::kView);
+        if (err != CHIP_NO_ERROR)
+        {
+            VerifyOrReturnError((err == CHIP_ERROR_ACCESS_DENIED) || (err == CHIP_ERROR_ACCESS_RESTRICTED_BY_ARL), err);
+
+            // Implementation of 8.4.3.2 of the spec for path expansion
+            if (path.mExpanded)
+            {
+                return CHIP_NO_ERROR;
+            }
+
+            // access denied and access restricted have specific codes for IM
+            return err == CHIP_ERROR_ACCESS_DENIED ? CHIP_IM_GLOBAL_STATUS(UnsupportedAccess)
+                                                   : CHIP_IM_GLOBAL_STATUS(AccessRestricted);
+        }
+    }
+
+    if (isRootPartsList)
+    {
+        return ReadRootPartsList(encoder);
+    }
+
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnError(endpoint != nullptr, Status::UnsupportedEndpoint);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnError(clusterIndex.has_value(), Status::UnsupportedCluster);
+
+    return ReadBridgedAttribute(path, *endpoint, *clusterIndex, encoder);
+}
+
+CHIP_ERROR BridgeDataModelProvider::ReadBridgedAttribute(const ConcreteAttributePath & path, const EndpointState & endpoint,
+                                                         size_t clusterIndex, AttributeValueEncoder & encoder)
+{
+    const TemplateState & state = TemplateOf(endpoint);
+    const BridgedClusterTemplate * cluster =
+        (clusterIndex < state.ClusterCount()) ? &state.endpointTemplate->clusters[clusterIndex] : nullptr;
+
+    switch (path.mAttributeId)
+    {
+    case Globals::Attributes::FeatureMap::Id:
+        return encoder.Encode((cluster != nullptr) ? cluster->featureMap : 0u);
+    case Globals::Attributes::ClusterRevision::Id:
+        return encoder.Encode((cluster != nullptr) ? cluster->clusterRevision : kDescriptorClusterRevision);
+    case Globals::Attributes::AttributeList::Id:
+        return encoder.EncodeList([&](const auto & listEncoder) -> CHIP_ERROR {
+            // Cluster attributes, then global attributes, all in increasing order.
+            const size_t count     = AttributeCount(state, clusterIndex);
+            bool addedExtraGlobals = false;
+            for (size_t i = 0; i < count; i++)
+            {
+                AttributeId id = AttributeIdAt(state, clusterIndex, i);
+                if (!addedExtraGlobals && id > GlobalAttributesNotInMetadata[ArraySize(GlobalAttributesNotInMetadata) - 1])
+                {
+                    for (AttributeId globalId : GlobalAttributesNotInMetadata)
+                    {
+                        ReturnErrorOnFailure(listEncoder.Encode(globalId));
+                    }
+                    addedExtraGlobals = true;
+                }
+                ReturnErrorOnFailure(listEncoder.Encode(id));
+            }
+            return CHIP_NO_ERROR;
+        });
+    case Globals::Attributes::AcceptedCommandList::Id:
+    case Globals::Attributes::GeneratedCommandList::Id:
+        return encoder.EncodeList([&](const auto & listEncoder) -> CHIP_ERROR {
+            VerifyOrReturnError(cluster != nullptr, CHIP_NO_ERROR);
+            const bool accepted = (path.mAttributeId == Globals::Attributes::AcceptedCommandList::Id);
+            for (CommandId command : accepted ? cluster->acceptedCommands : cluster->generatedCommands)
+            {
+                ReturnErrorOnFailure(listEncoder.Encode(command));
+            }
+            return CHIP_NO_ERROR;
+        });
+    default:
+        break;
+    }
+
+    if (cluster == nullptr)
+    {
+        return ReadDescriptorAttribute(path, endpoint, encoder);
+    }
+
+    ValueLocation location;
+    ReturnErrorOnFailure(LocateValue(path, location));
+    const uint8_t * value = location.value;
+    if (value[0] != 0)
+    {
+        return encoder.EncodeNull();
+    }
+
+    const BridgedAttributeType type = location.attribute->type;
+    if (type == BridgedAttributeType::kBoolean)
+    {
+        return encoder.Encode(value[1] != 0);
+    }
+    if (type == BridgedAttributeType::kCharString)
+    {
+        return encoder.Encode(CharSpan(reinterpret_cast<const char *>(value + 2), value[1]));
+    }
+    if (IsSigned(type))
+    {
+        return encoder.Encode(GetSigned(value + 1, IntegerSize(type)));
+    }
+    return encoder.Encode(GetUnsigned(value + 1, IntegerSize(type)));
+}
+
+CHIP_ERROR BridgeDataModelProvider::ReadDescriptorAttribute(const ConcreteAttributePath & path, const EndpointState & endpoint,
+                                                            AttributeValueEncoder & encoder)
+{
+    const TemplateState & state = TemplateOf(endpoint);
+
+    switch (path.mAttributeId)
+    {
+    case Descriptor::Attributes::DeviceTypeList::Id:
+        return encoder.EncodeList([&](const auto & listEncoder) -> CHIP_ERROR {
+            for (const DataModel::DeviceTypeEntry & deviceType : state.endpointTemplate->deviceTypes)
+            {
+                Descriptor::Structs::DeviceTypeStruct::Type entry;
+                entry.deviceType = deviceType.deviceTypeId;
+                entry.revision   = deviceType.deviceTypeVersion;
+                ReturnErrorOnFailure(listEncoder.Encode(entry));
+            }
+            return CHIP_NO_ERROR;
+        });
+    case Descriptor::Attributes::ServerList::Id:
+        return encoder.EncodeList([&](const auto & listEncoder) -> CHIP_ERROR {
+            for (size_t i = 0; i <= state.ClusterCount(); i++)
+            {
+                ReturnErrorOnFailure(listEncoder.Encode(ClusterIdAt(state, i)));
+            }
+            return CHIP_NO_ERROR;
+        });
+    case Descriptor::Attributes::ClientList::Id:
+        return encoder.EncodeEmptyList();
+    case Descriptor::Attributes::PartsList::Id:
+        return encoder.EncodeList([&](const auto & listEncoder) -> CHIP_ERROR {
+            const bool fullFamily = (state.endpointTemplate->composition == BridgedComposition::kFullFamily);
+
+            // Depth-first walk of the children, using the parent links to go back up.
+            const uint16_t root = static_cast<uint16_t>(&endpoint - mEndpoints.data());
+            uint16_t current    = endpoint.firstChild;
+            while (current != kNoIndex)
+            {
+                ReturnErrorOnFailure(listEncoder.Encode(EndpointIdAt(current)));
+                if (fullFamily && mEndpoints[current].firstChild != kNoIndex)
+                {
+                    current = mEndpoints[current].firstChild;
+                    continue;
+                }
+                while (current != root && mEndpoints[current].nextSibling == kNoIndex)
+                {
+                    current = mEndpoints[current].parent;
+                }
+                current = (current == root) ? kNoIndex : mEndpoints[current].nextSibling;
+            }
+            return CHIP_NO_ERROR;
+        });
+    default:
+        return CHIP_IM_GLOBAL_STATUS(UnsupportedAttribute);
+    }
+}
+
+CHIP_ERROR BridgeDataModelProvider::ReadRootPartsList(AttributeValueEncoder & encoder)
+{
+    // Like the Descriptor cluster implementation: every endpoint except the root endpoint itself.
+    return encoder.EncodeList([this](const auto & listEncoder) -> CHIP_ERROR {
+        for (EndpointId endpoint = FirstEndpoint(); endpoint != kInvalidEndpointId; endpoint = NextEndpoint(endpoint))
+        {
+            if (endpoint != kRootEndpointId)
+            {
+                ReturnErrorOnFailure(listEncoder.Encode(endpoint));
+            }
+        }
+        return CHIP_NO_ERROR;
+    });
+}
+
+DataModel::ActionReturnStatus BridgeDataModelProvider::WriteAttribute(const DataModel::WriteAttributeRequest & request,
+                                                                      AttributeValueDecoder & decoder)
+{
+    const ConcreteDataAttributePath & path = request.path;
+    if (!InBridgedRange(path.mEndpointId))
+    {
+        return mFallback.WriteAttribute(request, decoder);
+    }
+
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnError(endpoint != nullptr, Status::UnsupportedEndpoint);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnError(clusterIndex.has_value(), Status::UnsupportedCluster);
+    VerifyOrReturnError(FindAttribute(TemplateOf(*endpoint), *clusterIndex, path.mAttributeId).has_value() ||
+                            IsSupportedGlobalAttributeNotInMetadata(path.mAttributeId),
+                        Status::UnsupportedAttribute);
+
+    // Same order of checks as for ember attributes: writability, then ACL, then timed.
+    ValueLocation location;
+    const bool writable = (LocateValue(path, location) == CHIP_NO_ERROR) && location.attribute->writePrivilege.has_value();
+    VerifyOrReturnError(writable, Status::UnsupportedWrite);
+
+    if (!request.operationFlags.Has(DataModel::OperationFlags::kInternal))
+    {
+        VerifyOrReturnError(request.subjectDescriptor.has_value(), Status::UnsupportedAccess);
+
+        CHIP_ERROR err = CheckAccess(*request.subjectDescriptor, path, Access::RequestType::kAttributeWriteRequest,
+                                     path.mAttributeId, *location.attribute->writePrivilege);
+        if (err != CHIP_NO_ERROR)
+        {
+            VerifyOrReturnValue(err != CHIP_ERROR_ACCESS_DENIED, Status::UnsupportedAccess);
+            VerifyOrReturnValue(err != CHIP_ERROR_ACCESS_RESTRICTED_BY_ARL, Status::AccessRestricted);
+            return err;
+        }
+
+        VerifyOrReturnError(!location.attribute->timedWrite || request.writeFlags.Has(DataModel::WriteFlags::kTimed),
+                            Status::NeedsTimedInteraction);
+    }
+
+    if (path.mDataVersion.HasValue() && path.mDataVersion.Value() != *location.dataVersion)
+    {
+        ChipLogError(DataManagement, "Write Version mismatch for Endpoint 0x%x, Cluster " ChipLogFormatMEI, path.mEndpointId,
+                     ChipLogValueMEI(path.mClusterId));
+        return Status::DataVersionMismatch;
+    }
+
+    uint8_t value[kMaxValueSize] = { 0 };
+    DataModel::ActionReturnStatus status = DecodeValue(*location.attribute, decoder, value);
+    VerifyOrReturnError(status.IsSuccess(), status);
+    ReturnErrorOnFailure(StoreValue(path, location, value));
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->OnAttributeWritten(path);
+    }
+    return CHIP_NO_ERROR;
+}
+
+DataModel::ActionReturnStatus BridgeDataModelProvider::DecodeValue(const BridgedAttributeTemplate & attribute,
+                                                                   AttributeValueDecoder & decoder, uint8_t * value)
+{
+    const size_t size = IntegerSize(attribute.type);
+    switch (attribute.type)
+    {
+    case BridgedAttributeType::kBoolean: {
+        std::optional<bool> decoded;
+        ReturnErrorOnFailure(DecodeNullable(decoder, attribute.nullable, decoded));
+        if (!decoded.has_value())
+        {
+            value[0] = 1; // null
+            return CHIP_NO_ERROR;
+        }
+        value[1] = *decoded ? 1 : 0;
+        return CHIP_NO_ERROR;
+    }
+    case BridgedAttributeType::kCharString: {
+        std::optional<CharSpan> decoded;
+        ReturnErrorOnFailure(DecodeNullable(decoder, attribute.nullable, decoded));
+        if (!decoded.has_value())
+        {
+            value[0] = 1; // null
+            return CHIP_NO_ERROR;
+        }
+        VerifyOrReturnError(decoded->size() <= attribute.maxLength, Status::ConstraintError);
+        value[1] = static_cast<uint8_t>(decoded->size());
+        memcpy(value + 2, decoded->data(), decoded->size());
+        return CHIP_NO_ERROR;
+    }
+    default:
+        break;
+    }
+
+    if (IsSigned(attribute.type))
+    {
+        std::optional<int64_t> decoded;
+        ReturnErrorOnFailure(DecodeNullable(decoder, attribute.nullable, decoded));
+        if (!decoded.has_value())
+        {
+            value[0] = 1; // null
+            return CHIP_NO_ERROR;
+        }
+        VerifyOrReturnError(FitsSigned(*decoded, size), Status::ConstraintError);
+        PutInteger(value + 1, static_cast<uint64_t>(*decoded), size);
+        return CHIP_NO_ERROR;
+    }
+
+    std::optional<uint64_t> decoded;
+    ReturnErrorOnFailure(DecodeNullable(decoder, attribute.nullable, decoded));
+    if (!decoded.has_value())
+    {
+        value[0] = 1; // null
+        return CHIP_NO_ERROR;
+    }
+    VerifyOrReturnError(FitsUnsigned(*decoded, size), Status::ConstraintError);
+    PutInteger(value + 1, *decoded, size);
+    return CHIP_NO_ERROR;
+}
+
+std::optional<DataModel::ActionReturnStatus> BridgeDataModelProvider::Invoke(const DataModel::InvokeRequest & request,
+                                                                             TLV::TLVReader & input_arguments,
+                                                                             CommandHandler * handler)
+{
+    if (!InBridgedRange(request.path.mEndpointId))
+    {
+        return mFallback.Invoke(request, input_arguments, handler);
+    }
+
+    const EndpointState * endpoint = FindEndpoint(request.path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, Status::UnsupportedEndpoint);
+    VerifyOrReturnValue(FindCluster(*endpoint, request.path.mClusterId).has_value(), Status::UnsupportedCluster);
+    VerifyOrReturnValue(FindAcceptedCommand(request.path).has_value() && (mDelegate != nullptr), Status::UnsupportedCommand);
+
+    return mDelegate->Invoke(request, input_arguments, handler);
+}
+
+EndpointId BridgeDataModelProvider::FirstEndpoint()
+{
+    EndpointId endpoint = mFallback.FirstEndpoint();
+    while (endpoint != kInvalidEndpointId && InBridgedRange(endpoint))
+    {
+        endpoint = mFallback.NextEndpoint(endpoint);
+    }
+    if (endpoint != kInvalidEndpointId)
+    {
+        return endpoint;
+    }
+
+    // Bridged endpoints come after all the fallback endpoints.
+    for (size_t index = 0; index < mEndpoints.size(); index++)
+    {
+        if (mEndpoints[index].templateIndex != kNoIndex)
+        {
+            return EndpointIdAt(index);
+        }
+    }
+    return kInvalidEndpointId;
+}
+
+EndpointId BridgeDataModelProvider::NextEndpoint(EndpointId before)
+{
+    size_t index = 0;
+    if (InBridgedRange(before))
+    {
+        index = static_cast<size_t>(before - mFirstEndpoint) + 1;
+    }
+    else
+    {
+        EndpointId endpoint = mFallback.NextEndpoint(before);
+        while (endpoint != kInvalidEndpointId && InBridgedRange(endpoint))
+        {
+            endpoint = mFallback.NextEndpoint(endpoint);
+        }
+        VerifyOrReturnValue(endpoint == kInvalidEndpointId, endpoint);
+    }
+
+    for (; index < mEndpoints.size(); index++)
+    {
+        if (mEndpoints[index].templateIndex != kNoIndex)
+        {
+            return EndpointIdAt(index);
+        }
+    }
+    return kInvalidEndpointId;
+}
+
+bool BridgeDataModelProvider::EndpointExists(EndpointId endpoint)
+{
+    return InBridgedRange(endpoint) ? (FindEndpoint(endpoint) != nullptr) : mFallback.EndpointExists(endpoint);
+}
+
+std::optional<DataModel::DeviceTypeEntry> BridgeDataModelProvider::FirstDeviceType(EndpointId endpointId)
+{
+    VerifyOrReturnValue(InBridgedRange(endpointId), mFallback.FirstDeviceType(endpointId));
+    const EndpointState * endpoint = FindEndpoint(endpointId);
+    VerifyOrReturnValue(endpoint != nullptr && !TemplateOf(*endpoint).endpointTemplate->deviceTypes.empty(), std::nullopt);
+    return TemplateOf(*endpoint).endpointTemplate->deviceTypes[0];
+}
+
+std::optional<DataModel::DeviceTypeEntry> BridgeDataModelProvider::NextDeviceType(EndpointId endpointId,
+                                                                                  const DataModel::DeviceTypeEntry & previous)
+{
+    VerifyOrReturnValue(InBridgedRange(endpointId), mFallback.NextDeviceType(endpointId, previous));
+    const EndpointState * endpoint = FindEndpoint(endpointId);
+    VerifyOrReturnValue(endpoint != nullptr, std::nullopt);
+
+    Span<const DataModel::DeviceTypeEntry> deviceTypes = TemplateOf(*endpoint).endpointTemplate->deviceTypes;
+    std::optional<size_t> index                        = IndexOf(deviceTypes, previous);
+    VerifyOrReturnValue(index.has_value() && *index + 1 < deviceTypes.size(), std::nullopt);
+    return deviceTypes[*index + 1];
+}
+
+DataModel::ClusterEntry BridgeDataModelProvider::FirstCluster(EndpointId endpointId)
+{
+    if (!InBridgedRange(endpointId))
+    {
+        DataModel::ClusterEntry entry = mFallback.FirstCluster(endpointId);
+        if (entry.path.mEndpointId == kRootEndpointId && entry.path.mClusterId == Descriptor::Id)
+        {
+            entry.info.dataVersion += mRootDescriptorVersionOffset;
+        }
+        return entry;
+    }
+
+    const EndpointState * endpoint = FindEndpoint(endpointId);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::ClusterEntry::kInvalid);
+    return ClusterEntryAt(endpointId, *endpoint, 0);
+}
+
+DataModel::ClusterEntry BridgeDataModelProvider::NextCluster(const ConcreteClusterPath & before)
+{
+    if (!InBridgedRange(before.mEndpointId))
+    {
+        DataModel::ClusterEntry entry = mFallback.NextCluster(before);
+        if (entry.path.mEndpointId == kRootEndpointId && entry.path.mClusterId == Descriptor::Id)
+        {
+            entry.info.dataVersion += mRootDescriptorVersionOffset;
+        }
+        return entry;
+    }
+
+    const EndpointState * endpoint = FindEndpoint(before.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::ClusterEntry::kInvalid);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, before.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value(), DataModel::ClusterEntry::kInvalid);
+    return ClusterEntryAt(before.mEndpointId, *endpoint, *clusterIndex + 1);
+}
+
+std::optional<DataModel::ClusterInfo> BridgeDataModelProvider::GetClusterInfo(const ConcreteClusterPath & path)
+{
+    if (!InBridgedRange(path.mEndpointId))
+    {
+        std::optional<DataModel::ClusterInfo> info = mFallback.GetClusterInfo(path);
+        if (info.has_value() && path.mEndpointId == kRootEndpointId && path.mClusterId == Descriptor::Id)
+        {
+            info->dataVersion += mRootDescriptorVersionOffset;
+        }
+        return info;
+    }
+
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, std::nullopt);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value(), std::nullopt);
+    return DataModel::ClusterInfo(DataVersionOf(*endpoint, *clusterIndex));
+}
+
+DataModel::AttributeEntry BridgeDataModelProvider::FirstAttribute(const ConcreteClusterPath & path)
+{
+    VerifyOrReturnValue(InBridgedRange(path.mEndpointId), mFallback.FirstAttribute(path));
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::AttributeEntry::kInvalid);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value(), DataModel::AttributeEntry::kInvalid);
+    return AttributeEntryAt(path, TemplateOf(*endpoint), *clusterIndex, 0);
+}
+
+DataModel::AttributeEntry BridgeDataModelProvider::NextAttribute(const ConcreteAttributePath & before)
+{
+    VerifyOrReturnValue(InBridgedRange(before.mEndpointId), mFallback.NextAttribute(before));
+    const EndpointState * endpoint = FindEndpoint(before.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::AttributeEntry::kInvalid);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, before.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value(), DataModel::AttributeEntry::kInvalid);
+    std::optional<size_t> attributeIndex = FindAttribute(TemplateOf(*endpoint), *clusterIndex, before.mAttributeId);
+    VerifyOrReturnValue(attributeIndex.has_value(), DataModel::AttributeEntry::kInvalid);
+    return AttributeEntryAt(before, TemplateOf(*endpoint), *clusterIndex, *attributeIndex + 1);
+}
+
+std::optional<DataModel::AttributeInfo> BridgeDataModelProvider::GetAttributeInfo(const ConcreteAttributePath & path)
+{
+    VerifyOrReturnValue(InBridgedRange(path.mEndpointId), mFallback.GetAttributeInfo(path));
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, std::nullopt);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value(), std::nullopt);
+    std::optional<size_t> attributeIndex = FindAttribute(TemplateOf(*endpoint), *clusterIndex, path.mAttributeId);
+    VerifyOrReturnValue(attributeIndex.has_value(), std::nullopt);
+    return AttributeEntryAt(path, TemplateOf(*endpoint), *clusterIndex, *attributeIndex).info;
+}
+
+DataModel::CommandEntry BridgeDataModelProvider::FirstAcceptedCommand(const ConcreteClusterPath & path)
+{
+    VerifyOrReturnValue(InBridgedRange(path.mEndpointId), mFallback.FirstAcceptedCommand(path));
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::CommandEntry::kInvalid);
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value() && *clusterIndex < TemplateOf(*endpoint).ClusterCount(),
+                        DataModel::CommandEntry::kInvalid);
+
+    Span<const CommandId> commands = TemplateOf(*endpoint).endpointTemplate->clusters[*clusterIndex].acceptedCommands;
+    VerifyOrReturnValue(!commands.empty(), DataModel::CommandEntry::kInvalid);
+    return DataModel::CommandEntry{ .path = ConcreteCommandPath(path.mEndpointId, path.mClusterId, commands[0]), .info = {} };
+}
+
+DataModel::CommandEntry BridgeDataModelProvider::NextAcceptedCommand(const ConcreteCommandPath & before)
+{
+    VerifyOrReturnValue(InBridgedRange(before.mEndpointId), mFallback.NextAcceptedCommand(before));
+    std::optional<size_t> index = FindAcceptedCommand(before);
+    VerifyOrReturnValue(index.has_value(), DataModel::CommandEntry::kInvalid);
+
+    const EndpointState * endpoint = FindEndpoint(before.mEndpointId);
+    Span<const CommandId> commands =
+        TemplateOf(*endpoint).endpointTemplate->clusters[*FindCluster(*endpoint, before.mClusterId)].acceptedCommands;
+    VerifyOrReturnValue(*index + 1 < commands.size(), DataModel::CommandEntry::kInvalid);
+    return DataModel::CommandEntry{ .path = ConcreteCommandPath(before.mEndpointId, before.mClusterId, commands[*index + 1]),
+                                    .info = {} };
+}
+
+std::optional<DataModel::CommandInfo> BridgeDataModelProvider::GetAcceptedCommandInfo(const ConcreteCommandPath & path)
+{
+    VerifyOrReturnValue(InBridgedRange(path.mEndpointId), mFallback.GetAcceptedCommandInfo(path));
+    VerifyOrReturnValue(FindAcceptedCommand(path).has_value(), std::nullopt);
+    return DataModel::CommandInfo{};
+}
+
+ConcreteCommandPath BridgeDataModelProvider::FirstGeneratedCommand(const ConcreteClusterPath & path)
+{
+    VerifyOrReturnValue(InBridgedRange(path.mEndpointId), mFallback.FirstGeneratedCommand(path));
+    const EndpointState * endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint != nullptr, ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId));
+    std::optional<size_t> clusterIndex = FindCluster(*endpoint, path.mClusterId);
+    VerifyOrReturnValue(clusterIndex.has_value() && *clusterIndex < TemplateOf(*endpoint).ClusterCount(),
+                        ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId));
+
+    Span<const CommandId> commands = TemplateOf(*endpoint).endpointTemplate->clusters[*clusterIndex].generatedCommands;
+    VerifyOrReturnValue(!commands.empty(), ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId));
+    return ConcreteCommandPath(path.mEndpointId, path.mClusterId, commands[0]);
+}
+
+ConcreteCommandPath BridgeDataModelProvider::NextGeneratedCommand(const ConcreteCommandPath & before)
+{
+    VerifyOrReturnValue(InBridgedRange(before.mEndpointId), mFallback.NextGeneratedCommand(before));
+    std::optional<size_t> index = FindGeneratedCommand(before);
+    VerifyOrReturnValue(index.has_value(), ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId));
+
+    const EndpointState * endpoint = FindEndpoint(before.mEndpointId);
+    Span<const CommandId> commands =
+        TemplateOf(*endpoint).endpointTemplate->clusters[*FindCluster(*endpoint, before.mClusterId)].generatedCommands;
+    VerifyOrReturnValue(*index + 1 < commands.size(),
+                        ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId));
+    return ConcreteCommandPath(before.mEndpointId, before.mClusterId, commands[*index + 1]);
+}
+
+} // namespace app
+} // namespace chip
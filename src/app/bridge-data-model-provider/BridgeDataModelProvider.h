@@ -0,0 +1,297 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/data-model-provider/Provider.h>
+#include <lib/support/Span.h>
+
+#include <optional>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/// How the value of a bridged attribute is stored and encoded.
+enum class BridgedAttributeType : uint8_t
+{
+    kBoolean,
+    kUnsigned8,
+    kUnsigned16,
+    kUnsigned32,
+    kUnsigned64,
+    kSigned8,
+    kSigned16,
+    kSigned32,
+    kSigned64,
+    kCharString, // at most `maxLength` bytes of UTF-8
+};
+
+/// Metadata of one attribute of a bridged cluster. Global attributes are generated and must not be listed.
+struct BridgedAttributeTemplate
+{
+    AttributeId id;
+    BridgedAttributeType type;
+    uint8_t maxLength = 0; // only for kCharString
+    bool nullable     = false;
+    // Missing if the attribute is read-only. Reading always requires View.
+    std::optional<Access::Privilege> writePrivilege = std::nullopt;
+    bool timedWrite                                 = false;
+};
+
+/// Metadata of one server cluster of a bridged endpoint.
+struct BridgedClusterTemplate
+{
+    ClusterId id;
+    uint16_t clusterRevision;
+    uint32_t featureMap;
+    Span<const BridgedAttributeTemplate> attributes; // sorted by id
+    Span<const CommandId> acceptedCommands;
+    Span<const CommandId> generatedCommands;
+};
+
+/// How the Descriptor PartsList of a bridged endpoint is built from its children.
+enum class BridgedComposition : uint8_t
+{
+    kFullFamily, // all the descendants (e.g. Aggregator)
+    kTree,       // only the direct children
+};
+
+/// Metadata of a kind of bridged endpoint, shared by every endpoint of that kind.
+///
+/// The Descriptor cluster is generated by BridgeDataModelProvider and must not be listed in `clusters`.
+struct BridgedEndpointTemplate
+{
+    Span<const DataModel::DeviceTypeEntry> deviceTypes;
+    Span<const BridgedClusterTemplate> clusters;
+    BridgedComposition composition = BridgedComposition::kFullFamily;
+};
+
+/// A data model provider for bridges exposing a large number of bridged endpoints.
+///
+/// Endpoints in [firstEndpoint, firstEndpoint + maxEndpoints) are served by this provider; every other
+/// endpoint (root node, fixed endpoints...) is forwarded to a fallback provider, generally the
+/// CodegenDataModelProvider, which must not use endpoints in that range.
+///
+/// Endpoint metadata is not copied per endpoint: each endpoint references a shared BridgedEndpointTemplate.
+/// Attribute values and cluster data versions live in flat arrays per template, so an endpoint costs a few
+/// bytes of bookkeeping plus its values. Finding the state of a path is a direct index by endpoint id followed
+/// by a search of the (few) clusters and attributes of its template, independent of the number of endpoints.
+///
+/// The Descriptor cluster of bridged endpoints is generated from the template and the endpoint tree. The
+/// PartsList of the root endpoint is also served here, as it must list the bridged endpoints.
+///
+/// Ember knows nothing about bridged endpoints, so the application must build with the interaction model
+/// using data model providers only (chip_use_data_model_interface = "enabled").
+///
+/// Like every Provider, this class is single-threaded: all calls must be made from the Matter event loop.
+class BridgeDataModelProvider : public DataModel::Provider
+{
+public:
+    /// Application callbacks for client interactions with bridged endpoints.
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /// Called after a client wrote a bridged attribute. The new value is already stored.
+        virtual void OnAttributeWritten(const ConcreteAttributePath & path) {}
+
+        /// Handles a command accepted by a bridged cluster. Same contract as DataModel::Provider::Invoke.
+        virtual std::optional<DataModel::ActionReturnStatus> Invoke(const DataModel::InvokeRequest & request,
+                                                                    TLV::TLVReader & input_arguments, CommandHandler * handler) = 0;
+    };
+
+    BridgeDataModelProvider(DataModel::Provider & fallback, EndpointId firstEndpoint, uint16_t maxEndpoints);
+
+    void SetDelegate(Delegate * delegate) { mDelegate = delegate; }
+
+    /// Adds a bridged endpoint described by `endpointTemplate`, which must outlive this provider.
+    ///
+    /// `parentEndpoint` is another bridged endpoint (e.g. an aggregator, or the bridged node of a composed
+    /// device) or kInvalidEndpointId for a top-level endpoint. Attributes start out as null when nullable,
+    /// and as 0, false or an empty string otherwise.
+    ///
+    /// Endpoint ids are not reused until all the other ids of the range were used. Returns CHIP_ERROR_NO_MEMORY
+    /// when they are all in use.
+    CHIP_ERROR AddEndpoint(const BridgedEndpointTemplate & endpointTemplate, EndpointId parentEndpoint, EndpointId & outEndpoint);
+
+    /// Removes a bridged endpoint, which must not have children.
+    CHIP_ERROR RemoveEndpoint(EndpointId endpoint);
+
+    /// Updates the stored value of a bridged attribute. When the value changes, the cluster data version is
+    /// incremented and the attribute is marked dirty for reporting.
+    ///
+    /// Integer values must fit in the attribute type. Fails with an UnsupportedEndpoint/Cluster/Attribute IM
+    /// status if the path does not exist.
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & path, bool value);
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & path, uint64_t value);
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & path, int64_t value);
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & path, CharSpan value);
+    CHIP_ERROR SetAttributeNull(const ConcreteAttributePath & path);
+
+    /// Gets the stored value of a bridged attribute. Returns CHIP_ERROR_INCORRECT_STATE if the value is null.
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, bool & value);
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, uint64_t & value);
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, int64_t & value);
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, CharSpan & value);
+
+    /// Defers the dirty marking of changed attributes until the matching EndUpdate(), which hands every path
+    /// changed in between to the reporting engine at once. Bridges refreshing many attributes from their
+    /// devices should wrap the SetAttribute calls of a refresh in BeginUpdate()/EndUpdate(). Calls may nest.
+    void BeginUpdate() { mUpdateDepth++; }
+    void EndUpdate();
+
+    bool IsBridgedEndpoint(EndpointId endpoint) const { return FindEndpoint(endpoint) != nullptr; }
+    size_t BridgedEndpointCount() const { return mEndpointCount; }
+
+    /// Generic model implementations
+    CHIP_ERROR Startup(DataModel::InteractionModelContext context) override;
+    CHIP_ERROR Shutdown() override;
+
+    bool EventPathIncludesAccessibleConcretePath(const EventPathParams & path,
+                                                 const Access::SubjectDescriptor & descriptor) override;
+    DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
+                                                AttributeValueEncoder & encoder) override;
+    DataModel::ActionReturnStatus WriteAttribute(const DataModel::WriteAttributeRequest & request,
+                                                 AttributeValueDecoder & decoder) override;
+    std::optional<DataModel::ActionReturnStatus> Invoke(const DataModel::InvokeRequest & request,
+                                                        chip::TLV::TLVReader & input_arguments, CommandHandler * handler) override;
+
+    /// attribute tree iteration
+    EndpointId FirstEndpoint() override;
+    EndpointId NextEndpoint(EndpointId before) override;
+    bool EndpointExists(EndpointId endpoint) override;
+
+    std::optional<DataModel::DeviceTypeEntry> FirstDeviceType(EndpointId endpoint) override;
+    std::optional<DataModel::DeviceTypeEntry> NextDeviceType(EndpointId endpoint,
+                                                             const DataModel::DeviceTypeEntry & previous) override;
+
+    DataModel::ClusterEntry FirstCluster(EndpointId endpoint) override;
+    DataModel::ClusterEntry NextCluster(const ConcreteClusterPath & before) override;
+    std::optional<DataModel::ClusterInfo> GetClusterInfo(const ConcreteClusterPath & path) override;
+
+    DataModel::AttributeEntry FirstAttribute(const ConcreteClusterPath & cluster) override;
+    DataModel::AttributeEntry NextAttribute(const ConcreteAttributePath & before) override;
+    std::optional<DataModel::AttributeInfo> GetAttributeInfo(const ConcreteAttributePath & path) override;
+
+    DataModel::CommandEntry FirstAcceptedCommand(const ConcreteClusterPath & cluster) override;
+    DataModel::CommandEntry NextAcceptedCommand(const ConcreteCommandPath & before) override;
+    std::optional<DataModel::CommandInfo> GetAcceptedCommandInfo(const ConcreteCommandPath & path) override;
+
+    ConcreteCommandPath FirstGeneratedCommand(const ConcreteClusterPath & cluster) override;
+    ConcreteCommandPath NextGeneratedCommand(const ConcreteCommandPath & before) override;
+
+private:
+    static constexpr uint16_t kNoIndex = 0xFFFF;
+
+    /// Value layout and storage of the endpoints sharing a template.
+    ///
+    /// Every endpoint owns a row of `values` and a row of `dataVersions` (one per cluster, then the Descriptor).
+    /// An attribute value is a null flag followed by its little-endian integer or length-prefixed string.
+    struct TemplateState
+    {
+        const BridgedEndpointTemplate * endpointTemplate = nullptr;
+
+        std::vector<uint16_t> clusterFirstValue; // index in valueOffsets of the first attribute of each cluster
+        std::vector<uint16_t> valueOffsets;      // offset of each attribute value in a row
+        size_t rowSize = 0;
+
+        std::vector<uint8_t> values;
+        std::vector<DataVersion> dataVersions;
+        std::vector<uint32_t> freeRows;
+
+        size_t ClusterCount() const { return endpointTemplate->clusters.size(); }
+    };
+
+    struct EndpointState
+    {
+        uint16_t templateIndex = kNoIndex; // kNoIndex if the endpoint id is not in use
+        uint32_t row           = 0;
+        // Parent and children are indexes in mEndpoints; children form a singly-linked list.
+        uint16_t parent      = kNoIndex;
+        uint16_t firstChild  = kNoIndex;
+        uint16_t nextSibling = kNoIndex;
+    };
+
+    /// Storage of a bridged attribute value.
+    struct ValueLocation
+    {
+        const BridgedAttributeTemplate * attribute = nullptr;
+        uint8_t * value                            = nullptr;
+        DataVersion * dataVersion                  = nullptr;
+    };
+
+    bool InBridgedRange(EndpointId endpoint) const
+    {
+        return (endpoint >= mFirstEndpoint) && (endpoint - mFirstEndpoint < mMaxEndpoints);
+    }
+    const EndpointState * FindEndpoint(EndpointId endpoint) const;
+    EndpointId EndpointIdAt(size_t index) const { return static_cast<EndpointId>(mFirstEndpoint + index); }
+    const TemplateState & TemplateOf(const EndpointState & endpoint) const { return mTemplates[endpoint.templateIndex]; }
+
+    /// Clusters of an endpoint are numbered in template order, the Descriptor cluster coming last.
+    std::optional<size_t> FindCluster(const EndpointState & endpoint, ClusterId cluster) const;
+    ClusterId ClusterIdAt(const TemplateState & state, size_t clusterIndex) const;
+    DataVersion & DataVersionOf(const EndpointState & endpoint, size_t clusterIndex);
+    DataModel::ClusterEntry ClusterEntryAt(EndpointId endpointId, const EndpointState & endpoint, size_t clusterIndex);
+
+    /// Attributes of a cluster are numbered in template order, FeatureMap and ClusterRevision coming last.
+    size_t AttributeCount(const TemplateState & state, size_t clusterIndex) const;
+    AttributeId AttributeIdAt(const TemplateState & state, size_t clusterIndex, size_t attributeIndex) const;
+    std::optional<size_t> FindAttribute(const TemplateState & state, size_t clusterIndex, AttributeId attribute) const;
+    DataModel::AttributeEntry AttributeEntryAt(const ConcreteClusterPath & path, const TemplateState & state, size_t clusterIndex,
+                                               size_t attributeIndex) const;
+
+    std::optional<size_t> FindAcceptedCommand(const ConcreteCommandPath & path) const;
+    std::optional<size_t> FindGeneratedCommand(const ConcreteCommandPath & path) const;
+
+    CHIP_ERROR LocateValue(const ConcreteAttributePath & path, ValueLocation & location);
+    CHIP_ERROR StoreValue(const ConcreteAttributePath & path, const ValueLocation & location, const uint8_t * value);
+
+    CHIP_ERROR ReadBridgedAttribute(const ConcreteAttributePath & path, const EndpointState & endpoint, size_t clusterIndex,
+                                    AttributeValueEncoder & encoder);
+    CHIP_ERROR ReadDescriptorAttribute(const ConcreteAttributePath & path, const EndpointState & endpoint,
+                                       AttributeValueEncoder & encoder);
+    CHIP_ERROR ReadRootPartsList(AttributeValueEncoder & encoder);
+    DataModel::ActionReturnStatus DecodeValue(const BridgedAttributeTemplate & attribute, AttributeValueDecoder & decoder,
+                                              uint8_t * value);
+
+    /// Bumps the Descriptor data versions and marks the PartsList attributes that list `endpointIndex` dirty.
+    void OnPartsListChanged(size_t endpointIndex);
+    void MarkDirty(const AttributePathParams & path);
+
+    DataModel::Provider & mFallback;
+    Delegate * mDelegate = nullptr;
+
+    const EndpointId mFirstEndpoint;
+    const uint16_t mMaxEndpoints;
+    std::vector<EndpointState> mEndpoints; // grows up to mMaxEndpoints as ids get used
+    std::vector<TemplateState> mTemplates;
+    size_t mEndpointCount     = 0;
+    size_t mNextEndpointIndex = 0;
+
+    // Added to the root endpoint Descriptor data version of the fallback provider, so that the version changes
+    // whenever the bridged endpoints listed in the root PartsList do.
+    DataVersion mRootDescriptorVersionOffset = 0;
+
+    // Paths changed since the outermost BeginUpdate(), marked dirty by the last EndUpdate().
+    unsigned mUpdateDepth = 0;
+    std::vector<AttributePathParams> mDeferredDirtyPaths;
+};
+
+} // namespace app
+} // namespace chip
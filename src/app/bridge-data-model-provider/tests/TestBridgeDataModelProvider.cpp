@@ -0,0 +1,760 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <access/AccessControl.h>
+#include <access/SubjectDescriptor.h>
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app-common/zap-generated/ids/Commands.h>
+#include <app/bridge-data-model-provider/BridgeDataModelProvider.h>
+#include <app/data-model-provider/StringBuilderAdapters.h>
+#include <app/data-model-provider/tests/ReadTesting.h>
+#include <app/data-model-provider/tests/TestConstants.h>
+#include <app/data-model-provider/tests/WriteTesting.h>
+#include <app/data-model/DecodableList.h>
+#include <app/data-model/Nullable.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/Span.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::DataModel;
+using namespace chip::app::Testing;
+using namespace chip::app::Clusters;
+
+using Protocols::InteractionModel::Status;
+
+namespace {
+
+constexpr EndpointId kFirstBridgedEndpoint = 10;
+constexpr DataVersion kRootDescriptorVersion = 100;
+
+constexpr DeviceTypeEntry kAggregatorDeviceTypes[] = { { .deviceTypeId = 0x000E, .deviceTypeVersion = 1 } };
+constexpr DeviceTypeEntry kLightDeviceTypes[]      = { { .deviceTypeId = 0x0100, .deviceTypeVersion = 3 },
+                                                       { .deviceTypeId = 0x0013, .deviceTypeVersion = 2 } };
+
+const BridgedAttributeTemplate kOnOffAttributes[] = {
+    { .id = OnOff::Attributes::OnOff::Id, .type = BridgedAttributeType::kBoolean },
+    { .id             = OnOff::Attributes::OnTime::Id,
+      .type           = BridgedAttributeType::kUnsigned16,
+      .writePrivilege = Access::Privilege::kOperate },
+    { .id             = OnOff::Attributes::StartUpOnOff::Id,
+      .type           = BridgedAttributeType::kUnsigned8,
+      .nullable       = true,
+      .writePrivilege = Access::Privilege::kManage,
+      .timedWrite     = true },
+};
+
+const BridgedAttributeTemplate kBasicInformationAttributes[] = {
+    { .id             = BridgedDeviceBasicInformation::Attributes::NodeLabel::Id,
+      .type           = BridgedAttributeType::kCharString,
+      .maxLength      = 32,
+      .writePrivilege = Access::Privilege::kOperate },
+    { .id = BridgedDeviceBasicInformation::Attributes::Reachable::Id, .type = BridgedAttributeType::kBoolean },
+};
+
+const BridgedAttributeTemplate kTemperatureAttributes[] = {
+    { .id = TemperatureMeasurement::Attributes::MeasuredValue::Id, .type = BridgedAttributeType::kSigned16, .nullable = true },
+};
+
+constexpr CommandId kOnOffAcceptedCommands[] = { OnOff::Commands::Off::Id, OnOff::Commands::On::Id, OnOff::Commands::Toggle::Id };
+
+const BridgedClusterTemplate kLightClusters[] = {
+    { .id                = OnOff::Id,
+      .clusterRevision   = 6,
+      .featureMap        = 0,
+      .attributes        = Span<const BridgedAttributeTemplate>(kOnOffAttributes),
+      .acceptedCommands  = Span<const CommandId>(kOnOffAcceptedCommands),
+      .generatedCommands = {} },
+    { .id                = BridgedDeviceBasicInformation::Id,
+      .clusterRevision   = 4,
+      .featureMap        = 0,
+      .attributes        = Span<const BridgedAttributeTemplate>(kBasicInformationAttributes),
+      .acceptedCommands  = {},
+      .generatedCommands = {} },
+};
+
+const BridgedClusterTemplate kSensorClusters[] = {
+    { .id                = TemperatureMeasurement::Id,
+      .clusterRevision   = 4,
+      .featureMap        = 0,
+      .attributes        = Span<const BridgedAttributeTemplate>(kTemperatureAttributes),
+      .acceptedCommands  = {},
+      .generatedCommands = {} },
+};
+
+const BridgedEndpointTemplate kAggregatorTemplate = { .deviceTypes = Span<const DeviceTypeEntry>(kAggregatorDeviceTypes),
+                                                      .clusters    = {} };
+const BridgedEndpointTemplate kLightTemplate      = { .deviceTypes = Span<const DeviceTypeEntry>(kLightDeviceTypes),
+                                                      .clusters    = Span<const BridgedClusterTemplate>(kLightClusters) };
+const BridgedEndpointTemplate kSensorTemplate     = { .deviceTypes = Span<const DeviceTypeEntry>(kLightDeviceTypes),
+                                                      .clusters    = Span<const BridgedClusterTemplate>(kSensorClusters),
+                                                      .composition = BridgedComposition::kTree };
+
+/// Stands for the codegen provider: a root endpoint with only a Descriptor cluster.
+class FakeRootProvider : public Provider
+{
+public:
+    CHIP_ERROR Shutdown() override { return CHIP_NO_ERROR; }
+    bool EventPathIncludesAccessibleConcretePath(const EventPathParams & path,
+                                                 const Access::SubjectDescriptor & descriptor) override
+    {
+        return path.mEndpointId == kRootEndpointId;
+    }
+    ActionReturnStatus ReadAttribute(const ReadAttributeRequest & request, AttributeValueEncoder & encoder) override
+    {
+        mLastRead = request.path;
+        return encoder.Encode(static_cast<uint32_t>(0));
+    }
+    ActionReturnStatus WriteAttribute(const WriteAttributeRequest & request, AttributeValueDecoder & decoder) override
+    {
+        return Status::UnsupportedWrite;
+    }
+    std::optional<ActionReturnStatus> Invoke(const InvokeRequest & request, TLV::TLVReader & input_arguments,
+                                             CommandHandler * handler) override
+    {
+        return Status::UnsupportedCommand;
+    }
+
+    EndpointId FirstEndpoint() override { return kRootEndpointId; }
+    EndpointId NextEndpoint(EndpointId before) override { return kInvalidEndpointId; }
+    std::optional<DeviceTypeEntry> FirstDeviceType(EndpointId endpoint) override { return std::nullopt; }
+    std::optional<DeviceTypeEntry> NextDeviceType(EndpointId endpoint, const DeviceTypeEntry & previous) override
+    {
+        return std::nullopt;
+    }
+    ClusterEntry FirstCluster(EndpointId endpoint) override
+    {
+        VerifyOrReturnValue(endpoint == kRootEndpointId, ClusterEntry::kInvalid);
+        return ClusterEntry{ .path = ConcreteClusterPath(kRootEndpointId, Descriptor::Id),
+                             .info = ClusterInfo(kRootDescriptorVersion) };
+    }
+    ClusterEntry NextCluster(const ConcreteClusterPath & before) override { return ClusterEntry::kInvalid; }
+    std::optional<ClusterInfo> GetClusterInfo(const ConcreteClusterPath & path) override
+    {
+        VerifyOrReturnValue(path == ConcreteClusterPath(kRootEndpointId, Descriptor::Id), std::nullopt);
+        return ClusterInfo(kRootDescriptorVersion);
+    }
+    AttributeEntry FirstAttribute(const ConcreteClusterPath & cluster) override { return AttributeEntry::kInvalid; }
+    AttributeEntry NextAttribute(const ConcreteAttributePath & before) override { return AttributeEntry::kInvalid; }
+    std::optional<AttributeInfo> GetAttributeInfo(const ConcreteAttributePath & path) override { return std::nullopt; }
+    CommandEntry FirstAcceptedCommand(const ConcreteClusterPath & cluster) override { return CommandEntry::kInvalid; }
+    CommandEntry NextAcceptedCommand(const ConcreteCommandPath & before) override { return CommandEntry::kInvalid; }
+    std::optional<CommandInfo> GetAcceptedCommandInfo(const ConcreteCommandPath & path) override { return std::nullopt; }
+    ConcreteCommandPath FirstGeneratedCommand(const ConcreteClusterPath & cluster) override
+    {
+        return ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId);
+    }
+    ConcreteCommandPath NextGeneratedCommand(const ConcreteCommandPath & before) override
+    {
+        return ConcreteCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId);
+    }
+
+    std::optional<ConcreteAttributePath> mLastRead;
+};
+
+class TestProviderChangeListener : public ProviderChangeListener
+{
+public:
+    void MarkDirty(const AttributePathParams & path) override { mDirtyList.push_back(path); }
+    void MarkDirtyPaths(Span<const AttributePathParams> paths) override
+    {
+        mBatchCount++;
+        mDirtyList.insert(mDirtyList.end(), paths.begin(), paths.end());
+    }
+
+    std::vector<AttributePathParams> mDirtyList;
+    size_t mBatchCount = 0;
+};
+
+class TestDelegate : public BridgeDataModelProvider::Delegate
+{
+public:
+    void OnAttributeWritten(const ConcreteAttributePath & path) override { mWritten.push_back(path); }
+    std::optional<ActionReturnStatus> Invoke(const InvokeRequest & request, TLV::TLVReader & input_arguments,
+                                             CommandHandler * handler) override
+    {
+        mInvoked.push_back(request.path);
+        return Status::Success;
+    }
+
+    std::vector<ConcreteAttributePath> mWritten;
+    std::vector<ConcreteCommandPath> mInvoked;
+};
+
+bool operator==(const Access::SubjectDescriptor & a, const Access::SubjectDescriptor & b)
+{
+    return (a.fabricIndex == b.fabricIndex) && (a.authMode == b.authMode) && (a.subject == b.subject);
+}
+
+class MockAccessControl : public Access::AccessControl::Delegate, public Access::AccessControl::DeviceTypeResolver
+{
+public:
+    CHIP_ERROR Check(const Access::SubjectDescriptor & subjectDescriptor, const Access::RequestPath & requestPath,
+                     Access::Privilege requestPrivilege) override
+    {
+        if (subjectDescriptor == kAdminSubjectDescriptor)
+        {
+            return CHIP_NO_ERROR;
+        }
+        if ((subjectDescriptor == kViewSubjectDescriptor) && (requestPrivilege == Access::Privilege::kView))
+        {
+            return CHIP_NO_ERROR;
+        }
+        return CHIP_ERROR_ACCESS_DENIED;
+    }
+
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return true; }
+};
+
+class TestBridgeDataModelProvider : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        Access::GetAccessControl().Init(&mAccessControl, mAccessControl);
+        InteractionModelContext context{
+            .eventsGenerator         = nullptr,
+            .dataModelChangeListener = &mChangeListener,
+            .actionContext           = nullptr,
+        };
+        ASSERT_EQ(mProvider.Startup(context), CHIP_NO_ERROR);
+        mProvider.SetDelegate(&mDelegate);
+    }
+
+    void TearDown() override
+    {
+        mProvider.Shutdown();
+        Access::GetAccessControl().Finish();
+    }
+
+    template <typename T>
+    ActionReturnStatus ReadList(const ConcreteAttributePath & path, std::vector<T> & items)
+    {
+        ReadOperation request(path);
+        request.SetSubjectDescriptor(kViewSubjectDescriptor);
+        std::unique_ptr<AttributeValueEncoder> encoder = request.StartEncoding();
+        ActionReturnStatus status                      = mProvider.ReadAttribute(request.GetRequest(), *encoder);
+        VerifyOrReturnValue(status.IsSuccess(), status);
+        ReturnErrorOnFailure(request.FinishEncoding());
+
+        std::vector<DecodedAttributeData> attributeData;
+        ReturnErrorOnFailure(request.GetEncodedIBs().Decode(attributeData));
+        VerifyOrReturnValue(attributeData.size() == 1, CHIP_ERROR_INCORRECT_STATE);
+
+        DecodableList<T> list;
+        ReturnErrorOnFailure(list.Decode(attributeData[0].dataReader));
+        items.clear();
+        auto it = list.begin();
+        while (it.Next())
+        {
+            items.push_back(it.GetValue());
+        }
+        return it.GetStatus();
+    }
+
+    template <typename T>
+    ActionReturnStatus Read(const ConcreteAttributePath & path, T & value)
+    {
+        ReadOperation request(path);
+        request.SetSubjectDescriptor(kViewSubjectDescriptor);
+        std::unique_ptr<AttributeValueEncoder> encoder = request.StartEncoding();
+        ActionReturnStatus status                      = mProvider.ReadAttribute(request.GetRequest(), *encoder);
+        VerifyOrReturnValue(status.IsSuccess(), status);
+        ReturnErrorOnFailure(request.FinishEncoding());
+
+        std::vector<DecodedAttributeData> attributeData;
+        ReturnErrorOnFailure(request.GetEncodedIBs().Decode(attributeData));
+        VerifyOrReturnValue(attributeData.size() == 1, CHIP_ERROR_INCORRECT_STATE);
+        return DataModel::Decode(attributeData[0].dataReader, value);
+    }
+
+    template <typename T>
+    ActionReturnStatus Write(const ConcreteAttributePath & path, const T & value,
+                             const Access::SubjectDescriptor & subject = kAdminSubjectDescriptor, bool timed = false)
+    {
+        WriteOperation request(path);
+        request.SetSubjectDescriptor(subject);
+        if (timed)
+        {
+            request.SetWriteFlags(WriteFlags::kTimed);
+        }
+        AttributeValueDecoder decoder = request.DecoderFor(value);
+        return mProvider.WriteAttribute(request.GetRequest(), decoder);
+    }
+
+    std::vector<EndpointId> AllEndpoints()
+    {
+        std::vector<EndpointId> endpoints;
+        for (EndpointId id = mProvider.FirstEndpoint(); id != kInvalidEndpointId; id = mProvider.NextEndpoint(id))
+        {
+            endpoints.push_back(id);
+        }
+        return endpoints;
+    }
+
+    bool IsDirty(const AttributePathParams & path) const
+    {
+        for (const AttributePathParams & dirty : mChangeListener.mDirtyList)
+        {
+            if (dirty.mEndpointId == path.mEndpointId && dirty.mClusterId == path.mClusterId &&
+                dirty.mAttributeId == path.mAttributeId)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+    MockAccessControl mAccessControl;
+    FakeRootProvider mFallback;
+    TestProviderChangeListener mChangeListener;
+    TestDelegate mDelegate;
+    BridgeDataModelProvider mProvider{ mFallback, kFirstBridgedEndpoint, 1000 };
+};
+
+TEST_F(TestBridgeDataModelProvider, TestMetadataIteration)
+{
+    EndpointId aggregator, light;
+    ASSERT_EQ(mProvider.AddEndpoint(kAggregatorTemplate, kInvalidEndpointId, aggregator), CHIP_NO_ERROR);
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, aggregator, light), CHIP_NO_ERROR);
+    EXPECT_EQ(aggregator, kFirstBridgedEndpoint);
+    EXPECT_EQ(light, kFirstBridgedEndpoint + 1);
+
+    // Fallback endpoints first, then bridged endpoints.
+    EXPECT_EQ(AllEndpoints(), (std::vector<EndpointId>{ kRootEndpointId, aggregator, light }));
+    EXPECT_TRUE(mProvider.EndpointExists(light));
+    EXPECT_TRUE(mProvider.EndpointExists(kRootEndpointId));
+    EXPECT_FALSE(mProvider.EndpointExists(light + 1));
+
+    std::optional<DeviceTypeEntry> deviceType = mProvider.FirstDeviceType(light);
+    ASSERT_TRUE(deviceType.has_value());
+    EXPECT_EQ(*deviceType, kLightDeviceTypes[0]);
+    deviceType = mProvider.NextDeviceType(light, *deviceType);
+    ASSERT_TRUE(deviceType.has_value());
+    EXPECT_EQ(*deviceType, kLightDeviceTypes[1]);
+    EXPECT_FALSE(mProvider.NextDeviceType(light, *deviceType).has_value());
+
+    // Template clusters, then Descriptor
+    std::vector<ClusterId> clusters;
+    for (ClusterEntry entry = mProvider.FirstCluster(light); entry.IsValid(); entry = mProvider.NextCluster(entry.path))
+    {
+        EXPECT_EQ(entry.path.mEndpointId, light);
+        clusters.push_back(entry.path.mClusterId);
+    }
+    EXPECT_EQ(clusters, (std::vector<ClusterId>{ OnOff::Id, BridgedDeviceBasicInformation::Id, Descriptor::Id }));
+    EXPECT_FALSE(mProvider.GetClusterInfo(ConcreteClusterPath(light, LevelControl::Id)).has_value());
+
+    std::vector<AttributeId> attributes;
+    for (AttributeEntry entry = mProvider.FirstAttribute(ConcreteClusterPath(light, OnOff::Id)); entry.IsValid();
+         entry                = mProvider.NextAttribute(entry.path))
+    {
+        attributes.push_back(entry.path.mAttributeId);
+    }
+    EXPECT_EQ(attributes,
+              (std::vector<AttributeId>{ OnOff::Attributes::OnOff::Id, OnOff::Attributes::OnTime::Id,
+                                         OnOff::Attributes::StartUpOnOff::Id, Globals::Attributes::FeatureMap::Id,
+                                         Globals::Attributes::ClusterRevision::Id }));
+
+    std::optional<AttributeInfo> info =
+        mProvider.GetAttributeInfo(ConcreteAttributePath(light, OnOff::Id, OnOff::Attributes::OnOff::Id));
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->readPrivilege, Access::Privilege::kView);  // NOLINT(bugprone-unchecked-optional-access)
+    EXPECT_FALSE(info->writePrivilege.has_value());            // NOLINT(bugprone-unchecked-optional-access)
+    info = mProvider.GetAttributeInfo(ConcreteAttributePath(light, OnOff::Id, OnOff::Attributes::StartUpOnOff::Id));
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->writePrivilege, Access::Privilege::kManage);                 // NOLINT(bugprone-unchecked-optional-access)
+    EXPECT_TRUE(info->flags.Has(AttributeQualityFlags::kTimed));                 // NOLINT(bugprone-unchecked-optional-access)
+    info = mProvider.GetAttributeInfo(ConcreteAttributePath(light, Descriptor::Id, Descriptor::Attributes::PartsList::Id));
+    ASSERT_TRUE(info.has_value());
+    EXPECT_TRUE(info->flags.Has(AttributeQualityFlags::kListAttribute));         // NOLINT(bugprone-unchecked-optional-access)
+    EXPECT_FALSE(mProvider.GetAttributeInfo(ConcreteAttributePath(light, OnOff::Id, 0x1234)).has_value());
+
+    std::vector<CommandId> commands;
+    for (CommandEntry entry = mProvider.FirstAcceptedCommand(ConcreteClusterPath(light, OnOff::Id)); entry.IsValid();
+         entry              = mProvider.NextAcceptedCommand(entry.path))
+    {
+        commands.push_back(entry.path.mCommandId);
+    }
+    EXPECT_EQ(commands, (std::vector<CommandId>{ OnOff::Commands::Off::Id, OnOff::Commands::On::Id, OnOff::Commands::Toggle::Id }));
+    EXPECT_TRUE(mProvider.GetAcceptedCommandInfo(ConcreteCommandPath(light, OnOff::Id, OnOff::Commands::On::Id)).has_value());
+    EXPECT_FALSE(mProvider.FirstAcceptedCommand(ConcreteClusterPath(light, Descriptor::Id)).IsValid());
+    EXPECT_FALSE(mProvider.FirstGeneratedCommand(ConcreteClusterPath(light, OnOff::Id)).HasValidIds());
+}
+
+TEST_F(TestBridgeDataModelProvider, TestGlobalAttributes)
+{
+    EndpointId light;
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, kInvalidEndpointId, light), CHIP_NO_ERROR);
+
+    uint16_t revision;
+    ASSERT_TRUE(Read(ConcreteAttributePath(light, OnOff::Id, Globals::Attributes::ClusterRevision::Id), revision).IsSuccess());
+    EXPECT_EQ(revision, 6u);
+
+    std::vector<AttributeId> attributeList;
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(light, OnOff::Id, Globals::Attributes::AttributeList::Id), attributeList).IsSuccess());
+    EXPECT_EQ(attributeList,
+              (std::vector<AttributeId>{ OnOff::Attributes::OnOff::Id, OnOff::Attributes::OnTime::Id,
+                                         OnOff::Attributes::StartUpOnOff::Id, Globals::Attributes::GeneratedCommandList::Id,
+                                         Globals::Attributes::AcceptedCommandList::Id, Globals::Attributes::AttributeList::Id,
+                                         Globals::Attributes::FeatureMap::Id, Globals::Attributes::ClusterRevision::Id }));
+
+    std::vector<CommandId> commands;
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(light, OnOff::Id, Globals::Attributes::AcceptedCommandList::Id), commands).IsSuccess());
+    EXPECT_EQ(commands, (std::vector<CommandId>{ OnOff::Commands::Off::Id, OnOff::Commands::On::Id, OnOff::Commands::Toggle::Id }));
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(light, OnOff::Id, Globals::Attributes::GeneratedCommandList::Id), commands).IsSuccess());
+    EXPECT_TRUE(commands.empty());
+
+    std::vector<ClusterId> serverList;
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(light, Descriptor::Id, Descriptor::Attributes::ServerList::Id), serverList).IsSuccess());
+    EXPECT_EQ(serverList, (std::vector<ClusterId>{ OnOff::Id, BridgedDeviceBasicInformation::Id, Descriptor::Id }));
+
+    std::vector<Descriptor::Structs::DeviceTypeStruct::DecodableType> deviceTypes;
+    const ConcreteAttributePath deviceTypeList(light, Descriptor::Id, Descriptor::Attributes::DeviceTypeList::Id);
+    ASSERT_TRUE(ReadList(deviceTypeList, deviceTypes).IsSuccess());
+    ASSERT_EQ(deviceTypes.size(), 2u);
+    EXPECT_EQ(deviceTypes[1].deviceType, kLightDeviceTypes[1].deviceTypeId);
+    EXPECT_EQ(deviceTypes[1].revision, kLightDeviceTypes[1].deviceTypeVersion);
+
+    // Errors and access
+    EXPECT_EQ(Read(ConcreteAttributePath(light + 1, OnOff::Id, OnOff::Attributes::OnOff::Id), revision),
+              Status::UnsupportedEndpoint);
+    EXPECT_EQ(Read(ConcreteAttributePath(light, LevelControl::Id, OnOff::Attributes::OnOff::Id), revision),
+              Status::UnsupportedCluster);
+    EXPECT_EQ(Read(ConcreteAttributePath(light, OnOff::Id, 0x1234), revision), Status::UnsupportedAttribute);
+
+    ReadOperation denied(light, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    denied.SetSubjectDescriptor(kDenySubjectDescriptor);
+    std::unique_ptr<AttributeValueEncoder> encoder = denied.StartEncoding();
+    EXPECT_EQ(mProvider.ReadAttribute(denied.GetRequest(), *encoder), Status::UnsupportedAccess);
+
+    // Non-bridged endpoints go to the fallback
+    uint32_t ignored;
+    EXPECT_TRUE(Read(ConcreteAttributePath(kRootEndpointId, BasicInformation::Id, 0), ignored).IsSuccess());
+    EXPECT_EQ(mFallback.mLastRead, std::make_optional(ConcreteAttributePath(kRootEndpointId, BasicInformation::Id, 0)));
+}
+
+TEST_F(TestBridgeDataModelProvider, TestAttributeValues)
+{
+    EndpointId light, sensor;
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, kInvalidEndpointId, light), CHIP_NO_ERROR);
+    ASSERT_EQ(mProvider.AddEndpoint(kSensorTemplate, kInvalidEndpointId, sensor), CHIP_NO_ERROR);
+
+    const ConcreteAttributePath onOff(light, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    const ConcreteAttributePath onTime(light, OnOff::Id, OnOff::Attributes::OnTime::Id);
+    const ConcreteAttributePath startUp(light, OnOff::Id, OnOff::Attributes::StartUpOnOff::Id);
+    const ConcreteAttributePath label(light, BridgedDeviceBasicInformation::Id,
+                                      BridgedDeviceBasicInformation::Attributes::NodeLabel::Id);
+    const ConcreteAttributePath temperature(sensor, TemperatureMeasurement::Id,
+                                            TemperatureMeasurement::Attributes::MeasuredValue::Id);
+
+    // Initial values
+    bool boolValue = true;
+    uint64_t unsignedValue;
+    int64_t signedValue;
+    CharSpan stringValue;
+    ASSERT_EQ(mProvider.GetAttribute(onOff, boolValue), CHIP_NO_ERROR);
+    EXPECT_FALSE(boolValue);
+    EXPECT_EQ(mProvider.GetAttribute(startUp, unsignedValue), CHIP_ERROR_INCORRECT_STATE); // null
+    ASSERT_EQ(mProvider.GetAttribute(label, stringValue), CHIP_NO_ERROR);
+    EXPECT_TRUE(stringValue.empty());
+
+    // Setting a value bumps the version and marks the attribute dirty, only when it changes.
+    std::optional<ClusterInfo> info = mProvider.GetClusterInfo(onOff);
+    ASSERT_TRUE(info.has_value());
+    const DataVersion version = info->dataVersion; // NOLINT(bugprone-unchecked-optional-access)
+    mChangeListener.mDirtyList.clear();
+    ASSERT_EQ(mProvider.SetAttribute(onOff, true), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.GetClusterInfo(onOff)->dataVersion, version + 1); // NOLINT(bugprone-unchecked-optional-access)
+    EXPECT_TRUE(IsDirty(AttributePathParams(light, OnOff::Id, OnOff::Attributes::OnOff::Id)));
+    mChangeListener.mDirtyList.clear();
+    ASSERT_EQ(mProvider.SetAttribute(onOff, true), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.GetClusterInfo(onOff)->dataVersion, version + 1); // NOLINT(bugprone-unchecked-optional-access)
+    EXPECT_TRUE(mChangeListener.mDirtyList.empty());
+
+    ASSERT_EQ(mProvider.SetAttribute(onTime, static_cast<uint64_t>(0xFFFF)), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.SetAttribute(onTime, static_cast<uint64_t>(0x10000)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mProvider.SetAttribute(onTime, static_cast<int64_t>(1)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mProvider.SetAttributeNull(onTime), CHIP_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(mProvider.GetAttribute(onTime, unsignedValue), CHIP_NO_ERROR);
+    EXPECT_EQ(unsignedValue, 0xFFFFu);
+
+    ASSERT_EQ(mProvider.SetAttribute(temperature, static_cast<int64_t>(-2750)), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.SetAttribute(temperature, static_cast<int64_t>(-32769)), CHIP_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(mProvider.GetAttribute(temperature, signedValue), CHIP_NO_ERROR);
+    EXPECT_EQ(signedValue, -2750);
+
+    ASSERT_EQ(mProvider.SetAttribute(label, "Kitchen"_span), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.SetAttribute(label, "This label is longer than 32 characters"_span), CHIP_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(mProvider.GetAttribute(label, stringValue), CHIP_NO_ERROR);
+    EXPECT_TRUE(stringValue.data_equal("Kitchen"_span));
+
+    EXPECT_EQ(mProvider.SetAttribute(ConcreteAttributePath(light, OnOff::Id, 0x1234), true),
+              CHIP_IM_GLOBAL_STATUS(UnsupportedAttribute));
+
+    // Reads encode the stored values
+    ASSERT_TRUE(Read(onOff, boolValue).IsSuccess());
+    EXPECT_TRUE(boolValue);
+    int16_t measured;
+    ASSERT_TRUE(Read(temperature, measured).IsSuccess());
+    EXPECT_EQ(measured, -2750);
+    ASSERT_TRUE(Read(label, stringValue).IsSuccess());
+    EXPECT_TRUE(stringValue.data_equal("Kitchen"_span));
+    Nullable<uint8_t> nullableValue;
+    ASSERT_TRUE(Read(startUp, nullableValue).IsSuccess());
+    EXPECT_TRUE(nullableValue.IsNull());
+}
+
+TEST_F(TestBridgeDataModelProvider, TestBatchedUpdate)
+{
+    EndpointId light;
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, kInvalidEndpointId, light), CHIP_NO_ERROR);
+    EXPECT_EQ(mChangeListener.mBatchCount, 1u); // PartsList and the new endpoint
+
+    const ConcreteAttributePath onOff(light, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    const ConcreteAttributePath onTime(light, OnOff::Id, OnOff::Attributes::OnTime::Id);
+    const ConcreteAttributePath reachable(light, BridgedDeviceBasicInformation::Id,
+                                          BridgedDeviceBasicInformation::Attributes::Reachable::Id);
+
+    // Changes are stored right away, but only marked dirty when the outermost update ends.
+    mChangeListener.mDirtyList.clear();
+    mChangeListener.mBatchCount = 0;
+    mProvider.BeginUpdate();
+    ASSERT_EQ(mProvider.SetAttribute(onOff, true), CHIP_NO_ERROR);
+    mProvider.BeginUpdate();
+    ASSERT_EQ(mProvider.SetAttribute(onTime, static_cast<uint64_t>(30)), CHIP_NO_ERROR);
+    ASSERT_EQ(mProvider.SetAttribute(reachable, false), CHIP_NO_ERROR); // unchanged
+    mProvider.EndUpdate();
+    EXPECT_TRUE(mChangeListener.mDirtyList.empty());
+
+    bool boolValue = false;
+    ASSERT_EQ(mProvider.GetAttribute(onOff, boolValue), CHIP_NO_ERROR);
+    EXPECT_TRUE(boolValue);
+
+    mProvider.EndUpdate();
+    EXPECT_EQ(mChangeListener.mBatchCount, 1u);
+    EXPECT_EQ(mChangeListener.mDirtyList.size(), 2u);
+    EXPECT_TRUE(IsDirty(AttributePathParams(light, OnOff::Id, OnOff::Attributes::OnOff::Id)));
+    EXPECT_TRUE(IsDirty(AttributePathParams(light, OnOff::Id, OnOff::Attributes::OnTime::Id)));
+
+    // An update without changes marks nothing dirty, and unbalanced EndUpdate calls are ignored.
+    mProvider.BeginUpdate();
+    ASSERT_EQ(mProvider.SetAttribute(onOff, true), CHIP_NO_ERROR);
+    mProvider.EndUpdate();
+    mProvider.EndUpdate();
+    EXPECT_EQ(mChangeListener.mBatchCount, 1u);
+
+    ASSERT_EQ(mProvider.SetAttribute(onOff, false), CHIP_NO_ERROR);
+    EXPECT_EQ(mChangeListener.mBatchCount, 1u);
+    EXPECT_EQ(mChangeListener.mDirtyList.size(), 3u);
+}
+
+TEST_F(TestBridgeDataModelProvider, TestWrite)
+{
+    EndpointId light;
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, kInvalidEndpointId, light), CHIP_NO_ERROR);
+
+    const ConcreteAttributePath onOff(light, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    const ConcreteAttributePath onTime(light, OnOff::Id, OnOff::Attributes::OnTime::Id);
+    const ConcreteAttributePath startUp(light, OnOff::Id, OnOff::Attributes::StartUpOnOff::Id);
+    const ConcreteAttributePath label(light, BridgedDeviceBasicInformation::Id,
+                                      BridgedDeviceBasicInformation::Attributes::NodeLabel::Id);
+
+    EXPECT_EQ(Write(onOff, true), Status::UnsupportedWrite);
+    EXPECT_EQ(Write(ConcreteAttributePath(light, OnOff::Id, Globals::Attributes::ClusterRevision::Id), static_cast<uint16_t>(1)),
+              Status::UnsupportedWrite);
+    EXPECT_EQ(Write(ConcreteAttributePath(light, OnOff::Id, 0x1234), true), Status::UnsupportedAttribute);
+    EXPECT_EQ(Write(onTime, static_cast<uint16_t>(10), kViewSubjectDescriptor), Status::UnsupportedAccess);
+    EXPECT_EQ(Write(onTime, static_cast<uint32_t>(0x10000)), Status::ConstraintError);
+    EXPECT_TRUE(mDelegate.mWritten.empty());
+
+    mChangeListener.mDirtyList.clear();
+    ASSERT_TRUE(Write(onTime, static_cast<uint16_t>(10)).IsSuccess());
+    uint64_t value;
+    ASSERT_EQ(mProvider.GetAttribute(onTime, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 10u);
+    EXPECT_TRUE(IsDirty(AttributePathParams(light, OnOff::Id, OnOff::Attributes::OnTime::Id)));
+    EXPECT_EQ(mDelegate.mWritten, (std::vector<ConcreteAttributePath>{ onTime }));
+
+    // Timed and nullable
+    EXPECT_EQ(Write(startUp, Nullable<uint8_t>(1)), Status::NeedsTimedInteraction);
+    ASSERT_TRUE(Write(startUp, Nullable<uint8_t>(1), kAdminSubjectDescriptor, /* timed = */ true).IsSuccess());
+    ASSERT_EQ(mProvider.GetAttribute(startUp, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 1u);
+    ASSERT_TRUE(Write(startUp, Nullable<uint8_t>(), kAdminSubjectDescriptor, /* timed = */ true).IsSuccess());
+    EXPECT_EQ(mProvider.GetAttribute(startUp, value), CHIP_ERROR_INCORRECT_STATE);
+
+    EXPECT_EQ(Write(label, "This label is longer than 32 characters"_span), Status::ConstraintError);
+    ASSERT_TRUE(Write(label, "Hall"_span).IsSuccess());
+    CharSpan stringValue;
+    ASSERT_EQ(mProvider.GetAttribute(label, stringValue), CHIP_NO_ERROR);
+    EXPECT_TRUE(stringValue.data_equal("Hall"_span));
+
+    // Data version check
+    WriteOperation request(onTime);
+    request.SetSubjectDescriptor(kAdminSubjectDescriptor);
+    request.SetDataVersion(MakeOptional(static_cast<DataVersion>(mProvider.GetClusterInfo(onTime)->dataVersion + 1)));
+    AttributeValueDecoder decoder = request.DecoderFor(static_cast<uint16_t>(20));
+    EXPECT_EQ(mProvider.WriteAttribute(request.GetRequest(), decoder), Status::DataVersionMismatch);
+}
+
+TEST_F(TestBridgeDataModelProvider, TestInvoke)
+{
+    EndpointId light;
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, kInvalidEndpointId, light), CHIP_NO_ERROR);
+
+    TLV::TLVReader arguments;
+    InvokeRequest request;
+    request.path = ConcreteCommandPath(light, OnOff::Id, OnOff::Commands::Toggle::Id);
+    EXPECT_EQ(mProvider.Invoke(request, arguments, nullptr), std::make_optional<ActionReturnStatus>(Status::Success));
+    EXPECT_EQ(mDelegate.mInvoked, (std::vector<ConcreteCommandPath>{ request.path }));
+
+    request.path = ConcreteCommandPath(light, OnOff::Id, OnOff::Commands::OffWithEffect::Id);
+    EXPECT_EQ(mProvider.Invoke(request, arguments, nullptr), std::make_optional<ActionReturnStatus>(Status::UnsupportedCommand));
+    request.path = ConcreteCommandPath(light, LevelControl::Id, OnOff::Commands::Toggle::Id);
+    EXPECT_EQ(mProvider.Invoke(request, arguments, nullptr), std::make_optional<ActionReturnStatus>(Status::UnsupportedCluster));
+    request.path = ConcreteCommandPath(light + 1, OnOff::Id, OnOff::Commands::Toggle::Id);
+    EXPECT_EQ(mProvider.Invoke(request, arguments, nullptr), std::make_optional<ActionReturnStatus>(Status::UnsupportedEndpoint));
+    EXPECT_EQ(mDelegate.mInvoked.size(), 1u);
+}
+
+TEST_F(TestBridgeDataModelProvider, TestPartsList)
+{
+    EndpointId aggregator, node, sensor, light;
+    ASSERT_EQ(mProvider.AddEndpoint(kAggregatorTemplate, kInvalidEndpointId, aggregator), CHIP_NO_ERROR);
+    // A composed device: a bridged node with a child endpoint
+    ASSERT_EQ(mProvider.AddEndpoint(kSensorTemplate, aggregator, node), CHIP_NO_ERROR);
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, node, sensor), CHIP_NO_ERROR);
+    ASSERT_EQ(mProvider.AddEndpoint(kLightTemplate, aggregator, light), CHIP_NO_ERROR);
+
+    std::vector<EndpointId> parts;
+    ASSERT_TRUE(ReadList(ConcreteAttributePath(kRootEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts)
+                    .IsSuccess());
+    EXPECT_EQ(parts, (std::vector<EndpointId>{ aggregator, node, sensor, light }));
+
+    // Full family for the aggregator, tree (direct children only) for the composed device
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(aggregator, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts).IsSuccess());
+    std::sort(parts.begin(), parts.end());
+    EXPECT_EQ(parts, (std::vector<EndpointId>{ node, sensor, light }));
+    ASSERT_TRUE(ReadList(ConcreteAttributePath(node, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts).IsSuccess());
+    EXPECT_EQ(parts, (std::vector<EndpointId>{ sensor }));
+    ASSERT_TRUE(ReadList(ConcreteAttributePath(light, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts).IsSuccess());
+    EXPECT_TRUE(parts.empty());
+
+    // Removing an endpoint updates the PartsList attributes that listed it
+    const ConcreteClusterPath rootDescriptor(kRootEndpointId, Descriptor::Id);
+    const ConcreteClusterPath aggregatorDescriptor(aggregator, Descriptor::Id);
+    const DataVersion rootVersion       = mProvider.GetClusterInfo(rootDescriptor)->dataVersion;       // NOLINT
+    const DataVersion aggregatorVersion = mProvider.GetClusterInfo(aggregatorDescriptor)->dataVersion; // NOLINT
+    EXPECT_EQ(mProvider.FirstCluster(kRootEndpointId).info.dataVersion, rootVersion);
+    EXPECT_NE(rootVersion, kRootDescriptorVersion);
+
+    EXPECT_EQ(mProvider.RemoveEndpoint(node), CHIP_ERROR_INCORRECT_STATE);
+    mChangeListener.mDirtyList.clear();
+    ASSERT_EQ(mProvider.RemoveEndpoint(sensor), CHIP_NO_ERROR);
+    EXPECT_NE(mProvider.GetClusterInfo(rootDescriptor)->dataVersion, rootVersion);             // NOLINT
+    EXPECT_NE(mProvider.GetClusterInfo(aggregatorDescriptor)->dataVersion, aggregatorVersion); // NOLINT
+    EXPECT_TRUE(IsDirty(AttributePathParams(kRootEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id)));
+    EXPECT_TRUE(IsDirty(AttributePathParams(aggregator, Descriptor::Id, Descriptor::Attributes::PartsList::Id)));
+    EXPECT_TRUE(IsDirty(AttributePathParams(node, Descriptor::Id, Descriptor::Attributes::PartsList::Id)));
+
+    ASSERT_EQ(mProvider.RemoveEndpoint(node), CHIP_NO_ERROR);
+    ASSERT_TRUE(
+        ReadList(ConcreteAttributePath(aggregator, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts).IsSuccess());
+    EXPECT_EQ(parts, (std::vector<EndpointId>{ light }));
+    EXPECT_EQ(AllEndpoints(), (std::vector<EndpointId>{ kRootEndpointId, aggregator, light }));
+    EXPECT_EQ(mProvider.BridgedEndpointCount(), 2u);
+    EXPECT_EQ(mProvider.RemoveEndpoint(node), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestBridgeDataModelProvider, TestEndpointAllocation)
+{
+    BridgeDataModelProvider provider(mFallback, kFirstBridgedEndpoint, 3);
+
+    EndpointId endpoints[3];
+    for (EndpointId & endpoint : endpoints)
+    {
+        ASSERT_EQ(provider.AddEndpoint(kLightTemplate, kInvalidEndpointId, endpoint), CHIP_NO_ERROR);
+    }
+    EndpointId extra;
+    EXPECT_EQ(provider.AddEndpoint(kLightTemplate, kInvalidEndpointId, extra), CHIP_ERROR_NO_MEMORY);
+
+    // Ids are reused round-robin, and values are reset.
+    ASSERT_EQ(provider.SetAttribute(ConcreteAttributePath(endpoints[0], OnOff::Id, OnOff::Attributes::OnOff::Id), true),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(provider.RemoveEndpoint(endpoints[0]), CHIP_NO_ERROR);
+    ASSERT_EQ(provider.RemoveEndpoint(endpoints[1]), CHIP_NO_ERROR);
+    ASSERT_EQ(provider.AddEndpoint(kLightTemplate, kInvalidEndpointId, extra), CHIP_NO_ERROR);
+    EXPECT_EQ(extra, endpoints[0]);
+    bool onOff = true;
+    ASSERT_EQ(provider.GetAttribute(ConcreteAttributePath(extra, OnOff::Id, OnOff::Attributes::OnOff::Id), onOff), CHIP_NO_ERROR);
+    EXPECT_FALSE(onOff);
+    ASSERT_EQ(provider.AddEndpoint(kSensorTemplate, kInvalidEndpointId, extra), CHIP_NO_ERROR);
+    EXPECT_EQ(extra, endpoints[1]);
+    EXPECT_TRUE(provider.GetClusterInfo(ConcreteClusterPath(extra, TemperatureMeasurement::Id)).has_value());
+    EXPECT_FALSE(provider.GetClusterInfo(ConcreteClusterPath(extra, OnOff::Id)).has_value());
+
+    // The parent must be a bridged endpoint.
+    EXPECT_EQ(provider.AddEndpoint(kLightTemplate, kRootEndpointId, extra), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestBridgeDataModelProvider, TestManyEndpoints)
+{
+    constexpr uint16_t kEndpointCount = 30000;
+    BridgeDataModelProvider provider(mFallback, kFirstBridgedEndpoint, kEndpointCount);
+
+    EndpointId aggregator;
+    ASSERT_EQ(provider.AddEndpoint(kAggregatorTemplate, kInvalidEndpointId, aggregator), CHIP_NO_ERROR);
+    for (uint16_t i = 1; i < kEndpointCount; i++)
+    {
+        EndpointId endpoint;
+        ASSERT_EQ(provider.AddEndpoint((i % 2) ? kLightTemplate : kSensorTemplate, aggregator, endpoint), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(provider.BridgedEndpointCount(), kEndpointCount);
+
+    // Every other endpoint is a light
+    for (uint16_t i = 1; i < kEndpointCount; i++)
+    {
+        const EndpointId endpoint = static_cast<EndpointId>(kFirstBridgedEndpoint + i);
+        EXPECT_EQ(provider.GetClusterInfo(ConcreteClusterPath(endpoint, OnOff::Id)).has_value(), (i % 2) == 1);
+    }
+
+    const EndpointId sensor = static_cast<EndpointId>(kFirstBridgedEndpoint + kEndpointCount - 2);
+    const ConcreteAttributePath temperature(sensor, TemperatureMeasurement::Id,
+                                            TemperatureMeasurement::Attributes::MeasuredValue::Id);
+    ASSERT_EQ(provider.SetAttribute(temperature, static_cast<int64_t>(2100)), CHIP_NO_ERROR);
+    int64_t value;
+    ASSERT_EQ(provider.GetAttribute(temperature, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 2100);
+}
+
+} // namespace
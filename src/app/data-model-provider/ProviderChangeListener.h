@@ -17,6 +17,7 @@
 #pragma once
 
 #include <app/AttributePathParams.h>
+#include <lib/support/Span.h>
 
 namespace chip {
 namespace app {
@@ -40,6 +41,20 @@ public:
     ///
     /// Wildcards are supported.
     virtual void MarkDirty(const AttributePathParams & path) = 0;
+
+    /// Mark all attributes matching any of the given paths dirty.
+    ///
+    /// Producers changing many attributes at once should prefer this over
+    /// one MarkDirty call per path, as listeners may process the whole set
+    /// in a single pass. The default implementation calls MarkDirty for
+    /// every path.
+    virtual void MarkDirtyPaths(Span<const AttributePathParams> paths)
+    {
+        for (const auto & path : paths)
+        {
+            MarkDirty(path);
+        }
+    }
 };
 
 } // namespace DataModel
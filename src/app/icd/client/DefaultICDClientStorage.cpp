@@ -16,6 +16,7 @@
  */
 
 #include <app/icd/client/DefaultICDClientStorage.h>
+#include <algorithm>
 #include <iterator>
 #include <lib/core/Global.h>
 #include <lib/support/Base64.h>
@@ -24,6 +25,7 @@
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <limits>
+#include <utility>
 
 namespace {
 // FabricIndex is uint8_t, the tlv size with anonymous tag is 1(control bytes) + 1(value) = 2
@@ -50,6 +52,8 @@ CHIP_ERROR DefaultICDClientStorage::UpdateFabricList(FabricIndex fabricIndex)
     }
 
     mFabricList.push_back(fabricIndex);
+    // Storage may already hold entries for this fabric.
+    mCheckInIndexValid = false;
 
     return StoreFabricList();
 }
@@ -365,6 +369,8 @@ bool DefaultICDClientStorage::FabricExists(FabricIndex fabricIndex)
 CHIP_ERROR DefaultICDClientStorage::StoreEntry(const ICDClientInfo & clientInfo)
 {
     VerifyOrReturnError(FabricExists(clientInfo.peer_node.GetFabricIndex()), CHIP_ERROR_INVALID_FABRIC_INDEX);
+    // Any failure below leaves the Check-In index invalid, so that it is rebuilt from storage.
+    bool checkInIndexValid = std::exchange(mCheckInIndexValid, false);
     std::vector<ICDClientInfo> clientInfoVector;
     size_t clientInfoSize = MaxICDClientInfoSize();
     ReturnErrorOnFailure(Load(clientInfo.peer_node.GetFabricIndex(), clientInfoVector, clientInfoSize));
@@ -395,6 +401,11 @@ CHIP_ERROR DefaultICDClientStorage::StoreEntry(const ICDClientInfo & clientInfo)
         static_cast<uint16_t>(len)));
 
     ReturnErrorOnFailure(IncreaseEntryCountForFabric(clientInfo.peer_node.GetFabricIndex()));
+    if (checkInIndexValid)
+    {
+        UpdateCheckInIndex(clientInfo);
+        mCheckInIndexValid = true;
+    }
     ChipLogProgress(ICD,
                     "Store ICD entry successfully with peer nodeId " ChipLogFormatScopedNodeId
                     " and checkin nodeId " ChipLogFormatScopedNodeId,
@@ -452,6 +463,7 @@ CHIP_ERROR DefaultICDClientStorage::DeleteEntry(const ScopedNodeId & peerNode)
     std::vector<ICDClientInfo> clientInfoVector;
     ReturnErrorOnFailure(Load(peerNode.GetFabricIndex(), clientInfoVector, clientInfoSize));
     VerifyOrReturnError(clientInfoVector.size() > 0, CHIP_NO_ERROR);
+    bool checkInIndexValid = std::exchange(mCheckInIndexValid, false);
 
     for (auto it = clientInfoVector.begin(); it != clientInfoVector.end(); it++)
     {
@@ -481,6 +493,13 @@ CHIP_ERROR DefaultICDClientStorage::DeleteEntry(const ScopedNodeId & peerNode)
                                            backingBuffer.Get(), static_cast<uint16_t>(len)));
 
     ReturnErrorOnFailure(DecreaseEntryCountForFabric(peerNode.GetFabricIndex()));
+    if (checkInIndexValid)
+    {
+        mCheckInIndex.erase(std::remove_if(mCheckInIndex.begin(), mCheckInIndex.end(),
+                                           [&](const CheckInIndexEntry & entry) { return entry.clientInfo.peer_node == peerNode; }),
+                            mCheckInIndex.end());
+        mCheckInIndexValid = true;
+    }
     ChipLogProgress(ICD, "Remove ICD entry successfully with peer nodeId " ChipLogFormatScopedNodeId,
                     ChipLogValueScopedNodeId(peerNode));
     return CHIP_NO_ERROR;
@@ -490,7 +509,8 @@ CHIP_ERROR DefaultICDClientStorage::DeleteAllEntries(FabricIndex fabricIndex)
 {
     VerifyOrReturnError(FabricExists(fabricIndex), CHIP_NO_ERROR);
 
-    size_t clientInfoSize = 0;
+    bool checkInIndexValid = std::exchange(mCheckInIndexValid, false);
+    size_t clientInfoSize  = 0;
     std::vector<ICDClientInfo> clientInfoVector;
     ReturnErrorOnFailure(Load(fabricIndex, clientInfoVector, clientInfoSize));
     IgnoreUnusedVariable(clientInfoSize);
@@ -512,6 +532,16 @@ CHIP_ERROR DefaultICDClientStorage::DeleteAllEntries(FabricIndex fabricIndex)
         }
     }
 
+    if (checkInIndexValid)
+    {
+        mCheckInIndex.erase(std::remove_if(mCheckInIndex.begin(), mCheckInIndex.end(),
+                                           [&](const CheckInIndexEntry & entry) {
+                                               return entry.clientInfo.peer_node.GetFabricIndex() == fabricIndex;
+                                           }),
+                            mCheckInIndex.end());
+        mCheckInIndexValid = true;
+    }
+
     if (mFabricList.size() == 0)
     {
         return mpClientInfoStore->SyncDeleteKeyValue(DefaultStorageKeyAllocator::ICDFabricList().KeyName());
@@ -524,23 +554,122 @@ CHIP_ERROR DefaultICDClientStorage::DeleteAllEntries(FabricIndex fabricIndex)
 
 CHIP_ERROR DefaultICDClientStorage::ProcessCheckInPayload(const ByteSpan & payload, ICDClientInfo & clientInfo,
                                                           Protocols::SecureChannel::CounterType & counter)
+{
+    using Protocols::SecureChannel::CheckinMessage;
+
+    VerifyOrReturnError(payload.size() >= CheckinMessage::kMinPayloadSize, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    if (!mCheckInIndexValid)
+    {
+        ReturnErrorOnFailure(BuildCheckInIndex());
+    }
+
+    ByteSpan nonce = payload.SubSpan(0, Crypto::CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES);
+
+    // The nonce is derived from the ICD's key and counter, so a hint match almost always identifies the sender.
+    for (const auto & entry : mCheckInIndex)
+    {
+        if (entry.MatchesNonceHint(nonce) && TryCheckInIndexEntry(entry, payload, clientInfo, counter))
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    // The sender's counter may have moved past its hints, e.g. if Check-In messages were missed.
+    for (const auto & entry : mCheckInIndex)
+    {
+        if (!entry.MatchesNonceHint(nonce) && TryCheckInIndexEntry(entry, payload, clientInfo, counter))
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+bool DefaultICDClientStorage::TryCheckInIndexEntry(const CheckInIndexEntry & entry, const ByteSpan & payload,
+                                                   ICDClientInfo & clientInfo, Protocols::SecureChannel::CounterType & counter)
 {
     uint8_t appDataBuffer[kAppDataLength];
     MutableByteSpan appData(appDataBuffer);
+
+    mCheckInDecryptionCount++;
+    CHIP_ERROR err = Protocols::SecureChannel::CheckinMessage::ParseCheckinMessagePayload(
+        entry.clientInfo.aes_key_handle, entry.clientInfo.hmac_key_handle, payload, counter, appData);
+    VerifyOrReturnValue(err == CHIP_NO_ERROR, false);
+
+    clientInfo = entry.clientInfo;
+    return true;
+}
+
+CHIP_ERROR DefaultICDClientStorage::BuildCheckInIndex()
+{
+    mCheckInIndex.clear();
+
     auto * iterator = IterateICDClientInfo();
     VerifyOrReturnError(iterator != nullptr, CHIP_ERROR_NO_MEMORY);
-    while (iterator->Next(clientInfo))
+    ICDClientInfoIteratorWrapper clientInfoIteratorWrapper(iterator);
+
+    mCheckInIndex.reserve(iterator->Count());
+    CheckInIndexEntry entry;
+    while (iterator->Next(entry.clientInfo))
     {
-        CHIP_ERROR err = chip::Protocols::SecureChannel::CheckinMessage::ParseCheckinMessagePayload(
-            clientInfo.aes_key_handle, clientInfo.hmac_key_handle, payload, counter, appData);
-        if (CHIP_NO_ERROR == err)
+        entry.ComputeNonceHints();
+        mCheckInIndex.push_back(entry);
+    }
+
+    mCheckInIndexValid = true;
+    return CHIP_NO_ERROR;
+}
+
+void DefaultICDClientStorage::UpdateCheckInIndex(const ICDClientInfo & clientInfo)
+{
+    CheckInIndexEntry * target = nullptr;
+    for (auto & entry : mCheckInIndex)
+    {
+        if (entry.clientInfo.peer_node == clientInfo.peer_node)
         {
-            iterator->Release();
-            return CHIP_NO_ERROR;
+            target = &entry;
+            break;
         }
     }
-    iterator->Release();
-    return CHIP_ERROR_NOT_FOUND;
+
+    if (target == nullptr)
+    {
+        mCheckInIndex.emplace_back();
+        target = &mCheckInIndex.back();
+    }
+
+    target->clientInfo = clientInfo;
+    target->ComputeNonceHints();
+}
+
+void DefaultICDClientStorage::CheckInIndexEntry::ComputeNonceHints()
+{
+    // The ICD increments its counter for every Check-In message it sends; the next one received after `offset` is
+    // therefore expected to carry start_icd_counter + offset + 1, or a little more if some were missed.
+    Protocols::SecureChannel::CounterType nextCounter = clientInfo.start_icd_counter + clientInfo.offset + 1;
+    for (auto & hint : nonceHints)
+    {
+        Encoding::LittleEndian::BufferWriter writer(hint.data(), hint.size());
+        if (Protocols::SecureChannel::CheckinMessage::GenerateCheckInMessageNonce(clientInfo.hmac_key_handle, nextCounter++,
+                                                                                 writer) != CHIP_NO_ERROR)
+        {
+            // Unusable key: the entry is still tried as a fallback.
+            hint.fill(0);
+        }
+    }
+}
+
+bool DefaultICDClientStorage::CheckInIndexEntry::MatchesNonceHint(const ByteSpan & nonce) const
+{
+    for (const auto & hint : nonceHints)
+    {
+        if (nonce.data_equal(ByteSpan(hint.data(), hint.size())))
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 void DefaultICDClientStorage::Shutdown()
@@ -549,6 +678,8 @@ void DefaultICDClientStorage::Shutdown()
     mpClientInfoStore = nullptr;
     mpKeyStore        = nullptr;
     mFabricList.clear();
+    mCheckInIndex.clear();
+    mCheckInIndexValid = false;
 }
 
 } // namespace app
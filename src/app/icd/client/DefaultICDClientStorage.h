@@ -33,6 +33,8 @@
 #include <lib/core/TLV.h>
 #include <lib/support/CommonIterator.h>
 #include <lib/support/Pool.h>
+
+#include <array>
 #include <vector>
 
 // TODO: SymmetricKeystore is an alias for SessionKeystore, replace the below when sdk supports SymmetricKeystore
@@ -117,6 +119,12 @@ public:
      */
     CHIP_ERROR DeleteAllEntries(FabricIndex fabricIndex);
 
+    /**
+     * Check-In messages are dispatched through an in-memory index of the stored ICDClientInfos, built from storage on
+     * first use and kept up to date by StoreEntry, DeleteEntry and DeleteAllEntries.  ICDs whose precomputed nonce for
+     * one of their next CHIP_CONFIG_ICD_CLIENT_CHECK_IN_NONCE_HINTS counters matches the payload are tried first; every
+     * other ICD is only tried if none of those can decrypt it.
+     */
     CHIP_ERROR ProcessCheckInPayload(const ByteSpan & payload, ICDClientInfo & clientInfo,
                                      Protocols::SecureChannel::CounterType & counter) override;
 
@@ -130,6 +138,8 @@ public:
     size_t GetFabricListSize() { return mFabricList.size(); }
 
     PersistentStorageDelegate * GetClientInfoStore() { return mpClientInfoStore; }
+
+    size_t GetCheckInDecryptionCount() { return mCheckInDecryptionCount; }
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
 protected:
@@ -185,6 +195,26 @@ protected:
 
 private:
     friend class ICDClientInfoIteratorImpl;
+
+    using CheckInNonce = std::array<uint8_t, Crypto::CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES>;
+
+    static constexpr size_t kCheckInNonceHints = CHIP_CONFIG_ICD_CLIENT_CHECK_IN_NONCE_HINTS;
+
+    struct CheckInIndexEntry
+    {
+        ICDClientInfo clientInfo;
+        // Nonces of the next kCheckInNonceHints Check-In counters the ICD is expected to use.
+        std::array<CheckInNonce, kCheckInNonceHints> nonceHints;
+
+        void ComputeNonceHints();
+        bool MatchesNonceHint(const ByteSpan & nonce) const;
+    };
+
+    CHIP_ERROR BuildCheckInIndex();
+    void UpdateCheckInIndex(const ICDClientInfo & clientInfo);
+    bool TryCheckInIndexEntry(const CheckInIndexEntry & entry, const ByteSpan & payload, ICDClientInfo & clientInfo,
+                              Protocols::SecureChannel::CounterType & counter);
+
     CHIP_ERROR StoreFabricList();
     CHIP_ERROR LoadFabricList();
     CHIP_ERROR LoadCounter(FabricIndex fabricIndex, size_t & count, size_t & clientInfoSize);
@@ -203,6 +233,10 @@ private:
     PersistentStorageDelegate * mpClientInfoStore = nullptr;
     Crypto::SymmetricKeystore * mpKeyStore        = nullptr;
     std::vector<FabricIndex> mFabricList;
+
+    std::vector<CheckInIndexEntry> mCheckInIndex;
+    bool mCheckInIndexValid        = false;
+    size_t mCheckInDecryptionCount = 0;
 };
 } // namespace app
 } // namespace chip
@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/Pool.h>
+#include <system/SystemConfig.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Index of the attribute paths that read handlers are interested in, so that the reporting engine finds the handlers a dirty
+ * path matters to without walking every handler and every path of every handler.
+ *
+ * Interest paths are hashed on their endpoint and cluster, either of which may be a wildcard. A dirty path with a concrete
+ * endpoint E and cluster C can only intersect interest paths stored under (E, C), (*, C), (E, *) or (*, *), so a lookup visits
+ * at most four bucket chains. When pools are allocated from the heap, the bucket table grows with the number of paths so that
+ * chains stay short and a lookup costs about the number of matching paths, whatever the number of handlers. Otherwise it has
+ * CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS buckets.
+ *
+ * Dirty paths with a wildcard endpoint or cluster cannot be looked up; callers must check them against the handlers directly.
+ *
+ * The index keeps pointers to the path list nodes of its owners: a path list must not change while its owner is indexed.
+ *
+ * @tparam Owner       Type of the objects holding the interest paths (ReadHandler).
+ * @tparam kMaxEntries Number of interest paths that can be indexed, when pools are statically allocated.
+ */
+template <typename Owner, size_t kMaxEntries>
+class AttributeInterestIndex
+{
+public:
+    using PathList = SingleLinkedListNode<AttributePathParams>;
+
+    AttributeInterestIndex() = default;
+    ~AttributeInterestIndex() { Clear(); }
+
+    AttributeInterestIndex(const AttributeInterestIndex &)             = delete;
+    AttributeInterestIndex & operator=(const AttributeInterestIndex &) = delete;
+
+    /**
+     * Indexes every path of aPaths for aOwner. On failure, nothing is indexed for aOwner.
+     */
+    CHIP_ERROR Add(Owner & aOwner, const PathList * aPaths)
+    {
+        for (const PathList * node = aPaths; node != nullptr; node = node->mpNext)
+        {
+            Entry * entry = mEntryPool.CreateObject();
+            if (entry == nullptr)
+            {
+                Remove(aOwner, aPaths);
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            entry->mOwner = &aOwner;
+            entry->mPath  = &node->mValue;
+            Insert(entry);
+            mEntryCount++;
+        }
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        if (mEntryCount > kMaxEntriesPerBucket * mBucketCount)
+        {
+            // If the allocation fails, the table keeps its size: lookups get slower, not wrong.
+            Grow();
+        }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Removes the paths indexed for aOwner, which must be given the same path list as Add. Does nothing for paths that are not
+     * indexed.
+     */
+    void Remove(Owner & aOwner, const PathList * aPaths)
+    {
+        for (const PathList * node = aPaths; node != nullptr; node = node->mpNext)
+        {
+            Entry ** link = &mBuckets[BucketIndex(node->mValue.mEndpointId, node->mValue.mClusterId)];
+            while (*link != nullptr)
+            {
+                Entry * entry = *link;
+                if (entry->mOwner == &aOwner && entry->mPath == &node->mValue)
+                {
+                    *link = entry->mpNext;
+                    mEntryPool.ReleaseObject(entry);
+                    mEntryCount--;
+                    break;
+                }
+                link = &entry->mpNext;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        mEntryPool.ReleaseAll();
+        FreeBuckets();
+        for (auto & bucket : mInlineBuckets)
+        {
+            bucket = nullptr;
+        }
+        mEntryCount = 0;
+    }
+
+    /**
+     * Returns whether aPath can be looked up, i.e. has a concrete endpoint and cluster.
+     */
+    static bool CanLookUp(const AttributePathParams & aPath)
+    {
+        return !aPath.HasWildcardEndpointId() && !aPath.HasWildcardClusterId();
+    }
+
+    /**
+     * Calls aFunction(Owner &) for every indexed interest path intersecting aPath, which must satisfy CanLookUp. An owner is
+     * visited once per interest path that intersects aPath.
+     */
+    template <typename Function>
+    void ForEachInterestedOwner(const AttributePathParams & aPath, Function && aFunction) const
+    {
+        const size_t buckets[] = {
+            BucketIndex(aPath.mEndpointId, aPath.mClusterId),
+            BucketIndex(kInvalidEndpointId, aPath.mClusterId),
+            BucketIndex(aPath.mEndpointId, kInvalidClusterId),
+            BucketIndex(kInvalidEndpointId, kInvalidClusterId),
+        };
+
+        for (size_t i = 0; i < ArraySize(buckets); i++)
+        {
+            // Several keys may share a bucket: only walk it once.
+            bool visited = false;
+            for (size_t j = 0; j < i; j++)
+            {
+                visited = visited || (buckets[j] == buckets[i]);
+            }
+            if (visited)
+            {
+                continue;
+            }
+
+            for (const Entry * entry = mBuckets[buckets[i]]; entry != nullptr; entry = entry->mpNext)
+            {
+                if (entry->mPath->Intersects(aPath))
+                {
+                    aFunction(*entry->mOwner);
+                }
+            }
+        }
+    }
+
+    size_t EntryCount() const { return mEntryCount; }
+    size_t BucketCount() const { return mBucketCount; }
+
+private:
+    struct Entry
+    {
+        Owner * mOwner;
+        const AttributePathParams * mPath;
+        Entry * mpNext;
+    };
+
+    static constexpr size_t kInlineBucketCount = CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS;
+    static_assert(kInlineBucketCount > 0, "The interest index needs at least one bucket");
+
+    // Average chain length above which the bucket table grows, and by how much.
+    static constexpr size_t kMaxEntriesPerBucket = 2;
+    static constexpr size_t kGrowthFactor        = 4;
+
+    size_t BucketIndex(EndpointId aEndpointId, ClusterId aClusterId) const
+    {
+        // Cluster ids carry a vendor prefix in their upper bits: fold it in before mixing with the endpoint.
+        uint32_t hash = (aClusterId ^ (aClusterId >> 16)) * 0x9E3779B1u;
+        hash ^= static_cast<uint32_t>(aEndpointId) * 0x85EBCA77u;
+        hash ^= hash >> 15;
+        return hash % mBucketCount;
+    }
+
+    void Insert(Entry * aEntry)
+    {
+        Entry *& bucket = mBuckets[BucketIndex(aEntry->mPath->mEndpointId, aEntry->mPath->mClusterId)];
+        aEntry->mpNext  = bucket;
+        bucket          = aEntry;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    void Grow()
+    {
+        const size_t bucketCount = mBucketCount * kGrowthFactor;
+        auto ** buckets          = static_cast<Entry **>(Platform::MemoryCalloc(bucketCount, sizeof(Entry *)));
+        VerifyOrReturn(buckets != nullptr);
+
+        Entry ** oldBuckets         = mBuckets;
+        const size_t oldBucketCount = mBucketCount;
+        mBuckets                    = buckets;
+        mBucketCount                = bucketCount;
+        for (size_t i = 0; i < oldBucketCount; i++)
+        {
+            Entry * entry = oldBuckets[i];
+            while (entry != nullptr)
+            {
+                Entry * next = entry->mpNext;
+                Insert(entry);
+                entry = next;
+            }
+        }
+        if (oldBuckets != mInlineBuckets)
+        {
+            Platform::MemoryFree(oldBuckets);
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    void FreeBuckets()
+    {
+        if (mBuckets != mInlineBuckets)
+        {
+            Platform::MemoryFree(mBuckets);
+            mBuckets     = mInlineBuckets;
+            mBucketCount = kInlineBucketCount;
+        }
+    }
+
+    Entry * mInlineBuckets[kInlineBucketCount] = {};
+    Entry ** mBuckets                          = mInlineBuckets;
+    size_t mBucketCount                        = kInlineBucketCount;
+    size_t mEntryCount                         = 0;
+    ObjectPool<Entry, kMaxEntries> mEntryPool;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -32,6 +32,8 @@
 #include <lib/core/DataModelTypes.h>
 #include <protocols/interaction_model/StatusCode.h>
 
+#include <algorithm>
+
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
 #include <app/icd/server/ICDNotifier.h> // nogncheck
 #endif
@@ -79,6 +81,8 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+    mInterestIndex.Clear();
+    mUnindexedReadHandlerCount = 0;
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -880,36 +884,136 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
 
 CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 {
+    return SetDirtyInSinglePass(Span<const AttributePathParams>(&aAttributePath, 1));
+}
+
+CHIP_ERROR Engine::SetDirty(Span<const AttributePathParams> aAttributePaths)
+{
+    while (!aAttributePaths.empty())
+    {
+        const size_t count = std::min(aAttributePaths.size(), kMaxDirtyPathsPerPass);
+        ReturnErrorOnFailure(SetDirtyInSinglePass(aAttributePaths.SubSpan(0, count)));
+        aAttributePaths = aAttributePaths.SubSpan(count);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Engine::SetEndpointRangeDirty(EndpointId aFirstEndpointId, EndpointId aLastEndpointId, ClusterId aClusterId)
+{
+    VerifyOrReturnError(aFirstEndpointId <= aLastEndpointId && aLastEndpointId != kInvalidEndpointId, CHIP_ERROR_INVALID_ARGUMENT);
+
+    AttributePathParams paths[kMaxDirtyPathsPerPass];
+    uint32_t endpointId = aFirstEndpointId;
+    while (endpointId <= aLastEndpointId)
+    {
+        size_t count = 0;
+        for (; count < kMaxDirtyPathsPerPass && endpointId <= aLastEndpointId; count++, endpointId++)
+        {
+            paths[count] = AttributePathParams(static_cast<EndpointId>(endpointId), aClusterId);
+        }
+        ReturnErrorOnFailure(SetDirtyInSinglePass(Span<const AttributePathParams>(paths, count)));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Engine::SetDirtyInSinglePass(Span<const AttributePathParams> aAttributePaths)
+{
+    static_assert(kMaxDirtyPathsPerPass <= 32, "The paths somebody is interested in are tracked in a uint32_t");
+    VerifyOrDie(aAttributePaths.size() <= kMaxDirtyPathsPerPass);
+
     BumpDirtySetGeneration();
+    const uint64_t generation = GetDirtySetGeneration();
 
-    bool intersectsInterestPath = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+    uint32_t interestedPaths = 0;
+    auto markDirty           = [&](ReadHandler & handler, size_t pathIndex) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
         // waiting for a response to the last message chunk for read interactions.
-        if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
+        if (!handler.CanStartReporting() && !handler.IsAwaitingReportResponse())
+        {
+            return;
+        }
+
+        // MarkAttributePathDirty records the current generation in the handler: let the report scheduler know the first time
+        // the handler is interested in a path of this pass only.
+        const bool firstPathForHandler = handler.mDirtyGeneration != generation;
+        handler.MarkAttributePathDirty(aAttributePaths[pathIndex]);
+        if (firstPathForHandler)
+        {
+            handler.NotifyBecameReportable();
+        }
+        interestedPaths |= static_cast<uint32_t>(1) << pathIndex;
+    };
+
+    uint32_t pathsToCheckOnEveryHandler = 0;
+    for (size_t i = 0; i < aAttributePaths.size(); i++)
+    {
+        if (mUnindexedReadHandlerCount == 0 && decltype(mInterestIndex)::CanLookUp(aAttributePaths[i]))
+        {
+            mInterestIndex.ForEachInterestedOwner(aAttributePaths[i], [&](ReadHandler & handler) { markDirty(handler, i); });
+        }
+        else
         {
-            for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+            pathsToCheckOnEveryHandler |= static_cast<uint32_t>(1) << i;
+        }
+    }
+
+    if (pathsToCheckOnEveryHandler != 0)
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+            for (size_t i = 0; i < aAttributePaths.size(); i++)
             {
-                if (object->mValue.Intersects(aAttributePath))
+                if ((pathsToCheckOnEveryHandler & (static_cast<uint32_t>(1) << i)) == 0)
                 {
-                    handler->AttributePathIsDirty(aAttributePath);
-                    intersectsInterestPath = true;
-                    break;
+                    continue;
+                }
+                for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+                {
+                    if (object->mValue.Intersects(aAttributePaths[i]))
+                    {
+                        markDirty(*handler, i);
+                        break;
+                    }
                 }
             }
+            return Loop::Continue;
+        });
+    }
+
+    for (size_t i = 0; i < aAttributePaths.size(); i++)
+    {
+        if (interestedPaths & (static_cast<uint32_t>(1) << i))
+        {
+            ReturnErrorOnFailure(InsertPathIntoDirtySet(aAttributePaths[i]));
         }
+    }
 
-        return Loop::Continue;
-    });
+    return CHIP_NO_ERROR;
+}
 
-    if (!intersectsInterestPath)
+void Engine::AddToInterestIndex(ReadHandler & aReadHandler)
+{
+    CHIP_ERROR err = mInterestIndex.Add(aReadHandler, aReadHandler.GetAttributePathList());
+    if (err != CHIP_NO_ERROR)
     {
-        return CHIP_NO_ERROR;
+        ChipLogError(DataManagement, "Failed to index read handler paths, falling back to full scans: %" CHIP_ERROR_FORMAT,
+                     err.Format());
+        aReadHandler.mFlags.Set(ReadHandler::ReadHandlerFlags::NotInInterestIndex);
+        mUnindexedReadHandlerCount++;
     }
-    ReturnErrorOnFailure(InsertPathIntoDirtySet(aAttributePath));
+}
 
-    return CHIP_NO_ERROR;
+void Engine::RemoveFromInterestIndex(ReadHandler & aReadHandler)
+{
+    if (aReadHandler.mFlags.Has(ReadHandler::ReadHandlerFlags::NotInInterestIndex))
+    {
+        aReadHandler.mFlags.Clear(ReadHandler::ReadHandlerFlags::NotInInterestIndex);
+        mUnindexedReadHandlerCount--;
+        return;
+    }
+    mInterestIndex.Remove(aReadHandler, aReadHandler.GetAttributePathList());
 }
 
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
@@ -973,17 +1077,12 @@ CHIP_ERROR Engine::ScheduleBufferPressureEventDelivery(uint32_t aBytesWritten)
 
 CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBytesWritten)
 {
-    // If we literally have no read handlers right now that care about any events,
-    // we don't need to call schedule run for event.
-    // If schedule run is called, actually we would not delivery events as well.
-    // Just wanna save one schedule run here
-    if (mpImEngine->mEventPathPool.Allocated() == 0)
-    {
-        return CHIP_NO_ERROR;
-    }
-
+    // Event paths may live in the read handlers' own arenas rather than in the engine pool, so ask the handlers
+    // whether any of them cares about events.
+    bool hasEventPaths = false;
     bool isUrgentEvent = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aPath, &isUrgentEvent](ReadHandler * handler) {
+    mpImEngine->mReadHandlers.ForEachActiveObject([&aPath, &hasEventPaths, &isUrgentEvent](ReadHandler * handler) {
+        hasEventPaths = hasEventPaths || (handler->GetEventPathList() != nullptr);
         if (handler->IsType(ReadHandler::InteractionType::Read))
         {
             return Loop::Continue;
@@ -1003,6 +1102,15 @@ CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBy
         return Loop::Continue;
     });
 
+    // If we literally have no read handlers right now that care about any events,
+    // we don't need to call schedule run for event.
+    // If schedule run is called, actually we would not delivery events as well.
+    // Just wanna save one schedule run here
+    if (!hasEventPaths)
+    {
+        return CHIP_NO_ERROR;
+    }
+
     if (isUrgentEvent)
     {
         ChipLogDetail(DataManagement, "Urgent event will be sent once reporting is not blocked by the min interval");
@@ -1042,6 +1150,15 @@ void Engine::MarkDirty(const AttributePathParams & path)
     }
 }
 
+void Engine::MarkDirtyPaths(Span<const AttributePathParams> paths)
+{
+    CHIP_ERROR err = SetDirty(paths);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to set paths dirty: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
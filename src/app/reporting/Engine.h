@@ -28,6 +28,7 @@
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
 #include <app/data-model-provider/ProviderChangeListener.h>
+#include <app/reporting/AttributeInterestIndex.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -96,6 +97,34 @@ public:
      */
     CHIP_ERROR SetDirty(const AttributePathParams & aAttributePathParams);
 
+    /**
+     * Marks a set of changed paths dirty at once. The paths may contain wildcards, e.g. to mark a whole cluster or a whole
+     * endpoint dirty.
+     *
+     * This has the same effect as calling SetDirty for every path, but the read handlers are only walked once per
+     * kMaxDirtyPathsPerPass paths, and an interested read handler notifies the report scheduler once per walk instead of once
+     * per path. Producers changing many attributes at once (e.g. bridges) should prefer it.
+     */
+    CHIP_ERROR SetDirty(Span<const AttributePathParams> aAttributePaths);
+
+    /**
+     * Marks the given cluster, or every cluster when aClusterId is kInvalidClusterId, dirty on all the endpoints in
+     * [aFirstEndpointId, aLastEndpointId].
+     */
+    CHIP_ERROR SetEndpointRangeDirty(EndpointId aFirstEndpointId, EndpointId aLastEndpointId,
+                                     ClusterId aClusterId = kInvalidClusterId);
+
+    /**
+     * Adds the attribute paths of a read handler to the index SetDirty uses to find interested read handlers. Called by the
+     * read handler once its attribute path list is complete; the list must not change until RemoveFromInterestIndex.
+     */
+    void AddToInterestIndex(ReadHandler & aReadHandler);
+
+    /**
+     * Removes the attribute paths of a read handler from the interest index, before its attribute path list is released.
+     */
+    void RemoveFromInterestIndex(ReadHandler & aReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -139,10 +168,17 @@ public:
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
+    size_t GetInterestIndexEntryCount() const { return mInterestIndex.EntryCount(); }
 #endif
 
     /* ProviderChangeListener implementation */
     void MarkDirty(const AttributePathParams & path) override;
+    void MarkDirtyPaths(Span<const AttributePathParams> paths) override;
+
+    /**
+     * The number of paths SetDirty processes in a single walk of the read handlers.
+     */
+    static constexpr size_t kMaxDirtyPathsPerPass = 32;
 
 private:
     /**
@@ -230,6 +266,11 @@ private:
 
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
+    /**
+     * Marks up to kMaxDirtyPathsPerPass paths dirty with a single walk of the read handlers.
+     */
+    CHIP_ERROR SetDirtyInSinglePass(Span<const AttributePathParams> aAttributePaths);
+
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
     /**
@@ -267,6 +308,15 @@ private:
     ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
 #endif
 
+    /**
+     * Attribute paths of the read handlers, to find those interested in a dirty path. Read handlers whose paths could not be
+     * indexed are flagged and counted; while there are any, SetDirty checks every read handler instead.
+     */
+    static constexpr size_t kMaxInterestIndexEntries =
+        CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS;
+    AttributeInterestIndex<ReadHandler, kMaxInterestIndexEntries> mInterestIndex;
+    size_t mUnindexedReadHandlerCount = 0;
+
     /**
      * A generation counter for the dirty attrbute set.
      * ReadHandlers can save the generation value when generating reports.
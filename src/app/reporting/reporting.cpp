@@ -24,6 +24,37 @@
 using namespace chip;
 using namespace chip::app;
 
+namespace {
+
+/// Collects the paths emberAfAttributeChanged marks dirty, to hand them to the reporting engine at once.
+class BatchedAttributesChangedListener : public AttributesChangedListener
+{
+public:
+    ~BatchedAttributesChangedListener() { Flush(); }
+
+    void MarkDirty(const AttributePathParams & path) override
+    {
+        if (mCount == ArraySize(mPaths))
+        {
+            Flush();
+        }
+        mPaths[mCount++] = path;
+    }
+
+private:
+    void Flush()
+    {
+        VerifyOrReturn(mCount > 0);
+        InteractionModelEngine::GetInstance()->GetReportingEngine().MarkDirtyPaths(Span<const AttributePathParams>(mPaths, mCount));
+        mCount = 0;
+    }
+
+    AttributePathParams mPaths[reporting::Engine::kMaxDirtyPathsPerPass];
+    size_t mCount = 0;
+};
+
+} // namespace
+
 void MatterReportingAttributeChangeCallback(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
 {
     // Attribute writes have asserted this already, but this assert should catch
@@ -43,6 +74,19 @@ void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
                             emberAfGlobalInteractionModelAttributesChangedListener());
 }
 
+void MatterReportingAttributeChangeCallback(Span<const ConcreteAttributePath> aPaths)
+{
+    // Attribute writes have asserted this already, but this assert should catch
+    // applications notifying about changes from their end.
+    assertChipStackLockedByCurrentThread();
+
+    BatchedAttributesChangedListener listener;
+    for (const auto & path : aPaths)
+    {
+        emberAfAttributeChanged(path.mEndpointId, path.mClusterId, path.mAttributeId, &listener);
+    }
+}
+
 void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 {
     // Attribute writes have asserted this already, but this assert should catch
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <app/ConcreteAttributePath.h>
+#include <lib/support/Span.h>
 
 /** @brief Reporting Attribute Change
  *
@@ -33,6 +34,12 @@ void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::Clu
  */
 void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePath & aPath);
 
+/*
+ * Same for a set of attributes that changed together, e.g. when a bridge refreshes the state of a device. Cluster data
+ * versions are increased as for individual changes, but the reporting engine processes the whole set at once.
+ */
+void MatterReportingAttributeChangeCallback(chip::Span<const chip::app::ConcreteAttributePath> aPaths);
+
 /*
  * Same but only with an EndpointId, this is used when adding / enabling an endpoint during runtime.
  */
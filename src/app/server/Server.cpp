@@ -137,6 +137,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     mDeviceStorage                 = initParams.persistentStorageDelegate;
     mSessionResumptionStorage      = initParams.sessionResumptionStorage;
     mSubscriptionResumptionStorage = initParams.subscriptionResumptionStorage;
+    mDataVersionPersistence        = initParams.dataVersionPersistence;
     mOperationalKeystore           = initParams.operationalKeystore;
     mOpCertStore                   = initParams.opCertStore;
     mSessionKeystore               = initParams.sessionKeystore;
@@ -160,7 +161,13 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 
     // Set up attribute persistence before we try to bring up the data model
     // handler.
+#if CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
+    // Attribute values are written to storage in batches rather than one at a time.
+    SuccessOrExit(err = mAttributeStorage.Init(mDeviceStorage));
+    SuccessOrExit(err = mAttributePersister.Init(&mAttributeStorage));
+#else
     SuccessOrExit(err = mAttributePersister.Init(mDeviceStorage));
+#endif // CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
     SetAttributePersistenceProvider(&mAttributePersister);
     SetSafeAttributePersistenceProvider(&mAttributePersister);
 
@@ -361,6 +368,24 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
                                                                  &mCASESessionManager, mSubscriptionResumptionStorage);
     SuccessOrExit(err);
 
+    if (mDataVersionPersistence != nullptr)
+    {
+        // Clusters are initialized by now, and no read or subscription was served yet.
+        app::SetDataVersionPersistence(mDataVersionPersistence);
+        CHIP_ERROR restoreErr =
+            mDataVersionPersistence->RestoreDataVersions(*app::InteractionModelEngine::GetInstance()->GetDataModelProvider());
+        if (restoreErr != CHIP_NO_ERROR)
+        {
+            // Not fatal: the clusters that were not restored keep their random data versions.
+            ChipLogError(AppServer, "Failed to restore data versions: %" CHIP_ERROR_FORMAT, restoreErr.Format());
+        }
+        else
+        {
+            ChipLogProgress(AppServer, "Restored the data versions of %u clusters",
+                            static_cast<unsigned>(mDataVersionPersistence->GetRestoredClusterCount()));
+        }
+    }
+
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
     app::InteractionModelEngine::GetInstance()->SetICDManager(&mICDManager);
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -592,6 +617,10 @@ void Server::ScheduleFactoryReset()
         // Delete all fabrics and emit Leave event.
         GetInstance().GetFabricTable().DeleteAllFabrics();
         PlatformMgr().HandleServerShuttingDown();
+#if CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
+        // Pending attribute values must not be written back once storage is erased.
+        GetInstance().mAttributeStorage.DiscardPendingWrites();
+#endif // CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
         ConfigurationMgr().InitiateFactoryReset();
     });
 }
@@ -622,6 +651,11 @@ void Server::Shutdown()
 #endif // CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY
 
     chip::Dnssd::Resolver::Instance().Shutdown();
+    if (mDataVersionPersistence != nullptr)
+    {
+        app::SetDataVersionPersistence(nullptr);
+        mDataVersionPersistence->Shutdown();
+    }
     chip::app::InteractionModelEngine::GetInstance()->Shutdown();
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
     app::InteractionModelEngine::GetInstance()->SetICDManager(nullptr);
@@ -649,6 +683,9 @@ void Server::Shutdown()
     mICDManager.Shutdown();
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
     mAttributePersister.Shutdown();
+#if CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
+    mAttributeStorage.Shutdown();
+#endif // CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryShutdown();
 }
@@ -790,6 +827,9 @@ SimpleSessionResumptionStorage CommonCaseDeviceServerInitParams::sSessionResumpt
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 app::SimpleSubscriptionResumptionStorage CommonCaseDeviceServerInitParams::sSubscriptionResumptionStorage;
 #endif
+#if CHIP_CONFIG_PERSIST_DATA_VERSIONS
+app::DataVersionPersistence CommonCaseDeviceServerInitParams::sDataVersionPersistence;
+#endif
 app::DefaultAclStorage CommonCaseDeviceServerInitParams::sAclStorage;
 Crypto::DefaultSessionKeystore CommonCaseDeviceServerInitParams::sSessionKeystore;
 #if CHIP_CONFIG_ENABLE_ICD_CIP
@@ -22,8 +22,10 @@
 
 #include <access/AccessControl.h>
 #include <access/examples/ExampleAccessControlDelegate.h>
+#include <app/BatchedPersistentStorageDelegate.h>
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
+#include <app/DataVersionPersistence.h>
 #include <app/DefaultAttributePersistenceProvider.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
@@ -149,6 +151,9 @@ struct ServerInitParams
     // Session resumption storage: Optional. Support session resumption when provided.
     // Must be initialized before being provided.
     app::SubscriptionResumptionStorage * subscriptionResumptionStorage = nullptr;
+    // Data version persistence: Optional. Keeps the data versions of unchanged clusters across reboots when provided.
+    // Must be initialized before being provided.
+    app::DataVersionPersistence * dataVersionPersistence = nullptr;
     // Certificate validity policy: Optional. If none is injected, CHIPCert
     // enforces a default policy.
     Credentials::CertificateValidityPolicy * certificateValidityPolicy = nullptr;
@@ -302,6 +307,11 @@ struct CommonCaseDeviceServerInitParams : public ServerInitParams
         ChipLogProgress(AppServer, "Subscription persistence not supported");
 #endif
 
+#if CHIP_CONFIG_PERSIST_DATA_VERSIONS
+        ReturnErrorOnFailure(sDataVersionPersistence.Init(this->persistentStorageDelegate));
+        this->dataVersionPersistence = &sDataVersionPersistence;
+#endif
+
 #if CHIP_CONFIG_ENABLE_ICD_CIP
         if (this->icdCheckInBackOffStrategy == nullptr)
         {
@@ -325,6 +335,9 @@ private:
 #endif
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     static app::SimpleSubscriptionResumptionStorage sSubscriptionResumptionStorage;
+#endif
+#if CHIP_CONFIG_PERSIST_DATA_VERSIONS
+    static app::DataVersionPersistence sDataVersionPersistence;
 #endif
     static app::DefaultAclStorage sAclStorage;
     static Crypto::DefaultSessionKeystore sSessionKeystore;
@@ -678,9 +691,13 @@ private:
     PersistentStorageDelegate * mDeviceStorage;
     SessionResumptionStorage * mSessionResumptionStorage;
     app::SubscriptionResumptionStorage * mSubscriptionResumptionStorage;
+    app::DataVersionPersistence * mDataVersionPersistence;
     Credentials::GroupDataProvider * mGroupsProvider;
     Crypto::SessionKeystore * mSessionKeystore;
     app::DefaultAttributePersistenceProvider mAttributePersister;
+#if CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
+    app::BatchedPersistentStorageDelegate mAttributeStorage;
+#endif // CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS > 0
     GroupDataProviderListener mListener;
     ServerFabricDelegate mFabricDelegate;
     app::reporting::ReportScheduler * mReportScheduler;
@@ -0,0 +1,203 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <app/reporting/AttributeInterestIndex.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+
+#include <memory>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr size_t kPathsPerHandler = 8;
+
+/// Stands for a read handler: a fixed list of interest paths.
+struct FakeHandler
+{
+    SingleLinkedListNode<AttributePathParams> mPaths[kPathsPerHandler];
+    size_t mPathCount = 0;
+    size_t mVisits    = 0;
+
+    void AddPath(const AttributePathParams & path)
+    {
+        mPaths[mPathCount].mValue = path;
+        if (mPathCount > 0)
+        {
+            mPaths[mPathCount - 1].mpNext = &mPaths[mPathCount];
+        }
+        mPathCount++;
+    }
+
+    const SingleLinkedListNode<AttributePathParams> * PathList() const { return mPathCount > 0 ? &mPaths[0] : nullptr; }
+};
+
+using Index = AttributeInterestIndex<FakeHandler, 8192>;
+
+struct TestAttributeInterestIndex : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    static size_t CountVisits(const Index & index, const AttributePathParams & path)
+    {
+        size_t visits = 0;
+        index.ForEachInterestedOwner(path, [&](FakeHandler & handler) {
+            handler.mVisits++;
+            visits++;
+        });
+        return visits;
+    }
+};
+
+TEST_F(TestAttributeInterestIndex, TestLookup)
+{
+    FakeHandler concrete, wildcardEndpoint, wildcardCluster, wildcardAll, other;
+    concrete.AddPath(AttributePathParams(1, 6, 0));
+    concrete.AddPath(AttributePathParams(EndpointId(1), ClusterId(8)));          // every attribute of a cluster
+    wildcardEndpoint.AddPath(AttributePathParams(ClusterId(6), AttributeId(0))); // OnOff on every endpoint
+    wildcardCluster.AddPath(AttributePathParams(2));                             // every cluster of endpoint 2
+    wildcardAll.AddPath(AttributePathParams());
+    other.AddPath(AttributePathParams(3, 6, 0));
+
+    Index index;
+    for (FakeHandler * handler : { &concrete, &wildcardEndpoint, &wildcardCluster, &wildcardAll, &other })
+    {
+        ASSERT_EQ(index.Add(*handler, handler->PathList()), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(index.EntryCount(), 6u);
+
+    EXPECT_TRUE(Index::CanLookUp(AttributePathParams(EndpointId(1), ClusterId(6))));
+    EXPECT_FALSE(Index::CanLookUp(AttributePathParams(1)));
+    EXPECT_FALSE(Index::CanLookUp(AttributePathParams(ClusterId(6), AttributeId(0))));
+
+    // (1, 6, 0) is of interest to the concrete path, the OnOff wildcard and the full wildcard.
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 0)), 3u);
+    EXPECT_EQ(concrete.mVisits, 1u);
+    EXPECT_EQ(wildcardEndpoint.mVisits, 1u);
+    EXPECT_EQ(wildcardAll.mVisits, 1u);
+    EXPECT_EQ(wildcardCluster.mVisits, 0u);
+    EXPECT_EQ(other.mVisits, 0u);
+
+    // Another attribute of the same cluster only matters to the wildcards.
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 1)), 1u);
+    // A dirty cluster intersects the concrete paths in it.
+    EXPECT_EQ(CountVisits(index, AttributePathParams(EndpointId(1), ClusterId(6))), 3u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 8, 5)), 2u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(2, 6, 0)), 3u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(2, 29, 0)), 2u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(4, 29, 0)), 1u);
+
+    index.Remove(wildcardAll, wildcardAll.PathList());
+    index.Remove(concrete, concrete.PathList());
+    EXPECT_EQ(index.EntryCount(), 3u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 0)), 1u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(4, 29, 0)), 0u);
+
+    // Removing paths that are not indexed does nothing.
+    index.Remove(concrete, concrete.PathList());
+    EXPECT_EQ(index.EntryCount(), 3u);
+
+    index.Clear();
+    EXPECT_EQ(index.EntryCount(), 0u);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(3, 6, 0)), 0u);
+}
+
+TEST_F(TestAttributeInterestIndex, TestSamePathFromSeveralHandlers)
+{
+    constexpr size_t kHandlerCount = 20;
+    FakeHandler handlers[kHandlerCount];
+    Index index;
+    for (auto & handler : handlers)
+    {
+        handler.AddPath(AttributePathParams(1, 6, 0));
+        handler.AddPath(AttributePathParams(EndpointId(1), ClusterId(6))); // overlaps the first path
+        ASSERT_EQ(index.Add(handler, handler.PathList()), CHIP_NO_ERROR);
+    }
+
+    // Each handler is visited once per path intersecting the dirty path.
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 0)), 2 * kHandlerCount);
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 1)), kHandlerCount);
+
+    // Only the paths of the removed handler go away.
+    index.Remove(handlers[5], handlers[5].PathList());
+    EXPECT_EQ(index.EntryCount(), 2 * (kHandlerCount - 1));
+    handlers[5].mVisits = 0;
+    EXPECT_EQ(CountVisits(index, AttributePathParams(1, 6, 1)), kHandlerCount - 1);
+    EXPECT_EQ(handlers[5].mVisits, 0u);
+}
+
+// The index must find exactly the handlers that checking every path of every handler, as the reporting engine did before, finds.
+// Each handler subscribes to attributes of its own endpoint, and one handler in 16 to a cluster on every endpoint.
+// chip-interest-index-benchmark (src/tools/interest-index-benchmark) times both on the same layout.
+TEST_F(TestAttributeInterestIndex, TestMatchesFullScan)
+{
+    constexpr size_t kHandlerCount = 48;
+
+    std::unique_ptr<FakeHandler[]> handlers(new FakeHandler[kHandlerCount]);
+    Index index;
+    for (size_t h = 0; h < kHandlerCount; h++)
+    {
+        const EndpointId endpoint   = static_cast<EndpointId>(1 + h);
+        const size_t attributeCount = (h % 16 == 0) ? kPathsPerHandler - 1 : kPathsPerHandler;
+        for (AttributeId a = 0; a < attributeCount; a++)
+        {
+            handlers[h].AddPath(AttributePathParams(endpoint, 0x0402, a));
+        }
+        if (h % 16 == 0)
+        {
+            handlers[h].AddPath(AttributePathParams(ClusterId(0x0006), AttributeId(0)));
+        }
+        ASSERT_EQ(index.Add(handlers[h], handlers[h].PathList()), CHIP_NO_ERROR);
+    }
+
+    std::unique_ptr<size_t[]> expectedVisits(new size_t[kHandlerCount]);
+    for (EndpointId endpoint = 1; endpoint <= kHandlerCount + 1; endpoint++)
+    {
+        for (const AttributePathParams & dirty :
+             { AttributePathParams(endpoint, 0x0402, 0), AttributePathParams(endpoint, 0x0402, kPathsPerHandler - 1),
+               AttributePathParams(endpoint, 0x0402, kPathsPerHandler), AttributePathParams(endpoint, 0x0006, 0),
+               AttributePathParams(endpoint, 0x0006, 1), AttributePathParams(endpoint, ClusterId(0x0402)) })
+        {
+            size_t expectedTotal = 0;
+            for (size_t h = 0; h < kHandlerCount; h++)
+            {
+                handlers[h].mVisits = 0;
+                expectedVisits[h]   = 0;
+                for (auto * node = handlers[h].PathList(); node != nullptr; node = node->mpNext)
+                {
+                    expectedVisits[h] += node->mValue.Intersects(dirty) ? 1 : 0;
+                }
+                expectedTotal += expectedVisits[h];
+            }
+
+            EXPECT_EQ(CountVisits(index, dirty), expectedTotal);
+            for (size_t h = 0; h < kHandlerCount; h++)
+            {
+                EXPECT_EQ(handlers[h].mVisits, expectedVisits[h]);
+            }
+        }
+    }
+}
+
+} // namespace
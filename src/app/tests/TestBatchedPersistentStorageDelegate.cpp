@@ -0,0 +1,302 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/BatchedPersistentStorageDelegate.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr System::Clock::Milliseconds32 kLongFlushInterval = System::Clock::Milliseconds32(3600 * 1000);
+
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    size_t mWriteCount = 0;
+
+protected:
+    CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size) override
+    {
+        mWriteCount++;
+        return TestPersistentStorageDelegate::SyncSetKeyValueInternal(key, value, size);
+    }
+};
+
+// Storage without transactions, such as most platform key-value stores.
+class NonTransactionalStorage : public CountingStorage
+{
+public:
+    CHIP_ERROR SyncBeginTransaction() override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+};
+
+uint8_t ReadByte(PersistentStorageDelegate & storage, const char * key)
+{
+    uint8_t value = 0;
+    uint16_t size = sizeof(value);
+    EXPECT_EQ(storage.SyncGetKeyValue(key, &value, size), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+class TestBatchedPersistentStorageDelegate : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(sIOContext.Init(), CHIP_NO_ERROR);
+        DeviceLayer::SetSystemLayerForTesting(&sIOContext.GetSystemLayer());
+    }
+
+    static void TearDownTestSuite()
+    {
+        DeviceLayer::SetSystemLayerForTesting(nullptr);
+        sIOContext.Shutdown();
+        Platform::MemoryShutdown();
+    }
+
+protected:
+    static chip::Test::IOContext sIOContext;
+};
+
+chip::Test::IOContext TestBatchedPersistentStorageDelegate::sIOContext;
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestMergeRepeatedWrites)
+{
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+
+    for (uint8_t i = 1; i <= 10; i++)
+    {
+        EXPECT_EQ(batched.SyncSetKeyValue("a", &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+
+    // Reads get the pending value, which is not stored yet.
+    EXPECT_EQ(ReadByte(batched, "a"), 10);
+    EXPECT_TRUE(batched.SyncDoesKeyExist("a"));
+    EXPECT_FALSE(storage.HasKey("a"));
+    EXPECT_EQ(batched.GetPendingWriteCount(), 1u);
+
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadByte(storage, "a"), 10);
+    EXPECT_EQ(storage.mWriteCount, 1u);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 0u);
+
+    const BatchedPersistentStorageDelegate::Metrics & metrics = batched.GetMetrics();
+    EXPECT_EQ(metrics.mWrites, 10u);
+    EXPECT_EQ(metrics.mMergedWrites, 9u);
+    EXPECT_EQ(metrics.mStorageWrites, 1u);
+    EXPECT_EQ(metrics.mFlushes, 1u);
+    EXPECT_EQ(metrics.mFailedFlushes, 0u);
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestFlushInterval)
+{
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, System::Clock::Milliseconds32(10)), CHIP_NO_ERROR);
+
+    uint8_t value = 42;
+    EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_FALSE(storage.HasKey("a"));
+
+    sIOContext.DriveIOUntil(System::Clock::Seconds16(1), [&]() { return storage.HasKey("a"); });
+    EXPECT_EQ(ReadByte(storage, "a"), 42);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 0u);
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestAtomicFlush)
+{
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+
+    uint8_t value = 1;
+    EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncSetKeyValue("c", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetCommittedTransactionCount(), 1u);
+    EXPECT_EQ(storage.GetNumKeys(), 3u);
+
+    // A failed transaction stores none of the values, which stay pending.
+    value = 2;
+    EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    storage.SetRejectWrites(true);
+    EXPECT_NE(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadByte(storage, "a"), 1);
+    EXPECT_EQ(ReadByte(storage, "b"), 1);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 2u);
+    EXPECT_EQ(batched.GetMetrics().mFailedFlushes, 1u);
+
+    storage.SetRejectWrites(false);
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadByte(storage, "a"), 2);
+    EXPECT_EQ(ReadByte(storage, "b"), 2);
+    EXPECT_EQ(storage.GetCommittedTransactionCount(), 2u);
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestFlushWithoutTransactions)
+{
+    NonTransactionalStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+
+    uint8_t value = 1;
+    storage.AddPoisonKey("b");
+    EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+
+    // Values are written one at a time: the ones that could not be written stay pending.
+    EXPECT_NE(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadByte(storage, "a"), 1);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 1u);
+
+    storage.ClearPoisonKeys();
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadByte(storage, "b"), 1);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 0u);
+    EXPECT_EQ(batched.GetMetrics().mStorageWrites, 2u);
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestDelete)
+{
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+
+    uint8_t value = 1;
+    EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncDeleteKeyValue("a"), CHIP_NO_ERROR);
+    EXPECT_FALSE(batched.SyncDoesKeyExist("a"));
+    EXPECT_EQ(batched.SyncDeleteKeyValue("a"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // Deleting a stored key with a pending value deletes both.
+    EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    value = 2;
+    EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(batched.SyncDeleteKeyValue("b"), CHIP_NO_ERROR);
+    EXPECT_FALSE(storage.HasKey("b"));
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+    EXPECT_FALSE(storage.HasKey("b"));
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestShutdown)
+{
+    CountingStorage storage;
+    uint8_t value = 1;
+
+    {
+        BatchedPersistentStorageDelegate batched;
+        ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+        EXPECT_EQ(batched.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+        batched.Shutdown();
+        EXPECT_EQ(batched.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_ERROR_INCORRECT_STATE);
+    }
+    EXPECT_TRUE(storage.HasKey("a"));
+
+    {
+        BatchedPersistentStorageDelegate batched;
+        ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+        EXPECT_EQ(batched.SyncSetKeyValue("c", &value, sizeof(value)), CHIP_NO_ERROR);
+        batched.DiscardPendingWrites();
+    }
+    EXPECT_FALSE(storage.HasKey("c"));
+}
+
+TEST_F(TestBatchedPersistentStorageDelegate, TestMaxPendingWrites)
+{
+    constexpr size_t kMaxPendingWrites = CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_MAX_PENDING_WRITES;
+
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+
+    char key[PersistentStorageDelegate::kKeyLengthMax + 1];
+    uint8_t value = 1;
+    for (size_t i = 0; i < kMaxPendingWrites; i++)
+    {
+        snprintf(key, sizeof(key), "k%u", static_cast<unsigned>(i));
+        EXPECT_EQ(batched.SyncSetKeyValue(key, &value, sizeof(value)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(storage.GetNumKeys(), 0u);
+
+    // One more key flushes the pending values first.
+    EXPECT_EQ(batched.SyncSetKeyValue("last", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetNumKeys(), kMaxPendingWrites);
+    EXPECT_EQ(batched.GetPendingWriteCount(), 1u);
+}
+
+/**
+ * Counts the storage writes of a burst of persisted attribute changes: a level
+ * transition updating one attribute 100 times, followed by 10 scene recalls
+ * writing the same 8 attributes.
+ */
+TEST_F(TestBatchedPersistentStorageDelegate, TestAttributeWriteBurst)
+{
+    auto runBurst = [](PersistentStorageDelegate & storage) {
+        DefaultAttributePersistenceProvider provider;
+        EXPECT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+
+        for (uint8_t level = 0; level < 100; level++)
+        {
+            EXPECT_EQ(provider.WriteValue(ConcreteAttributePath(1, 0x0008, 0x0000), ByteSpan(&level, sizeof(level))),
+                      CHIP_NO_ERROR);
+        }
+        for (uint8_t recall = 0; recall < 10; recall++)
+        {
+            for (AttributeId attribute = 0; attribute < 8; attribute++)
+            {
+                EXPECT_EQ(provider.WriteValue(ConcreteAttributePath(1, 0x0300, attribute), ByteSpan(&recall, sizeof(recall))),
+                          CHIP_NO_ERROR);
+            }
+        }
+    };
+
+    CountingStorage directStorage;
+    runBurst(directStorage);
+
+    CountingStorage storage;
+    BatchedPersistentStorageDelegate batched;
+    ASSERT_EQ(batched.Init(&storage, kLongFlushInterval), CHIP_NO_ERROR);
+    runBurst(batched);
+    EXPECT_EQ(batched.Flush(), CHIP_NO_ERROR);
+
+    const BatchedPersistentStorageDelegate::Metrics & metrics = batched.GetMetrics();
+    EXPECT_EQ(metrics.mWrites, directStorage.mWriteCount);
+    EXPECT_EQ(storage.mWriteCount, 9u);
+    EXPECT_EQ(metrics.mStorageWrites, 9u);
+    EXPECT_EQ(metrics.mMergedWrites, metrics.mWrites - metrics.mStorageWrites);
+    EXPECT_EQ(storage.GetCommittedTransactionCount(), 1u);
+}
@@ -597,4 +597,113 @@ TEST_F(TestBufferedReadCallback, TestBufferedSequences)
     });
 }
 
+//
+// Validates a large list of structs with variable length octet strings, delivered as one chunk per item.
+//
+class LargeListValidator : public BufferedReadCallback::Callback
+{
+public:
+    static constexpr uint32_t kListLength = 1000;
+
+    static void FillItemBytes(uint32_t index, uint8_t (&bytes)[32], size_t & length)
+    {
+        length = index % sizeof(bytes);
+        for (size_t i = 0; i < length; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(index + i);
+        }
+    }
+
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType value;
+        size_t len;
+
+        EXPECT_EQ(aPath.mAttributeId, Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+        EXPECT_EQ(aPath.mListOp, ConcreteDataAttributePath::ListOperation::ReplaceAll);
+        EXPECT_EQ(DataModel::Decode(*apData, value), CHIP_NO_ERROR);
+        EXPECT_EQ(value.ComputeSize(&len), CHIP_NO_ERROR);
+        EXPECT_EQ(len, kListLength);
+
+        //
+        // Walk the list twice, to make sure the iterators (which each hold their own copy of the reader)
+        // don't disturb each other.
+        //
+        for (int pass = 0; pass < 2; pass++)
+        {
+            auto iter      = value.begin();
+            uint32_t index = 0;
+            while (iter.Next())
+            {
+                uint8_t expectedBytes[32];
+                size_t expectedLength;
+                FillItemBytes(index, expectedBytes, expectedLength);
+
+                auto & item = iter.GetValue();
+                EXPECT_EQ(item.member1, index);
+                EXPECT_TRUE(item.member2.data_equal(ByteSpan(expectedBytes, expectedLength)));
+                index++;
+            }
+
+            EXPECT_EQ(iter.GetStatus(), CHIP_NO_ERROR);
+            EXPECT_EQ(index, kListLength);
+        }
+
+        mListCount++;
+    }
+
+    void OnDone(ReadClient *) override {}
+
+    uint32_t mListCount = 0;
+};
+
+TEST_F(TestBufferedReadCallback, TestLargeChunkedList)
+{
+    LargeListValidator validator;
+    BufferedReadCallback bufferedCallback(validator);
+    ReadClient::Callback * callback = &bufferedCallback;
+    ConcreteDataAttributePath path(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferTLVReader reader;
+    System::PacketBufferHandle handle;
+    StatusIB status;
+
+    callback->OnReportBegin();
+
+    {
+        Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::Type value;
+
+        writer.Init(System::PacketBufferHandle::New(1000), true);
+        path.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
+        EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), value), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Finalize(&handle), CHIP_NO_ERROR);
+        reader.Init(std::move(handle));
+        EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+        callback->OnAttributeData(path, &reader, status);
+    }
+
+    for (uint32_t i = 0; i < LargeListValidator::kListLength; i++)
+    {
+        Clusters::UnitTesting::Structs::TestListStructOctet::Type listItem;
+        uint8_t bytes[32];
+        size_t length;
+
+        LargeListValidator::FillItemBytes(i, bytes, length);
+        listItem.member1 = i;
+        listItem.member2 = ByteSpan(bytes, length);
+
+        writer.Init(System::PacketBufferHandle::New(1000), true);
+        path.mListOp = ConcreteDataAttributePath::ListOperation::AppendItem;
+        EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), listItem), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Finalize(&handle), CHIP_NO_ERROR);
+        reader.Init(std::move(handle));
+        EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+        callback->OnAttributeData(path, &reader, status);
+    }
+
+    EXPECT_EQ(validator.mListCount, 0u);
+    callback->OnReportEnd();
+    EXPECT_EQ(validator.mListCount, 1u);
+}
+
 } // namespace
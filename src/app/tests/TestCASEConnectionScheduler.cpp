@@ -0,0 +1,371 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEConnectionScheduler.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+using Priority = CASEConnectionScheduler::Priority;
+
+constexpr FabricIndex kFabric                          = 1;
+constexpr System::Clock::Milliseconds64 kLookupTime    = 200_ms64;
+constexpr System::Clock::Milliseconds64 kHandshakeTime = 500_ms64;
+
+/**
+ * Scheduler whose stages are simulated loopback peers: every lookup takes
+ * kLookupTime and every handshake kHandshakeTime of mock clock time.  Peers
+ * listed in `unreachable` fail their lookup with CHIP_ERROR_TIMEOUT, and peers
+ * listed in `unknown` fail to start it with CHIP_ERROR_INVALID_FABRIC_INDEX.
+ */
+class SimulatedScheduler : public CASEConnectionScheduler
+{
+public:
+    ~SimulatedScheduler() override { Shutdown(); }
+
+    struct Operation
+    {
+        ScopedNodeId peerId;
+        Entry::State state;
+        System::Clock::Timestamp deadline;
+    };
+
+    /// Runs every simulated operation due within `duration`, in deadline order.
+    void Advance(System::Clock::Internal::MockClock & clock, System::Clock::Milliseconds64 duration)
+    {
+        System::Clock::Timestamp end = clock.GetMonotonicTimestamp() + duration;
+        while (true)
+        {
+            auto next = std::min_element(mOperations.begin(), mOperations.end(),
+                                         [](const Operation & a, const Operation & b) { return a.deadline < b.deadline; });
+            if (next == mOperations.end() || next->deadline > end)
+            {
+                break;
+            }
+
+            Operation op = *next;
+            mOperations.erase(next);
+            clock.SetMonotonic(op.deadline);
+
+            Entry * entry = FindEntry(op.peerId, op.state);
+            if (entry == nullptr)
+            {
+                continue; // Cancelled
+            }
+
+            if (op.state == Entry::State::kResolving)
+            {
+                bool unreachable = std::find(mUnreachable.begin(), mUnreachable.end(), op.peerId) != mUnreachable.end();
+                OnLookupComplete(*entry, unreachable ? CHIP_ERROR_TIMEOUT : CHIP_NO_ERROR);
+            }
+            else
+            {
+                OnHandshakeComplete(*entry, CHIP_NO_ERROR);
+            }
+        }
+        clock.SetMonotonic(end);
+    }
+
+    std::vector<ScopedNodeId> mUnreachable;
+    std::vector<ScopedNodeId> mUnknown;
+    std::vector<ScopedNodeId> mLookupOrder;
+    uint8_t mPeakLookups    = 0;
+    uint8_t mPeakHandshakes = 0;
+
+protected:
+    CHIP_ERROR StartLookup(Entry & entry) override
+    {
+        if (std::find(mUnknown.begin(), mUnknown.end(), entry.GetPeerId()) != mUnknown.end())
+        {
+            return CHIP_ERROR_INVALID_FABRIC_INDEX;
+        }
+
+        mLookupOrder.push_back(entry.GetPeerId());
+        mPeakLookups = std::max(mPeakLookups, GetActiveLookupCount());
+        mOperations.push_back(
+            { entry.GetPeerId(), Entry::State::kResolving, System::SystemClock().GetMonotonicTimestamp() + kLookupTime });
+        return CHIP_NO_ERROR;
+    }
+
+    void CancelLookup(Entry & entry) override {}
+
+    void StartHandshake(Entry & entry) override
+    {
+        mPeakHandshakes = std::max(mPeakHandshakes, GetActiveHandshakeCount());
+        mOperations.push_back(
+            { entry.GetPeerId(), Entry::State::kConnecting, System::SystemClock().GetMonotonicTimestamp() + kHandshakeTime });
+    }
+
+private:
+    std::vector<Operation> mOperations;
+};
+
+/// System layer that only queues scheduled work until RunScheduledWork is called.
+class DeferredWorkLayer : public System::LayerImpl
+{
+public:
+    CHIP_ERROR ScheduleWork(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        mWork.push_back({ aComplete, aAppState });
+        return CHIP_NO_ERROR;
+    }
+
+    void CancelTimer(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        mWork.erase(std::remove_if(mWork.begin(), mWork.end(),
+                                   [&](const Work & work) { return work.callback == aComplete && work.appState == aAppState; }),
+                    mWork.end());
+    }
+
+    void RunScheduledWork()
+    {
+        std::vector<Work> work;
+        work.swap(mWork);
+        for (const auto & item : work)
+        {
+            item.callback(this, item.appState);
+        }
+    }
+
+    size_t GetScheduledWorkCount() const { return mWork.size(); }
+
+private:
+    struct Work
+    {
+        System::TimerCompleteCallback callback;
+        void * appState;
+    };
+
+    std::vector<Work> mWork;
+};
+
+class TestCASEConnectionScheduler : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    CASEConnectionScheduler::Params MakeParams(uint8_t lookups, uint8_t handshakes)
+    {
+        CASEConnectionScheduler::Params params;
+        params.sessionManager          = &mSessionManager;
+        params.fabricTable             = &mFabricTable;
+        params.systemLayer             = &mSystemLayer;
+        params.maxConcurrentLookups    = lookups;
+        params.maxConcurrentHandshakes = handshakes;
+        return params;
+    }
+
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+    CASESessionManager mSessionManager;
+    FabricTable mFabricTable;
+    DeferredWorkLayer mSystemLayer;
+};
+
+struct FailureRecorder
+{
+    static void OnFailure(void * context, const OperationalSessionSetup::ConnectionFailureInfo & info)
+    {
+        auto * self = static_cast<FailureRecorder *>(context);
+        self->failures.push_back(info.peerId);
+        self->lastError = info.error;
+    }
+
+    std::vector<ScopedNodeId> failures;
+    CHIP_ERROR lastError = CHIP_NO_ERROR;
+};
+
+TEST_F(TestCASEConnectionScheduler, TestInitValidation)
+{
+    SimulatedScheduler scheduler;
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(1, kFabric), Priority::kNormal, nullptr, nullptr), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(scheduler.Init(MakeParams(0, 1)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(scheduler.Init(MakeParams(1, 0)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    CASEConnectionScheduler::Params params = MakeParams(1, 1);
+    params.systemLayer                     = nullptr;
+    EXPECT_EQ(scheduler.Init(params), CHIP_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(scheduler.Init(MakeParams(1, 1)), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.Init(MakeParams(1, 1)), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestCASEConnectionScheduler, TestBoundedFanOut)
+{
+    constexpr uint8_t kLookups    = 4;
+    constexpr uint8_t kHandshakes = 16;
+    constexpr NodeId kNodeCount   = 40;
+
+    SimulatedScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(MakeParams(kLookups, kHandshakes)), CHIP_NO_ERROR);
+
+    for (NodeId node = 1; node <= kNodeCount; node++)
+    {
+        EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(node, kFabric), Priority::kNormal, nullptr, nullptr), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(scheduler.GetActiveLookupCount(), kLookups);
+
+    scheduler.Advance(mMockClock, 60000_ms64);
+
+    const auto & stats = scheduler.GetStats();
+    EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+    EXPECT_EQ(stats.requested, kNodeCount);
+    EXPECT_EQ(stats.connected, kNodeCount);
+    EXPECT_EQ(stats.failed, 0u);
+    EXPECT_EQ(stats.peakQueueDepth, kNodeCount);
+    EXPECT_EQ(scheduler.mPeakLookups, kLookups);
+    EXPECT_LE(scheduler.mPeakHandshakes, kHandshakes);
+
+    // Lookups are the bottleneck here: 40 nodes, 4 at a time, 200ms each, plus
+    // the trailing handshake.  Serialized establishment would take 28 seconds.
+    EXPECT_EQ(stats.lastDrainDuration.count(), 2500u);
+}
+
+TEST_F(TestCASEConnectionScheduler, TestPriorityOrdering)
+{
+    SimulatedScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(MakeParams(1, 1)), CHIP_NO_ERROR);
+
+    // The first request starts its lookup immediately; the others queue.
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(1, kFabric), Priority::kLow, nullptr, nullptr), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(2, kFabric), Priority::kLow, nullptr, nullptr), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(3, kFabric), Priority::kNormal, nullptr, nullptr), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(4, kFabric), Priority::kHigh, nullptr, nullptr), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(5, kFabric), Priority::kNormal, nullptr, nullptr), CHIP_NO_ERROR);
+
+    scheduler.Advance(mMockClock, 60000_ms64);
+
+    const std::vector<ScopedNodeId> expected = { ScopedNodeId(1, kFabric), ScopedNodeId(4, kFabric), ScopedNodeId(3, kFabric),
+                                                 ScopedNodeId(5, kFabric), ScopedNodeId(2, kFabric) };
+    EXPECT_TRUE(scheduler.mLookupOrder == expected);
+    EXPECT_EQ(scheduler.GetStats().connected, 5u);
+}
+
+TEST_F(TestCASEConnectionScheduler, TestBackPressure)
+{
+    SimulatedScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(MakeParams(2, 2)), CHIP_NO_ERROR);
+
+    for (NodeId node = 1; node <= CASEConnectionScheduler::kQueueSize; node++)
+    {
+        EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(node, kFabric), Priority::kNormal, nullptr, nullptr), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(scheduler.GetAvailableQueueSlots(), 0u);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(1000, kFabric), Priority::kHigh, nullptr, nullptr), CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(scheduler.GetStats().rejected, 1u);
+
+    // Completing the first lookup and handshake frees a slot.
+    scheduler.Advance(mMockClock, kLookupTime + kHandshakeTime);
+    EXPECT_GT(scheduler.GetAvailableQueueSlots(), 0u);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(1000, kFabric), Priority::kHigh, nullptr, nullptr), CHIP_NO_ERROR);
+}
+
+TEST_F(TestCASEConnectionScheduler, TestLookupFailureAndCancel)
+{
+    SimulatedScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(MakeParams(2, 2)), CHIP_NO_ERROR);
+    scheduler.mUnreachable.push_back(ScopedNodeId(2, kFabric));
+
+    FailureRecorder recorder;
+    Callback::Callback<OperationalSessionSetup::OnSetupFailure> onFailure(FailureRecorder::OnFailure, &recorder);
+
+    for (NodeId node = 1; node <= 4; node++)
+    {
+        EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(node, kFabric), Priority::kNormal, nullptr, &onFailure), CHIP_NO_ERROR);
+    }
+
+    // Node 4 is still queued; cancelling it must not report anything.
+    scheduler.CancelRequests(ScopedNodeId(4, kFabric));
+    EXPECT_EQ(scheduler.GetPendingCount(), 3u);
+
+    scheduler.Advance(mMockClock, 60000_ms64);
+
+    ASSERT_EQ(recorder.failures.size(), 1u);
+    EXPECT_TRUE(recorder.failures[0] == ScopedNodeId(2, kFabric));
+    EXPECT_EQ(recorder.lastError, CHIP_ERROR_TIMEOUT);
+    EXPECT_EQ(scheduler.GetStats().connected, 2u);
+    EXPECT_EQ(scheduler.GetStats().failed, 1u);
+    EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+}
+
+TEST_F(TestCASEConnectionScheduler, TestSynchronousFailureIsDeferred)
+{
+    SimulatedScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(MakeParams(2, 2)), CHIP_NO_ERROR);
+    scheduler.mUnknown.push_back(ScopedNodeId(2, kFabric));
+    scheduler.mUnknown.push_back(ScopedNodeId(3, kFabric));
+
+    FailureRecorder recorder;
+    Callback::Callback<OperationalSessionSetup::OnSetupFailure> onFailure(FailureRecorder::OnFailure, &recorder);
+
+    for (NodeId node = 1; node <= 3; node++)
+    {
+        EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(node, kFabric), Priority::kNormal, nullptr, &onFailure), CHIP_NO_ERROR);
+    }
+
+    // The failed lookups gave their slots back, but their callbacks wait for
+    // the event loop.
+    EXPECT_TRUE(recorder.failures.empty());
+    EXPECT_EQ(scheduler.GetActiveLookupCount(), 1u);
+    EXPECT_EQ(scheduler.GetPendingCount(), 3u);
+    EXPECT_EQ(scheduler.GetStats().failed, 2u);
+    EXPECT_EQ(mSystemLayer.GetScheduledWorkCount(), 1u);
+
+    mSystemLayer.RunScheduledWork();
+
+    const std::vector<ScopedNodeId> expected = { ScopedNodeId(2, kFabric), ScopedNodeId(3, kFabric) };
+    EXPECT_TRUE(recorder.failures == expected);
+    EXPECT_EQ(recorder.lastError, CHIP_ERROR_INVALID_FABRIC_INDEX);
+    EXPECT_EQ(scheduler.GetPendingCount(), 1u);
+
+    scheduler.Advance(mMockClock, 60000_ms64);
+    EXPECT_EQ(scheduler.GetStats().connected, 1u);
+    EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+
+    // A deferred failure is dropped when its request is cancelled or the
+    // scheduler shuts down first.
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(2, kFabric), Priority::kNormal, nullptr, &onFailure), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestSession(ScopedNodeId(3, kFabric), Priority::kNormal, nullptr, &onFailure), CHIP_NO_ERROR);
+    scheduler.CancelRequests(ScopedNodeId(2, kFabric));
+    EXPECT_EQ(scheduler.GetPendingCount(), 1u);
+    scheduler.Shutdown();
+    EXPECT_EQ(mSystemLayer.GetScheduledWorkCount(), 0u);
+    EXPECT_EQ(recorder.failures.size(), 2u);
+}
+
+} // namespace
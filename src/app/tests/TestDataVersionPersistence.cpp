@@ -0,0 +1,354 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/DataVersionPersistence.h>
+#include <app/InteractionModelEngine.h>
+#include <app/ReadClient.h>
+#include <app/tests/AppTestContext.h>
+#include <app/tests/test-interaction-model-api.h>
+#include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+using namespace chip::app::Clusters::Globals::Attributes;
+
+// A single cluster, as the mock clusters all share one data version.  Attribute 4 is a list read in several chunks.
+const MockNodeConfig & TestMockNodeConfig()
+{
+    // clang-format off
+    static const MockNodeConfig config({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), {
+                ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1), MockAttributeId(2), MockAttributeId(4),
+            }),
+        }),
+    });
+    // clang-format on
+    return config;
+}
+
+const ConcreteClusterPath kTestClusterPath(kMockEndpoint1, MockClusterId(1));
+const ConcreteAttributePath kVaryingAttributePath(kMockEndpoint1, MockClusterId(1), MockAttributeId(2));
+
+constexpr DataVersion kVersionBeforeReboot = 1000;
+constexpr DataVersion kRandomVersion       = 0x5a5a5a5a;
+
+/// Mock data model where the value of one attribute can change, e.g. across a reboot.
+class VaryingDataModel : public TestImCustomDataModel
+{
+public:
+    DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
+                                                AttributeValueEncoder & encoder) override
+    {
+        if (request.path == kVaryingAttributePath)
+        {
+            return encoder.Encode(mValue);
+        }
+        return TestImCustomDataModel::ReadAttribute(request, encoder);
+    }
+
+    uint32_t mValue = 0;
+};
+
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    size_t mWriteCount = 0;
+
+protected:
+    CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size) override
+    {
+        mWriteCount++;
+        return TestPersistentStorageDelegate::SyncSetKeyValueInternal(key, value, size);
+    }
+};
+
+class NullChangedListener : public AttributesChangedListener
+{
+public:
+    void MarkDirty(const AttributePathParams & path) override {}
+};
+
+class ByteCounter : public LoopbackTransportDelegate
+{
+public:
+    void WillSendMessage(const Transport::PeerAddress & peer, const System::PacketBufferHandle & message) override
+    {
+        mMessageCount++;
+        mByteCount += message->TotalLength();
+    }
+
+    size_t mMessageCount = 0;
+    size_t mByteCount    = 0;
+};
+
+class ReadCallback : public ReadClient::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & path, TLV::TLVReader * data, const StatusIB & status) override
+    {
+        mAttributeCount++;
+    }
+    void OnError(CHIP_ERROR error) override { mError = error; }
+    void OnDone(ReadClient *) override { mDone = true; }
+
+    size_t mAttributeCount = 0;
+    CHIP_ERROR mError      = CHIP_NO_ERROR;
+    bool mDone             = false;
+};
+
+} // namespace
+
+class TestDataVersionPersistence : public AppContext
+{
+public:
+    void SetUp() override
+    {
+        AppContext::SetUp();
+        VerifyOrReturn(!HasFailure());
+
+        SetMockNodeConfig(TestMockNodeConfig());
+        DeviceLayer::SetSystemLayerForTesting(&GetSystemLayer());
+        mOldProvider = InteractionModelEngine::GetInstance()->SetDataModelProvider(&mDataModel);
+    }
+
+    void TearDown() override
+    {
+        SetDataVersionPersistence(nullptr);
+        InteractionModelEngine::GetInstance()->SetDataModelProvider(mOldProvider);
+        DeviceLayer::SetSystemLayerForTesting(nullptr);
+        ResetMockNodeConfig();
+        AppContext::TearDown();
+    }
+
+protected:
+    // Stores the data versions as they are before the reboot, with the same values as after it.
+    void StoreDataVersionsBeforeReboot()
+    {
+        DataVersionPersistence persistence;
+        SetVersionTo(kVersionBeforeReboot);
+        ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+        ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+        EXPECT_EQ(persistence.GetRestoredClusterCount(), 0u);
+        EXPECT_EQ(persistence.Flush(), CHIP_NO_ERROR);
+        persistence.Shutdown();
+    }
+
+    void ChangeTestCluster()
+    {
+        NullChangedListener listener;
+        emberAfAttributeChanged(kTestClusterPath.mEndpointId, kTestClusterPath.mClusterId, MockAttributeId(1), &listener);
+    }
+
+    VaryingDataModel mDataModel;
+    CountingStorage mStorage;
+    DataModel::Provider * mOldProvider = nullptr;
+};
+
+TEST_F(TestDataVersionPersistence, TestSnapshot)
+{
+    uint64_t snapshot;
+    uint64_t otherSnapshot;
+    ASSERT_EQ(DataVersionPersistence::ComputeSnapshot(mDataModel, kTestClusterPath, snapshot), CHIP_NO_ERROR);
+
+    // Data versions are not part of the snapshot.
+    BumpVersion();
+    ASSERT_EQ(DataVersionPersistence::ComputeSnapshot(mDataModel, kTestClusterPath, otherSnapshot), CHIP_NO_ERROR);
+    EXPECT_EQ(otherSnapshot, snapshot);
+
+    mDataModel.mValue++;
+    ASSERT_EQ(DataVersionPersistence::ComputeSnapshot(mDataModel, kTestClusterPath, otherSnapshot), CHIP_NO_ERROR);
+    EXPECT_NE(otherSnapshot, snapshot);
+}
+
+TEST_F(TestDataVersionPersistence, TestRestoreUnchangedCluster)
+{
+    StoreDataVersionsBeforeReboot();
+    EXPECT_TRUE(mStorage.HasKey(DefaultStorageKeyAllocator::ClusterDataVersions(kMockEndpoint1).KeyName()));
+
+    DataVersionPersistence persistence;
+    SetVersionTo(kRandomVersion);
+    ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+    ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+    EXPECT_EQ(persistence.GetRestoredClusterCount(), 1u);
+    EXPECT_EQ(GetVersion(), kVersionBeforeReboot);
+
+    // Nothing changed, so nothing needs to be written.
+    size_t writeCount = mStorage.mWriteCount;
+    EXPECT_EQ(persistence.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWriteCount, writeCount);
+}
+
+TEST_F(TestDataVersionPersistence, TestChangedClusterIsNotRestored)
+{
+    StoreDataVersionsBeforeReboot();
+
+    {
+        DataVersionPersistence persistence;
+        mDataModel.mValue++;
+        SetVersionTo(kRandomVersion);
+        ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+        ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+        EXPECT_EQ(persistence.GetRestoredClusterCount(), 0u);
+        EXPECT_EQ(GetVersion(), kRandomVersion);
+    }
+
+    // The new data version was stored on shutdown, and is restored on the next reboot.
+    DataVersionPersistence persistence;
+    SetVersionTo(kVersionBeforeReboot);
+    ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+    ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+    EXPECT_EQ(persistence.GetRestoredClusterCount(), 1u);
+    EXPECT_EQ(GetVersion(), kRandomVersion);
+}
+
+TEST_F(TestDataVersionPersistence, TestBatchedWrites)
+{
+    StoreDataVersionsBeforeReboot();
+
+    DataVersionPersistence persistence;
+    SetVersionTo(kRandomVersion);
+    ASSERT_EQ(persistence.Init(&mStorage, System::Clock::Milliseconds32(10)), CHIP_NO_ERROR);
+    ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+    SetDataVersionPersistence(&persistence);
+
+    // The first change after a restore is stored without waiting (see TestUnstoredVersionsAreSkipped).
+    ChangeTestCluster();
+
+    size_t writeCount = mStorage.mWriteCount;
+    for (int i = 0; i < 10; i++)
+    {
+        ChangeTestCluster();
+    }
+    EXPECT_EQ(mStorage.mWriteCount, writeCount);
+
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(1), [&]() { return mStorage.mWriteCount != writeCount; });
+    EXPECT_EQ(mStorage.mWriteCount, writeCount + 1);
+}
+
+TEST_F(TestDataVersionPersistence, TestUnstoredVersionsAreSkipped)
+{
+    StoreDataVersionsBeforeReboot();
+
+    {
+        DataVersionPersistence persistence;
+        SetVersionTo(kRandomVersion);
+        ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+        ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+        SetDataVersionPersistence(&persistence);
+
+        // Versions kVersionBeforeReboot + 1 and later may have been published before the reboot: skip them, and store the
+        // version that was skipped to without waiting.
+        size_t writeCount = mStorage.mWriteCount;
+        ChangeTestCluster();
+        EXPECT_EQ(GetVersion(), kVersionBeforeReboot + DataVersionPersistence::kMaxUnstoredVersions);
+        EXPECT_EQ(mStorage.mWriteCount, writeCount + 1);
+
+        ChangeTestCluster();
+        EXPECT_EQ(GetVersion(), kVersionBeforeReboot + DataVersionPersistence::kMaxUnstoredVersions + 1);
+        EXPECT_EQ(mStorage.mWriteCount, writeCount + 1);
+
+        // The versions that follow are stored before kMaxUnstoredVersions of them are published.
+        for (DataVersion i = 2; i < DataVersionPersistence::kMaxUnstoredVersions; i++)
+        {
+            ChangeTestCluster();
+        }
+        EXPECT_EQ(mStorage.mWriteCount, writeCount + 1);
+        ChangeTestCluster();
+        EXPECT_EQ(mStorage.mWriteCount, writeCount + 2);
+
+        // Lose power before the last version is stored.
+        ChangeTestCluster();
+        EXPECT_EQ(GetVersion(), kVersionBeforeReboot + 2 * DataVersionPersistence::kMaxUnstoredVersions + 1);
+        SetDataVersionPersistence(nullptr);
+        mStorage.SetRejectWrites(true);
+    }
+    mStorage.SetRejectWrites(false);
+
+    DataVersionPersistence persistence;
+    SetVersionTo(kRandomVersion);
+    ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+    ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+    EXPECT_EQ(GetVersion(), kVersionBeforeReboot + 2 * DataVersionPersistence::kMaxUnstoredVersions);
+    SetDataVersionPersistence(&persistence);
+
+    ChangeTestCluster();
+    EXPECT_EQ(GetVersion(), kVersionBeforeReboot + 3 * DataVersionPersistence::kMaxUnstoredVersions);
+}
+
+TEST_F(TestDataVersionPersistence, TestReadBytesAfterReboot)
+{
+    ByteCounter counter;
+    GetLoopback().SetLoopbackTransportDelegate(&counter);
+
+    auto readAfterReboot = [&](ReadCallback & callback) {
+        AttributePathParams attributePath(kMockEndpoint1, MockClusterId(1));
+        DataVersionFilter dataVersionFilter(kMockEndpoint1, MockClusterId(1), kVersionBeforeReboot);
+        ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+        readPrepareParams.mpAttributePathParamsList    = &attributePath;
+        readPrepareParams.mAttributePathParamsListSize = 1;
+        readPrepareParams.mpDataVersionFilterList      = &dataVersionFilter;
+        readPrepareParams.mDataVersionFilterListSize   = 1;
+
+        counter.mMessageCount = 0;
+        counter.mByteCount    = 0;
+        ReadClient readClient(InteractionModelEngine::GetInstance(), &GetExchangeManager(), callback,
+                              ReadClient::InteractionType::Read);
+        EXPECT_EQ(readClient.SendRequest(readPrepareParams), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+        EXPECT_TRUE(callback.mDone);
+        EXPECT_EQ(callback.mError, CHIP_NO_ERROR);
+    };
+
+    StoreDataVersionsBeforeReboot();
+
+    // The client read the cluster at kVersionBeforeReboot, and reads it again after the reboot.
+    ReadCallback withoutRestore;
+    SetVersionTo(kRandomVersion);
+    readAfterReboot(withoutRestore);
+    size_t bytesWithoutRestore    = counter.mByteCount;
+    size_t messagesWithoutRestore = counter.mMessageCount;
+
+    ReadCallback withRestore;
+    DataVersionPersistence persistence;
+    ASSERT_EQ(persistence.Init(&mStorage), CHIP_NO_ERROR);
+    ASSERT_EQ(persistence.RestoreDataVersions(mDataModel), CHIP_NO_ERROR);
+    readAfterReboot(withRestore);
+    size_t bytesWithRestore    = counter.mByteCount;
+    size_t messagesWithRestore = counter.mMessageCount;
+
+    GetLoopback().SetLoopbackTransportDelegate(nullptr);
+
+    EXPECT_GT(withoutRestore.mAttributeCount, 0u);
+    EXPECT_EQ(withRestore.mAttributeCount, 0u);
+    EXPECT_LT(bytesWithRestore, bytesWithoutRestore);
+    EXPECT_LE(messagesWithRestore, messagesWithoutRestore);
+}
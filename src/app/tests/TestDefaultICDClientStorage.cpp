@@ -395,3 +395,89 @@ TEST_F(TestDefaultICDClientStorage, TestProcessCheckInPayloadWithEmptyIcdStorage
     ByteSpan payload1{ buffer->Start(), buffer->DataLength() };
     EXPECT_EQ(manager.ProcessCheckInPayload(payload1, decodeClientInfo, checkInCounter), CHIP_ERROR_NOT_FOUND);
 }
+
+TEST_F(TestDefaultICDClientStorage, TestProcessCheckInPayloadIndex)
+{
+    constexpr FabricIndex kFabricCount = 4;
+    constexpr NodeId kNodesPerFabric   = 50;
+
+    TestPersistentStorageDelegate clientInfoStorage;
+    TestSessionKeystoreImpl keystore;
+
+    DefaultICDClientStorage manager;
+    EXPECT_EQ(manager.Init(&clientInfoStorage, &keystore), CHIP_NO_ERROR);
+
+    ICDClientInfo target;
+    for (FabricIndex fabricIndex = 1; fabricIndex <= kFabricCount; fabricIndex++)
+    {
+        EXPECT_EQ(manager.UpdateFabricList(fabricIndex), CHIP_NO_ERROR);
+        for (NodeId nodeId = 1; nodeId <= kNodesPerFabric; nodeId++)
+        {
+            uint8_t keyBuffer[sizeof(kKeyBuffer1)];
+            memcpy(keyBuffer, kKeyBuffer1, sizeof(keyBuffer));
+            keyBuffer[0] = fabricIndex;
+            keyBuffer[1] = static_cast<uint8_t>(nodeId);
+
+            ICDClientInfo clientInfo;
+            clientInfo.peer_node         = ScopedNodeId(nodeId, fabricIndex);
+            clientInfo.start_icd_counter = static_cast<uint32_t>(nodeId * 100);
+            EXPECT_EQ(manager.SetKey(clientInfo, ByteSpan(keyBuffer)), CHIP_NO_ERROR);
+            EXPECT_EQ(manager.StoreEntry(clientInfo), CHIP_NO_ERROR);
+
+            if (fabricIndex == 3 && nodeId == 42)
+            {
+                target = clientInfo;
+            }
+        }
+    }
+
+    System::PacketBufferHandle buffer = MessagePacketBuffer::New(chip::Protocols::SecureChannel::CheckinMessage::kMinPayloadSize);
+    auto processCheckIn = [&](uint32_t counter, ICDClientInfo & decodeClientInfo, uint32_t & checkInCounter) {
+        MutableByteSpan output{ buffer->Start(), buffer->MaxDataLength() };
+        EXPECT_EQ(chip::Protocols::SecureChannel::CheckinMessage::GenerateCheckinMessagePayload(
+                      target.aes_key_handle, target.hmac_key_handle, counter, ByteSpan(), output),
+                  CHIP_NO_ERROR);
+        return manager.ProcessCheckInPayload(output, decodeClientInfo, checkInCounter);
+    };
+
+    // The expected next Check-In is resolved with a single decryption.
+    ICDClientInfo decodeClientInfo;
+    uint32_t checkInCounter = 0;
+    size_t decryptions      = manager.GetCheckInDecryptionCount();
+    EXPECT_EQ(processCheckIn(target.start_icd_counter + 1, decodeClientInfo, checkInCounter), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.GetCheckInDecryptionCount() - decryptions, 1u);
+    EXPECT_TRUE(decodeClientInfo.peer_node == target.peer_node);
+    EXPECT_EQ(checkInCounter, target.start_icd_counter + 1);
+
+    // Storing the new offset, as CheckInHandler does, moves the hints along.
+    decodeClientInfo.offset = 1;
+    EXPECT_EQ(manager.StoreEntry(decodeClientInfo), CHIP_NO_ERROR);
+    decryptions = manager.GetCheckInDecryptionCount();
+    EXPECT_EQ(processCheckIn(target.start_icd_counter + 2, decodeClientInfo, checkInCounter), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.GetCheckInDecryptionCount() - decryptions, 1u);
+    EXPECT_EQ(decodeClientInfo.offset, 1u);
+
+    // After many missed Check-Ins the sender is still found, by trying every key.
+    decryptions = manager.GetCheckInDecryptionCount();
+    EXPECT_EQ(processCheckIn(target.start_icd_counter + 1000, decodeClientInfo, checkInCounter), CHIP_NO_ERROR);
+    EXPECT_GT(manager.GetCheckInDecryptionCount() - decryptions, 1u);
+    EXPECT_TRUE(decodeClientInfo.peer_node == target.peer_node);
+    EXPECT_EQ(checkInCounter, target.start_icd_counter + 1000);
+
+    // A rebuilt index resolves Check-Ins the same way.
+    DefaultICDClientStorage reloaded;
+    EXPECT_EQ(reloaded.Init(&clientInfoStorage, &keystore), CHIP_NO_ERROR);
+    MutableByteSpan output{ buffer->Start(), buffer->MaxDataLength() };
+    EXPECT_EQ(chip::Protocols::SecureChannel::CheckinMessage::GenerateCheckinMessagePayload(
+                  target.aes_key_handle, target.hmac_key_handle, target.start_icd_counter + 2, ByteSpan(), output),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(reloaded.ProcessCheckInPayload(output, decodeClientInfo, checkInCounter), CHIP_NO_ERROR);
+    EXPECT_EQ(reloaded.GetCheckInDecryptionCount(), 1u);
+    EXPECT_TRUE(decodeClientInfo.peer_node == target.peer_node);
+
+    // Deleted entries are dropped from the index.
+    EXPECT_EQ(manager.DeleteEntry(target.peer_node), CHIP_NO_ERROR);
+    EXPECT_EQ(processCheckIn(target.start_icd_counter + 3, decodeClientInfo, checkInCounter), CHIP_ERROR_NOT_FOUND);
+    EXPECT_EQ(manager.DeleteAllEntries(1), CHIP_NO_ERROR);
+    EXPECT_EQ(processCheckIn(target.start_icd_counter + 3, decodeClientInfo, checkInCounter), CHIP_ERROR_NOT_FOUND);
+}
@@ -118,6 +118,45 @@ TEST_F(TestInteractionModelEngine, TestAttributePathParamsPushRelease)
     EXPECT_EQ(GetAttributePathListLength(attributePathParamsList), 0);
 }
 
+TEST_F(TestInteractionModelEngine, TestPathListsInArena)
+{
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()), CHIP_NO_ERROR);
+
+    Arena arena;
+    SingleLinkedListNode<AttributePathParams> * attributePathParamsList = nullptr;
+    SingleLinkedListNode<DataVersionFilter> * dataVersionFilterList     = nullptr;
+
+    AttributePathParams wildcardPath;
+    AttributePathParams concretePath(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(2), chip::Test::MockAttributeId(1));
+    DataVersionFilter dataVersionFilter(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(2), 1);
+
+    EXPECT_EQ(engine->PushFrontAttributePathList(attributePathParamsList, concretePath, &arena), CHIP_NO_ERROR);
+    EXPECT_EQ(engine->PushFrontAttributePathList(attributePathParamsList, wildcardPath, &arena), CHIP_NO_ERROR);
+    EXPECT_EQ(engine->PushFrontDataVersionFilterList(dataVersionFilterList, dataVersionFilter, &arena), CHIP_NO_ERROR);
+    EXPECT_EQ(GetAttributePathListLength(attributePathParamsList), 2);
+
+    // The nodes come from the arena, not from the engine pools.
+    InteractionModelEngine::MemoryStatistics statistics = engine->GetMemoryStatistics();
+    EXPECT_EQ(statistics.mAttributePaths.mAllocated, 0u);
+    EXPECT_EQ(statistics.mDataVersionFilters.mAllocated, 0u);
+    EXPECT_EQ(arena.GetStatistics().mAllocations, 3u + 1u); // DataVersionFilter needs a destructor record.
+    EXPECT_EQ(arena.GetStatistics().mBlockAllocations, 1u);
+
+    // Duplicates are unlinked without being handed back to the pool.
+    engine->RemoveDuplicateConcreteAttributePath(attributePathParamsList, &arena);
+    EXPECT_EQ(GetAttributePathListLength(attributePathParamsList), 1);
+
+    engine->ReleaseAttributePathList(attributePathParamsList, &arena);
+    engine->ReleaseDataVersionFilterList(dataVersionFilterList, &arena);
+    EXPECT_EQ(attributePathParamsList, nullptr);
+    EXPECT_EQ(dataVersionFilterList, nullptr);
+
+    arena.Reset();
+    EXPECT_TRUE(arena.IsEmpty());
+}
+
 TEST_F(TestInteractionModelEngine, TestRemoveDuplicateConcreteAttribute)
 {
 
@@ -2711,6 +2711,67 @@ TEST_F(TestReadInteraction, TestSubscribePartialOverlap)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+// Subscribe to ten paths and check how the read handler holds them.
+TEST_F(TestReadInteraction, TestSubscribePathMemory)
+{
+    constexpr size_t kPathCount = 10;
+
+    MockInteractionModelApp delegate;
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), gReportScheduler), CHIP_NO_ERROR);
+
+    ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+    readPrepareParams.mEventPathParamsListSize = 0;
+
+    std::unique_ptr<chip::app::AttributePathParams[]> attributePathParams(new chip::app::AttributePathParams[kPathCount]);
+    for (size_t i = 0; i < kPathCount; i++)
+    {
+        attributePathParams[i].mEndpointId  = chip::Test::kMockEndpoint2;
+        attributePathParams[i].mClusterId   = chip::Test::MockClusterId(3);
+        attributePathParams[i].mAttributeId = chip::Test::MockAttributeId(1);
+    }
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams.get();
+    readPrepareParams.mAttributePathParamsListSize = kPathCount;
+
+    readPrepareParams.mMinIntervalFloorSeconds   = 0;
+    readPrepareParams.mMaxIntervalCeilingSeconds = 1;
+
+    {
+        app::ReadClient readClient(chip::app::InteractionModelEngine::GetInstance(), &GetExchangeManager(), delegate,
+                                   chip::app::ReadClient::InteractionType::Subscribe);
+
+        attributePathParams.release();
+        EXPECT_EQ(readClient.SendAutoResubscribeRequest(std::move(readPrepareParams)), CHIP_NO_ERROR);
+
+        DrainAndServiceIO();
+
+        EXPECT_TRUE(delegate.mGotReport);
+        EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe), 1u);
+
+        InteractionModelEngine::MemoryStatistics statistics = engine->GetMemoryStatistics();
+        EXPECT_EQ(statistics.mReadHandlers.mAllocated, 1u);
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        // All the paths share a single block of the handler's arena, instead of being two heap allocations each.
+        EXPECT_EQ(statistics.mAttributePaths.mAllocated, 0u);
+        EXPECT_EQ(statistics.mPathArenas.mAllocations, kPathCount);
+        EXPECT_EQ(statistics.mPathArenas.mBlockAllocations, 1u);
+        EXPECT_LE(statistics.mPathArenas.mBytesUsed, statistics.mPathArenas.mBytesReserved);
+#else
+        EXPECT_EQ(statistics.mAttributePaths.mAllocated, kPathCount);
+        EXPECT_EQ(statistics.mPathArenas.mBlockCount, 0u);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 0u);
+    engine->Shutdown();
+
+    InteractionModelEngine::MemoryStatistics statistics = engine->GetMemoryStatistics();
+    EXPECT_EQ(statistics.mReadHandlers.mAllocated, 0u);
+    EXPECT_EQ(statistics.mAttributePaths.mAllocated, 0u);
+    EXPECT_EQ(statistics.mPathArenas.mBlockCount, 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 // Subscribe (E2, C3, A1), then setDirty (wildcard, wildcard, wildcard), receive one attribute after setDirty
 TEST_F(TestReadInteraction, TestSubscribeSetDirtyFullyOverlap)
 {
@@ -2779,6 +2840,125 @@ TEST_F(TestReadInteraction, TestSubscribeSetDirtyFullyOverlap)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+// Subscribe (E2, C3, A1), then set dirty paths in batches, across several passes over the read handlers, and by endpoint range.
+TEST_F(TestReadInteraction, TestSubscribeSetDirtyBatch)
+{
+    MockInteractionModelApp delegate;
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), gReportScheduler), CHIP_NO_ERROR);
+
+    ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+    readPrepareParams.mEventPathParamsListSize = 0;
+
+    std::unique_ptr<chip::app::AttributePathParams[]> attributePathParams(new chip::app::AttributePathParams[1]);
+    attributePathParams[0].mEndpointId             = chip::Test::kMockEndpoint2;
+    attributePathParams[0].mClusterId              = chip::Test::MockClusterId(3);
+    attributePathParams[0].mAttributeId            = chip::Test::MockAttributeId(1);
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams.get();
+    readPrepareParams.mAttributePathParamsListSize = 1;
+
+    readPrepareParams.mMinIntervalFloorSeconds   = 0;
+    readPrepareParams.mMaxIntervalCeilingSeconds = 1;
+
+    {
+        app::ReadClient readClient(chip::app::InteractionModelEngine::GetInstance(), &GetExchangeManager(), delegate,
+                                   chip::app::ReadClient::InteractionType::Subscribe);
+
+        attributePathParams.release();
+        EXPECT_EQ(readClient.SendAutoResubscribeRequest(std::move(readPrepareParams)), CHIP_NO_ERROR);
+
+        DrainAndServiceIO();
+
+        EXPECT_TRUE(delegate.mGotReport);
+        EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe), 1u);
+        ASSERT_NE(engine->ActiveHandlerAt(0), nullptr);
+        delegate.mpReadHandler = engine->ActiveHandlerAt(0);
+
+        // The subscribed path is in the interest index of the reporting engine until the subscription ends.
+        EXPECT_EQ(engine->GetReportingEngine().GetInterestIndexEntryCount(), 1u);
+
+        // More paths than a single pass handles, none of which is subscribed to: no report.
+        constexpr size_t kDirtyPathCount = reporting::Engine::kMaxDirtyPathsPerPass + 8;
+        AttributePathParams dirtyPaths[kDirtyPathCount];
+        for (size_t i = 0; i < kDirtyPathCount; i++)
+        {
+            dirtyPaths[i] = AttributePathParams(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(2),
+                                                chip::Test::MockAttributeId(static_cast<AttributeId>(i)));
+        }
+        {
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+
+            EXPECT_EQ(engine->GetReportingEngine().SetDirty(Span<const AttributePathParams>(dirtyPaths)), CHIP_NO_ERROR);
+            EXPECT_EQ(engine->GetReportingEngine().GetGlobalDirtySetSize(), 0u);
+
+            DrainAndServiceIO();
+
+            EXPECT_FALSE(delegate.mGotReport);
+        }
+
+        // The same batch with the subscribed attribute in the second pass: a single report of E2C3A1.
+        dirtyPaths[kDirtyPathCount - 1] = AttributePathParams(chip::Test::kMockEndpoint2, chip::Test::MockClusterId(3));
+        {
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+
+            EXPECT_EQ(engine->GetReportingEngine().SetDirty(Span<const AttributePathParams>(dirtyPaths)), CHIP_NO_ERROR);
+            EXPECT_EQ(engine->GetReportingEngine().GetGlobalDirtySetSize(), 1u);
+
+            DrainAndServiceIO();
+
+            EXPECT_TRUE(delegate.mGotReport);
+            EXPECT_EQ(delegate.mNumAttributeResponse, 1);
+            EXPECT_EQ(delegate.mReceivedAttributePaths[0].mEndpointId, chip::Test::kMockEndpoint2);
+            EXPECT_EQ(delegate.mReceivedAttributePaths[0].mClusterId, chip::Test::MockClusterId(3));
+            EXPECT_EQ(delegate.mReceivedAttributePaths[0].mAttributeId, chip::Test::MockAttributeId(1));
+        }
+
+        // An endpoint range including E2.
+        {
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+
+            EXPECT_EQ(engine->GetReportingEngine().SetEndpointRangeDirty(chip::Test::kMockEndpoint3, chip::Test::kMockEndpoint1),
+                      CHIP_NO_ERROR);
+
+            DrainAndServiceIO();
+
+            EXPECT_TRUE(delegate.mGotReport);
+            EXPECT_EQ(delegate.mNumAttributeResponse, 1);
+            EXPECT_EQ(delegate.mReceivedAttributePaths[0].mEndpointId, chip::Test::kMockEndpoint2);
+        }
+
+        // A cluster over an endpoint range that does not include E2.
+        {
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+
+            EXPECT_EQ(
+                engine->GetReportingEngine().SetEndpointRangeDirty(0, chip::Test::kMockEndpoint3, chip::Test::MockClusterId(3)),
+                CHIP_NO_ERROR);
+
+            DrainAndServiceIO();
+
+            EXPECT_FALSE(delegate.mGotReport);
+        }
+
+        EXPECT_EQ(engine->GetReportingEngine().SetEndpointRangeDirty(chip::Test::kMockEndpoint1, chip::Test::kMockEndpoint2),
+                  CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 0u);
+
+    // Tearing down the subscription removes its handler from the interest index.
+    engine->ShutdownActiveReads();
+    EXPECT_EQ(engine->GetNumActiveReadHandlers(), 0u);
+    EXPECT_EQ(engine->GetReportingEngine().GetInterestIndexEntryCount(), 0u);
+
+    engine->Shutdown();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 // Verify that subscription can be shut down just after receiving SUBSCRIBE RESPONSE,
 // before receiving any subsequent REPORT DATA.
 TEST_F(TestReadInteraction, TestSubscribeEarlyShutdown)
@@ -0,0 +1,265 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/MessageDef/AttributeDataIB.h>
+#include <app/SharedAttributeStore.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+const ScopedNodeId kNode1(0x1111, 1);
+const ScopedNodeId kNode2(0x2222, 1);
+const ScopedNodeId kNode3(0x1111, 2);
+
+const ConcreteAttributePath kInt16uPath(1, UnitTesting::Id, UnitTesting::Attributes::Int16u::Id);
+const ConcreteAttributePath kOctetStringPath(1, UnitTesting::Id, UnitTesting::Attributes::OctetString::Id);
+const ConcreteAttributePath kCharStringPath(1, UnitTesting::Id, UnitTesting::Attributes::CharString::Id);
+const ConcreteAttributePath kBasicNamePath(0, BasicInformation::Id, BasicInformation::Attributes::NodeLabel::Id);
+
+class TestSharedAttributeStore : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+protected:
+    // Encode a value the way it appears in an AttributeDataIB, and store it.
+    template <typename T>
+    CHIP_ERROR Set(const ScopedNodeId & node, const ConcreteAttributePath & path, const T & value, bool & changed)
+    {
+        uint8_t buffer[256];
+        TLV::TLVWriter writer;
+        TLV::TLVType outer;
+        writer.Init(buffer);
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outer));
+        ReturnErrorOnFailure(DataModel::Encode(writer, TLV::ContextTag(AttributeDataIB::Tag::kData), value));
+        ReturnErrorOnFailure(writer.EndContainer(outer));
+        ReturnErrorOnFailure(writer.Finalize());
+
+        TLV::TLVReader reader;
+        reader.Init(buffer, writer.GetLengthWritten());
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(reader.EnterContainer(outer));
+        ReturnErrorOnFailure(reader.Next());
+        return mStore.SetAttribute(node, path, reader, changed);
+    }
+
+    template <typename T>
+    void ExpectSet(const ScopedNodeId & node, const ConcreteAttributePath & path, const T & value, bool expectChanged)
+    {
+        bool changed = !expectChanged;
+        EXPECT_EQ(Set(node, path, value, changed), CHIP_NO_ERROR);
+        EXPECT_EQ(changed, expectChanged);
+    }
+
+    SharedAttributeStore mStore;
+};
+
+TEST_F(TestSharedAttributeStore, TestInlineValues)
+{
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(42), true);
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(42), false);
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(43), true);
+
+    uint16_t value = 0;
+    EXPECT_EQ(mStore.Get<UnitTesting::Attributes::Int16u::TypeInfo>(kNode1, 1, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 43);
+
+    SharedAttributeStore::Stats stats;
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mNodeCount, 1u);
+    EXPECT_EQ(stats.mAttributeCount, 1u);
+    EXPECT_EQ(stats.mInlineValueCount, 1u);
+    EXPECT_EQ(stats.mSharedValueCount, 0u);
+
+    // Nothing stored for other paths or nodes.
+    TLV::TLVReader reader;
+    EXPECT_EQ(mStore.Get(kNode1, kOctetStringPath, reader), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(mStore.Get(kNode2, kInt16uPath, reader), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestSharedAttributeStore, TestSharedValues)
+{
+    const char label[] = "a label long enough not to be inlined";
+
+    // The same value on many nodes is stored once.
+    for (NodeId node = 1; node <= 100; node++)
+    {
+        ExpectSet(ScopedNodeId(node, 1), kCharStringPath, CharSpan::fromCharString(label), true);
+    }
+
+    SharedAttributeStore::Stats stats;
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mNodeCount, 100u);
+    EXPECT_EQ(stats.mAttributeCount, 100u);
+    EXPECT_EQ(stats.mInlineValueCount, 0u);
+    EXPECT_EQ(stats.mSharedValueCount, 1u);
+
+    CharSpan value;
+    EXPECT_EQ(mStore.Get<UnitTesting::Attributes::CharString::TypeInfo>(ScopedNodeId(50, 1), 1, value), CHIP_NO_ERROR);
+    EXPECT_TRUE(value.data_equal(CharSpan::fromCharString(label)));
+
+    // Storing the same value again is not a change, even though it goes through a fresh encoding.
+    ExpectSet(ScopedNodeId(50, 1), kCharStringPath, CharSpan::fromCharString(label), false);
+
+    // Changing the value on one node leaves the others alone.
+    const char other[] = "another label long enough not to be inlined";
+    ExpectSet(ScopedNodeId(50, 1), kCharStringPath, CharSpan::fromCharString(other), true);
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mSharedValueCount, 2u);
+
+    EXPECT_EQ(mStore.Get<UnitTesting::Attributes::CharString::TypeInfo>(ScopedNodeId(50, 1), 1, value), CHIP_NO_ERROR);
+    EXPECT_TRUE(value.data_equal(CharSpan::fromCharString(other)));
+    EXPECT_EQ(mStore.Get<UnitTesting::Attributes::CharString::TypeInfo>(ScopedNodeId(51, 1), 1, value), CHIP_NO_ERROR);
+    EXPECT_TRUE(value.data_equal(CharSpan::fromCharString(label)));
+
+    // The last reference going away frees the value.
+    ExpectSet(ScopedNodeId(50, 1), kCharStringPath, CharSpan::fromCharString(label), true);
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mSharedValueCount, 1u);
+
+    mStore.Clear();
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mNodeCount, 0u);
+    EXPECT_EQ(stats.mSharedValueCount, 0u);
+    EXPECT_EQ(stats.mSharedValueBytes, 0u);
+}
+
+TEST_F(TestSharedAttributeStore, TestTypeMismatch)
+{
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(42), true);
+
+    CharSpan value;
+    EXPECT_EQ(mStore.Get<UnitTesting::Attributes::CharString::TypeInfo>(kNode1, 1, value), CHIP_ERROR_KEY_NOT_FOUND);
+
+    // Same path, wrong type.
+    ExpectSet(kNode1, kCharStringPath, static_cast<uint16_t>(42), true);
+    EXPECT_NE(mStore.Get<UnitTesting::Attributes::CharString::TypeInfo>(kNode1, 1, value), CHIP_NO_ERROR);
+}
+
+TEST_F(TestSharedAttributeStore, TestStatus)
+{
+    bool changed = false;
+    StatusIB status(Protocols::InteractionModel::Status::UnsupportedAttribute);
+
+    EXPECT_EQ(mStore.SetStatus(kNode1, kOctetStringPath, status, changed), CHIP_NO_ERROR);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(mStore.SetStatus(kNode1, kOctetStringPath, status, changed), CHIP_NO_ERROR);
+    EXPECT_FALSE(changed);
+
+    TLV::TLVReader reader;
+    EXPECT_EQ(mStore.Get(kNode1, kOctetStringPath, reader), CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+
+    StatusIB stored;
+    EXPECT_EQ(mStore.GetStatus(kNode1, kOctetStringPath, stored), CHIP_NO_ERROR);
+    EXPECT_EQ(stored.mStatus, Protocols::InteractionModel::Status::UnsupportedAttribute);
+    EXPECT_FALSE(stored.mClusterStatus.HasValue());
+
+    // Data replaces the status.
+    uint8_t bytes[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    ExpectSet(kNode1, kOctetStringPath, ByteSpan(bytes), true);
+    EXPECT_EQ(mStore.GetStatus(kNode1, kOctetStringPath, stored), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // And a status replaces data, releasing the shared value.
+    EXPECT_EQ(mStore.SetStatus(kNode1, kOctetStringPath, status, changed), CHIP_NO_ERROR);
+    EXPECT_TRUE(changed);
+
+    SharedAttributeStore::Stats stats;
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mSharedValueCount, 0u);
+}
+
+TEST_F(TestSharedAttributeStore, TestDataVersions)
+{
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(1), true);
+    ExpectSet(kNode1, kOctetStringPath, ByteSpan(), true);
+    ExpectSet(kNode1, kCharStringPath, CharSpan(), true);
+    ExpectSet(kNode1, kBasicNamePath, CharSpan(), true);
+
+    Optional<DataVersion> version;
+    EXPECT_EQ(mStore.GetDataVersion(kNode1, kInt16uPath, version), CHIP_NO_ERROR);
+    EXPECT_FALSE(version.HasValue());
+
+    mStore.SetDataVersion(kNode1, kInt16uPath, MakeOptional<DataVersion>(7));
+    mStore.SetDataVersion(kNode1, kBasicNamePath, MakeOptional<DataVersion>(9));
+    EXPECT_EQ(mStore.GetDataVersion(kNode1, kInt16uPath, version), CHIP_NO_ERROR);
+    EXPECT_EQ(version, MakeOptional<DataVersion>(7));
+
+    // Versions are per node.
+    EXPECT_NE(mStore.GetDataVersion(kNode3, kInt16uPath, version), CHIP_NO_ERROR);
+
+    // Filters come out with the biggest clusters first.
+    std::vector<std::pair<DataVersionFilter, size_t>> filters;
+    mStore.GetDataVersionFilters(kNode1, filters);
+    ASSERT_EQ(filters.size(), 2u);
+    EXPECT_EQ(filters[0].first.mClusterId, UnitTesting::Id);
+    EXPECT_EQ(filters[0].first.mDataVersion, MakeOptional<DataVersion>(7));
+    EXPECT_EQ(filters[1].first.mClusterId, BasicInformation::Id);
+    EXPECT_GT(filters[0].second, filters[1].second);
+
+    mStore.SetDataVersion(kNode1, kInt16uPath, NullOptional);
+    mStore.GetDataVersionFilters(kNode1, filters);
+    ASSERT_EQ(filters.size(), 1u);
+    EXPECT_EQ(filters[0].first.mClusterId, BasicInformation::Id);
+
+    // Clearing a cluster drops its attributes and version.
+    mStore.ClearCluster(kNode1, kBasicNamePath);
+    TLV::TLVReader reader;
+    EXPECT_EQ(mStore.Get(kNode1, kBasicNamePath, reader), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(mStore.Get(kNode1, kInt16uPath, reader), CHIP_NO_ERROR);
+    mStore.GetDataVersionFilters(kNode1, filters);
+    EXPECT_TRUE(filters.empty());
+}
+
+TEST_F(TestSharedAttributeStore, TestRemoveNode)
+{
+    const char label[] = "a label long enough not to be inlined";
+
+    ExpectSet(kNode1, kCharStringPath, CharSpan::fromCharString(label), true);
+    ExpectSet(kNode2, kCharStringPath, CharSpan::fromCharString(label), true);
+    ExpectSet(kNode1, kInt16uPath, static_cast<uint16_t>(1), true);
+    EXPECT_EQ(mStore.GetNodeCount(), 2u);
+
+    mStore.RemoveNode(kNode1);
+    EXPECT_FALSE(mStore.HasNode(kNode1));
+    EXPECT_TRUE(mStore.HasNode(kNode2));
+
+    SharedAttributeStore::Stats stats;
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mAttributeCount, 1u);
+    EXPECT_EQ(stats.mSharedValueCount, 1u);
+
+    mStore.RemoveNode(kNode2);
+    mStore.GetStats(stats);
+    EXPECT_EQ(stats.mNodeCount, 0u);
+    EXPECT_EQ(stats.mSharedValueCount, 0u);
+}
+
+} // namespace
@@ -49,7 +49,8 @@ struct TestSubscriptionInfo : public chip::app::SubscriptionResumptionStorage::S
             return false;
         }
         if ((mAttributePaths.AllocatedSize() != that.mAttributePaths.AllocatedSize()) ||
-            (mEventPaths.AllocatedSize() != that.mEventPaths.AllocatedSize()))
+            (mEventPaths.AllocatedSize() != that.mEventPaths.AllocatedSize()) ||
+            (mDataVersionFilters.AllocatedSize() != that.mDataVersionFilters.AllocatedSize()))
         {
             return false;
         }
@@ -72,6 +73,15 @@ struct TestSubscriptionInfo : public chip::app::SubscriptionResumptionStorage::S
                 return false;
             }
         }
+        for (size_t i = 0; i < mDataVersionFilters.AllocatedSize(); i++)
+        {
+            if ((mDataVersionFilters[i].mEndpointId != that.mDataVersionFilters[i].mEndpointId) ||
+                (mDataVersionFilters[i].mClusterId != that.mDataVersionFilters[i].mClusterId) ||
+                (mDataVersionFilters[i].mDataVersion != that.mDataVersionFilters[i].mDataVersion))
+            {
+                return false;
+            }
+        }
         return true;
     }
 };
@@ -219,6 +229,13 @@ TEST_F(TestSimpleSubscriptionResumptionStorage, TestSubscriptionState)
     subscriptionInfo3.mEventPaths[1].mClusterId     = 8;
     subscriptionInfo3.mEventPaths[1].mEventId       = 8;
     subscriptionInfo2.mEventPaths[1].mIsUrgentEvent = false;
+    subscriptionInfo3.mDataVersionFilters.Calloc(2);
+    subscriptionInfo3.mDataVersionFilters[0].mEndpointId  = 5;
+    subscriptionInfo3.mDataVersionFilters[0].mClusterId   = 5;
+    subscriptionInfo3.mDataVersionFilters[0].mDataVersion = 0x55555555;
+    subscriptionInfo3.mDataVersionFilters[1].mEndpointId  = 6;
+    subscriptionInfo3.mDataVersionFilters[1].mClusterId   = 6;
+    subscriptionInfo3.mDataVersionFilters[1].mDataVersion = 0xFFFFFFFF;
 
     EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo1), CHIP_NO_ERROR);
     EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo2), CHIP_NO_ERROR);
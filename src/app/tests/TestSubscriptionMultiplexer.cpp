@@ -0,0 +1,384 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/SubscriptionMultiplexer.h>
+#include <app/tests/AppTestContext.h>
+#include <app/tests/test-interaction-model-api.h>
+#include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <system/SystemClock.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::Globals::Attributes;
+using namespace chip::Test;
+
+namespace chip {
+namespace app {
+
+class SubscriptionMultiplexerTestAccess
+{
+public:
+    static SharedAttributeStore & GetStore(SubscriptionMultiplexer & aMultiplexer) { return aMultiplexer.mStore; }
+};
+
+} // namespace app
+} // namespace chip
+
+namespace {
+
+static System::Clock::Internal::MockClock gMockClock;
+static System::Clock::ClockBase * gRealClock;
+
+constexpr size_t kNodeCount = 24;
+
+const MockNodeConfig & TestMockNodeConfig()
+{
+    // clang-format off
+    static const MockNodeConfig config({
+        MockEndpointConfig(kMockEndpoint3, {
+            MockClusterConfig(MockClusterId(2), {
+                ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1), MockAttributeId(2), MockAttributeId(3),
+            }),
+        }),
+    });
+    // clang-format on
+    return config;
+}
+
+const ConcreteClusterPath kSubscribedCluster(kMockEndpoint3, MockClusterId(2));
+
+class MultiplexerCallback : public SubscriptionMultiplexer::Callback
+{
+public:
+    void OnAttributeChanged(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                            const ConcreteAttributePath & aPath) override
+    {
+        mChangeCount++;
+    }
+
+    void OnReportEnd(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode) override
+    {
+        mReportCount[aNode.GetNodeId()]++;
+    }
+
+    void OnSubscriptionEstablished(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode,
+                                   SubscriptionId aSubscriptionId) override
+    {
+        mEstablishedAt.push_back(gMockClock.GetMonotonicTimestamp());
+    }
+
+    void OnResubscriptionScheduled(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                   System::Clock::Milliseconds32 aDelay) override
+    {
+        // Only keep the first attempt of each node, made when its subscription dropped.
+        if (mResubscribeAt.find(aNode.GetNodeId()) == mResubscribeAt.end())
+        {
+            mResubscribeAt[aNode.GetNodeId()] = gMockClock.GetMonotonicTimestamp() + aDelay;
+        }
+    }
+
+    void OnSubscriptionTerminated(SubscriptionMultiplexer & aMultiplexer, const ScopedNodeId & aNode, CHIP_ERROR aError) override
+    {
+        mTerminatedCount++;
+    }
+
+    size_t mChangeCount     = 0;
+    size_t mTerminatedCount = 0;
+    std::map<NodeId, size_t> mReportCount;
+    std::vector<System::Clock::Timestamp> mEstablishedAt;
+    std::map<NodeId, System::Clock::Timestamp> mResubscribeAt;
+};
+
+class TestSubscriptionMultiplexer : public chip::Test::AppContext
+{
+public:
+    static void SetUpTestSuite()
+    {
+        AppContext::SetUpTestSuite();
+
+        gRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&gMockClock);
+    }
+
+    static void TearDownTestSuite()
+    {
+        System::Clock::Internal::SetSystemClockForTesting(gRealClock);
+        AppContext::TearDownTestSuite();
+    }
+
+    void SetUp() override
+    {
+        AppContext::SetUp();
+
+        mOldProvider = InteractionModelEngine::GetInstance()->SetDataModelProvider(&TestImCustomDataModel::Instance());
+        InteractionModelEngine::GetInstance()->SetHandlerCapacityForSubscriptions(kNodeCount);
+        SetMockNodeConfig(TestMockNodeConfig());
+        SetVersionTo(kTestDataVersion1);
+
+        mAttributePath = AttributePathParams(kSubscribedCluster.mEndpointId, kSubscribedCluster.mClusterId);
+    }
+
+    void TearDown() override
+    {
+        InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+        ResetMockNodeConfig();
+        InteractionModelEngine::GetInstance()->SetHandlerCapacityForSubscriptions(-1);
+        InteractionModelEngine::GetInstance()->SetDataModelProvider(mOldProvider);
+        AppContext::TearDown();
+    }
+
+protected:
+    SubscriptionMultiplexer::Params DefaultParams()
+    {
+        SubscriptionMultiplexer::Params params;
+        params.mAttributePaths            = Span<AttributePathParams>(&mAttributePath, 1);
+        params.mMaxIntervalCeilingSeconds = 2;
+        // Every node is reached through the same loopback session: do not let the subscriptions replace each other.
+        params.mKeepSubscriptions = true;
+        return params;
+    }
+
+    // Spacing between two subscription attempts at the pace set by aParams.
+    static System::Clock::Microseconds64 SubscribeInterval(const SubscriptionMultiplexer::Params & aParams)
+    {
+        return System::Clock::Microseconds64(System::Clock::Seconds32(1)) / aParams.mMaxSubscribesPerSecond;
+    }
+
+    // Nodes are simulated by distinct ids that all share the loopback session.
+    CHIP_ERROR AddNodes(SubscriptionMultiplexer & aMultiplexer, size_t aCount)
+    {
+        for (size_t i = 1; i <= aCount; i++)
+        {
+            ReturnErrorOnFailure(aMultiplexer.AddNode(ScopedNodeId(static_cast<NodeId>(i), GetAliceFabricIndex()),
+                                                      GetSessionBobToAlice()));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    // Let time pass in small steps, processing messages and timers, until the condition holds.
+    template <typename Condition>
+    bool AdvanceUntil(Condition aCondition, System::Clock::Milliseconds32 aMaxTime)
+    {
+        const System::Clock::Timestamp end = gMockClock.GetMonotonicTimestamp() + aMaxTime;
+        DrainAndServiceIO();
+        while (!aCondition() && gMockClock.GetMonotonicTimestamp() < end)
+        {
+            gMockClock.AdvanceMonotonic(System::Clock::Milliseconds32(10));
+            DrainAndServiceIO();
+        }
+        return aCondition();
+    }
+
+    AttributePathParams mAttributePath;
+    DataModel::Provider * mOldProvider = nullptr;
+};
+
+TEST_F(TestSubscriptionMultiplexer, TestSharedTimerScheduler)
+{
+    SharedTimerScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(&GetSystemLayer(), System::Clock::Milliseconds32(100)), CHIP_NO_ERROR);
+
+    int fired[10] = {};
+    auto callback = [](System::Layer *, void * appState) { (*static_cast<int *>(appState))++; };
+
+    // Timers expiring within the same tick are handled in a single wakeup.
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(scheduler.StartTimer(System::Clock::Milliseconds32(10 * (i + 1)), callback, &fired[i]), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(scheduler.GetPendingTimerCount(), 10u);
+
+    // Restarting a timer replaces it, cancelling removes it.
+    EXPECT_EQ(scheduler.StartTimer(System::Clock::Milliseconds32(50), callback, &fired[9]), CHIP_NO_ERROR);
+    scheduler.CancelTimer(callback, &fired[0]);
+    EXPECT_FALSE(scheduler.IsTimerActive(callback, &fired[0]));
+    EXPECT_TRUE(scheduler.IsTimerActive(callback, &fired[9]));
+    EXPECT_EQ(scheduler.GetPendingTimerCount(), 9u);
+
+    EXPECT_TRUE(AdvanceUntil([&] { return scheduler.GetPendingTimerCount() == 0; }, System::Clock::Seconds16(1)));
+    EXPECT_EQ(fired[0], 0);
+    for (int i = 1; i < 10; i++)
+    {
+        EXPECT_EQ(fired[i], 1);
+    }
+    EXPECT_EQ(scheduler.GetWakeupCount(), 1u);
+
+    scheduler.Shutdown();
+}
+
+TEST_F(TestSubscriptionMultiplexer, TestSubscribeManyNodes)
+{
+    MultiplexerCallback callback;
+    SubscriptionMultiplexer multiplexer(InteractionModelEngine::GetInstance(), callback);
+    SubscriptionMultiplexer::Params params = DefaultParams();
+    ASSERT_EQ(multiplexer.Init(params), CHIP_NO_ERROR);
+
+    const System::Clock::Timestamp start = gMockClock.GetMonotonicTimestamp();
+    ASSERT_EQ(AddNodes(multiplexer, kNodeCount), CHIP_NO_ERROR);
+    EXPECT_EQ(multiplexer.AddNode(ScopedNodeId(1, GetAliceFabricIndex()), GetSessionBobToAlice()), CHIP_ERROR_INCORRECT_STATE);
+
+    EXPECT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == kNodeCount; }, System::Clock::Seconds16(10)));
+    EXPECT_EQ(callback.mTerminatedCount, 0u);
+    ASSERT_EQ(callback.mEstablishedAt.size(), kNodeCount);
+
+    // Subscriptions were started at the configured pace, not all at once.
+    const auto elapsed = callback.mEstablishedAt.back() - start;
+    EXPECT_GE(elapsed, SubscribeInterval(params) * (kNodeCount - 1));
+
+    // Every node's attributes are stored, along with the cluster data version.
+    const SharedAttributeStore & store = multiplexer.GetStore();
+    EXPECT_EQ(store.GetNodeCount(), kNodeCount);
+    for (size_t i = 1; i <= kNodeCount; i++)
+    {
+        ScopedNodeId node(static_cast<NodeId>(i), GetAliceFabricIndex());
+        Optional<DataVersion> version;
+        EXPECT_EQ(store.GetDataVersion(node, kSubscribedCluster, version), CHIP_NO_ERROR);
+        EXPECT_EQ(version, MakeOptional(kTestDataVersion1));
+
+        TLV::TLVReader reader;
+        EXPECT_EQ(store.Get(node, ConcreteAttributePath(kMockEndpoint3, MockClusterId(2), MockAttributeId(1)), reader),
+                  CHIP_NO_ERROR);
+    }
+
+    // All the nodes report the same values: the ones not stored inline (the global lists) are stored once for the whole
+    // fleet.  The liveness timers of all the subscriptions are driven by the shared scheduler.
+    SharedAttributeStore::Stats stats;
+    store.GetStats(stats);
+    EXPECT_EQ(stats.mAttributeCount % kNodeCount, 0u);
+    EXPECT_EQ(callback.mChangeCount, stats.mAttributeCount);
+    EXPECT_GT(stats.mSharedValueCount, 0u);
+    EXPECT_LE(stats.mSharedValueCount, stats.mAttributeCount / kNodeCount);
+    EXPECT_EQ(multiplexer.GetTimerScheduler().GetPendingTimerCount(), kNodeCount);
+
+    // A report updates the stored data version of every node.
+    BumpVersion();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(mAttributePath);
+    callback.mReportCount.clear();
+    EXPECT_TRUE(AdvanceUntil([&] { return callback.mReportCount.size() == kNodeCount; }, System::Clock::Seconds16(5)));
+    for (size_t i = 1; i <= kNodeCount; i++)
+    {
+        Optional<DataVersion> version;
+        EXPECT_EQ(multiplexer.GetStore().GetDataVersion(ScopedNodeId(static_cast<NodeId>(i), GetAliceFabricIndex()),
+                                                        kSubscribedCluster, version),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(version, MakeOptional<DataVersion>(kTestDataVersion1 + 1));
+    }
+
+    multiplexer.RemoveNode(ScopedNodeId(1, GetAliceFabricIndex()));
+    EXPECT_EQ(multiplexer.GetNodeCount(), kNodeCount - 1);
+    EXPECT_FALSE(multiplexer.GetStore().HasNode(ScopedNodeId(1, GetAliceFabricIndex())));
+
+    multiplexer.Shutdown();
+    EXPECT_EQ(multiplexer.GetNodeCount(), 0u);
+    EXPECT_EQ(multiplexer.GetTimerScheduler().GetPendingTimerCount(), 0u);
+    DrainAndServiceIO();
+}
+
+TEST_F(TestSubscriptionMultiplexer, TestResubscriptionsArePaced)
+{
+    MultiplexerCallback callback;
+    SubscriptionMultiplexer multiplexer(InteractionModelEngine::GetInstance(), callback);
+    SubscriptionMultiplexer::Params params = DefaultParams();
+    ASSERT_EQ(multiplexer.Init(params), CHIP_NO_ERROR);
+
+    ASSERT_EQ(AddNodes(multiplexer, kNodeCount), CHIP_NO_ERROR);
+    ASSERT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == kNodeCount; }, System::Clock::Seconds16(10)));
+
+    // Cut the network: the liveness timeouts of the nodes expire, several in each wakeup of the shared scheduler, and
+    // none of them may retry at the same time as another.
+    GetLoopback().mNumMessagesToDrop = LoopbackTransport::kUnlimitedMessageCount;
+    EXPECT_TRUE(AdvanceUntil([&] { return callback.mResubscribeAt.size() == kNodeCount; }, System::Clock::Seconds16(30)));
+
+    std::vector<System::Clock::Timestamp> attempts;
+    for (const auto & entry : callback.mResubscribeAt)
+    {
+        attempts.push_back(entry.second);
+    }
+    std::sort(attempts.begin(), attempts.end());
+    for (size_t i = 1; i < attempts.size(); i++)
+    {
+        EXPECT_GE(attempts[i] - attempts[i - 1], SubscribeInterval(params));
+    }
+
+    // Once the network is back, every node recovers its subscription.
+    GetLoopback().mNumMessagesToDrop = 0;
+    EXPECT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == kNodeCount; }, System::Clock::Seconds16(60)));
+    EXPECT_EQ(callback.mTerminatedCount, 0u);
+
+    multiplexer.Shutdown();
+    DrainAndServiceIO();
+}
+
+TEST_F(TestSubscriptionMultiplexer, TestStoreFailureInvalidatesDataVersion)
+{
+    MultiplexerCallback callback;
+    SubscriptionMultiplexer multiplexer(InteractionModelEngine::GetInstance(), callback);
+    ASSERT_EQ(multiplexer.Init(DefaultParams()), CHIP_NO_ERROR);
+
+    // The failing attribute is neither the first nor the last one reported for the cluster.
+    const ConcreteAttributePath failingPath(kMockEndpoint3, MockClusterId(2), MockAttributeId(2));
+    const ScopedNodeId node(1, GetAliceFabricIndex());
+    SharedAttributeStore & store = SubscriptionMultiplexerTestAccess::GetStore(multiplexer);
+    store.SetFailingAttributeForTesting(MakeOptional(failingPath));
+
+    ASSERT_EQ(AddNodes(multiplexer, 1), CHIP_NO_ERROR);
+    ASSERT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == 1; }, System::Clock::Seconds16(10)));
+
+    // The attributes reported after the failing one are stored, but the cluster version is not.
+    TLV::TLVReader reader;
+    Optional<DataVersion> version;
+    EXPECT_EQ(store.Get(node, failingPath, reader), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(store.Get(node, ConcreteAttributePath(kMockEndpoint3, MockClusterId(2), MockAttributeId(3)), reader),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetDataVersion(node, kSubscribedCluster, version), CHIP_NO_ERROR);
+    EXPECT_FALSE(version.HasValue());
+
+    // Nor is the version of a later report carrying only another attribute of the cluster.
+    store.SetFailingAttributeForTesting(NullOptional);
+    BumpVersion();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(
+        AttributePathParams(kMockEndpoint3, MockClusterId(2), MockAttributeId(1)));
+    callback.mReportCount.clear();
+    EXPECT_TRUE(AdvanceUntil([&] { return callback.mReportCount.size() == 1; }, System::Clock::Seconds16(5)));
+    EXPECT_EQ(store.GetDataVersion(node, kSubscribedCluster, version), CHIP_NO_ERROR);
+    EXPECT_FALSE(version.HasValue());
+
+    // Once the cluster has been reported whole again by a new subscription, its version is committed.
+    GetLoopback().mNumMessagesToDrop = LoopbackTransport::kUnlimitedMessageCount;
+    EXPECT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == 0; }, System::Clock::Seconds16(30)));
+    GetLoopback().mNumMessagesToDrop = 0;
+    EXPECT_TRUE(AdvanceUntil([&] { return multiplexer.GetActiveSubscriptionCount() == 1; }, System::Clock::Seconds16(60)));
+    EXPECT_EQ(store.Get(node, failingPath, reader), CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetDataVersion(node, kSubscribedCluster, version), CHIP_NO_ERROR);
+    EXPECT_EQ(version, MakeOptional<DataVersion>(kTestDataVersion1 + 1));
+
+    multiplexer.Shutdown();
+    DrainAndServiceIO();
+}
+
+} // namespace
@@ -84,6 +84,9 @@ public:
 
     void TestWriteClient();
     void TestWriteClientGroup();
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    void TestWriteClientLargePayloadList();
+#endif
     void TestWriteHandlerReceiveInvalidMessage();
     void TestWriteInvalidMessage1();
     void TestWriteInvalidMessage2();
@@ -286,6 +289,36 @@ TEST_F_FROM_FIXTURE(TestWriteInteraction, TestWriteClientGroup)
     EXPECT_EQ(writeClient.mState, WriteClient::State::AwaitingDestruction);
 }
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+TEST_F_FROM_FIXTURE(TestWriteInteraction, TestWriteClientLargePayloadList)
+{
+    constexpr size_t kListLength = 300;
+    uint32_t values[kListLength];
+    for (size_t i = 0; i < kListLength; i++)
+    {
+        values[i] = static_cast<uint32_t>(i);
+    }
+    AttributePathParams attributePathParams(1 /* endpoint */, 3 /* cluster */, 4 /* attribute */);
+
+    TestWriteClientCallback callback;
+
+    // Appending every item with its own path overflows a regular chunk.
+    app::WriteClient regularWriteClient(&GetExchangeManager(), &callback, /* aTimedWriteTimeoutMs = */ NullOptional);
+    EXPECT_EQ(regularWriteClient.EncodeAttribute(attributePathParams, DataModel::List<uint32_t>(values)), CHIP_NO_ERROR);
+    EXPECT_FALSE(regularWriteClient.mChunks.IsNull());
+
+    // A large payload chunk holds the whole list in a single AttributeDataIB.
+    app::WriteClient largeWriteClient(&GetExchangeManager(), &callback, /* aTimedWriteTimeoutMs = */ NullOptional,
+                                      /* aSuppressResponse = */ false, /* aAllowLargePayload = */ true);
+    EXPECT_EQ(largeWriteClient.EncodeAttribute(attributePathParams, DataModel::List<uint32_t>(values)), CHIP_NO_ERROR);
+    EXPECT_TRUE(largeWriteClient.mChunks.IsNull());
+
+    // The loopback session is not over TCP, so it cannot carry the large chunk.
+    EXPECT_FALSE(GetSessionBobToAlice()->AllowsLargePayload());
+    EXPECT_EQ(largeWriteClient.SendWriteRequest(GetSessionBobToAlice()), CHIP_ERROR_INCORRECT_STATE);
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
 TEST_F(TestWriteInteraction, TestWriteHandler)
 {
     using namespace Protocols::InteractionModel;
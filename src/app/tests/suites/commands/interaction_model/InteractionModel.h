@@ -403,8 +403,9 @@ protected:
         while (repeat--)
         {
 
-            mWriteClient = std::make_unique<chip::app::WriteClient>(device->GetExchangeManager(), &mChunkedWriteCallback,
-                                                                    mTimedInteractionTimeoutMs, mSuppressResponse.ValueOr(false));
+            mWriteClient = std::make_unique<chip::app::WriteClient>(
+                device->GetExchangeManager(), &mChunkedWriteCallback, mTimedInteractionTimeoutMs, mSuppressResponse.ValueOr(false),
+                device->GetSecureSession().Value()->AllowsLargePayload());
             VerifyOrReturnError(mWriteClient != nullptr, CHIP_ERROR_NO_MEMORY);
 
             for (uint8_t i = 0; i < pathsConfig.count; i++)
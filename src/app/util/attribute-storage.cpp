@@ -22,6 +22,7 @@
 #include <app/AttributeAccessInterfaceRegistry.h>
 #include <app/AttributePersistenceProvider.h>
 #include <app/CommandHandlerInterfaceRegistry.h>
+#include <app/DataVersionPersistence.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/reporting.h>
 #include <app/util/config.h>
@@ -330,6 +331,11 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+
+        if (DataVersionPersistence * dataVersionPersistence = GetDataVersionPersistence())
+        {
+            dataVersionPersistence->ForgetEndpoint(ep);
+        }
     }
 
     return ep;
@@ -1497,6 +1503,10 @@ void emberAfAttributeChanged(EndpointId endpoint, ClusterId clusterId, Attribute
     else
     {
         (*(version))++;
+        if (DataVersionPersistence * dataVersionPersistence = GetDataVersionPersistence())
+        {
+            dataVersionPersistence->OnDataVersionChanged(ConcreteClusterPath(endpoint, clusterId), *version);
+        }
         ChipLogDetail(DataManagement, "Endpoint %x, Cluster " ChipLogFormatMEI " update version to %" PRIx32, endpoint,
                       ChipLogValueMEI(clusterId), *(version));
     }
@@ -41,6 +41,7 @@
 
 #include <app/AttributeValueEncoder.h>
 #include <app/ConcreteAttributePath.h>
+#include <app/DataVersionPersistence.h>
 #include <app/EventManagement.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPEncoding.h>
@@ -339,6 +340,10 @@ void emberAfAttributeChanged(EndpointId endpoint, ClusterId clusterId, Attribute
                              AttributesChangedListener * listener)
 {
     dataVersion++;
+    if (DataVersionPersistence * dataVersionPersistence = GetDataVersionPersistence())
+    {
+        dataVersionPersistence->OnDataVersionChanged(ConcreteClusterPath(endpoint, clusterId), dataVersion);
+    }
     listener->MarkDirty(AttributePathParams(endpoint, clusterId, attributeId));
 }
 
@@ -583,6 +583,8 @@ void DeviceCommissioner::Shutdown()
         return Loop::Continue;
     });
 
+    mPASEVerifierCache.Clear();
+
     DeviceController::Shutdown();
 }
 
@@ -854,6 +856,7 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
     exchangeCtxt = mSystemState->ExchangeMgr()->NewContext(session.Value(), &device->GetPairing());
     VerifyOrExit(exchangeCtxt != nullptr, err = CHIP_ERROR_INTERNAL);
 
+    device->GetPairing().SetVerifierCache(&mPASEVerifierCache);
     err = device->GetPairing().Pair(*mSystemState->SessionMgr(), params.GetSetupPINCode(), GetLocalMRPConfig(), exchangeCtxt, this);
     SuccessOrExit(err);
 
@@ -1928,6 +1931,8 @@ void DeviceCommissioner::CleanupCommissioning(DeviceProxy * proxy, NodeId nodeId
         CommissioneeDeviceProxy * commissionee = FindCommissioneeDevice(nodeId);
         if (commissionee != nullptr)
         {
+            // The device is commissioned, so its passcode is of no further use: don't keep what PBKDF2 derived from it.
+            commissionee->GetPairing().EraseFromVerifierCache();
             ReleaseCommissioneeDevice(commissionee);
         }
         // Send the callbacks, we're done.
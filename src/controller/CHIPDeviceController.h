@@ -835,6 +835,9 @@ private:
 
     ObjectPool<CommissioneeDeviceProxy, kNumMaxActiveDevices> mCommissioneeDevicePool;
 
+    // PBKDF2 output of recent PASE sessions, so that retrying with the same passcode does not run PBKDF2 again.
+    PASEVerifierCache mPASEVerifierCache;
+
 #if CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY // make this commissioner discoverable
     Protocols::UserDirectedCommissioning::UserDirectedCommissioningServer * mUdcServer = nullptr;
     // mUdcTransportMgr is for insecure communication (ex. user directed commissioning)
@@ -115,6 +115,16 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
 #if CONFIG_DEVICE_LAYER
     ReturnErrorOnFailure(DeviceLayer::PlatformMgr().InitChipStack());
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // The commissioner runs the PBKDF2 of its PASE sessions as background work.  If another controller
+    // already started the background event loop, keep using it.
+    CHIP_ERROR bgErr = DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask();
+    if (bgErr != CHIP_NO_ERROR && bgErr != CHIP_ERROR_INCORRECT_STATE)
+    {
+        ChipLogError(Controller, "Failed to start the background event loop: %" CHIP_ERROR_FORMAT, bgErr.Format());
+    }
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
     stateParams.systemLayer        = &DeviceLayer::SystemLayer();
     stateParams.udpEndPointManager = DeviceLayer::UDPEndPointManager();
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -596,6 +606,9 @@ void DeviceControllerSystemState::Shutdown()
     // Consumers are expected to call PlaformMgr().StopEventLoopTask() before calling
     // DeviceController::Shutdown() in the CONFIG_DEVICE_LAYER configuration
     //
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask();
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
     DeviceLayer::PlatformMgr().Shutdown();
 #endif
 }
@@ -203,6 +203,19 @@ bool ChipCertificateSet::IsCertInTheSet(const ChipCertificateData * cert) const
     return false;
 }
 
+void ChipCertificateSet::UsePreparedPublicKey(const P256PreparedPublicKey & publicKey)
+{
+    const P256PublicKeySpan publicKeySpan(publicKey.Pubkey().ConstBytes());
+
+    for (uint8_t i = 0; i < mCertCount; i++)
+    {
+        if (mCerts[i].mPublicKey.data_equal(publicKeySpan))
+        {
+            mCerts[i].mPreparedPublicKey = &publicKey;
+        }
+    }
+}
+
 CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, ValidationContext & context)
 {
     VerifyOrReturnError(IsCertInTheSet(cert), CHIP_ERROR_INVALID_ARGUMENT);
@@ -241,6 +254,14 @@ CHIP_ERROR VerifyCertSignature(const ChipCertificateData & cert, const ChipCerti
     ReturnErrorOnFailure(signature.SetLength(cert.mSignature.size()));
     memcpy(signature.Bytes(), cert.mSignature.data(), cert.mSignature.size());
 
+#ifndef ENABLE_HSM_ECDSA_VERIFY
+    if (signer.mPreparedPublicKey != nullptr)
+    {
+        return signer.mPreparedPublicKey->ECDSA_validate_hash_signature(cert.mTBSHash, chip::Crypto::kSHA256_Hash_Length,
+                                                                        signature);
+    }
+#endif
+
     memcpy(signerPublicKey, signer.mPublicKey.data(), signer.mPublicKey.size());
 
     ReturnErrorOnFailure(
@@ -479,7 +500,8 @@ void ChipCertificateData::Clear()
     mCertFlags.ClearAll();
     mKeyUsageFlags.ClearAll();
     mKeyPurposeFlags.ClearAll();
-    mSignature = P256ECDSASignatureSpan();
+    mSignature         = P256ECDSASignatureSpan();
+    mPreparedPublicKey = nullptr;
 
     memset(mTBSHash, 0, sizeof(mTBSHash));
 }
@@ -461,6 +461,12 @@ struct ChipCertificateData
     P256ECDSASignatureSpan mSignature;          /**< Certificate signature. */
 
     uint8_t mTBSHash[Crypto::kSHA256_Hash_Length]; /**< Certificate TBS hash. */
+
+    /**
+     * Optional prepared form of mPublicKey, used to verify the signatures made with it. It is not owned by
+     * the certificate data (see ChipCertificateSet::UsePreparedPublicKey()).
+     */
+    const Crypto::P256PreparedPublicKey * mPreparedPublicKey = nullptr;
 };
 
 /**
@@ -222,6 +222,15 @@ public:
      **/
     bool IsCertInTheSet(const ChipCertificateData * cert) const;
 
+    /**
+     * @brief Verify the signatures made with the public key of certificates in the set using a prepared key.
+     *        Applies to the certificates already loaded whose public key matches. The prepared key is
+     *        required to stay valid while the certificate data in the set is used.
+     *
+     * @param publicKey  Prepared public key.
+     **/
+    void UsePreparedPublicKey(const Crypto::P256PreparedPublicKey & publicKey);
+
     /**
      * @brief Validate CHIP certificate.
      *
@@ -31,6 +31,8 @@
 #include <platform/LockTracker.h>
 #include <tracing/macros.h>
 
+#include <algorithm>
+
 namespace chip {
 using namespace Credentials;
 using namespace Crypto;
@@ -109,6 +111,23 @@ exit:
     return err;
 }
 
+// Stable insertion sort of the lookup indexes. The indexes are small and only rebuilt when fabrics are added,
+// updated or removed, and unlike std::stable_sort this never allocates.
+template <typename LessThan>
+void SortSlots(uint8_t * slots, size_t count, LessThan lessThan)
+{
+    for (size_t i = 1; i < count; ++i)
+    {
+        uint8_t slot = slots[i];
+        size_t j     = i;
+        for (; (j > 0) && lessThan(slot, slots[j - 1]); --j)
+        {
+            slots[j] = slots[j - 1];
+        }
+        slots[j] = slot;
+    }
+}
+
 } // anonymous namespace
 
 CHIP_ERROR FabricInfo::Init(const FabricInfo::InitParams & initParams)
@@ -149,7 +168,7 @@ void FabricInfo::operator=(FabricInfo && other)
     mFabricId                = other.mFabricId;
     mFabricIndex             = other.mFabricIndex;
     mCompressedFabricId      = other.mCompressedFabricId;
-    mRootPublicKey           = other.mRootPublicKey;
+    mRootPublicKey           = other.mRootPublicKey.Pubkey();
     mVendorId                = other.mVendorId;
     mShouldAdvertiseIdentity = other.mShouldAdvertiseIdentity;
 
@@ -202,11 +221,11 @@ CHIP_ERROR FabricInfo::LoadFromStorage(PersistentStorageDelegate * storage, Fabr
 
         P256PublicKeySpan rootPubKeySpan;
         ReturnErrorOnFailure(ExtractPublicKeyFromChipCert(rcac, rootPubKeySpan));
-        mRootPublicKey = rootPubKeySpan;
+        mRootPublicKey = P256PublicKey(rootPubKeySpan);
 
         uint8_t compressedFabricIdBuf[sizeof(uint64_t)];
         MutableByteSpan compressedFabricIdSpan(compressedFabricIdBuf);
-        ReturnErrorOnFailure(GenerateCompressedFabricId(mRootPublicKey, mFabricId, compressedFabricIdSpan));
+        ReturnErrorOnFailure(GenerateCompressedFabricId(mRootPublicKey.Pubkey(), mFabricId, compressedFabricIdSpan));
 
         // Decode compressed fabric ID accounting for endianness, as GenerateCompressedFabricId()
         // returns a binary buffer and is agnostic of usage of the output as an integer type.
@@ -378,7 +397,7 @@ CHIP_ERROR FabricInfo::FetchRootPubkey(Crypto::P256PublicKey & outPublicKey) con
 {
     MATTER_TRACE_SCOPE("FetchRootPubKey", "Fabric");
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_KEY_NOT_FOUND);
-    outPublicKey = mRootPublicKey;
+    outPublicKey = mRootPublicKey.Pubkey();
     return CHIP_NO_ERROR;
 }
 
@@ -392,11 +411,23 @@ CHIP_ERROR FabricTable::VerifyCredentials(FabricIndex fabricIndex, const ByteSpa
     uint8_t rootCertBuf[kMaxCHIPCertLength];
     MutableByteSpan rootCertSpan{ rootCertBuf };
     ReturnErrorOnFailure(FetchRootCert(fabricIndex, rootCertSpan));
-    return VerifyCredentials(noc, icac, rootCertSpan, context, outCompressedFabricId, outFabricId, outNodeId, outNocPubkey,
+
+    const FabricInfo * fabricInfo = FindFabricWithIndex(fabricIndex);
+    return VerifyCredentials(noc, icac, rootCertSpan, (fabricInfo != nullptr) ? &fabricInfo->mRootPublicKey : nullptr, context,
+                             outCompressedFabricId, outFabricId, outNodeId, outNocPubkey, outRootPublicKey);
+}
+
+CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                                          ValidationContext & context, CompressedFabricId & outCompressedFabricId,
+                                          FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
+                                          Crypto::P256PublicKey * outRootPublicKey)
+{
+    return VerifyCredentials(noc, icac, rcac, nullptr, context, outCompressedFabricId, outFabricId, outNodeId, outNocPubkey,
                              outRootPublicKey);
 }
 
 CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                                          const Crypto::P256PreparedPublicKey * preparedRootPublicKey,
                                           ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                           FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                           Crypto::P256PublicKey * outRootPublicKey)
@@ -419,6 +450,11 @@ CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan &
 
     ReturnErrorOnFailure(certificates.LoadCert(noc, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
 
+    if (preparedRootPublicKey != nullptr)
+    {
+        certificates.UsePreparedPublicKey(*preparedRootPublicKey);
+    }
+
     const ChipDN & nocSubjectDN              = certificates.GetLastCert()[0].mSubjectDN;
     const CertificateKeyId & nocSubjectKeyId = certificates.GetLastCert()[0].mSubjectKeyId;
 
@@ -506,19 +542,16 @@ const FabricInfo * FabricTable::FindFabricCommon(const Crypto::P256PublicKey & r
         }
     }
 
-    for (auto & fabric : mStates)
-    {
-        auto matchingNodeId = (nodeId == kUndefinedNodeId) ? fabric.GetNodeId() : nodeId;
+    const uint8_t * slotsEnd = &mSlotsByRootKeyAndFabricId[mIndexedFabricCount];
+    const uint8_t * slot =
+        std::lower_bound(&mSlotsByRootKeyAndFabricId[0], slotsEnd, fabricId, [&](uint8_t candidate, FabricId) {
+            return CompareRootKeyAndFabricId(mStates[candidate], rootPubKey, fabricId) < 0;
+        });
 
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-        if (fabric.FetchRootPubkey(candidatePubKey) != CHIP_NO_ERROR)
-        {
-            continue;
-        }
-        if (rootPubKey.Matches(candidatePubKey) && fabricId == fabric.GetFabricId() && matchingNodeId == fabric.GetNodeId())
+    for (; (slot != slotsEnd) && (CompareRootKeyAndFabricId(mStates[*slot], rootPubKey, fabricId) == 0); ++slot)
+    {
+        const FabricInfo & fabric = mStates[*slot];
+        if ((nodeId == kUndefinedNodeId) || (nodeId == fabric.GetNodeId()))
         {
             return &fabric;
         }
@@ -535,20 +568,8 @@ FabricInfo * FabricTable::GetMutableFabricByIndex(FabricIndex fabricIndex)
         return &mPendingFabric;
     }
 
-    for (auto & fabric : mStates)
-    {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-
-        if (fabric.GetFabricIndex() == fabricIndex)
-        {
-            return &fabric;
-        }
-    }
-
-    return nullptr;
+    size_t slot = FindSlotWithFabricIndex(fabricIndex);
+    return (slot < ArraySize(mStates)) ? &mStates[slot] : nullptr;
 }
 
 const FabricInfo * FabricTable::FindFabricWithIndex(FabricIndex fabricIndex) const
@@ -564,20 +585,8 @@ const FabricInfo * FabricTable::FindFabricWithIndex(FabricIndex fabricIndex) con
         return &mPendingFabric;
     }
 
-    for (const auto & fabric : mStates)
-    {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-
-        if (fabric.GetFabricIndex() == fabricIndex)
-        {
-            return &fabric;
-        }
-    }
-
-    return nullptr;
+    size_t slot = FindSlotWithFabricIndex(fabricIndex);
+    return (slot < ArraySize(mStates)) ? &mStates[slot] : nullptr;
 }
 
 const FabricInfo * FabricTable::FindFabricWithCompressedId(CompressedFabricId compressedFabricId) const
@@ -588,19 +597,66 @@ const FabricInfo * FabricTable::FindFabricWithCompressedId(CompressedFabricId co
         return &mPendingFabric;
     }
 
-    for (auto & fabric : mStates)
+    const uint8_t * slotsEnd = &mSlotsByCompressedFabricId[mIndexedFabricCount];
+    const uint8_t * slot =
+        std::lower_bound(&mSlotsByCompressedFabricId[0], slotsEnd, compressedFabricId,
+                         [this](uint8_t candidate, CompressedFabricId id) { return mStates[candidate].GetCompressedFabricId() < id; });
+
+    if ((slot != slotsEnd) && (mStates[*slot].GetCompressedFabricId() == compressedFabricId))
     {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
+        return &mStates[*slot];
+    }
+    return nullptr;
+}
+
+size_t FabricTable::FindSlotWithFabricIndex(FabricIndex fabricIndex) const
+{
+    const uint8_t * slotsEnd = &mSlotsByFabricIndex[mIndexedFabricCount];
+    const uint8_t * slot =
+        std::lower_bound(&mSlotsByFabricIndex[0], slotsEnd, fabricIndex,
+                         [this](uint8_t candidate, FabricIndex index) { return mStates[candidate].GetFabricIndex() < index; });
 
-        if (compressedFabricId == fabric.GetPeerId().GetCompressedFabricId())
+    if ((slot != slotsEnd) && (mStates[*slot].GetFabricIndex() == fabricIndex))
+    {
+        return *slot;
+    }
+    return ArraySize(mStates);
+}
+
+int FabricTable::CompareRootKeyAndFabricId(const FabricInfo & fabric, const Crypto::P256PublicKey & rootPubKey, FabricId fabricId)
+{
+    if (fabric.GetFabricId() != fabricId)
+    {
+        return (fabric.GetFabricId() < fabricId) ? -1 : 1;
+    }
+    return memcmp(fabric.mRootPublicKey.Pubkey().ConstBytes(), rootPubKey.ConstBytes(), rootPubKey.Length());
+}
+
+void FabricTable::RebuildLookupIndexes()
+{
+    static_assert(CHIP_CONFIG_MAX_FABRICS <= UINT8_MAX, "Slots must fit in the lookup indexes");
+
+    mIndexedFabricCount = 0;
+    for (uint8_t slot = 0; slot < ArraySize(mStates); ++slot)
+    {
+        if (mStates[slot].IsInitialized())
         {
-            return &fabric;
+            mSlotsByFabricIndex[mIndexedFabricCount]        = slot;
+            mSlotsByCompressedFabricId[mIndexedFabricCount] = slot;
+            mSlotsByRootKeyAndFabricId[mIndexedFabricCount] = slot;
+            ++mIndexedFabricCount;
         }
     }
-    return nullptr;
+
+    // Slots start out in increasing order and the sorts are stable, so ties stay ordered by position.
+    SortSlots(mSlotsByFabricIndex, mIndexedFabricCount,
+              [this](uint8_t a, uint8_t b) { return mStates[a].GetFabricIndex() < mStates[b].GetFabricIndex(); });
+    SortSlots(mSlotsByCompressedFabricId, mIndexedFabricCount, [this](uint8_t a, uint8_t b) {
+        return mStates[a].GetCompressedFabricId() < mStates[b].GetCompressedFabricId();
+    });
+    SortSlots(mSlotsByRootKeyAndFabricId, mIndexedFabricCount, [this](uint8_t a, uint8_t b) {
+        return CompareRootKeyAndFabricId(mStates[a], mStates[b].mRootPublicKey.Pubkey(), mStates[b].GetFabricId()) < 0;
+    });
 }
 
 CHIP_ERROR FabricTable::FetchRootCert(FabricIndex fabricIndex, MutableByteSpan & outCert) const
@@ -908,7 +964,13 @@ FabricTable::AddOrUpdateInner(FabricIndex fabricIndex, bool isAddition, Crypto::
     newFabricInfo.advertiseIdentity = (advertiseIdentity == AdvertiseIdentity::Yes);
 
     // Update local copy of fabric data. For add it's a new entry, for update, it's `mPendingFabric` shadow entry.
-    ReturnErrorOnFailure(fabricEntry->Init(newFabricInfo));
+    CHIP_ERROR initErr = fabricEntry->Init(newFabricInfo);
+    if (isAddition)
+    {
+        // Even a failed Init may have changed the entry, so index it either way.
+        RebuildLookupIndexes();
+    }
+    ReturnErrorOnFailure(initErr);
 
     // Set the label, matching add/update semantics of empty/existing.
     fabricEntry->SetFabricLabel(fabricLabel);
@@ -1011,6 +1073,7 @@ CHIP_ERROR FabricTable::Delete(FabricIndex fabricIndex)
 
     // Since fabricIsInitialized was true, fabric is not null.
     fabricInfo->Reset();
+    RebuildLookupIndexes();
 
     if (!mNextAvailableFabricIndex.HasValue())
     {
@@ -1089,6 +1152,7 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     {
         fabric.Reset();
     }
+    RebuildLookupIndexes();
     mNextAvailableFabricIndex.SetValue(kMinValidFabricIndex);
 
     // Init failure of Last Known Good Time is non-fatal.  If Last Known Good
@@ -1112,6 +1176,8 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
 
         // TODO: A safer way would be to just clean-up the entire fabric table on this situation...
         err = ReadFabricInfo(reader);
+        // Index whatever was loaded, even on error, so lookups agree with the contents of the table.
+        RebuildLookupIndexes();
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(FabricProvisioning, "Error loading fabric table: %" CHIP_ERROR_FORMAT ", we are in a bad state!",
@@ -1153,6 +1219,7 @@ void FabricTable::Forget(FabricIndex fabricIndex)
 
     RevertPendingFabricData();
     fabricInfo->Reset();
+    RebuildLookupIndexes();
 }
 
 void FabricTable::Shutdown()
@@ -1176,6 +1243,7 @@ void FabricTable::Shutdown()
         // direct lookups fail.
         fabricInfo.Reset();
     }
+    RebuildLookupIndexes();
 
     mStorage = nullptr;
 }
@@ -1946,6 +2014,7 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
             // Commit the pending entry to local in-memory fabric metadata, which
             // also moves operational keys if not backed by OperationalKeystore
             *existingFabricToUpdate = std::move(mPendingFabric);
+            RebuildLookupIndexes();
         }
 
         // Store pending metadata first
@@ -228,8 +228,9 @@ private:
     FabricId mFabricId = kUndefinedFabricId;
     // We cache the compressed fabric id since it's used so often and costly to get.
     CompressedFabricId mCompressedFabricId = kUndefinedCompressedFabricId;
-    // We cache the root public key since it's used so often and costly to get.
-    Crypto::P256PublicKey mRootPublicKey;
+    // We cache the root public key since it's used so often and costly to get. It is kept prepared for
+    // verifying the signatures of the certificates it issued.
+    Crypto::P256PreparedPublicKey mRootPublicKey;
 
     // mFabricLabel is 33 bytes, so ends on a 1 mod 4 byte boundary.
     char mFabricLabel[kFabricLabelMaxLengthInBytes + 1] = { '\0' };
@@ -1092,6 +1093,20 @@ private:
      */
     FabricInfo * GetMutableFabricByIndex(FabricIndex fabricIndex);
 
+    /**
+     * @brief Rebuild the lookup indexes over `mStates`.
+     *
+     * Must be called whenever an entry of `mStates` is initialized, reset or replaced, before the next lookup.
+     */
+    void RebuildLookupIndexes();
+
+    // Returns the position in `mStates` of the (non-pending) fabric with the given index, or
+    // CHIP_CONFIG_MAX_FABRICS if there is none.
+    size_t FindSlotWithFabricIndex(FabricIndex fabricIndex) const;
+
+    // Orders fabrics by fabric ID, then by root public key. Returns <0, 0 or >0 like memcmp.
+    static int CompareRootKeyAndFabricId(const FabricInfo & fabric, const Crypto::P256PublicKey & rootPubKey, FabricId fabricId);
+
     // Load a FabricInfo metatada item from storage for a given new fabric index. Returns internal error on failure.
     CHIP_ERROR LoadFromStorage(FabricInfo * fabric, FabricIndex newFabricIndex);
 
@@ -1186,6 +1201,14 @@ private:
                                                NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                                Crypto::P256PublicKey & outRootPubkey);
 
+    // Verifies credentials, using the provided root certificate. The signatures made with the root key are verified
+    // with `preparedRootPublicKey` if it is not null and matches the root certificate.
+    static CHIP_ERROR VerifyCredentials(const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                                        const Crypto::P256PreparedPublicKey * preparedRootPublicKey,
+                                        Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
+                                        FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
+                                        Crypto::P256PublicKey * outRootPublicKey);
+
     /**
      * Read our fabric index info from the given TLV reader and set up the
      * fabric table accordingly.
@@ -1200,6 +1223,13 @@ private:
     CHIP_ERROR GetCommitMarker(CommitMarker & outCommitMarker);
 
     FabricInfo mStates[CHIP_CONFIG_MAX_FABRICS];
+    // Positions in `mStates` of the initialized entries, sorted by fabric index, by compressed fabric ID and by
+    // <fabric ID, root public key> respectively, so that lookups are binary searches instead of scans of every
+    // entry. Ties are ordered by position, so a lookup returns the same entry a scan of `mStates` would.
+    uint8_t mSlotsByFabricIndex[CHIP_CONFIG_MAX_FABRICS];
+    uint8_t mSlotsByCompressedFabricId[CHIP_CONFIG_MAX_FABRICS];
+    uint8_t mSlotsByRootKeyAndFabricId[CHIP_CONFIG_MAX_FABRICS];
+    uint8_t mIndexedFabricCount = 0;
     // Used for UpdateNOC pending fabric updates
     FabricInfo mPendingFabric;
     PersistentStorageDelegate * mStorage                    = nullptr;
@@ -567,6 +567,51 @@ TEST_F(TestChipCert, TestChipCert_CertValidation)
     }
 }
 
+TEST_F(TestChipCert, TestChipCert_CertValidationWithPreparedKey)
+{
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    const ChipCertificateData * resultCert = nullptr;
+
+    ByteSpan rootPublicKeySpan;
+    ASSERT_EQ(GetTestCertPubkey(TestCert::kRoot01, rootPublicKeySpan), CHIP_NO_ERROR);
+    ASSERT_EQ(rootPublicKeySpan.size(), Crypto::kP256_PublicKey_Length);
+    P256PreparedPublicKey rootPublicKey(P256PublicKey(P256PublicKeySpan(rootPublicKeySpan.data())));
+
+    ByteSpan otherPublicKeySpan;
+    ASSERT_EQ(GetTestCertPubkey(TestCert::kRoot02, otherPublicKeySpan), CHIP_NO_ERROR);
+    P256PreparedPublicKey otherPublicKey(P256PublicKey(P256PublicKeySpan(otherPublicKeySpan.data())));
+
+    ASSERT_EQ(certSet.Init(kStandardCertsCount), CHIP_NO_ERROR);
+    ASSERT_EQ(LoadTestCertSet01(certSet), CHIP_NO_ERROR);
+
+    // Only the certificates with the same public key use a prepared key.
+    certSet.UsePreparedPublicKey(otherPublicKey);
+    certSet.UsePreparedPublicKey(rootPublicKey);
+    EXPECT_EQ(certSet.GetCertSet()[0].mPreparedPublicKey, &rootPublicKey);
+    EXPECT_EQ(certSet.GetCertSet()[1].mPreparedPublicKey, nullptr);
+    EXPECT_EQ(certSet.GetCertSet()[2].mPreparedPublicKey, nullptr);
+
+    // Validate the chain more than once, so that the prepared key is reused.
+    for (int i = 0; i < 2; i++)
+    {
+        validContext.Reset();
+        EXPECT_EQ(SetCurrentTime(validContext, 2021, 1, 1), CHIP_NO_ERROR);
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+
+        EXPECT_EQ(certSet.FindValidCert(certSet.GetLastCert()->mSubjectDN, certSet.GetLastCert()->mSubjectKeyId, validContext,
+                                        &resultCert),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(resultCert, certSet.GetLastCert());
+        EXPECT_EQ(validContext.mTrustAnchor, &certSet.GetCertSet()[0]);
+    }
+
+    EXPECT_EQ(VerifyCertSignature(certSet.GetCertSet()[1], certSet.GetCertSet()[0]), CHIP_NO_ERROR);
+    EXPECT_NE(VerifyCertSignature(certSet.GetCertSet()[2], certSet.GetCertSet()[0]), CHIP_NO_ERROR);
+
+    certSet.Release();
+}
+
 TEST_F(TestChipCert, TestChipCert_CertValidTime)
 {
     CHIP_ERROR err;
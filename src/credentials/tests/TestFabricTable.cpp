@@ -2368,6 +2368,103 @@ TEST_F(TestFabricTable, TestFabricLookup)
     }
 }
 
+TEST_F(TestFabricTable, TestFabricLookupWithFullTable)
+{
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthorities[2];
+    Crypto::P256PublicKey rootPublicKeys[2];
+
+    for (size_t i = 0; i < ArraySize(fabricCertAuthorities); ++i)
+    {
+        auto & fabricCertAuthority = fabricCertAuthorities[i];
+        ASSERT_TRUE(fabricCertAuthority.Init().IsSuccess());
+
+        P256PublicKeySpan rootPublicKeySpan;
+        ASSERT_EQ(ExtractPublicKeyFromChipCert(fabricCertAuthority.GetRcac(), rootPublicKeySpan), CHIP_NO_ERROR);
+        rootPublicKeys[i] = Crypto::P256PublicKey(rootPublicKeySpan);
+    }
+
+    // Fabric IDs out of insertion order, each used once per root, so that the lookup indexes have work to do.
+    auto rootForFabric     = [](size_t i) { return i % 2; };
+    auto fabricIdForFabric = [](size_t i) -> FabricId { return 1000 + ((i / 2) * 7) % 23 + (i / 2 / 23) * 23; };
+    auto nodeIdForFabric   = [](size_t i) -> NodeId { return 100 + i; };
+
+    constexpr uint16_t kVendorId = 0xFFF1u;
+    chip::TestPersistentStorageDelegate storage;
+
+    auto checkLookups = [&](FabricTable & fabricTable, size_t deletedFabric) {
+        for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+        {
+            FabricIndex fabricIndex    = static_cast<FabricIndex>(i + 1);
+            const auto & rootPublicKey = rootPublicKeys[rootForFabric(i)];
+
+            const FabricInfo * fabricInfo = fabricTable.FindFabricWithIndex(fabricIndex);
+            if (i == deletedFabric)
+            {
+                EXPECT_EQ(fabricInfo, nullptr);
+                EXPECT_EQ(fabricTable.FindFabric(rootPublicKey, fabricIdForFabric(i)), nullptr);
+                continue;
+            }
+
+            ASSERT_NE(fabricInfo, nullptr);
+            EXPECT_EQ(fabricInfo->GetFabricIndex(), fabricIndex);
+            EXPECT_EQ(fabricInfo->GetFabricId(), fabricIdForFabric(i));
+            EXPECT_EQ(fabricInfo->GetNodeId(), nodeIdForFabric(i));
+
+            EXPECT_EQ(fabricTable.FindFabric(rootPublicKey, fabricIdForFabric(i)), fabricInfo);
+            EXPECT_EQ(fabricTable.FindIdentity(rootPublicKey, fabricIdForFabric(i), nodeIdForFabric(i)), fabricInfo);
+            EXPECT_EQ(fabricTable.FindIdentity(rootPublicKey, fabricIdForFabric(i), nodeIdForFabric(i) + 1), nullptr);
+            EXPECT_EQ(fabricTable.FindFabricWithCompressedId(fabricInfo->GetCompressedFabricId()), fabricInfo);
+        }
+
+        EXPECT_EQ(fabricTable.FindFabric(rootPublicKeys[0], 999), nullptr);
+        EXPECT_EQ(fabricTable.FindFabricWithIndex(CHIP_CONFIG_MAX_FABRICS + 1), nullptr);
+        EXPECT_EQ(fabricTable.FindFabricWithCompressedId(0), nullptr);
+    };
+
+    // First scope: fill the table, then delete one fabric in the middle.
+    {
+        ScopedFabricTable fabricTableHolder;
+        EXPECT_EQ(fabricTableHolder.Init(&storage), CHIP_NO_ERROR);
+        FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+
+        for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+        {
+            auto & fabricCertAuthority = fabricCertAuthorities[rootForFabric(i)];
+
+            uint8_t csrBuf[chip::Crypto::kMIN_CSR_Buffer_Size];
+            MutableByteSpan csrSpan{ csrBuf };
+            EXPECT_EQ(fabricTable.AllocatePendingOperationalKey(chip::NullOptional, csrSpan), CHIP_NO_ERROR);
+            EXPECT_EQ(fabricCertAuthority.SetIncludeIcac(false)
+                          .GenerateNocChain(fabricIdForFabric(i), nodeIdForFabric(i), csrSpan)
+                          .GetStatus(),
+                      CHIP_NO_ERROR);
+
+            EXPECT_EQ(fabricTable.AddNewPendingTrustedRootCert(fabricCertAuthority.GetRcac()), CHIP_NO_ERROR);
+            FabricIndex newFabricIndex = kUndefinedFabricIndex;
+            EXPECT_EQ(fabricTable.AddNewPendingFabricWithOperationalKeystore(fabricCertAuthority.GetNoc(), ByteSpan{}, kVendorId,
+                                                                             &newFabricIndex),
+                      CHIP_NO_ERROR);
+            EXPECT_EQ(newFabricIndex, i + 1);
+            EXPECT_EQ(fabricTable.CommitPendingFabricData(), CHIP_NO_ERROR);
+        }
+        EXPECT_EQ(fabricTable.FabricCount(), CHIP_CONFIG_MAX_FABRICS);
+        checkLookups(fabricTable, CHIP_CONFIG_MAX_FABRICS);
+
+        EXPECT_EQ(fabricTable.Delete(CHIP_CONFIG_MAX_FABRICS / 2 + 1), CHIP_NO_ERROR);
+        checkLookups(fabricTable, CHIP_CONFIG_MAX_FABRICS / 2);
+    }
+
+    // Second scope: the reloaded table has the same fabrics.
+    {
+        ScopedFabricTable fabricTableHolder;
+        EXPECT_EQ(fabricTableHolder.Init(&storage), CHIP_NO_ERROR);
+        FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+
+        EXPECT_EQ(fabricTable.FabricCount(), CHIP_CONFIG_MAX_FABRICS - 1);
+        checkLookups(fabricTable, CHIP_CONFIG_MAX_FABRICS / 2);
+    }
+}
+
 TEST_F(TestFabricTable, ShouldFailSetFabricIndexWithInvalidIndex)
 {
     chip::TestPersistentStorageDelegate testStorage;
@@ -612,6 +612,27 @@ CHIP_ERROR Spake2pVerifier::ComputeWS(uint32_t pbkdf2IterCount, const ByteSpan &
                                 pbkdf2IterCount, ws_len, ws);
 }
 
+CHIP_ERROR P256PreparedPublicKey::ECDSA_validate_msg_signature(const uint8_t * msg, size_t msg_length,
+                                                               const P256ECDSASignature & signature) const
+{
+    VerifyOrReturnError((msg != nullptr) && (msg_length > 0), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t digest[kSHA256_Hash_Length];
+    ReturnErrorOnFailure(Hash_SHA256(msg, msg_length, &digest[0]));
+    return ECDSA_validate_hash_signature(&digest[0], sizeof(digest), signature);
+}
+
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+// Crypto PALs that don't prepare public keys verify as P256PublicKey does.
+CHIP_ERROR P256PreparedPublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, size_t hash_length,
+                                                                const P256ECDSASignature & signature) const
+{
+    return mPublicKey.ECDSA_validate_hash_signature(hash, hash_length, signature);
+}
+
+void P256PreparedPublicKey::Release() const {}
+#endif // !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+
 CHIP_ERROR ReadDerLength(Reader & reader, size_t & length)
 {
     length = 0;
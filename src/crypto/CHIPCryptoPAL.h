@@ -437,6 +437,56 @@ private:
     uint8_t bytes[kP256_PublicKey_Length];
 };
 
+/**
+ * @brief A P256 public key prepared for verifying many signatures.
+ *
+ * P256PublicKey decodes and checks its point for every signature it verifies. P256PreparedPublicKey does
+ * it on the first verification and keeps the result until the key is changed or the object is destroyed,
+ * which pays off for keys that verify signatures repeatedly, such as the root CA key of a fabric. With
+ * crypto PALs that don't implement the preparation, verifications cost the same as with P256PublicKey.
+ *
+ * Verifications may update the prepared state, so an instance must not be used from several threads at
+ * the same time.
+ */
+class P256PreparedPublicKey
+{
+public:
+    P256PreparedPublicKey() = default;
+    explicit P256PreparedPublicKey(const P256PublicKey & publicKey) : mPublicKey(publicKey) {}
+    ~P256PreparedPublicKey() { Release(); }
+
+    P256PreparedPublicKey(const P256PreparedPublicKey &)             = delete;
+    P256PreparedPublicKey & operator=(const P256PreparedPublicKey &) = delete;
+
+    /**
+     * @brief Set the public key, releasing the state prepared for the previous one.
+     */
+    P256PreparedPublicKey & operator=(const P256PublicKey & publicKey)
+    {
+        Release();
+        mPublicKey = publicKey;
+        return *this;
+    }
+
+    const P256PublicKey & Pubkey() const { return mPublicKey; }
+
+    /**
+     * @brief Same as P256PublicKey::ECDSA_validate_msg_signature().
+     */
+    CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, size_t msg_length, const P256ECDSASignature & signature) const;
+
+    /**
+     * @brief Same as P256PublicKey::ECDSA_validate_hash_signature().
+     */
+    CHIP_ERROR ECDSA_validate_hash_signature(const uint8_t * hash, size_t hash_length, const P256ECDSASignature & signature) const;
+
+private:
+    void Release() const;
+
+    P256PublicKey mPublicKey;
+    mutable void * mPrepared = nullptr;
+};
+
 template <typename PK, typename Secret, typename Sig>
 class ECPKeypair
 {
@@ -651,11 +701,38 @@ class Symmetric128BitsKeyHandle : public SymmetricKeyHandle<CHIP_CRYPTO_SYMMETRI
 {
 };
 
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+class AesCcmContextCache;
+#endif
+
 /**
  * @brief Platform-specific 128-bit AES key handle
+ *
+ * On OpenSSL and BoringSSL builds, the handle also holds the cipher contexts prepared by AES_CCM_encrypt()
+ * and AES_CCM_decrypt() for its key, so the key schedule is expanded once instead of for every message.
+ * The contexts are created on first use, re-created if the key material changes, and released when the
+ * key is destroyed by the keystore or when the handle goes away. A handle must not be used from several
+ * threads at the same time.
  */
 class Aes128KeyHandle final : public Symmetric128BitsKeyHandle
 {
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+public:
+    Aes128KeyHandle() = default;
+    ~Aes128KeyHandle() { ReleaseCipherContexts(); }
+
+    /**
+     * @brief Release the cipher contexts prepared for the key, if any.
+     *
+     * Keystores call this before writing new key material into the handle.
+     */
+    void ReleaseCipherContexts() const;
+
+private:
+    friend class AesCcmContextCache;
+
+    mutable AesCcmContextCache * mCipherContexts = nullptr;
+#endif // CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
 };
 
 /**
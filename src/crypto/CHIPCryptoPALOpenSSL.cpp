@@ -48,6 +48,7 @@
 #include <lib/support/BufferWriter.h>
 #include <lib/support/BytesToHex.h>
 #include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/SafePointerCast.h>
@@ -146,19 +147,187 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
+/**
+ * Cipher contexts prepared for the key of an Aes128KeyHandle.
+ *
+ * The cipher, nonce length, tag length and key are set once when a context is prepared; every message then
+ * only passes in its nonce. A copy of the key is kept so that handles whose key material is overwritten in
+ * place (e.g. restored from storage) get new contexts instead of stale ones.
+ */
+class AesCcmContextCache
+{
+public:
+    explicit AesCcmContextCache(const Symmetric128BitsKeyByteArray & key) { memcpy(mKey, key, sizeof(mKey)); }
+    ~AesCcmContextCache();
+
+    /**
+     * Returns the cache of the given handle, creating it if needed, or nullptr if out of memory.
+     */
+    static AesCcmContextCache * Get(const Aes128KeyHandle & key);
+
+#if CHIP_CRYPTO_BORINGSSL
+    CHIP_ERROR GetContext(size_t tag_length, EVP_AEAD_CTX *& context);
+#else
+    CHIP_ERROR GetEncryptContext(int nonce_length, int tag_length, EVP_CIPHER_CTX *& context)
+    {
+        return GetContext(mEncrypt, 1, nonce_length, tag_length, context);
+    }
+    CHIP_ERROR GetDecryptContext(int nonce_length, int tag_length, EVP_CIPHER_CTX *& context)
+    {
+        return GetContext(mDecrypt, 0, nonce_length, tag_length, context);
+    }
+
+    /**
+     * Frees a context left in an unknown state by a failed operation. It is prepared again on next use.
+     */
+    void Discard(EVP_CIPHER_CTX * context);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+private:
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX * mContext = nullptr;
+    size_t mTagLength       = 0;
+#else
+    struct PreparedContext
+    {
+        EVP_CIPHER_CTX * context = nullptr;
+        int nonce_length         = 0;
+        int tag_length           = 0;
+    };
+
+    CHIP_ERROR GetContext(PreparedContext & prepared, int enc, int nonce_length, int tag_length, EVP_CIPHER_CTX *& context);
+
+    PreparedContext mEncrypt;
+    PreparedContext mDecrypt;
+#endif // CHIP_CRYPTO_BORINGSSL
+    Symmetric128BitsKeyByteArray mKey;
+};
+
+void Aes128KeyHandle::ReleaseCipherContexts() const
+{
+    Platform::Delete(mCipherContexts);
+    mCipherContexts = nullptr;
+}
+
+AesCcmContextCache::~AesCcmContextCache()
+{
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(mContext);
+#else
+    EVP_CIPHER_CTX_free(mEncrypt.context);
+    EVP_CIPHER_CTX_free(mDecrypt.context);
+#endif // CHIP_CRYPTO_BORINGSSL
+    ClearSecretData(mKey);
+}
+
+AesCcmContextCache * AesCcmContextCache::Get(const Aes128KeyHandle & key)
+{
+    const Symmetric128BitsKeyByteArray & keyBytes = key.As<Symmetric128BitsKeyByteArray>();
+
+    if (key.mCipherContexts != nullptr && CRYPTO_memcmp(key.mCipherContexts->mKey, keyBytes, sizeof(keyBytes)) != 0)
+    {
+        key.ReleaseCipherContexts();
+    }
+
+    if (key.mCipherContexts == nullptr)
+    {
+        key.mCipherContexts = Platform::New<AesCcmContextCache>(keyBytes);
+    }
+
+    return key.mCipherContexts;
+}
+
+#if CHIP_CRYPTO_BORINGSSL
+CHIP_ERROR AesCcmContextCache::GetContext(size_t tag_length, EVP_AEAD_CTX *& context)
+{
+    if (mContext == nullptr || mTagLength != tag_length)
+    {
+        EVP_AEAD_CTX_free(mContext);
+        mContext = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), mKey, sizeof(mKey), tag_length);
+        VerifyOrReturnError(mContext != nullptr, CHIP_ERROR_NO_MEMORY);
+        mTagLength = tag_length;
+    }
+
+    context = mContext;
+    return CHIP_NO_ERROR;
+}
+#else
+CHIP_ERROR AesCcmContextCache::GetContext(PreparedContext & prepared, int enc, int nonce_length, int tag_length,
+                                          EVP_CIPHER_CTX *& context)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    if (prepared.context != nullptr && prepared.nonce_length == nonce_length && prepared.tag_length == tag_length)
+    {
+        context = prepared.context;
+        return CHIP_NO_ERROR;
+    }
+
+    Discard(prepared.context);
+
+    context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // Pass in cipher
+    result = EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in nonce length
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, nonce_length, nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in tag length. For decryption, the expected tag itself is passed in with each message.
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, tag_length, nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in key. This has to come last, as the nonce and tag lengths are fixed when the key is set.
+    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+    result = EVP_CipherInit_ex(context, nullptr, nullptr, mKey, nullptr, enc);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    prepared.context      = context;
+    prepared.nonce_length = nonce_length;
+    prepared.tag_length   = tag_length;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        EVP_CIPHER_CTX_free(context);
+        context = nullptr;
+    }
+
+    return error;
+}
+
+void AesCcmContextCache::Discard(EVP_CIPHER_CTX * context)
+{
+    VerifyOrReturn(context != nullptr);
+
+    for (PreparedContext * prepared : { &mEncrypt, &mDecrypt })
+    {
+        if (prepared->context == context)
+        {
+            *prepared = PreparedContext();
+        }
+    }
+
+    EVP_CIPHER_CTX_free(context);
+}
+#endif // CHIP_CRYPTO_BORINGSSL
+
 CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
                            const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
                            uint8_t * tag, size_t tag_length)
 {
+    AesCcmContextCache * cache = nullptr;
 #if CHIP_CRYPTO_BORINGSSL
     EVP_AEAD_CTX * context = nullptr;
     size_t written_tag_len = 0;
-    const EVP_AEAD * aead  = nullptr;
 #else
     EVP_CIPHER_CTX * context = nullptr;
     int bytesWritten         = 0;
     size_t ciphertext_length = 0;
-    const EVP_CIPHER * type  = nullptr;
 #endif
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -201,38 +370,23 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
                               error = CHIP_ERROR_INVALID_ARGUMENT);
 #endif // CHIP_CRYPTO_BORINGSSL
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+    cache = AesCcmContextCache::Get(key);
+    VerifyOrExit(cache != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+#if CHIP_CRYPTO_BORINGSSL
+    SuccessOrExit(error = cache->GetContext(tag_length, context));
 
     result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
                                        plaintext_length, nullptr, 0, aad, aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
     VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
 #else
+    // Get a context with the cipher, nonce length, tag length and key already set. Casts are safe because we
+    // checked the nonce length with CanCastTo and the tag length against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
+    SuccessOrExit(error = cache->GetEncryptContext(static_cast<int>(nonce_length), static_cast<int>(tag_length), context));
 
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    // Pass in nonce
+    result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in plain text length
@@ -268,15 +422,12 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+#if !CHIP_CRYPTO_BORINGSSL
+    if (error != CHIP_NO_ERROR && context != nullptr)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-        context = nullptr;
+        cache->Discard(context);
     }
+#endif // !CHIP_CRYPTO_BORINGSSL
 
     return error;
 }
@@ -285,14 +436,12 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext)
 {
+    AesCcmContextCache * cache = nullptr;
 #if CHIP_CRYPTO_BORINGSSL
     EVP_AEAD_CTX * context = nullptr;
-    const EVP_AEAD * aead  = nullptr;
 #else
-
     EVP_CIPHER_CTX * context = nullptr;
     int bytesOutput          = 0;
-    const EVP_CIPHER * type  = nullptr;
 #endif // CHIP_CRYPTO_BORINGSSL
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -333,41 +482,30 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
     VerifyOrExit(nonce != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+    cache = AesCcmContextCache::Get(key);
+    VerifyOrExit(cache != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+#if CHIP_CRYPTO_BORINGSSL
+    SuccessOrExit(error = cache->GetContext(tag_length, context));
 
     result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
                                       aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 #else
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length
+    // Get a context with the cipher, nonce length, tag length and key already set
     VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    SuccessOrExit(error = cache->GetDecryptContext(static_cast<int>(nonce_length), static_cast<int>(tag_length), context));
 
     // Pass in expected tag
     // Removing "const" from |tag| here should hopefully be safe as
     // we're writing the tag, not reading.
-    VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
     result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
                                               const_cast<void *>(static_cast<const void *>(tag)));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    // Pass in nonce
+    result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in cipher text length
@@ -397,16 +535,12 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+#if !CHIP_CRYPTO_BORINGSSL
+    if (error != CHIP_NO_ERROR && context != nullptr)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-
-        context = nullptr;
+        cache->Discard(context);
     }
+#endif // !CHIP_CRYPTO_BORINGSSL
 
     return error;
 }
@@ -754,25 +888,17 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_msg_signature(const uint8_t * msg, cons
     return ECDSA_validate_hash_signature(&digest[0], sizeof(digest), signature);
 }
 
-CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, const size_t hash_length,
-                                                        const P256ECDSASignature & signature) const
+// helper function to decode and check a public key. Caller must free out_ec_key
+static CHIP_ERROR _create_ec_key_from_p256_public_key(const P256PublicKey & key, EC_KEY ** out_ec_key)
 {
-    ERR_clear_error();
     CHIP_ERROR error     = CHIP_ERROR_INTERNAL;
     int nid              = NID_undef;
     EC_KEY * ec_key      = nullptr;
     EC_POINT * key_point = nullptr;
     EC_GROUP * ec_group  = nullptr;
-    ECDSA_SIG * ec_sig   = nullptr;
-    BIGNUM * r           = nullptr;
-    BIGNUM * s           = nullptr;
     int result           = 0;
 
-    VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(hash_length == kSHA256_Hash_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(signature.Length() == kP256_ECDSA_Signature_Length_Raw, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    nid = _nidForCurve(MapECName(Type()));
+    nid = _nidForCurve(MapECName(key.Type()));
     VerifyOrExit(nid != NID_undef, error = CHIP_ERROR_INVALID_ARGUMENT);
 
     ec_group = EC_GROUP_new_by_curve_name(nid);
@@ -781,7 +907,7 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, co
     key_point = EC_POINT_new(ec_group);
     VerifyOrExit(key_point != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(*this), Length(), nullptr);
+    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(key), key.Length(), nullptr);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     ec_key = EC_KEY_new_by_curve_name(nid);
@@ -793,6 +919,36 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, co
     result = EC_KEY_check_key(ec_key);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
+    *out_ec_key = ec_key;
+    ec_key      = nullptr;
+    error       = CHIP_NO_ERROR;
+
+exit:
+    if (ec_key != nullptr)
+    {
+        EC_KEY_free(ec_key);
+    }
+    if (key_point != nullptr)
+    {
+        EC_POINT_clear_free(key_point);
+    }
+    if (ec_group != nullptr)
+    {
+        EC_GROUP_free(ec_group);
+    }
+    return error;
+}
+
+// helper function to verify a raw <r,s> signature of a SHA-256 hash
+static CHIP_ERROR _verify_hash_signature(EC_KEY * ec_key, const uint8_t * hash, const size_t hash_length,
+                                         const P256ECDSASignature & signature)
+{
+    CHIP_ERROR error   = CHIP_ERROR_INTERNAL;
+    ECDSA_SIG * ec_sig = nullptr;
+    BIGNUM * r         = nullptr;
+    BIGNUM * s         = nullptr;
+    int result         = 0;
+
     // Build-up the signature object from raw <r,s> tuple
     r = BN_bin2bn(Uint8::to_const_uchar(signature.ConstBytes()) + 0u, kP256_FE_Length, nullptr);
     VerifyOrExit(r != nullptr, error = CHIP_ERROR_NO_MEMORY);
@@ -811,7 +967,6 @@ CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, co
     error = CHIP_NO_ERROR;
 
 exit:
-    _logSSLError();
     if (ec_sig != nullptr)
     {
         ECDSA_SIG_free(ec_sig);
@@ -829,19 +984,66 @@ exit:
     {
         BN_clear_free(r);
     }
+    return error;
+}
+
+CHIP_ERROR P256PublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, const size_t hash_length,
+                                                        const P256ECDSASignature & signature) const
+{
+    ERR_clear_error();
+    CHIP_ERROR error = CHIP_ERROR_INTERNAL;
+    EC_KEY * ec_key  = nullptr;
+
+    VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(hash_length == kSHA256_Hash_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(signature.Length() == kP256_ECDSA_Signature_Length_Raw, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    SuccessOrExit(error = _create_ec_key_from_p256_public_key(*this, &ec_key));
+    error = _verify_hash_signature(ec_key, hash, hash_length, signature);
+
+exit:
+    _logSSLError();
     if (ec_key != nullptr)
     {
         EC_KEY_free(ec_key);
     }
-    if (key_point != nullptr)
+    return error;
+}
+
+CHIP_ERROR P256PreparedPublicKey::ECDSA_validate_hash_signature(const uint8_t * hash, const size_t hash_length,
+                                                                const P256ECDSASignature & signature) const
+{
+    ERR_clear_error();
+    CHIP_ERROR error = CHIP_ERROR_INTERNAL;
+    EC_KEY * ec_key  = nullptr;
+
+    VerifyOrExit(hash != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(hash_length == kSHA256_Hash_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(signature.Length() == kP256_ECDSA_Signature_Length_Raw, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The decoded and checked key is kept for the next verifications. A key that fails the checks is not,
+    // so all verifications with it fail the same way.
+    if (mPrepared == nullptr)
     {
-        EC_POINT_clear_free(key_point);
+        SuccessOrExit(error = _create_ec_key_from_p256_public_key(mPublicKey, &ec_key));
+        mPrepared = ec_key;
     }
-    if (ec_group != nullptr)
+    ec_key = static_cast<EC_KEY *>(mPrepared);
+
+    error = _verify_hash_signature(ec_key, hash, hash_length, signature);
+
+exit:
+    _logSSLError();
+    return error;
+}
+
+void P256PreparedPublicKey::Release() const
+{
+    if (mPrepared != nullptr)
     {
-        EC_GROUP_free(ec_group);
+        EC_KEY_free(static_cast<EC_KEY *>(mPrepared));
+        mPrepared = nullptr;
     }
-    return error;
 }
 
 // helper function to populate octet key into EVP_PKEY out_evp_pkey. Caller must free out_evp_pkey
@@ -1340,7 +1542,7 @@ exit:
 
 typedef struct Spake2p_Context
 {
-    EC_GROUP * curve;
+    const EC_GROUP * curve;
     BN_CTX * bn_ctx;
     const EVP_MD * md_info;
 } Spake2p_Context;
@@ -1350,6 +1552,15 @@ static inline Spake2p_Context * to_inner_spake2p_context(Spake2pOpaqueContext *
     return SafePointerCast<Spake2p_Context *>(context);
 }
 
+// Building the P-256 group takes about half of the time of a SPAKE2+ context setup, so all contexts share one
+// group, created on first use and never freed.  The group is not modified by the point operations, which makes
+// it safe to use from several threads.
+static const EC_GROUP * GetSpake2pGroup()
+{
+    static const EC_GROUP * const sGroup = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    return sGroup;
+}
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal()
 {
     Spake2p_Context * const context = to_inner_spake2p_context(&mSpake2pContext);
@@ -1358,7 +1569,7 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal()
     context->bn_ctx  = nullptr;
     context->md_info = nullptr;
 
-    context->curve = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    context->curve = GetSpake2pGroup();
     VerifyOrReturnError(context->curve != nullptr, CHIP_ERROR_INTERNAL);
 
     G = EC_GROUP_get0_generator(context->curve);
@@ -1383,8 +1594,8 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal()
     init_bn(tempbn);
     init_bn(order);
 
-    const int error_openssl = EC_GROUP_get_order(context->curve, static_cast<BIGNUM *>(order), context->bn_ctx);
-    VerifyOrReturnError(error_openssl == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(BN_copy(static_cast<BIGNUM *>(order), EC_GROUP_get0_order(context->curve)) != nullptr,
+                        CHIP_ERROR_INTERNAL);
 
     return CHIP_NO_ERROR;
 }
@@ -1395,10 +1606,8 @@ void Spake2p_P256_SHA256_HKDF_HMAC::Clear()
 
     Spake2p_Context * const context = to_inner_spake2p_context(&mSpake2pContext);
 
-    if (context->curve != nullptr)
-    {
-        EC_GROUP_clear_free(context->curve);
-    }
+    // The group is shared by all contexts, see GetSpake2pGroup().
+    context->curve = nullptr;
 
     if (context->bn_ctx != nullptr)
     {
@@ -27,6 +27,8 @@ namespace Crypto {
 class PSASessionKeystore : public SessionKeystore
 {
 public:
+    using SessionKeystore::DestroyKey;
+
     CHIP_ERROR CreateKey(const Symmetric128BitsKeyByteArray & keyMaterial, Aes128KeyHandle & key) override;
     CHIP_ERROR CreateKey(const Symmetric128BitsKeyByteArray & keyMaterial, Hmac128KeyHandle & key) override;
     CHIP_ERROR CreateKey(const ByteSpan & keyMaterial, HkdfKeyHandle & key) override;
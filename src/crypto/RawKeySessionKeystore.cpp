@@ -36,8 +36,21 @@ struct RawHkdfKeyHandle
     uint8_t size;
 };
 
+namespace {
+
+// Releases the cipher contexts that the crypto PAL may have prepared for the previous key material of the handle.
+void ReleaseCipherContexts(Aes128KeyHandle & key)
+{
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+    key.ReleaseCipherContexts();
+#endif
+}
+
+} // namespace
+
 CHIP_ERROR RawKeySessionKeystore::CreateKey(const Symmetric128BitsKeyByteArray & keyMaterial, Aes128KeyHandle & key)
 {
+    ReleaseCipherContexts(key);
     memcpy(key.AsMutable<Symmetric128BitsKeyByteArray>(), keyMaterial, sizeof(Symmetric128BitsKeyByteArray));
     return CHIP_NO_ERROR;
 }
@@ -64,6 +77,7 @@ CHIP_ERROR RawKeySessionKeystore::DeriveKey(const P256ECDHDerivedSecret & secret
 {
     HKDF_sha hkdf;
 
+    ReleaseCipherContexts(key);
     return hkdf.HKDF_SHA256(secret.ConstBytes(), secret.Length(), salt.data(), salt.size(), info.data(), info.size(),
                             key.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray));
 }
@@ -80,6 +94,9 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const ByteSpan & secret, con
 
     Encoding::LittleEndian::Reader reader(keyMaterial, sizeof(keyMaterial));
 
+    ReleaseCipherContexts(i2rKey);
+    ReleaseCipherContexts(r2iKey);
+
     return reader.ReadBytes(i2rKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
         .ReadBytes(r2iKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
         .ReadBytes(attestationChallenge.Bytes(), AttestationChallenge::Capacity())
@@ -98,6 +115,12 @@ void RawKeySessionKeystore::DestroyKey(Symmetric128BitsKeyHandle & key)
     ClearSecretData(key.AsMutable<Symmetric128BitsKeyByteArray>());
 }
 
+void RawKeySessionKeystore::DestroyKey(Aes128KeyHandle & key)
+{
+    ReleaseCipherContexts(key);
+    ClearSecretData(key.AsMutable<Symmetric128BitsKeyByteArray>());
+}
+
 void RawKeySessionKeystore::DestroyKey(HkdfKeyHandle & key)
 {
     RawHkdfKeyHandle & rawKey = key.AsMutable<RawHkdfKeyHandle>();
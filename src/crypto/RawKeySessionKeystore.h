@@ -36,6 +36,7 @@ public:
                                  Aes128KeyHandle & i2rKey, Aes128KeyHandle & r2iKey,
                                  AttestationChallenge & attestationChallenge) override;
     void DestroyKey(Symmetric128BitsKeyHandle & key) override;
+    void DestroyKey(Aes128KeyHandle & key) override;
     void DestroyKey(HkdfKeyHandle & key) override;
 };
 
@@ -87,6 +87,14 @@ public:
      */
     virtual void DestroyKey(Symmetric128BitsKeyHandle & key) = 0;
 
+    /**
+     * @brief Destroy AES key.
+     *
+     * Keystores that keep additional state in AES key handles override this method to release it. By default,
+     * it is the same as destroying the key as a Symmetric128BitsKeyHandle.
+     */
+    virtual void DestroyKey(Aes128KeyHandle & key) { DestroyKey(static_cast<Symmetric128BitsKeyHandle &>(key)); }
+
     /**
      * @brief Destroy key.
      *
@@ -392,6 +392,76 @@ TEST_F(TestChipCryptoPAL, TestAES_CCM_128DecryptTestVectors)
     EXPECT_GT(numOfTestsRan, 0);
 }
 
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128ReuseKeyHandle)
+{
+    HeapChecker heapChecker;
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+
+    // Go through the vectors twice with the same handle, so that messages are protected both with contexts
+    // prepared for a previous key and with contexts prepared for the current one.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+        {
+            const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+            if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+
+            numOfTestsRan++;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            out_ct.Alloc(vector->ct_len);
+            ASSERT_TRUE(out_ct);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            out_tag.Alloc(vector->tag_len);
+            ASSERT_TRUE(out_tag);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            out_pt.Alloc(vector->pt_len);
+            ASSERT_TRUE(out_pt);
+
+            Crypto::Symmetric128BitsKeyByteArray keyMaterial;
+            memcpy(&keyMaterial, vector->key, vector->key_len);
+
+            // Odd vectors overwrite the key material in place, as done when restoring keys from storage.
+            if (vectorIndex % 2 == 0)
+            {
+                EXPECT_EQ(keystore.CreateKey(keyMaterial, key), CHIP_NO_ERROR);
+            }
+            else
+            {
+                memcpy(key.AsMutable<Crypto::Symmetric128BitsKeyByteArray>(), keyMaterial, sizeof(keyMaterial));
+            }
+
+            for (int message = 0; message < 2; message++)
+            {
+                EXPECT_EQ(AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, key, vector->nonce,
+                                          vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len),
+                          CHIP_NO_ERROR);
+                EXPECT_EQ(memcmp(out_ct.Get(), vector->ct, vector->ct_len), 0);
+                EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0);
+
+                // A message that fails authentication must not affect the next ones.
+                out_tag[0] ^= 0x01;
+                EXPECT_NE(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(),
+                                          vector->tag_len, key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                          CHIP_NO_ERROR);
+
+                EXPECT_EQ(AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                          key, vector->nonce, vector->nonce_len, out_pt.Get()),
+                          CHIP_NO_ERROR);
+                EXPECT_EQ(memcmp(out_pt.Get(), vector->pt, vector->pt_len), 0);
+            }
+        }
+    }
+
+    keystore.DestroyKey(key);
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
 TEST_F(TestChipCryptoPAL, TestAES_CCM_128EncryptInvalidNonceLen)
 {
     HeapChecker heapChecker;
@@ -1158,6 +1228,78 @@ TEST_F(TestChipCryptoPAL, TestECDSA_ValidationFailIncorrectHashSignature)
     EXPECT_EQ(validation_error, CHIP_ERROR_INVALID_SIGNATURE);
 }
 
+TEST_F(TestChipCryptoPAL, TestECDSA_PreparedPublicKey)
+{
+    HeapChecker heapChecker;
+    const uint8_t * msg  = reinterpret_cast<const uint8_t *>("Hello World!");
+    const size_t msg_len = strlen("Hello World!");
+
+    P256Keypair keypair;
+    EXPECT_EQ(keypair.Initialize(ECPKeyTarget::ECDSA), CHIP_NO_ERROR);
+    P256Keypair otherKeypair;
+    EXPECT_EQ(otherKeypair.Initialize(ECPKeyTarget::ECDSA), CHIP_NO_ERROR);
+
+    P256ECDSASignature signature;
+    EXPECT_EQ(keypair.ECDSA_sign_msg(msg, msg_len, signature), CHIP_NO_ERROR);
+    P256ECDSASignature otherSignature;
+    EXPECT_EQ(otherKeypair.ECDSA_sign_msg(msg, msg_len, otherSignature), CHIP_NO_ERROR);
+
+    uint8_t hash[kSHA256_Hash_Length];
+    EXPECT_EQ(Hash_SHA256(msg, msg_len, hash), CHIP_NO_ERROR);
+
+    {
+        P256PreparedPublicKey publicKey(keypair.Pubkey());
+
+        // The prepared key verifies any number of signatures, and fails on the wrong ones.
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, signature), CHIP_NO_ERROR);
+            EXPECT_EQ(publicKey.ECDSA_validate_hash_signature(hash, sizeof(hash), signature), CHIP_NO_ERROR);
+            EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, otherSignature), CHIP_ERROR_INVALID_SIGNATURE);
+        }
+        EXPECT_EQ(publicKey.ECDSA_validate_hash_signature(nullptr, sizeof(hash), signature), CHIP_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(publicKey.ECDSA_validate_hash_signature(hash, sizeof(hash) - 1, signature), CHIP_ERROR_INVALID_ARGUMENT);
+
+        // Changing the key drops what was prepared for the previous one.
+        publicKey = otherKeypair.Pubkey();
+        EXPECT_TRUE(publicKey.Pubkey().Matches(otherKeypair.Pubkey()));
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, otherSignature), CHIP_NO_ERROR);
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, signature), CHIP_ERROR_INVALID_SIGNATURE);
+
+        // And so does changing it back.
+        publicKey = keypair.Pubkey();
+        EXPECT_EQ(publicKey.ECDSA_validate_hash_signature(hash, sizeof(hash), signature), CHIP_NO_ERROR);
+        EXPECT_EQ(publicKey.ECDSA_validate_hash_signature(hash, sizeof(hash), otherSignature), CHIP_ERROR_INVALID_SIGNATURE);
+    }
+
+    {
+        // A key assigned before anything was prepared.
+        P256PreparedPublicKey publicKey;
+        publicKey = otherKeypair.Pubkey();
+        publicKey = keypair.Pubkey();
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, signature), CHIP_NO_ERROR);
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, otherSignature), CHIP_ERROR_INVALID_SIGNATURE);
+    }
+
+    {
+        // A key that is not a valid point never verifies anything, and does not get in the way of a valid key assigned
+        // afterwards.
+        P256PublicKey invalidKey;
+        memset(invalidKey.Bytes(), 0, invalidKey.Length());
+        invalidKey.Bytes()[0] = 0x04;
+
+        P256PreparedPublicKey publicKey(invalidKey);
+        for (int i = 0; i < 2; i++)
+        {
+            EXPECT_NE(publicKey.ECDSA_validate_msg_signature(msg, msg_len, signature), CHIP_NO_ERROR);
+        }
+
+        publicKey = keypair.Pubkey();
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, signature), CHIP_NO_ERROR);
+        EXPECT_EQ(publicKey.ECDSA_validate_msg_signature(msg, msg_len, otherSignature), CHIP_ERROR_INVALID_SIGNATURE);
+    }
+}
+
 TEST_F(TestChipCryptoPAL, TestECDSA_SigningMsgInvalidParams)
 {
     HeapChecker heapChecker;
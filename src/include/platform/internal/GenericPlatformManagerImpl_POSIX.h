@@ -36,6 +36,10 @@
 #include <pthread.h>
 #include <queue>
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "Background event processing needs the Matter event loop to accept events from other threads, which libev does not"
+#endif
+
 namespace chip {
 namespace DeviceLayer {
 namespace Internal {
@@ -93,6 +97,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -113,6 +124,22 @@ private:
     static void * EventLoopTaskMain(void * arg);
 #endif
     void ProcessDeviceEvents();
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background events are only queued while the background event loop runs, so that work scheduled
+    // with ScheduleBackgroundWork() is never left in a queue that nothing services.  Otherwise they
+    // are posted to the Matter event loop.
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    pthread_mutex_t mBackgroundEventLock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventCond  = PTHREAD_COND_INITIALIZER;
+    bool mShouldRunBackgroundEventLoop   = false;
+
+    pthread_t mBackgroundEventLoopTask;
+    bool mInternallyManagedBackgroundEventLoopTask = false;
+
+    void ProcessBackgroundEvents();
+    static void * BackgroundEventLoopTaskMain(void * arg);
+#endif
 };
 
 // Instruct the compiler to instantiate the template only when explicitly told to do so.
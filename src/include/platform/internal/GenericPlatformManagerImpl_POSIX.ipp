@@ -383,6 +383,126 @@ exit:
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    VerifyOrReturnError(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    pthread_mutex_lock(&mBackgroundEventLock);
+    const bool isRunning = mShouldRunBackgroundEventLoop;
+    if (isRunning)
+    {
+        mBackgroundEventQueue.push(*event);
+        pthread_cond_signal(&mBackgroundEventCond);
+    }
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    //
+    // Without a background event loop, the work runs on the Matter thread, as it does on platforms
+    // that do not process background events.
+    //
+    return isRunning ? CHIP_NO_ERROR : Impl()->PostEvent(event);
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    if (mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        ChipLogError(DeviceLayer, "Error trying to run the background event loop while it is already running");
+        return;
+    }
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    ProcessBackgroundEvents();
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessBackgroundEvents()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    for (;;)
+    {
+        while (mShouldRunBackgroundEventLoop && mBackgroundEventQueue.empty())
+        {
+            pthread_cond_wait(&mBackgroundEventCond, &mBackgroundEventLock);
+        }
+
+        //
+        // Events queued before the loop was asked to stop are still processed: whoever scheduled
+        // the work is waiting for it to complete.
+        //
+        if (mBackgroundEventQueue.empty())
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->ProcessBackgroundEvents();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    if (mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    //
+    // Accept events right away, they are queued until the task starts processing them.
+    //
+    mShouldRunBackgroundEventLoop = true;
+
+    int err = pthread_create(&mBackgroundEventLoopTask, nullptr, BackgroundEventLoopTaskMain, this);
+    mInternallyManagedBackgroundEventLoopTask = (err == 0);
+    mShouldRunBackgroundEventLoop             = (err == 0);
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    return CHIP_ERROR_POSIX(err);
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_cond_broadcast(&mBackgroundEventCond);
+
+    const bool joinTask                       = mInternallyManagedBackgroundEventLoopTask;
+    mInternallyManagedBackgroundEventLoopTask = false;
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    int err = 0;
+    if (joinTask && (pthread_equal(pthread_self(), mBackgroundEventLoopTask) == 0))
+    {
+        err = pthread_join(mBackgroundEventLoopTask, nullptr);
+    }
+    return CHIP_ERROR_POSIX(err);
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
 {
@@ -393,6 +513,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    _StopBackgroundEventLoopTask();
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
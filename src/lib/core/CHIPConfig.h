@@ -742,6 +742,10 @@
  *    Maximum number of fabrics the device can participate in.  Each fabric can
  *    provision the device with its unique operational credentials and manage
  *    its own access control lists.
+ *
+ *    At most 254 (the number of valid fabric indices). Fabric table lookups are
+ *    binary searches, so controllers hosting many fabric identities can raise
+ *    this without making lookups slower.
  */
 #ifndef CHIP_CONFIG_MAX_FABRICS
 #define CHIP_CONFIG_MAX_FABRICS 16
@@ -802,6 +806,29 @@
 #define CHIP_CONFIG_SLOW_CRYPTO 1
 #endif // CHIP_CONFIG_SLOW_CRYPTO
 
+/**
+ *  @def CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE
+ *
+ *  @brief
+ *   Number of (passcode, salt, iteration count) combinations whose PBKDF2 output a commissioner
+ *   keeps in its PASEVerifierCache, so that a new PASE session with the same parameters does not
+ *   run PBKDF2 again.
+ */
+#ifndef CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE
+#define CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE 4
+#endif // CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE
+
+/**
+ *  @def CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS
+ *
+ *  @brief
+ *   Number of seconds after which a PASEVerifierCache entry expires.  The default matches the longest
+ *   commissioning window a device may open, after which its passcode is of no further use.
+ */
+#ifndef CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS
+#define CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS 900
+#endif // CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS
+
 /**
  * @def CHIP_NON_PRODUCTION_MARKER
  *
@@ -854,6 +881,7 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -931,6 +959,16 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets of the index the reporting engine uses to find the read handlers interested in a
+ *        dirty attribute path. Each bucket costs a pointer; more buckets keep the chains short when many paths are subscribed.
+ */
+#ifndef CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS 32
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1032,6 +1070,40 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_QUEUE_SIZE
+ *
+ * @brief Number of session establishment requests a CASEConnectionScheduler
+ *        can hold (queued or in progress). Further requests are rejected with
+ *        CHIP_ERROR_NO_MEMORY until earlier ones complete.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_QUEUE_SIZE
+#define CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_QUEUE_SIZE 64
+#endif // CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_QUEUE_SIZE
+
+/**
+ * @def CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_LOOKUPS
+ *
+ * @brief Default number of operational address lookups a
+ *        CASEConnectionScheduler runs in parallel. Defaults to the number of
+ *        resolves the minimal mDNS resolver retries concurrently
+ *        (CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES).
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_LOOKUPS
+#define CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_LOOKUPS CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
+#endif // CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_LOOKUPS
+
+/**
+ * @def CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_HANDSHAKES
+ *
+ * @brief Default number of CASE handshakes a CASEConnectionScheduler keeps in
+ *        flight. Should not exceed the number of CASE clients available to
+ *        the CASESessionManager it drives.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_HANDSHAKES
+#define CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_HANDSHAKES CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS
+#endif // CHIP_CONFIG_CASE_CONNECTION_SCHEDULER_MAX_HANDSHAKES
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1380,6 +1452,45 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+ *
+ * @brief Determines the maximum number of known answers from a single received
+ *        query that minmdns considers for known-answer suppression.
+ *        Known answers beyond this limit are ignored, which only results in
+ *        less reply suppression.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+#define CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS 8
+#endif // CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_THROTTLED_INTERFACES
+ *
+ * @brief Determines the number of interfaces for which minmdns tracks when
+ *        each record was last multicast, to throttle multicast replies to
+ *        once per second per interface.
+ *        With more interfaces, the least recently used one stops being
+ *        throttled, which only results in more replies.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_THROTTLED_INTERFACES
+#define CHIP_CONFIG_MINMDNS_MAX_THROTTLED_INTERFACES 4
+#endif // CHIP_CONFIG_MINMDNS_MAX_THROTTLED_INTERFACES
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+ *
+ * @brief Number of resolved operational nodes that minmdns keeps cached.
+ *        Resolving a cached node completes without sending mDNS queries.
+ *        The cache is fed by all received responses (including unsolicited
+ *        announcements) and entries expire according to the record TTLs.
+ *
+ *        Set to 0 to disable caching.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1470,6 +1581,58 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_SUBSCRIPTION_RESUMPTION_STORAGE_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_DATA_VERSION_PERSISTENCE_WRITE_DELAY_MS
+ *
+ * @brief Defines how long DataVersionPersistence waits after a cluster data version changed before writing the data versions of
+ *        its endpoint, so that a burst of changes results in a single storage write.
+ */
+#ifndef CHIP_CONFIG_DATA_VERSION_PERSISTENCE_WRITE_DELAY_MS
+#define CHIP_CONFIG_DATA_VERSION_PERSISTENCE_WRITE_DELAY_MS 10000
+#endif
+
+/**
+ * @def CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_UNSTORED_VERSIONS
+ *
+ * @brief Defines how far the data version of a cluster may get past its stored value before DataVersionPersistence writes it
+ *        without waiting. After a reboot, a restored cluster skips that many versions on its next change, as they may have been
+ *        published before the reboot.
+ */
+#ifndef CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_UNSTORED_VERSIONS
+#define CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_UNSTORED_VERSIONS 256
+#endif
+
+/**
+ * @def CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_CLUSTERS
+ *
+ * @brief Defines the maximum number of clusters whose data versions DataVersionPersistence keeps, when its pool is not
+ *        allocated on the heap.
+ */
+#ifndef CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_CLUSTERS
+#define CHIP_CONFIG_DATA_VERSION_PERSISTENCE_MAX_CLUSTERS 64
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS
+ *
+ * @brief Defines how long the server keeps the attribute values written to persistent storage in memory before writing them all
+ *        at once (see BatchedPersistentStorageDelegate). Repeated writes of the same attribute within that interval result in a
+ *        single storage write; values not yet written are lost on power loss. 0 writes every value through immediately.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS
+#define CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_FLUSH_INTERVAL_MS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_MAX_PENDING_WRITES
+ *
+ * @brief Defines the maximum number of keys whose values BatchedPersistentStorageDelegate keeps in memory. Writing another key
+ *        flushes the pending values first.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_MAX_PENDING_WRITES
+#define CHIP_CONFIG_ATTRIBUTE_PERSISTENCE_MAX_PENDING_WRITES 16
+#endif
+
 /**
  * @brief Maximum length of Scene names
  */
@@ -1770,6 +1933,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ICD_CLIENTS_INFO_STORAGE_CONCURRENT_ITERATORS 1
 #endif
 
+/**
+ * @def CHIP_CONFIG_ICD_CLIENT_CHECK_IN_NONCE_HINTS
+ *
+ * @brief Number of upcoming Check-In counters per registered ICD for which DefaultICDClientStorage precomputes the
+ *        Check-In message nonce.
+ *
+ * A received Check-In message whose nonce matches one of these is decrypted with that ICD's key first, so it is usually
+ * resolved with a single decryption.  Larger values tolerate more missed Check-In messages per ICD, at the cost of
+ * CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES of memory and one HMAC computation per hint per ICD.
+ */
+#ifndef CHIP_CONFIG_ICD_CLIENT_CHECK_IN_NONCE_HINTS
+#define CHIP_CONFIG_ICD_CLIENT_CHECK_IN_NONCE_HINTS 4
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_THREAD_NETWORK_DIRECTORY_STORAGE_CAPACITY
  *
@@ -110,6 +110,37 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Starts a transaction: the sets and deletes that follow, up to SyncCommitTransaction(),
+     *   are applied together, so that either all of them or none of them are stored.
+     *
+     *   Transactions are optional.  Implementations that do not support them return
+     *   CHIP_ERROR_NOT_IMPLEMENTED, in which case sets and deletes are applied as they are made.
+     *   Values read during a transaction may not reflect its sets and deletes yet.
+     *
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_NOT_IMPLEMENTED if transactions are not supported,
+     *         CHIP_ERROR_INCORRECT_STATE if a transaction is already started, or another CHIP_ERROR
+     *         value from implementation on failure.
+     */
+    virtual CHIP_ERROR SyncBeginTransaction() { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
+    /**
+     * @brief
+     *   Applies the sets and deletes of the transaction started by SyncBeginTransaction().
+     *   On failure, none of them are applied and the transaction is over.
+     *
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_INCORRECT_STATE if no transaction is started,
+     *         or another CHIP_ERROR value from implementation on failure.
+     */
+    virtual CHIP_ERROR SyncCommitTransaction() { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
+    /**
+     * @brief
+     *   Drops the sets and deletes of the transaction started by SyncBeginTransaction(), if any.
+     */
+    virtual void SyncAbortTransaction() {}
 };
 
 } // namespace chip
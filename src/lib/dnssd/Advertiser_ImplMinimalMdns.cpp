@@ -27,6 +27,7 @@
 #include <crypto/RandUtils.h>
 #include <lib/dnssd/Advertiser_ImplMinimalMdnsAllocator.h>
 #include <lib/dnssd/minimal_mdns/AddressPolicy.h>
+#include <lib/dnssd/minimal_mdns/KnownAnswerList.h>
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 #include <lib/dnssd/minimal_mdns/Server.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
@@ -312,6 +313,7 @@ private:
     void ClearServices();
 
     ResponseSender mResponseSender;
+    KnownAnswerList mKnownAnswers; // known answers of the query packet currently being processed
     uint8_t mCommissionableInstanceName[sizeof(uint64_t)];
 
     bool mIsInitialized = false;
@@ -333,12 +335,28 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
     ChipLogDetail(Discovery, "Received an mDNS query from %s", srcAddressString);
 #endif
 
+    // Known answers follow the queries within the packet, so they have to be
+    // collected before replying to any of the queries.
+    mKnownAnswers.Reset(data);
+    if ((data.Size() >= HeaderRef::kSizeBytes) && (ConstHeaderRef(data.Start()).GetAnswerCount() > 0))
+    {
+        KnownAnswerCollector collector(mKnownAnswers);
+        ParsePacket(data, &collector);
+    }
+
     mCurrentSource = info;
+    mResponseSender.BeginAggregation();
     if (!ParsePacket(data, this))
     {
         ChipLogError(Discovery, "Failed to parse mDNS query");
     }
+    CHIP_ERROR err = mResponseSender.EndAggregation();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to send mDNS reply: %" CHIP_ERROR_FORMAT, err.Format());
+    }
     mCurrentSource = nullptr;
+    mKnownAnswers.Reset(BytesRange());
 }
 
 void AdvertiserMinMdns::OnQuery(const QueryData & data)
@@ -352,7 +370,7 @@ void AdvertiserMinMdns::OnQuery(const QueryData & data)
     LogQuery(data);
 
     const ResponseConfiguration defaultResponseConfiguration;
-    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration);
+    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration, &mKnownAnswers);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Discovery, "Failed to reply to query: %" CHIP_ERROR_FORMAT, err.Format());
@@ -16,6 +16,8 @@
  */
 #include <lib/dnssd/IncrementalResolve.h>
 
+#include <algorithm>
+
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/TxtFields.h>
@@ -145,6 +147,7 @@ CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQName
     ReturnErrorOnFailure(mRecordName.Set(name));
     ReturnErrorOnFailure(mTargetHostName.Set(srv.GetName()));
     mCommonResolutionData.port = srv.GetPort();
+    mTtlSeconds                = static_cast<uint32_t>(std::min<uint64_t>(ttl, UINT32_MAX));
 
     {
         // TODO: Chip code historically seems to assume that the host name is of the
@@ -263,7 +266,9 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        ReturnErrorOnFailure(OnIpAddress(interface, addr));
+        mTtlSeconds = static_cast<uint32_t>(std::min<uint64_t>(mTtlSeconds, data.GetTtlSeconds()));
+        return CHIP_NO_ERROR;
 #else
 #if CHIP_MINMDNS_HIGH_VERBOSITY
         ChipLogProgress(Discovery, "Ignoring A record: IPv4 not supported");
@@ -285,7 +290,9 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        ReturnErrorOnFailure(OnIpAddress(interface, addr));
+        mTtlSeconds = static_cast<uint32_t>(std::min<uint64_t>(mTtlSeconds, data.GetTtlSeconds()));
+        return CHIP_NO_ERROR;
     }
     case QType::SRV: // SRV handled on creation, ignored for 'additional data'
     default:
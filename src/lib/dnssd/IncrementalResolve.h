@@ -149,6 +149,10 @@ public:
     ///           as this object is valid and InitializeParsing is not called again.
     mdns::Minimal::SerializedQNameIterator GetRecordName() const { return mRecordName.Get(); }
 
+    /// Smallest TTL of the SRV and IP address records used so far, i.e. how long
+    /// the parsed data is expected to remain valid.
+    uint32_t GetTtlSeconds() const { return mTtlSeconds; }
+
     /// Take the current value of the object and clear it once returned.
     ///
     /// Object must be in `IsActive()` for this to succeed.
@@ -191,6 +195,7 @@ private:
     StoredServerName mRecordName;     // Record name for what is parsed (SRV/PTR/TXT)
     StoredServerName mTargetHostName; // `Target` for the SRV record
     ServiceNameType mServiceNameType = ServiceNameType::kInvalid;
+    uint32_t mTtlSeconds             = 0;
     CommonResolutionData mCommonResolutionData;
     ParsedRecordSpecificData mSpecificResolutionData;
 };
@@ -0,0 +1,244 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <lib/core/PeerId.h>
+#include <lib/dnssd/Types.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps recently resolved operational node data, shared by all operational
+/// resolves.
+///
+/// The cache is fed by every fully resolved SRV/AAAA set received, including
+/// unsolicited announcements, so that resolving a node seen recently does not
+/// require any mDNS query round trips.
+///
+/// Entries expire based on the TTL of the records they were built from. When
+/// the cache is full, the least recently used entry is replaced.
+template <size_t kCacheSize>
+class OperationalResolveCache
+{
+public:
+    static_assert(kCacheSize > 0, "Resolve cache needs to have storage");
+
+    enum class LookupResult
+    {
+        kMiss,            // nothing (valid) cached
+        kHit,             // cached data is valid
+        kHitNeedsRefresh, // cached data is valid, however close to expiring
+    };
+
+    OperationalResolveCache(chip::System::Clock::ClockBase * clock) : mClock(clock) {}
+
+    /// Store data valid for the given TTL. A TTL of 0 removes any cached data
+    /// for the node (e.g. the node announced that it is going away).
+    void Store(const chip::Dnssd::ResolvedNodeData & data, uint32_t ttlSeconds)
+    {
+        const chip::PeerId & peerId = data.operationalData.peerId;
+
+        if ((ttlSeconds == 0) || data.operationalData.hasZeroTTL)
+        {
+            Remove(peerId);
+            return;
+        }
+
+        const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+        Entry * entry = Find(peerId);
+        if (entry == nullptr)
+        {
+            entry = FindFreeOrOldest(now);
+        }
+
+        entry->data        = data;
+        entry->storedAt    = now;
+        entry->lastUsed    = now;
+        entry->ttl         = chip::System::Clock::Seconds32(ttlSeconds);
+        entry->inUse       = true;
+        entry->pendingCall = false;
+    }
+
+    /// Fetch cached data for the given peer.
+    ///
+    /// [outData] is only updated on a hit.
+    LookupResult Lookup(const chip::PeerId & peerId, chip::Dnssd::ResolvedNodeData & outData)
+    {
+        const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+        Entry * entry = Find(peerId);
+        if (entry == nullptr)
+        {
+            return LookupResult::kMiss;
+        }
+
+        if (entry->IsExpired(now))
+        {
+            entry->inUse = false;
+            return LookupResult::kMiss;
+        }
+
+        entry->lastUsed = now;
+        outData         = entry->data;
+
+        return entry->NeedsRefresh(now) ? LookupResult::kHitNeedsRefresh : LookupResult::kHit;
+    }
+
+    /// Mark a cached node as requiring a delivery via `TakePendingDelivery`.
+    ///
+    /// Returns false if the peer is not cached.
+    bool MarkPendingDelivery(const chip::PeerId & peerId)
+    {
+        Entry * entry = Find(peerId);
+        VerifyOrReturnValue(entry != nullptr, false);
+        entry->pendingCall = true;
+        return true;
+    }
+
+    /// Fetch (and clear the pending flag of) the next cached node marked by
+    /// `MarkPendingDelivery`.
+    ///
+    /// Returns false once no more deliveries are pending.
+    bool TakePendingDelivery(chip::Dnssd::ResolvedNodeData & outData)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse && entry.pendingCall)
+            {
+                entry.pendingCall = false;
+                outData           = entry.data;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Remove(const chip::PeerId & peerId)
+    {
+        Entry * entry = Find(peerId);
+        if (entry != nullptr)
+        {
+            entry->inUse = false;
+        }
+    }
+
+    /// Remove all entries for the given host (first host name label) that
+    /// contain the given address.
+    void RemoveHostAddress(const char * hostName, const chip::Inet::IPAddress & address)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse || !entry.data.resolutionData.IsHost(hostName))
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < entry.data.resolutionData.numIPs; i++)
+            {
+                if (entry.data.resolutionData.ipAddress[i] == address)
+                {
+                    entry.inUse = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry.inUse = false;
+        }
+    }
+
+    /// Number of valid (non-expired) entries
+    size_t Count() const
+    {
+        const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+        size_t count                             = 0;
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse && !entry.IsExpired(now))
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+private:
+    struct Entry
+    {
+        chip::Dnssd::ResolvedNodeData data;
+        chip::System::Clock::Timestamp storedAt = chip::System::Clock::kZero;
+        chip::System::Clock::Timestamp lastUsed = chip::System::Clock::kZero;
+        chip::System::Clock::Seconds32 ttl      = chip::System::Clock::Seconds32(0);
+        bool inUse                              = false;
+        bool pendingCall                        = false; // a cache hit still needs to be reported
+
+        bool IsExpired(chip::System::Clock::Timestamp now) const { return now >= storedAt + ttl; }
+
+        // https://datatracker.ietf.org/doc/html/rfc6762#section-5.2: queriers
+        // refresh records once 80% of their TTL has passed.
+        bool NeedsRefresh(chip::System::Clock::Timestamp now) const { return (now - storedAt) * 5 >= ttl * 4; }
+    };
+
+    Entry * Find(const chip::PeerId & peerId)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse && (entry.data.operationalData.peerId == peerId))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Find an entry that can be reused: free or expired entries are preferred,
+    /// otherwise the least recently used entry is returned.
+    Entry * FindFreeOrOldest(chip::System::Clock::Timestamp now)
+    {
+        Entry * oldest = &mEntries[0];
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse || entry.IsExpired(now))
+            {
+                return &entry;
+            }
+            if (entry.lastUsed < oldest->lastUsed)
+            {
+                oldest = &entry;
+            }
+        }
+        return oldest;
+    }
+
+    chip::System::Clock::ClockBase * mClock;
+    Entry mEntries[kCacheSize];
+};
+
+} // namespace Minimal
+} // namespace mdns
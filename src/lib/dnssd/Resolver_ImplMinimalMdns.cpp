@@ -21,6 +21,7 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/OperationalResolveCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
@@ -43,6 +44,10 @@ namespace {
 constexpr size_t kMdnsMaxPacketSize = 1024;
 constexpr uint16_t kMdnsPort        = 5353;
 
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+using ResolveCache = mdns::Minimal::OperationalResolveCache<CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE>;
+#endif
+
 using namespace mdns::Minimal;
 
 /// Handles processing of minmdns packet data.
@@ -267,7 +272,12 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() :
+        mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+        ,
+        mResolveCache(&chip::System::SystemClock())
+#endif
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -293,6 +303,13 @@ private:
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    ResolveCache mResolveCache;
+
+    /// Reports cache hits to the operational delegate. Runs as scheduled work
+    /// since callers of ResolveNodeId do not expect results before it returns.
+    static void DeliverCachedResults(System::Layer *, void * self);
+#endif
 
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
@@ -451,6 +468,9 @@ void MinMdnsResolver::AdvancePendingResolverStates()
         {
             MATTER_TRACE_SCOPE("Active operational delegate call", "MinMdnsResolver");
             ResolvedNodeData nodeResolvedData;
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+            const uint32_t ttlSeconds = resolver->GetTtlSeconds();
+#endif
             CHIP_ERROR err = resolver->Take(nodeResolvedData);
 
             if (err != CHIP_NO_ERROR)
@@ -459,6 +479,12 @@ void MinMdnsResolver::AdvancePendingResolverStates()
                 continue;
             }
 
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+            // Cache everything resolved, including unsolicited announcements:
+            // a resolve for this node is likely to follow.
+            mResolveCache.Store(nodeResolvedData, ttlSeconds);
+#endif
+
             if (mActiveResolves.HasBrowseFor(chip::Dnssd::DiscoveryType::kOperational))
             {
                 if (mDiscoveryContext != nullptr)
@@ -533,6 +559,13 @@ bool MinMdnsResolver::IsInitialized()
 
 void MinMdnsResolver::Shutdown()
 {
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(&DeliverCachedResults, this);
+    }
+    mResolveCache.Clear();
+#endif
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
 }
 
@@ -744,7 +777,14 @@ CHIP_ERROR MinMdnsResolver::StopDiscovery(DiscoveryContext & context)
 
 CHIP_ERROR MinMdnsResolver::ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId)
 {
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    // Stale data is only ever kept in the resolve cache, so dropping it is enough
+    // for the next resolve to query the network again.
+    mResolveCache.RemoveHostAddress(hostname, address);
+    return CHIP_NO_ERROR;
+#else
     return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif
 }
 
 CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filter)
@@ -756,11 +796,49 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    ResolvedNodeData cachedData;
+    ResolveCache::LookupResult cacheResult = mResolveCache.Lookup(peerId, cachedData);
+
+    if (cacheResult != ResolveCache::LookupResult::kMiss)
+    {
+        MATTER_TRACE_INSTANT("Resolve cache hit", "MinMdnsResolver");
+        ReturnErrorCodeIf(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+        mResolveCache.MarkPendingDelivery(peerId);
+        ReturnErrorOnFailure(mSystemLayer->ScheduleWork(&DeliverCachedResults, this));
+
+        if (cacheResult == ResolveCache::LookupResult::kHit)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        // Data is about to expire: refresh it in the background. Results
+        // will update the cache and be reported to the delegate once more.
+    }
+#endif
+
     mActiveResolves.MarkPending(peerId);
 
     return SendAllPendingQueries();
 }
 
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+void MinMdnsResolver::DeliverCachedResults(System::Layer *, void * self)
+{
+    MinMdnsResolver * resolver = static_cast<MinMdnsResolver *>(self);
+    ResolvedNodeData nodeData;
+
+    while (resolver->mResolveCache.TakePendingDelivery(nodeData))
+    {
+        if (resolver->mOperationalDelegate != nullptr)
+        {
+            resolver->mOperationalDelegate->OnOperationalNodeResolved(nodeData);
+        }
+    }
+}
+#endif
+
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
     mActiveResolves.NodeIdResolutionNoLongerNeeded(peerId);
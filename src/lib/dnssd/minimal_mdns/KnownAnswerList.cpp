@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "KnownAnswerList.h"
+
+#include <string.h>
+
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+
+namespace mdns {
+namespace Minimal {
+
+bool KnownAnswerList::Add(const ResourceData & data)
+{
+    if (mCount >= kMaxKnownAnswers)
+    {
+        return false;
+    }
+
+    mAnswers[mCount++] = data;
+    return true;
+}
+
+bool KnownAnswerList::Suppresses(const ResourceRecord & record) const
+{
+    if (record.GetTtl() == 0)
+    {
+        return false; // never suppress goodbye records
+    }
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        const ResourceData & answer = mAnswers[i];
+
+        if (answer.GetType() != record.GetType())
+        {
+            continue;
+        }
+
+        // cache flush bit is not part of the record identity
+        if ((static_cast<uint16_t>(answer.GetClass()) & ~kQClassResponseFlushBit) != static_cast<uint16_t>(QClass::IN))
+        {
+            continue;
+        }
+
+        // A querier that has less than half of the TTL remaining is expected to
+        // refresh the record soon, so we send it anyway.
+        if (static_cast<uint64_t>(answer.GetTtlSeconds()) * 2 < record.GetTtl())
+        {
+            continue;
+        }
+
+        if (!(answer.GetName() == record.GetName()))
+        {
+            continue;
+        }
+
+        if (DataMatches(record, answer.GetData()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool KnownAnswerList::DataMatches(const ResourceRecord & record, const BytesRange & data) const
+{
+    // Record data may contain compressed names, so comparison is done on the
+    // parsed content rather than on raw bytes.
+    switch (record.GetType())
+    {
+    case QType::PTR: {
+        SerializedQNameIterator target;
+        return ParsePtrRecord(data, mPacket, &target) && (target == static_cast<const PtrResourceRecord &>(record).GetPtr());
+    }
+    case QType::SRV: {
+        const auto & srvRecord = static_cast<const SrvResourceRecord &>(record);
+        SrvRecord srv;
+        return srv.Parse(data, mPacket) && (srv.GetPort() == srvRecord.GetPort()) &&
+            (srv.GetPriority() == srvRecord.GetPriority()) && (srv.GetWeight() == srvRecord.GetWeight()) &&
+            (srv.GetName() == srvRecord.GetServerName());
+    }
+    case QType::A: {
+        chip::Inet::IPAddress addr;
+        return ParseARecord(data, &addr) && (addr == static_cast<const IPResourceRecord &>(record).GetIPAddress());
+    }
+    case QType::AAAA: {
+        chip::Inet::IPAddress addr;
+        return ParseAAAARecord(data, &addr) && (addr == static_cast<const IPResourceRecord &>(record).GetIPAddress());
+    }
+    case QType::TXT: {
+        const auto & txtRecord = static_cast<const TxtResourceRecord &>(record);
+        const uint8_t * pos    = data.Start();
+
+        for (size_t i = 0; i < txtRecord.GetNumEntries(); i++)
+        {
+            const char * entry = txtRecord.GetEntries()[i];
+            size_t len         = strlen(entry);
+
+            if (!data.Contains(pos) || (*pos != len) || (static_cast<size_t>(data.End() - pos) < len + 1))
+            {
+                return false;
+            }
+            if (memcmp(pos + 1, entry, len) != 0)
+            {
+                return false;
+            }
+            pos += len + 1;
+        }
+        return pos == data.End();
+    }
+    default:
+        return false;
+    }
+}
+
+} // namespace Minimal
+} // namespace mdns
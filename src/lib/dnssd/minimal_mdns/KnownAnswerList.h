@@ -0,0 +1,92 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+
+#include "Parser.h"
+
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps track of the answers a querier reported as already known within its query
+/// (i.e. the answer section of a query packet).
+///
+/// Used to implement known-answer suppression as described in
+/// https://datatracker.ietf.org/doc/html/rfc6762#section-7.1
+///
+/// The list references data within the received packet, so it is only valid
+/// for as long as the packet data given to `Reset` is valid.
+class KnownAnswerList
+{
+public:
+    static constexpr size_t kMaxKnownAnswers = CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS;
+
+    /// Forget all known answers and set the packet that subsequently
+    /// added answers are part of.
+    void Reset(const BytesRange & packet)
+    {
+        mPacket = packet;
+        mCount  = 0;
+    }
+
+    /// Remember the given resource as known by the querier.
+    ///
+    /// Returns false if the list is full. Dropping known answers is safe: it
+    /// only results in less suppression, never in missing replies.
+    bool Add(const ResourceData & data);
+
+    size_t Count() const { return mCount; }
+
+    /// Returns true if the querier already knows the given record with at
+    /// least half of its TTL remaining, in which case it should not be sent.
+    bool Suppresses(const ResourceRecord & record) const;
+
+private:
+    bool DataMatches(const ResourceRecord & record, const BytesRange & data) const;
+
+    BytesRange mPacket;
+    ResourceData mAnswers[kMaxKnownAnswers];
+    size_t mCount = 0;
+};
+
+/// Parser delegate that collects the answer section of a query into a KnownAnswerList.
+class KnownAnswerCollector : public ParserDelegate
+{
+public:
+    KnownAnswerCollector(KnownAnswerList & list) : mList(list) {}
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (type == ResourceType::kAnswer)
+        {
+            mList.Add(data);
+        }
+    }
+
+private:
+    KnownAnswerList & mList;
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -40,9 +40,22 @@ constexpr uint16_t kPacketSizeBytes = 512;
 } // namespace
 namespace Internal {
 
-bool ResponseSendingState::SendUnicast() const
+void ResponseSendingState::Reset(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * packet)
 {
-    return mQuery->RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
+    mMessageId = messageId;
+    mSentItems.ClearAll();
+    ResetForAggregatedQuery(query, packet);
+}
+
+void ResponseSendingState::ResetForAggregatedQuery(const QueryData & query, const chip::Inet::IPPacketInfo * packet)
+{
+    mQuery        = &query;
+    mSource       = packet;
+    mSendError    = CHIP_NO_ERROR;
+    mResourceType = ResourceType::kAnswer;
+
+    // Computed once as the query may no longer be valid by the time an aggregated reply is flushed
+    mSendUnicast = query.RequestedUnicastAnswer() || (packet->SrcPort != kMdnsStandardPort);
 }
 
 bool ResponseSendingState::IncludeQuery() const
@@ -103,9 +116,28 @@ bool ResponseSender::HasQueryResponders() const
 }
 
 CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
-                                   const ResponseConfiguration & configuration)
+                                   const ResponseConfiguration & configuration, const KnownAnswerList * knownAnswers)
 {
-    mSendState.Reset(messageId, query, querySource);
+    if (mAggregating && mResponseBuilder.HasPacketBuffer())
+    {
+        // Only multicast replies are ever kept pending. A unicast reply has a different
+        // destination, so whatever is pending gets sent out first.
+        if (query.RequestedUnicastAnswer() || (querySource->SrcPort != kMdnsStandardPort))
+        {
+            ReturnErrorOnFailure(FlushReply());
+            mSendState.Reset(messageId, query, querySource);
+        }
+        else
+        {
+            mSendState.ResetForAggregatedQuery(query, querySource);
+        }
+    }
+    else
+    {
+        mSendState.Reset(messageId, query, querySource);
+    }
+
+    mKnownAnswers = knownAnswers;
 
     if (query.IsAnnounceBroadcast())
     {
@@ -138,10 +170,9 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         if (!mSendState.SendUnicast())
         {
             // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
-            //
-            // TODO: the 'last sent' value does NOT track the interface we used to send, so this may cause
-            //       broadcasts on one interface to throttle broadcasts on another interface.
-            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1));
+            // per interface.
+            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1))
+                .SetMulticastInterface(mSendState.GetSourceInterfaceId());
         }
         for (auto & responder : mResponders)
         {
@@ -151,14 +182,17 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             }
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
+                mAddedRecords = 0;
                 it->responder->AddAllResponses(querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
 
                 responder->MarkAdditionalRepliesFor(it);
 
-                if (!mSendState.SendUnicast())
+                // Records fully suppressed by known answers were not multicast, so they
+                // must not throttle replies to other queriers.
+                if (!mSendState.SendUnicast() && (mAddedRecords > 0))
                 {
-                    it->lastMulticastTime = kTimeNow;
+                    it->multicastThrottle.RecordMulticast(mSendState.GetSourceInterfaceId(), kTimeNow);
                 }
             }
         }
@@ -195,6 +229,17 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         }
     }
 
+    if (mAggregating && !mSendState.SendUnicast())
+    {
+        return CHIP_NO_ERROR; // sent by EndAggregation, possibly together with replies to other queries
+    }
+
+    return FlushReply();
+}
+
+CHIP_ERROR ResponseSender::EndAggregation()
+{
+    mAggregating = false;
     return FlushReply();
 }
 
@@ -202,7 +247,12 @@ CHIP_ERROR ResponseSender::FlushReply()
 {
     ReturnErrorCodeIf(!mResponseBuilder.HasPacketBuffer(), CHIP_NO_ERROR); // nothing to flush
 
-    if (mResponseBuilder.HasResponseRecords())
+    if (!mResponseBuilder.HasResponseRecords())
+    {
+        // Drop the empty packet so that the next reply starts with a fresh header
+        (void) mResponseBuilder.ReleasePacket();
+    }
+    else
     {
         char srcAddressString[chip::Inet::IPAddress::kMaxStringLength];
         VerifyOrDie(mSendState.GetSourceAddress().ToString(srcAddressString) != nullptr);
@@ -288,6 +338,14 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
 {
     ReturnOnFailure(mSendState.GetError());
 
+    // https://datatracker.ietf.org/doc/html/rfc6762#section-7.1
+    if ((mKnownAnswers != nullptr) && mKnownAnswers->Suppresses(record))
+    {
+        mSuppressedRecords++;
+        return;
+    }
+    mAddedRecords++;
+
     if (!mResponseBuilder.HasPacketBuffer())
     {
         mSendState.SetError(PrepareNewReplyPacket());
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "KnownAnswerList.h"
 #include "Parser.h"
 #include "ResponseBuilder.h"
 #include "Server.h"
@@ -71,15 +72,11 @@ class ResponseSendingState
 public:
     ResponseSendingState() {}
 
-    void Reset(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * packet)
-    {
-        mMessageId    = messageId;
-        mQuery        = &query;
-        mSource       = packet;
-        mSendError    = CHIP_NO_ERROR;
-        mResourceType = ResourceType::kAnswer;
-        mSentItems.ClearAll();
-    }
+    void Reset(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * packet);
+
+    /// Reset for replying to another query that is aggregated in the same
+    /// reply packet: items already sent are not sent again.
+    void ResetForAggregatedQuery(const QueryData & query, const chip::Inet::IPPacketInfo * packet);
 
     void SetResourceType(ResourceType resourceType) { mResourceType = resourceType; }
     ResourceType GetResourceType() const { return mResourceType; }
@@ -96,7 +93,7 @@ public:
     const QueryData * GetQuery() const { return mQuery; }
 
     /// Check if the reply should be sent as a unicast reply
-    bool SendUnicast() const;
+    bool SendUnicast() const { return mSendUnicast; }
 
     /// Check if the original query should be included in the reply
     bool IncludeQuery() const;
@@ -116,6 +113,7 @@ private:
     uint16_t mMessageId                      = 0;                     // message id for the reply
     ResourceType mResourceType               = ResourceType::kAnswer; // what is being sent right now
     CHIP_ERROR mSendError                    = CHIP_NO_ERROR;
+    bool mSendUnicast                        = false; // reply goes to the querier rather than multicast
     chip::BitFlags<ResponseItemsSent> mSentItems;
 };
 
@@ -135,8 +133,21 @@ public:
     bool HasQueryResponders() const;
 
     /// Send back the response to a particular query
+    ///
+    /// If knownAnswers is provided, records the querier listed as already known
+    /// (with at least half of their TTL remaining) are not sent.
     CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
-                       const ResponseConfiguration & configuration);
+                       const ResponseConfiguration & configuration, const KnownAnswerList * knownAnswers = nullptr);
+
+    /// Start aggregating replies: multicast replies to the queries passed to
+    /// subsequent Respond calls are combined into as few packets as possible
+    /// and only sent once EndAggregation is called.
+    ///
+    /// Intended for replying to all the queries contained in a single received packet.
+    void BeginAggregation() { mAggregating = true; }
+
+    /// Stop aggregating replies and send any pending aggregated reply.
+    CHIP_ERROR EndAggregation();
 
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
@@ -145,6 +156,9 @@ public:
 
     void SetServer(ServerBase * server) { mServer = server; }
 
+    /// Number of records that were not sent because the querier already knew them.
+    uint32_t GetSuppressedRecordCount() const { return mSuppressedRecords; }
+
 private:
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
@@ -155,6 +169,11 @@ private:
     /// Current send state
     ResponseBuilder mResponseBuilder;          // packet being built
     Internal::ResponseSendingState mSendState; // sending state
+
+    const KnownAnswerList * mKnownAnswers = nullptr; // known answers of the query being replied to
+    bool mAggregating                     = false;   // replies are combined until EndAggregation
+    size_t mAddedRecords                  = 0;       // records added for the current query
+    uint32_t mSuppressedRecords           = 0;       // records suppressed by known answers
 };
 
 } // namespace Minimal
@@ -31,6 +31,8 @@ public:
         ResourceRecord(ip.IsIPv6() ? QType::AAAA : QType::A, qName), mIPAddress(ip)
     {}
 
+    const chip::Inet::IPAddress & GetIPAddress() const { return mIPAddress; }
+
 protected:
     bool WriteData(RecordWriter & out) const override;
 
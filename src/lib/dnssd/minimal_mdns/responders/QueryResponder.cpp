@@ -172,7 +172,7 @@ void QueryResponderBase::ClearBroadcastThrottle()
 {
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
-        mResponderInfos[i].lastMulticastTime = chip::System::Clock::kZero;
+        mResponderInfos[i].multicastThrottle.Clear();
     }
 }
 
@@ -21,17 +21,76 @@
 #include "ReplyFilter.h"
 #include "Responder.h"
 
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
 #include <system/SystemClock.h>
 
 namespace mdns {
 namespace Minimal {
 
+/// Tracks when a record was last multicast on each interface, so that
+/// multicast replies can be throttled per interface.
+class MulticastThrottle
+{
+public:
+    /// Last time the record was multicast on the given interface, or zero if never.
+    chip::System::Clock::Timestamp GetLastMulticastTime(chip::Inet::InterfaceId interface) const
+    {
+        for (const auto & entry : mEntries)
+        {
+            if (entry.interface == interface)
+            {
+                return entry.time;
+            }
+        }
+        return chip::System::Clock::kZero;
+    }
+
+    /// Records a multicast on the given interface. When all the entries are
+    /// used, the interface multicast on least recently is forgotten.
+    void RecordMulticast(chip::Inet::InterfaceId interface, chip::System::Clock::Timestamp time)
+    {
+        Entry * slot = &mEntries[0];
+        for (auto & entry : mEntries)
+        {
+            if (entry.interface == interface)
+            {
+                slot = &entry;
+                break;
+            }
+            if (entry.time < slot->time)
+            {
+                slot = &entry;
+            }
+        }
+        slot->interface = interface;
+        slot->time      = time;
+    }
+
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry = Entry();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        chip::Inet::InterfaceId interface   = chip::Inet::InterfaceId::Null();
+        chip::System::Clock::Timestamp time = chip::System::Clock::kZero;
+    };
+
+    Entry mEntries[CHIP_CONFIG_MINMDNS_MAX_THROTTLED_INTERFACES];
+};
+
 /// Represents available data (replies) for mDNS queries.
 struct QueryResponderRecord
 {
-    Responder * responder                            = nullptr; // what response/data is available
-    bool reportService                               = false;   // report as a service when listing dnssd services
-    chip::System::Clock::Timestamp lastMulticastTime = chip::System::Clock::kZero; // last time this record was multicast
+    Responder * responder = nullptr;     // what response/data is available
+    bool reportService    = false;       // report as a service when listing dnssd services
+    MulticastThrottle multicastThrottle; // when this record was last multicast, per interface
 };
 
 namespace Internal {
@@ -128,6 +187,15 @@ public:
         return *this;
     }
 
+    /// Interface the reply is multicast on. Multicast throttling set via
+    /// SetIncludeOnlyMulticastBeforeMS only considers when records were last
+    /// multicast on this same interface.
+    QueryResponderRecordFilter & SetMulticastInterface(chip::Inet::InterfaceId interface)
+    {
+        mMulticastInterface = interface;
+        return *this;
+    }
+
     bool Accept(Internal::QueryResponderInfo * record) const
     {
         if (record->responder == nullptr)
@@ -141,7 +209,7 @@ public:
         }
 
         if ((mIncludeOnlyMulticastBefore > chip::System::Clock::kZero) &&
-            (record->lastMulticastTime >= mIncludeOnlyMulticastBefore))
+            (record->multicastThrottle.GetLastMulticastTime(mMulticastInterface) >= mIncludeOnlyMulticastBefore))
         {
             return false;
         }
@@ -158,6 +226,7 @@ private:
     bool mIncludeAdditionalRepliesOnly                         = false;
     ReplyFilter * mReplyFilter                                 = nullptr;
     chip::System::Clock::Timestamp mIncludeOnlyMulticastBefore = chip::System::Clock::kZero;
+    chip::Inet::InterfaceId mMulticastInterface                = chip::Inet::InterfaceId::Null();
 };
 
 /// Iterates over an array of QueryResponderRecord items, providing only 'valid' ones, where
@@ -23,6 +23,7 @@
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/StringBuilderAdapters.h>
+#include <lib/dnssd/minimal_mdns/KnownAnswerList.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
@@ -31,6 +32,7 @@
 #include <lib/dnssd/minimal_mdns/responders/Txt.h>
 #include <lib/dnssd/minimal_mdns/tests/CheckOnlyServer.h>
 #include <lib/support/CHIPMem.h>
+#include <system/SystemClock.h>
 
 namespace {
 
@@ -84,6 +86,65 @@ struct CommonTestElements
     }
 };
 
+/// Builds a query packet within [storage] listing [record] as a known answer
+/// and collects it into [knownAnswers].
+template <size_t N>
+void BuildKnownAnswers(uint8_t (&storage)[N], const ResourceRecord & record, KnownAnswerList & knownAnswers)
+{
+    HeaderRef header(storage);
+    header.Clear();
+
+    Encoding::BigEndian::BufferWriter output(storage + HeaderRef::kSizeBytes, N - HeaderRef::kSizeBytes);
+    RecordWriter writer(&output);
+    EXPECT_TRUE(record.Append(header, ResourceType::kAnswer, writer));
+
+    BytesRange packet(storage, storage + HeaderRef::kSizeBytes + output.Needed());
+    knownAnswers.Reset(packet);
+
+    KnownAnswerCollector collector(knownAnswers);
+    EXPECT_TRUE(ParsePacket(packet, &collector));
+    EXPECT_EQ(knownAnswers.Count(), 1u);
+}
+
+constexpr uint16_t kMdnsPort = 5353;
+
+/// Checks the replies like CheckOnlyServer, and also counts the multicast ones.
+class MulticastCheckServer : public CheckOnlyServer
+{
+public:
+    using CheckOnlyServer::BroadcastSend;
+
+    CHIP_ERROR BroadcastSend(chip::System::PacketBufferHandle && data, uint16_t port, chip::Inet::InterfaceId interface,
+                             chip::Inet::IPAddressType addressType) override
+    {
+        mMulticastCount++;
+        return DirectSend(std::move(data), chip::Inet::IPAddress::Any, port, interface);
+    }
+
+    size_t GetMulticastCount() const { return mMulticastCount; }
+
+private:
+    size_t mMulticastCount = 0;
+};
+
+/// Installs a mock clock for the lifetime of the object.
+class ScopedMockClock
+{
+public:
+    ScopedMockClock() : mRealClock(&chip::System::SystemClock())
+    {
+        mMockClock.SetMonotonic(chip::System::Clock::Seconds64(100));
+        chip::System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+    ~ScopedMockClock() { chip::System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    void Advance(chip::System::Clock::Milliseconds64 increment) { mMockClock.AdvanceMonotonic(increment); }
+
+private:
+    chip::System::Clock::Internal::MockClock mMockClock;
+    chip::System::Clock::ClockBase * mRealClock;
+};
+
 class TestResponseSender : public ::testing::Test
 {
 public:
@@ -350,4 +411,241 @@ TEST_F(TestResponseSender, PtrSrvTxtMultipleRespondersToServiceListing)
     EXPECT_TRUE(common1->server.GetHeaderFound());
 }
 
+TEST_F(TestResponseSender, KnownAnswerSuppressesPtr)
+{
+    CommonTestElements common("test");
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Build a query for the service name
+    common.recordWriter.WriteQName(common.service);
+    QueryData queryData = QueryData(QType::PTR, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    // Querier already knows the PTR record with its full TTL
+    uint8_t knownAnswerStorage[128];
+    KnownAnswerList knownAnswers;
+    BuildKnownAnswers(knownAnswerStorage, common.ptrRecord, knownAnswers);
+
+    // PTR is suppressed, additional data is still sent
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+
+    responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration(), &knownAnswers);
+
+    EXPECT_TRUE(common.server.GetSendCalled());
+    EXPECT_TRUE(common.server.GetHeaderFound());
+    EXPECT_EQ(responseSender.GetSuppressedRecordCount(), 1u);
+}
+
+TEST_F(TestResponseSender, KnownAnswerWithLowTtlIsNotSuppressed)
+{
+    CommonTestElements common("test");
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Build a query for the service name
+    common.recordWriter.WriteQName(common.service);
+    QueryData queryData = QueryData(QType::PTR, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    // Querier knows the PTR record, however with less than half of its TTL remaining
+    PtrResourceRecord expiringRecord(common.service, common.instance);
+    expiringRecord.SetTtl(common.ptrRecord.GetTtl() / 2 - 1);
+
+    uint8_t knownAnswerStorage[128];
+    KnownAnswerList knownAnswers;
+    BuildKnownAnswers(knownAnswerStorage, expiringRecord, knownAnswers);
+
+    common.server.AddExpectedRecord(&common.ptrRecord);
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+
+    responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration(), &knownAnswers);
+
+    EXPECT_TRUE(common.server.GetSendCalled());
+    EXPECT_TRUE(common.server.GetHeaderFound());
+    EXPECT_EQ(responseSender.GetSuppressedRecordCount(), 0u);
+}
+
+TEST_F(TestResponseSender, KnownAnswerWithLargeTtlSuppressesPtr)
+{
+    CommonTestElements common("test");
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Build a query for the service name
+    common.recordWriter.WriteQName(common.service);
+    QueryData queryData = QueryData(QType::PTR, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    // Twice this TTL does not fit in 32 bits
+    PtrResourceRecord longLivedRecord(common.service, common.instance);
+    longLivedRecord.SetTtl(0x80000001);
+
+    uint8_t knownAnswerStorage[128];
+    KnownAnswerList knownAnswers;
+    BuildKnownAnswers(knownAnswerStorage, longLivedRecord, knownAnswers);
+
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+
+    responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration(), &knownAnswers);
+
+    EXPECT_TRUE(common.server.GetSendCalled());
+    EXPECT_TRUE(common.server.GetHeaderFound());
+    EXPECT_EQ(responseSender.GetSuppressedRecordCount(), 1u);
+}
+
+TEST_F(TestResponseSender, KnownAnswerSuppressesSrvAndTxt)
+{
+    CommonTestElements common("test");
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Build a query for the instance name
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    uint8_t knownAnswerStorage[128];
+    KnownAnswerList knownAnswers;
+    BuildKnownAnswers(knownAnswerStorage, common.txtRecord, knownAnswers);
+
+    // TXT is known, so only SRV is expected
+    common.server.AddExpectedRecord(&common.srvRecord);
+
+    responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration(), &knownAnswers);
+
+    EXPECT_TRUE(common.server.GetSendCalled());
+    EXPECT_TRUE(common.server.GetHeaderFound());
+    EXPECT_EQ(responseSender.GetSuppressedRecordCount(), 1u);
+}
+
+TEST_F(TestResponseSender, AggregatesMulticastReplies)
+{
+    CommonTestElements common("test");
+    MulticastCheckServer server;
+    ResponseSender responseSender(&server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    common.packetInfo.Clear();
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    // Two questions of the same packet, for the SRV and the TXT records of the instance
+    common.recordWriter.WriteQName(common.instance);
+    QueryData srvQuery(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+    QueryData txtQuery(QType::TXT, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    server.AddExpectedRecord(&common.srvRecord);
+    server.AddExpectedRecord(&common.txtRecord);
+
+    responseSender.BeginAggregation();
+    EXPECT_EQ(responseSender.Respond(1, srvQuery, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(responseSender.Respond(1, txtQuery, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_FALSE(server.GetSendCalled());
+
+    // Both answers go out in a single packet
+    EXPECT_EQ(responseSender.EndAggregation(), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 1u);
+    EXPECT_TRUE(server.GetHeaderFound());
+
+    // Without aggregation, each reply is sent right away
+    server.Reset();
+    server.AddExpectedRecord(&common.srvRecord);
+    common.queryResponder.ClearBroadcastThrottle();
+    EXPECT_EQ(responseSender.Respond(1, srvQuery, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 2u);
+    EXPECT_TRUE(server.GetHeaderFound());
+}
+
+TEST_F(TestResponseSender, UnicastReplyIsNotAggregated)
+{
+    CommonTestElements common("test");
+    MulticastCheckServer server;
+    ResponseSender responseSender(&server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+
+    common.packetInfo.Clear();
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData unicastQuery(QType::SRV, QClass::IN, true /* unicast response */, common.requestNameStart,
+                           common.requestBytesRange);
+
+    server.AddExpectedRecord(&common.srvRecord);
+
+    responseSender.BeginAggregation();
+    EXPECT_EQ(responseSender.Respond(1, unicastQuery, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_TRUE(server.GetSendCalled());
+    EXPECT_TRUE(server.GetHeaderFound());
+    EXPECT_EQ(server.GetMulticastCount(), 0u);
+
+    // Nothing is left to send
+    server.Reset();
+    EXPECT_EQ(responseSender.EndAggregation(), CHIP_NO_ERROR);
+    EXPECT_FALSE(server.GetSendCalled());
+}
+
+TEST_F(TestResponseSender, MulticastThrottledPerInterface)
+{
+    ScopedMockClock clock;
+    CommonTestElements common("test");
+    MulticastCheckServer server;
+    ResponseSender responseSender(&server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+    server.AddExpectedRecord(&common.srvRecord);
+
+    Inet::IPPacketInfo packetInfoA;
+    packetInfoA.Clear();
+    packetInfoA.SrcPort   = kMdnsPort;
+    packetInfoA.Interface = Inet::InterfaceId(1);
+
+    Inet::IPPacketInfo packetInfoB = packetInfoA;
+    packetInfoB.Interface          = Inet::InterfaceId(2);
+
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoA, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 1u);
+    EXPECT_TRUE(server.GetHeaderFound());
+
+    // Multicast at most once per second on an interface...
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoA, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 1u);
+
+    // ...without throttling the other interfaces.
+    server.Reset();
+    server.AddExpectedRecord(&common.srvRecord);
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoB, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 2u);
+    EXPECT_TRUE(server.GetHeaderFound());
+
+    // Multicasting on the other interface does not lift the throttling of the first one.
+    clock.Advance(chip::System::Clock::Milliseconds64(500));
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoA, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoB, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 2u);
+
+    // Once a second went by, the record is multicast again.
+    clock.Advance(chip::System::Clock::Milliseconds64(600));
+    server.Reset();
+    server.AddExpectedRecord(&common.srvRecord);
+    EXPECT_EQ(responseSender.Respond(1, queryData, &packetInfoA, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_EQ(server.GetMulticastCount(), 3u);
+    EXPECT_TRUE(server.GetHeaderFound());
+}
+
 } // namespace
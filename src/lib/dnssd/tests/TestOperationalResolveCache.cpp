@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/dnssd/OperationalResolveCache.h>
+#include <lib/support/CHIPMemString.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using mdns::Minimal::OperationalResolveCache;
+
+using TestCache = OperationalResolveCache<2>;
+
+Dnssd::ResolvedNodeData MakeNodeData(NodeId nodeId, const char * host = "hostname")
+{
+    Dnssd::ResolvedNodeData data;
+    data.operationalData.peerId     = PeerId().SetNodeId(nodeId).SetCompressedFabricId(123);
+    data.operationalData.hasZeroTTL = false;
+    Platform::CopyString(data.resolutionData.hostName, host);
+    data.resolutionData.port   = 5540;
+    data.resolutionData.numIPs = 1;
+    EXPECT_TRUE(Inet::IPAddress::FromString("fe80::1", data.resolutionData.ipAddress[0]));
+    return data;
+}
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    return PeerId().SetNodeId(nodeId).SetCompressedFabricId(123);
+}
+
+TEST(TestOperationalResolveCache, TestHitAndExpiry)
+{
+    System::Clock::Internal::MockClock mockClock;
+    TestCache cache(&mockClock);
+    Dnssd::ResolvedNodeData out;
+
+    mockClock.AdvanceMonotonic(1234_ms32);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kMiss);
+
+    cache.Store(MakeNodeData(1), 100);
+    EXPECT_EQ(cache.Count(), 1u);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kHit);
+    EXPECT_EQ(out.operationalData.peerId, MakePeerId(1));
+    EXPECT_EQ(out.resolutionData.port, 5540);
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), out), TestCache::LookupResult::kMiss);
+
+    // Past 80% of the TTL a refresh is recommended
+    mockClock.AdvanceMonotonic(81_s);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kHitNeedsRefresh);
+
+    // Expired
+    mockClock.AdvanceMonotonic(20_s);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kMiss);
+    EXPECT_EQ(cache.Count(), 0u);
+}
+
+TEST(TestOperationalResolveCache, TestZeroTtlRemoves)
+{
+    System::Clock::Internal::MockClock mockClock;
+    TestCache cache(&mockClock);
+    Dnssd::ResolvedNodeData out;
+
+    cache.Store(MakeNodeData(1), 120);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kHit);
+
+    // Goodbye packet
+    Dnssd::ResolvedNodeData goodbye = MakeNodeData(1);
+    goodbye.operationalData.hasZeroTTL = true;
+    cache.Store(goodbye, 120);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kMiss);
+
+    cache.Store(MakeNodeData(1), 120);
+    cache.Store(MakeNodeData(1), 0);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kMiss);
+}
+
+TEST(TestOperationalResolveCache, TestLeastRecentlyUsedReplacement)
+{
+    System::Clock::Internal::MockClock mockClock;
+    TestCache cache(&mockClock);
+    Dnssd::ResolvedNodeData out;
+
+    cache.Store(MakeNodeData(1), 120);
+    mockClock.AdvanceMonotonic(1_s);
+    cache.Store(MakeNodeData(2), 120);
+    mockClock.AdvanceMonotonic(1_s);
+
+    // Use node 1, so that node 2 becomes the least recently used
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kHit);
+    mockClock.AdvanceMonotonic(1_s);
+
+    cache.Store(MakeNodeData(3), 120);
+    EXPECT_EQ(cache.Count(), 2u);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kHit);
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), out), TestCache::LookupResult::kMiss);
+    EXPECT_EQ(cache.Lookup(MakePeerId(3), out), TestCache::LookupResult::kHit);
+}
+
+TEST(TestOperationalResolveCache, TestPendingDelivery)
+{
+    System::Clock::Internal::MockClock mockClock;
+    TestCache cache(&mockClock);
+    Dnssd::ResolvedNodeData out;
+
+    EXPECT_FALSE(cache.MarkPendingDelivery(MakePeerId(1)));
+    EXPECT_FALSE(cache.TakePendingDelivery(out));
+
+    cache.Store(MakeNodeData(1), 120);
+    cache.Store(MakeNodeData(2), 120);
+    EXPECT_TRUE(cache.MarkPendingDelivery(MakePeerId(2)));
+
+    EXPECT_TRUE(cache.TakePendingDelivery(out));
+    EXPECT_EQ(out.operationalData.peerId, MakePeerId(2));
+    EXPECT_FALSE(cache.TakePendingDelivery(out));
+}
+
+TEST(TestOperationalResolveCache, TestRemoveHostAddress)
+{
+    System::Clock::Internal::MockClock mockClock;
+    TestCache cache(&mockClock);
+    Dnssd::ResolvedNodeData out;
+
+    cache.Store(MakeNodeData(1, "host1"), 120);
+    cache.Store(MakeNodeData(2, "host2"), 120);
+
+    Inet::IPAddress other;
+    EXPECT_TRUE(Inet::IPAddress::FromString("fe80::2", other));
+    cache.RemoveHostAddress("host1", other);
+    EXPECT_EQ(cache.Count(), 2u);
+
+    cache.RemoveHostAddress("host1", MakeNodeData(1).resolutionData.ipAddress[0]);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), out), TestCache::LookupResult::kMiss);
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), out), TestCache::LookupResult::kHit);
+}
+
+} // namespace
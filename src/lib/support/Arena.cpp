@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "Arena.h"
+
+#include <lib/support/CHIPMem.h>
+
+namespace chip {
+
+Arena::Block * Arena::NewBlock(size_t size)
+{
+    Block * block = static_cast<Block *>(Platform::MemoryAlloc(kBlockHeaderSize + size));
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    block->mSize = size;
+    mStats.mBytesReserved += size;
+    mStats.mBlockCount++;
+    mStats.mBlockAllocations++;
+    return block;
+}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || size > SIZE_MAX / 2)
+    {
+        return nullptr;
+    }
+
+    uintptr_t cursor  = reinterpret_cast<uintptr_t>(mCursor);
+    uintptr_t aligned = (cursor + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    if (mCursor != nullptr && aligned <= reinterpret_cast<uintptr_t>(mEnd) &&
+        size <= static_cast<size_t>(reinterpret_cast<uintptr_t>(mEnd) - aligned))
+    {
+        mCursor = reinterpret_cast<uint8_t *>(aligned + size);
+        mStats.mAllocations++;
+        mStats.mBytesUsed += static_cast<size_t>(aligned - cursor) + size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Worst case padding when the payload is only aligned to max_align_t.
+    size_t padding = (alignment > alignof(std::max_align_t)) ? alignment - alignof(std::max_align_t) : 0;
+    size_t needed  = size + padding;
+
+    if (needed > mBlockSize / 2 && mCursor != nullptr)
+    {
+        // Large allocations get a block of their own, so the space left in the
+        // current block is not thrown away.
+        Block * block = NewBlock(needed);
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        block->mNext = mBlocks;
+        mBlocks      = block;
+
+        uintptr_t payload = reinterpret_cast<uintptr_t>(Payload(block));
+        aligned           = (payload + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        mStats.mAllocations++;
+        mStats.mBytesUsed += needed;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    Block * block = NewBlock((needed > mBlockSize) ? needed : mBlockSize);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    // Whatever is left at the end of the previous block is lost until Reset().
+    block->mNext = mBlocks;
+    mBlocks      = block;
+    mCursor      = Payload(block);
+    mEnd         = mCursor + block->mSize;
+
+    return Allocate(size, alignment);
+}
+
+void Arena::RunCleanups()
+{
+    while (mCleanups != nullptr)
+    {
+        Cleanup * cleanup = mCleanups;
+        mCleanups         = cleanup->mNext;
+        cleanup->mDestroy(cleanup->mObject);
+    }
+}
+
+void Arena::Reset()
+{
+    RunCleanups();
+    if (mBlocks == nullptr)
+    {
+        return;
+    }
+
+    // Keep the oldest block, which is the one every transaction starts with.
+    while (mBlocks->mNext != nullptr)
+    {
+        Block * block = mBlocks;
+        mBlocks       = block->mNext;
+        mStats.mBytesReserved -= block->mSize;
+        mStats.mBlockCount--;
+        Platform::MemoryFree(block);
+    }
+
+    mCursor             = Payload(mBlocks);
+    mEnd                = mCursor + mBlocks->mSize;
+    mStats.mAllocations = 0;
+    mStats.mBytesUsed   = 0;
+}
+
+void Arena::Release()
+{
+    RunCleanups();
+    while (mBlocks != nullptr)
+    {
+        Block * block = mBlocks;
+        mBlocks       = block->mNext;
+        Platform::MemoryFree(block);
+    }
+
+    mCursor               = nullptr;
+    mEnd                  = nullptr;
+    mStats.mAllocations   = 0;
+    mStats.mBytesUsed     = 0;
+    mStats.mBytesReserved = 0;
+    mStats.mBlockCount    = 0;
+}
+
+} // namespace chip
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * Defines a region allocator for state whose lifetime is bound to a single
+ * transaction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace chip {
+
+/**
+ * Memory allocator that serves allocations out of heap blocks and releases
+ * them all at once.
+ *
+ * Allocations are bumped out of the current block; a new block is obtained
+ * from Platform::MemoryAlloc when it runs out.  Individual allocations cannot
+ * be freed: Reset() drops everything while keeping the first block for reuse,
+ * and Release() (also run by the destructor) returns every block to the heap.
+ *
+ * Objects created with New() that are not trivially destructible have their
+ * destructor run, in reverse order of creation, when the arena is reset or
+ * released.
+ */
+class Arena
+{
+public:
+    struct Statistics
+    {
+        size_t mAllocations      = 0; ///< Allocations served since the last Reset().
+        size_t mBytesUsed        = 0; ///< Bytes handed out since the last Reset(), including alignment padding.
+        size_t mBytesReserved    = 0; ///< Bytes held in blocks; mBytesReserved - mBytesUsed is lost to fragmentation.
+        size_t mBlockCount       = 0; ///< Blocks currently held.
+        size_t mBlockAllocations = 0; ///< Blocks obtained from the heap over the lifetime of the arena.
+    };
+
+    static constexpr size_t kDefaultBlockSize = 512;
+
+    explicit Arena(size_t blockSize = kDefaultBlockSize) : mBlockSize(blockSize) {}
+    ~Arena() { Release(); }
+
+    /**
+     * Allocate a specified number of bytes.
+     *
+     * @param size      Number of bytes to allocate.
+     * @param alignment Required alignment, a power of two.
+     * @return          Pointer to the allocated memory region or nullptr on failure.
+     */
+    void * Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Allocate and construct an object.
+     *
+     * @return          Pointer to the new object or nullptr on failure.
+     */
+    template <typename T, typename... Args>
+    T * New(Args &&... args)
+    {
+        Cleanup * cleanup = nullptr;
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            cleanup = static_cast<Cleanup *>(Allocate(sizeof(Cleanup), alignof(Cleanup)));
+            if (cleanup == nullptr)
+            {
+                return nullptr;
+            }
+        }
+
+        void * memory = Allocate(sizeof(T), alignof(T));
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        T * object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            cleanup->mDestroy = [](void * p) { static_cast<T *>(p)->~T(); };
+            cleanup->mObject  = object;
+            cleanup->mNext    = mCleanups;
+            mCleanups         = cleanup;
+        }
+        return object;
+    }
+
+    /**
+     * Drop every allocation.  The first block is kept so that an arena reused
+     * for transactions of similar size does not go back to the heap.
+     */
+    void Reset();
+
+    /**
+     * Drop every allocation and return all blocks to the heap.
+     */
+    void Release();
+
+    bool IsEmpty() const { return mStats.mAllocations == 0; }
+    const Statistics & GetStatistics() const { return mStats; }
+
+private:
+    struct Block
+    {
+        Block * mNext;
+        size_t mSize;
+    };
+
+    struct Cleanup
+    {
+        void (*mDestroy)(void *);
+        void * mObject;
+        Cleanup * mNext;
+    };
+
+    Arena(const Arena &)             = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    static constexpr size_t kBlockHeaderSize =
+        (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    static uint8_t * Payload(Block * block) { return reinterpret_cast<uint8_t *>(block) + kBlockHeaderSize; }
+    Block * NewBlock(size_t size);
+    void RunCleanups();
+
+    const size_t mBlockSize;
+    Block * mBlocks     = nullptr; // Most recently allocated first; the last one is kept by Reset().
+    uint8_t * mCursor   = nullptr;
+    uint8_t * mEnd      = nullptr;
+    Cleanup * mCleanups = nullptr; // Most recently created object first.
+    Statistics mStats;
+};
+
+} // namespace chip
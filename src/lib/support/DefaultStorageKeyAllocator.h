@@ -220,6 +220,9 @@ public:
     }
     static StorageKeyName SubscriptionResumptionMaxCount() { return StorageKeyName::Formatted("g/sum"); }
 
+    // Data versions of the clusters of an endpoint, along with snapshots of their attribute values.
+    static StorageKeyName ClusterDataVersions(EndpointId endpoint) { return StorageKeyName::Formatted("g/dv/%x", endpoint); }
+
     // Number of scenes stored in a given endpoint's scene table, across all fabrics.
     static StorageKeyName EndpointSceneCountKey(EndpointId endpoint) { return StorageKeyName::Formatted("g/scc/e/%x", endpoint); }
 
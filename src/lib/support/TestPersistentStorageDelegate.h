@@ -25,6 +25,7 @@
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -87,7 +88,7 @@ public:
                           static_cast<unsigned>(size));
         }
 
-        CHIP_ERROR err = SyncSetKeyValueInternal(key, value, size);
+        CHIP_ERROR err = mInTransaction ? StageSetKeyValue(key, value, size) : SyncSetKeyValueInternal(key, value, size);
 
         if (mLoggingLevel >= LoggingLevel::kLogMutationAndReads)
         {
@@ -107,7 +108,7 @@ public:
         {
             ChipLogDetail(Test, "TestPersistentStorageDelegate::SyncDeleteKeyValue, Delete key '%s'", StringOrNullMarker(key));
         }
-        CHIP_ERROR err = SyncDeleteKeyValueInternal(key);
+        CHIP_ERROR err = mInTransaction ? StageDeleteKeyValue(key) : SyncDeleteKeyValueInternal(key);
 
         if (mLoggingLevel >= LoggingLevel::kLogMutation)
         {
@@ -126,6 +127,49 @@ public:
         return err;
     }
 
+    CHIP_ERROR SyncBeginTransaction() override
+    {
+        VerifyOrReturnError(!mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+        mInTransaction = true;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncCommitTransaction() override
+    {
+        VerifyOrReturnError(mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+        std::map<std::string, std::optional<std::vector<uint8_t>>> transaction = std::move(mTransaction);
+        SyncAbortTransaction();
+
+        // Rejected writes fail the whole transaction, before anything is applied.
+        VerifyOrReturnError(!mRejectWrites, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        for (auto & entry : transaction)
+        {
+            if (entry.second.has_value())
+            {
+                const std::vector<uint8_t> & value = entry.second.value();
+                ReturnErrorOnFailure(SyncSetKeyValueInternal(entry.first.c_str(), value.empty() ? nullptr : value.data(),
+                                                             static_cast<uint16_t>(value.size())));
+            }
+            else if (HasKey(entry.first))
+            {
+                ReturnErrorOnFailure(SyncDeleteKeyValueInternal(entry.first.c_str()));
+            }
+        }
+        mCommittedTransactionCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void SyncAbortTransaction() override
+    {
+        mTransaction.clear();
+        mInTransaction = false;
+    }
+
+    /**
+     * @return the number of transactions committed so far
+     */
+    virtual size_t GetCommittedTransactionCount() { return mCommittedTransactionCount; }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -276,10 +320,41 @@ protected:
         return CHIP_NO_ERROR;
     }
 
+    virtual CHIP_ERROR StageSetKeyValue(const char * key, const void * value, uint16_t size)
+    {
+        if (mRejectWrites || mPoisonKeys.find(std::string(key)) != mPoisonKeys.end())
+        {
+            return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+        }
+        VerifyOrReturnError(value != nullptr || size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+        const uint8_t * bytes = static_cast<const uint8_t *>(value);
+        mTransaction[key]     = (size == 0) ? std::vector<uint8_t>() : std::vector<uint8_t>(bytes, bytes + size);
+        return CHIP_NO_ERROR;
+    }
+
+    virtual CHIP_ERROR StageDeleteKeyValue(const char * key)
+    {
+        if (mRejectWrites || mPoisonKeys.find(std::string(key)) != mPoisonKeys.end())
+        {
+            return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+        }
+
+        auto staged   = mTransaction.find(key);
+        bool contains = (staged != mTransaction.end()) ? staged->second.has_value() : HasKey(key);
+        VerifyOrReturnError(contains, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        mTransaction[key] = std::nullopt;
+        return CHIP_NO_ERROR;
+    }
+
     std::map<std::string, std::vector<uint8_t>> mStorage;
+    // Sets (with a value) and deletes (without) of the current transaction, applied on commit.
+    std::map<std::string, std::optional<std::vector<uint8_t>>> mTransaction;
     std::set<std::string> mPoisonKeys;
-    bool mRejectWrites         = false;
-    LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
+    bool mRejectWrites                = false;
+    bool mInTransaction               = false;
+    size_t mCommittedTransactionCount = 0;
+    LoggingLevel mLoggingLevel        = LoggingLevel::kDisabled;
 };
 
 } // namespace chip
@@ -19,11 +19,13 @@
 
 #include <algorithm>
 #include <charconv>
-#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include <json/json.h>
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/jsontlv/ElementTypes.h>
@@ -38,61 +40,422 @@ namespace {
 // This profile, but will be used for deciding what binary values to encode.
 constexpr uint32_t kTemporaryImplicitProfileId = 0xFF01;
 
-std::vector<std::string> SplitIntoFieldsBySeparator(const std::string & input, char separator)
+// Data model payloads are only a few levels deep. This bounds the recursion on untrusted input.
+constexpr size_t kMaxNestingDepth = 64;
+
+enum class JsonTokenType : uint8_t
+{
+    kObject,
+    kArray,
+    kString,
+    kNumber,
+    kTrue,
+    kFalse,
+    kNull,
+};
+
+/*
+ * A JSON value, as found by JsonTokenizer. Values are stored in document order, so the members of an
+ * object (a name string followed by its value) and the elements of an array directly follow the
+ * container token.
+ */
+struct JsonToken
+{
+    JsonTokenType type;
+    bool hasEscapes = false; // kString only
+    uint32_t offset = 0;     // kString: first character after the opening quote. kNumber: first character.
+    uint32_t length = 0;     // kString, kNumber: length of the raw text. kObject: member count. kArray: element count.
+    uint32_t next   = 0;     // index of the token following this value, including all of its children
+};
+
+/*
+ * Splits a JSON document into a flat list of tokens in a single pass, without building a DOM.
+ *
+ * This validates the syntax of the whole document, so that syntax errors are reported before anything
+ * is encoded. The grammar follows what Json::Reader used to accept: comments are allowed, and anything
+ * following the top level value is ignored.
+ */
+class JsonTokenizer
+{
+public:
+    JsonTokenizer(const std::string & json, std::vector<JsonToken> & tokens) :
+        mBegin(json.data()), mCurrent(json.data()), mEnd(json.data() + json.size()), mTokens(tokens)
+    {}
+
+    bool Tokenize()
+    {
+        VerifyOrReturnValue(CanCastTo<uint32_t>(mEnd - mBegin), false);
+        mTokens.clear();
+        return ParseValue(0);
+    }
+
+private:
+    bool ParseValue(size_t depth);
+    bool ParseObject(size_t depth);
+    bool ParseArray(size_t depth);
+    bool ParseString();
+    bool ParseNumber();
+    bool ParseLiteral(const char * literal, JsonTokenType type);
+    bool SkipWhitespace();
+
+    bool Consume(char c)
+    {
+        VerifyOrReturnValue(SkipWhitespace() && mCurrent != mEnd && *mCurrent == c, false);
+        mCurrent++;
+        return true;
+    }
+
+    uint32_t Offset() const { return static_cast<uint32_t>(mCurrent - mBegin); }
+
+    size_t AddToken(JsonTokenType type)
+    {
+        JsonToken token;
+        token.type   = type;
+        token.offset = Offset();
+        mTokens.push_back(token);
+        return mTokens.size() - 1;
+    }
+
+    const char * const mBegin;
+    const char * mCurrent;
+    const char * const mEnd;
+    std::vector<JsonToken> & mTokens;
+};
+
+bool IsHexDigit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool JsonTokenizer::SkipWhitespace()
+{
+    while (mCurrent != mEnd)
+    {
+        const char c = *mCurrent;
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        {
+            mCurrent++;
+        }
+        else if (c == '/' && mEnd - mCurrent >= 2 && mCurrent[1] == '*')
+        {
+            static constexpr char kCommentEnd[] = "*/";
+            const char * commentEnd             = std::search(mCurrent + 2, mEnd, kCommentEnd, kCommentEnd + 2);
+            VerifyOrReturnValue(commentEnd != mEnd, false);
+            mCurrent = commentEnd + 2;
+        }
+        else if (c == '/' && mEnd - mCurrent >= 2 && mCurrent[1] == '/')
+        {
+            while (mCurrent != mEnd && *mCurrent != '\n' && *mCurrent != '\r')
+            {
+                mCurrent++;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+bool JsonTokenizer::ParseValue(size_t depth)
+{
+    VerifyOrReturnValue(depth <= kMaxNestingDepth && SkipWhitespace() && mCurrent != mEnd, false);
+
+    switch (*mCurrent)
+    {
+    case '{':
+        return ParseObject(depth + 1);
+    case '[':
+        return ParseArray(depth + 1);
+    case '"':
+        return ParseString();
+    case 't':
+        return ParseLiteral("true", JsonTokenType::kTrue);
+    case 'f':
+        return ParseLiteral("false", JsonTokenType::kFalse);
+    case 'n':
+        return ParseLiteral("null", JsonTokenType::kNull);
+    default:
+        return ParseNumber();
+    }
+}
+
+bool JsonTokenizer::ParseObject(size_t depth)
+{
+    const size_t index = AddToken(JsonTokenType::kObject);
+    uint32_t count     = 0;
+
+    mCurrent++; // '{'
+    if (!Consume('}'))
+    {
+        do
+        {
+            VerifyOrReturnValue(SkipWhitespace() && mCurrent != mEnd && *mCurrent == '"', false);
+            VerifyOrReturnValue(ParseString() && Consume(':') && ParseValue(depth), false);
+            count++;
+        } while (Consume(','));
+        VerifyOrReturnValue(Consume('}'), false);
+    }
+
+    mTokens[index].length = count;
+    mTokens[index].next   = static_cast<uint32_t>(mTokens.size());
+    return true;
+}
+
+bool JsonTokenizer::ParseArray(size_t depth)
+{
+    const size_t index = AddToken(JsonTokenType::kArray);
+    uint32_t count     = 0;
+
+    mCurrent++; // '['
+    if (!Consume(']'))
+    {
+        do
+        {
+            VerifyOrReturnValue(ParseValue(depth), false);
+            count++;
+        } while (Consume(','));
+        VerifyOrReturnValue(Consume(']'), false);
+    }
+
+    mTokens[index].length = count;
+    mTokens[index].next   = static_cast<uint32_t>(mTokens.size());
+    return true;
+}
+
+bool JsonTokenizer::ParseString()
+{
+    mCurrent++; // '"'
+    const size_t index = AddToken(JsonTokenType::kString);
+    bool hasEscapes    = false;
+
+    while (mCurrent != mEnd && *mCurrent != '"')
+    {
+        if (*mCurrent != '\\')
+        {
+            mCurrent++;
+            continue;
+        }
+
+        hasEscapes = true;
+        VerifyOrReturnValue(mEnd - mCurrent >= 2, false);
+        const char escaped = mCurrent[1];
+        mCurrent += 2;
+
+        if (escaped == 'u')
+        {
+            VerifyOrReturnValue(mEnd - mCurrent >= 4 && std::all_of(mCurrent, mCurrent + 4, IsHexDigit), false);
+            const bool isHighSurrogate = (mCurrent[0] == 'd' || mCurrent[0] == 'D') && strchr("89abAB", mCurrent[1]) != nullptr;
+            mCurrent += 4;
+
+            // A high surrogate must be followed by the rest of its pair.
+            if (isHighSurrogate)
+            {
+                VerifyOrReturnValue(mEnd - mCurrent >= 6 && mCurrent[0] == '\\' && mCurrent[1] == 'u', false);
+                VerifyOrReturnValue(std::all_of(mCurrent + 2, mCurrent + 6, IsHexDigit), false);
+                mCurrent += 6;
+            }
+        }
+        else
+        {
+            VerifyOrReturnValue(escaped != '\0' && strchr("\"/\\bfnrt", escaped) != nullptr, false);
+        }
+    }
+    VerifyOrReturnValue(mCurrent != mEnd, false);
+
+    mTokens[index].hasEscapes = hasEscapes;
+    mTokens[index].length     = Offset() - mTokens[index].offset;
+    mTokens[index].next       = static_cast<uint32_t>(mTokens.size());
+    mCurrent++; // '"'
+    return true;
+}
+
+bool JsonTokenizer::ParseNumber()
 {
-    std::vector<std::string> substrings;
-    std::stringstream ss(input);
-    std::string substring;
+    const size_t index = AddToken(JsonTokenType::kNumber);
+
+    if (*mCurrent == '-')
+    {
+        mCurrent++;
+    }
+    const char * digits = mCurrent;
+    mCurrent            = std::find_if_not(mCurrent, mEnd, IsDigit);
+    VerifyOrReturnValue(mCurrent != digits, false);
 
-    while (std::getline(ss, substring, separator))
+    if (mCurrent != mEnd && *mCurrent == '.')
     {
-        substrings.push_back(std::move(substring));
+        mCurrent = std::find_if_not(mCurrent + 1, mEnd, IsDigit);
+    }
+    if (mCurrent != mEnd && (*mCurrent == 'e' || *mCurrent == 'E'))
+    {
+        mCurrent++;
+        if (mCurrent != mEnd && (*mCurrent == '+' || *mCurrent == '-'))
+        {
+            mCurrent++;
+        }
+        digits   = mCurrent;
+        mCurrent = std::find_if_not(mCurrent, mEnd, IsDigit);
+        VerifyOrReturnValue(mCurrent != digits, false);
     }
 
-    return substrings;
+    mTokens[index].length = Offset() - mTokens[index].offset;
+    mTokens[index].next   = static_cast<uint32_t>(mTokens.size());
+    return true;
+}
+
+bool JsonTokenizer::ParseLiteral(const char * literal, JsonTokenType type)
+{
+    const size_t length = strlen(literal);
+    VerifyOrReturnValue(static_cast<size_t>(mEnd - mCurrent) >= length && memcmp(mCurrent, literal, length) == 0, false);
+
+    const size_t index  = AddToken(type);
+    mCurrent           += length;
+    mTokens[index].next = static_cast<uint32_t>(mTokens.size());
+    return true;
+}
+
+uint32_t ParseHex16(const char * hex)
+{
+    uint32_t value = 0;
+    std::from_chars(hex, hex + 4, value, 16);
+    return value;
+}
+
+void AppendUtf8(std::string & out, uint32_t codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
 }
 
-CHIP_ERROR JsonTypeStrToTlvType(const char * elementType, ElementTypeContext & type)
+/// Unescapes the raw text of a string token, which JsonTokenizer already validated.
+void UnescapeJsonString(std::string_view raw, std::string & out)
 {
-    if (strcmp(elementType, kElementTypeInt) == 0)
+    out.clear();
+    for (size_t i = 0; i < raw.size(); i++)
+    {
+        if (raw[i] != '\\')
+        {
+            out += raw[i];
+            continue;
+        }
+
+        const char escaped = raw[++i];
+        switch (escaped)
+        {
+        case 'b':
+            out += '\b';
+            break;
+        case 'f':
+            out += '\f';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'u': {
+            uint32_t codePoint = ParseHex16(&raw[i + 1]);
+            i += 4;
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                codePoint = 0x10000 + ((codePoint & 0x3FF) << 10) + (ParseHex16(&raw[i + 3]) & 0x3FF);
+                i += 6;
+            }
+            AppendUtf8(out, codePoint);
+            break;
+        }
+        default: // '"', '\\' and '/'
+            out += escaped;
+            break;
+        }
+    }
+}
+
+/// Splits `input` like std::getline would: a trailing separator does not start an extra empty field.
+size_t SplitIntoFieldsBySeparator(std::string_view input, char separator, std::string_view * fields, size_t maxFields)
+{
+    size_t count = 0;
+    while (!input.empty())
+    {
+        const size_t end = input.find(separator);
+        VerifyOrReturnValue(count < maxFields, maxFields + 1);
+        fields[count++] = input.substr(0, end);
+        input           = (end == std::string_view::npos) ? std::string_view() : input.substr(end + 1);
+    }
+    return count;
+}
+
+CHIP_ERROR JsonTypeStrToTlvType(std::string_view elementType, ElementTypeContext & type)
+{
+    if (elementType == kElementTypeInt)
     {
         type.tlvType = TLV::kTLVType_SignedInteger;
     }
-    else if (strcmp(elementType, kElementTypeUInt) == 0)
+    else if (elementType == kElementTypeUInt)
     {
         type.tlvType = TLV::kTLVType_UnsignedInteger;
     }
-    else if (strcmp(elementType, kElementTypeBool) == 0)
+    else if (elementType == kElementTypeBool)
     {
         type.tlvType = TLV::kTLVType_Boolean;
     }
-    else if (strcmp(elementType, kElementTypeFloat) == 0)
+    else if (elementType == kElementTypeFloat)
     {
         type.tlvType  = TLV::kTLVType_FloatingPointNumber;
         type.isDouble = false;
     }
-    else if (strcmp(elementType, kElementTypeDouble) == 0)
+    else if (elementType == kElementTypeDouble)
     {
         type.tlvType  = TLV::kTLVType_FloatingPointNumber;
         type.isDouble = true;
     }
-    else if (strcmp(elementType, kElementTypeBytes) == 0)
+    else if (elementType == kElementTypeBytes)
     {
         type.tlvType = TLV::kTLVType_ByteString;
     }
-    else if (strcmp(elementType, kElementTypeString) == 0)
+    else if (elementType == kElementTypeString)
     {
         type.tlvType = TLV::kTLVType_UTF8String;
     }
-    else if (strcmp(elementType, kElementTypeNull) == 0)
+    else if (elementType == kElementTypeNull)
     {
         type.tlvType = TLV::kTLVType_Null;
     }
-    else if (strcmp(elementType, kElementTypeStruct) == 0)
+    else if (elementType == kElementTypeStruct)
     {
         type.tlvType = TLV::kTLVType_Structure;
     }
-    else if (strncmp(elementType, kElementTypeArray, strlen(kElementTypeArray)) == 0)
+    else if (elementType.compare(0, strlen(kElementTypeArray), kElementTypeArray) == 0)
     {
         type.tlvType = TLV::kTLVType_Array;
     }
@@ -106,23 +469,13 @@ CHIP_ERROR JsonTypeStrToTlvType(const char * elementType, ElementTypeContext & t
 
 struct ElementContext
 {
-    std::string jsonName;
-    TLV::Tag tag = TLV::AnonymousTag();
+    uint32_t nameToken  = 0; // index of the JSON name token, for structure members
+    uint32_t valueToken = 0; // index of the JSON value token
+    TLV::Tag tag        = TLV::AnonymousTag();
     ElementTypeContext type;
     ElementTypeContext subType;
 };
 
-bool CompareByTag(const ElementContext & a, const ElementContext & b)
-{
-    // If tags are of the same type compare by tag number
-    if (IsContextTag(a.tag) == IsContextTag(b.tag))
-    {
-        return TLV::TagNumFromTag(a.tag) < TLV::TagNumFromTag(b.tag);
-    }
-    // Otherwise, compare by tag type: context tags first followed by common profile tags
-    return IsContextTag(a.tag);
-}
-
 // The profileId parameter is used when encoding a tag for a TLV element to specify the profile that the tag belongs to.
 // If the vendor ID is zero but the tag ID does not fit within an 8-bit value, the function uses Implicit Profile Tag.
 // Here, the kTemporaryImplicitProfileId serves as a default value for cases where no explicit profile ID is provided by
@@ -149,7 +502,7 @@ CHIP_ERROR InternalConvertTlvTag(uint32_t tagNumber, TLV::Tag & tag, const uint3
 }
 
 template <typename T>
-CHIP_ERROR ParseNumericalField(const std::string & decimalString, T & outValue)
+CHIP_ERROR ParseNumericalField(std::string_view decimalString, T & outValue)
 {
     const char * start_ptr       = decimalString.data();
     const char * end_ptr         = decimalString.data() + decimalString.size();
@@ -158,27 +511,26 @@ CHIP_ERROR ParseNumericalField(const std::string & decimalString, T & outValue)
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR ParseJsonName(const std::string & name, ElementContext & elementCtx, uint32_t implicitProfileId)
+CHIP_ERROR ParseJsonName(std::string_view name, ElementContext & elementCtx, uint32_t implicitProfileId)
 {
-    uint32_t tagNumber                  = 0;
-    const char * elementType            = nullptr;
-    std::vector<std::string> nameFields = SplitIntoFieldsBySeparator(name, ':');
-    TLV::Tag tag                        = TLV::AnonymousTag();
+    uint32_t tagNumber = 0;
+    std::string_view nameFields[3];
+    std::string_view elementType;
+    TLV::Tag tag = TLV::AnonymousTag();
     ElementTypeContext type;
     ElementTypeContext subType;
 
-    if (nameFields.size() == 2)
+    switch (SplitIntoFieldsBySeparator(name, ':', nameFields, ArraySize(nameFields)))
     {
+    case 2:
         ReturnErrorOnFailure(ParseNumericalField(nameFields[0], tagNumber));
-        elementType = nameFields[1].c_str();
-    }
-    else if (nameFields.size() == 3)
-    {
+        elementType = nameFields[1];
+        break;
+    case 3:
         ReturnErrorOnFailure(ParseNumericalField(nameFields[1], tagNumber));
-        elementType = nameFields[2].c_str();
-    }
-    else
-    {
+        elementType = nameFields[2];
+        break;
+    default:
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
@@ -187,42 +539,183 @@ CHIP_ERROR ParseJsonName(const std::string & name, ElementContext & elementCtx,
 
     if (type.tlvType == TLV::kTLVType_Array)
     {
-        std::vector<std::string> arrayFields = SplitIntoFieldsBySeparator(elementType, '-');
-        VerifyOrReturnError(arrayFields.size() == 2, CHIP_ERROR_INVALID_ARGUMENT);
+        std::string_view arrayFields[2];
+        VerifyOrReturnError(SplitIntoFieldsBySeparator(elementType, '-', arrayFields, ArraySize(arrayFields)) == 2,
+                            CHIP_ERROR_INVALID_ARGUMENT);
 
-        if (strcmp(arrayFields[1].c_str(), kElementTypeEmpty) == 0)
+        if (arrayFields[1] == kElementTypeEmpty)
         {
             subType.tlvType = TLV::kTLVType_NotSpecified;
         }
         else
         {
-            ReturnErrorOnFailure(JsonTypeStrToTlvType(arrayFields[1].c_str(), subType));
+            ReturnErrorOnFailure(JsonTypeStrToTlvType(arrayFields[1], subType));
         }
     }
 
-    elementCtx.jsonName = name;
-    elementCtx.tag      = tag;
-    elementCtx.type     = type;
-    elementCtx.subType  = subType;
+    elementCtx.tag     = tag;
+    elementCtx.type    = type;
+    elementCtx.subType = subType;
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, const ElementContext & elementCtx)
+/*
+ * A JSON number. Integers are kept exact, like Json::Value does, so that 64-bit values do not go
+ * through a double.
+ */
+struct JsonNumber
+{
+    bool isInteger      = false;
+    bool isNegative     = false;
+    uint64_t magnitude  = 0; // isInteger only
+    double floatingPart = 0; // !isInteger only
+
+    bool GetUInt64(uint64_t & v) const
+    {
+        if (isInteger)
+        {
+            VerifyOrReturnValue(!isNegative || magnitude == 0, false);
+            v = magnitude;
+            return true;
+        }
+        VerifyOrReturnValue(floatingPart >= 0 && floatingPart < 18446744073709551616.0 && std::trunc(floatingPart) == floatingPart,
+                            false);
+        v = static_cast<uint64_t>(floatingPart);
+        return true;
+    }
+
+    bool GetInt64(int64_t & v) const
+    {
+        if (isInteger)
+        {
+            if (isNegative)
+            {
+                // magnitude is at most 2^63, see DecodeNumber.
+                v = static_cast<int64_t>(0 - magnitude);
+                return true;
+            }
+            VerifyOrReturnValue(CanCastTo<int64_t>(magnitude), false);
+            v = static_cast<int64_t>(magnitude);
+            return true;
+        }
+        VerifyOrReturnValue(floatingPart >= -9223372036854775808.0 && floatingPart < 9223372036854775808.0 &&
+                                std::trunc(floatingPart) == floatingPart,
+                            false);
+        v = static_cast<int64_t>(floatingPart);
+        return true;
+    }
+
+    template <typename T>
+    T Get() const
+    {
+        if (!isInteger)
+        {
+            return static_cast<T>(floatingPart);
+        }
+        if (isNegative)
+        {
+            return static_cast<T>(static_cast<int64_t>(0 - magnitude));
+        }
+        return static_cast<T>(magnitude);
+    }
+};
+
+/*
+ * Encodes the values found by JsonTokenizer into TLV, writing directly to the TLVWriter.
+ *
+ * Structure members have to be written in tag order, which JSON does not guarantee. The members of
+ * each object are therefore sorted by tag before being encoded, using a scratch list shared by all
+ * nesting levels.
+ */
+class TlvEncoder
 {
-    TLV::Tag tag = elementCtx.tag;
+public:
+    TlvEncoder(const std::string & json, const std::vector<JsonToken> & tokens) : mJson(json), mTokens(tokens) {}
+
+    CHIP_ERROR EncodeTlvElement(uint32_t index, TLV::TLVWriter & writer, const ElementContext & elementCtx);
+
+private:
+    CHIP_ERROR EncodeStruct(uint32_t index, TLV::TLVWriter & writer, TLV::Tag tag);
+    CHIP_ERROR EncodeArray(uint32_t index, TLV::TLVWriter & writer, const ElementContext & elementCtx);
+    CHIP_ERROR DecodeNumber(const JsonToken & token, JsonNumber & number);
+    bool IsOverridden(size_t member, size_t end) const;
+
+    std::string_view RawText(const JsonToken & token) const { return std::string_view(mJson).substr(token.offset, token.length); }
+
+    bool CompareByTag(const ElementContext & a, const ElementContext & b) const
+    {
+        // If tags are of the same type compare by tag number
+        if (IsContextTag(a.tag) == IsContextTag(b.tag))
+        {
+            if (TLV::TagNumFromTag(a.tag) != TLV::TagNumFromTag(b.tag))
+            {
+                return TLV::TagNumFromTag(a.tag) < TLV::TagNumFromTag(b.tag);
+            }
+            // Same tag numbers are ordered by JSON name, as they were when taken from a Json::Value,
+            // and then in document order.
+            const int order = RawText(mTokens[a.nameToken]).compare(RawText(mTokens[b.nameToken]));
+            return (order != 0) ? (order < 0) : (a.valueToken < b.valueToken);
+        }
+        // Otherwise, compare by tag type: context tags first followed by common profile tags
+        return IsContextTag(a.tag);
+    }
+
+    /// Returns the unescaped value of a string token. The result is only valid until the next call.
+    std::string_view StringValue(const JsonToken & token)
+    {
+        VerifyOrReturnValue(token.hasEscapes, RawText(token));
+        UnescapeJsonString(RawText(token), mUnescaped);
+        return mUnescaped;
+    }
+
+    const std::string & mJson;
+    const std::vector<JsonToken> & mTokens;
+    std::vector<ElementContext> mMembers; // structure members being encoded, for all nesting levels
+    std::string mUnescaped;
+    std::vector<uint8_t> mBytes;
+};
+
+CHIP_ERROR TlvEncoder::DecodeNumber(const JsonToken & token, JsonNumber & number)
+{
+    std::string_view text = RawText(token);
+
+    if (text.find_first_of(".eE") == std::string_view::npos)
+    {
+        number.isNegative = (text[0] == '-');
+        const std::string_view digits = text.substr(number.isNegative ? 1 : 0);
+        auto [ptr, ec]                = std::from_chars(digits.data(), digits.data() + digits.size(), number.magnitude);
+        number.isInteger              = (ec == std::errc()) && (!number.isNegative || number.magnitude <= (uint64_t(1) << 63));
+        VerifyOrReturnError(!number.isInteger, CHIP_NO_ERROR);
+    }
+
+    // Integers that do not fit 64 bits are decoded as doubles, like Json::Reader does.
+    // The number is always followed by a character that is not part of it, so strtod stops at its end.
+    char * end          = nullptr;
+    number.isInteger    = false;
+    number.floatingPart = strtod(text.data(), &end);
+    VerifyOrReturnError(end == text.data() + text.size(), CHIP_ERROR_INVALID_ARGUMENT);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TlvEncoder::EncodeTlvElement(uint32_t index, TLV::TLVWriter & writer, const ElementContext & elementCtx)
+{
+    const JsonToken & val = mTokens[index];
+    TLV::Tag tag          = elementCtx.tag;
 
     switch (elementCtx.type.tlvType)
     {
     case TLV::kTLVType_UnsignedInteger: {
         uint64_t v = 0;
-        if (val.isUInt64())
+        if (val.type == JsonTokenType::kNumber)
         {
-            v = val.asUInt64();
+            JsonNumber number;
+            ReturnErrorOnFailure(DecodeNumber(val, number));
+            VerifyOrReturnError(number.GetUInt64(v), CHIP_ERROR_INVALID_ARGUMENT);
         }
-        else if (val.isString())
+        else if (val.type == JsonTokenType::kString)
         {
-            ReturnErrorOnFailure(ParseNumericalField(val.asString(), v));
+            ReturnErrorOnFailure(ParseNumericalField(StringValue(val), v));
         }
         else
         {
@@ -234,13 +727,15 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
 
     case TLV::kTLVType_SignedInteger: {
         int64_t v = 0;
-        if (val.isInt64())
+        if (val.type == JsonTokenType::kNumber)
         {
-            v = val.asInt64();
+            JsonNumber number;
+            ReturnErrorOnFailure(DecodeNumber(val, number));
+            VerifyOrReturnError(number.GetInt64(v), CHIP_ERROR_INVALID_ARGUMENT);
         }
-        else if (val.isString())
+        else if (val.type == JsonTokenType::kString)
         {
-            ReturnErrorOnFailure(ParseNumericalField(val.asString(), v));
+            ReturnErrorOnFailure(ParseNumericalField(StringValue(val), v));
         }
         else
         {
@@ -251,28 +746,30 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
     }
 
     case TLV::kTLVType_Boolean: {
-        VerifyOrReturnError(val.isBool(), CHIP_ERROR_INVALID_ARGUMENT);
-        ReturnErrorOnFailure(writer.Put(tag, val.asBool()));
+        VerifyOrReturnError(val.type == JsonTokenType::kTrue || val.type == JsonTokenType::kFalse, CHIP_ERROR_INVALID_ARGUMENT);
+        ReturnErrorOnFailure(writer.Put(tag, val.type == JsonTokenType::kTrue));
         break;
     }
 
     case TLV::kTLVType_FloatingPointNumber: {
-        if (val.isNumeric())
+        if (val.type == JsonTokenType::kNumber)
         {
+            JsonNumber number;
+            ReturnErrorOnFailure(DecodeNumber(val, number));
             if (elementCtx.type.isDouble)
             {
-                ReturnErrorOnFailure(writer.Put(tag, val.asDouble()));
+                ReturnErrorOnFailure(writer.Put(tag, number.Get<double>()));
             }
             else
             {
-                ReturnErrorOnFailure(writer.Put(tag, val.asFloat()));
+                ReturnErrorOnFailure(writer.Put(tag, number.Get<float>()));
             }
         }
-        else if (val.isString())
+        else if (val.type == JsonTokenType::kString)
         {
-            const std::string valAsString = val.asString();
-            bool isPositiveInfinity       = (valAsString == kFloatingPointPositiveInfinity);
-            bool isNegativeInfinity       = (valAsString == kFloatingPointNegativeInfinity);
+            const std::string_view valAsString = StringValue(val);
+            bool isPositiveInfinity            = (valAsString == kFloatingPointPositiveInfinity);
+            bool isNegativeInfinity            = (valAsString == kFloatingPointNegativeInfinity);
             VerifyOrReturnError(isPositiveInfinity || isNegativeInfinity, CHIP_ERROR_INVALID_ARGUMENT);
             if (elementCtx.type.isDouble)
             {
@@ -305,95 +802,124 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
     }
 
     case TLV::kTLVType_ByteString: {
-        VerifyOrReturnError(val.isString(), CHIP_ERROR_INVALID_ARGUMENT);
-        const std::string valAsString = val.asString();
-        size_t encodedLen             = valAsString.length();
+        VerifyOrReturnError(val.type == JsonTokenType::kString, CHIP_ERROR_INVALID_ARGUMENT);
+        const std::string_view valAsString = StringValue(val);
+        size_t encodedLen                  = valAsString.length();
         VerifyOrReturnError(CanCastTo<uint16_t>(encodedLen), CHIP_ERROR_INVALID_ARGUMENT);
 
         // Check if the length is a multiple of 4 as strict padding is required.
         VerifyOrReturnError(encodedLen % 4 == 0, CHIP_ERROR_INVALID_ARGUMENT);
 
-        Platform::ScopedMemoryBuffer<uint8_t> byteString;
-        byteString.Alloc(BASE64_MAX_DECODED_LEN(static_cast<uint16_t>(encodedLen)));
-        VerifyOrReturnError(byteString.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-
-        auto decodedLen = Base64Decode(valAsString.c_str(), static_cast<uint16_t>(encodedLen), byteString.Get());
+        mBytes.resize(BASE64_MAX_DECODED_LEN(encodedLen));
+        auto decodedLen = Base64Decode(valAsString.data(), static_cast<uint16_t>(encodedLen), mBytes.data());
         VerifyOrReturnError(decodedLen < UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
-        ReturnErrorOnFailure(writer.PutBytes(tag, byteString.Get(), decodedLen));
+        ReturnErrorOnFailure(writer.PutBytes(tag, mBytes.data(), decodedLen));
         break;
     }
 
     case TLV::kTLVType_UTF8String: {
-        VerifyOrReturnError(val.isString(), CHIP_ERROR_INVALID_ARGUMENT);
-        const std::string valAsString = val.asString();
+        VerifyOrReturnError(val.type == JsonTokenType::kString, CHIP_ERROR_INVALID_ARGUMENT);
+        const std::string_view valAsString = StringValue(val);
+        VerifyOrReturnError(CanCastTo<uint32_t>(valAsString.size()), CHIP_ERROR_INVALID_ARGUMENT);
         ReturnErrorOnFailure(writer.PutString(tag, valAsString.data(), static_cast<uint32_t>(valAsString.size())));
         break;
     }
 
     case TLV::kTLVType_Null: {
-        VerifyOrReturnError(val.isNull(), CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(val.type == JsonTokenType::kNull, CHIP_ERROR_INVALID_ARGUMENT);
         ReturnErrorOnFailure(writer.PutNull(tag));
         break;
     }
 
-    case TLV::kTLVType_Structure: {
-        TLV::TLVType containerType;
-        VerifyOrReturnError(val.isObject(), CHIP_ERROR_INVALID_ARGUMENT);
-        ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Structure, containerType));
+    case TLV::kTLVType_Structure:
+        return EncodeStruct(index, writer, tag);
 
-        std::vector<std::string> jsonNames = val.getMemberNames();
-        std::vector<ElementContext> nestedElementsCtx;
+    case TLV::kTLVType_Array:
+        return EncodeArray(index, writer, elementCtx);
 
-        for (size_t i = 0; i < jsonNames.size(); i++)
-        {
-            ElementContext ctx;
-            ReturnErrorOnFailure(ParseJsonName(jsonNames[i], ctx, writer.ImplicitProfileId));
-            nestedElementsCtx.push_back(ctx);
-        }
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+        break;
+    }
 
-        // Sort Json object elements by Tag number (low to high).
-        // Note that all sorted Context Tags will appear first followed by all sorted Common Tags.
-        std::sort(nestedElementsCtx.begin(), nestedElementsCtx.end(), CompareByTag);
+    return CHIP_NO_ERROR;
+}
 
-        for (auto & ctx : nestedElementsCtx)
-        {
-            ReturnErrorOnFailure(EncodeTlvElement(val[ctx.jsonName], writer, ctx));
-        }
+/// Json::Value keeps the last of several members with the same name, so earlier ones are dropped.
+/// Sorting puts members with the same name next to each other, in document order.
+bool TlvEncoder::IsOverridden(size_t member, size_t end) const
+{
+    return member + 1 < end &&
+        RawText(mTokens[mMembers[member + 1].nameToken]) == RawText(mTokens[mMembers[member].nameToken]);
+}
 
-        ReturnErrorOnFailure(writer.EndContainer(containerType));
-        break;
+CHIP_ERROR TlvEncoder::EncodeStruct(uint32_t index, TLV::TLVWriter & writer, TLV::Tag tag)
+{
+    TLV::TLVType containerType;
+    const JsonToken & val = mTokens[index];
+    VerifyOrReturnError(val.type == JsonTokenType::kObject, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Structure, containerType));
+
+    // Members of nested structures are appended past this range while it is being encoded,
+    // so it is only ever accessed by index.
+    const size_t begin = mMembers.size();
+    uint32_t nameToken = index + 1;
+    for (uint32_t i = 0; i < val.length; i++)
+    {
+        ElementContext ctx;
+        ctx.nameToken  = nameToken;
+        ctx.valueToken = nameToken + 1;
+        ReturnErrorOnFailure(ParseJsonName(StringValue(mTokens[nameToken]), ctx, writer.ImplicitProfileId));
+        mMembers.push_back(ctx);
+        nameToken = mTokens[ctx.valueToken].next;
     }
+    const size_t end = mMembers.size();
 
-    case TLV::kTLVType_Array: {
-        TLV::TLVType containerType;
-        VerifyOrReturnError(val.isArray(), CHIP_ERROR_INVALID_ARGUMENT);
-        ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Array, containerType));
+    // Sort Json object elements by Tag number (low to high).
+    // Note that all sorted Context Tags will appear first followed by all sorted Common Tags.
+    std::sort(mMembers.begin() + static_cast<std::ptrdiff_t>(begin), mMembers.begin() + static_cast<std::ptrdiff_t>(end),
+              [this](const ElementContext & a, const ElementContext & b) { return CompareByTag(a, b); });
 
-        if (elementCtx.subType.tlvType == TLV::kTLVType_NotSpecified)
+    for (size_t member = begin; member < end; member++)
+    {
+        if (IsOverridden(member, end))
         {
-            VerifyOrReturnError(val.size() == 0, CHIP_ERROR_INVALID_ARGUMENT);
-        }
-        else
-        {
-            ElementContext nestedElementCtx;
-            nestedElementCtx.tag  = TLV::AnonymousTag();
-            nestedElementCtx.type = elementCtx.subType;
-            for (Json::ArrayIndex i = 0; i < val.size(); i++)
-            {
-                ReturnErrorOnFailure(EncodeTlvElement(val[i], writer, nestedElementCtx));
-            }
+            continue;
         }
+        const ElementContext ctx = mMembers[member];
+        ReturnErrorOnFailure(EncodeTlvElement(ctx.valueToken, writer, ctx));
+    }
+    mMembers.resize(begin);
 
-        ReturnErrorOnFailure(writer.EndContainer(containerType));
-        break;
+    return writer.EndContainer(containerType);
+}
+
+CHIP_ERROR TlvEncoder::EncodeArray(uint32_t index, TLV::TLVWriter & writer, const ElementContext & elementCtx)
+{
+    TLV::TLVType containerType;
+    const JsonToken & val = mTokens[index];
+    VerifyOrReturnError(val.type == JsonTokenType::kArray, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(writer.StartContainer(elementCtx.tag, TLV::kTLVType_Array, containerType));
+
+    if (elementCtx.subType.tlvType == TLV::kTLVType_NotSpecified)
+    {
+        VerifyOrReturnError(val.length == 0, CHIP_ERROR_INVALID_ARGUMENT);
     }
+    else
+    {
+        ElementContext nestedElementCtx;
+        nestedElementCtx.tag  = TLV::AnonymousTag();
+        nestedElementCtx.type = elementCtx.subType;
 
-    default:
-        return CHIP_ERROR_INVALID_TLV_ELEMENT;
-        break;
+        uint32_t element = index + 1;
+        for (uint32_t i = 0; i < val.length; i++)
+        {
+            ReturnErrorOnFailure(EncodeTlvElement(element, writer, nestedElementCtx));
+            element = mTokens[element].next;
+        }
     }
 
-    return CHIP_NO_ERROR;
+    return writer.EndContainer(containerType);
 }
 
 } // namespace
@@ -411,10 +937,9 @@ CHIP_ERROR JsonToTlv(const std::string & jsonString, MutableByteSpan & tlv)
 
 CHIP_ERROR JsonToTlv(const std::string & jsonString, TLV::TLVWriter & writer)
 {
-    Json::Reader reader;
-    Json::Value json;
-    bool result = reader.parse(jsonString, json);
-    VerifyOrReturnError(result, CHIP_ERROR_INTERNAL);
+    std::vector<JsonToken> tokens;
+    JsonTokenizer tokenizer(jsonString, tokens);
+    VerifyOrReturnError(tokenizer.Tokenize(), CHIP_ERROR_INTERNAL);
 
     ElementContext elementCtx;
     elementCtx.type = { TLV::kTLVType_Structure, false };
@@ -427,7 +952,8 @@ CHIP_ERROR JsonToTlv(const std::string & jsonString, TLV::TLVWriter & writer)
         writer.ImplicitProfileId = kTemporaryImplicitProfileId;
     }
 
-    return EncodeTlvElement(json, writer, elementCtx);
+    TlvEncoder encoder(jsonString, tokens);
+    return encoder.EncodeTlvElement(0, writer, elementCtx);
 }
 
 CHIP_ERROR ConvertTlvTag(uint32_t tagNumber, TLV::Tag & tag)
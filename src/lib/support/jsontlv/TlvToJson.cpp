@@ -15,15 +15,18 @@
  *    limitations under the License.
  */
 
-#include "lib/support/CHIPMemString.h"
-#include "lib/support/ScopedBuffer.h"
-#include <json/json.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/jsontlv/ElementTypes.h>
 #include <lib/support/jsontlv/TlvToJson.h>
 
+#include <charconv>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
 namespace chip {
 
 namespace {
@@ -77,92 +80,124 @@ const char * GetJsonElementStrFromType(const ElementTypeContext & ctx)
     }
 };
 
+ElementTypeContext GetElementTypeContext(TLV::TLVReader & reader)
+{
+    ElementTypeContext type;
+    type.tlvType = reader.GetType();
+    if (type.tlvType == TLV::kTLVType_FloatingPointNumber)
+    {
+        type.isDouble = reader.IsElementDouble();
+    }
+    return type;
+}
+
+template <typename T>
+void AppendNumber(std::string & out, T value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
 /*
- * Encapsulates the element information required to construct a JSON element name string in a JSON object.
+ * Writes JSON text straight from a TLVReader, without building an intermediate document.
  *
- * The generated JSON element name string is constructed as:
- *     'TagNumber:ElementType-SubElementType'.
+ * The layout (3-space indentation, " : " separators, short scalar arrays on a single line) and
+ * the number and string formatting follow Json::StyledWriter, which this converter used to rely
+ * on. Structure members are written in TLV order rather than sorted by their JSON name.
  */
-struct JsonObjectElementContext
+class JsonEmitter
 {
-    JsonObjectElementContext(TLV::TLVReader & reader)
+public:
+    JsonEmitter(std::string & out) : mOut(out) {}
+
+    /// Converts the element the reader is positioned on.
+    CHIP_ERROR WriteElement(TLV::TLVReader & reader);
+
+    /// Converts the members of the structure the reader is positioned on.
+    CHIP_ERROR WriteStruct(TLV::TLVReader & reader);
+
+private:
+    // Json::StyledWriter puts arrays on multiple lines once their single line form reaches this width.
+    static constexpr size_t kRightMargin      = 74;
+    static constexpr size_t kIndentationWidth = 3;
+
+    CHIP_ERROR WriteScalar(TLV::TLVReader & reader);
+    CHIP_ERROR WriteArray(TLV::TLVReader & reader, ElementTypeContext & subType);
+    CHIP_ERROR TryWriteSingleLineArray(TLV::TLVReader & reader, bool & fits);
+    CHIP_ERROR WriteMultiLineArray(TLV::TLVReader & reader);
+    void WriteMemberName(const TLV::TLVReader & reader, const ElementTypeContext & type, const ElementTypeContext & subType);
+    void WriteString(const char * str, size_t length);
+    void WriteDouble(double value);
+
+    void WriteIndent();
+    void WriteWithIndent(const char * str)
     {
-        tag               = reader.GetTag();
-        implicitProfileId = reader.ImplicitProfileId;
-        type.tlvType      = reader.GetType();
-        if (type.tlvType == TLV::kTLVType_FloatingPointNumber)
-        {
-            type.isDouble = reader.IsElementDouble();
-        }
+        WriteIndent();
+        mOut += str;
     }
 
-    std::string GenerateJsonElementName() const
+    std::string & mOut;
+    size_t mDepth = 0;
+};
+
+void JsonEmitter::WriteIndent()
+{
+    if (!mOut.empty())
     {
-        std::string str = "???";
-        if (TLV::IsContextTag(tag))
-        {
-            // common case for context tags: raw value
-            str = std::to_string(TLV::TagNumFromTag(tag));
-        }
-        else if (TLV::IsProfileTag(tag))
+        const char last = mOut.back();
+        if (last == ' ')
         {
-            if (TLV::ProfileIdFromTag(tag) == implicitProfileId)
-            {
-                str = std::to_string(TLV::TagNumFromTag(tag));
-            }
-            else
-            {
-                uint32_t tagNumber = (static_cast<uint32_t>(TLV::VendorIdFromTag(tag)) << 16) | TLV::TagNumFromTag(tag);
-                str                = std::to_string(tagNumber);
-            }
+            // already indented
+            return;
         }
-        str = str + ":" + GetJsonElementStrFromType(type);
-        if (type.tlvType == TLV::kTLVType_Array)
+        if (last != '\n')
         {
-            str = str + "-" + GetJsonElementStrFromType(subType);
+            mOut += '\n';
         }
-        return str;
     }
-
-    TLV::Tag tag;
-    uint32_t implicitProfileId;
-    ElementTypeContext type;
-    ElementTypeContext subType;
-};
+    mOut.append(mDepth * kIndentationWidth, ' ');
+}
 
 /*
- * This templated function inserts a name/value pair into the Json object.
- * The value is templated to be of type T and accepts any of the following types:
- *
- *      bool, uint*_t, int*_t, char *, float, double, std::string, Json::Value
- *
- * This method uses the provided element context to generate Json name string.
+ * Writes the JSON element name for the element the reader is positioned on:
+ *     'TagNumber:ElementType[-SubElementType]'.
  */
-template <typename T>
-void InsertJsonElement(Json::Value & json, const JsonObjectElementContext & ctx, T val)
+void JsonEmitter::WriteMemberName(const TLV::TLVReader & reader, const ElementTypeContext & type,
+                                  const ElementTypeContext & subType)
 {
-    if (json.isArray())
+    const TLV::Tag tag = reader.GetTag();
+
+    WriteIndent();
+    mOut += '"';
+    if (TLV::IsContextTag(tag) || (TLV::IsProfileTag(tag) && TLV::ProfileIdFromTag(tag) == reader.ImplicitProfileId))
+    {
+        // common case for context tags: raw value
+        AppendNumber(mOut, TLV::TagNumFromTag(tag));
+    }
+    else if (TLV::IsProfileTag(tag))
     {
-        json.append(val);
+        AppendNumber(mOut, (static_cast<uint32_t>(TLV::VendorIdFromTag(tag)) << 16) | TLV::TagNumFromTag(tag));
     }
     else
     {
-        json[ctx.GenerateJsonElementName()] = val;
+        mOut += "???";
     }
+    mOut += ':';
+    mOut += GetJsonElementStrFromType(type);
+    if (type.tlvType == TLV::kTLVType_Array)
+    {
+        mOut += '-';
+        mOut += GetJsonElementStrFromType(subType);
+    }
+    mOut += "\" : ";
 }
 
-static CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj);
-
-/*
- * Given a TLVReader positioned at TLV structure this function:
- *   - enters structure
- *   - converts all elements of a structure into JSON object representation
- *   - exits structure
- */
-CHIP_ERROR TlvStructToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
+CHIP_ERROR JsonEmitter::WriteStruct(TLV::TLVReader & reader)
 {
     CHIP_ERROR err;
     TLV::TLVType containerType;
+    bool empty = true;
 
     ReturnErrorOnFailure(reader.EnterContainer(containerType));
 
@@ -176,30 +211,77 @@ CHIP_ERROR TlvStructToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
             VerifyOrReturnError(TLV::TagNumFromTag(tag) > UINT8_MAX, CHIP_ERROR_INVALID_TLV_TAG);
         }
 
-        // Recursively convert to JSON the item within the struct.
-        ReturnErrorOnFailure(TlvToJson(reader, jsonObj));
+        if (empty)
+        {
+            WriteWithIndent("{");
+            mDepth++;
+            empty = false;
+        }
+        else
+        {
+            mOut += ',';
+        }
+
+        // The name of an array carries the type of its elements, which is only known once they are read.
+        // Arrays write their name themselves.
+        const ElementTypeContext type = GetElementTypeContext(reader);
+        if (type.tlvType == TLV::kTLVType_Array)
+        {
+            ElementTypeContext subType;
+            ReturnErrorOnFailure(WriteArray(reader, subType));
+            continue;
+        }
+
+        WriteMemberName(reader, type, ElementTypeContext());
+        ReturnErrorOnFailure(WriteElement(reader));
     }
 
     VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
-    return reader.ExitContainer(containerType);
+    ReturnErrorOnFailure(reader.ExitContainer(containerType));
+
+    if (empty)
+    {
+        mOut += "{}";
+    }
+    else
+    {
+        mDepth--;
+        WriteWithIndent("}");
+    }
+    return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
+CHIP_ERROR JsonEmitter::WriteElement(TLV::TLVReader & reader)
 {
-    JsonObjectElementContext context(reader);
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_Structure:
+        return WriteStruct(reader);
+    case TLV::kTLVType_Array:
+        // Arrays are handled by WriteStruct, as their name depends on their content, and cannot be nested.
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    default:
+        return WriteScalar(reader);
+    }
+}
 
+CHIP_ERROR JsonEmitter::WriteScalar(TLV::TLVReader & reader)
+{
     switch (reader.GetType())
     {
     case TLV::kTLVType_UnsignedInteger: {
         uint64_t v;
         ReturnErrorOnFailure(reader.Get(v));
-        if (CanCastTo<uint32_t>(v))
+        // Values that do not fit 32 bits are written as strings, so that JSON parsers using doubles do not lose precision.
+        const bool asString = !CanCastTo<uint32_t>(v);
+        if (asString)
         {
-            InsertJsonElement(jsonObj, context, v);
+            mOut += '"';
         }
-        else
+        AppendNumber(mOut, v);
+        if (asString)
         {
-            InsertJsonElement(jsonObj, context, std::to_string(v));
+            mOut += '"';
         }
         break;
     }
@@ -207,13 +289,15 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
     case TLV::kTLVType_SignedInteger: {
         int64_t v;
         ReturnErrorOnFailure(reader.Get(v));
-        if (CanCastTo<int32_t>(v))
+        const bool asString = !CanCastTo<int32_t>(v);
+        if (asString)
         {
-            InsertJsonElement(jsonObj, context, v);
+            mOut += '"';
         }
-        else
+        AppendNumber(mOut, v);
+        if (asString)
         {
-            InsertJsonElement(jsonObj, context, std::to_string(v));
+            mOut += '"';
         }
         break;
     }
@@ -221,7 +305,7 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
     case TLV::kTLVType_Boolean: {
         bool v;
         ReturnErrorOnFailure(reader.Get(v));
-        InsertJsonElement(jsonObj, context, v);
+        mOut += v ? "true" : "false";
         break;
     }
 
@@ -230,15 +314,15 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
         ReturnErrorOnFailure(reader.Get(v));
         if (v == std::numeric_limits<double>::infinity())
         {
-            InsertJsonElement(jsonObj, context, kFloatingPointPositiveInfinity);
+            WriteString(kFloatingPointPositiveInfinity, strlen(kFloatingPointPositiveInfinity));
         }
         else if (v == -std::numeric_limits<double>::infinity())
         {
-            InsertJsonElement(jsonObj, context, kFloatingPointNegativeInfinity);
+            WriteString(kFloatingPointNegativeInfinity, strlen(kFloatingPointNegativeInfinity));
         }
         else
         {
-            InsertJsonElement(jsonObj, context, v);
+            WriteDouble(v);
         }
         break;
     }
@@ -246,87 +330,286 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
     case TLV::kTLVType_ByteString: {
         ByteSpan span;
         ReturnErrorOnFailure(reader.Get(span));
-
-        Platform::ScopedMemoryBuffer<char> byteString;
-        byteString.Alloc(BASE64_ENCODED_LEN(span.size()) + 1);
-        VerifyOrReturnError(byteString.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-
-        auto encodedLen              = Base64Encode(span.data(), static_cast<uint16_t>(span.size()), byteString.Get());
-        byteString.Get()[encodedLen] = '\0';
-
-        InsertJsonElement(jsonObj, context, byteString.Get());
+        VerifyOrReturnError(CanCastTo<uint32_t>(span.size()), CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        // Base64 needs no escaping, so encode straight into the output.
+        const size_t start = mOut.size();
+        mOut.resize(start + BASE64_ENCODED_LEN(span.size()) + 2);
+        mOut[start]           = '"';
+        const uint32_t length = Base64Encode32(span.data(), static_cast<uint32_t>(span.size()), &mOut[start + 1]);
+        mOut.resize(start + 1 + length);
+        mOut += '"';
         break;
     }
 
     case TLV::kTLVType_UTF8String: {
         CharSpan span;
         ReturnErrorOnFailure(reader.Get(span));
-
-        std::string str(span.data(), span.size());
-        InsertJsonElement(jsonObj, context, str);
+        WriteString(span.data(), span.size());
         break;
     }
 
-    case TLV::kTLVType_Null: {
-        InsertJsonElement(jsonObj, context, Json::Value());
+    case TLV::kTLVType_Null:
+        mOut += "null";
         break;
+
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
     }
 
-    case TLV::kTLVType_Structure: {
-        Json::Value jsonStruct(Json::objectValue);
-        ReturnErrorOnFailure(TlvStructToJson(reader, jsonStruct));
-        InsertJsonElement(jsonObj, context, jsonStruct);
-        break;
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Writes the name and value of the array the reader is positioned on, and reports the type of its elements.
+ *
+ * Arrays of scalars are first written on a single line. If that turns out to be too wide, or an element
+ * is a non-empty structure, the single line form is dropped and the array is read again from a copy of
+ * the reader to write it one element per line.
+ */
+CHIP_ERROR JsonEmitter::WriteArray(TLV::TLVReader & reader, ElementTypeContext & subType)
+{
+    CHIP_ERROR err;
+    TLV::TLVType containerType;
+    bool empty = true;
+
+    // Validate the elements and find their type before anything is written, as it is part of the name.
+    TLV::TLVReader elementsReader;
+    elementsReader.Init(reader);
+    ReturnErrorOnFailure(elementsReader.EnterContainer(containerType));
+    while ((err = elementsReader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(elementsReader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+        VerifyOrReturnError(elementsReader.GetType() != TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        const ElementTypeContext nextSubType = GetElementTypeContext(elementsReader);
+        if (empty)
+        {
+            subType = nextSubType;
+            empty   = false;
+        }
+        else
+        {
+            VerifyOrReturnError(subType.tlvType == nextSubType.tlvType && subType.isDouble == nextSubType.isDouble,
+                                CHIP_ERROR_INVALID_TLV_ELEMENT);
+        }
     }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
 
-    case TLV::kTLVType_Array: {
-        CHIP_ERROR err;
-        Json::Value jsonArray(Json::arrayValue);
-        ElementTypeContext prevSubType;
-        ElementTypeContext nextSubType;
-        TLV::TLVType containerType;
+    WriteMemberName(reader, GetElementTypeContext(reader), subType);
 
+    if (empty)
+    {
+        mOut += "[]";
         ReturnErrorOnFailure(reader.EnterContainer(containerType));
+        return reader.ExitContainer(containerType);
+    }
+
+    const size_t start = mOut.size();
+    TLV::TLVReader retryReader;
+    retryReader.Init(reader);
+
+    bool fits = false;
+    ReturnErrorOnFailure(TryWriteSingleLineArray(reader, fits));
+    VerifyOrReturnError(!fits, CHIP_NO_ERROR);
+
+    mOut.resize(start);
+    reader.Init(retryReader);
+    return WriteMultiLineArray(reader);
+}
+
+CHIP_ERROR JsonEmitter::TryWriteSingleLineArray(TLV::TLVReader & reader, bool & fits)
+{
+    CHIP_ERROR err;
+    TLV::TLVType containerType;
+    const size_t start = mOut.size();
+    bool first         = true;
 
-        while ((err = reader.Next()) == CHIP_NO_ERROR)
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    mOut += "[ ";
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (!first)
         {
-            VerifyOrReturnError(reader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
-            VerifyOrReturnError(reader.GetType() != TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
+            mOut += ", ";
+        }
+        first = false;
+
+        if (reader.GetType() == TLV::kTLVType_Structure)
+        {
+            // Only empty structures can share a line.
+            TLV::TLVReader structReader;
+            TLV::TLVType structType;
+            structReader.Init(reader);
+            ReturnErrorOnFailure(structReader.EnterContainer(structType));
+            VerifyOrReturnError(structReader.Next() == CHIP_END_OF_TLV, CHIP_NO_ERROR, fits = false);
+            mOut += "{}";
+        }
+        else
+        {
+            ReturnErrorOnFailure(WriteScalar(reader));
+        }
+        // The closing " ]" still has to fit.
+        VerifyOrReturnError(mOut.size() - start + 2 < kRightMargin, CHIP_NO_ERROR, fits = false);
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    mOut += " ]";
+
+    fits = true;
+    return reader.ExitContainer(containerType);
+}
+
+CHIP_ERROR JsonEmitter::WriteMultiLineArray(TLV::TLVReader & reader)
+{
+    CHIP_ERROR err;
+    TLV::TLVType containerType;
+    bool first = true;
+
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
 
-            nextSubType.tlvType = reader.GetType();
-            if (nextSubType.tlvType == TLV::kTLVType_FloatingPointNumber)
+    WriteWithIndent("[");
+    mDepth++;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (!first)
+        {
+            mOut += ',';
+        }
+        first = false;
+
+        WriteIndent();
+        ReturnErrorOnFailure(WriteElement(reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    mDepth--;
+    WriteWithIndent("]");
+
+    return reader.ExitContainer(containerType);
+}
+
+/// Returns the code point of the UTF-8 sequence at `str` and advances `str` to its last byte.
+uint32_t DecodeUtf8(const char *& str, const char * end)
+{
+    constexpr uint32_t kReplacementCharacter = 0xFFFD;
+
+    const auto byte = [&](size_t i) { return static_cast<uint32_t>(static_cast<uint8_t>(str[i])); };
+    const uint32_t first = byte(0);
+
+    if (first < 0x80)
+    {
+        return first;
+    }
+    if (first < 0xE0)
+    {
+        VerifyOrReturnValue(end - str >= 2, kReplacementCharacter);
+        const uint32_t codePoint = ((first & 0x1F) << 6) | (byte(1) & 0x3F);
+        str += 1;
+        return codePoint < 0x80 ? kReplacementCharacter : codePoint;
+    }
+    if (first < 0xF0)
+    {
+        VerifyOrReturnValue(end - str >= 3, kReplacementCharacter);
+        const uint32_t codePoint = ((first & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F);
+        str += 2;
+        // Surrogates are not valid code points, and overlong encodings are invalid.
+        VerifyOrReturnValue(codePoint < 0xD800 || codePoint > 0xDFFF, kReplacementCharacter);
+        return codePoint < 0x800 ? kReplacementCharacter : codePoint;
+    }
+    if (first < 0xF8)
+    {
+        VerifyOrReturnValue(end - str >= 4, kReplacementCharacter);
+        const uint32_t codePoint = ((first & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F);
+        str += 3;
+        return codePoint < 0x10000 ? kReplacementCharacter : codePoint;
+    }
+    return kReplacementCharacter;
+}
+
+/// Writes a quoted JSON string. Like Json::StyledWriter, anything outside of printable ASCII is escaped.
+void JsonEmitter::WriteString(const char * str, size_t length)
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+
+    const auto appendEscapedCodeUnit = [this](uint32_t codeUnit) {
+        const char escaped[] = { '\\',
+                                 'u',
+                                 kHexDigits[(codeUnit >> 12) & 0xF],
+                                 kHexDigits[(codeUnit >> 8) & 0xF],
+                                 kHexDigits[(codeUnit >> 4) & 0xF],
+                                 kHexDigits[codeUnit & 0xF] };
+        mOut.append(escaped, sizeof(escaped));
+    };
+
+    const char * end = str + length;
+
+    mOut += '"';
+    for (const char * c = str; c != end; ++c)
+    {
+        switch (*c)
+        {
+        case '"':
+            mOut += "\\\"";
+            break;
+        case '\\':
+            mOut += "\\\\";
+            break;
+        case '\b':
+            mOut += "\\b";
+            break;
+        case '\f':
+            mOut += "\\f";
+            break;
+        case '\n':
+            mOut += "\\n";
+            break;
+        case '\r':
+            mOut += "\\r";
+            break;
+        case '\t':
+            mOut += "\\t";
+            break;
+        default: {
+            uint32_t codePoint = DecodeUtf8(c, end);
+            if (codePoint >= 0x20 && codePoint < 0x80)
             {
-                nextSubType.isDouble = reader.IsElementDouble();
+                mOut += static_cast<char>(codePoint);
             }
-
-            if (jsonArray.empty())
+            else if (codePoint < 0x10000)
             {
-                prevSubType = nextSubType;
+                appendEscapedCodeUnit(codePoint);
             }
             else
             {
-                VerifyOrReturnError(prevSubType.tlvType == nextSubType.tlvType && prevSubType.isDouble == nextSubType.isDouble,
-                                    CHIP_ERROR_INVALID_TLV_ELEMENT);
+                codePoint -= 0x10000;
+                appendEscapedCodeUnit(0xD800 + ((codePoint >> 10) & 0x3FF));
+                appendEscapedCodeUnit(0xDC00 + (codePoint & 0x3FF));
             }
-
-            // Recursively convert to JSON the encompassing item within the array.
-            ReturnErrorOnFailure(TlvToJson(reader, jsonArray));
+            break;
+        }
         }
-
-        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
-        ReturnErrorOnFailure(reader.ExitContainer(containerType));
-
-        context.subType = prevSubType;
-        InsertJsonElement(jsonObj, context, jsonArray);
-        break;
     }
+    mOut += '"';
+}
 
-    default:
-        return CHIP_ERROR_INVALID_TLV_ELEMENT;
-        break;
+void JsonEmitter::WriteDouble(double value)
+{
+    if (std::isnan(value))
+    {
+        mOut += "null";
+        return;
     }
 
-    return CHIP_NO_ERROR;
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+    VerifyOrReturn(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+    mOut.append(buffer, static_cast<size_t>(length));
+
+    // Keep integral values recognizable as floating point numbers.
+    if (strpbrk(buffer, ".e") == nullptr)
+    {
+        mOut += ".0";
+    }
 }
 
 } // namespace
@@ -350,11 +633,12 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, std::string & jsonString)
     // During json conversion, a implicit profile ID is required
     ImplicitProfileIdChange implicitProfileIdChange(reader, kTemporaryImplicitProfileId);
 
-    Json::Value jsonObject(Json::objectValue);
-    ReturnErrorOnFailure(TlvStructToJson(reader, jsonObject));
+    std::string json;
+    JsonEmitter emitter(json);
+    ReturnErrorOnFailure(emitter.WriteStruct(reader));
+    json += '\n';
 
-    Json::StyledWriter writer;
-    jsonString = writer.write(jsonObject);
+    jsonString = std::move(json);
     return CHIP_NO_ERROR;
 }
 } // namespace chip
@@ -0,0 +1,219 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/Arena.h>
+
+#include <cstring>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+
+using namespace chip;
+
+namespace {
+
+struct Node
+{
+    uint32_t mValue;
+    Node * mpNext;
+};
+
+class TestArena : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestArena, TestAllocate)
+{
+    Arena arena(256);
+    EXPECT_TRUE(arena.IsEmpty());
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 0u);
+
+    Node * head = nullptr;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Node * node = arena.New<Node>(Node{ i, head });
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(node) % alignof(Node), 0u);
+        head = node;
+    }
+
+    uint32_t expected = 10;
+    for (Node * node = head; node != nullptr; node = node->mpNext)
+    {
+        EXPECT_EQ(node->mValue, --expected);
+    }
+    EXPECT_EQ(expected, 0u);
+
+    // Ten small nodes are served by a single block.
+    const Arena::Statistics & stats = arena.GetStatistics();
+    EXPECT_FALSE(arena.IsEmpty());
+    EXPECT_EQ(stats.mAllocations, 10u);
+    EXPECT_EQ(stats.mBlockCount, 1u);
+    EXPECT_EQ(stats.mBlockAllocations, 1u);
+    EXPECT_EQ(stats.mBytesUsed, 10 * sizeof(Node));
+    EXPECT_EQ(stats.mBytesReserved, 256u);
+}
+
+TEST_F(TestArena, TestAlignment)
+{
+    Arena arena(64);
+
+    uint8_t * byte = static_cast<uint8_t *>(arena.Allocate(1, 1));
+    ASSERT_NE(byte, nullptr);
+
+    void * aligned = arena.Allocate(8, 8);
+    ASSERT_NE(aligned, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 8, 0u);
+    EXPECT_EQ(arena.GetStatistics().mBytesUsed, 16u);
+
+    void * overAligned = arena.Allocate(4, 64);
+    ASSERT_NE(overAligned, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(overAligned) % 64, 0u);
+
+    EXPECT_EQ(arena.Allocate(4, 3), nullptr);
+    EXPECT_EQ(arena.Allocate(4, 0), nullptr);
+}
+
+TEST_F(TestArena, TestLargeAllocations)
+{
+    Arena arena(128);
+
+    void * small = arena.Allocate(16);
+    ASSERT_NE(small, nullptr);
+
+    // A large allocation gets a block of its own, and the current block keeps
+    // serving small ones.
+    uint8_t * large = static_cast<uint8_t *>(arena.Allocate(1000));
+    ASSERT_NE(large, nullptr);
+    memset(large, 0xA5, 1000);
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 2u);
+
+    uint8_t * next = static_cast<uint8_t *>(arena.Allocate(16));
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(next, static_cast<uint8_t *>(small) + 16);
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 2u);
+
+    // Filling the current block moves on to a new one.
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_NE(arena.Allocate(16), nullptr);
+    }
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 3u);
+    EXPECT_EQ(arena.GetStatistics().mBytesReserved, 128u + 1000u + 128u);
+}
+
+TEST_F(TestArena, TestReset)
+{
+    Arena arena(128);
+
+    void * first = arena.Allocate(16);
+    ASSERT_NE(first, nullptr);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_NE(arena.Allocate(16), nullptr);
+    }
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 3u);
+
+    // Reset keeps the first block and hands it out again.
+    arena.Reset();
+    EXPECT_TRUE(arena.IsEmpty());
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 1u);
+    EXPECT_EQ(arena.GetStatistics().mBytesReserved, 128u);
+    EXPECT_EQ(arena.GetStatistics().mBytesUsed, 0u);
+    EXPECT_EQ(arena.Allocate(16), first);
+    EXPECT_EQ(arena.GetStatistics().mBlockAllocations, 3u);
+
+    arena.Release();
+    EXPECT_EQ(arena.GetStatistics().mBlockCount, 0u);
+    EXPECT_EQ(arena.GetStatistics().mBytesReserved, 0u);
+    EXPECT_NE(arena.Allocate(16), nullptr);
+    EXPECT_EQ(arena.GetStatistics().mBlockAllocations, 4u);
+}
+
+TEST_F(TestArena, TestDestructors)
+{
+    static int sLive = 0;
+    struct Tracked
+    {
+        Tracked() { sLive++; }
+        ~Tracked() { sLive--; }
+    };
+
+    Arena arena(128);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_NE(arena.New<Tracked>(), nullptr);
+    }
+    EXPECT_EQ(sLive, 20);
+
+    arena.Reset();
+    EXPECT_EQ(sLive, 0);
+
+    ASSERT_NE(arena.New<Tracked>(), nullptr);
+    arena.Release();
+    EXPECT_EQ(sLive, 0);
+
+    {
+        Arena scoped;
+        ASSERT_NE(scoped.New<Tracked>(), nullptr);
+        EXPECT_EQ(sLive, 1);
+    }
+    EXPECT_EQ(sLive, 0);
+}
+
+TEST_F(TestArena, TestLongRunFragmentation)
+{
+    // Simulate a long-lived handler serving many transactions of varying size:
+    // memory held between transactions must not grow, and a transaction that
+    // fits in the first block must not go back to the heap.
+    Arena arena(512);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+
+    size_t peakReserved = 0;
+    for (int transaction = 0; transaction < 10000; transaction++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        size_t count = static_cast<size_t>(seed % 64);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t size = 1 + static_cast<size_t>((seed >> (i % 48)) % 48);
+            ASSERT_NE(arena.Allocate(size, (i % 2) ? 8 : 1), nullptr);
+        }
+
+        const Arena::Statistics & stats = arena.GetStatistics();
+        EXPECT_LE(stats.mBytesUsed, stats.mBytesReserved);
+        peakReserved = (stats.mBytesReserved > peakReserved) ? stats.mBytesReserved : peakReserved;
+
+        arena.Reset();
+        EXPECT_EQ(arena.GetStatistics().mBlockCount, 1u);
+        EXPECT_EQ(arena.GetStatistics().mBytesReserved, 512u);
+    }
+
+    // At most 64 * 48 bytes per transaction, so a handful of blocks at peak.
+    EXPECT_LE(peakReserved, 8 * 512u);
+}
+
+} // namespace
@@ -17,6 +17,7 @@
 
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 #include <pw_unit_test/framework.h>
 
@@ -1862,4 +1863,134 @@ TEST_F(TestJsonToTlvToJson, TestConverter_Struct_MEITags)
     ByteSpan tlvSpan(buf, writer.GetLengthWritten());
     CheckValidConversion(jsonString, tlvSpan, jsonString);
 }
+
+// Members are written in tag order, and short arrays of scalars on a single line.
+TEST_F(TestJsonToTlvToJson, TestConverter_TlvToJson_Layout)
+{
+    uint8_t buf[256];
+    TLV::TLVWriter writer;
+    TLV::TLVType containerType;
+    TLV::TLVType containerType2;
+
+    writer.Init(buf);
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(2), static_cast<uint32_t>(2)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(10), static_cast<uint32_t>(10)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::ContextTag(11), TLV::kTLVType_Array, containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::AnonymousTag(), static_cast<int32_t>(-1)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::AnonymousTag(), static_cast<int32_t>(1)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::ContextTag(12), TLV::kTLVType_Structure, containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.PutString(TLV::ContextTag(13), "\"caf\xc3\xa9\"\n"));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Finalize());
+
+    std::string jsonString;
+    EXPECT_EQ(CHIP_NO_ERROR, TlvToJson(ByteSpan(buf, writer.GetLengthWritten()), jsonString));
+    EXPECT_EQ(jsonString,
+              "{\n"
+              "   \"2:UINT\" : 2,\n"
+              "   \"10:UINT\" : 10,\n"
+              "   \"11:ARRAY-INT\" : [ -1, 1 ],\n"
+              "   \"12:STRUCT\" : {},\n"
+              "   \"13:STRING\" : \"\\\"caf\\u00e9\\\"\\n\"\n"
+              "}\n");
+}
+
+// JSON members may come in any order, with comments, and the last of duplicate names wins.
+TEST_F(TestJsonToTlvToJson, TestConverter_JsonToTlv_MemberOrder)
+{
+    uint8_t buf[256];
+    TLV::TLVWriter writer;
+    TLV::TLVType containerType;
+    TLV::TLVType containerType2;
+
+    writer.Init(buf);
+    writer.ImplicitProfileId = kImplicitProfileId;
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(1), static_cast<uint32_t>(2)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::ContextTag(3), TLV::kTLVType_Structure, containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.PutString(TLV::ContextTag(0), "\xc3\xa9\xf0\x9f\x98\x80/"));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(4), true));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType2));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(20), static_cast<int32_t>(-20)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ProfileTag(kImplicitProfileId, 300), static_cast<uint32_t>(300)));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Finalize());
+
+    std::string jsonString = "// leading comment\n"
+                             "{\n"
+                             "   \"300:UINT\" : 300,\n"
+                             "   \"20:INT\" : -20, /* inline comment */\n"
+                             "   \"3:STRUCT\" : { \"4:BOOL\" : true, \"0:STRING\" : \"\\u00E9\\ud83d\\ude00\\/\" },\n"
+                             "   \"1:UINT\" : 1,\n"
+                             "   \"1:UINT\" : 2\n"
+                             "}\n";
+
+    uint8_t outBuf[256];
+    MutableByteSpan tlvSpan(outBuf);
+    EXPECT_EQ(CHIP_NO_ERROR, JsonToTlv(jsonString, tlvSpan));
+    EXPECT_TRUE(tlvSpan.data_equal(ByteSpan(buf, writer.GetLengthWritten())));
+}
+
+// A report of a few hundred attributes, about the size of a wildcard read, converts back to the same TLV.
+TEST_F(TestJsonToTlvToJson, TestConverter_LargeReport)
+{
+    constexpr uint32_t kAttributeCount = 400;
+
+    std::vector<uint8_t> buf(32 * 1024);
+    TLV::TLVWriter writer;
+    TLV::TLVType containerType;
+    TLV::TLVType arrayType;
+    TLV::TLVType structType;
+
+    writer.Init(buf.data(), static_cast<uint32_t>(buf.size()));
+    writer.ImplicitProfileId = kImplicitProfileId;
+    EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType));
+    for (uint32_t i = 0; i < kAttributeCount; i++)
+    {
+        const TLV::Tag tag = (i <= UINT8_MAX) ? TLV::ContextTag(static_cast<uint8_t>(i)) : TLV::ProfileTag(kImplicitProfileId, i);
+        switch (i % 4)
+        {
+        case 0:
+            EXPECT_EQ(CHIP_NO_ERROR, writer.Put(tag, static_cast<uint64_t>(i) << 24));
+            break;
+        case 1:
+            EXPECT_EQ(CHIP_NO_ERROR, writer.PutString(tag, "Manufacturer Label"));
+            break;
+        case 2:
+            EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(tag, TLV::kTLVType_Array, arrayType));
+            for (uint8_t j = 0; j < 4; j++)
+            {
+                EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, structType));
+                EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(0), j));
+                EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(1), static_cast<int8_t>(-j)));
+                EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::ContextTag(2), 0.5 * j));
+                EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(structType));
+            }
+            EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(arrayType));
+            break;
+        default:
+            EXPECT_EQ(CHIP_NO_ERROR, writer.StartContainer(tag, TLV::kTLVType_Array, arrayType));
+            for (uint16_t j = 0; j < 30; j++)
+            {
+                EXPECT_EQ(CHIP_NO_ERROR, writer.Put(TLV::AnonymousTag(), j));
+            }
+            EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(arrayType));
+            break;
+        }
+    }
+    EXPECT_EQ(CHIP_NO_ERROR, writer.EndContainer(containerType));
+    EXPECT_EQ(CHIP_NO_ERROR, writer.Finalize());
+    ByteSpan tlv(buf.data(), writer.GetLengthWritten());
+
+    std::string jsonString;
+    EXPECT_EQ(CHIP_NO_ERROR, TlvToJson(tlv, jsonString));
+
+    std::vector<uint8_t> outBuf(buf.size());
+    MutableByteSpan tlvSpan(outBuf.data(), outBuf.size());
+    EXPECT_EQ(CHIP_NO_ERROR, JsonToTlv(jsonString, tlvSpan));
+    EXPECT_TRUE(tlvSpan.data_equal(tlv));
+}
 } // namespace
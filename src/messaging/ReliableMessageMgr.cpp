@@ -49,6 +49,10 @@ namespace chip {
 namespace Messaging {
 
 System::Clock::Timeout ReliableMessageMgr::sAdditionalMRPBackoffTime = CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST;
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+ReliableMessageMgr::BackoffJitterGenerator ReliableMessageMgr::sBackoffJitterGenerator = nullptr;
+void * ReliableMessageMgr::sBackoffJitterGeneratorContext                     = nullptr;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
     ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
@@ -268,7 +272,17 @@ System::Clock::Timeout ReliableMessageMgr::GetBackoff(System::Clock::Timeout bas
     System::Clock::Milliseconds64 mrpBackoffTime = interval * backoffNum / backoffDenom;
 
     // 3. Calculate `mrpBackoffTime *= (1.0 + random(0,1) * MRP_BACKOFF_JITTER)`
-    uint32_t jitter = MRP_BACKOFF_JITTER_BASE + (computeMaxPossible ? UINT8_MAX : Crypto::GetRandU8());
+    uint8_t random = UINT8_MAX;
+    if (!computeMaxPossible)
+    {
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+        random =
+            (sBackoffJitterGenerator != nullptr) ? sBackoffJitterGenerator(sBackoffJitterGeneratorContext) : Crypto::GetRandU8();
+#else
+        random = Crypto::GetRandU8();
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    }
+    uint32_t jitter = MRP_BACKOFF_JITTER_BASE + random;
     mrpBackoffTime  = mrpBackoffTime * jitter / MRP_BACKOFF_JITTER_BASE;
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -473,6 +487,14 @@ void ReliableMessageMgr::SetAdditionalMRPBackoffTime(const Optional<System::Cloc
     sAdditionalMRPBackoffTime = additionalTime.ValueOr(CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST);
 }
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+void ReliableMessageMgr::SetBackoffJitterGeneratorForTesting(BackoffJitterGenerator generator, void * context)
+{
+    sBackoffJitterGenerator        = generator;
+    sBackoffJitterGeneratorContext = context;
+}
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 {
     System::Clock::Timeout baseTimeout = System::Clock::Timeout(0);
@@ -221,6 +221,17 @@ public:
      */
     static void SetAdditionalMRPBackoffTime(const Optional<System::Clock::Timeout> & additionalTime);
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    using BackoffJitterGenerator = uint8_t (*)(void * context);
+
+    /**
+     * Test-only: replace the random source of the jitter of the MRP backoff
+     * time (Crypto::GetRandU8() by default), so that tests can retransmit at
+     * reproducible times.  Passing nullptr restores the default.
+     */
+    static void SetBackoffJitterGeneratorForTesting(BackoffJitterGenerator generator, void * context);
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 private:
     /**
      * Calculates the next retransmission time for the entry
@@ -251,6 +262,10 @@ private:
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    static BackoffJitterGenerator sBackoffJitterGenerator;
+    static void * sBackoffJitterGeneratorContext;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 };
 
 } // namespace Messaging
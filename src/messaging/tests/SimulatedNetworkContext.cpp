@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "SimulatedNetworkContext.h"
+
+#include <lib/support/CodeUtils.h>
+#include <messaging/ReliableMessageMgr.h>
+
+namespace chip {
+namespace Test {
+
+namespace {
+
+uint8_t NextBackoffJitter(void * network)
+{
+    return static_cast<SimulatedNetwork *>(network)->NextRandomU8();
+}
+
+} // namespace
+
+IOContext * SimulatedNetworkContext::sIOContext = nullptr;
+
+CHIP_ERROR SimulatedNode::Init(SimulatedNetwork & network, System::Layer & systemLayer)
+{
+    VerifyOrReturnError(!mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    mInitialized = true;
+
+    ReturnErrorOnFailure(mTransportMgr.Init(&network));
+    ReturnErrorOnFailure(mOpCertStore.Init(&mStorage));
+
+    FabricTable::InitParams initParams;
+    initParams.storage     = &mStorage;
+    initParams.opCertStore = &mOpCertStore;
+    ReturnErrorOnFailure(mFabricTable.Init(initParams));
+
+    ReturnErrorOnFailure(
+        mSessionManager.Init(&systemLayer, &mTransportMgr, &mMessageCounterManager, &mStorage, &mFabricTable, mSessionKeystore));
+    ReturnErrorOnFailure(mExchangeManager.Init(&mSessionManager));
+    return mMessageCounterManager.Init(&mExchangeManager);
+}
+
+void SimulatedNode::Shutdown()
+{
+    VerifyOrReturn(mInitialized);
+    mInitialized = false;
+
+    mMessageCounterManager.Shutdown();
+    mExchangeManager.Shutdown();
+    mSessionManager.Shutdown();
+    mFabricTable.Shutdown();
+    mOpCertStore.Finish();
+    mTransportMgr.Close();
+}
+
+CHIP_ERROR SimulatedNode::CreateSessionTo(SimulatedNode & peer, SessionHolder & session)
+{
+    const uint16_t localSessionId = mNextSessionId++;
+    const uint16_t peerSessionId  = peer.mNextSessionId++;
+
+    // The session of the peer stays in its session table until it shuts down.
+    SessionHolder peerSession;
+    ReturnErrorOnFailure(peer.mSessionManager.InjectPaseSessionWithTestKey(peerSession, peerSessionId, kUndefinedNodeId,
+                                                                           localSessionId, kUndefinedFabricIndex, GetAddress(),
+                                                                           CryptoContext::SessionRole::kResponder));
+    return mSessionManager.InjectPaseSessionWithTestKey(session, localSessionId, kUndefinedNodeId, peerSessionId,
+                                                        kUndefinedFabricIndex, peer.GetAddress(),
+                                                        CryptoContext::SessionRole::kInitiator);
+}
+
+void SimulatedNetworkContext::SetUpTestSuite()
+{
+    sIOContext = new IOContext();
+    ASSERT_EQ(sIOContext->Init(), CHIP_NO_ERROR);
+}
+
+void SimulatedNetworkContext::TearDownTestSuite()
+{
+    sIOContext->Shutdown();
+    delete sIOContext;
+    sIOContext = nullptr;
+}
+
+void SimulatedNetworkContext::SetUp()
+{
+    mRealClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    ASSERT_EQ(mNetwork.Init(*sIOContext, &mMockClock), CHIP_NO_ERROR);
+
+    // Keep the retransmission schedule of MRP independent of the host.
+    Messaging::ReliableMessageMgr::SetAdditionalMRPBackoffTime(MakeOptional(System::Clock::kZero));
+    // Draw the MRP backoff jitter from the seeded generator of the network: retransmissions, and hence which packets get
+    // lost, are then the same on every run.
+    Messaging::ReliableMessageMgr::SetBackoffJitterGeneratorForTesting(NextBackoffJitter, &mNetwork);
+}
+
+void SimulatedNetworkContext::TearDown()
+{
+    // Let the nodes close their exchanges while the network is still there.
+    mNodes.clear();
+    mNetwork.Shutdown();
+
+    Messaging::ReliableMessageMgr::SetBackoffJitterGeneratorForTesting(nullptr, nullptr);
+    Messaging::ReliableMessageMgr::SetAdditionalMRPBackoffTime(NullOptional);
+    System::Clock::Internal::SetSystemClockForTesting(mRealClock);
+}
+
+SimulatedNode * SimulatedNetworkContext::AddNode()
+{
+    auto node = std::make_unique<SimulatedNode>();
+    VerifyOrReturnValue(node->Init(mNetwork, sIOContext->GetSystemLayer()) == CHIP_NO_ERROR, nullptr);
+    mNodes.push_back(std::move(node));
+    return mNodes.back().get();
+}
+
+} // namespace Test
+} // namespace chip
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <pw_unit_test/framework.h>
+
+#include <credentials/FabricTable.h>
+#include <credentials/PersistentStorageOpCertStore.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <messaging/ExchangeMgr.h>
+#include <protocols/secure_channel/MessageCounterManager.h>
+#include <system/SystemClock.h>
+#include <transport/SessionManager.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+#include <transport/raw/tests/SimulatedNetwork.h>
+
+#include <memory>
+#include <vector>
+
+namespace chip {
+namespace Test {
+
+/**
+ * A node of a SimulatedNetwork with its own messaging stack: transport, session manager, exchange manager and
+ * message counter manager.  Nodes do not share any state, so a single process can run a controller and many devices.
+ */
+class SimulatedNode
+{
+public:
+    ~SimulatedNode() { Shutdown(); }
+
+    CHIP_ERROR Init(SimulatedNetwork & network, System::Layer & systemLayer);
+    void Shutdown();
+
+    /**
+     * Create a PASE session with test keys between this node and the peer.  On success, `session` holds the side of
+     * this node, which is the initiator.
+     */
+    CHIP_ERROR CreateSessionTo(SimulatedNode & peer, SessionHolder & session);
+
+    const Transport::PeerAddress & GetAddress() { return mTransportMgr.GetTransport().GetImplAtIndex<0>().GetAddress(); }
+    SessionManager & GetSessionManager() { return mSessionManager; }
+    Messaging::ExchangeManager & GetExchangeManager() { return mExchangeManager; }
+
+private:
+    bool mInitialized       = false;
+    uint16_t mNextSessionId = 1;
+
+    TransportMgr<SimulatedTransport> mTransportMgr;
+    TestPersistentStorageDelegate mStorage;
+    Credentials::PersistentStorageOpCertStore mOpCertStore;
+    Crypto::DefaultSessionKeystore mSessionKeystore;
+    FabricTable mFabricTable;
+    SessionManager mSessionManager;
+    Messaging::ExchangeManager mExchangeManager;
+    secure_channel::MessageCounterManager mMessageCounterManager;
+};
+
+/**
+ * Test fixture running any number of nodes over a SimulatedNetwork, with a mock clock driven by the network.
+ */
+class SimulatedNetworkContext : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+
+    void SetUp() override;
+    void TearDown() override;
+
+    /// Add a node to the network.  Returns nullptr on failure.  Nodes live until the end of the test.
+    SimulatedNode * AddNode();
+
+    SimulatedNetwork & GetNetwork() { return mNetwork; }
+    System::Clock::Internal::MockClock & GetClock() { return mMockClock; }
+    static IOContext & GetIOContext() { return *sIOContext; }
+
+private:
+    static IOContext * sIOContext;
+
+    System::Clock::ClockBase * mRealClock = nullptr;
+    System::Clock::Internal::MockClock mMockClock;
+    SimulatedNetwork mNetwork;
+    std::vector<std::unique_ptr<SimulatedNode>> mNodes;
+};
+
+} // namespace Test
+} // namespace chip
@@ -0,0 +1,270 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Messaging between one controller and many nodes over a simulated network, with latency, limited bandwidth
+ *      and packet loss.
+ */
+
+#include "SimulatedNetworkContext.h"
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <protocols/echo/Echo.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::Test;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+constexpr size_t kEchoPayloadLength = 32;
+
+// Long enough for MRP to go through all its retransmissions.
+constexpr System::Clock::Timeout kEchoResponseTimeout = 30_s;
+
+/// Sends echo requests to a single peer and records the round-trip time of each one.
+class EchoPinger : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR Ping(ExchangeManager & exchangeMgr, const SessionHandle & session)
+    {
+        VerifyOrReturnError(!mPending, CHIP_ERROR_BUSY);
+
+        uint8_t data[kEchoPayloadLength] = {};
+        System::PacketBufferHandle payload = MessagePacketBuffer::NewWithData(data, sizeof(data));
+        VerifyOrReturnError(!payload.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        ExchangeContext * ec = exchangeMgr.NewContext(session, this);
+        VerifyOrReturnError(ec != nullptr, CHIP_ERROR_NO_MEMORY);
+        ec->SetResponseTimeout(kEchoResponseTimeout);
+
+        mSentTime      = System::SystemClock().GetMonotonicTimestamp();
+        CHIP_ERROR err = ec->SendMessage(Protocols::Echo::MsgType::EchoRequest, std::move(payload),
+                                         SendFlags(SendMessageFlags::kExpectResponse));
+        if (err != CHIP_NO_ERROR)
+        {
+            ec->Close();
+            return err;
+        }
+        mPending = true;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        EXPECT_TRUE(payloadHeader.HasMessageType(Protocols::Echo::MsgType::EchoResponse));
+        EXPECT_EQ(buffer->DataLength(), kEchoPayloadLength);
+        mRoundTripTimes.push_back(System::SystemClock().GetMonotonicTimestamp() - mSentTime);
+        mPending = false;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override
+    {
+        mTimeouts++;
+        mPending = false;
+    }
+
+    bool IsPending() const { return mPending; }
+
+    std::vector<System::Clock::Milliseconds64> mRoundTripTimes;
+    size_t mTimeouts = 0;
+
+private:
+    System::Clock::Timestamp mSentTime = System::Clock::kZero;
+    bool mPending                      = false;
+};
+
+struct FleetResult
+{
+    size_t mResponses = 0;
+    size_t mTimeouts  = 0;
+    System::Clock::Milliseconds64 mDuration;
+    System::Clock::Milliseconds64 mMedianRoundTrip;
+    System::Clock::Milliseconds64 mP99RoundTrip;
+};
+
+} // namespace
+
+class TestMessagingAtScale : public SimulatedNetworkContext
+{
+protected:
+    /**
+     * Connect a controller to `nodeCount` echo servers, then run `rounds` rounds in which the controller pings every
+     * node at once and waits for all the answers.
+     */
+    FleetResult RunFleet(size_t nodeCount, size_t rounds, const SimulatedNetwork::LinkConditions & conditions)
+    {
+        FleetResult result;
+
+        SimulatedNode * controller = AddNode();
+        EXPECT_NE(controller, nullptr);
+        VerifyOrReturnValue(controller != nullptr, result);
+
+        std::vector<std::unique_ptr<Protocols::Echo::EchoServer>> servers;
+        std::vector<std::unique_ptr<SessionHolder>> sessions;
+        std::vector<EchoPinger> pingers(nodeCount);
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            SimulatedNode * node = AddNode();
+            EXPECT_NE(node, nullptr);
+            VerifyOrReturnValue(node != nullptr, result);
+
+            servers.push_back(std::make_unique<Protocols::Echo::EchoServer>());
+            EXPECT_EQ(servers.back()->Init(&node->GetExchangeManager()), CHIP_NO_ERROR);
+
+            sessions.push_back(std::make_unique<SessionHolder>());
+            EXPECT_EQ(controller->CreateSessionTo(*node, *sessions.back()), CHIP_NO_ERROR);
+        }
+
+        GetNetwork().SetDefaultLinkConditions(conditions);
+        GetNetwork().ResetStats();
+
+        const System::Clock::Timestamp start = GetClock().GetMonotonicTimestamp();
+        for (size_t round = 0; round < rounds; round++)
+        {
+            for (size_t i = 0; i < nodeCount; i++)
+            {
+                EXPECT_EQ(pingers[i].Ping(controller->GetExchangeManager(), sessions[i]->Get().Value()), CHIP_NO_ERROR);
+            }
+            EXPECT_TRUE(GetNetwork().RunUntil(
+                [&] { return std::none_of(pingers.begin(), pingers.end(), [](auto & p) { return p.IsPending(); }); }, 60_s));
+        }
+        result.mDuration = GetClock().GetMonotonicTimestamp() - start;
+
+        // Let the last acknowledgements go through before the exchanges are torn down.
+        GetNetwork().RunFor(1_s);
+
+        std::vector<System::Clock::Milliseconds64> roundTripTimes;
+        for (auto & pinger : pingers)
+        {
+            roundTripTimes.insert(roundTripTimes.end(), pinger.mRoundTripTimes.begin(), pinger.mRoundTripTimes.end());
+            result.mTimeouts += pinger.mTimeouts;
+        }
+        result.mResponses = roundTripTimes.size();
+        if (!roundTripTimes.empty())
+        {
+            std::sort(roundTripTimes.begin(), roundTripTimes.end());
+            result.mMedianRoundTrip = roundTripTimes[roundTripTimes.size() / 2];
+            result.mP99RoundTrip    = roundTripTimes[(roundTripTimes.size() * 99) / 100];
+        }
+
+        for (auto & server : servers)
+        {
+            server->Shutdown();
+        }
+        return result;
+    }
+};
+
+TEST_F(TestMessagingAtScale, TestEchoRoundTrip)
+{
+    SimulatedNetwork::LinkConditions conditions;
+    conditions.mLatency = 25_ms32;
+
+    FleetResult result = RunFleet(1, 3, conditions);
+    EXPECT_EQ(result.mResponses, 3u);
+    EXPECT_EQ(result.mTimeouts, 0u);
+
+    // Request, then response (which carries the acknowledgement of the request).
+    EXPECT_EQ(result.mMedianRoundTrip, 50_ms);
+    EXPECT_EQ(result.mP99RoundTrip, 50_ms);
+}
+
+TEST_F(TestMessagingAtScale, TestRetransmissionsRecoverLostMessages)
+{
+    SimulatedNetwork::LinkConditions conditions;
+    conditions.mLatency      = 10_ms32;
+    conditions.mLossPerMille = 100;
+    GetNetwork().SetSeed(7);
+
+    FleetResult result = RunFleet(20, 5, conditions);
+    EXPECT_EQ(result.mResponses, 100u);
+    EXPECT_EQ(result.mTimeouts, 0u);
+    EXPECT_GT(GetNetwork().GetStats().mPacketsLost, 0u);
+
+    // Lost messages were made up for by retransmissions, which take at least one MRP interval.
+    EXPECT_GT(result.mP99RoundTrip, 200_ms);
+}
+
+TEST_F(TestMessagingAtScale, TestLossyRunsAreReproducible)
+{
+    SimulatedNetwork::LinkConditions conditions;
+    conditions.mLatency      = 10_ms32;
+    conditions.mJitter       = 10_ms32;
+    conditions.mLossPerMille = 200;
+
+    GetNetwork().SetSeed(11);
+    FleetResult first                        = RunFleet(10, 5, conditions);
+    const SimulatedNetwork::Stats firstStats = GetNetwork().GetStats();
+
+    // Same seed, same outcome: packet loss and jitter, as well as MRP backoff, come from the seeded generator.
+    GetNetwork().SetSeed(11);
+    FleetResult second = RunFleet(10, 5, conditions);
+    EXPECT_EQ(second.mResponses, first.mResponses);
+    EXPECT_EQ(second.mTimeouts, first.mTimeouts);
+    EXPECT_EQ(second.mDuration, first.mDuration);
+    EXPECT_EQ(second.mMedianRoundTrip, first.mMedianRoundTrip);
+    EXPECT_EQ(second.mP99RoundTrip, first.mP99RoundTrip);
+    EXPECT_EQ(GetNetwork().GetStats().mPacketsSent, firstStats.mPacketsSent);
+    EXPECT_EQ(GetNetwork().GetStats().mPacketsLost, firstStats.mPacketsLost);
+    EXPECT_GT(firstStats.mPacketsLost, 0u);
+}
+
+// A controller talking to 100 nodes over a Thread-like link: 31.25 kB/s, a few tens of milliseconds of latency.
+TEST_F(TestMessagingAtScale, TestFleetOfEchoServers)
+{
+    SimulatedNetwork::LinkConditions conditions;
+    conditions.mLatency                 = 20_ms32;
+    conditions.mJitter                  = 10_ms32;
+    conditions.mBandwidthBytesPerSecond = 31250;
+
+    FleetResult result = RunFleet(100, 10, conditions);
+    EXPECT_EQ(result.mResponses, 1000u);
+    EXPECT_EQ(result.mTimeouts, 0u);
+
+    // Request, response, then standalone acknowledgement of the response: nothing was retransmitted.
+    EXPECT_EQ(GetNetwork().GetStats().mPacketsSent, 3000u);
+    EXPECT_EQ(GetNetwork().GetStats().mPacketsLost, 0u);
+}
+
+TEST_F(TestMessagingAtScale, TestFleetOfEchoServersWithLoss)
+{
+    SimulatedNetwork::LinkConditions conditions;
+    conditions.mLatency                 = 20_ms32;
+    conditions.mJitter                  = 10_ms32;
+    conditions.mBandwidthBytesPerSecond = 31250;
+    conditions.mLossPerMille            = 100;
+
+    FleetResult result = RunFleet(100, 10, conditions);
+    EXPECT_EQ(result.mResponses, 1000u);
+    EXPECT_EQ(result.mTimeouts, 0u);
+    EXPECT_GT(GetNetwork().GetStats().mPacketsLost, 0u);
+}
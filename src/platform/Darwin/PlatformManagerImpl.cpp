@@ -59,6 +59,12 @@ PlatformManagerImpl::PlatformManagerImpl() :
     // Tag our queue for IsWorkQueueCurrentQueue()
     dispatch_queue_set_specific(mWorkQueue, this, this, nullptr);
     dispatch_suspend(mWorkQueue);
+
+#if CHIP_SYSTEM_CONFIG_USE_DISPATCH && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    mBackgroundQueue = dispatch_queue_create("org.csa-iot.matter.backgroundqueue",
+                                             dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL,
+                                                                                     QOS_CLASS_UTILITY, QOS_MIN_RELATIVE_PRIORITY));
+#endif
 }
 
 CHIP_ERROR PlatformManagerImpl::_InitChipStack()
@@ -141,6 +147,44 @@ CHIP_ERROR PlatformManagerImpl::_PostEvent(const ChipDeviceEvent * event)
     });
     return CHIP_NO_ERROR;
 }
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+CHIP_ERROR PlatformManagerImpl::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    VerifyOrReturnError(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Without a background event loop, the work runs on the work queue, as it does on platforms
+    // that do not process background events.
+    if (!mBackgroundQueueRunning.load())
+    {
+        return _PostEvent(event);
+    }
+
+    const ChipDeviceEvent eventCopy = *event;
+    dispatch_async(mBackgroundQueue, ^{
+        DispatchEvent(&eventCopy);
+    });
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PlatformManagerImpl::_StartBackgroundEventLoopTask()
+{
+    bool expected = false;
+    VerifyOrReturnError(mBackgroundQueueRunning.compare_exchange_strong(expected, true), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PlatformManagerImpl::_StopBackgroundEventLoopTask()
+{
+    bool expected = true;
+    VerifyOrReturnError(mBackgroundQueueRunning.compare_exchange_strong(expected, false), CHIP_ERROR_INCORRECT_STATE);
+
+    // Wait for the work already queued, whose completion may still be posted to the work queue.
+    dispatch_sync(mBackgroundQueue, ^{});
+    return CHIP_NO_ERROR;
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
 #endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
 
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
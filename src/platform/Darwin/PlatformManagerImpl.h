@@ -79,6 +79,12 @@ private:
     bool _TryLockChipStack() { return false; };
     void _UnlockChipStack(){};
     CHIP_ERROR _PostEvent(const ChipDeviceEvent * event);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
 #endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
 
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
@@ -110,6 +116,13 @@ private:
 
     // Semaphore used to implement blocking behavior in _RunEventLoop.
     dispatch_semaphore_t mRunLoopSem;
+
+#if CHIP_SYSTEM_CONFIG_USE_DISPATCH && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Runs the work scheduled with ScheduleBackgroundWork() while the background event loop task is
+    // started; otherwise that work goes to mWorkQueue.
+    dispatch_queue_t mBackgroundQueue;
+    std::atomic<bool> mBackgroundQueueRunning{ false };
+#endif
 };
 
 /**
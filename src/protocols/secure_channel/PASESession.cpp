@@ -29,6 +29,7 @@
  */
 #include <protocols/secure_channel/PASESession.h>
 
+#include <atomic>
 #include <inttypes.h>
 #include <string.h>
 
@@ -40,6 +41,7 @@
 #include <lib/support/SafeInt.h>
 #include <lib/support/TypeTraits.h>
 #include <messaging/SessionParameters.h>
+#include <platform/PlatformManager.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/Constants.h>
 #include <protocols/secure_channel/StatusReport.h>
@@ -68,6 +70,92 @@ const char kSpake2pR2ISessionInfo[] = "Commissioning R2I Key";
 static constexpr ExchangeContext::Timeout kExpectedLowProcessingTime  = System::Clock::Seconds16(2);
 static constexpr ExchangeContext::Timeout kExpectedHighProcessingTime = System::Clock::Seconds16(30);
 
+// PBKDF2 for the commissioner side of a pairing, run via `PlatformManager::ScheduleBackgroundWork` with the result
+// posted back to the Matter thread via `PlatformManager::ScheduleWork`.  The background part only uses the copies
+// of the inputs held by the work; the session is only accessed from the Matter thread, and not at all once it
+// cancelled the work.
+class PASESession::ComputeWSWork
+{
+public:
+    ComputeWSWork(PASESession & session, uint32_t passcode, uint32_t iterationCount) :
+        mSession(&session), mPasscode(passcode), mIterationCount(iterationCount)
+    {}
+
+    ~ComputeWSWork() { Crypto::ClearSecretData(mSerializedWS); }
+
+    CHIP_ERROR SetSalt(const ByteSpan & salt)
+    {
+        VerifyOrReturnError(salt.size() <= sizeof(mSalt), CHIP_ERROR_INVALID_ARGUMENT);
+        memcpy(mSalt, salt.data(), salt.size());
+        mSaltLength = salt.size();
+        return CHIP_NO_ERROR;
+    }
+
+    // The work keeps itself alive while it is queued, whatever happens to the session.
+    static CHIP_ERROR Schedule(const Platform::SharedPtr<ComputeWSWork> & work)
+    {
+        work->mStrongPtr = work;
+        CHIP_ERROR err   = DeviceLayer::PlatformMgr().ScheduleBackgroundWork(WorkHandler, reinterpret_cast<intptr_t>(work.get()));
+        if (err != CHIP_NO_ERROR)
+        {
+            work->mStrongPtr.reset();
+        }
+        return err;
+    }
+
+    void Cancel() { mSession.store(nullptr); }
+
+    uint32_t GetPasscode() const { return mPasscode; }
+    uint32_t GetIterationCount() const { return mIterationCount; }
+    ByteSpan GetSalt() const { return ByteSpan(mSalt, mSaltLength); }
+    const uint8_t (&GetSerializedWS() const)[PASEVerifierCache::kWSLength] { return mSerializedWS; }
+    CHIP_ERROR GetStatus() const { return mStatus; }
+
+private:
+    static void WorkHandler(intptr_t arg)
+    {
+        auto * work = reinterpret_cast<ComputeWSWork *>(arg);
+        auto strongPtr(std::move(work->mStrongPtr));
+        VerifyOrReturn(work->mSession.load() != nullptr);
+
+        work->mStatus = Spake2pVerifier::ComputeWS(work->mIterationCount, work->GetSalt(), work->mPasscode, work->mSerializedWS,
+                                                   sizeof(work->mSerializedWS));
+        VerifyOrReturn(work->mSession.load() != nullptr);
+
+        work->mStrongPtr.swap(strongPtr);
+        CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(AfterWorkHandler, arg);
+        if (err != CHIP_NO_ERROR)
+        {
+            // Nothing else references the work on this thread, so it is released here.
+            ChipLogError(SecureChannel, "Failed to schedule the PBKDF2 completion: %" CHIP_ERROR_FORMAT, err.Format());
+            strongPtr.swap(work->mStrongPtr);
+        }
+    }
+
+    static void AfterWorkHandler(intptr_t arg)
+    {
+        assertChipStackLockedByCurrentThread();
+
+        auto * work = reinterpret_cast<ComputeWSWork *>(arg);
+        auto strongPtr(std::move(work->mStrongPtr));
+        if (auto * session = work->mSession.load())
+        {
+            session->OnComputeWSDone(*work);
+        }
+    }
+
+    Platform::SharedPtr<ComputeWSWork> mStrongPtr;
+    std::atomic<PASESession *> mSession;
+
+    const uint32_t mPasscode;
+    const uint32_t mIterationCount;
+    uint8_t mSalt[kSpake2p_Max_PBKDF_Salt_Length];
+    size_t mSaltLength = 0;
+
+    uint8_t mSerializedWS[PASEVerifierCache::kWSLength] = { 0 };
+    CHIP_ERROR mStatus                                  = CHIP_NO_ERROR;
+};
+
 PASESession::~PASESession()
 {
     // Let's clear out any security state stored in the object, before destroying it.
@@ -95,6 +183,12 @@ void PASESession::Clear()
     memset(&mPASEVerifier, 0, sizeof(mPASEVerifier));
     mNextExpectedMsg.ClearValue();
 
+    if (mComputeWSWork)
+    {
+        mComputeWSWork->Cancel();
+        mComputeWSWork.reset();
+    }
+
     mSpake2p.Clear();
     mCommissioningHash.Clear();
 
@@ -109,6 +203,12 @@ void PASESession::Clear()
     PairingSession::Clear();
 }
 
+void PASESession::EraseFromVerifierCache()
+{
+    VerifyOrReturn(mVerifierCache != nullptr);
+    mVerifierCache->Erase(mSetupPINCode);
+}
+
 CHIP_ERROR PASESession::Init(SessionManager & sessionManager, uint32_t setupCode, SessionEstablishmentDelegate * delegate)
 {
     MATTER_TRACE_SCOPE("Init", "PASESession");
@@ -458,7 +558,6 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
 
     uint32_t decodeTagIdSeq = 0;
     ByteSpan salt;
-    uint8_t serializedWS[kSpake2p_WS_Length * 2] = { 0 };
 
     ChipLogDetail(SecureChannel, "Received PBKDF param response");
 
@@ -525,22 +624,98 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
     err = SetupSpake2p();
     SuccessOrExit(err);
 
-    err = Spake2pVerifier::ComputeWS(mIterationCount, salt, mSetupPINCode, serializedWS, sizeof(serializedWS));
+    err = ComputeWSAndSendMsg1(salt);
     SuccessOrExit(err);
 
-    err = mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &serializedWS[0], kSpake2p_WS_Length, &serializedWS[kSpake2p_WS_Length],
-                               kSpake2p_WS_Length);
-    SuccessOrExit(err);
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+    }
+    return err;
+}
+
+CHIP_ERROR PASESession::ComputeWSAndSendMsg1(const ByteSpan & salt)
+{
+    MATTER_TRACE_SCOPE("ComputeWS", "PASESession");
+    uint8_t serializedWS[PASEVerifierCache::kWSLength] = { 0 };
+    CHIP_ERROR err                                     = CHIP_NO_ERROR;
+
+    if (mVerifierCache != nullptr && mVerifierCache->Find(mSetupPINCode, mIterationCount, salt, serializedWS))
+    {
+        ChipLogDetail(SecureChannel, "Using cached PBKDF2 output");
+        err = BeginProverAndSendMsg1(serializedWS);
+        ClearSecretData(serializedWS);
+        return err;
+    }
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // With up to 100000 iterations, PBKDF2 would hold the Matter thread for a long time.  Run it in the
+    // background when possible, the session resumes in OnComputeWSDone().  If the background work cannot
+    // be scheduled, compute it inline instead.
+    {
+        auto work = Platform::MakeShared<ComputeWSWork>(*this, mSetupPINCode, mIterationCount);
+        VerifyOrReturnError(work, CHIP_ERROR_NO_MEMORY);
+        ReturnErrorOnFailure(work->SetSalt(salt));
+        if (ComputeWSWork::Schedule(work) == CHIP_NO_ERROR)
+        {
+            mComputeWSWork = work;
+            mExchangeCtxt.Value()->WillSendMessage();
+            // Only a status report from the peer is expected until Pake1 is sent.
+            mNextExpectedMsg.ClearValue();
+            return CHIP_NO_ERROR;
+        }
+    }
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
+    err = Spake2pVerifier::ComputeWS(mIterationCount, salt, mSetupPINCode, serializedWS, sizeof(serializedWS));
+    if (err == CHIP_NO_ERROR)
+    {
+        if (mVerifierCache != nullptr)
+        {
+            mVerifierCache->Insert(mSetupPINCode, mIterationCount, salt, serializedWS);
+        }
+        err = BeginProverAndSendMsg1(serializedWS);
+    }
+    ClearSecretData(serializedWS);
+    return err;
+}
+
+void PASESession::OnComputeWSDone(ComputeWSWork & work)
+{
+    MATTER_TRACE_SCOPE("OnComputeWSDone", "PASESession");
+    // `work` is kept alive by the caller.
+    mComputeWSWork.reset();
 
-    err = SendMsg1();
+    CHIP_ERROR err = work.GetStatus();
     SuccessOrExit(err);
 
+    if (mVerifierCache != nullptr)
+    {
+        mVerifierCache->Insert(work.GetPasscode(), work.GetIterationCount(), work.GetSalt(), work.GetSerializedWS());
+    }
+    err = BeginProverAndSendMsg1(work.GetSerializedWS());
+
 exit:
     if (err != CHIP_NO_ERROR)
     {
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        // Abort the pairing, which is normally done by PASESession::OnMessageReceived, but in the
+        // background processing case must be done here.
+        DiscardExchange();
+        Clear();
+        ChipLogError(SecureChannel, "Failed during PASE session setup: %" CHIP_ERROR_FORMAT, err.Format());
+        MATTER_TRACE_COUNTER("PASEFail");
+        // Do this last in case the delegate frees us.
+        NotifySessionEstablishmentError(err);
     }
-    return err;
+}
+
+CHIP_ERROR PASESession::BeginProverAndSendMsg1(const uint8_t (&serializedWS)[PASEVerifierCache::kWSLength])
+{
+    ReturnErrorOnFailure(mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &serializedWS[0], kSpake2p_WS_Length,
+                                              &serializedWS[kSpake2p_WS_Length], kSpake2p_WS_Length));
+    return SendMsg1();
 }
 
 CHIP_ERROR PASESession::SendMsg1()
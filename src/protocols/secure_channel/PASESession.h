@@ -31,10 +31,12 @@
 #include <crypto/PSASpake2p.h>
 #endif
 #include <lib/support/Base64.h>
+#include <lib/support/CHIPMem.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeDelegate.h>
 #include <messaging/ExchangeMessageDispatch.h>
 #include <protocols/secure_channel/Constants.h>
+#include <protocols/secure_channel/PASEVerifierCache.h>
 #include <protocols/secure_channel/PairingSession.h>
 #include <protocols/secure_channel/SessionEstablishmentExchangeDispatch.h>
 #include <system/SystemPacketBuffer.h>
@@ -106,6 +108,20 @@ public:
                     Optional<ReliableMessageProtocolConfig> mrpLocalConfig, Messaging::ExchangeContext * exchangeCtxt,
                     SessionEstablishmentDelegate * delegate);
 
+    /**
+     * @brief
+     *   Set the cache the commissioner side of the pairing (see Pair()) looks up the PBKDF2 output in, and
+     *   adds it to once computed.  The cache must outlive the pairing.  Pass nullptr to always run PBKDF2.
+     */
+    void SetVerifierCache(PASEVerifierCache * verifierCache) { mVerifierCache = verifierCache; }
+
+    /**
+     * @brief
+     *   Erase the PBKDF2 output computed from the setup PIN code of this pairing from the verifier cache (see
+     *   SetVerifierCache()), e.g. once the peer has been commissioned and the PIN code is of no further use.
+     */
+    void EraseFromVerifierCache();
+
     /**
      * @brief
      *   Generate a new PASE verifier.
@@ -186,6 +202,12 @@ private:
     CHIP_ERROR SendPBKDFParamResponse(ByteSpan initiatorRandom, bool initiatorHasPBKDFParams);
     CHIP_ERROR HandlePBKDFParamResponse(System::PacketBufferHandle && msg);
 
+    class ComputeWSWork;
+
+    CHIP_ERROR ComputeWSAndSendMsg1(const ByteSpan & salt);
+    void OnComputeWSDone(ComputeWSWork & work);
+    CHIP_ERROR BeginProverAndSendMsg1(const uint8_t (&serializedWS)[PASEVerifierCache::kWSLength]);
+
     CHIP_ERROR SendMsg1();
 
     CHIP_ERROR HandleMsg1_and_SendMsg2(System::PacketBufferHandle && msg);
@@ -220,6 +242,11 @@ private:
     uint16_t mSaltLength     = 0;
     uint8_t * mSalt          = nullptr;
 
+    PASEVerifierCache * mVerifierCache = nullptr;
+
+    // PBKDF2 run in the background for the commissioner, while the session waits for it.
+    Platform::SharedPtr<ComputeWSWork> mComputeWSWork;
+
     struct Spake2pErrorMsg
     {
         Spake2pErrorType error;
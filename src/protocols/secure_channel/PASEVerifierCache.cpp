@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/PASEVerifierCache.h>
+
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+
+bool PASEVerifierCache::Matches(const Entry & entry, uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt) const
+{
+    return entry.lastUse != 0 && entry.passcode == passcode && entry.iterationCount == iterationCount &&
+        salt.data_equal(ByteSpan(entry.salt, entry.saltLength));
+}
+
+void PASEVerifierCache::ClearExpired()
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    for (auto & entry : mEntries)
+    {
+        if (entry.lastUse != 0 && now - entry.insertTime >= System::Clock::Seconds32(CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS))
+        {
+            Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(&entry), sizeof(entry));
+        }
+    }
+}
+
+bool PASEVerifierCache::Find(uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt, uint8_t (&ws)[kWSLength])
+{
+    ClearExpired();
+    for (auto & entry : mEntries)
+    {
+        if (Matches(entry, passcode, iterationCount, salt))
+        {
+            entry.lastUse = ++mUseCounter;
+            memcpy(ws, entry.ws, kWSLength);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PASEVerifierCache::Insert(uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt, const uint8_t (&ws)[kWSLength])
+{
+    VerifyOrReturn(salt.size() <= sizeof(Entry::salt));
+    ClearExpired();
+
+    Entry * slot = nullptr;
+    for (auto & entry : mEntries)
+    {
+        if (Matches(entry, passcode, iterationCount, salt))
+        {
+            slot = &entry;
+            break;
+        }
+        if (slot == nullptr || entry.lastUse < slot->lastUse)
+        {
+            slot = &entry;
+        }
+    }
+    VerifyOrReturn(slot != nullptr);
+
+    if (mUseCounter == UINT32_MAX)
+    {
+        // Restart the use counter rather than let it wrap, which would make recent entries look old.
+        Clear();
+        slot = &mEntries[0];
+    }
+
+    Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(slot), sizeof(*slot));
+    slot->passcode       = passcode;
+    slot->iterationCount = iterationCount;
+    memcpy(slot->salt, salt.data(), salt.size());
+    slot->saltLength = static_cast<uint8_t>(salt.size());
+    memcpy(slot->ws, ws, kWSLength);
+    slot->lastUse    = ++mUseCounter;
+    slot->insertTime = System::SystemClock().GetMonotonicTimestamp();
+}
+
+void PASEVerifierCache::Erase(uint32_t passcode)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.lastUse != 0 && entry.passcode == passcode)
+        {
+            Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(&entry), sizeof(entry));
+        }
+    }
+}
+
+void PASEVerifierCache::Clear()
+{
+    Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mEntries), sizeof(mEntries));
+    mUseCounter = 0;
+}
+
+} // namespace chip
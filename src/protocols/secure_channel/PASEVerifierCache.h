@@ -0,0 +1,97 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+
+static_assert(CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE > 0, "CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE must be at least 1");
+
+namespace chip {
+
+/**
+ * Keeps the PBKDF2 output (w0s || w1s) that a commissioner derives from a setup passcode, keyed by the
+ * passcode, the salt and the iteration count.  A PASE session that finds its parameters in the cache does
+ * not run PBKDF2, which takes up to 100000 iterations, again: e.g. when commissioning is retried, or when
+ * several devices share the same PBKDF parameters.
+ *
+ * Since w0s || w1s is as good as the passcode to whoever holds it, entries expire
+ * CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS after they were computed, and the commissioner erases the
+ * entries of a passcode once a device has been commissioned with it.  When the cache is full, the least
+ * recently used entry is evicted.  Expired, erased and evicted entries are cleared.
+ *
+ * The cache is not thread-safe and must only be used from the Matter thread.
+ */
+class PASEVerifierCache
+{
+public:
+    static constexpr size_t kWSLength = 2 * Crypto::kSpake2p_WS_Length;
+
+    PASEVerifierCache() = default;
+    ~PASEVerifierCache() { Clear(); }
+
+    PASEVerifierCache(const PASEVerifierCache &)             = delete;
+    PASEVerifierCache & operator=(const PASEVerifierCache &) = delete;
+
+    /**
+     * Copies the cached w0s || w1s for the given parameters into `ws`.
+     *
+     * @return true if the parameters were found and have not expired, false otherwise (`ws` is left untouched).
+     */
+    bool Find(uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt, uint8_t (&ws)[kWSLength]);
+
+    /**
+     * Adds (or refreshes) the w0s || w1s computed for the given parameters.
+     */
+    void Insert(uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt, const uint8_t (&ws)[kWSLength]);
+
+    /**
+     * Clears the entries computed from the given passcode, whatever their salt and iteration count.
+     */
+    void Erase(uint32_t passcode);
+
+    /**
+     * Clears all the entries.
+     */
+    void Clear();
+
+private:
+    struct Entry
+    {
+        uint32_t passcode;
+        uint32_t iterationCount;
+        uint8_t salt[Crypto::kSpake2p_Max_PBKDF_Salt_Length];
+        uint8_t saltLength;
+        uint8_t ws[kWSLength];
+        uint32_t lastUse; // 0 for unused entries
+        System::Clock::Timestamp insertTime;
+    };
+
+    bool Matches(const Entry & entry, uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt) const;
+    void ClearExpired();
+
+    Entry mEntries[CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE] = {};
+    uint32_t mUseCounter                                 = 0;
+};
+
+} // namespace chip
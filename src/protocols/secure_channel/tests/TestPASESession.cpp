@@ -33,6 +33,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestUtils.h>
 #include <messaging/tests/MessagingContext.h>
+#include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/PASESession.h>
 #include <stdarg.h>
 
@@ -89,18 +90,48 @@ class TestSecurePairingDelegate;
 class TestPASESession : public chip::Test::LoopbackMessagingContext
 {
 public:
+    static void SetUpTestSuite()
+    {
+        LoopbackMessagingContext::SetUpTestSuite();
+        ASSERT_EQ(chip::DeviceLayer::PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+        chip::DeviceLayer::SetSystemLayerForTesting(&GetSystemLayer());
+    }
+
+    static void TearDownTestSuite()
+    {
+        chip::DeviceLayer::SetSystemLayerForTesting(nullptr);
+        chip::DeviceLayer::PlatformMgr().Shutdown();
+        LoopbackMessagingContext::TearDownTestSuite();
+    }
+
     void SetUp() override
     {
         ConfigInitializeNodes(false);
         chip::Test::LoopbackMessagingContext::SetUp();
     }
 
+    void ServiceEvents();
     void SecurePairingHandshakeTestCommon(SessionManager & sessionManager, PASESession & pairingCommissioner,
                                           Optional<ReliableMessageProtocolConfig> mrpCommissionerConfig,
                                           Optional<ReliableMessageProtocolConfig> mrpAccessoryConfig,
                                           TestSecurePairingDelegate & delegateCommissioner);
 };
 
+void TestPASESession::ServiceEvents()
+{
+    // The commissioner may run PBKDF2 as background work, which is processed by the platform event loop.
+    // Takes a few rounds of this because handling IO messages may schedule work, and scheduled work may
+    // queue messages for sending...
+    for (int i = 0; i < 3; ++i)
+    {
+        DrainAndServiceIO();
+
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(
+            [](intptr_t) -> void { chip::DeviceLayer::PlatformMgr().StopEventLoopTask(); }, (intptr_t) nullptr);
+        chip::DeviceLayer::PlatformMgr().RunEventLoop();
+    }
+}
+
 class PASETestLoopbackTransportDelegate : public Test::LoopbackTransportDelegate
 {
 public:
@@ -296,7 +327,7 @@ void TestPASESession::SecurePairingHandshakeTestCommon(SessionManager & sessionM
     EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode, mrpCommissionerConfig, contextCommissioner,
                                        &delegateCommissioner),
               CHIP_NO_ERROR);
-    DrainAndServiceIO();
+    ServiceEvents();
 
     while (delegate.mMessageDropped)
     {
@@ -314,7 +345,7 @@ void TestPASESession::SecurePairingHandshakeTestCommon(SessionManager & sessionM
         chip::test_utils::SleepMillis(waitTimeout.count());
         delegate.mMessageDropped = false;
         ReliableMessageMgr::Timeout(&GetSystemLayer(), GetExchangeManager().GetReliableMessageMgr());
-        DrainAndServiceIO();
+        ServiceEvents();
     };
 
     // Standalone acks also increment the mSentMessageCount. But some messages could be acked
@@ -470,14 +501,186 @@ TEST_F(TestPASESession, SecurePairingFailedHandshake)
     EXPECT_EQ(pairingCommissioner.Pair(sessionManager, 4321, Optional<ReliableMessageProtocolConfig>::Missing(),
                                        contextCommissioner, &delegateCommissioner),
               CHIP_NO_ERROR);
+    ServiceEvents();
+
+    EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateAccessory.mNumPairingErrors, 1u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 1u);
+}
+
+TEST_F(TestPASESession, SecurePairingHandshakeWithVerifierCacheTest)
+{
+    TemporarySessionManager sessionManager(*this);
+
+    PASEVerifierCache verifierCache;
+    auto & loopback = GetLoopback();
+
+    uint8_t expectedWS[PASEVerifierCache::kWSLength];
+    ASSERT_EQ(Spake2pVerifier::ComputeWS(sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), sTestSpake2p01_PinCode,
+                                         expectedWS, sizeof(expectedWS)),
+              CHIP_NO_ERROR);
+
+    // The first pairing adds the PBKDF2 output to the cache, the second one finds it there.
+    for (int i = 0; i < 2; i++)
+    {
+        TestSecurePairingDelegate delegateCommissioner;
+        PASESession pairingCommissioner;
+        pairingCommissioner.SetVerifierCache(&verifierCache);
+        loopback.Reset();
+        SecurePairingHandshakeTestCommon(sessionManager, pairingCommissioner, Optional<ReliableMessageProtocolConfig>::Missing(),
+                                         Optional<ReliableMessageProtocolConfig>::Missing(), delegateCommissioner);
+
+        uint8_t ws[PASEVerifierCache::kWSLength];
+        EXPECT_TRUE(verifierCache.Find(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), ws));
+        EXPECT_TRUE(ByteSpan(ws).data_equal(ByteSpan(expectedWS)));
+    }
+}
+
+TEST_F(TestPASESession, SecurePairingHandshakeUsesVerifierCacheTest)
+{
+    TemporarySessionManager sessionManager(*this);
+
+    TestSecurePairingDelegate delegateCommissioner;
+    PASESession pairingCommissioner;
+
+    TestSecurePairingDelegate delegateAccessory;
+    PASESession pairingAccessory;
+
+    auto & loopback = GetLoopback();
+    loopback.Reset();
+    loopback.mSentMessageCount = 0;
+
+    // Cache the PBKDF2 output of another passcode under the right one: the pairing only fails if the
+    // commissioner takes it from the cache instead of running PBKDF2.
+    PASEVerifierCache verifierCache;
+    uint8_t wrongWS[PASEVerifierCache::kWSLength];
+    ASSERT_EQ(Spake2pVerifier::ComputeWS(sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), 4321, wrongWS,
+                                         sizeof(wrongWS)),
+              CHIP_NO_ERROR);
+    verifierCache.Insert(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), wrongWS);
+    pairingCommissioner.SetVerifierCache(&verifierCache);
+
+    ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+    contextCommissioner->GetSessionHandle()->AsUnauthenticatedSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        64_ms32, // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        64_ms32, // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::PBKDFParamRequest,
+                                                                            &pairingAccessory),
+              CHIP_NO_ERROR);
+
+    EXPECT_EQ(pairingAccessory.WaitForPairing(sessionManager, sTestSpake2p01_PASEVerifier, sTestSpake2p01_IterationCount,
+                                              ByteSpan(sTestSpake2p01_Salt), Optional<ReliableMessageProtocolConfig>::Missing(),
+                                              &delegateAccessory),
+              CHIP_NO_ERROR);
     DrainAndServiceIO();
 
+    EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode, Optional<ReliableMessageProtocolConfig>::Missing(),
+                                       contextCommissioner, &delegateCommissioner),
+              CHIP_NO_ERROR);
+    ServiceEvents();
+
     EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
     EXPECT_EQ(delegateAccessory.mNumPairingErrors, 1u);
     EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
     EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 1u);
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+TEST_F(TestPASESession, SecurePairingHandshakeInBackgroundTest)
+{
+    TemporarySessionManager sessionManager(*this);
+    PASEVerifierCache verifierCache;
+    auto & loopback = GetLoopback();
+
+    // Runs the handshake up to the point where the commissioner has scheduled PBKDF2 as background work.
+    // Only IO is serviced, so the work stays queued until the platform event loop runs.
+    auto startPairing = [&](PASESession & pairingCommissioner, TestSecurePairingDelegate & delegateCommissioner,
+                            PASESession & pairingAccessory, TestSecurePairingDelegate & delegateAccessory) {
+        loopback.Reset();
+        pairingCommissioner.SetVerifierCache(&verifierCache);
+        ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+        EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                      Protocols::SecureChannel::MsgType::PBKDFParamRequest, &pairingAccessory),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(pairingAccessory.WaitForPairing(sessionManager, sTestSpake2p01_PASEVerifier, sTestSpake2p01_IterationCount,
+                                                  ByteSpan(sTestSpake2p01_Salt),
+                                                  Optional<ReliableMessageProtocolConfig>::Missing(), &delegateAccessory),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode,
+                                           Optional<ReliableMessageProtocolConfig>::Missing(), contextCommissioner,
+                                           &delegateCommissioner),
+                  CHIP_NO_ERROR);
+        DrainAndServiceIO();
+    };
+
+    uint8_t ws[PASEVerifierCache::kWSLength];
+
+    // The pairing resumes once the background work completes.
+    {
+        TestSecurePairingDelegate delegateCommissioner;
+        PASESession pairingCommissioner;
+        TestSecurePairingDelegate delegateAccessory;
+        PASESession pairingAccessory;
+
+        startPairing(pairingCommissioner, delegateCommissioner, pairingAccessory, delegateAccessory);
+        EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+        EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+        EXPECT_FALSE(verifierCache.Find(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), ws));
+
+        ServiceEvents();
+        EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+        EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 1u);
+        EXPECT_EQ(delegateAccessory.mNumPairingErrors, 0u);
+        EXPECT_EQ(delegateAccessory.mNumPairingComplete, 1u);
+        EXPECT_TRUE(verifierCache.Find(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), ws));
+
+        pairingCommissioner.CopySecureSession().Value()->AsSecureSession()->MarkForEviction();
+        pairingAccessory.CopySecureSession().Value()->AsSecureSession()->MarkForEviction();
+        DrainAndServiceIO();
+    }
+
+    // Clear() cancels the work: the commissioner neither resumes the pairing nor reports anything.
+    verifierCache.Clear();
+    {
+        TestSecurePairingDelegate delegateCommissioner;
+        PASESession pairingCommissioner;
+        TestSecurePairingDelegate delegateAccessory;
+        PASESession pairingAccessory;
+
+        startPairing(pairingCommissioner, delegateCommissioner, pairingAccessory, delegateAccessory);
+        pairingCommissioner.Clear();
+
+        ServiceEvents();
+        EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+        EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+        EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+        EXPECT_FALSE(verifierCache.Find(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), ws));
+    }
+
+    // So does destroying the session, the work outlives it.
+    {
+        TestSecurePairingDelegate delegateCommissioner;
+        TestSecurePairingDelegate delegateAccessory;
+        PASESession pairingAccessory;
+        {
+            PASESession pairingCommissioner;
+            startPairing(pairingCommissioner, delegateCommissioner, pairingAccessory, delegateAccessory);
+        }
+
+        ServiceEvents();
+        EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+        EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+        EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+        EXPECT_FALSE(verifierCache.Find(sTestSpake2p01_PinCode, sTestSpake2p01_IterationCount, ByteSpan(sTestSpake2p01_Salt), ws));
+    }
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 TEST_F(TestPASESession, PASEVerifierSerializeTest)
 {
     Spake2pVerifier verifier;
@@ -0,0 +1,176 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/CHIPCore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <protocols/secure_channel/PASEVerifierCache.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr uint32_t kPasscode       = 20202021;
+constexpr uint32_t kIterationCount = 1000;
+constexpr uint8_t kSalt[]          = { 0x53, 0x50, 0x41, 0x4B, 0x45, 0x32, 0x50, 0x20,
+                                       0x4B, 0x65, 0x79, 0x20, 0x53, 0x61, 0x6C, 0x74 };
+
+void FillWS(uint8_t (&ws)[PASEVerifierCache::kWSLength], uint8_t value)
+{
+    memset(ws, value, sizeof(ws));
+}
+
+bool FindWS(PASEVerifierCache & cache, uint32_t passcode, uint32_t iterationCount, const ByteSpan & salt, uint8_t expectedValue)
+{
+    uint8_t ws[PASEVerifierCache::kWSLength];
+    uint8_t expectedWS[PASEVerifierCache::kWSLength];
+    FillWS(expectedWS, expectedValue);
+    return cache.Find(passcode, iterationCount, salt, ws) && memcmp(ws, expectedWS, sizeof(ws)) == 0;
+}
+
+TEST(TestPASEVerifierCache, TestFindMatchesAllParameters)
+{
+    PASEVerifierCache cache;
+    uint8_t ws[PASEVerifierCache::kWSLength];
+
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(kSalt), ws));
+
+    FillWS(ws, 1);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(kSalt), ws);
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 1));
+
+    uint8_t otherSalt[sizeof(kSalt)];
+    memcpy(otherSalt, kSalt, sizeof(kSalt));
+    otherSalt[0] ^= 1;
+
+    EXPECT_FALSE(cache.Find(kPasscode + 1, kIterationCount, ByteSpan(kSalt), ws));
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount + 1, ByteSpan(kSalt), ws));
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(otherSalt), ws));
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(kSalt).SubSpan(0, sizeof(kSalt) - 1), ws));
+
+    // Inserting the same parameters again replaces the entry.
+    FillWS(ws, 2);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(kSalt), ws);
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 2));
+
+    cache.Clear();
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(kSalt), ws));
+}
+
+TEST(TestPASEVerifierCache, TestEvictsLeastRecentlyUsed)
+{
+    PASEVerifierCache cache;
+    uint8_t ws[PASEVerifierCache::kWSLength];
+
+    // Fill the cache, one passcode per entry.
+    for (uint32_t i = 0; i < CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE; i++)
+    {
+        FillWS(ws, static_cast<uint8_t>(i));
+        cache.Insert(kPasscode + i, kIterationCount, ByteSpan(kSalt), ws);
+    }
+    for (uint32_t i = 0; i < CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE; i++)
+    {
+        EXPECT_TRUE(FindWS(cache, kPasscode + i, kIterationCount, ByteSpan(kSalt), static_cast<uint8_t>(i)));
+    }
+
+    // Use the first entry, which makes the second one the least recently used.
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 0));
+
+    FillWS(ws, 0xff);
+    cache.Insert(kPasscode + CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE, kIterationCount, ByteSpan(kSalt), ws);
+    EXPECT_TRUE(FindWS(cache, kPasscode + CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE, kIterationCount, ByteSpan(kSalt), 0xff));
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 0));
+
+    if (CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE > 1)
+    {
+        EXPECT_FALSE(cache.Find(kPasscode + 1, kIterationCount, ByteSpan(kSalt), ws));
+        for (uint32_t i = 2; i < CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE; i++)
+        {
+            EXPECT_TRUE(FindWS(cache, kPasscode + i, kIterationCount, ByteSpan(kSalt), static_cast<uint8_t>(i)));
+        }
+    }
+}
+
+TEST(TestPASEVerifierCache, TestErasePasscode)
+{
+    PASEVerifierCache cache;
+    uint8_t ws[PASEVerifierCache::kWSLength];
+
+    FillWS(ws, 1);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(kSalt), ws);
+    FillWS(ws, 2);
+    cache.Insert(kPasscode, kIterationCount + 1, ByteSpan(kSalt), ws);
+    FillWS(ws, 3);
+    cache.Insert(kPasscode + 1, kIterationCount, ByteSpan(kSalt), ws);
+
+    // All the entries of the passcode go, whatever their PBKDF parameters.
+    cache.Erase(kPasscode);
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(kSalt), ws));
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount + 1, ByteSpan(kSalt), ws));
+    if (CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE > 2)
+    {
+        EXPECT_TRUE(FindWS(cache, kPasscode + 1, kIterationCount, ByteSpan(kSalt), 3));
+    }
+}
+
+TEST(TestPASEVerifierCache, TestEntriesExpire)
+{
+    System::Clock::Internal::MockClock mockClock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&mockClock);
+
+    constexpr System::Clock::Seconds32 kTimeout(CHIP_CONFIG_PASE_VERIFIER_CACHE_TIMEOUT_SECS);
+
+    PASEVerifierCache cache;
+    uint8_t ws[PASEVerifierCache::kWSLength];
+
+    FillWS(ws, 1);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(kSalt), ws);
+
+    // Using an entry does not extend its lifetime.
+    mockClock.AdvanceMonotonic(kTimeout - System::Clock::Seconds32(1));
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 1));
+    mockClock.AdvanceMonotonic(System::Clock::Seconds32(1));
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(kSalt), ws));
+
+    // Inserting the parameters again restarts it.
+    FillWS(ws, 2);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(kSalt), ws);
+    mockClock.AdvanceMonotonic(kTimeout - System::Clock::Seconds32(1));
+    EXPECT_TRUE(FindWS(cache, kPasscode, kIterationCount, ByteSpan(kSalt), 2));
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+
+TEST(TestPASEVerifierCache, TestRejectsOversizedSalt)
+{
+    PASEVerifierCache cache;
+    uint8_t ws[PASEVerifierCache::kWSLength];
+    uint8_t salt[Crypto::kSpake2p_Max_PBKDF_Salt_Length + 1] = {};
+
+    FillWS(ws, 1);
+    cache.Insert(kPasscode, kIterationCount, ByteSpan(salt), ws);
+    EXPECT_FALSE(cache.Find(kPasscode, kIterationCount, ByteSpan(salt), ws));
+}
+
+} // namespace
@@ -523,6 +523,17 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the CHIP System Layer can measure the callbacks run by its event loop and
+ *      report slow ones (see EventLoopProfiler).  Requires std::thread and std::mutex.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+#define CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING 0
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_TEST
  *
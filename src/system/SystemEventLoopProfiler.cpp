@@ -0,0 +1,281 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <system/SystemEventLoopProfiler.h>
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+namespace chip {
+namespace System {
+
+namespace {
+
+uint32_t ToHistogramValue(Clock::Microseconds64 value)
+{
+    return static_cast<uint32_t>(std::min<uint64_t>(value.count(), UINT32_MAX));
+}
+
+Clock::Microseconds64 Elapsed(Clock::Microseconds64 start, Clock::Microseconds64 end)
+{
+    return (end > start) ? (end - start) : Clock::kZero;
+}
+
+const char * CallbackTypeName(EventLoopProfiler::CallbackType type)
+{
+    switch (type)
+    {
+    case EventLoopProfiler::CallbackType::kTimer:
+        return "timer";
+    case EventLoopProfiler::CallbackType::kSocket:
+        return "socket";
+    case EventLoopProfiler::CallbackType::kLoopHandler:
+        return "loop handler";
+    }
+    return "unknown";
+}
+
+void LogCallback(const char * what, const EventLoopProfiler::CallbackInfo & info)
+{
+    ChipLogError(chipSystemLayer, "%s: %s callback %p (context %p, label %s) for %" PRIu64 " us, started %" PRIu64 " us late",
+                 what, CallbackTypeName(info.mType), reinterpret_cast<void *>(info.mFunction), info.mContext,
+                 StringOrNullMarker(info.mLabel), static_cast<uint64_t>(info.mDuration.count()),
+                 static_cast<uint64_t>(info.mLag.count()));
+}
+
+void LogHistogram(const char * what, const Tracing::Metrics::LatencyHistogram & histogram)
+{
+    VerifyOrReturn(histogram.Count() > 0);
+    ChipLogProgress(chipSystemLayer,
+                    "Event loop %s: %" PRIu64 " samples, p50 %" PRIu32 " us, p90 %" PRIu32 " us, p99 %" PRIu32 " us, max %" PRIu32
+                    " us",
+                    what, histogram.Count(), histogram.ValueAtPercentile(50), histogram.ValueAtPercentile(90),
+                    histogram.ValueAtPercentile(99), histogram.Max());
+}
+
+} // namespace
+
+EventLoopProfiler & EventLoopProfiler::Instance()
+{
+    static EventLoopProfiler sInstance;
+    return sInstance;
+}
+
+void EventLoopProfiler::Enable(const Config & config)
+{
+    // Stop the watchdog of the previous configuration, if any.
+    Disable();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mConfig       = config;
+        mWatchdogStop = false;
+    }
+    if (config.mStallThreshold > Clock::kZero)
+    {
+        mWatchdog = std::thread(&EventLoopProfiler::RunWatchdog, this);
+    }
+    mEnabled.store(true, std::memory_order_relaxed);
+}
+
+void EventLoopProfiler::Disable()
+{
+    mEnabled.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWatchdogStop = true;
+    }
+    mWatchdogWakeup.notify_all();
+    if (mWatchdog.joinable())
+    {
+        mWatchdog.join();
+    }
+}
+
+void EventLoopProfiler::SetDelegate(Delegate * delegate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDelegate = delegate;
+}
+
+void EventLoopProfiler::GetStats(Stats & stats) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    stats = mStats;
+}
+
+void EventLoopProfiler::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats             = Stats();
+    mSlowCallbackCount = 0;
+}
+
+size_t EventLoopProfiler::GetSlowCallbacks(CallbackInfo * infos, size_t maxCount) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const size_t count = std::min({ maxCount, mSlowCallbackCount, kSlowCallbackHistorySize });
+    for (size_t i = 0; i < count; i++)
+    {
+        infos[i] = mSlowCallbacks[(mSlowCallbackCount - 1 - i) % kSlowCallbackHistorySize];
+    }
+    return count;
+}
+
+void EventLoopProfiler::LogStats() const
+{
+    Stats stats;
+    GetStats(stats);
+
+    LogHistogram("timer durations", stats.mDurations[static_cast<size_t>(CallbackType::kTimer)]);
+    LogHistogram("socket durations", stats.mDurations[static_cast<size_t>(CallbackType::kSocket)]);
+    LogHistogram("loop handler durations", stats.mDurations[static_cast<size_t>(CallbackType::kLoopHandler)]);
+    LogHistogram("timer lag", stats.mTimerLag);
+    ChipLogProgress(chipSystemLayer, "Event loop: %" PRIu64 " slow callbacks, %" PRIu64 " stalls", stats.mSlowCallbacks,
+                    stats.mStalls);
+}
+
+void EventLoopProfiler::Annotate(const char * label)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    // Tracing scopes are opened on every thread: only keep the labels of the event loop thread.
+    VerifyOrReturn(mDepth > 0 && mLoopThread == std::this_thread::get_id());
+    if (++mScopeDepth >= mLabelDepth)
+    {
+        mCurrent.mLabel = label;
+        mLabelDepth     = mScopeDepth;
+    }
+}
+
+void EventLoopProfiler::EndAnnotation()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    // Scopes opened before the callback started were not counted.
+    if (mDepth > 0 && mScopeDepth > 0 && mLoopThread == std::this_thread::get_id())
+    {
+        mScopeDepth--;
+    }
+}
+
+void EventLoopProfiler::BeginCallback(CallbackType type, Function function, const void * context, Clock::Timestamp dueTime)
+{
+    const Clock::Microseconds64 now = SystemClock().GetMonotonicMicroseconds64();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    VerifyOrReturn(mDepth++ == 0);
+
+    mCurrent            = CallbackInfo();
+    mCurrent.mType      = type;
+    mCurrent.mFunction  = function;
+    mCurrent.mContext   = context;
+    mCurrent.mStartTime = now;
+    if (dueTime > Clock::kZero)
+    {
+        mCurrent.mLag = Elapsed(dueTime, now);
+    }
+    mScopeDepth = 0;
+    mLabelDepth = 0;
+    mLoopThread = std::this_thread::get_id();
+    mSequence++;
+}
+
+void EventLoopProfiler::EndCallback()
+{
+    const Clock::Microseconds64 now = SystemClock().GetMonotonicMicroseconds64();
+
+    CallbackInfo info;
+    Delegate * delegate = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        VerifyOrReturn(mDepth > 0 && --mDepth == 0);
+
+        info           = mCurrent;
+        info.mDuration = Elapsed(info.mStartTime, now);
+
+        mStats.mDurations[static_cast<size_t>(info.mType)].Record(ToHistogramValue(info.mDuration));
+        if (info.mType == CallbackType::kTimer)
+        {
+            mStats.mTimerLag.Record(ToHistogramValue(info.mLag));
+        }
+        VerifyOrReturn(info.mDuration >= mConfig.mSlowCallbackThreshold);
+
+        mStats.mSlowCallbacks++;
+        mSlowCallbacks[mSlowCallbackCount % kSlowCallbackHistorySize] = info;
+        mSlowCallbackCount++;
+        delegate = mDelegate;
+    }
+
+    if (delegate != nullptr)
+    {
+        delegate->OnSlowCallback(info);
+    }
+    else
+    {
+        LogCallback("Slow event loop callback", info);
+    }
+}
+
+void EventLoopProfiler::RunWatchdog()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // Check a few times per threshold, so that a stall is reported at most a quarter of the threshold late.
+    const auto period = std::chrono::milliseconds(std::max<uint32_t>(mConfig.mStallThreshold.count() / 4, 1));
+    while (!mWatchdogStop)
+    {
+        mWatchdogWakeup.wait_for(lock, period);
+        if (mWatchdogStop || mDepth == 0 || mStalledSequence == mSequence)
+        {
+            continue;
+        }
+
+        const Clock::Microseconds64 elapsed = Elapsed(mCurrent.mStartTime, SystemClock().GetMonotonicMicroseconds64());
+        if (elapsed < mConfig.mStallThreshold)
+        {
+            continue;
+        }
+
+        mStalledSequence = mSequence;
+        mStats.mStalls++;
+        CallbackInfo info   = mCurrent;
+        info.mDuration      = elapsed;
+        Delegate * delegate = mDelegate;
+
+        lock.unlock();
+        if (delegate != nullptr)
+        {
+            delegate->OnStall(info);
+        }
+        else
+        {
+            LogCallback("Event loop stalled", info);
+        }
+        lock.lock();
+    }
+}
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
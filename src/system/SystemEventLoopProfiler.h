@@ -0,0 +1,225 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measurement of the callbacks run by the event loop of the system layer.
+ */
+
+#pragma once
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
+#include <system/SystemClock.h>
+#include <tracing/metrics/latency_histogram.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace chip {
+namespace System {
+
+/**
+ * Measures every callback run by the event loop: timers (including work posted with ScheduleWork and platform
+ * events), socket callbacks and event loop handlers.
+ *
+ * For each callback the profiler records how long it ran and, for timers, the loop lag: how late the callback ran
+ * compared to when it was due.  Callbacks running longer than the slow callback threshold are reported with their
+ * function pointer, context and trace label, and the most recent ones are kept for inspection.  An optional watchdog
+ * thread reports a callback while it is still running past the stall threshold, so that stalls are attributed even
+ * when the callback never returns.
+ *
+ * Profiling is off until Enable() is called.  While off, a callback costs a single relaxed atomic load.
+ *
+ * THREAD SAFETY:
+ *    callbacks are reported on the event loop thread; all other methods may be called from any thread.
+ */
+class EventLoopProfiler
+{
+public:
+    enum class CallbackType : uint8_t
+    {
+        kTimer,       // Timers, ScheduleWork and posted platform events
+        kSocket,      // Socket watch callbacks
+        kLoopHandler, // EventLoopHandler::HandleEvents
+    };
+    static constexpr size_t kCallbackTypeCount = 3;
+
+    using Function = void (*)();
+
+    struct CallbackInfo
+    {
+        CallbackType mType               = CallbackType::kTimer;
+        Function mFunction               = nullptr;
+        const void * mContext            = nullptr;
+        const char * mLabel              = nullptr; // Innermost tracing scope opened while the callback ran, if any
+        Clock::Microseconds64 mStartTime = Clock::kZero;
+        Clock::Microseconds64 mDuration  = Clock::kZero; // For a stall, the time elapsed so far
+        Clock::Microseconds64 mLag       = Clock::kZero; // How late a timer ran
+    };
+
+    struct Config
+    {
+        Clock::Milliseconds32 mSlowCallbackThreshold = Clock::Milliseconds32(20);
+        // Report callbacks still running after this long from a watchdog thread.  Zero disables the watchdog.
+        Clock::Milliseconds32 mStallThreshold = Clock::kZero;
+    };
+
+    /// Histograms are in microseconds.
+    struct Stats
+    {
+        std::array<Tracing::Metrics::LatencyHistogram, kCallbackTypeCount> mDurations;
+        Tracing::Metrics::LatencyHistogram mTimerLag;
+        uint64_t mSlowCallbacks = 0;
+        uint64_t mStalls        = 0;
+    };
+
+    /**
+     * Receives slow callbacks and stalls instead of the log.
+     */
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /// Called on the event loop thread after a callback ran longer than the slow callback threshold.
+        virtual void OnSlowCallback(const CallbackInfo & info) = 0;
+
+        /// Called on the watchdog thread, once per callback, when it has been running longer than the stall threshold.
+        virtual void OnStall(const CallbackInfo & info) = 0;
+    };
+
+    static constexpr size_t kSlowCallbackHistorySize = 16;
+
+    /// The profiler used by the system layer.
+    static EventLoopProfiler & Instance();
+
+    ~EventLoopProfiler() { Disable(); }
+
+    /**
+     * Start profiling, or change the configuration.  Statistics are kept across calls.
+     */
+    void Enable(const Config & config);
+    void Disable();
+    bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+    /// nullptr restores logging.  The delegate must outlive profiling.
+    void SetDelegate(Delegate * delegate);
+
+    void GetStats(Stats & stats) const;
+    void ResetStats();
+
+    /**
+     * Copies up to `maxCount` of the most recent slow callbacks, newest first.  Returns how many were copied.
+     */
+    size_t GetSlowCallbacks(CallbackInfo * infos, size_t maxCount) const;
+
+    /// Logs the percentiles of the durations and of the loop lag.
+    void LogStats() const;
+
+    /**
+     * Called when a tracing scope opens, and EndAnnotation() when it closes.  The callback running on the event loop is
+     * labeled with its innermost scope: the most deeply nested one it opened, the latest of them if there are several.
+     * The label must stay valid for the lifetime of the profiler, like the labels of tracing scopes.
+     */
+    void Annotate(const char * label);
+    void EndAnnotation();
+
+    void BeginCallback(CallbackType type, Function function, const void * context, Clock::Timestamp dueTime);
+    void EndCallback();
+
+    /**
+     * Reports the callback run within its scope, if profiling is enabled.  Use CHIP_SYSTEM_PROFILE_CALLBACK.
+     */
+    class CallbackScope
+    {
+    public:
+        template <typename F>
+        CallbackScope(CallbackType type, F * function, const void * context, Clock::Timestamp dueTime = Clock::kZero) :
+            mActive(Instance().IsEnabled())
+        {
+            if (mActive)
+            {
+                Instance().BeginCallback(type, reinterpret_cast<Function>(function), context, dueTime);
+            }
+        }
+        CallbackScope(CallbackType type, std::nullptr_t, const void * context) :
+            CallbackScope(type, static_cast<Function>(nullptr), context)
+        {}
+        ~CallbackScope()
+        {
+            if (mActive)
+            {
+                Instance().EndCallback();
+            }
+        }
+
+    private:
+        bool mActive;
+    };
+
+private:
+    void RunWatchdog();
+
+    std::atomic<bool> mEnabled{ false };
+
+    mutable std::mutex mMutex; // protects everything below
+    Config mConfig;
+    Delegate * mDelegate = nullptr;
+    Stats mStats;
+
+    // The callback running on the event loop.  Nested callbacks (e.g. an event loop driven from a callback in tests)
+    // are accounted to the outermost one.
+    CallbackInfo mCurrent;
+    std::thread::id mLoopThread;
+    unsigned mDepth           = 0;
+    unsigned mScopeDepth      = 0; // Tracing scopes currently open within the callback
+    unsigned mLabelDepth      = 0; // Nesting depth of the scope mCurrent.mLabel comes from
+    uint64_t mSequence        = 0; // Incremented for every outermost callback
+    uint64_t mStalledSequence = 0; // Last callback reported by the watchdog
+
+    std::array<CallbackInfo, kSlowCallbackHistorySize> mSlowCallbacks;
+    size_t mSlowCallbackCount = 0; // Total ever recorded since the last reset
+
+    std::thread mWatchdog;
+    std::condition_variable mWatchdogWakeup;
+    bool mWatchdogStop = false;
+};
+
+} // namespace System
+} // namespace chip
+
+#define CHIP_SYSTEM_PROFILE_CALLBACK(type, function, context, ...)                                                                 \
+    ::chip::System::EventLoopProfiler::CallbackScope _chipEventLoopProfilerScope(                                                  \
+        ::chip::System::EventLoopProfiler::CallbackType::type, function, context, ##__VA_ARGS__)
+
+#else // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
+#define CHIP_SYSTEM_PROFILE_CALLBACK(type, function, context, ...)                                                                 \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (false)
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
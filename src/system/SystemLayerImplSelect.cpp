@@ -24,6 +24,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TimeUtils.h>
 #include <platform/LockTracker.h>
+#include <system/SystemEventLoopProfiler.h>
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplSelect.h>
@@ -306,7 +307,9 @@ CHIP_ERROR LayerImplSelect::ScheduleWork(TimerCompleteCallback onComplete, void
     dispatch_queue_t dispatchQueue = GetDispatchQueue();
     if (dispatchQueue)
     {
+        [[maybe_unused]] const Clock::Timestamp scheduledTime = SystemClock().GetMonotonicTimestamp();
         dispatch_async(dispatchQueue, ^{
+            CHIP_SYSTEM_PROFILE_CALLBACK(kTimer, onComplete, appState, scheduledTime);
             onComplete(this, appState);
         });
         return CHIP_NO_ERROR;
@@ -431,6 +434,7 @@ CHIP_ERROR LayerImplSelect::RequestCallbackOnPendingRead(SocketWatchToken token)
             dispatch_source_set_event_handler(watch->mRdSource, ^{
                 if (watch->mPendingIO.Has(SocketEventFlags::kRead) && watch->mCallback != nullptr)
                 {
+                    CHIP_SYSTEM_PROFILE_CALLBACK(kSocket, watch->mCallback, reinterpret_cast<const void *>(watch->mCallbackData));
                     SocketEvents events;
                     events.Set(SocketEventFlags::kRead);
                     watch->mCallback(events, watch->mCallbackData);
@@ -491,6 +495,7 @@ CHIP_ERROR LayerImplSelect::RequestCallbackOnPendingWrite(SocketWatchToken token
             dispatch_source_set_event_handler(watch->mWrSource, ^{
                 if (watch->mPendingIO.Has(SocketEventFlags::kWrite) && watch->mCallback != nullptr)
                 {
+                    CHIP_SYSTEM_PROFILE_CALLBACK(kSocket, watch->mCallback, reinterpret_cast<const void *>(watch->mCallbackData));
                     SocketEvents events;
                     events.Set(SocketEventFlags::kWrite);
                     watch->mCallback(events, watch->mCallbackData);
@@ -726,6 +731,8 @@ void LayerImplSelect::HandleEvents()
     TimerList::Node * timer = nullptr;
     while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
     {
+        CHIP_SYSTEM_PROFILE_CALLBACK(kTimer, timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState(),
+                                     timer->AwakenTime());
         mTimerPool.Invoke(timer);
     }
 
@@ -739,6 +746,7 @@ void LayerImplSelect::HandleEvents()
                 SocketEvents events = SocketEventsFromFDs(w.mFD, mSelected.mReadSet, mSelected.mWriteSet, mSelected.mErrorSet);
                 if (events.HasAny())
                 {
+                    CHIP_SYSTEM_PROFILE_CALLBACK(kSocket, w.mCallback, reinterpret_cast<const void *>(w.mCallbackData));
                     w.mCallback(events, w.mCallbackData);
                 }
             }
@@ -753,6 +761,7 @@ void LayerImplSelect::HandleEvents()
         auto & loop = *loopIter++; // advance before calling out, in case a list modification clobbers the `next` pointer
         if (LoopHandlerState(loop) == kLoopHandlerActive)
         {
+            CHIP_SYSTEM_PROFILE_CALLBACK(kLoopHandler, nullptr, &loop);
             loop.HandleEvents();
         }
     }
@@ -767,6 +776,8 @@ void LayerImplSelect::HandleEvents()
 
 void LayerImplSelect::HandleTimerComplete(TimerList::Node * timer)
 {
+    CHIP_SYSTEM_PROFILE_CALLBACK(kTimer, timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState(),
+                                 timer->AwakenTime());
     mTimerList.Remove(timer);
     mTimerPool.Invoke(timer);
 }
@@ -779,6 +790,8 @@ void LayerImplSelect::HandleLibEvTimer(EV_P_ struct ev_timer * t, int revents)
     VerifyOrDie(timer != nullptr);
     LayerImplSelect * layerP = dynamic_cast<LayerImplSelect *>(timer->mCallback.mSystemLayer);
     VerifyOrDie(layerP != nullptr);
+    CHIP_SYSTEM_PROFILE_CALLBACK(kTimer, timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState(),
+                                 timer->AwakenTime());
     layerP->mTimerList.Remove(timer);
     layerP->mTimerPool.Invoke(timer);
 }
@@ -799,6 +812,7 @@ void LayerImplSelect::HandleLibEvIoWatcher(EV_P_ struct ev_io * i, int revents)
         }
         if (events.HasAny())
         {
+            CHIP_SYSTEM_PROFILE_CALLBACK(kSocket, watch->mCallback, reinterpret_cast<const void *>(watch->mCallbackData));
             watch->mCallback(events, watch->mCallbackData);
         }
     }
@@ -0,0 +1,224 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+#include <system/SystemConfig.h>
+
+// The profiler instruments the select-based event loop, which the test drives directly.
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING && CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemEventLoopProfiler.h>
+#include <system/SystemLayerImpl.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+using namespace chip::System;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+class RecordingDelegate : public EventLoopProfiler::Delegate
+{
+public:
+    void OnSlowCallback(const EventLoopProfiler::CallbackInfo & info) override { mSlowCallbacks.push_back(info); }
+
+    void OnStall(const EventLoopProfiler::CallbackInfo & info) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStall = info;
+        mStalled.store(true);
+    }
+
+    std::vector<EventLoopProfiler::CallbackInfo> mSlowCallbacks;
+
+    std::mutex mMutex;
+    EventLoopProfiler::CallbackInfo mStall;
+    std::atomic<bool> mStalled{ false };
+};
+
+Clock::Internal::MockClock gMockClock;
+RecordingDelegate gDelegate;
+
+void FastCallback(Layer * layer, void * context) {}
+
+void SlowCallback(Layer * layer, void * context)
+{
+    // The callback is labeled with its innermost tracing scope.
+    EventLoopProfiler::Instance().Annotate("Outer");
+    EventLoopProfiler::Instance().Annotate("SlowCallback");
+    gMockClock.AdvanceMonotonic(50_ms64);
+    EventLoopProfiler::Instance().EndAnnotation();
+    EventLoopProfiler::Instance().EndAnnotation();
+    // A less nested scope opened afterwards does not replace it.
+    EventLoopProfiler::Instance().Annotate("Ignored");
+    EventLoopProfiler::Instance().EndAnnotation();
+}
+
+void StallingCallback(Layer * layer, void * context)
+{
+    gMockClock.AdvanceMonotonic(100_ms64);
+
+    // Wait for the watchdog, in real time.
+    for (int i = 0; i < 5000 && !gDelegate.mStalled.load(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+class TestEventLoopProfiler : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(sLayer.Init(), CHIP_NO_ERROR);
+        // Timers due at time zero are not accounted as late.
+        gMockClock.SetMonotonic(10_s64);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sLayer.Shutdown();
+        Platform::MemoryShutdown();
+    }
+
+    void SetUp() override
+    {
+        mRealClock = &SystemClock();
+        Clock::Internal::SetSystemClockForTesting(&gMockClock);
+
+        gDelegate.mSlowCallbacks.clear();
+        gDelegate.mStalled.store(false);
+        EventLoopProfiler::Instance().ResetStats();
+        EventLoopProfiler::Instance().SetDelegate(&gDelegate);
+    }
+
+    void TearDown() override
+    {
+        EventLoopProfiler::Instance().Disable();
+        EventLoopProfiler::Instance().SetDelegate(nullptr);
+        Clock::Internal::SetSystemClockForTesting(mRealClock);
+    }
+
+    static void ServiceEvents()
+    {
+        sLayer.PrepareEvents();
+        sLayer.WaitForEvents();
+        sLayer.HandleEvents();
+    }
+
+    static LayerImpl sLayer;
+
+private:
+    Clock::ClockBase * mRealClock = nullptr;
+};
+
+LayerImpl TestEventLoopProfiler::sLayer;
+
+TEST_F(TestEventLoopProfiler, TestMeasuresCallbacks)
+{
+    EventLoopProfiler::Instance().Enable(EventLoopProfiler::Config());
+
+    int context = 0;
+    EXPECT_EQ(sLayer.ScheduleWork(FastCallback, nullptr), CHIP_NO_ERROR);
+    EXPECT_EQ(sLayer.ScheduleWork(SlowCallback, &context), CHIP_NO_ERROR);
+    ServiceEvents();
+
+    EventLoopProfiler::Stats stats;
+    EventLoopProfiler::Instance().GetStats(stats);
+    const auto & timerDurations = stats.mDurations[static_cast<size_t>(EventLoopProfiler::CallbackType::kTimer)];
+    EXPECT_EQ(timerDurations.Count(), 2u);
+    EXPECT_EQ(timerDurations.Max(), 50000u);
+    EXPECT_EQ(stats.mSlowCallbacks, 1u);
+    EXPECT_EQ(stats.mStalls, 0u);
+
+    ASSERT_EQ(gDelegate.mSlowCallbacks.size(), 1u);
+    const EventLoopProfiler::CallbackInfo & info = gDelegate.mSlowCallbacks[0];
+    EXPECT_EQ(info.mType, EventLoopProfiler::CallbackType::kTimer);
+    EXPECT_EQ(info.mFunction, reinterpret_cast<EventLoopProfiler::Function>(SlowCallback));
+    EXPECT_EQ(info.mContext, &context);
+    EXPECT_STREQ(info.mLabel, "SlowCallback");
+    EXPECT_EQ(info.mDuration, 50_ms);
+
+    EventLoopProfiler::CallbackInfo history[EventLoopProfiler::kSlowCallbackHistorySize];
+    ASSERT_EQ(EventLoopProfiler::Instance().GetSlowCallbacks(history, ArraySize(history)), 1u);
+    EXPECT_EQ(history[0].mFunction, info.mFunction);
+}
+
+TEST_F(TestEventLoopProfiler, TestMeasuresTimerLag)
+{
+    EventLoopProfiler::Instance().Enable(EventLoopProfiler::Config());
+
+    EXPECT_EQ(sLayer.StartTimer(10_ms32, FastCallback, nullptr), CHIP_NO_ERROR);
+    gMockClock.AdvanceMonotonic(40_ms64);
+    ServiceEvents();
+
+    EventLoopProfiler::Stats stats;
+    EventLoopProfiler::Instance().GetStats(stats);
+    EXPECT_EQ(stats.mTimerLag.Count(), 1u);
+    EXPECT_EQ(stats.mTimerLag.Max(), 30000u);
+    EXPECT_EQ(stats.mSlowCallbacks, 0u);
+    EXPECT_TRUE(gDelegate.mSlowCallbacks.empty());
+}
+
+TEST_F(TestEventLoopProfiler, TestWatchdogReportsStalls)
+{
+    EventLoopProfiler::Config config;
+    config.mStallThreshold = 50_ms32;
+    EventLoopProfiler::Instance().Enable(config);
+
+    EXPECT_EQ(sLayer.ScheduleWork(StallingCallback, nullptr), CHIP_NO_ERROR);
+    ServiceEvents();
+
+    ASSERT_TRUE(gDelegate.mStalled.load());
+    {
+        std::lock_guard<std::mutex> lock(gDelegate.mMutex);
+        EXPECT_EQ(gDelegate.mStall.mFunction, reinterpret_cast<EventLoopProfiler::Function>(StallingCallback));
+        EXPECT_GE(gDelegate.mStall.mDuration, 50_ms);
+    }
+
+    EventLoopProfiler::Stats stats;
+    EventLoopProfiler::Instance().GetStats(stats);
+    EXPECT_EQ(stats.mStalls, 1u);
+    EXPECT_EQ(stats.mSlowCallbacks, 1u);
+}
+
+TEST_F(TestEventLoopProfiler, TestDisabled)
+{
+    EXPECT_FALSE(EventLoopProfiler::Instance().IsEnabled());
+
+    EXPECT_EQ(sLayer.ScheduleWork(SlowCallback, nullptr), CHIP_NO_ERROR);
+    ServiceEvents();
+
+    EventLoopProfiler::Stats stats;
+    EventLoopProfiler::Instance().GetStats(stats);
+    EXPECT_EQ(stats.mDurations[static_cast<size_t>(EventLoopProfiler::CallbackType::kTimer)].Count(), 0u);
+    EXPECT_TRUE(gDelegate.mSlowCallbacks.empty());
+}
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING && CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
@@ -0,0 +1,600 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the 'chip-crypto-benchmark' command line tool, which
+ *      measures the operations of the crypto PAL the SDK was built with and writes
+ *      the results as JSON.
+ *
+ *      The same operations, with the same parameters, are run whatever the crypto
+ *      backend is, so the output of builds with different `chip_crypto` values can
+ *      be compared record by record.
+ */
+
+#include <CHIPVersion.h>
+#include <credentials/CHIPCert.h>
+#include <credentials/CHIPCertificateSet.h>
+#include <credentials/tests/CHIPCert_test_vectors.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#if CHIP_CRYPTO_PSA_SPAKE2P
+#include <crypto/PSASpake2p.h>
+#endif
+#include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#if CHIP_CRYPTO_PSA
+#include <psa/crypto.h>
+#endif
+
+#include <chrono>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define COPYRIGHT_STRING "Copyright (c) 2024 Project CHIP Authors.\nAll rights reserved.\n"
+#define CMD_NAME "chip-crypto-benchmark"
+
+namespace chip {
+namespace Logging {
+namespace Platform {
+
+void LogV(const char * module, uint8_t category, const char * msg, va_list v) {}
+
+} // namespace Platform
+} // namespace Logging
+} // namespace chip
+
+namespace {
+
+using namespace chip;
+using namespace chip::ArgParser;
+using namespace chip::Credentials;
+using namespace chip::Crypto;
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg);
+
+// clang-format off
+OptionDef gCmdOptionDefs[] =
+{
+    { "min-time", kArgumentRequired, 't' },
+    { "filter",   kArgumentRequired, 'f' },
+    { "out",      kArgumentRequired, 'o' },
+    { }
+};
+
+const char * const gCmdOptionHelp =
+    "   -t, --min-time <ms>\n"
+    "\n"
+    "       Minimum time spent running each operation, in milliseconds. Operations\n"
+    "       are repeated until this time has elapsed. Defaults to 250.\n"
+    "\n"
+    "   -f, --filter <string>\n"
+    "\n"
+    "       Only run the operations whose name contains the given string, e.g.\n"
+    "       'aes_ccm' or 'spake2p'.\n"
+    "\n"
+    "   -o, --out <file>\n"
+    "\n"
+    "       File to write the JSON results to. Defaults to stdout.\n"
+    "\n"
+    ;
+
+OptionSet gCmdOptions =
+{
+    HandleOption,
+    gCmdOptionDefs,
+    "COMMAND OPTIONS",
+    gCmdOptionHelp
+};
+
+HelpOptions gHelpOptions(
+    CMD_NAME,
+    "Usage: " CMD_NAME " [ <options...> ]\n",
+    CHIP_VERSION_STRING "\n" COPYRIGHT_STRING,
+    "Measure the operations of the crypto PAL and write the results as JSON.\n"
+    "\n"
+    "Every record has the same operation name and parameters whatever the crypto\n"
+    "backend is, so that the output of builds with different backends can be compared.\n"
+);
+
+OptionSet * gCmdOptionSets[] =
+{
+    &gCmdOptions,
+    &gHelpOptions,
+    nullptr
+};
+// clang-format on
+
+uint32_t gMinTimeMs       = 250;
+const char * gFilter      = nullptr;
+const char * gOutFileName = nullptr;
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg)
+{
+    switch (id)
+    {
+    case 't':
+        if (!ParseInt(arg, gMinTimeMs) || gMinTimeMs == 0)
+        {
+            PrintArgError("%s: Invalid value specified for min-time parameter: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'f':
+        gFilter = arg;
+        break;
+    case 'o':
+        gOutFileName = arg;
+        break;
+    default:
+        PrintArgError("%s: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+const char * BackendName()
+{
+#if CHIP_CRYPTO_OPENSSL
+    return "openssl";
+#elif CHIP_CRYPTO_BORINGSSL
+    return "boringssl";
+#elif CHIP_CRYPTO_MBEDTLS
+    return "mbedtls";
+#elif CHIP_CRYPTO_PSA
+    return "psa";
+#elif CHIP_CRYPTO_PLATFORM
+    return "platform";
+#else
+    return "unknown";
+#endif
+}
+
+// Payload sizes for the AES-CCM operations, from small control messages up to the
+// largest payload fitting in an IPv6 minimum MTU.
+constexpr size_t kAesCcmPayloadSizes[] = { 16, 32, 64, 128, 256, 512, 1024, 1280 };
+
+// Input sizes for the hash and HMAC operations.
+constexpr size_t kHashInputSizes[] = { 64, 256, 1024 };
+
+// PBKDF2 iteration counts allowed for the commissioning SPAKE2+ parameters, and a
+// value in between.
+constexpr uint32_t kPbkdf2IterationCounts[] = { kSpake2p_Min_PBKDF_Iterations, 10000, kSpake2p_Max_PBKDF_Iterations };
+
+// Size of the additional authenticated data of a typical secured message header.
+constexpr size_t kAadLength = 24;
+
+constexpr size_t kMaxPayloadSize = 1280;
+
+constexpr uint32_t kSetupPinCode = 20202021;
+
+const uint8_t kSpake2pContext[] = "CHIP PAKE V1 Commissioning";
+
+/**
+ * An operation and the parameter it is measured with (payload size or PBKDF2
+ * iteration count), as written in a result record.
+ */
+struct Benchmark
+{
+    const char * operation;
+    const char * parameterName = nullptr;
+    uint64_t parameterValue    = 0;
+    size_t bytesPerRun         = 0;
+};
+
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(FILE * out) : mOut(out) {}
+
+    bool IsEnabled(const char * operation) const { return gFilter == nullptr || strstr(operation, gFilter) != nullptr; }
+
+    /**
+     * Repeats `operation`, a callable returning a CHIP_ERROR, until the minimum time has
+     * elapsed and writes the result record. Stops at the first error.
+     */
+    template <typename Operation>
+    CHIP_ERROR Run(const Benchmark & benchmark, Operation && operation)
+    {
+        VerifyOrReturnError(IsEnabled(benchmark.operation), CHIP_NO_ERROR);
+
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end   = start + std::chrono::milliseconds(gMinTimeMs);
+        Clock::time_point now         = start;
+        uint64_t runs                 = 0;
+
+        do
+        {
+            CHIP_ERROR err = operation();
+            if (err != CHIP_NO_ERROR)
+            {
+                fprintf(stderr, "%s failed: %" CHIP_ERROR_FORMAT "\n", benchmark.operation, err.Format());
+                return err;
+            }
+            runs++;
+            now = Clock::now();
+        } while (now < end);
+
+        Emit(benchmark, runs, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()));
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Writes a result record for operations timed by the caller.
+     */
+    void Emit(const Benchmark & benchmark, uint64_t runs, uint64_t elapsedNs)
+    {
+        const double nsPerOp   = static_cast<double>(elapsedNs) / static_cast<double>(runs);
+        const double opsPerSec = 1e9 / nsPerOp;
+
+        fprintf(mOut, "%s\n    { \"operation\": \"%s\"", mRecordCount == 0 ? "" : ",", benchmark.operation);
+        if (benchmark.parameterName != nullptr)
+        {
+            fprintf(mOut, ", \"%s\": %" PRIu64, benchmark.parameterName, benchmark.parameterValue);
+        }
+        fprintf(mOut, ", \"runs\": %" PRIu64 ", \"ns_per_op\": %.0f, \"ops_per_sec\": %.1f", runs, nsPerOp, opsPerSec);
+        if (benchmark.bytesPerRun != 0)
+        {
+            fprintf(mOut, ", \"mb_per_sec\": %.2f", opsPerSec * static_cast<double>(benchmark.bytesPerRun) / 1e6);
+        }
+        fprintf(mOut, " }");
+        fflush(mOut);
+        mRecordCount++;
+    }
+
+    void Begin()
+    {
+        fprintf(mOut, "{\n  \"backend\": \"%s\",\n  \"psa_spake2p\": %s,\n  \"min_time_ms\": %" PRIu32 ",\n  \"results\": [",
+                BackendName(), CHIP_CRYPTO_PSA_SPAKE2P ? "true" : "false", gMinTimeMs);
+    }
+
+    void End() { fprintf(mOut, "\n  ]\n}\n"); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FILE * mOut;
+    size_t mRecordCount = 0;
+};
+
+CHIP_ERROR BenchmarkAesCcm(BenchmarkRunner & runner)
+{
+    DefaultSessionKeystore keystore;
+    Symmetric128BitsKeyByteArray keyMaterial;
+    uint8_t nonce[kAES_CCM128_Nonce_Length];
+    uint8_t aad[kAadLength];
+    uint8_t plaintext[kMaxPayloadSize];
+    uint8_t ciphertext[kMaxPayloadSize];
+    uint8_t tag[kAES_CCM128_Tag_Length];
+
+    ReturnErrorOnFailure(DRBG_get_bytes(keyMaterial, sizeof(keyMaterial)));
+    ReturnErrorOnFailure(DRBG_get_bytes(nonce, sizeof(nonce)));
+    ReturnErrorOnFailure(DRBG_get_bytes(aad, sizeof(aad)));
+    ReturnErrorOnFailure(DRBG_get_bytes(plaintext, sizeof(plaintext)));
+
+    Aes128KeyHandle key;
+    ReturnErrorOnFailure(keystore.CreateKey(keyMaterial, key));
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (size_t size : kAesCcmPayloadSizes)
+    {
+        err = runner.Run({ "aes_ccm_encrypt", "bytes", size, size }, [&]() {
+            return AES_CCM_encrypt(plaintext, size, aad, sizeof(aad), key, nonce, sizeof(nonce), ciphertext, tag, sizeof(tag));
+        });
+        SuccessOrExit(err);
+
+        // Decrypt what was encrypted last, so that the tag is valid.
+        err = AES_CCM_encrypt(plaintext, size, aad, sizeof(aad), key, nonce, sizeof(nonce), ciphertext, tag, sizeof(tag));
+        SuccessOrExit(err);
+
+        err = runner.Run({ "aes_ccm_decrypt", "bytes", size, size }, [&]() {
+            return AES_CCM_decrypt(ciphertext, size, aad, sizeof(aad), tag, sizeof(tag), key, nonce, sizeof(nonce), plaintext);
+        });
+        SuccessOrExit(err);
+    }
+
+exit:
+    keystore.DestroyKey(key);
+    return err;
+}
+
+CHIP_ERROR BenchmarkHashes(BenchmarkRunner & runner)
+{
+    uint8_t input[kMaxPayloadSize];
+    uint8_t key[kSHA256_Hash_Length];
+    uint8_t digest[kSHA256_Hash_Length];
+
+    ReturnErrorOnFailure(DRBG_get_bytes(input, sizeof(input)));
+    ReturnErrorOnFailure(DRBG_get_bytes(key, sizeof(key)));
+
+    for (size_t size : kHashInputSizes)
+    {
+        ReturnErrorOnFailure(runner.Run({ "sha256", "bytes", size, size }, [&]() { return Hash_SHA256(input, size, digest); }));
+    }
+
+    for (size_t size : kHashInputSizes)
+    {
+        ReturnErrorOnFailure(runner.Run({ "hmac_sha256", "bytes", size, size }, [&]() {
+            HMAC_sha hmac;
+            return hmac.HMAC_SHA256(key, sizeof(key), input, size, digest, sizeof(digest));
+        }));
+    }
+
+    // Same inputs as the derivation of the session keys at the end of CASE and PASE.
+    uint8_t secret[kP256_FE_Length];
+    uint8_t salt[kSHA256_Hash_Length];
+    uint8_t sessionKeys[3 * kAES_CCM128_Key_Length];
+    const uint8_t info[] = "SessionKeys";
+
+    ReturnErrorOnFailure(DRBG_get_bytes(secret, sizeof(secret)));
+    ReturnErrorOnFailure(DRBG_get_bytes(salt, sizeof(salt)));
+
+    return runner.Run({ "hkdf_sha256" }, [&]() {
+        HKDF_sha hkdf;
+        return hkdf.HKDF_SHA256(secret, sizeof(secret), salt, sizeof(salt), info, sizeof(info) - 1, sessionKeys,
+                                sizeof(sessionKeys));
+    });
+}
+
+CHIP_ERROR BenchmarkPbkdf2(BenchmarkRunner & runner)
+{
+    uint8_t salt[kSpake2p_Max_PBKDF_Salt_Length];
+    ReturnErrorOnFailure(DRBG_get_bytes(salt, sizeof(salt)));
+
+    // Derives w0s || w1s from the setup PIN code, as done by a commissioner for every
+    // commissioning and by a device computing its verifier.
+    for (uint32_t iterationCount : kPbkdf2IterationCounts)
+    {
+        ReturnErrorOnFailure(runner.Run({ "pbkdf2_sha256", "pbkdf2_iterations", iterationCount }, [&]() {
+            uint8_t ws[2 * kSpake2p_WS_Length];
+            return Spake2pVerifier::ComputeWS(iterationCount, ByteSpan(salt), kSetupPinCode, ws, sizeof(ws));
+        }));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BenchmarkP256(BenchmarkRunner & runner)
+{
+    const uint8_t message[] = "A message about the size of the TBS data of a CASE Sigma message";
+
+    P256Keypair keypair;
+    ReturnErrorOnFailure(keypair.Initialize(ECPKeyTarget::ECDSA));
+
+    P256ECDSASignature signature;
+    ReturnErrorOnFailure(runner.Run({ "ecdsa_sign" }, [&]() { return keypair.ECDSA_sign_msg(message, sizeof(message), signature); }));
+    ReturnErrorOnFailure(keypair.ECDSA_sign_msg(message, sizeof(message), signature));
+
+    // A fresh copy of the key is used for every verification, as when verifying a signature with
+    // the public key of a certificate.
+    ReturnErrorOnFailure(runner.Run({ "ecdsa_verify" }, [&]() {
+        P256PublicKey publicKey(keypair.Pubkey());
+        return publicKey.ECDSA_validate_msg_signature(message, sizeof(message), signature);
+    }));
+
+    P256PreparedPublicKey preparedPublicKey(keypair.Pubkey());
+    ReturnErrorOnFailure(runner.Run({ "ecdsa_verify_prepared" }, [&]() {
+        return preparedPublicKey.ECDSA_validate_msg_signature(message, sizeof(message), signature);
+    }));
+
+    P256Keypair peerKeypair;
+    ReturnErrorOnFailure(peerKeypair.Initialize(ECPKeyTarget::ECDH));
+
+    P256ECDHDerivedSecret secret;
+    ReturnErrorOnFailure(runner.Run({ "ecdh_derive_secret" }, [&]() { return keypair.ECDH_derive_secret(peerKeypair.Pubkey(), secret); }));
+
+    return runner.Run({ "p256_generate_keypair" }, []() {
+        P256Keypair ephemeralKeypair;
+        return ephemeralKeypair.Initialize(ECPKeyTarget::ECDH);
+    });
+}
+
+#if CHIP_CRYPTO_PSA_SPAKE2P
+using Spake2p = PSASpake2p_P256_SHA256_HKDF_HMAC;
+#else
+using Spake2p = Spake2p_P256_SHA256_HKDF_HMAC;
+#endif
+
+/**
+ * Runs complete SPAKE2+ exchanges between a prover (commissioner) and a verifier
+ * (commissionee) and times the work each of them does for every PASE message.
+ */
+CHIP_ERROR BenchmarkSpake2p(BenchmarkRunner & runner)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Benchmark proverRoundOne{ "spake2p_prover_round_one" };
+    const Benchmark verifierRounds{ "spake2p_verifier_round_one_two" };
+    const Benchmark proverRoundTwo{ "spake2p_prover_round_two_confirm" };
+    const Benchmark verifierConfirm{ "spake2p_verifier_confirm" };
+
+    VerifyOrReturnError(runner.IsEnabled(proverRoundOne.operation) || runner.IsEnabled(verifierRounds.operation) ||
+                            runner.IsEnabled(proverRoundTwo.operation) || runner.IsEnabled(verifierConfirm.operation),
+                        CHIP_NO_ERROR);
+
+    uint8_t salt[kSpake2p_Min_PBKDF_Salt_Length];
+    ReturnErrorOnFailure(DRBG_get_bytes(salt, sizeof(salt)));
+
+    // The PBKDF2 part of commissioning is measured by the pbkdf2_sha256 operations, so the
+    // lowest iteration count is used here.
+    Spake2pVerifier verifierParams;
+    ReturnErrorOnFailure(verifierParams.Generate(kSpake2p_Min_PBKDF_Iterations, ByteSpan(salt), kSetupPinCode));
+
+    uint8_t ws[2 * kSpake2p_WS_Length];
+    ReturnErrorOnFailure(Spake2pVerifier::ComputeWS(kSpake2p_Min_PBKDF_Iterations, ByteSpan(salt), kSetupPinCode, ws, sizeof(ws)));
+
+    uint64_t elapsedNs[4] = {};
+    uint64_t runs         = 0;
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end   = start + std::chrono::milliseconds(gMinTimeMs);
+    Clock::time_point now         = start;
+
+    auto lap = [&](uint64_t & elapsed) {
+        const Clock::time_point previous = now;
+        now                              = Clock::now();
+        elapsed += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous).count());
+    };
+
+    do
+    {
+        Spake2p prover;
+        Spake2p verifier;
+        uint8_t X[kMAX_Point_Length];
+        size_t X_len = sizeof(X);
+        uint8_t Y[kMAX_Point_Length];
+        size_t Y_len = sizeof(Y);
+        uint8_t proverConfirm[kMAX_Hash_Length];
+        size_t proverConfirm_len = sizeof(proverConfirm);
+        uint8_t verifierConfirmation[kMAX_Hash_Length];
+        size_t verifierConfirmation_len = sizeof(verifierConfirmation);
+
+        now = Clock::now();
+
+        // Pake1
+        ReturnErrorOnFailure(prover.Init(kSpake2pContext, sizeof(kSpake2pContext) - 1));
+        ReturnErrorOnFailure(prover.BeginProver(nullptr, 0, nullptr, 0, &ws[0], kSpake2p_WS_Length, &ws[kSpake2p_WS_Length],
+                                                kSpake2p_WS_Length));
+        ReturnErrorOnFailure(prover.ComputeRoundOne(nullptr, 0, X, &X_len));
+        lap(elapsedNs[0]);
+
+        // Pake2
+        ReturnErrorOnFailure(verifier.Init(kSpake2pContext, sizeof(kSpake2pContext) - 1));
+        ReturnErrorOnFailure(verifier.BeginVerifier(nullptr, 0, nullptr, 0, verifierParams.mW0, kP256_FE_Length, verifierParams.mL,
+                                                    kP256_Point_Length));
+        ReturnErrorOnFailure(verifier.ComputeRoundOne(X, X_len, Y, &Y_len));
+        ReturnErrorOnFailure(verifier.ComputeRoundTwo(X, X_len, verifierConfirmation, &verifierConfirmation_len));
+        lap(elapsedNs[1]);
+
+        // Pake3
+        ReturnErrorOnFailure(prover.ComputeRoundTwo(Y, Y_len, proverConfirm, &proverConfirm_len));
+        ReturnErrorOnFailure(prover.KeyConfirm(verifierConfirmation, verifierConfirmation_len));
+        lap(elapsedNs[2]);
+
+        ReturnErrorOnFailure(verifier.KeyConfirm(proverConfirm, proverConfirm_len));
+        lap(elapsedNs[3]);
+
+        runs++;
+    } while (now < end);
+
+    const Benchmark * benchmarks[] = { &proverRoundOne, &verifierRounds, &proverRoundTwo, &verifierConfirm };
+    for (size_t i = 0; i < ArraySize(benchmarks); i++)
+    {
+        if (runner.IsEnabled(benchmarks[i]->operation))
+        {
+            runner.Emit(*benchmarks[i], runs, elapsedNs[i]);
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BenchmarkCertificates(BenchmarkRunner & runner)
+{
+    using namespace chip::TestCerts;
+
+    // Operational certificate chain (RCAC, ICAC, NOC) as received during CASE.
+    ChipCertificateData certData;
+    ReturnErrorOnFailure(runner.Run({ "cert_decode" }, [&]() {
+        certData.Clear();
+        return DecodeChipCert(sTestCert_Node01_01_Chip, certData, CertDecodeFlags::kGenerateTBSHash);
+    }));
+
+    ReturnErrorOnFailure(runner.Run({ "cert_convert_to_x509" }, [&]() {
+        uint8_t derBuf[kMaxDERCertLength];
+        MutableByteSpan der(derBuf);
+        return ConvertChipCertToX509Cert(sTestCert_Node01_01_Chip, der);
+    }));
+
+    ChipCertificateSet certSet;
+    ReturnErrorOnFailure(certSet.Init(3));
+    ReturnErrorOnFailure(certSet.LoadCert(sTestCert_Root01_Chip, CertDecodeFlags::kIsTrustAnchor));
+    ReturnErrorOnFailure(certSet.LoadCert(sTestCert_ICA01_Chip, CertDecodeFlags::kGenerateTBSHash));
+    ReturnErrorOnFailure(certSet.LoadCert(sTestCert_Node01_01_Chip, CertDecodeFlags::kGenerateTBSHash));
+
+    // Checks the validity periods, extensions and both signatures of the chain.
+    const ChipCertificateData * noc = certSet.GetLastCert();
+    return runner.Run({ "cert_validate_chain" }, [&]() {
+        ValidationContext context;
+        context.Reset();
+        context.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+        context.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+        context.SetEffectiveTime<CurrentChipEpochTime>(System::Clock::Seconds32(noc->mNotBeforeTime));
+
+        const ChipCertificateData * validCert = nullptr;
+        ReturnErrorOnFailure(certSet.FindValidCert(noc->mSubjectDN, noc->mSubjectKeyId, context, &validCert));
+        VerifyOrReturnError(validCert == noc, CHIP_ERROR_CERT_NOT_TRUSTED);
+        return CHIP_NO_ERROR;
+    });
+}
+
+CHIP_ERROR RunBenchmarks(BenchmarkRunner & runner)
+{
+    ReturnErrorOnFailure(BenchmarkAesCcm(runner));
+    ReturnErrorOnFailure(BenchmarkHashes(runner));
+    ReturnErrorOnFailure(BenchmarkPbkdf2(runner));
+    ReturnErrorOnFailure(BenchmarkP256(runner));
+    ReturnErrorOnFailure(BenchmarkSpake2p(runner));
+    return BenchmarkCertificates(runner);
+}
+
+} // namespace
+
+extern "C" int main(int argc, char * argv[])
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    FILE * out     = stdout;
+
+    chip::Platform::MemoryInit();
+#if CHIP_CRYPTO_PSA
+    psa_crypto_init();
+#endif
+
+    VerifyOrExit(ParseArgs(CMD_NAME, argc, argv, gCmdOptionSets), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (gOutFileName != nullptr && strcmp(gOutFileName, "-") != 0)
+    {
+        out = fopen(gOutFileName, "w");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "Unable to create file %s: %s\n", gOutFileName, strerror(errno));
+            ExitNow(err = CHIP_ERROR_OPEN_FAILED);
+        }
+    }
+
+    {
+        BenchmarkRunner runner(out);
+        runner.Begin();
+        err = RunBenchmarks(runner);
+        runner.End();
+    }
+
+exit:
+    if (out != stdout && out != nullptr)
+    {
+        fclose(out);
+    }
+    chip::Platform::MemoryShutdown();
+
+    return (err == CHIP_NO_ERROR) ? 0 : -1;
+}
@@ -0,0 +1,272 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the 'chip-interest-index-benchmark' command line tool,
+ *      which measures how long the reporting engine takes to find the read handlers
+ *      interested in a dirty attribute, with the attribute interest index and with a
+ *      scan of every path of every handler, and writes the results as JSON.
+ */
+
+#include <CHIPVersion.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <errno.h>
+#include <inttypes.h>
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+
+#define COPYRIGHT_STRING "Copyright (c) 2024 Project CHIP Authors.\nAll rights reserved.\n"
+#define CMD_NAME "chip-interest-index-benchmark"
+
+namespace chip {
+namespace Logging {
+namespace Platform {
+
+void LogV(const char * module, uint8_t category, const char * msg, va_list v) {}
+
+} // namespace Platform
+} // namespace Logging
+} // namespace chip
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+using namespace chip::ArgParser;
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg);
+
+// clang-format off
+OptionDef gCmdOptionDefs[] =
+{
+    { "lookups", kArgumentRequired, 'n' },
+    { "out",     kArgumentRequired, 'o' },
+    { }
+};
+
+const char * const gCmdOptionHelp =
+    "   -n, --lookups <count>\n"
+    "\n"
+    "       Number of dirty attributes looked up for each number of handlers.\n"
+    "       Defaults to 20000.\n"
+    "\n"
+    "   -o, --out <file>\n"
+    "\n"
+    "       File to write the JSON results to. Defaults to stdout.\n"
+    "\n"
+    ;
+
+OptionSet gCmdOptions =
+{
+    HandleOption,
+    gCmdOptionDefs,
+    "COMMAND OPTIONS",
+    gCmdOptionHelp
+};
+
+HelpOptions gHelpOptions(
+    CMD_NAME,
+    "Usage: " CMD_NAME " [ <options...> ]\n",
+    CHIP_VERSION_STRING "\n" COPYRIGHT_STRING,
+    "Measure the lookup of the read handlers interested in a dirty attribute, with the\n"
+    "attribute interest index and with a full scan, and write the results as JSON.\n"
+);
+
+OptionSet * gCmdOptionSets[] =
+{
+    &gCmdOptions,
+    &gHelpOptions,
+    nullptr
+};
+// clang-format on
+
+uint32_t gLookups         = 20000;
+const char * gOutFileName = nullptr;
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg)
+{
+    switch (id)
+    {
+    case 'n':
+        if (!ParseInt(arg, gLookups) || gLookups == 0)
+        {
+            PrintArgError("%s: Invalid value specified for lookups parameter: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'o':
+        gOutFileName = arg;
+        break;
+    default:
+        PrintArgError("%s: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+constexpr size_t kPathsPerHandler = 8;
+
+// Numbers of read handlers to measure. The largest one fills the index.
+constexpr size_t kHandlerCounts[] = { 16, 128, 1024 };
+
+/// Stands for a read handler: a fixed list of interest paths.
+struct FakeHandler
+{
+    SingleLinkedListNode<AttributePathParams> mPaths[kPathsPerHandler];
+    size_t mPathCount = 0;
+
+    void AddPath(const AttributePathParams & path)
+    {
+        mPaths[mPathCount].mValue = path;
+        if (mPathCount > 0)
+        {
+            mPaths[mPathCount - 1].mpNext = &mPaths[mPathCount];
+        }
+        mPathCount++;
+    }
+
+    const SingleLinkedListNode<AttributePathParams> * PathList() const { return mPathCount > 0 ? &mPaths[0] : nullptr; }
+};
+
+using Index = AttributeInterestIndex<FakeHandler, 8192>;
+using Clock = std::chrono::steady_clock;
+
+uint64_t ElapsedNs(Clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+AttributePathParams DirtyPath(uint32_t lookup, size_t handlerCount)
+{
+    return AttributePathParams(static_cast<EndpointId>(1 + (lookup * 7) % handlerCount), 0x0402,
+                               static_cast<AttributeId>(lookup % kPathsPerHandler));
+}
+
+/**
+ * Each handler subscribes to kPathsPerHandler attributes of its own endpoint, and one handler in 16 to a cluster on every
+ * endpoint. The index cost should stay flat as the number of handlers grows, while the scan grows linearly.
+ */
+CHIP_ERROR RunBenchmark(FILE * out, size_t handlerCount, bool first)
+{
+    std::unique_ptr<FakeHandler[]> handlers(new FakeHandler[handlerCount]);
+    Index index;
+    for (size_t h = 0; h < handlerCount; h++)
+    {
+        const EndpointId endpoint   = static_cast<EndpointId>(1 + h);
+        const size_t attributeCount = (h % 16 == 0) ? kPathsPerHandler - 1 : kPathsPerHandler;
+        for (AttributeId a = 0; a < attributeCount; a++)
+        {
+            handlers[h].AddPath(AttributePathParams(endpoint, 0x0402, a));
+        }
+        if (h % 16 == 0)
+        {
+            handlers[h].AddPath(AttributePathParams(ClusterId(0x0006), AttributeId(0)));
+        }
+        ReturnErrorOnFailure(index.Add(handlers[h], handlers[h].PathList()));
+    }
+
+    size_t indexMatches                = 0;
+    const Clock::time_point indexStart = Clock::now();
+    for (uint32_t i = 0; i < gLookups; i++)
+    {
+        index.ForEachInterestedOwner(DirtyPath(i, handlerCount), [&](FakeHandler &) { indexMatches++; });
+    }
+    const uint64_t indexNs = ElapsedNs(indexStart);
+
+    // The scan the reporting engine did before the index: every path of every handler.
+    size_t scanMatches                = 0;
+    const Clock::time_point scanStart = Clock::now();
+    for (uint32_t i = 0; i < gLookups; i++)
+    {
+        const AttributePathParams dirty = DirtyPath(i, handlerCount);
+        for (size_t h = 0; h < handlerCount; h++)
+        {
+            for (auto * node = handlers[h].PathList(); node != nullptr; node = node->mpNext)
+            {
+                if (node->mValue.Intersects(dirty))
+                {
+                    scanMatches++;
+                    break;
+                }
+            }
+        }
+    }
+    const uint64_t scanNs = ElapsedNs(scanStart);
+
+    if (indexMatches != scanMatches)
+    {
+        fprintf(stderr, "Index found %zu handlers, scan found %zu, for %zu handlers\n", indexMatches, scanMatches, handlerCount);
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    fprintf(out,
+            "%s\n    { \"handlers\": %zu, \"paths\": %zu, \"buckets\": %zu, \"lookups\": %" PRIu32
+            ", \"index_ns_per_lookup\": %" PRIu64 ", \"scan_ns_per_lookup\": %" PRIu64 " }",
+            first ? "" : ",", handlerCount, index.EntryCount(), index.BucketCount(), gLookups, indexNs / gLookups,
+            scanNs / gLookups);
+    fflush(out);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+extern "C" int main(int argc, char * argv[])
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    FILE * out     = stdout;
+
+    chip::Platform::MemoryInit();
+
+    VerifyOrExit(ParseArgs(CMD_NAME, argc, argv, gCmdOptionSets), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (gOutFileName != nullptr && strcmp(gOutFileName, "-") != 0)
+    {
+        out = fopen(gOutFileName, "w");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "Unable to create file %s: %s\n", gOutFileName, strerror(errno));
+            ExitNow(err = CHIP_ERROR_OPEN_FAILED);
+        }
+    }
+
+    fprintf(out, "{\n  \"paths_per_handler\": %zu,\n  \"results\": [", kPathsPerHandler);
+    for (size_t handlerCount : kHandlerCounts)
+    {
+        err = RunBenchmark(out, handlerCount, handlerCount == kHandlerCounts[0]);
+        SuccessOrExit(err);
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+exit:
+    if (out != stdout && out != nullptr)
+    {
+        fclose(out);
+    }
+    chip::Platform::MemoryShutdown();
+
+    return (err == CHIP_NO_ERROR) ? 0 : -1;
+}
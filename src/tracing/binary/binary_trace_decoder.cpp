@@ -0,0 +1,346 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/binary_trace_decoder.h>
+
+#include <lib/support/CodeUtils.h>
+#include <tracing/binary/record_format.h>
+
+#include <json/json.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+namespace {
+
+constexpr int kProcessId = 1;
+
+// Values of the enums recorded in Record::subtype. Kept here rather than
+// including the device-side headers so the decoder stays a pure host tool.
+const char * OutgoingMessageTypeName(uint8_t type)
+{
+    switch (type)
+    {
+    case 0:
+        return "Group";
+    case 1:
+        return "Secure";
+    case 2:
+        return "Unauthenticated";
+    default:
+        return "Unknown";
+    }
+}
+
+const char * IncomingMessageTypeName(uint8_t type)
+{
+    switch (type)
+    {
+    case 0:
+        return "Group";
+    case 1:
+        return "Secure";
+    case 2:
+        return "Unauthenticated";
+    default:
+        return "Unknown";
+    }
+}
+
+const char * DiscoveryTypeName(uint8_t type)
+{
+    switch (type)
+    {
+    case 0:
+        return "intermediate";
+    case 1:
+        return "done";
+    case 2:
+        return "retry-different";
+    default:
+        return "unknown";
+    }
+}
+
+std::string Hex(uint64_t value, int width)
+{
+    char buffer[2 + 16 + 1];
+    snprintf(buffer, sizeof(buffer), "0x%0*" PRIX64, width, value);
+    return buffer;
+}
+
+bool ReadRecord(std::istream & input, Record & record)
+{
+    input.read(reinterpret_cast<char *>(&record), sizeof(record));
+    // A trailing partial record is what is left of a flush interrupted by a crash.
+    return static_cast<size_t>(input.gcount()) == sizeof(record);
+}
+
+size_t LabelRecordCount(const Record & definition)
+{
+    return (definition.value + sizeof(Record) - 1) / sizeof(Record);
+}
+
+class ChromeTraceWriter
+{
+public:
+    ChromeTraceWriter(std::ostream & output) : mOutput(output)
+    {
+        ::Json::StreamWriterBuilder builder;
+        builder["indentation"] = "";
+        mWriter.reset(builder.newStreamWriter());
+        mOutput << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    }
+
+    ~ChromeTraceWriter() { mOutput << "\n]}\n"; }
+
+    ::Json::Value NewEvent(const Record & record, const char * phase, const std::string & name, const char * category)
+    {
+        ::Json::Value event;
+        event["name"] = name;
+        event["cat"]  = category;
+        event["ph"]   = phase;
+        event["ts"]   = static_cast<::Json::UInt64>(record.timestampUs);
+        event["pid"]  = kProcessId;
+        event["tid"]  = record.thread;
+        if (strcmp(phase, "i") == 0)
+        {
+            event["s"] = "t";
+        }
+        return event;
+    }
+
+    void Write(const ::Json::Value & event)
+    {
+        if (!mFirstEvent)
+        {
+            mOutput << ",\n";
+        }
+        mFirstEvent = false;
+        mWriter->write(event, &mOutput);
+    }
+
+private:
+    std::ostream & mOutput;
+    std::unique_ptr<::Json::StreamWriter> mWriter;
+    bool mFirstEvent = true;
+};
+
+class Decoder
+{
+public:
+    Decoder(std::istream & input, std::ostream & output) : mInput(input), mOutput(output) {}
+
+    CHIP_ERROR Run(DecodeStats & stats)
+    {
+        FileHeader header;
+        mInput.read(reinterpret_cast<char *>(&header), sizeof(header));
+        VerifyOrReturnError(static_cast<size_t>(mInput.gcount()) == sizeof(header), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+        VerifyOrReturnError(memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+        VerifyOrReturnError(header.byteOrderMark == kByteOrderMark, CHIP_ERROR_VERSION_MISMATCH);
+        VerifyOrReturnError(header.version == kFormatVersion && header.recordSize == sizeof(Record), CHIP_ERROR_VERSION_MISMATCH);
+
+        const std::streampos recordsStart = mInput.tellg();
+        ReadLabels(stats);
+
+        mInput.clear();
+        mInput.seekg(recordsStart);
+        VerifyOrReturnError(mInput.good(), CHIP_ERROR_READ_FAILED);
+
+        WriteEvents(stats);
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    void ReadLabels(DecodeStats & stats)
+    {
+        Record record;
+        while (ReadRecord(mInput, record))
+        {
+            if (record.type != RecordType::kLabelDefinition)
+            {
+                continue;
+            }
+
+            std::string label(LabelRecordCount(record) * sizeof(Record), '\0');
+            mInput.read(label.data(), static_cast<std::streamsize>(label.size()));
+            label.resize(std::min<size_t>(record.value, static_cast<size_t>(mInput.gcount())));
+            mLabels[record.label.id] = std::move(label);
+            stats.labels++;
+        }
+    }
+
+    const std::string & Label(uint16_t id)
+    {
+        auto it = mLabels.find(id);
+        if (it == mLabels.end())
+        {
+            // Label table overflowed on the device or the trace was cut short.
+            it = mLabels.emplace(id, (id == kInvalidLabelId) ? std::string("<unknown>") : "label#" + std::to_string(id)).first;
+        }
+        return it->second;
+    }
+
+    void WriteEvents(DecodeStats & stats)
+    {
+        ChromeTraceWriter writer(mOutput);
+
+        Record record;
+        while (ReadRecord(mInput, record))
+        {
+            if (record.type == RecordType::kLabelDefinition)
+            {
+                mInput.seekg(static_cast<std::streamoff>(LabelRecordCount(record) * sizeof(Record)), std::ios_base::cur);
+                continue;
+            }
+
+            stats.records++;
+            switch (record.type)
+            {
+            case RecordType::kBegin:
+                writer.Write(writer.NewEvent(record, "B", Label(record.label.id), Label(record.label.group).c_str()));
+                break;
+            case RecordType::kEnd:
+                writer.Write(writer.NewEvent(record, "E", Label(record.label.id), Label(record.label.group).c_str()));
+                break;
+            case RecordType::kInstant:
+                writer.Write(writer.NewEvent(record, "i", Label(record.label.id), Label(record.label.group).c_str()));
+                break;
+            case RecordType::kCounter: {
+                const std::string & name = Label(record.label.id);
+                ::Json::Value event      = writer.NewEvent(record, "C", name, "counter");
+                event["args"][name]      = ++mCounters[record.label.id];
+                writer.Write(event);
+                break;
+            }
+            case RecordType::kMessageSend:
+            case RecordType::kMessageReceived: {
+                const bool send     = record.type == RecordType::kMessageSend;
+                ::Json::Value event = writer.NewEvent(record, "i", send ? "MessageSend" : "MessageReceived", "message");
+                ::Json::Value & args = event["args"];
+
+                args["messageType"]    = send ? OutgoingMessageTypeName(record.subtype) : IncomingMessageTypeName(record.subtype);
+                args["messageCounter"] = record.message.messageCounter;
+                args["sessionId"]      = record.message.sessionId;
+                args["exchangeId"]     = record.message.exchangeId;
+                args["protocolId"]     = Hex(record.message.protocolId, 8);
+                args["opcode"]         = record.message.opcode;
+                args["exchangeFlags"]  = record.message.exchangeFlags;
+                args["messageFlags"]   = record.message.messageFlags;
+                args["payloadSize"]    = record.value;
+                writer.Write(event);
+                break;
+            }
+            case RecordType::kNodeLookup:
+                writer.Write(NodeEvent(writer, record, "NodeLookup"));
+                break;
+            case RecordType::kNodeDiscovered: {
+                ::Json::Value event  = NodeEvent(writer, record, "NodeDiscovered");
+                event["args"]["type"] = DiscoveryTypeName(record.subtype);
+                writer.Write(event);
+                break;
+            }
+            case RecordType::kNodeDiscoveryFailed: {
+                ::Json::Value event   = NodeEvent(writer, record, "NodeDiscoveryFailed");
+                event["args"]["error"] = Hex(record.value, 8);
+                writer.Write(event);
+                break;
+            }
+            case RecordType::kMetric:
+                writer.Write(MetricEvent(writer, record));
+                break;
+            case RecordType::kDropped: {
+                ::Json::Value event    = writer.NewEvent(record, "i", "RecordsDropped", "tracing");
+                event["args"]["count"] = record.value;
+                writer.Write(event);
+                stats.dropped += record.value;
+                break;
+            }
+            default:
+                stats.records--;
+                break;
+            }
+        }
+    }
+
+    ::Json::Value NodeEvent(ChromeTraceWriter & writer, const Record & record, const char * name)
+    {
+        ::Json::Value event                   = writer.NewEvent(record, "i", name, "dnssd");
+        event["args"]["node_id"]              = Hex(record.node.nodeId, 16);
+        event["args"]["compressed_fabric_id"] = Hex(record.node.compressedFabricId, 16);
+        return event;
+    }
+
+    ::Json::Value MetricEvent(ChromeTraceWriter & writer, const Record & record)
+    {
+        // Record::subtype is a MetricEvent::Type: begin, end or instant. Metric
+        // begin/end pairs do not nest with trace scopes, so they are emitted as
+        // async events keyed by metric.
+        static const char * const kPhases[] = { "b", "e", "i" };
+        const char * phase                  = (record.subtype < ArraySize(kPhases)) ? kPhases[record.subtype] : "i";
+
+        ::Json::Value event = writer.NewEvent(record, phase, Label(record.label.id), "metric");
+        if (strcmp(phase, "i") != 0)
+        {
+            event["id"] = record.label.id;
+        }
+
+        // Record::label.valueType is a MetricEvent::Value::Type.
+        switch (record.label.valueType)
+        {
+        case 1:
+            event["args"]["value"] = static_cast<int32_t>(record.value);
+            break;
+        case 2:
+            event["args"]["value"] = record.value;
+            break;
+        case 3:
+            event["args"]["error"] = Hex(record.value, 8);
+            break;
+        default:
+            break;
+        }
+        return event;
+    }
+
+    std::istream & mInput;
+    std::ostream & mOutput;
+    std::unordered_map<uint16_t, std::string> mLabels;
+    std::unordered_map<uint16_t, uint32_t> mCounters;
+};
+
+} // namespace
+
+CHIP_ERROR ConvertToChromeTrace(std::istream & input, std::ostream & output, DecodeStats * stats)
+{
+    DecodeStats localStats;
+    Decoder decoder(input, output);
+    return decoder.Run(stats != nullptr ? *stats : localStats);
+}
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
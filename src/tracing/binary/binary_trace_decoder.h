@@ -0,0 +1,52 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+struct DecodeStats
+{
+    size_t records = 0; // trace records decoded (label definitions excluded)
+    size_t labels  = 0; // label definitions found
+    size_t dropped = 0; // records the device reported as dropped
+};
+
+/// Converts a trace written by BinaryBackend into Chrome trace event JSON,
+/// which both chrome://tracing and https://ui.perfetto.dev can load.
+///
+/// `input` must be seekable: labels are resolved in a first pass over the file.
+///
+/// As this uses std::string, this is NOT for use on embedded devices.
+///
+/// @retval CHIP_ERROR_INVALID_FILE_IDENTIFIER `input` is not a binary trace.
+/// @retval CHIP_ERROR_VERSION_MISMATCH        the trace uses an unsupported format
+///                                            version or byte order.
+CHIP_ERROR ConvertToChromeTrace(std::istream & input, std::ostream & output, DecodeStats * stats = nullptr);
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
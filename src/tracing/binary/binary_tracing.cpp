@@ -0,0 +1,468 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/binary_tracing.h>
+
+#include <lib/address_resolve/TracingStructs.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <system/SystemClock.h>
+#include <tracing/metric_event.h>
+#include <transport/TracingStructs.h>
+
+#include <errno.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+namespace {
+
+// Label slot id of a label that was seen after the label table filled up.
+constexpr uint16_t kLabelTableFull = UINT16_MAX;
+
+std::atomic<uint64_t> gNextInstanceId{ 1 };
+
+// Ring of the calling thread for the backend that used it last. Tracing
+// almost always goes to a single backend, so this avoids any lookup in the
+// common case.
+struct ThreadRingCache
+{
+    uint64_t instanceId = 0;
+    void * ring         = nullptr;
+};
+
+thread_local ThreadRingCache gThreadRingCache;
+
+// The decoder maps Record::subtype and LabelData::valueType back to names
+// without depending on the device-side headers.
+static_assert(to_underlying(OutgoingMessageType::kUnauthenticated) == 2, "Decoder expects OutgoingMessageType values 0..2");
+static_assert(to_underlying(IncomingMessageType::kUnauthenticated) == 2, "Decoder expects IncomingMessageType values 0..2");
+static_assert(to_underlying(DiscoveryInfoType::kRetryDifferent) == 2, "Decoder expects DiscoveryInfoType values 0..2");
+static_assert(to_underlying(MetricEvent::Type::kInstantEvent) == 2, "Decoder expects MetricEvent::Type values 0..2");
+static_assert(to_underlying(MetricEvent::Value::Type::kChipErrorCode) == 3, "Decoder expects MetricEvent::Value::Type values 0..3");
+
+void FillMessageData(MessageData & data, const PayloadHeader * payloadHeader, const PacketHeader * packetHeader)
+{
+    if (payloadHeader != nullptr)
+    {
+        data.protocolId    = payloadHeader->GetProtocolID().ToFullyQualifiedSpecForm();
+        data.exchangeId    = payloadHeader->GetExchangeID();
+        data.opcode        = payloadHeader->GetMessageType();
+        data.exchangeFlags = payloadHeader->GetExchangeFlags();
+    }
+
+    if (packetHeader != nullptr)
+    {
+        data.messageCounter = packetHeader->GetMessageCounter();
+        data.sessionId      = packetHeader->GetSessionId();
+        data.messageFlags   = packetHeader->GetMessageFlags();
+    }
+}
+
+void FillNodeData(NodeData & data, const PeerId & peerId)
+{
+    data.nodeId             = peerId.GetNodeId();
+    data.compressedFabricId = peerId.GetCompressedFabricId();
+}
+
+} // namespace
+
+BinaryBackend::BinaryBackend() : mInstanceId(gNextInstanceId.fetch_add(1, std::memory_order_relaxed))
+{
+    for (auto & label : mLabelsById)
+    {
+        label.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+BinaryBackend::~BinaryBackend()
+{
+    CloseFile();
+}
+
+CHIP_ERROR BinaryBackend::OpenFile(const char * path, std::chrono::milliseconds flushInterval)
+{
+    CloseFile();
+
+    std::FILE * file = std::fopen(path, "wb");
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_POSIX(errno));
+
+    FileHeader header;
+    memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version       = kFormatVersion;
+    header.recordSize    = sizeof(Record);
+    header.byteOrderMark = kByteOrderMark;
+
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        std::fclose(file);
+        return err;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mOutputMutex);
+
+        // Records that raced with the previous CloseFile belong to no file.
+        size_t ringCount = mRingCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < ringCount; i++)
+        {
+            ThreadRing & ring = *mRings[i];
+            ring.tail.store(ring.head.load(std::memory_order_acquire), std::memory_order_release);
+            ring.dropped.store(0, std::memory_order_relaxed);
+        }
+
+        mOutputFile    = file;
+        mLabelsWritten = kInvalidLabelId;
+        mStopFlusher   = false;
+    }
+
+    mEnabled.store(true, std::memory_order_release);
+    mFlusher = std::thread(&BinaryBackend::FlusherLoop, this, flushInterval);
+
+    return CHIP_NO_ERROR;
+}
+
+void BinaryBackend::Flush()
+{
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    VerifyOrReturn(mOutputFile != nullptr);
+    DrainLocked();
+}
+
+void BinaryBackend::CloseFile()
+{
+    mEnabled.store(false, std::memory_order_release);
+
+    if (mFlusher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mOutputMutex);
+            mStopFlusher = true;
+        }
+        mFlusherWakeup.notify_all();
+        mFlusher.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    VerifyOrReturn(mOutputFile != nullptr);
+
+    DrainLocked();
+    std::fclose(mOutputFile);
+    mOutputFile = nullptr;
+}
+
+void BinaryBackend::TraceBegin(const char * label, const char * group)
+{
+    TraceLabel(RecordType::kBegin, label, group);
+}
+
+void BinaryBackend::TraceEnd(const char * label, const char * group)
+{
+    TraceLabel(RecordType::kEnd, label, group);
+}
+
+void BinaryBackend::TraceInstant(const char * label, const char * group)
+{
+    TraceLabel(RecordType::kInstant, label, group);
+}
+
+void BinaryBackend::TraceCounter(const char * label)
+{
+    TraceLabel(RecordType::kCounter, label, nullptr);
+}
+
+void BinaryBackend::LogMessageSend(MessageSendInfo & info)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type    = RecordType::kMessageSend;
+    record.subtype = static_cast<uint8_t>(to_underlying(info.messageType));
+    record.value   = static_cast<uint32_t>(info.payload.size());
+    FillMessageData(record.message, info.payloadHeader, info.packetHeader);
+    Push(record);
+}
+
+void BinaryBackend::LogMessageReceived(MessageReceivedInfo & info)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type    = RecordType::kMessageReceived;
+    record.subtype = static_cast<uint8_t>(to_underlying(info.messageType));
+    record.value   = static_cast<uint32_t>(info.payload.size());
+    FillMessageData(record.message, info.payloadHeader, info.packetHeader);
+    Push(record);
+}
+
+void BinaryBackend::LogNodeLookup(NodeLookupInfo & info)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type = RecordType::kNodeLookup;
+    FillNodeData(record.node, info.request->GetPeerId());
+    Push(record);
+}
+
+void BinaryBackend::LogNodeDiscovered(NodeDiscoveredInfo & info)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type    = RecordType::kNodeDiscovered;
+    record.subtype = static_cast<uint8_t>(to_underlying(info.type));
+    FillNodeData(record.node, *info.peerId);
+    Push(record);
+}
+
+void BinaryBackend::LogNodeDiscoveryFailed(NodeDiscoveryFailedInfo & info)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type  = RecordType::kNodeDiscoveryFailed;
+    record.value = info.error.AsInteger();
+    FillNodeData(record.node, *info.peerId);
+    Push(record);
+}
+
+void BinaryBackend::LogMetricEvent(const MetricEvent & event)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type            = RecordType::kMetric;
+    record.subtype         = static_cast<uint8_t>(to_underlying(event.type()));
+    record.label.id        = InternLabel(event.key());
+    record.label.valueType = to_underlying(event.ValueType());
+
+    using ValueType = MetricEvent::Value::Type;
+    switch (event.ValueType())
+    {
+    case ValueType::kInt32:
+        record.value = static_cast<uint32_t>(event.ValueInt32());
+        break;
+    case ValueType::kUInt32:
+        record.value = event.ValueUInt32();
+        break;
+    case ValueType::kChipErrorCode:
+        record.value = event.ValueErrorCode();
+        break;
+    default:
+        break;
+    }
+
+    Push(record);
+}
+
+void BinaryBackend::TraceLabel(RecordType type, const char * label, const char * group)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed));
+
+    Record record{};
+    record.type        = type;
+    record.label.id    = InternLabel(label);
+    record.label.group = InternLabel(group);
+    Push(record);
+}
+
+uint16_t BinaryBackend::InternLabel(const char * label)
+{
+    VerifyOrReturnValue(label != nullptr, kInvalidLabelId);
+
+    constexpr size_t kSlotMask = std::tuple_size<decltype(mLabelSlots)>::value - 1;
+    static_assert((kSlotMask & (kSlotMask + 1)) == 0, "Label slot count must be a power of 2");
+
+    // Labels are distinct constant strings, so the (low-entropy) pointer is mixed before use.
+    size_t hash = static_cast<size_t>((reinterpret_cast<uintptr_t>(label) >> 3) * 0x9E3779B97F4A7C15ull);
+    for (size_t probe = 0; probe <= kSlotMask; probe++)
+    {
+        LabelSlot & slot     = mLabelSlots[(hash + probe) & kSlotMask];
+        const char * current = slot.label.load(std::memory_order_acquire);
+
+        if (current == nullptr && slot.label.compare_exchange_strong(current, label, std::memory_order_acq_rel))
+        {
+            uint16_t id = mNextLabelId.fetch_add(1, std::memory_order_relaxed);
+            if (id < kMaxLabels)
+            {
+                mLabelsById[id].store(label, std::memory_order_release);
+            }
+            else
+            {
+                id = kLabelTableFull;
+            }
+            slot.id.store(id, std::memory_order_release);
+            return (id == kLabelTableFull) ? kInvalidLabelId : id;
+        }
+
+        if (current == label)
+        {
+            uint16_t id;
+            // Another thread claimed the slot and is about to publish its id.
+            while ((id = slot.id.load(std::memory_order_acquire)) == kInvalidLabelId)
+            {
+            }
+            return (id == kLabelTableFull) ? kInvalidLabelId : id;
+        }
+    }
+
+    return kInvalidLabelId;
+}
+
+BinaryBackend::ThreadRing * BinaryBackend::GetThreadRing()
+{
+    ThreadRingCache & cache = gThreadRingCache;
+    if (cache.instanceId != mInstanceId)
+    {
+        cache.ring       = RegisterThreadRing();
+        cache.instanceId = mInstanceId;
+    }
+    return static_cast<ThreadRing *>(cache.ring);
+}
+
+BinaryBackend::ThreadRing * BinaryBackend::RegisterThreadRing()
+{
+    std::lock_guard<std::mutex> lock(mRingsMutex);
+
+    const std::thread::id self = std::this_thread::get_id();
+    const size_t ringCount     = mRingCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < ringCount; i++)
+    {
+        if (mRings[i]->owner == self)
+        {
+            return mRings[i].get();
+        }
+    }
+
+    VerifyOrReturnValue(ringCount < kMaxThreads, nullptr);
+
+    auto ring   = std::make_unique<ThreadRing>();
+    ring->owner = self;
+    ring->index = static_cast<uint16_t>(ringCount);
+
+    mRings[ringCount] = std::move(ring);
+    mRingCount.store(ringCount + 1, std::memory_order_release);
+    return mRings[ringCount].get();
+}
+
+void BinaryBackend::Push(Record & record)
+{
+    ThreadRing * ring = GetThreadRing();
+    if (ring == nullptr)
+    {
+        mDroppedTotal.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingCapacity)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        mDroppedTotal.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    record.timestampUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+    record.thread      = ring->index;
+
+    ring->records[head & (kRingCapacity - 1)] = record;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void BinaryBackend::FlusherLoop(std::chrono::milliseconds flushInterval)
+{
+    std::unique_lock<std::mutex> lock(mOutputMutex);
+    while (!mStopFlusher)
+    {
+        mFlusherWakeup.wait_for(lock, flushInterval, [this] { return mStopFlusher; });
+        DrainLocked();
+    }
+}
+
+void BinaryBackend::DrainLocked()
+{
+    const size_t ringCount = mRingCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < ringCount; i++)
+    {
+        ThreadRing & ring   = *mRings[i];
+        uint32_t tail       = ring.tail.load(std::memory_order_relaxed);
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+
+        while (tail != head)
+        {
+            const size_t start = tail & (kRingCapacity - 1);
+            const size_t count = std::min<size_t>(head - tail, kRingCapacity - start);
+            std::fwrite(&ring.records[start], sizeof(Record), count, mOutputFile);
+            tail += static_cast<uint32_t>(count);
+        }
+        ring.tail.store(tail, std::memory_order_release);
+
+        uint32_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            Record record{};
+            record.timestampUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+            record.type        = RecordType::kDropped;
+            record.thread      = ring.index;
+            record.value       = dropped;
+            std::fwrite(&record, sizeof(record), 1, mOutputFile);
+        }
+    }
+
+    WriteLabelsLocked();
+    std::fflush(mOutputFile);
+}
+
+void BinaryBackend::WriteLabelsLocked()
+{
+    const uint16_t nextId = std::min<uint16_t>(mNextLabelId.load(std::memory_order_acquire), kMaxLabels);
+    for (uint16_t id = static_cast<uint16_t>(mLabelsWritten + 1); id < nextId; id++)
+    {
+        const char * label = mLabelsById[id].load(std::memory_order_acquire);
+        if (label == nullptr)
+        {
+            // Still being published; picked up by the next drain.
+            break;
+        }
+
+        const size_t length = strlen(label);
+
+        Record definition{};
+        definition.type     = RecordType::kLabelDefinition;
+        definition.value    = static_cast<uint32_t>(length);
+        definition.label.id = id;
+        std::fwrite(&definition, sizeof(definition), 1, mOutputFile);
+
+        // The string is padded with zeroes to a whole number of records.
+        std::fwrite(label, 1, length, mOutputFile);
+        static const uint8_t kPadding[sizeof(Record)] = {};
+        std::fwrite(kPadding, 1, (sizeof(Record) - length % sizeof(Record)) % sizeof(Record), mOutputFile);
+
+        mLabelsWritten = id;
+    }
+}
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
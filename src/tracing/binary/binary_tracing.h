@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <tracing/backend.h>
+#include <tracing/binary/record_format.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// A Backend that records fixed-size binary records for offline decoding.
+///
+/// Every thread that emits trace events gets its own single-producer ring of
+/// Records, so tracing calls never take a lock: they look up an interned id
+/// for the label, fill in a Record and publish it. A background thread drains
+/// the rings into the output file. `chip-binary-trace-decoder` converts the
+/// file into Chrome/Perfetto trace JSON.
+///
+/// When a ring is full, records are dropped and the number of dropped records
+/// is written to the file instead.
+///
+/// Labels, groups and metric keys are interned by pointer, so they MUST be
+/// constant strings (see src/tracing/README.md).
+///
+/// THREAD SAFETY:
+///    all tracing methods may be called from any thread. OpenFile/CloseFile
+///    must not race with each other.
+class BinaryBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr size_t kRingCapacity = 4096; // records per thread, must be a power of 2
+    static constexpr size_t kMaxThreads   = 32;
+    static constexpr size_t kMaxLabels    = 1024;
+
+    static constexpr std::chrono::milliseconds kDefaultFlushInterval{ 100 };
+
+    BinaryBackend();
+    ~BinaryBackend();
+
+    /// Start tracing output to the given file.
+    ///
+    /// Rings are drained every `flushInterval` by a background thread.
+    CHIP_ERROR OpenFile(const char * path, std::chrono::milliseconds flushInterval = kDefaultFlushInterval);
+
+    /// Writes all pending records to the file, if one is open.
+    void Flush();
+
+    /// Stops the background thread, writes all pending records and closes the file.
+    void CloseFile();
+
+    /// Total number of records dropped because a ring was full or too many threads were tracing.
+    uint32_t GetDroppedCount() const { return mDroppedTotal.load(std::memory_order_relaxed); }
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceInstant(const char * label, const char * group) override;
+    void TraceCounter(const char * label) override;
+    void LogMessageSend(MessageSendInfo &) override;
+    void LogMessageReceived(MessageReceivedInfo &) override;
+    void LogNodeLookup(NodeLookupInfo &) override;
+    void LogNodeDiscovered(NodeDiscoveredInfo &) override;
+    void LogNodeDiscoveryFailed(NodeDiscoveryFailedInfo &) override;
+    void LogMetricEvent(const MetricEvent &) override;
+    void Close() override { CloseFile(); }
+
+private:
+    static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "Ring capacity must be a power of 2");
+    static_assert(kMaxLabels <= UINT16_MAX, "Label ids are 16 bits");
+
+    /// Single producer (the owning thread), single consumer (the flusher) ring.
+    struct ThreadRing
+    {
+        std::thread::id owner;
+        uint16_t index = 0;
+
+        alignas(64) std::atomic<uint32_t> head{ 0 }; // written by the producer
+        alignas(64) std::atomic<uint32_t> tail{ 0 }; // written by the consumer
+        std::atomic<uint32_t> dropped{ 0 };
+
+        std::array<Record, kRingCapacity> records;
+    };
+
+    /// Lock-free open addressing map from label pointer to label id.
+    struct LabelSlot
+    {
+        std::atomic<const char *> label{ nullptr };
+        std::atomic<uint16_t> id{ kInvalidLabelId };
+    };
+
+    uint16_t InternLabel(const char * label);
+
+    /// Stamps `record` and publishes it in the calling thread's ring.
+    void Push(Record & record);
+    ThreadRing * GetThreadRing();
+    ThreadRing * RegisterThreadRing();
+
+    void TraceLabel(RecordType type, const char * label, const char * group);
+
+    void FlusherLoop(std::chrono::milliseconds flushInterval);
+    void DrainLocked();
+    void WriteLabelsLocked();
+
+    // Identifies this backend instance in the per-thread ring cache.
+    const uint64_t mInstanceId;
+
+    std::atomic<bool> mEnabled{ false };
+    std::atomic<uint32_t> mDroppedTotal{ 0 };
+
+    std::array<LabelSlot, 2 * kMaxLabels> mLabelSlots;
+    std::array<std::atomic<const char *>, kMaxLabels> mLabelsById;
+    std::atomic<uint16_t> mNextLabelId{ kInvalidLabelId + 1 };
+
+    std::mutex mRingsMutex; // protects ring registration
+    std::array<std::unique_ptr<ThreadRing>, kMaxThreads> mRings;
+    std::atomic<size_t> mRingCount{ 0 };
+
+    std::mutex mOutputMutex; // protects everything below
+    std::FILE * mOutputFile = nullptr;
+    uint16_t mLabelsWritten = kInvalidLabelId;
+    bool mStopFlusher       = false;
+    std::condition_variable mFlusherWakeup;
+    std::thread mFlusher;
+};
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
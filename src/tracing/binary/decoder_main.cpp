@@ -0,0 +1,58 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/binary_trace_decoder.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+/// Converts a binary trace (`--trace-to binary:<file>`) into Chrome trace event JSON.
+int main(int argc, char * argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <binary-trace-file> <output.json>\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios_base::in | std::ios_base::binary);
+    if (!input)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::ofstream output(argv[2], std::ios_base::out | std::ios_base::trunc);
+    if (!output)
+    {
+        fprintf(stderr, "Cannot create %s\n", argv[2]);
+        return 1;
+    }
+
+    chip::Tracing::Binary::DecodeStats stats;
+    CHIP_ERROR err = chip::Tracing::Binary::ConvertToChromeTrace(input, output, &stats);
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to decode %s: %" CHIP_ERROR_FORMAT "\n", argv[1], err.Format());
+        return 1;
+    }
+
+    printf("Decoded %zu records (%zu labels, %zu dropped on device)\n", stats.records, stats.labels, stats.dropped);
+    return 0;
+}
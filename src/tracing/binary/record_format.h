@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// On-disk layout of binary trace files.
+///
+/// A file is a FileHeader followed by a stream of fixed-size Records. Records
+/// are stored in the byte order of the traced device; FileHeader::byteOrderMark
+/// lets the decoder detect a mismatch.
+///
+/// Records of a single thread appear in the order they were traced, records of
+/// different threads are interleaved in flush order. Label definitions may
+/// appear after the records that reference them.
+
+inline constexpr char kFileMagic[8]       = { 'M', 'T', 'R', 'B', 'I', 'N', '0', '1' };
+inline constexpr uint16_t kFormatVersion  = 1;
+inline constexpr uint32_t kByteOrderMark  = 0x01020304;
+inline constexpr uint16_t kInvalidLabelId = 0;
+
+struct FileHeader
+{
+    char magic[sizeof(kFileMagic)];
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t byteOrderMark;
+};
+
+enum class RecordType : uint8_t
+{
+    kLabelDefinition     = 1, // value = string length, label.id = id; followed by the string padded to whole records
+    kBegin               = 2,
+    kEnd                 = 3,
+    kInstant             = 4,
+    kCounter             = 5,
+    kMessageSend         = 6, // subtype = OutgoingMessageType, value = payload size
+    kMessageReceived     = 7, // subtype = IncomingMessageType, value = payload size
+    kNodeLookup          = 8,
+    kNodeDiscovered      = 9,  // subtype = DiscoveryInfoType
+    kNodeDiscoveryFailed = 10, // value = CHIP_ERROR
+    kMetric              = 11, // subtype = MetricEvent::Type, value = metric value
+    kDropped             = 12, // value = number of records lost because the thread ring was full
+};
+
+struct LabelData
+{
+    uint16_t id;    // label (or metric key) for trace/metric records
+    uint16_t group; // group label for begin/end/instant records
+    uint8_t valueType;
+    uint8_t reserved[11];
+};
+
+struct MessageData
+{
+    uint32_t messageCounter;
+    uint32_t protocolId; // vendor id << 16 | protocol id
+    uint16_t sessionId;
+    uint16_t exchangeId;
+    uint8_t opcode;
+    uint8_t exchangeFlags;
+    uint8_t messageFlags;
+    uint8_t reserved;
+};
+
+struct NodeData
+{
+    uint64_t nodeId;
+    uint64_t compressedFabricId;
+};
+
+struct Record
+{
+    uint64_t timestampUs; // System monotonic time
+    RecordType type;
+    uint8_t subtype;
+    uint16_t thread; // index of the thread that produced the record
+    uint32_t value;
+
+    union
+    {
+        LabelData label;
+        MessageData message;
+        NodeData node;
+    };
+};
+
+static_assert(sizeof(Record) == 32, "Binary trace records are expected to be 32 bytes");
+static_assert(sizeof(FileHeader) == 16, "Unexpected binary trace file header size");
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
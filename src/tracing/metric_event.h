@@ -22,6 +22,9 @@
 #include <tracing/metric_macros.h>
 #include <tracing/registry.h>
 
+#include <chrono>
+#include <cstdint>
+
 namespace chip {
 namespace Tracing {
 
@@ -143,6 +146,21 @@ private:
     Value mValue;
 };
 
+/**
+ * Converts an elapsed time into the value of a latency metric: microseconds,
+ * saturated to 32 bits (a little over an hour).
+ */
+template <typename Rep, typename Period>
+inline uint32_t LatencyMicroseconds(std::chrono::duration<Rep, Period> elapsed)
+{
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    if (micros <= 0)
+    {
+        return 0;
+    }
+    return (static_cast<uint64_t>(micros) > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(micros);
+}
+
 namespace ErrorHandling {
 
 /**
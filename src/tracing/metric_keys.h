@@ -78,5 +78,24 @@ constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
+// CASE connection scheduler: time from leaving idle until all requests completed
+constexpr MetricKey kMetricCASEConnectionSchedulerDrain = "core_case_sched_drain";
+
+// The following metrics are measured by their call site and reported as
+// instant events whose value is the latency in microseconds (see
+// LatencyMicroseconds), or the error that ended the interaction.
+
+// Read interaction: Read Request sent until the last report is processed
+constexpr MetricKey kMetricIMReadRoundTrip = "core_im_read_rtt_us";
+
+// Time between two consecutive reports of an established subscription
+constexpr MetricKey kMetricIMSubscriptionReportInterval = "core_im_sub_report_interval_us";
+
+// Invoke interaction: Invoke Request sent until the response is processed
+constexpr MetricKey kMetricIMCommandRoundTrip = "core_im_command_rtt_us";
+
+// Invoke Request received until all command handlers completed (server side)
+constexpr MetricKey kMetricIMCommandHandling = "core_im_command_handling_us";
+
 } // namespace Tracing
 } // namespace chip
@@ -0,0 +1,52 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
+
+#include <system/SystemEventLoopProfiler.h>
+#include <tracing/backend.h>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+/**
+ * A Backend that labels the event loop callbacks measured by System::EventLoopProfiler with the innermost tracing scope
+ * or instant event they emit (e.g. "HandleSigma1"), so that slow callbacks can be attributed without symbols.
+ */
+class EventLoopLabels : public ::chip::Tracing::Backend
+{
+public:
+    void TraceBegin(const char * label, const char * group) override { System::EventLoopProfiler::Instance().Annotate(label); }
+    void TraceEnd(const char * label, const char * group) override { System::EventLoopProfiler::Instance().EndAnnotation(); }
+    void TraceInstant(const char * label, const char * group) override
+    {
+        System::EventLoopProfiler::Instance().Annotate(label);
+        System::EventLoopProfiler::Instance().EndAnnotation();
+    }
+};
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILING
@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/metrics/latency_histogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+namespace {
+
+unsigned MostSignificantBit(uint32_t value)
+{
+    unsigned bit = 0;
+    while (value >>= 1)
+    {
+        bit++;
+    }
+    return bit;
+}
+
+} // namespace
+
+size_t LatencyHistogram::BucketIndex(uint32_t value)
+{
+    if (value < kSubBucketCount)
+    {
+        return value;
+    }
+
+    // Keep the top kSubBucketBits - 1 bits below the most significant one.
+    const unsigned shift = MostSignificantBit(value) - (kSubBucketBits - 1);
+    const size_t top     = value >> shift; // in [kHalfSubBucketCount, kSubBucketCount)
+    return kSubBucketCount + (shift - 1) * kHalfSubBucketCount + (top - kHalfSubBucketCount);
+}
+
+uint32_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < kSubBucketCount)
+    {
+        return static_cast<uint32_t>(index);
+    }
+
+    const size_t offset  = index - kSubBucketCount;
+    const unsigned shift = static_cast<unsigned>(offset / kHalfSubBucketCount) + 1;
+    const uint64_t top   = kHalfSubBucketCount + offset % kHalfSubBucketCount;
+    const uint64_t bound = ((top + 1) << shift) - 1;
+    return static_cast<uint32_t>(std::min<uint64_t>(bound, UINT32_MAX));
+}
+
+void LatencyHistogram::Record(uint32_t value)
+{
+    mBuckets[BucketIndex(value)]++;
+    mCount++;
+    mSum += value;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram & other)
+{
+    for (size_t i = 0; i < kBucketCount; i++)
+    {
+        mBuckets[i] += other.mBuckets[i];
+    }
+    mCount += other.mCount;
+    mSum += other.mSum;
+    mMin = std::min(mMin, other.mMin);
+    mMax = std::max(mMax, other.mMax);
+}
+
+uint32_t LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    percentile        = std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank     = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(mCount)));
+    rank              = std::max<uint64_t>(rank, 1);
+    uint64_t observed = 0;
+
+    for (size_t i = 0; i < kBucketCount; i++)
+    {
+        observed += mBuckets[i];
+        if (observed >= rank)
+        {
+            // The bucket bound may lie outside of what was actually recorded.
+            return std::clamp(BucketUpperBound(i), Min(), mMax);
+        }
+    }
+
+    return mMax;
+}
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
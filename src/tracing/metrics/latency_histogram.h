@@ -0,0 +1,81 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+/**
+ * Fixed-size histogram of 32-bit values (typically latencies in microseconds)
+ * with bounded relative error, in the style of HdrHistogram.
+ *
+ * Values below kSubBucketCount are counted exactly. Every larger power of two
+ * range is split into kHalfSubBucketCount linear buckets, so a value reported
+ * by ValueAtPercentile is at most 1 / kHalfSubBucketCount above the recorded
+ * one (6.25% for kSubBucketBits = 5).
+ *
+ * Recording is O(1) and never allocates.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned kSubBucketBits    = 5;
+    static constexpr size_t kSubBucketCount     = 1u << kSubBucketBits;
+    static constexpr size_t kHalfSubBucketCount = kSubBucketCount / 2;
+    static constexpr size_t kBucketCount        = kSubBucketCount + (32 - kSubBucketBits) * kHalfSubBucketCount;
+
+    void Record(uint32_t value);
+    void Reset() { *this = LatencyHistogram(); }
+
+    /// Adds all samples of `other` to this histogram.
+    void Merge(const LatencyHistogram & other);
+
+    uint64_t Count() const { return mCount; }
+    uint32_t Min() const { return mCount > 0 ? mMin : 0; }
+    uint32_t Max() const { return mMax; }
+    uint64_t Sum() const { return mSum; }
+    uint32_t Mean() const { return mCount > 0 ? static_cast<uint32_t>(mSum / mCount) : 0; }
+
+    /**
+     * Returns the smallest value such that at least `percentile` percent of
+     * the samples are less than or equal to it, within the histogram
+     * precision. Returns 0 for an empty histogram.
+     */
+    uint32_t ValueAtPercentile(double percentile) const;
+
+    static size_t BucketIndex(uint32_t value);
+    /// Highest value counted in the bucket at `index`.
+    static uint32_t BucketUpperBound(size_t index);
+
+private:
+    std::array<uint32_t, kBucketCount> mBuckets = {};
+    uint64_t mCount = 0;
+    uint64_t mSum   = 0;
+    uint32_t mMin   = UINT32_MAX;
+    uint32_t mMax   = 0;
+};
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,254 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/metrics/metrics_registry.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/EnforceFormat.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/metric_event.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+namespace {
+
+bool IsError(const MetricEvent & event)
+{
+    return event.ValueType() == MetricEvent::Value::Type::kChipErrorCode && event.ValueErrorCode() != CHIP_NO_ERROR.AsInteger();
+}
+
+void AppendFormatted(std::string & out, const char * format, ...) ENFORCE_FORMAT(2, 3);
+
+void AppendFormatted(std::string & out, const char * format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0)
+    {
+        out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+}
+
+void AppendHistogramText(std::string & out, const char * name, const LatencyHistogram & histogram)
+{
+    VerifyOrReturn(histogram.Count() > 0);
+    AppendFormatted(out,
+                    " %s[n=%" PRIu64 " min=%" PRIu32 " mean=%" PRIu32 " p50=%" PRIu32 " p90=%" PRIu32 " p99=%" PRIu32
+                    " max=%" PRIu32 "]",
+                    name, histogram.Count(), histogram.Min(), histogram.Mean(), histogram.ValueAtPercentile(50),
+                    histogram.ValueAtPercentile(90), histogram.ValueAtPercentile(99), histogram.Max());
+}
+
+void AppendHistogramJson(std::string & out, const char * name, const LatencyHistogram & histogram)
+{
+    VerifyOrReturn(histogram.Count() > 0);
+    AppendFormatted(out,
+                    ",\"%s\":{\"count\":%" PRIu64 ",\"min\":%" PRIu32 ",\"mean\":%" PRIu32 ",\"p50\":%" PRIu32
+                    ",\"p90\":%" PRIu32 ",\"p99\":%" PRIu32 ",\"max\":%" PRIu32 "}",
+                    name, histogram.Count(), histogram.Min(), histogram.Mean(), histogram.ValueAtPercentile(50),
+                    histogram.ValueAtPercentile(90), histogram.ValueAtPercentile(99), histogram.Max());
+}
+
+} // namespace
+
+MetricsRegistry & MetricsRegistry::Instance()
+{
+    static MetricsRegistry sInstance;
+    return sInstance;
+}
+
+void MetricsRegistry::LogMetricEvent(const MetricEvent & event)
+{
+    const System::Clock::Microseconds64 now = System::SystemClock().GetMonotonicMicroseconds64();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mEntries.find(std::string_view(event.key()));
+    if (it == mEntries.end())
+    {
+        it = mEntries.emplace(event.key(), Entry()).first;
+    }
+    Entry & entry = it->second;
+
+    if (IsError(event))
+    {
+        entry.stats.errors++;
+    }
+
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        if (entry.pendingBegins.size() >= kMaxPendingBegins)
+        {
+            entry.pendingBegins.pop_front();
+        }
+        entry.pendingBegins.push_back(now);
+        break;
+
+    case MetricEvent::Type::kEndEvent:
+        if (entry.pendingBegins.empty())
+        {
+            entry.stats.unmatchedEnds++;
+            break;
+        }
+        entry.stats.events++;
+        entry.stats.durations.Record(LatencyMicroseconds(now - entry.pendingBegins.front()));
+        entry.pendingBegins.pop_front();
+        break;
+
+    case MetricEvent::Type::kInstantEvent:
+        entry.stats.events++;
+        if (event.ValueType() == MetricEvent::Value::Type::kUInt32)
+        {
+            entry.stats.values.Record(event.ValueUInt32());
+        }
+        else if (event.ValueType() == MetricEvent::Value::Type::kInt32 && event.ValueInt32() >= 0)
+        {
+            entry.stats.values.Record(static_cast<uint32_t>(event.ValueInt32()));
+        }
+        break;
+    }
+}
+
+bool MetricsRegistry::GetStats(const char * key, MetricStats & stats) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mEntries.find(std::string_view(key));
+    VerifyOrReturnValue(it != mEntries.end(), false);
+    stats = it->second.stats;
+    return true;
+}
+
+void MetricsRegistry::Reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+}
+
+std::string MetricsRegistry::Export(ExportFormat format) const
+{
+    std::string out;
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    switch (format)
+    {
+    case ExportFormat::kText:
+        ExportText(out);
+        break;
+    case ExportFormat::kJson:
+        ExportJson(out);
+        break;
+    }
+    return out;
+}
+
+void MetricsRegistry::ExportText(std::string & out) const
+{
+    for (const auto & [key, entry] : mEntries)
+    {
+        const MetricStats & stats = entry.stats;
+
+        out += key;
+        AppendFormatted(out, " events=%" PRIu64 " errors=%" PRIu64, stats.events, stats.errors);
+        if (stats.unmatchedEnds > 0)
+        {
+            AppendFormatted(out, " unmatched_ends=%" PRIu64, stats.unmatchedEnds);
+        }
+        AppendHistogramText(out, "duration_us", stats.durations);
+        AppendHistogramText(out, "value", stats.values);
+        out += '\n';
+    }
+}
+
+void MetricsRegistry::ExportJson(std::string & out) const
+{
+    out += '{';
+    bool first = true;
+    for (const auto & [key, entry] : mEntries)
+    {
+        const MetricStats & stats = entry.stats;
+
+        // Metric keys are identifiers, so they need no escaping.
+        out += first ? "\"" : ",\"";
+        out += key;
+        AppendFormatted(out, "\":{\"events\":%" PRIu64 ",\"errors\":%" PRIu64 ",\"unmatched_ends\":%" PRIu64, stats.events,
+                        stats.errors, stats.unmatchedEnds);
+        AppendHistogramJson(out, "duration_us", stats.durations);
+        AppendHistogramJson(out, "value", stats.values);
+        out += '}';
+        first = false;
+    }
+    out += "}\n";
+}
+
+CHIP_ERROR MetricsRegistry::StartPeriodicExport(System::Layer & layer, System::Clock::Timeout interval, ExportFormat format,
+                                                ExportCallback callback, void * context)
+{
+    VerifyOrReturnError(callback != nullptr && interval > System::Clock::kZero, CHIP_ERROR_INVALID_ARGUMENT);
+
+    StopPeriodicExport();
+
+    mExportLayer    = &layer;
+    mExportInterval = interval;
+    mExportFormat   = format;
+    mExportCallback = callback;
+    mExportContext  = context;
+
+    CHIP_ERROR err = layer.StartTimer(interval, OnExportTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        mExportLayer = nullptr;
+    }
+    return err;
+}
+
+void MetricsRegistry::StopPeriodicExport()
+{
+    VerifyOrReturn(mExportLayer != nullptr);
+    mExportLayer->CancelTimer(OnExportTimer, this);
+    mExportLayer = nullptr;
+}
+
+void MetricsRegistry::OnExportTimer(System::Layer * layer, void * context)
+{
+    auto * self = static_cast<MetricsRegistry *>(context);
+    VerifyOrReturn(self->mExportLayer == layer);
+
+    self->mExportCallback(self->Export(self->mExportFormat), self->mExportContext);
+
+    // The callback may have stopped the export.
+    if (self->mExportLayer != nullptr)
+    {
+        LogErrorOnFailure(layer->StartTimer(self->mExportInterval, OnExportTimer, self));
+    }
+}
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <tracing/backend.h>
+#include <tracing/metrics/latency_histogram.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+/**
+ * A Backend that aggregates metric events in process, so that latency
+ * percentiles and counters are available without an external tracing tool.
+ *
+ * Events are aggregated per metric key:
+ *   - MATTER_LOG_METRIC_BEGIN/END pairs record the elapsed time into a
+ *     duration histogram (microseconds). Begins and ends of the same key are
+ *     paired in FIFO order.
+ *   - MATTER_LOG_METRIC instants with an integer value record that value into
+ *     a value histogram. Latency metrics measured by their call site (keys
+ *     ending in `_us`) are reported this way.
+ *   - Any event carrying a CHIP_ERROR other than CHIP_NO_ERROR counts as an
+ *     error.
+ *
+ * Snapshots can be exported as text or JSON on demand (Export) or
+ * periodically on the Matter event loop (StartPeriodicExport).
+ *
+ * THREAD SAFETY:
+ *    metric events and Export may come from any thread. Periodic export must
+ *    be started and stopped with the Matter stack lock held.
+ */
+class MetricsRegistry : public ::chip::Tracing::Backend
+{
+public:
+    enum class ExportFormat : uint8_t
+    {
+        kText, // one line per metric
+        kJson, // a single JSON object keyed by metric
+    };
+
+    struct MetricStats
+    {
+        uint64_t events        = 0; // completed begin/end pairs and instants
+        uint64_t errors        = 0; // events carrying an error
+        uint64_t unmatchedEnds = 0; // end events without a preceding begin
+        LatencyHistogram durations; // begin to end, in microseconds
+        LatencyHistogram values;    // values of instant events
+    };
+
+    using ExportCallback = void (*)(const std::string & snapshot, void * context);
+
+    // Begins without an end (e.g. cancelled operations) are forgotten after this many.
+    static constexpr size_t kMaxPendingBegins = 16;
+
+    MetricsRegistry() = default;
+
+    /// Process-wide registry used by command line tooling.
+    static MetricsRegistry & Instance();
+
+    /// Copies the statistics of `key` into `stats`. Returns false if nothing was recorded for `key`.
+    bool GetStats(const char * key, MetricStats & stats) const;
+
+    /// Returns a snapshot of all metrics, sorted by key.
+    std::string Export(ExportFormat format) const;
+
+    void Reset();
+
+    /**
+     * Calls `callback` with a snapshot every `interval` until StopPeriodicExport
+     * is called or the registry is closed.
+     *
+     * The export is not stopped on destruction: Instance() is destroyed after
+     * the system layer, so whoever starts the export stops it before shutting
+     * the stack down.
+     */
+    CHIP_ERROR StartPeriodicExport(System::Layer & layer, System::Clock::Timeout interval, ExportFormat format,
+                                   ExportCallback callback, void * context);
+    void StopPeriodicExport();
+
+    void LogMetricEvent(const MetricEvent & event) override;
+    void Close() override { StopPeriodicExport(); }
+
+private:
+    struct Entry
+    {
+        MetricStats stats;
+        std::deque<System::Clock::Microseconds64> pendingBegins;
+    };
+
+    static void OnExportTimer(System::Layer * layer, void * context);
+
+    void ExportText(std::string & out) const;
+    void ExportJson(std::string & out) const;
+
+    mutable std::mutex mMutex; // protects mEntries
+    std::map<std::string, Entry, std::less<>> mEntries;
+
+    System::Layer * mExportLayer = nullptr;
+    System::Clock::Timeout mExportInterval;
+    ExportFormat mExportFormat    = ExportFormat::kText;
+    ExportCallback mExportCallback = nullptr;
+    void * mExportContext          = nullptr;
+};
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,231 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <protocols/interaction_model/Constants.h>
+#include <tracing/binary/binary_trace_decoder.h>
+#include <tracing/binary/binary_tracing.h>
+#include <tracing/metric_event.h>
+#include <transport/TracingStructs.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <json/json.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Binary;
+
+namespace {
+
+class TestBinaryTracing : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        char path[] = "/tmp/matter-binary-trace-XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        mPath = path;
+    }
+
+    void TearDown() override { remove(mPath.c_str()); }
+
+    /// Decodes the trace file into its list of Chrome trace events.
+    ::Json::Value Decode(DecodeStats & stats)
+    {
+        std::ifstream input(mPath, std::ios_base::in | std::ios_base::binary);
+        std::stringstream output;
+        EXPECT_EQ(ConvertToChromeTrace(input, output, &stats), CHIP_NO_ERROR);
+
+        ::Json::Value root;
+        ::Json::CharReaderBuilder builder;
+        std::string errors;
+        EXPECT_TRUE(::Json::parseFromStream(builder, output, &root, &errors)) << errors;
+        return root["traceEvents"];
+    }
+
+    std::string mPath;
+};
+
+TEST_F(TestBinaryTracing, TestRoundTrip)
+{
+    BinaryBackend backend;
+    ASSERT_EQ(backend.OpenFile(mPath.c_str()), CHIP_NO_ERROR);
+
+    backend.TraceBegin("Outer", "Group");
+    backend.TraceBegin("Inner", "Group");
+    backend.TraceInstant("Instant", "Other");
+    backend.TraceEnd("Inner", "Group");
+    backend.TraceCounter("Counter");
+    backend.TraceCounter("Counter");
+    backend.TraceEnd("Outer", "Group");
+
+    PacketHeader packetHeader;
+    packetHeader.SetMessageCounter(1234).SetSessionId(42);
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(7).SetMessageType(Protocols::InteractionModel::MsgType::ReadRequest);
+    const uint8_t payload[16] = {};
+    MessageSendInfo sendInfo{ OutgoingMessageType::kSecureSession, &payloadHeader, &packetHeader, ByteSpan(payload) };
+    backend.LogMessageSend(sendInfo);
+
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, "core_metric"));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, "core_metric", CHIP_ERROR_TIMEOUT));
+
+    backend.CloseFile();
+
+    // Events are ignored while no file is open.
+    backend.TraceInstant("Ignored", "Group");
+
+    DecodeStats stats;
+    ::Json::Value events = Decode(stats);
+    EXPECT_EQ(stats.records, 10u);
+    EXPECT_EQ(stats.dropped, 0u);
+    ASSERT_EQ(events.size(), 10u);
+
+    const std::vector<std::string> expected = {
+        "B:Group:Outer",     "B:Group:Inner", "i:Other:Instant",       "E:Group:Inner",        "C:counter:Counter",
+        "C:counter:Counter", "E:Group:Outer", "i:message:MessageSend", "b:metric:core_metric", "e:metric:core_metric",
+    };
+    for (::Json::ArrayIndex i = 0; i < events.size(); i++)
+    {
+        EXPECT_EQ(events[i]["ph"].asString() + ":" + events[i]["cat"].asString() + ":" + events[i]["name"].asString(), expected[i]);
+        EXPECT_EQ(events[i]["tid"], events[0]["tid"]);
+        if (i > 0)
+        {
+            EXPECT_GE(events[i]["ts"].asUInt64(), events[i - 1]["ts"].asUInt64());
+        }
+    }
+
+    EXPECT_EQ(events[5]["args"]["Counter"].asUInt(), 2u);
+
+    const ::Json::Value & message = events[7]["args"];
+    EXPECT_EQ(message["messageType"].asString(), "Secure");
+    EXPECT_EQ(message["messageCounter"].asUInt(), 1234u);
+    EXPECT_EQ(message["sessionId"].asUInt(), 42u);
+    EXPECT_EQ(message["exchangeId"].asUInt(), 7u);
+    EXPECT_EQ(message["protocolId"].asString(), "0x00000001");
+    EXPECT_EQ(message["opcode"].asUInt(), to_underlying(Protocols::InteractionModel::MsgType::ReadRequest));
+    EXPECT_EQ(message["payloadSize"].asUInt(), sizeof(payload));
+
+    EXPECT_EQ(events[8]["id"], events[9]["id"]);
+    EXPECT_EQ(events[9]["args"]["error"].asString(), "0x00000032");
+}
+
+TEST_F(TestBinaryTracing, TestMultipleThreads)
+{
+    constexpr int kThreads         = 4;
+    constexpr int kScopesPerThread = 2000;
+
+    BinaryBackend backend;
+    ASSERT_EQ(backend.OpenFile(mPath.c_str(), std::chrono::milliseconds(1)), CHIP_NO_ERROR);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&backend] {
+            for (int i = 0; i < kScopesPerThread; i++)
+            {
+                backend.TraceBegin("Scope", "Thread");
+                backend.TraceEnd("Scope", "Thread");
+                if (i % 512 == 0)
+                {
+                    // Let the flusher catch up so that nothing is dropped.
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    backend.CloseFile();
+
+    DecodeStats stats;
+    ::Json::Value events = Decode(stats);
+    EXPECT_EQ(stats.records + backend.GetDroppedCount(), static_cast<size_t>(kThreads * kScopesPerThread * 2));
+
+    // Every thread's records stay in order, so scopes are properly nested per thread.
+    std::map<int, int> depth;
+    for (const auto & event : events)
+    {
+        if (event["name"].asString() == "RecordsDropped")
+        {
+            continue;
+        }
+        EXPECT_EQ(event["name"].asString(), "Scope");
+        int & threadDepth = depth[event["tid"].asInt()];
+        threadDepth += (event["ph"].asString() == "B") ? 1 : -1;
+        EXPECT_GE(threadDepth, 0);
+        EXPECT_LE(threadDepth, 1);
+    }
+    EXPECT_EQ(depth.size(), static_cast<size_t>(kThreads));
+}
+
+TEST_F(TestBinaryTracing, TestRingOverflow)
+{
+    constexpr size_t kExtra = 10;
+
+    BinaryBackend backend;
+    // The flusher does not run during the test, so the ring fills up.
+    ASSERT_EQ(backend.OpenFile(mPath.c_str(), std::chrono::hours(1)), CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < BinaryBackend::kRingCapacity + kExtra; i++)
+    {
+        backend.TraceInstant("Tick", "Group");
+    }
+    EXPECT_EQ(backend.GetDroppedCount(), kExtra);
+
+    // Draining makes room again.
+    backend.Flush();
+    backend.TraceInstant("Tock", "Group");
+    backend.CloseFile();
+
+    DecodeStats stats;
+    ::Json::Value events = Decode(stats);
+    EXPECT_EQ(stats.dropped, kExtra);
+    EXPECT_EQ(stats.labels, 3u); // Tick, Group, Tock
+    // The ring contents are followed by the drop notice and the event traced after the flush.
+    const ::Json::ArrayIndex kDroppedIndex = BinaryBackend::kRingCapacity;
+    ASSERT_EQ(events.size(), kDroppedIndex + 2);
+    EXPECT_EQ(events[kDroppedIndex]["name"].asString(), "RecordsDropped");
+    EXPECT_EQ(events[kDroppedIndex]["args"]["count"].asUInt(), kExtra);
+    EXPECT_EQ(events[kDroppedIndex + 1]["name"].asString(), "Tock");
+}
+
+TEST_F(TestBinaryTracing, TestInvalidInput)
+{
+    std::stringstream input("not a binary trace file");
+    std::stringstream output;
+    EXPECT_EQ(ConvertToChromeTrace(input, output), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+}
+
+} // namespace
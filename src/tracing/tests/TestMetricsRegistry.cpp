@@ -0,0 +1,226 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <system/SystemClock.h>
+#include <tracing/metric_event.h>
+#include <tracing/metrics/latency_histogram.h>
+#include <tracing/metrics/metrics_registry.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <cmath>
+#include <string>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Metrics;
+
+namespace {
+
+constexpr MetricKey kTestKey      = "test_operation";
+constexpr MetricKey kTestValueKey = "test_value_us";
+
+class TestMetricsRegistry : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    System::Clock::ClockBase * mRealClock;
+    System::Clock::Internal::MockClock mMockClock;
+};
+
+TEST(TestLatencyHistogram, TestBucketBounds)
+{
+    // Small values are recorded exactly.
+    for (uint32_t value = 0; value < LatencyHistogram::kSubBucketCount; value++)
+    {
+        EXPECT_EQ(LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketIndex(value)), value);
+    }
+
+    // Every value maps to a bucket whose upper bound is within the advertised relative error.
+    for (uint64_t value = LatencyHistogram::kSubBucketCount; value <= UINT32_MAX; value = value * 3 / 2 + 1)
+    {
+        const size_t index = LatencyHistogram::BucketIndex(static_cast<uint32_t>(value));
+        ASSERT_LT(index, LatencyHistogram::kBucketCount);
+
+        const uint64_t upper = LatencyHistogram::BucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), static_cast<double>(value) / LatencyHistogram::kHalfSubBucketCount);
+    }
+
+    EXPECT_EQ(LatencyHistogram::BucketIndex(UINT32_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(TestLatencyHistogram, TestPercentiles)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.ValueAtPercentile(50), 0u);
+
+    for (uint32_t value = 1; value <= 10000; value++)
+    {
+        histogram.Record(value);
+    }
+
+    EXPECT_EQ(histogram.Count(), 10000u);
+    EXPECT_EQ(histogram.Min(), 1u);
+    EXPECT_EQ(histogram.Max(), 10000u);
+    EXPECT_EQ(histogram.Sum(), 10000u * 10001u / 2);
+    EXPECT_EQ(histogram.ValueAtPercentile(0), 1u);
+    EXPECT_EQ(histogram.ValueAtPercentile(100), 10000u);
+
+    const double percentiles[] = { 50, 90, 99, 99.9 };
+    for (double percentile : percentiles)
+    {
+        const double expected = percentile * 100;
+        const double actual   = histogram.ValueAtPercentile(percentile);
+        EXPECT_LE(std::fabs(actual - expected), expected / LatencyHistogram::kHalfSubBucketCount) << percentile;
+    }
+}
+
+TEST(TestLatencyHistogram, TestMerge)
+{
+    LatencyHistogram a;
+    LatencyHistogram b;
+
+    a.Record(10);
+    a.Record(20);
+    b.Record(5);
+    b.Record(1000);
+
+    a.Merge(b);
+    EXPECT_EQ(a.Count(), 4u);
+    EXPECT_EQ(a.Min(), 5u);
+    EXPECT_EQ(a.Max(), 1000u);
+    EXPECT_EQ(a.Sum(), 1035u);
+
+    a.Reset();
+    EXPECT_EQ(a.Count(), 0u);
+    EXPECT_EQ(a.Max(), 0u);
+}
+
+TEST_F(TestMetricsRegistry, TestBeginEndPairing)
+{
+    MetricsRegistry registry;
+
+    mMockClock.SetMonotonic(System::Clock::Milliseconds64(1000));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kTestKey));
+    mMockClock.AdvanceMonotonic(System::Clock::Milliseconds64(5));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kTestKey));
+    mMockClock.AdvanceMonotonic(System::Clock::Milliseconds64(10));
+
+    // Ends are paired with the oldest outstanding begin.
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kTestKey));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kTestKey, CHIP_ERROR_TIMEOUT));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kTestKey));
+
+    MetricsRegistry::MetricStats stats;
+    ASSERT_TRUE(registry.GetStats(kTestKey, stats));
+    EXPECT_EQ(stats.events, 2u);
+    EXPECT_EQ(stats.errors, 1u);
+    EXPECT_EQ(stats.unmatchedEnds, 1u);
+    EXPECT_EQ(stats.durations.Count(), 2u);
+    EXPECT_EQ(stats.durations.Min(), 10000u);
+    EXPECT_EQ(stats.durations.Max(), 15000u);
+    EXPECT_EQ(stats.values.Count(), 0u);
+
+    EXPECT_FALSE(registry.GetStats(kTestValueKey, stats));
+}
+
+TEST_F(TestMetricsRegistry, TestPendingBeginsAreBounded)
+{
+    MetricsRegistry registry;
+
+    for (size_t i = 0; i < MetricsRegistry::kMaxPendingBegins * 2; i++)
+    {
+        registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kTestKey));
+        mMockClock.AdvanceMonotonic(System::Clock::Milliseconds64(1));
+    }
+
+    for (size_t i = 0; i < MetricsRegistry::kMaxPendingBegins * 2; i++)
+    {
+        registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kTestKey));
+    }
+
+    MetricsRegistry::MetricStats stats;
+    ASSERT_TRUE(registry.GetStats(kTestKey, stats));
+    EXPECT_EQ(stats.events, MetricsRegistry::kMaxPendingBegins);
+    EXPECT_EQ(stats.unmatchedEnds, MetricsRegistry::kMaxPendingBegins);
+
+    // Only the most recent begins were kept.
+    EXPECT_EQ(stats.durations.Max(), MetricsRegistry::kMaxPendingBegins * 1000);
+}
+
+TEST_F(TestMetricsRegistry, TestInstantValues)
+{
+    MetricsRegistry registry;
+
+    registry.LogMetricEvent(
+        MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, LatencyMicroseconds(std::chrono::milliseconds(2))));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, int32_t(300)));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, CHIP_ERROR_TIMEOUT));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, CHIP_NO_ERROR));
+
+    MetricsRegistry::MetricStats stats;
+    ASSERT_TRUE(registry.GetStats(kTestValueKey, stats));
+    EXPECT_EQ(stats.events, 4u);
+    EXPECT_EQ(stats.errors, 1u);
+    EXPECT_EQ(stats.values.Count(), 2u);
+    EXPECT_EQ(stats.values.Min(), 300u);
+    EXPECT_EQ(stats.values.Max(), 2000u);
+
+    registry.Reset();
+    EXPECT_FALSE(registry.GetStats(kTestValueKey, stats));
+}
+
+TEST_F(TestMetricsRegistry, TestExport)
+{
+    MetricsRegistry registry;
+
+    EXPECT_EQ(registry.Export(MetricsRegistry::ExportFormat::kText), "");
+    EXPECT_EQ(registry.Export(MetricsRegistry::ExportFormat::kJson), "{}\n");
+
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kTestKey));
+    mMockClock.AdvanceMonotonic(System::Clock::Milliseconds64(3));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kTestKey));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, uint32_t(42)));
+    registry.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kTestValueKey, CHIP_ERROR_TIMEOUT));
+
+    const std::string text = registry.Export(MetricsRegistry::ExportFormat::kText);
+    EXPECT_NE(text.find("test_operation events=1 errors=0 duration_us[n=1 min=3000 "), std::string::npos) << text;
+    EXPECT_NE(text.find("test_value_us events=2 errors=1 value[n=1 min=42 "), std::string::npos) << text;
+    // Keys are sorted.
+    EXPECT_LT(text.find("test_operation"), text.find("test_value_us"));
+
+    const std::string json = registry.Export(MetricsRegistry::ExportFormat::kJson);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_NE(json.find("\"test_operation\":{\"events\":1,\"errors\":0,\"unmatched_ends\":0,\"duration_us\":{\"count\":1,"),
+              std::string::npos)
+        << json;
+    EXPECT_NE(json.find("\"test_value_us\":{\"events\":2,\"errors\":1,\"unmatched_ends\":0,"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"value\":{\"count\":1,\"min\":42,"), std::string::npos) << json;
+}
+
+} // namespace
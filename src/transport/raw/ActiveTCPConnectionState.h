@@ -54,19 +54,25 @@ struct ActiveTCPConnectionState
 
     void Init(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddr)
     {
-        mEndPoint = endPoint;
-        mPeerAddr = peerAddr;
-        mReceived = nullptr;
-        mAppState = nullptr;
+        mEndPoint           = endPoint;
+        mPeerAddr           = peerAddr;
+        mReceived           = nullptr;
+        mPartialMessage     = nullptr;
+        mPartialMessageSize = 0;
+        mReceivePaused      = false;
+        mAppState           = nullptr;
     }
 
     void Free()
     {
         mEndPoint->Free();
-        mPeerAddr = PeerAddress::Uninitialized();
-        mEndPoint = nullptr;
-        mReceived = nullptr;
-        mAppState = nullptr;
+        mPeerAddr           = PeerAddress::Uninitialized();
+        mEndPoint           = nullptr;
+        mReceived           = nullptr;
+        mPartialMessage     = nullptr;
+        mPartialMessageSize = 0;
+        mReceivePaused      = false;
+        mAppState           = nullptr;
     }
 
     bool InUse() const { return mEndPoint != nullptr; }
@@ -84,6 +90,19 @@ struct ActiveTCPConnectionState
     // Buffers received but not yet consumed.
     System::PacketBufferHandle mReceived;
 
+    // Body received so far of a message whose length prefix has been
+    // consumed. Body bytes are copied in as they arrive so received buffers
+    // can be released immediately; the buffer is allocated once, for the
+    // whole message.
+    System::PacketBufferHandle mPartialMessage;
+
+    // Total body length of the message being received, 0 if none.
+    size_t mPartialMessageSize = 0;
+
+    // True while receiving is disabled because no buffer was available for
+    // the next message; a timer retries the allocation.
+    bool mReceivePaused = false;
+
     // Current state of the connection
     TCPState mConnectionState;
 
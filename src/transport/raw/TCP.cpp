@@ -30,8 +30,10 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <inttypes.h>
 #include <limits>
+#include <string.h>
 
 namespace chip {
 namespace Transport {
@@ -51,6 +53,9 @@ constexpr uint32_t kMaxTCPMessageSize =
 
 constexpr int kListenBacklogSize = 2;
 
+// How long to keep a connection's receive path paused before retrying a message buffer allocation that failed.
+constexpr System::Clock::Milliseconds32 kReceiveRetryInterval(100);
+
 } // namespace
 
 TCPBase::~TCPBase()
@@ -314,9 +319,33 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
     ActiveTCPConnectionState * state = FindActiveConnection(endPoint);
     VerifyOrReturnError(state != nullptr, CHIP_ERROR_INTERNAL);
     state->mReceived.AddToEnd(std::move(buffer));
+    ReturnErrorCodeIf(state->mReceivePaused, CHIP_NO_ERROR);
+
+    return ProcessReceivedData(peerAddress, state);
+}
 
+CHIP_ERROR TCPBase::ProcessReceivedData(const PeerAddress & peerAddress, ActiveTCPConnectionState * state)
+{
     while (!state->mReceived.IsNull())
     {
+        if (state->mPartialMessageSize > 0)
+        {
+            if (state->mPartialMessage.IsNull())
+            {
+                // The message size is bounded by kMaxTCPMessageSize, so allocate the whole message once and copy each
+                // received byte into it exactly once.
+                state->mPartialMessage = System::PacketBufferHandle::New(state->mPartialMessageSize, 0);
+                if (state->mPartialMessage.IsNull())
+                {
+                    // Out of buffers. Leave the data where it is and stop reading, so the peer sees the TCP window
+                    // close instead of the connection dropping; the allocation is retried later.
+                    return PauseReceiving(state);
+                }
+            }
+            ReturnErrorOnFailure(ContinuePartialMessage(peerAddress, state));
+            continue;
+        }
+
         uint8_t messageSizeBuf[kPacketSizeBytes];
         CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
         if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
@@ -340,8 +369,17 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
         // The subtraction will not underflow because we successfully read kPacketSizeBytes.
         if (messageSize > (state->mReceived->TotalLength() - kPacketSizeBytes))
         {
-            // We have not yet received the complete message.
-            return CHIP_NO_ERROR;
+            // We have not yet received the complete message. Rather than holding on to every received buffer until it
+            // is, stream the body into a message buffer; the copy is the same one ProcessSingleMessage would make for a
+            // message spanning several buffers.
+            if (state->mReceived->TotalLength() == kPacketSizeBytes)
+            {
+                // Only the length prefix so far. Wait for some of the body before allocating for it.
+                return CHIP_NO_ERROR;
+            }
+            state->mPartialMessageSize = messageSize;
+            state->mReceived.Consume(kPacketSizeBytes);
+            continue;
         }
         state->mReceived.Consume(kPacketSizeBytes);
         ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
@@ -387,6 +425,60 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TCPBase::ContinuePartialMessage(const PeerAddress & peerAddress, ActiveTCPConnectionState * state)
+{
+    System::PacketBufferHandle & message = state->mPartialMessage;
+    size_t received                      = message->DataLength();
+    size_t count                         = std::min(state->mPartialMessageSize - received, state->mReceived->TotalLength());
+
+    CHIP_ERROR err = state->mReceived->Read(message->Start() + received, count);
+    state->mReceived.Consume(count);
+    ReturnErrorOnFailure(err);
+    message->SetDataLength(received + count);
+
+    if (message->DataLength() < state->mPartialMessageSize)
+    {
+        // Wait for more data.
+        return CHIP_NO_ERROR;
+    }
+
+    // Detach the message first so the connection is ready for the next one no matter what the delegate does with it.
+    System::PacketBufferHandle complete = std::move(message);
+    MessageTransportContext msgContext;
+    msgContext.conn            = state;
+    state->mPartialMessageSize = 0;
+    HandleMessageReceived(peerAddress, std::move(complete), &msgContext);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TCPBase::PauseReceiving(ActiveTCPConnectionState * state)
+{
+    ChipLogError(Inet, "No buffer for a %u-byte TCP message; pausing receive.", static_cast<unsigned>(state->mPartialMessageSize));
+    ReturnErrorOnFailure(state->mEndPoint->GetSystemLayer().StartTimer(kReceiveRetryInterval, HandleReceiveRetryTimer, state));
+    state->mReceivePaused = true;
+    state->mEndPoint->DisableReceive();
+    return CHIP_NO_ERROR;
+}
+
+void TCPBase::HandleReceiveRetryTimer(System::Layer * layer, void * appState)
+{
+    auto * state  = reinterpret_cast<ActiveTCPConnectionState *>(appState);
+    TCPBase * tcp = reinterpret_cast<TCPBase *>(state->mEndPoint->mAppState);
+
+    state->mReceivePaused = false;
+    CHIP_ERROR err        = tcp->ProcessReceivedData(state->mPeerAddr, state);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to process paused TCP data: %" CHIP_ERROR_FORMAT, err.Format());
+        tcp->CloseConnectionInternal(state, err, SuppressCallback::No);
+        return;
+    }
+    if (!state->mReceivePaused)
+    {
+        state->mEndPoint->EnableReceive();
+    }
+}
+
 void TCPBase::CloseConnectionInternal(ActiveTCPConnectionState * connection, CHIP_ERROR err, SuppressCallback suppressCallback)
 {
     TCPState prevState;
@@ -428,6 +520,10 @@ void TCPBase::CloseConnectionInternal(ActiveTCPConnectionState * connection, CHI
             }
         }
 
+        if (connection->mReceivePaused)
+        {
+            connection->mEndPoint->GetSystemLayer().CancelTimer(HandleReceiveRetryTimer, connection);
+        }
         connection->Free();
         mUsedEndPointCount--;
     }
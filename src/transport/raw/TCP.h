@@ -249,6 +249,14 @@ private:
     CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                      System::PacketBufferHandle && buffer);
 
+    /**
+     * Process the data queued on a connection, dispatching every complete message.
+     *
+     * @param[in]     peerAddress   The peer the data is coming from.
+     * @param[in,out] state         The connection state. Data that cannot be processed yet stays in `state->mReceived`.
+     */
+    CHIP_ERROR ProcessReceivedData(const PeerAddress & peerAddress, ActiveTCPConnectionState * state);
+
     /**
      * Process a single message of the specified size from a buffer.
      *
@@ -260,6 +268,24 @@ private:
      */
     CHIP_ERROR ProcessSingleMessage(const PeerAddress & peerAddress, ActiveTCPConnectionState * state, size_t messageSize);
 
+    /**
+     * Copy received data into the connection's partial message and dispatch it once complete.
+     *
+     * @param[in]     peerAddress   The peer the data is coming from.
+     * @param[in,out] state         The connection state. On entry, `state->mPartialMessage` is allocated for the whole message
+     *                              and holds the part received so far, and `state->mReceived` the data that follows. On exit, the copied bytes have been consumed
+     *                              from `state->mReceived`.
+     */
+    CHIP_ERROR ContinuePartialMessage(const PeerAddress & peerAddress, ActiveTCPConnectionState * state);
+
+    /**
+     * Stop reading from a connection that has no buffer for its next message, and retry after kReceiveRetryInterval.
+     */
+    CHIP_ERROR PauseReceiving(ActiveTCPConnectionState * state);
+
+    // Timer handler resuming a connection paused by PauseReceiving.
+    static void HandleReceiveRetryTimer(System::Layer * layer, void * appState);
+
     /**
      * Initiate a connection to the given peer. On connection completion,
      * HandleTCPConnectComplete callback would be called.
@@ -60,6 +60,11 @@ void IOContext::DriveIO()
     ServiceEvents(kSleepTimeMilliseconds);
 }
 
+void IOContext::DriveIO(System::Clock::Milliseconds32 maxSleep)
+{
+    ServiceEvents(maxSleep.count());
+}
+
 void IOContext::DriveIOUntil(System::Clock::Timeout maxWait, std::function<bool(void)> completionFunction)
 {
     System::Clock::Timestamp startTime = System::SystemClock().GetMonotonicTimestamp();
@@ -45,6 +45,9 @@ public:
     /// Perform a single short IO Loop
     void DriveIO();
 
+    /// Perform a single IO Loop, waiting at most the given time for events
+    void DriveIO(System::Clock::Milliseconds32 maxSleep);
+
     /// DriveIO until the specified number of milliseconds has passed or until
     /// completionFunction returns true
     void DriveIOUntil(System::Clock::Timeout maxWait, std::function<bool(void)> completionFunction);
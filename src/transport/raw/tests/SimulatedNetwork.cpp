@@ -0,0 +1,301 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "SimulatedNetwork.h"
+
+#include <inet/IPAddress.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Test {
+
+using namespace System::Clock;
+
+namespace {
+
+// Nodes get addresses in a unique local prefix, one interface id per node.
+constexpr uint64_t kSimulatedNetworkGlobalId = 0x5e51a7ed;
+
+} // namespace
+
+CHIP_ERROR SimulatedTransport::Init(SimulatedNetwork * network)
+{
+    VerifyOrReturnError(network != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Close();
+    ReturnErrorOnFailure(network->Attach(*this, mAddress));
+    mNetwork = network;
+    return CHIP_NO_ERROR;
+}
+
+void SimulatedTransport::Close()
+{
+    if (mNetwork != nullptr)
+    {
+        mNetwork->Detach(*this);
+        mNetwork = nullptr;
+    }
+}
+
+CHIP_ERROR SimulatedTransport::SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf)
+{
+    VerifyOrReturnError(mNetwork != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanSendToPeer(address), CHIP_ERROR_INVALID_ADDRESS);
+    return mNetwork->Send(*this, address, std::move(msgBuf));
+}
+
+bool SimulatedNetwork::AddressLess::operator()(const Transport::PeerAddress & a, const Transport::PeerAddress & b) const
+{
+    const Inet::IPAddress & aAddr = a.GetIPAddress();
+    const Inet::IPAddress & bAddr = b.GetIPAddress();
+    for (size_t i = 0; i < ArraySize(aAddr.Addr); i++)
+    {
+        if (aAddr.Addr[i] != bAddr.Addr[i])
+        {
+            return aAddr.Addr[i] < bAddr.Addr[i];
+        }
+    }
+    return a.GetPort() < b.GetPort();
+}
+
+CHIP_ERROR SimulatedNetwork::Init(IOContext & ioContext, Internal::MockClock * clock)
+{
+    VerifyOrReturnError(mIOContext == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mIOContext = &ioContext;
+    mClock     = clock;
+    return CHIP_NO_ERROR;
+}
+
+void SimulatedNetwork::Shutdown()
+{
+    VerifyOrReturn(mIOContext != nullptr);
+
+    mIOContext->GetSystemLayer().CancelTimer(HandleDeliveryTimer, this);
+    mDeliveryTimerArmed = false;
+    mInFlight.clear();
+
+    // Nodes still attached are left without a network rather than with a dangling pointer.
+    for (auto & node : mNodes)
+    {
+        node.second->mNetwork = nullptr;
+    }
+    mNodes.clear();
+    mLinkBusyUntil.clear();
+    mIOContext = nullptr;
+}
+
+void SimulatedNetwork::SetLinkConditions(const Transport::PeerAddress & node, const LinkConditions & conditions)
+{
+    mConditions[node] = conditions;
+}
+
+const SimulatedNetwork::LinkConditions & SimulatedNetwork::GetLinkConditions(const Transport::PeerAddress & node) const
+{
+    auto it = mConditions.find(node);
+    return (it != mConditions.end()) ? it->second : mDefaultConditions;
+}
+
+CHIP_ERROR SimulatedNetwork::Attach(SimulatedTransport & transport, Transport::PeerAddress & address)
+{
+    VerifyOrReturnError(mIOContext != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    address = Transport::PeerAddress::UDP(Inet::IPAddress::MakeULA(kSimulatedNetworkGlobalId, 0, mNextNodeIndex++), CHIP_PORT);
+    mNodes[address] = &transport;
+    return CHIP_NO_ERROR;
+}
+
+void SimulatedNetwork::Detach(SimulatedTransport & transport)
+{
+    mNodes.erase(transport.GetAddress());
+    mLinkBusyUntil.erase(transport.GetAddress());
+}
+
+CHIP_ERROR SimulatedNetwork::Send(SimulatedTransport & sender, const Transport::PeerAddress & destination,
+                                  System::PacketBufferHandle && data)
+{
+    VerifyOrReturnError(!data.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    mStats.mPacketsSent++;
+
+    // Like UDP, packets that cannot make it are dropped silently.
+    if (mNodes.find(destination) == mNodes.end())
+    {
+        mStats.mPacketsUnroutable++;
+        return CHIP_NO_ERROR;
+    }
+
+    const LinkConditions & conditions = GetLinkConditions(sender.GetAddress());
+    if (!conditions.mOnline || (conditions.mLossPerMille > 0 && (NextRandom() % 1000) < conditions.mLossPerMille))
+    {
+        mStats.mPacketsLost++;
+        return CHIP_NO_ERROR;
+    }
+
+    // The receiver may decrypt in place, while the sender may keep the buffer for retransmissions: always copy.
+    System::PacketBufferHandle copy = data.CloneData();
+    VerifyOrReturnError(!copy.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    Microseconds64 sent = System::SystemClock().GetMonotonicMicroseconds64();
+    if (conditions.mBandwidthBytesPerSecond > 0)
+    {
+        // Packets sent by a node go out one after the other.
+        Microseconds64 & busyUntil = mLinkBusyUntil[sender.GetAddress()];
+        Microseconds64 duration(uint64_t(copy->TotalLength()) * 1000000 / conditions.mBandwidthBytesPerSecond);
+        sent      = std::max(sent, busyUntil) + duration;
+        busyUntil = sent;
+    }
+
+    Microseconds64 arrival = sent + conditions.mLatency;
+    if (conditions.mJitter > kZero)
+    {
+        arrival += Milliseconds64(NextRandom() % (uint64_t(conditions.mJitter.count()) + 1));
+    }
+
+    // Timers have a millisecond resolution: round up so that a packet is never delivered early.
+    PacketKey key{ std::chrono::ceil<Milliseconds64>(arrival), mNextSequence++ };
+    mInFlight.emplace(key, Packet{ sender.GetAddress(), destination, std::move(copy) });
+    ArmDeliveryTimer();
+    return CHIP_NO_ERROR;
+}
+
+uint64_t SimulatedNetwork::NextRandom()
+{
+    // xorshift64*
+    mRandomState ^= mRandomState >> 12;
+    mRandomState ^= mRandomState << 25;
+    mRandomState ^= mRandomState >> 27;
+    return mRandomState * 0x2545F4914F6CDD1DULL;
+}
+
+void SimulatedNetwork::ArmDeliveryTimer()
+{
+    System::Layer & systemLayer = mIOContext->GetSystemLayer();
+
+    if (mInFlight.empty())
+    {
+        if (mDeliveryTimerArmed)
+        {
+            systemLayer.CancelTimer(HandleDeliveryTimer, this);
+            mDeliveryTimerArmed = false;
+        }
+        return;
+    }
+
+    const Timestamp next = mInFlight.begin()->first.mDeliveryTime;
+    VerifyOrReturn(!mDeliveryTimerArmed || next < mArmedDeliveryTime);
+
+    const Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    CHIP_ERROR err      = systemLayer.StartTimer((next > now) ? (next - now) : kZero, HandleDeliveryTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Test, "Simulated network failed to arm its delivery timer: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mDeliveryTimerArmed = true;
+    mArmedDeliveryTime  = next;
+}
+
+void SimulatedNetwork::HandleDeliveryTimer(System::Layer * systemLayer, void * appState)
+{
+    static_cast<SimulatedNetwork *>(appState)->DeliverDuePackets();
+}
+
+void SimulatedNetwork::DeliverDuePackets()
+{
+    mDeliveryTimerArmed = false;
+
+    // Packets sent by the receivers during this pass wait for the next one, even with no latency, so that a
+    // conversation between two nodes cannot starve the rest of the system layer.
+    const Timestamp now        = System::SystemClock().GetMonotonicTimestamp();
+    const uint64_t endSequence = mNextSequence;
+    while (!mInFlight.empty())
+    {
+        auto it = mInFlight.begin();
+        if (it->first.mDeliveryTime > now || it->first.mSequence >= endSequence)
+        {
+            break;
+        }
+
+        Packet packet = std::move(it->second);
+        mInFlight.erase(it);
+
+        // Look the destination up again: it may have left the network while the packet was in flight.
+        auto node = mNodes.find(packet.mDestination);
+        if (node == mNodes.end())
+        {
+            mStats.mPacketsUnroutable++;
+            continue;
+        }
+        if (!GetLinkConditions(packet.mDestination).mOnline)
+        {
+            mStats.mPacketsLost++;
+            continue;
+        }
+
+        mStats.mPacketsDelivered++;
+        mStats.mBytesDelivered += packet.mData->TotalLength();
+        node->second->Deliver(packet.mSource, std::move(packet.mData));
+    }
+
+    if (mIOContext != nullptr)
+    {
+        ArmDeliveryTimer();
+    }
+}
+
+void SimulatedNetwork::RunFor(Milliseconds32 duration)
+{
+    RunUntil(nullptr, duration);
+}
+
+bool SimulatedNetwork::RunUntil(std::function<bool()> condition, Milliseconds32 maxDuration)
+{
+    VerifyOrDie(mIOContext != nullptr && mClock != nullptr);
+
+    const Timestamp end = mClock->GetMonotonicTimestamp() + maxDuration;
+    while (true)
+    {
+        mIOContext->DriveIO(kZero);
+        if (condition && condition())
+        {
+            return true;
+        }
+
+        const Timestamp now = mClock->GetMonotonicTimestamp();
+        if (now >= end)
+        {
+            return false;
+        }
+
+        // Jump straight to the next delivery when it comes before the next tick.  Timers of the system layer fire
+        // at the latest one tick late.
+        Timestamp next = std::min<Timestamp>(now + mTick, end);
+        if (!mInFlight.empty())
+        {
+            next = std::min(next, std::max(now, mInFlight.begin()->first.mDeliveryTime));
+        }
+        mClock->SetMonotonic(std::chrono::duration_cast<Milliseconds64>(next));
+    }
+}
+
+} // namespace Test
+} // namespace chip
@@ -0,0 +1,221 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/Base.h>
+#include <transport/raw/PeerAddress.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace chip {
+namespace Test {
+
+class SimulatedNetwork;
+
+/**
+ * A transport whose packets go through a SimulatedNetwork instead of the host's network stack.
+ *
+ * Each instance is a virtual node of the network, with its own address.  It is used like the loopback
+ * transport: TransportMgr<SimulatedTransport> transportMgr; transportMgr.Init(&network);
+ */
+class SimulatedTransport : public Transport::Base
+{
+public:
+    ~SimulatedTransport() override { Close(); }
+
+    /// Transports are required to have an Init method that takes exactly one argument.
+    CHIP_ERROR Init(SimulatedNetwork * network);
+
+    void Close() override;
+
+    CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override;
+
+    bool CanSendToPeer(const Transport::PeerAddress & address) override
+    {
+        return address.GetTransportType() == Transport::Type::kUdp;
+    }
+
+    const Transport::PeerAddress & GetAddress() const { return mAddress; }
+
+private:
+    friend class SimulatedNetwork;
+
+    void Deliver(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf)
+    {
+        HandleMessageReceived(source, std::move(msgBuf));
+    }
+
+    SimulatedNetwork * mNetwork = nullptr;
+    Transport::PeerAddress mAddress;
+};
+
+/**
+ * A deterministic, in-process network connecting any number of SimulatedTransport nodes.
+ *
+ * Packets sent by a node are delivered to the destination node after a delay given by the link conditions of the
+ * sender: a fixed latency, plus a random jitter, plus the time needed to send the packet at the bandwidth of the link
+ * (packets sent by the same node are serialized).  Packets may also be lost at random, or dropped because the sender
+ * or the destination is offline.  Randomness comes from a seeded generator, so a given scenario always plays out the
+ * same way.
+ *
+ * Packets are delivered from a timer of the system layer, so the network works with the regular IO loop.  To
+ * simulate long periods of time quickly, install a MockClock as the system clock and let RunFor / RunUntil drive time:
+ * they jump from one packet delivery to the next, servicing the IO context at least every tick without ever sleeping.
+ */
+class SimulatedNetwork
+{
+public:
+    struct LinkConditions
+    {
+        System::Clock::Milliseconds32 mLatency = System::Clock::kZero;
+        // Each packet gets an extra delay uniformly distributed in [0, mJitter].  Jitter may reorder packets.
+        System::Clock::Milliseconds32 mJitter = System::Clock::kZero;
+        // Out of 1000 packets, how many are lost.
+        uint16_t mLossPerMille = 0;
+        // 0 means unlimited.
+        uint32_t mBandwidthBytesPerSecond = 0;
+        bool mOnline                      = true;
+    };
+
+    struct Stats
+    {
+        uint64_t mPacketsSent       = 0;
+        uint64_t mPacketsDelivered  = 0;
+        uint64_t mPacketsLost       = 0; // Lost at random, or because the sender or the destination was offline.
+        uint64_t mPacketsUnroutable = 0; // No node with the destination address.
+        uint64_t mBytesDelivered    = 0;
+    };
+
+    static constexpr System::Clock::Milliseconds32 kDefaultTick = System::Clock::Milliseconds32(1);
+
+    ~SimulatedNetwork() { Shutdown(); }
+
+    /**
+     * @param ioContext     The IO context whose system layer delivers the packets.
+     * @param clock         If not null, the clock driven by RunFor / RunUntil.  It must be the installed system clock.
+     */
+    CHIP_ERROR Init(IOContext & ioContext, System::Clock::Internal::MockClock * clock = nullptr);
+
+    /**
+     * Drop the packets in flight.  Nodes must be closed before the network is destroyed.
+     */
+    void Shutdown();
+
+    void SetSeed(uint64_t seed) { mRandomState = (seed != 0) ? seed : kDefaultSeed; }
+
+    /**
+     * Draw a byte from the seeded generator of the network, so that other random choices made during a scenario are
+     * reproducible too.
+     */
+    uint8_t NextRandomU8() { return static_cast<uint8_t>(NextRandom() >> 56); }
+    void SetTick(System::Clock::Milliseconds32 tick) { mTick = tick; }
+
+    /**
+     * Set the conditions of the link of every node that has none of its own.
+     */
+    void SetDefaultLinkConditions(const LinkConditions & conditions) { mDefaultConditions = conditions; }
+
+    /**
+     * Set the conditions of the link of a node, applied to the packets it sends.  Taking a node offline also loses the
+     * packets sent to it.
+     */
+    void SetLinkConditions(const Transport::PeerAddress & node, const LinkConditions & conditions);
+    void ClearLinkConditions(const Transport::PeerAddress & node) { mConditions.erase(node); }
+    const LinkConditions & GetLinkConditions(const Transport::PeerAddress & node) const;
+
+    size_t GetNodeCount() const { return mNodes.size(); }
+    size_t GetPacketsInFlight() const { return mInFlight.size(); }
+    const Stats & GetStats() const { return mStats; }
+    void ResetStats() { mStats = Stats(); }
+
+    /**
+     * Let simulated time pass, delivering packets and servicing the system layer.  Requires a clock.
+     */
+    void RunFor(System::Clock::Milliseconds32 duration);
+
+    /**
+     * Like RunFor, but stop as soon as the condition holds.  Returns whether it holds.
+     */
+    bool RunUntil(std::function<bool()> condition, System::Clock::Milliseconds32 maxDuration);
+
+private:
+    friend class SimulatedTransport;
+
+    static constexpr uint64_t kDefaultSeed = 0x5eed5eed5eed5eedULL;
+
+    struct PacketKey
+    {
+        System::Clock::Timestamp mDeliveryTime;
+        uint64_t mSequence;
+
+        bool operator<(const PacketKey & other) const
+        {
+            return (mDeliveryTime != other.mDeliveryTime) ? (mDeliveryTime < other.mDeliveryTime) : (mSequence < other.mSequence);
+        }
+    };
+
+    struct Packet
+    {
+        Transport::PeerAddress mSource;
+        Transport::PeerAddress mDestination;
+        System::PacketBufferHandle mData;
+    };
+
+    struct AddressLess
+    {
+        bool operator()(const Transport::PeerAddress & a, const Transport::PeerAddress & b) const;
+    };
+
+    CHIP_ERROR Attach(SimulatedTransport & transport, Transport::PeerAddress & address);
+    void Detach(SimulatedTransport & transport);
+    CHIP_ERROR Send(SimulatedTransport & sender, const Transport::PeerAddress & destination, System::PacketBufferHandle && data);
+
+    uint64_t NextRandom();
+    void ArmDeliveryTimer();
+    void DeliverDuePackets();
+    static void HandleDeliveryTimer(System::Layer * systemLayer, void * appState);
+
+    IOContext * mIOContext                      = nullptr;
+    System::Clock::Internal::MockClock * mClock = nullptr;
+    System::Clock::Milliseconds32 mTick         = kDefaultTick;
+    uint64_t mRandomState                       = kDefaultSeed;
+    uint64_t mNextSequence                      = 0;
+    uint64_t mNextNodeIndex                     = 1;
+    System::Clock::Timestamp mArmedDeliveryTime = System::Clock::kZero;
+    bool mDeliveryTimerArmed                    = false;
+
+    LinkConditions mDefaultConditions;
+    std::map<Transport::PeerAddress, LinkConditions, AddressLess> mConditions;
+    std::map<Transport::PeerAddress, SimulatedTransport *, AddressLess> mNodes;
+    // When the link of each sender is done sending the packets queued so far.
+    std::map<Transport::PeerAddress, System::Clock::Microseconds64, AddressLess> mLinkBusyUntil;
+    std::map<PacketKey, Packet> mInFlight;
+    Stats mStats;
+};
+
+} // namespace Test
+} // namespace chip
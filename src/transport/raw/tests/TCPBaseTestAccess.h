@@ -39,6 +39,21 @@ public:
     }
     static Inet::TCPEndPoint * GetEndpoint(void * state) { return static_cast<ActiveTCPConnectionState *>(state)->mEndPoint; }
 
+    // Number of bytes the buffer of the message being received can hold, 0 if there is none.
+    static size_t GetPartialMessageCapacity(void * state)
+    {
+        const System::PacketBufferHandle & message = static_cast<ActiveTCPConnectionState *>(state)->mPartialMessage;
+        return message.IsNull() ? 0 : message->DataLength() + message->AvailableDataLength();
+    }
+
+    static const uint8_t * GetPartialMessageStart(void * state)
+    {
+        const System::PacketBufferHandle & message = static_cast<ActiveTCPConnectionState *>(state)->mPartialMessage;
+        return message.IsNull() ? nullptr : message->Start();
+    }
+
+    static bool IsReceivePaused(void * state) { return static_cast<ActiveTCPConnectionState *>(state)->mReceivePaused; }
+
     static CHIP_ERROR ProcessReceivedBuffer(TCPImpl & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                             System::PacketBufferHandle && buffer)
     {
@@ -0,0 +1,264 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "SimulatedNetwork.h"
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/CHIPCore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <transport/TransportMgr.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::Test;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+using SimulatedTransportMgr = TransportMgr<SimulatedTransport>;
+
+struct Arrival
+{
+    System::Clock::Timestamp mTime;
+    Transport::PeerAddress mSource;
+    size_t mLength;
+    uint8_t mTag;
+};
+
+class RecordingTransportMgrDelegate : public TransportMgrDelegate
+{
+public:
+    void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf,
+                           Transport::MessageTransportContext * transCtxt = nullptr) override
+    {
+        mArrivals.push_back(
+            { System::SystemClock().GetMonotonicTimestamp(), source, msgBuf->TotalLength(), msgBuf->Start()[0] });
+    }
+
+    std::vector<Arrival> mArrivals;
+};
+
+/// A node of the network and the packets it received.
+struct Node
+{
+    CHIP_ERROR Init(SimulatedNetwork & network)
+    {
+        ReturnErrorOnFailure(mTransportMgr.Init(&network));
+        mTransportMgr.SetSessionManager(&mDelegate);
+        return CHIP_NO_ERROR;
+    }
+
+    const Transport::PeerAddress & GetAddress() { return mTransportMgr.GetTransport().GetImplAtIndex<0>().GetAddress(); }
+
+    CHIP_ERROR Send(const Transport::PeerAddress & destination, size_t length, uint8_t tag = 0)
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(length);
+        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+        memset(buffer->Start(), tag, length);
+        buffer->SetDataLength(length);
+        return mTransportMgr.SendMessage(destination, std::move(buffer));
+    }
+
+    SimulatedTransportMgr mTransportMgr;
+    RecordingTransportMgrDelegate mDelegate;
+};
+
+} // namespace
+
+class TestSimulatedNetwork : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        mIOContext = new IOContext();
+        ASSERT_EQ(mIOContext->Init(), CHIP_NO_ERROR);
+    }
+
+    static void TearDownTestSuite()
+    {
+        mIOContext->Shutdown();
+        delete mIOContext;
+        mIOContext = nullptr;
+    }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+        ASSERT_EQ(mNetwork.Init(*mIOContext, &mMockClock), CHIP_NO_ERROR);
+    }
+
+    void TearDown() override
+    {
+        mNetwork.Shutdown();
+        System::Clock::Internal::SetSystemClockForTesting(mRealClock);
+    }
+
+protected:
+    // Sends `count` packets of `length` bytes from a to b, tagged with their index, and lets the network drain.
+    std::vector<Arrival> Exchange(uint64_t seed, const SimulatedNetwork::LinkConditions & conditions, size_t count, size_t length)
+    {
+        Node a;
+        Node b;
+        EXPECT_EQ(a.Init(mNetwork), CHIP_NO_ERROR);
+        EXPECT_EQ(b.Init(mNetwork), CHIP_NO_ERROR);
+
+        mNetwork.SetSeed(seed);
+        mNetwork.SetLinkConditions(a.GetAddress(), conditions);
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(a.Send(b.GetAddress(), length, static_cast<uint8_t>(i)), CHIP_NO_ERROR);
+        }
+        EXPECT_TRUE(mNetwork.RunUntil([&] { return mNetwork.GetPacketsInFlight() == 0; }, 60_s));
+        mNetwork.ClearLinkConditions(a.GetAddress());
+        return b.mDelegate.mArrivals;
+    }
+
+    static IOContext * mIOContext;
+
+    System::Clock::ClockBase * mRealClock = nullptr;
+    System::Clock::Internal::MockClock mMockClock;
+    SimulatedNetwork mNetwork;
+};
+
+IOContext * TestSimulatedNetwork::mIOContext = nullptr;
+
+TEST_F(TestSimulatedNetwork, TestLatency)
+{
+    Node a;
+    Node b;
+    ASSERT_EQ(a.Init(mNetwork), CHIP_NO_ERROR);
+    ASSERT_EQ(b.Init(mNetwork), CHIP_NO_ERROR);
+    EXPECT_EQ(mNetwork.GetNodeCount(), 2u);
+    EXPECT_FALSE(a.GetAddress() == b.GetAddress());
+
+    SimulatedNetwork::LinkConditions slow;
+    slow.mLatency = 20_ms32;
+    mNetwork.SetLinkConditions(a.GetAddress(), slow);
+
+    const System::Clock::Timestamp start = mMockClock.GetMonotonicTimestamp();
+    EXPECT_EQ(a.Send(b.GetAddress(), 10), CHIP_NO_ERROR);
+    EXPECT_EQ(b.Send(a.GetAddress(), 10), CHIP_NO_ERROR);
+
+    // b -> a uses the default conditions: it is delivered on the next pass of the event loop.
+    EXPECT_TRUE(mNetwork.RunUntil([&] { return !a.mDelegate.mArrivals.empty(); }, 1_s));
+    EXPECT_EQ(a.mDelegate.mArrivals[0].mTime, start);
+    EXPECT_EQ(a.mDelegate.mArrivals[0].mSource, b.GetAddress());
+    EXPECT_TRUE(b.mDelegate.mArrivals.empty());
+
+    EXPECT_TRUE(mNetwork.RunUntil([&] { return !b.mDelegate.mArrivals.empty(); }, 1_s));
+    EXPECT_EQ(b.mDelegate.mArrivals[0].mTime - start, 20_ms);
+    EXPECT_EQ(b.mDelegate.mArrivals[0].mSource, a.GetAddress());
+    EXPECT_EQ(b.mDelegate.mArrivals[0].mLength, 10u);
+
+    EXPECT_EQ(mNetwork.GetStats().mPacketsSent, 2u);
+    EXPECT_EQ(mNetwork.GetStats().mPacketsDelivered, 2u);
+    EXPECT_EQ(mNetwork.GetStats().mBytesDelivered, 20u);
+}
+
+TEST_F(TestSimulatedNetwork, TestBandwidth)
+{
+    SimulatedNetwork::LinkConditions narrow;
+    narrow.mLatency                 = 5_ms32;
+    narrow.mBandwidthBytesPerSecond = 1000;
+
+    // Packets queue behind each other: each takes 100ms to send.
+    const System::Clock::Timestamp start = mMockClock.GetMonotonicTimestamp();
+    std::vector<Arrival> arrivals        = Exchange(1, narrow, 10, 100);
+    ASSERT_EQ(arrivals.size(), 10u);
+    for (size_t i = 0; i < arrivals.size(); i++)
+    {
+        EXPECT_EQ(arrivals[i].mTag, i);
+        EXPECT_EQ(arrivals[i].mTime - start, System::Clock::Milliseconds64(100 * (i + 1) + 5));
+    }
+}
+
+TEST_F(TestSimulatedNetwork, TestLossAndJitterAreDeterministic)
+{
+    SimulatedNetwork::LinkConditions lossy;
+    lossy.mLatency      = 10_ms32;
+    lossy.mJitter       = 50_ms32;
+    lossy.mLossPerMille = 100;
+
+    std::vector<Arrival> first = Exchange(42, lossy, 250, 20);
+    const uint64_t lost        = mNetwork.GetStats().mPacketsLost;
+    EXPECT_EQ(first.size() + lost, 250u);
+    EXPECT_GT(lost, 5u);
+    EXPECT_LT(lost, 50u);
+
+    // Jitter reorders packets.
+    bool reordered = false;
+    for (size_t i = 1; i < first.size(); i++)
+    {
+        reordered = reordered || (first[i].mTag < first[i - 1].mTag);
+    }
+    EXPECT_TRUE(reordered);
+
+    // The same seed plays out the same way, relative to the start of the exchange.
+    std::vector<Arrival> second = Exchange(42, lossy, 250, 20);
+    ASSERT_EQ(second.size(), first.size());
+    for (size_t i = 0; i < first.size(); i++)
+    {
+        EXPECT_EQ(second[i].mTag, first[i].mTag);
+        EXPECT_EQ(second[i].mTime - second[0].mTime, first[i].mTime - first[0].mTime);
+    }
+
+    std::vector<Arrival> other = Exchange(43, lossy, 250, 20);
+    bool differs               = (other.size() != first.size());
+    for (size_t i = 0; !differs && i < first.size(); i++)
+    {
+        differs = (other[i].mTag != first[i].mTag);
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST_F(TestSimulatedNetwork, TestUnreachableNodes)
+{
+    Node a;
+    Node b;
+    ASSERT_EQ(a.Init(mNetwork), CHIP_NO_ERROR);
+    ASSERT_EQ(b.Init(mNetwork), CHIP_NO_ERROR);
+
+    // Packets to an offline node are lost.
+    SimulatedNetwork::LinkConditions offline;
+    offline.mOnline = false;
+    mNetwork.SetLinkConditions(b.GetAddress(), offline);
+    EXPECT_EQ(a.Send(b.GetAddress(), 10), CHIP_NO_ERROR);
+    EXPECT_EQ(b.Send(a.GetAddress(), 10), CHIP_NO_ERROR);
+    mNetwork.RunFor(100_ms32);
+    EXPECT_TRUE(a.mDelegate.mArrivals.empty());
+    EXPECT_TRUE(b.mDelegate.mArrivals.empty());
+    EXPECT_EQ(mNetwork.GetStats().mPacketsLost, 2u);
+
+    // Packets to an address without a node, or to a node that left while they were in flight, are unroutable.
+    mNetwork.ClearLinkConditions(b.GetAddress());
+    SimulatedNetwork::LinkConditions slow;
+    slow.mLatency = 50_ms32;
+    mNetwork.SetLinkConditions(a.GetAddress(), slow);
+    EXPECT_EQ(a.Send(b.GetAddress(), 10), CHIP_NO_ERROR);
+    b.mTransportMgr.Close();
+    EXPECT_EQ(a.Send(b.GetAddress(), 10), CHIP_NO_ERROR);
+    mNetwork.RunFor(100_ms32);
+    EXPECT_EQ(mNetwork.GetStats().mPacketsUnroutable, 2u);
+    EXPECT_EQ(mNetwork.GetStats().mPacketsDelivered, 0u);
+    EXPECT_EQ(mNetwork.GetNodeCount(), 1u);
+}
@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestUtils.h>
+#include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <transport/TransportMgr.h>
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -665,6 +666,84 @@ TEST_F(TestTCP, CheckProcessReceivedBuffer)
     EXPECT_EQ(err, CHIP_NO_ERROR);
     EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 2);
 
+    // Test a message whose buffers arrive in separate reads. The body is streamed into the message as it arrives, and the
+    // message is only dispatched once complete.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint32_t[]){ 151, 152, 153, 0 }));
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 0);
+        System::PacketBufferHandle part = testData[0].mHandle.PopHead();
+        err                             = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(part));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 1);
+
+    // Test a streamed message followed by a complete one, each read delivering a single buffer.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint32_t[]){ 161, 162, 0 }));
+    EXPECT_TRUE(testData[1].Init((const uint32_t[]){ 163, 0 }));
+    testData[0].mHandle->AddToEnd(std::move(testData[1].mHandle));
+    for (int i = 0; i < 3; ++i)
+    {
+        System::PacketBufferHandle part = testData[0].mHandle.PopHead();
+        err                             = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(part));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, i);
+    }
+
+    // Test that a streamed message is allocated once, for its whole length, as soon as body bytes arrive.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint32_t[]){ kPacketSizeBytes, 100, 100, 100, 100, 0 }));
+    {
+        System::PacketBufferHandle part = testData[0].mHandle.PopHead();
+        err                             = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(part));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(TestAccess::GetPartialMessageCapacity(state), 0u);
+    }
+    const uint8_t * partialMessageStart = nullptr;
+    for (size_t received = 100; received < 400; received += 100)
+    {
+        System::PacketBufferHandle part = testData[0].mHandle.PopHead();
+        err                             = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(part));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_GE(TestAccess::GetPartialMessageCapacity(state), 400u);
+        if (partialMessageStart == nullptr)
+        {
+            partialMessageStart = TestAccess::GetPartialMessageStart(state);
+        }
+        EXPECT_EQ(TestAccess::GetPartialMessageStart(state), partialMessageStart);
+    }
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 0);
+    err = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(testData[0].mHandle));
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 1);
+    EXPECT_EQ(TestAccess::GetPartialMessageCapacity(state), 0u);
+
+#if CHIP_WITH_NLFAULTINJECTION
+    // Test that failing to allocate a streamed message pauses receiving instead of closing the connection, and that the
+    // message is dispatched once the retry succeeds.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint32_t[]){ kPacketSizeBytes, 100, 100, 0 }));
+    for (int i = 0; i < 3; ++i)
+    {
+        if (i == 1)
+        {
+            chip::System::FaultInjection::GetManager().FailAtFault(chip::System::FaultInjection::kFault_PacketBufferNew, 0, 1);
+        }
+        System::PacketBufferHandle part = testData[0].mHandle.PopHead();
+        err                             = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(part));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(TestAccess::IsReceivePaused(state), i > 0);
+    }
+    EXPECT_EQ(TestAccess::GetEndpoint(state), lEndPoint);
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 0);
+    mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5),
+                             [&]() { return gMockTransportMgrDelegate.mReceiveHandlerCallCount != 0; });
+    EXPECT_FALSE(TestAccess::IsReceivePaused(state));
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 1);
+#endif // CHIP_WITH_NLFAULTINJECTION
+
     // Test a single packet buffer that is larger than
     // kMaxSizeWithoutReserve but less than CHIP_CONFIG_MAX_LARGE_PAYLOAD_SIZE_BYTES.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;